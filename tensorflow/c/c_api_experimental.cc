@@ -324,6 +324,80 @@ void TF_EnqueueNamedTensor(TF_Session* session, int tensor_id,
   VLOG(1) << "Enqueuing is done.";
 }
 
+struct TF_PreparedCall {
+  TF_Session* session;
+  tensorflow::Session::CallableHandle handle;
+  int ninputs;
+  int noutputs;
+};
+
+TF_PreparedCall* TF_SessionPrepareCall(TF_Session* session,
+                                       const TF_Output* inputs, int ninputs,
+                                       const TF_Output* outputs, int noutputs,
+                                       const TF_Operation* const* target_opers,
+                                       int ntargets, TF_Status* status) {
+  if (session->extend_before_run &&
+      !tensorflow::ExtendSessionGraphHelper(session, status)) {
+    return nullptr;
+  }
+
+  tensorflow::CallableOptions callable_options;
+  for (int i = 0; i < ninputs; ++i) {
+    callable_options.add_feed(tensorflow::strings::StrCat(
+        inputs[i].oper->node.name(), ":", inputs[i].index));
+  }
+  for (int i = 0; i < noutputs; ++i) {
+    callable_options.add_fetch(tensorflow::strings::StrCat(
+        outputs[i].oper->node.name(), ":", outputs[i].index));
+  }
+  for (int i = 0; i < ntargets; ++i) {
+    callable_options.add_target(target_opers[i]->node.name());
+  }
+
+  tensorflow::Session::CallableHandle handle;
+  status->status =
+      session->session->MakeCallable(callable_options, &handle);
+  if (!status->status.ok()) return nullptr;
+
+  TF_PreparedCall* call = new TF_PreparedCall;
+  call->session = session;
+  call->handle = handle;
+  call->ninputs = ninputs;
+  call->noutputs = noutputs;
+  return call;
+}
+
+void TF_PreparedCallRun(TF_PreparedCall* call, TF_Tensor* const* input_values,
+                        TF_Tensor** output_values, TF_Status* status) {
+  for (int i = 0; i < call->noutputs; ++i) {
+    output_values[i] = nullptr;
+  }
+
+  std::vector<tensorflow::Tensor> inputs(call->ninputs);
+  for (int i = 0; i < call->ninputs; ++i) {
+    status->status = tensorflow::TF_TensorToTensor(input_values[i], &inputs[i]);
+    if (!status->status.ok()) return;
+  }
+
+  std::vector<tensorflow::Tensor> outputs;
+  status->status = call->session->session->RunCallable(
+      call->handle, inputs, &outputs, /*run_metadata=*/nullptr);
+  if (!status->status.ok()) return;
+
+  for (int i = 0; i < call->noutputs; ++i) {
+    output_values[i] =
+        tensorflow::TF_TensorFromTensor(outputs[i], &status->status);
+    if (!status->status.ok()) return;
+  }
+}
+
+void TF_DeletePreparedCall(TF_PreparedCall* call, TF_Status* status) {
+  status->status = absl::OkStatus();
+  if (call == nullptr) return;
+  status->status = call->session->session->ReleaseCallable(call->handle);
+  delete call;
+}
+
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status) {
   tensorflow::ServerDef server_def;
   if (!tensorflow::protobuf::TextFormat::ParseFromString(text_proto,
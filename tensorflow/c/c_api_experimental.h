@@ -129,6 +129,39 @@ TF_CAPI_EXPORT extern void TF_EnqueueNamedTensor(TF_Session* session,
                                                  int tensor_id,
                                                  TF_Tensor* tensor,
                                                  TF_Status* status);
+
+// TF_PreparedCall resolves the feeds, fetches and targets of a repeated
+// TF_SessionRun signature once, so that each subsequent run passes only
+// tensor buffers and does no per-call name parsing or feed revalidation.
+// Internally this is backed by the session's MakeCallable/RunCallable
+// interface.
+//
+// A prepared call is only valid for the session it was created from, and must
+// be deleted before that session is closed or deleted.
+typedef struct TF_PreparedCall TF_PreparedCall;
+
+// Creates a prepared call from the same feed/fetch/target specification that
+// TF_SessionRun accepts. On failure, returns nullptr and sets `status`.
+TF_CAPI_EXPORT extern TF_PreparedCall* TF_SessionPrepareCall(
+    TF_Session* session, const TF_Output* inputs, int ninputs,
+    const TF_Output* outputs, int noutputs,
+    const TF_Operation* const* target_opers, int ntargets, TF_Status* status);
+
+// Runs a prepared call. `input_values` must hold one tensor per `inputs`
+// passed to TF_SessionPrepareCall, in the same order; the tensors remain
+// owned by the caller. On success, `output_values` receives one tensor per
+// requested output, and the caller must delete them with TF_DeleteTensor().
+// May be called from multiple threads concurrently.
+TF_CAPI_EXPORT extern void TF_PreparedCallRun(TF_PreparedCall* call,
+                                              TF_Tensor* const* input_values,
+                                              TF_Tensor** output_values,
+                                              TF_Status* status);
+
+// Releases the resources held by a prepared call. `call` must not be used
+// afterwards.
+TF_CAPI_EXPORT extern void TF_DeletePreparedCall(TF_PreparedCall* call,
+                                                 TF_Status* status);
+
 // Create a serialized tensorflow.ServerDef proto.
 TF_Buffer* TFE_GetServerDef(const char* text_proto, TF_Status* status);
 
@@ -35,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/op_def.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/grappler/utils/transitive_fanin.h"
 #include "tensorflow/core/lib/io/path.h"
 #include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/lib/monitoring/sampler.h"
@@ -268,6 +269,96 @@ Status RunRestore(const RunOptions& run_options, const string& export_dir,
                  nullptr /* outputs */, &run_metadata, session);
 }
 
+// Appends the name of each graph tensor referenced by `tensor_info` to
+// `nodes`.
+Status AddTensorInfoNodes(const TensorInfo& tensor_info,
+                          std::vector<string>* nodes) {
+  switch (tensor_info.encoding_case()) {
+    case TensorInfo::kName:
+      nodes->push_back(tensor_info.name());
+      return absl::OkStatus();
+    case TensorInfo::kCooSparse:
+      nodes->push_back(tensor_info.coo_sparse().values_tensor_name());
+      nodes->push_back(tensor_info.coo_sparse().indices_tensor_name());
+      nodes->push_back(tensor_info.coo_sparse().dense_shape_tensor_name());
+      return absl::OkStatus();
+    case TensorInfo::kCompositeTensor:
+      for (const auto& component :
+           tensor_info.composite_tensor().components()) {
+        nodes->push_back(component.name());
+      }
+      return absl::OkStatus();
+    default:
+      return absl::InvalidArgumentError(
+          "SignatureDef TensorInfo does not reference a tensor.");
+  }
+}
+
+// Restricts `meta_graph_def` to what is needed to run the signatures named in
+// `signature_keys`: the transitive fanin of their input and output tensors,
+// plus the restore, initialization and asset-feed nodes that RestoreSession
+// relies on. Signatures that were not requested are dropped from the
+// SignatureDef map so callers cannot accidentally run against pruned-away
+// graph nodes.
+Status PruneMetaGraphDefToSignatures(
+    const string& export_dir, const std::unordered_set<string>& signature_keys,
+    MetaGraphDef* meta_graph_def) {
+  std::vector<string> terminal_nodes;
+  for (const string& key : signature_keys) {
+    const auto signature_it = meta_graph_def->signature_def().find(key);
+    if (signature_it == meta_graph_def->signature_def().end()) {
+      return absl::NotFoundError(strings::StrCat(
+          "Could not find SignatureDef with key: ", key, " in MetaGraphDef"));
+    }
+    for (const auto& input : signature_it->second.inputs()) {
+      TF_RETURN_IF_ERROR(AddTensorInfoNodes(input.second, &terminal_nodes));
+    }
+    for (const auto& output : signature_it->second.outputs()) {
+      TF_RETURN_IF_ERROR(AddTensorInfoNodes(output.second, &terminal_nodes));
+    }
+  }
+  if (meta_graph_def->has_saver_def()) {
+    terminal_nodes.push_back(meta_graph_def->saver_def().restore_op_name());
+    terminal_nodes.push_back(
+        meta_graph_def->saver_def().filename_tensor_name());
+  }
+  string init_op_name;
+  TF_RETURN_IF_ERROR(
+      internal::GetInitOp(export_dir, *meta_graph_def, &init_op_name));
+  if (!init_op_name.empty()) {
+    terminal_nodes.push_back(init_op_name);
+  }
+  std::vector<AssetFileDef> asset_file_defs;
+  TF_RETURN_IF_ERROR(
+      internal::GetAssetFileDefs(*meta_graph_def, &asset_file_defs));
+  for (const AssetFileDef& asset_file_def : asset_file_defs) {
+    terminal_nodes.push_back(asset_file_def.tensor_info().name());
+  }
+
+  GraphDef pruned_graph_def;
+  TF_RETURN_IF_ERROR(grappler::SetTransitiveFaninGraph(
+      meta_graph_def->graph_def(), &pruned_graph_def, terminal_nodes));
+  // SetTransitiveFaninGraph only fills in nodes; the function library and
+  // op-version metadata still apply to the pruned graph.
+  *pruned_graph_def.mutable_versions() = meta_graph_def->graph_def().versions();
+  *pruned_graph_def.mutable_library() = meta_graph_def->graph_def().library();
+  *meta_graph_def->mutable_graph_def() = std::move(pruned_graph_def);
+
+  std::vector<string> unrequested_signatures;
+  for (const auto& entry : meta_graph_def->signature_def()) {
+    // The init-op signature is consulted again by RestoreSession, so it is
+    // retained even though callers never request it explicitly.
+    if (signature_keys.count(entry.first) == 0 &&
+        entry.first != kSavedModelInitOpSignatureKey) {
+      unrequested_signatures.push_back(entry.first);
+    }
+  }
+  for (const string& key : unrequested_signatures) {
+    meta_graph_def->mutable_signature_def()->erase(key);
+  }
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 SavedModelBundleInterface::~SavedModelBundleInterface() = default;
@@ -296,9 +387,14 @@ Status LoadSavedModelInternal(const SessionOptions& session_options,
                               const RunOptions& run_options,
                               const string& export_dir,
                               const std::unordered_set<string>& tags,
+                              const std::unordered_set<string>& signature_keys,
                               SavedModelBundle* const bundle) {
   TF_RETURN_IF_ERROR(ReadMetaGraphDefFromSavedModel(export_dir, tags,
                                                     &bundle->meta_graph_def));
+  if (!signature_keys.empty()) {
+    TF_RETURN_IF_ERROR(PruneMetaGraphDefToSignatures(
+        export_dir, signature_keys, &bundle->meta_graph_def));
+  }
   TF_RETURN_IF_ERROR(
       ReadSavedModelDebugInfoIfPresent(export_dir, &bundle->debug_info));
   TF_RETURN_IF_ERROR(LoadMetagraphIntoSession(
@@ -423,10 +519,15 @@ Status LoadSavedModelInternal(const SessionOptions& session_options,
                               const RunOptions& run_options,
                               const string& export_dir,
                               const std::unordered_set<string>& tags,
+                              const std::unordered_set<string>& signature_keys,
                               SavedModelBundleLite* const bundle) {
   MetaGraphDef meta_graph_def;
   TF_RETURN_IF_ERROR(
       ReadMetaGraphDefFromSavedModel(export_dir, tags, &meta_graph_def));
+  if (!signature_keys.empty()) {
+    TF_RETURN_IF_ERROR(PruneMetaGraphDefToSignatures(export_dir, signature_keys,
+                                                     &meta_graph_def));
+  }
   std::unique_ptr<Session> session;
   TF_RETURN_IF_ERROR(LoadGraphDefIntoSession(
       session_options, std::move(*meta_graph_def.mutable_graph_def()),
@@ -444,6 +545,7 @@ Status LoadSavedModelGeneric(const SessionOptions& session_options,
                              const RunOptions& run_options,
                              const string& export_dir,
                              const std::unordered_set<string>& tags,
+                             const std::unordered_set<string>& signature_keys,
                              BundleType* const bundle) {
   metrics::SavedModelReadApi(kCCLoadLabel).IncrementBy(1);
   auto fingerprint_proto =
@@ -456,8 +558,8 @@ Status LoadSavedModelGeneric(const SessionOptions& session_options,
 
   // TODO(robson): Add tests for the counters.
   const uint64 start_microseconds = Env::Default()->NowMicros();
-  const Status status = LoadSavedModelInternal(session_options, run_options,
-                                               export_dir, tags, bundle);
+  const Status status = LoadSavedModelInternal(
+      session_options, run_options, export_dir, tags, signature_keys, bundle);
   auto log_and_count = [&](const string& status_str) {
     LOG(INFO) << "SavedModel load for tags { " << absl::StrJoin(tags, " ")
               << " }; Status: " << status_str << ": " << status << ". Took "
@@ -479,8 +581,18 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const RunOptions& run_options, const string& export_dir,
                       const std::unordered_set<string>& tags,
                       SavedModelBundle* const bundle) {
-  return LoadSavedModelGeneric<SavedModelBundle>(session_options, run_options,
-                                                 export_dir, tags, bundle);
+  return LoadSavedModelGeneric<SavedModelBundle>(
+      session_options, run_options, export_dir, tags,
+      /*signature_keys=*/{}, bundle);
+}
+
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundle* const bundle) {
+  return LoadSavedModelGeneric<SavedModelBundle>(
+      session_options, run_options, export_dir, tags, signature_keys, bundle);
 }
 
 Status RestoreSession(const RunOptions& run_options,
@@ -518,6 +630,15 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const RunOptions& run_options, const string& export_dir,
                       const std::unordered_set<string>& tags,
                       SavedModelBundleLite* const bundle) {
+  return LoadSavedModel(session_options, run_options, export_dir, tags,
+                        /*signature_keys=*/{}, bundle);
+}
+
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundleLite* const bundle) {
   SessionOptions rewritten_options(session_options);
   // We disallow calls to Session::Extend() on the returned session, so we can
   // reduce memory consumption by not storing the original GraphDef.
@@ -531,7 +652,8 @@ Status LoadSavedModel(const SessionOptions& session_options,
   // TODO(mrry): Consider specializing the session creation to reduce peak
   // RAM consumption by using `Session::Create(GraphDef&&)`.
   TF_RETURN_IF_ERROR(LoadSavedModelGeneric(rewritten_options, run_options,
-                                           export_dir, tags, bundle));
+                                           export_dir, tags, signature_keys,
+                                           bundle));
   return absl::OkStatus();
 }
 
@@ -123,6 +123,19 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundle* bundle);
 
+/// Like the above, but restricts the loaded graph to the subgraph needed to
+/// serve the signatures named in `signature_keys` (plus the variable-restore
+/// and initialization ops). For multi-signature SavedModels this avoids
+/// constructing and optimizing graph nodes that only unrequested signatures
+/// reach. Unrequested signatures are dropped from the bundle's MetaGraphDef;
+/// returns NotFound if a requested key has no SignatureDef. An empty
+/// `signature_keys` set loads the full graph.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundle* bundle);
+
 /// Loads a SavedModel from the specified export directory. The MetaGraphDef
 /// to be loaded is identified by the supplied tags, corresponding exactly to
 /// the set of tags used at SavedModel build time. Stores a SavedModel bundle
@@ -135,6 +148,15 @@ Status LoadSavedModel(const SessionOptions& session_options,
                       const std::unordered_set<string>& tags,
                       SavedModelBundleLite* bundle);
 
+/// Like the above, but restricts the loaded graph to the subgraph needed to
+/// serve the signatures named in `signature_keys`. See the SavedModelBundle
+/// overload above for the pruning semantics.
+Status LoadSavedModel(const SessionOptions& session_options,
+                      const RunOptions& run_options, const string& export_dir,
+                      const std::unordered_set<string>& tags,
+                      const std::unordered_set<string>& signature_keys,
+                      SavedModelBundleLite* bundle);
+
 /// Checks whether the provided directory could contain a SavedModel. Note that
 /// the method does not load any data by itself. If the method returns `false`,
 /// the export directory definitely does not contain a SavedModel. If the method
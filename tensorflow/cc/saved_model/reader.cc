@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/cc/saved_model/reader.h"
 
+#include <climits>
+#include <cstdint>
 #include <memory>
 #include <string>
 #include <unordered_set>
@@ -34,8 +36,10 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/file_system_helper.h"
 #include "tensorflow/core/platform/path.h"
+#include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/meta_graph.pb.h"
@@ -46,6 +50,178 @@ limitations under the License.
 #define IS_OSS true
 
 namespace tensorflow {
+namespace {
+
+// A ZeroCopyInputStream over a RandomAccessFile, mirroring the stream that
+// `ReadBinaryProto` uses internally.  `Skip` only advances the file offset,
+// so wire-level skips never touch the disk.
+class RandomAccessFileStream : public protobuf::io::ZeroCopyInputStream {
+ public:
+  RandomAccessFileStream(RandomAccessFile* file, int64_t pos)
+      : file_(file), pos_(pos) {}
+
+  void BackUp(int count) override { pos_ -= count; }
+  bool Skip(int count) override {
+    pos_ += count;
+    return true;
+  }
+  int64_t ByteCount() const override { return pos_; }
+  Status status() const { return status_; }
+
+  bool Next(const void** data, int* size) override {
+    StringPiece result;
+    Status s = file_->Read(pos_, kBufSize, &result, scratch_);
+    if (result.empty()) {
+      status_ = s;
+      return false;
+    }
+    pos_ += result.size();
+    *data = result.data();
+    *size = result.size();
+    return true;
+  }
+
+ private:
+  static constexpr int kBufSize = 512 << 10;
+
+  RandomAccessFile* const file_;
+  int64_t pos_;
+  Status status_;
+  char scratch_[kBufSize];
+};
+
+// Reads the tag strings of a single wire-encoded MetaGraphDef from `coded`,
+// which must be limited to the extent of that MetaGraphDef, skipping every
+// other field.  Returns false if the message is malformed.
+bool ReadMetaGraphTags(protobuf::io::CodedInputStream* coded,
+                       std::unordered_set<string>* tags) {
+  using protobuf::internal::WireFormatLite;
+  uint32 tag;
+  while ((tag = coded->ReadTag()) != 0) {
+    if (WireFormatLite::GetTagFieldNumber(tag) ==
+            MetaGraphDef::kMetaInfoDefFieldNumber &&
+        WireFormatLite::GetTagWireType(tag) ==
+            WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      uint32 length;
+      if (!coded->ReadVarint32(&length)) return false;
+      const auto limit = coded->PushLimit(length);
+      uint32 info_tag;
+      while ((info_tag = coded->ReadTag()) != 0) {
+        if (WireFormatLite::GetTagFieldNumber(info_tag) ==
+                MetaGraphDef::MetaInfoDef::kTagsFieldNumber &&
+            WireFormatLite::GetTagWireType(info_tag) ==
+                WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+          string graph_tag;
+          if (!WireFormatLite::ReadString(coded, &graph_tag)) return false;
+          tags->insert(std::move(graph_tag));
+        } else if (!WireFormatLite::SkipField(coded, info_tag)) {
+          return false;
+        }
+      }
+      coded->PopLimit(limit);
+    } else if (!WireFormatLite::SkipField(coded, tag)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+// Streams saved_model.pb at `fname`, parsing only the MetaGraphDef whose tag
+// set matches `tags`.  The tag sets of the `meta_graphs` entries are decoded
+// with a shallow scan that skips the (typically dominant) graph bytes at the
+// wire level, so peak memory is proportional to the one MetaGraphDef that is
+// kept rather than to the whole SavedModel.  Scanning restarts the
+// CodedInputStream at each entry boundary, so files larger than the 2GB proto
+// limit can be read as long as each individual meta graph stays below it.
+Status StreamMetaGraphDefFromFile(const string& fname,
+                                  const std::unordered_set<string>& tags,
+                                  MetaGraphDef* const meta_graph_def) {
+  using protobuf::internal::WireFormatLite;
+  std::unique_ptr<RandomAccessFile> file;
+  TF_RETURN_IF_ERROR(Env::Default()->NewRandomAccessFile(fname, &file));
+  uint64 file_size;
+  TF_RETURN_IF_ERROR(Env::Default()->GetFileSize(fname, &file_size));
+
+  int64_t matched_offset = -1;
+  uint32 matched_length = 0;
+  int num_meta_graphs = 0;
+  int64_t offset = 0;
+  while (offset < static_cast<int64_t>(file_size)) {
+    auto stream = std::make_unique<RandomAccessFileStream>(file.get(), offset);
+    protobuf::io::CodedInputStream coded(stream.get());
+    coded.SetTotalBytesLimit(INT_MAX);
+    const uint32 tag = coded.ReadTag();
+    if (tag == 0) {
+      TF_RETURN_IF_ERROR(stream->status());
+      return errors::DataLoss("Can't parse ", fname, " as binary proto");
+    }
+    if (WireFormatLite::GetTagFieldNumber(tag) ==
+            SavedModel::kMetaGraphsFieldNumber &&
+        WireFormatLite::GetTagWireType(tag) ==
+            WireFormatLite::WIRETYPE_LENGTH_DELIMITED) {
+      uint32 length;
+      if (!coded.ReadVarint32(&length)) {
+        TF_RETURN_IF_ERROR(stream->status());
+        return errors::DataLoss("Can't parse ", fname, " as binary proto");
+      }
+      const int64_t entry_offset = offset + coded.CurrentPosition();
+      ++num_meta_graphs;
+      std::unordered_set<string> graph_tags;
+      const auto limit = coded.PushLimit(length);
+      if (!ReadMetaGraphTags(&coded, &graph_tags)) {
+        TF_RETURN_IF_ERROR(stream->status());
+        return errors::DataLoss("Can't parse ", fname, " as binary proto");
+      }
+      coded.PopLimit(limit);
+      if (matched_offset < 0 && graph_tags == tags) {
+        matched_offset = entry_offset;
+        matched_length = length;
+      }
+      offset = entry_offset + length;
+    } else {
+      if (!WireFormatLite::SkipField(&coded, tag)) {
+        TF_RETURN_IF_ERROR(stream->status());
+        return errors::DataLoss("Can't parse ", fname, " as binary proto");
+      }
+      offset += coded.CurrentPosition();
+    }
+  }
+  if (matched_offset < 0) {
+    return Status(
+        absl::StatusCode::kNotFound,
+        strings::StrCat(
+            "Could not find meta graph def matching supplied tags: { ",
+            absl::StrJoin(tags, " "),
+            " }. To inspect available tag-sets in the SavedModel, please "
+            "use the SavedModel CLI: `saved_model_cli`"));
+  }
+
+  auto stream =
+      std::make_unique<RandomAccessFileStream>(file.get(), matched_offset);
+  protobuf::io::CodedInputStream coded(stream.get());
+  coded.SetTotalBytesLimit(INT_MAX);
+  const auto limit = coded.PushLimit(matched_length);
+  if (!meta_graph_def->ParseFromCodedStream(&coded) ||
+      !coded.ConsumedEntireMessage()) {
+    TF_RETURN_IF_ERROR(stream->status());
+    return errors::DataLoss("Can't parse ", fname, " as binary proto");
+  }
+  coded.PopLimit(limit);
+
+  // Correct the endianness of Tensor content on big-endian systems.
+  if (!port::kLittleEndian) {
+    TF_RETURN_IF_ERROR(ByteSwapTensorContentInMetaGraphDef(meta_graph_def));
+  }
+  // Report the same "WriteVersion" ReadSavedModel would have derived from the
+  // full proto (see `saved_model::GetWriteVersion`).
+  metrics::SavedModelReadCount(
+      num_meta_graphs == 1 && meta_graph_def->has_object_graph_def() ? "2"
+                                                                     : "1")
+      .IncrementBy(1);
+  return absl::OkStatus();
+}
+
+}  // namespace
 
 absl::StatusOr<MetaGraphDef*> FindMetaGraphDef(
     const std::unordered_set<string>& tags, SavedModel* saved_model_proto) {
@@ -133,6 +309,21 @@ Status ReadSavedModel(absl::string_view export_dir,
 Status ReadMetaGraphDefFromSavedModel(absl::string_view export_dir,
                                       const std::unordered_set<string>& tags,
                                       MetaGraphDef* const meta_graph_def) {
+  if (IS_OSS) {
+    const std::string saved_model_pb_path =
+        io::JoinPath(export_dir, kSavedModelFilenamePb);
+    TF_ASSIGN_OR_RETURN(
+        bool saved_model_pb_exists,
+        internal::FileExists(Env::Default(), saved_model_pb_path));
+    if (saved_model_pb_exists) {
+      LOG(INFO) << "Reading meta graph with tags { " << absl::StrJoin(tags, " ")
+                << " } from " << saved_model_pb_path;
+      return StreamMetaGraphDefFromFile(saved_model_pb_path, tags,
+                                        meta_graph_def);
+    }
+  }
+  // Fall back to materializing the whole SavedModel for the formats that
+  // cannot be streamed (pbtxt, and chunked protos outside of OSS).
   SavedModel saved_model_proto;
   TF_RETURN_IF_ERROR(ReadSavedModel(export_dir, &saved_model_proto));
   TF_ASSIGN_OR_RETURN(MetaGraphDef * m,
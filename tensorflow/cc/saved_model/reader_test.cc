@@ -73,6 +73,24 @@ TEST_F(ReaderTest, TagMatch) {
   CheckMetaGraphDef(meta_graph_def);
 }
 
+TEST_F(ReaderTest, StreamedReadMatchesFullRead) {
+  MetaGraphDef meta_graph_def;
+
+  const string export_dir = GetDataDependencyFilepath(TestDataSharded());
+  TF_ASSERT_OK(ReadMetaGraphDefFromSavedModel(export_dir, {kSavedModelTagServe},
+                                              &meta_graph_def));
+
+  // The streamed parse must be indistinguishable from materializing the whole
+  // SavedModel and picking the matching meta graph out of it.
+  SavedModel saved_model_proto;
+  TF_ASSERT_OK(ReadSavedModel(export_dir, &saved_model_proto));
+  auto full_meta_graph_def =
+      FindMetaGraphDef({kSavedModelTagServe}, &saved_model_proto);
+  TF_ASSERT_OK(full_meta_graph_def.status());
+  EXPECT_EQ(meta_graph_def.DebugString(),
+            (*full_meta_graph_def)->DebugString());
+}
+
 TEST_F(ReaderTest, NoTagMatch) {
   MetaGraphDef meta_graph_def;
 
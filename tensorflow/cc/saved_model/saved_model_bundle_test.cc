@@ -13,6 +13,7 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include "absl/status/status.h"
 #include "tensorflow/cc/saved_model/constants.h"
 #include "tensorflow/cc/saved_model/loader.h"
 #include "tensorflow/cc/saved_model/metrics.h"
@@ -141,6 +142,38 @@ TEST_F(LoaderTest, TagMatch) {
   CheckSavedModelBundle(export_dir, bundle);
 }
 
+TEST_F(LoaderTest, SignatureScopedLoad) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  TF_ASSERT_OK(LoadSavedModel(session_options, run_options, export_dir,
+                              {kSavedModelTagServe}, {"regress_x_to_y"},
+                              &bundle));
+  // The requested signature remains runnable; the others have been pruned
+  // from the MetaGraphDef along with the graph nodes only they reach.
+  CheckSavedModelBundle(export_dir, bundle);
+  EXPECT_EQ(bundle.meta_graph_def.signature_def().count("regress_x_to_y"), 1);
+  EXPECT_EQ(bundle.meta_graph_def.signature_def().count("serving_default"), 0);
+  EXPECT_EQ(bundle.meta_graph_def.signature_def().count("classify_x_to_y"), 0);
+}
+
+TEST_F(LoaderTest, SignatureScopedLoadMissingSignature) {
+  SavedModelBundle bundle;
+  SessionOptions session_options;
+  RunOptions run_options;
+
+  const string export_dir =
+      io::JoinPath(testing::TensorFlowSrcRoot(), kTestDataSharded);
+  Status st = LoadSavedModel(session_options, run_options, export_dir,
+                             {kSavedModelTagServe}, {"missing-signature"},
+                             &bundle);
+  EXPECT_FALSE(st.ok());
+  EXPECT_TRUE(absl::IsNotFound(st)) << st.message();
+}
+
 TEST_F(LoaderTest, ReadMetaGraphFromSavedModel) {
   SavedModelBundle bundle;
   SessionOptions session_options;
@@ -42,6 +42,19 @@ bool ShouldBeMegamorphic(int64_t compile_count, int64_t execution_count) {
          execution_count < kMinExecutionsPerCompile * compile_count;
 }
 
+// Process-wide compilation statistics, aggregated over all profiler instances
+// (profilers are per-device resources).  Guarded by their own mutex so that
+// snapshots don't contend with per-profiler locks.
+mutex* GlobalCompileStatsMu() {
+  static mutex* mu = new mutex;
+  return mu;
+}
+
+DeviceCompilationProfiler::GlobalCompileStats* MutableGlobalCompileStats() {
+  static auto* stats = new DeviceCompilationProfiler::GlobalCompileStats;
+  return stats;
+}
+
 void RegisterExecutionForCluster(
     const NameAttrList& function,
     DeviceCompilationProfiler::ClusterCompileStats* stats) {
@@ -55,6 +68,9 @@ void RegisterExecutionForCluster(
             << " as megamorphic, compile_count=" << stats->compile_count
             << " execution_count=" << stats->execution_count;
     stats->is_megamorphic = true;
+
+    mutex_lock global_lock(*GlobalCompileStatsMu());
+    ++MutableGlobalCompileStats()->megamorphic_cluster_count;
   }
 }
 
@@ -72,6 +88,12 @@ DeviceCompilationProfiler::~DeviceCompilationProfiler() {
   cluster_compile_stats_.clear();
 }
 
+DeviceCompilationProfiler::GlobalCompileStats
+DeviceCompilationProfiler::GetGlobalCompileStats() {
+  mutex_lock global_lock(*GlobalCompileStatsMu());
+  return *MutableGlobalCompileStats();
+}
+
 absl::StatusOr<DeviceCompilationProfiler::ClusterCompileStats>
 DeviceCompilationProfiler::GetCompileStats(const NameAttrList& function) const {
   mutex_lock lock(mu_);
@@ -110,6 +132,16 @@ Status DeviceCompilationProfiler::RegisterCompilation(
   const uint64 compile_time_s = compile_time_us / 1.0e6;
   it->second.compile_count++;
   it->second.cumulative_compile_time_us += compile_time_us;
+
+  {
+    mutex_lock global_lock(*GlobalCompileStatsMu());
+    auto* global_stats = MutableGlobalCompileStats();
+    ++global_stats->compile_count;
+    if (it->second.compile_count > 1) {
+      ++global_stats->recompile_count;
+    }
+    global_stats->cumulative_compile_time_us += compile_time_us;
+  }
   VLOG(1) << "Compiled " << function_name << " " << it->second.compile_count
           << " times, compile time: " << compile_time_us
           << " us, cumulative: " << it->second.cumulative_compile_time_us
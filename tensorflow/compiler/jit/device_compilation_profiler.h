@@ -55,6 +55,27 @@ class DeviceCompilationProfiler : public ResourceBase {
     }
   };
 
+  // Process-wide aggregates across all profiler instances.  Consumed by
+  // auto-clustering (see MarkForCompilationPass) to weigh predicted fusion
+  // benefit against the compilation cost observed so far in this process.
+  struct GlobalCompileStats {
+    // Total number of cluster compilations.
+    int64_t compile_count = 0;
+
+    // Compilations beyond the first for a given cluster, i.e. recompilations
+    // caused by changing shapes.
+    int64_t recompile_count = 0;
+
+    // Cumulative time spent compiling clusters.
+    int64_t cumulative_compile_time_us = 0;
+
+    // Number of clusters that have been marked megamorphic.
+    int64_t megamorphic_cluster_count = 0;
+  };
+
+  // Returns a snapshot of the process-wide compilation statistics.
+  static GlobalCompileStats GetGlobalCompileStats();
+
   // Returns the compilation statistics for the given cluster.
   absl::StatusOr<ClusterCompileStats> GetCompileStats(
       const NameAttrList& function) const;
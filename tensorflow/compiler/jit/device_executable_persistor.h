@@ -28,9 +28,12 @@ limitations under the License.
 #include "xla/util.h"
 #include "tensorflow/core/framework/device.h"
 #include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/path.h"
 #include "tensorflow/core/platform/status.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/public/version.h"
 #include "tsl/platform/statusor.h"
 
 namespace tensorflow {
@@ -128,7 +131,9 @@ class DeviceExecutablePersistor {
       DeviceCompilerClient<ExecutableType, ClientType>* compiler_client) const;
 
   // Saves the cache entry in the file directory supplied during the
-  // construction of this class. Overwrites existing entries.
+  // construction of this class. Entries are immutable once written (the key
+  // includes the TF version), so the write is skipped if the entry already
+  // exists on disk or another process on this host is currently writing it.
   Status SaveSerializedEntry(const XlaSerializedCacheEntry& entry) const;
 
   // Tries to read a cache entry given a `key` by searching the file directory
@@ -180,7 +185,7 @@ std::string DeviceExecutablePersistor<ExecutableType, ClientType>::
       key.prefix(), key.prefix().empty() ? "" : kXlaSerializedCacheKeySeparator,
       key.signature_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.cluster_fingerprint(), kXlaSerializedCacheKeySeparator,
-      key.device_type(),
+      key.device_type(), kXlaSerializedCacheKeySeparator, key.tf_version(),
       key.compiled_using_pjrt()
           ? absl::StrCat(kXlaSerializedCacheKeySeparator, "pjrt")
           : "");
@@ -205,6 +210,7 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::BuildSerializedCacheKey(
   key.set_device_type(device_type().type_string());
   key.set_prefix(persistence_prefix());
   key.set_compiled_using_pjrt(compiled_using_pjrt);
+  key.set_tf_version(TF_VERSION_STRING);
   return key;
 }
 
@@ -281,6 +287,37 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::SaveSerializedEntry(
   Env* env = Env::Default();
   TF_RETURN_IF_ERROR(env->RecursivelyCreateDir(persistent_cache_directory_));
 
+  const std::string file_path = GetFilePath(entry.key());
+  if (env->FileExists(file_path).ok()) {
+    VLOG(1) << "Not saving " << file_path << "; the entry already exists.";
+    return absl::OkStatus();
+  }
+
+  // Take a best-effort advisory lock so that concurrent processes on this
+  // host don't write the same entry simultaneously.  Directory creation is
+  // atomic on the filesystems we care about, which makes the lock directory
+  // usable as a cross-process mutex.  Entries are immutable once written, so
+  // if another process holds the lock we can simply skip the write.
+  const std::string lock_path = absl::StrCat(file_path, ".lock");
+  const Status lock_status = env->CreateDir(lock_path);
+  if (!lock_status.ok()) {
+    if (!errors::IsAlreadyExists(lock_status)) {
+      return lock_status;
+    }
+    // Steal the lock only if it looks abandoned (e.g. its writer crashed).
+    constexpr int64_t kStaleEntryWriteLockMicros = 10 * 60 * 1000 * 1000LL;
+    FileStatistics lock_stat;
+    if (!env->Stat(lock_path, &lock_stat).ok() ||
+        static_cast<int64_t>(env->NowMicros()) -
+                lock_stat.mtime_nsec / EnvTime::kMicrosToNanos <
+            kStaleEntryWriteLockMicros) {
+      VLOG(1) << "Not saving " << file_path
+              << "; another process is writing it (lock: " << lock_path
+              << ").";
+      return absl::OkStatus();
+    }
+  }
+
   // The cache on the filesystem can be read while we're writing out the proto.
   // To prevent reads of partially-written files, we write the proto to a temp
   // file, then move it into place once we're done writing.  And we warn the
@@ -301,12 +338,18 @@ DeviceExecutablePersistor<ExecutableType, ClientType>::SaveSerializedEntry(
   // final location.
   std::string temp_path = io::JoinPath(
       persistent_cache_directory_, XlaSerializedCacheKeyToString(entry.key()));
+  Status save_status;
   if (!env->CreateUniqueFileName(&temp_path, ".pb.tmp")) {
-    return absl::UnavailableError(absl::StrCat(
+    save_status = absl::UnavailableError(absl::StrCat(
         "Could not create a unique file inside ", persistent_cache_directory_));
+  } else {
+    save_status = WriteBinaryProto(env, temp_path, entry);
+    if (save_status.ok()) {
+      save_status = env->RenameFile(temp_path, file_path);
+    }
   }
-  TF_RETURN_IF_ERROR(WriteBinaryProto(env, temp_path, entry));
-  return env->RenameFile(temp_path, GetFilePath(entry.key()));
+  env->DeleteDir(lock_path).IgnoreError();
+  return save_status;
 }
 
 template <typename ExecutableType, typename ClientType>
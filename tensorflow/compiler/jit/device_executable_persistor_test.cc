@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status_matchers.h"
 #include "tensorflow/core/platform/statusor.h"
+#include "tensorflow/core/public/version.h"
 #include "tensorflow/core/tfrt/common/create_pjrt_client_util.h"
 #include "tensorflow/core/tfrt/common/pjrt_util.h"
 
@@ -202,7 +203,7 @@ std::string GetFilePath(XlaSerializedCacheKey key,
       key.prefix(), key.prefix().empty() ? "" : kXlaSerializedCacheKeySeparator,
       key.signature_fingerprint(), kXlaSerializedCacheKeySeparator,
       key.cluster_fingerprint(), kXlaSerializedCacheKeySeparator,
-      key.device_type(),
+      key.device_type(), kXlaSerializedCacheKeySeparator, key.tf_version(),
       key.compiled_using_pjrt()
           ? absl::StrCat(kXlaSerializedCacheKeySeparator, "pjrt")
           : "",
@@ -231,6 +232,7 @@ XlaSerializedCacheKey CreateCacheKey(
   key.set_device_type(device_type.type_string());
   key.set_prefix(persistence_prefix);
   key.set_compiled_using_pjrt(compiled_using_pjrt);
+  key.set_tf_version(TF_VERSION_STRING);
   return key;
 }
 
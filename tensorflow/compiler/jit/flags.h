@@ -93,6 +93,12 @@ struct MarkForCompilationPassFlags {
   // so that they remain stable from run to run of auto clusteing.
   bool tf_xla_deterministic_cluster_names;
 
+  // If true, auto-clustering weighs the predicted benefit of fusion against
+  // the compilation cost observed so far in this process (compile times and
+  // recompilation counts reported by DeviceCompilationProfiler) and only
+  // forms clusters that are predicted to come out ahead.
+  bool tf_xla_cost_guided_clustering;
+
   // If non-empty, JIT-compiled executables are saved to and loaded from the
   // specified file system directory path.
   std::string tf_xla_persistent_cache_directory;
@@ -38,6 +38,7 @@ limitations under the License.
 #include "tensorflow/compiler/jit/compilability_check_util.h"
 #include "tensorflow/compiler/jit/deadness_analysis.h"
 #include "tensorflow/compiler/jit/defs.h"
+#include "tensorflow/compiler/jit/device_compilation_profiler.h"
 #include "tensorflow/compiler/jit/device_util.h"
 #include "tensorflow/compiler/jit/flags.h"
 #include "tensorflow/compiler/jit/resource_operation_safety_analysis.h"
@@ -109,6 +110,11 @@ class MarkForCompilationPassImpl {
     // stable from run to rum.
     bool deterministic_cluster_names;
 
+    // If true, weigh each cluster's predicted fusion benefit against the
+    // compilation cost observed so far in this process before marking it for
+    // compilation.
+    bool cost_guided_clustering;
+
     int max_cluster_size;
     int min_cluster_size;
 
@@ -959,6 +965,21 @@ int64_t GetNextClusterSequenceNumber(uint64 fingerprint) {
   return ClusterSequenceNumberGenerator::Global().GetNext(fingerprint);
 }
 
+// Returns true for ops whose XLA lowering does substantial arithmetic per
+// element.  Clusters containing at least one of these have something to gain
+// from fusing the surrounding elementwise work; clusters without any must
+// clear a higher size bar under cost-guided clustering because they save
+// mostly kernel launch overhead and memory traffic.
+bool IsHighArithmeticIntensityOp(const string& type) {
+  static const auto* const kOps = new absl::flat_hash_set<string>{
+      "MatMul", "BatchMatMul", "BatchMatMulV2", "BatchMatMulV3", "Einsum",
+      "Conv2D", "Conv2DBackpropFilter", "Conv2DBackpropInput", "Conv3D",
+      "DepthwiseConv2dNative", "FusedBatchNorm", "FusedBatchNormV2",
+      "FusedBatchNormV3", "Softmax", "LogSoftmax", "Sum", "Mean", "Prod",
+      "Max", "Min", "ArgMax", "ArgMin"};
+  return kOps->contains(type);
+}
+
 Status MarkForCompilationPassImpl::CreateClusters() {
   TF_RET_CHECK(initialized_ && edges_contracted_ && !clusters_created_);
   clusters_created_ = true;
@@ -970,6 +991,30 @@ Status MarkForCompilationPassImpl::CreateClusters() {
     DumpGraphToFile("before_mark_for_compilation", *graph_, flib_def_);
   }
 
+  // Under cost-guided clustering, determine which clusters contain at least
+  // one high-arithmetic-intensity op, and derive the size bar every cluster
+  // must clear from the compilation cost observed so far in this process.
+  absl::flat_hash_set<int> high_intensity_clusters;
+  int cost_guided_size_multiplier = 1;
+  if (debug_options_.cost_guided_clustering) {
+    for (Node* n : compilation_candidates_) {
+      Cluster* cluster = GetClusterForNode(n);
+      if (cluster != nullptr && IsHighArithmeticIntensityOp(n->type_string())) {
+        high_intensity_clusters.insert(cluster->cycles_graph_node_id());
+      }
+    }
+
+    // If shape volatility is already forcing frequent recompilation, demand
+    // bigger clusters so that each (re-)compile is amortized over more fused
+    // work.
+    const DeviceCompilationProfiler::GlobalCompileStats global_stats =
+        DeviceCompilationProfiler::GetGlobalCompileStats();
+    if (global_stats.megamorphic_cluster_count > 0 ||
+        global_stats.recompile_count * 2 > global_stats.compile_count) {
+      cost_guided_size_multiplier = 2;
+    }
+  }
+
   // Mark clusters for compilation that:
   // * are placed on a device that requires compilation (an XlaDevice),
   // * are explicitly marked for compilation (_XlaCompile=true), or
@@ -989,7 +1034,17 @@ Status MarkForCompilationPassImpl::CreateClusters() {
     // to (recursively) verify this fact, but that's probably not worth the
     // trouble.
 
-    if (cluster->effective_cluster_size() >= debug_options_.min_cluster_size ||
+    int min_cluster_size = debug_options_.min_cluster_size;
+    if (debug_options_.cost_guided_clustering) {
+      min_cluster_size *= cost_guided_size_multiplier;
+      if (!high_intensity_clusters.contains(cluster->cycles_graph_node_id())) {
+        // Fusion-only clusters need more fused elementwise work before the
+        // predicted runtime win covers the compile cost.
+        min_cluster_size *= 2;
+      }
+    }
+
+    if (cluster->effective_cluster_size() >= min_cluster_size ||
         cluster->has_functional_control_flow() ||
         cluster->is_xla_compile_attr_true()) {
       string& name = cluster_names[cluster->cycles_graph_node_id()];
@@ -1920,6 +1975,7 @@ Status MarkForCompilationPass::Run(
   debug_options.ignore_xla_compile_attr = false;
   debug_options.deterministic_cluster_names =
       flags->tf_xla_deterministic_cluster_names;
+  debug_options.cost_guided_clustering = flags->tf_xla_cost_guided_clustering;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
@@ -1939,6 +1995,7 @@ Status MarkForCompilationPass::RunForTest(
       flags->tf_xla_disable_resource_variable_safety_checks_for_debugging;
   debug_options.ignore_xla_compile_attr = true;
   debug_options.deterministic_cluster_names = deterministic_cluster_names;
+  debug_options.cost_guided_clustering = flags->tf_xla_cost_guided_clustering;
   debug_options.max_cluster_size = flags->tf_xla_max_cluster_size;
   debug_options.min_cluster_size = flags->tf_xla_min_cluster_size;
   debug_options.fuel = GetPointerToFuel(flags->tf_xla_clustering_fuel);
@@ -25,6 +25,10 @@ void MaybeEnableMultiWorkersWatching(tsl::CoordinationServiceAgent* agent) {}
 namespace tfw_internal {
 
 std::atomic<int> g_watcher_level(kWatcherDisabled);
+std::atomic<tsl::uint64> g_sample_period(0);
+std::atomic<tsl::uint64> g_sample_counter(0);
+std::atomic<tsl::uint64> g_num_sampled(0);
+std::atomic<tsl::uint64> g_num_aggregated(0);
 ActivityId RecordActivityStart(std::unique_ptr<Activity>) {
   return kActivityNotRecorded;
 }
@@ -32,5 +36,22 @@ void RecordActivityEnd(ActivityId id) {}
 
 }  // namespace tfw_internal
 
+void SetActivitySamplePeriod(tsl::uint64 period) {
+  tfw_internal::g_sample_period.store(period, std::memory_order_relaxed);
+}
+
+tsl::uint64 GetActivitySamplePeriod() {
+  return tfw_internal::g_sample_period.load(std::memory_order_relaxed);
+}
+
+ActivitySampleStats GetActivitySampleStats() {
+  ActivitySampleStats stats;
+  stats.num_sampled =
+      tfw_internal::g_num_sampled.load(std::memory_order_relaxed);
+  stats.num_aggregated =
+      tfw_internal::g_num_aggregated.load(std::memory_order_relaxed);
+  return stats;
+}
+
 }  // namespace activity_watcher
 }  // namespace tensorflow
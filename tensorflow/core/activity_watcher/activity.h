@@ -84,6 +84,27 @@ struct Activity {
 // service and also fetch all workers' activities.
 void MaybeEnableMultiWorkersWatching(tsl::CoordinationServiceAgent* agent);
 
+// Aggregate counts of activities seen while the watcher is enabled, split by
+// whether they fell into the fully recorded sample tier.
+struct ActivitySampleStats {
+  // Activities recorded with full detail.
+  tsl::uint64 num_sampled = 0;
+  // Activities that only updated the aggregate counters.
+  tsl::uint64 num_aggregated = 0;
+};
+
+// Sets the sampling period N: 1-in-N activities passing the level check are
+// recorded with full detail while the rest only update aggregate counters. A
+// period of 0 or 1 records every activity. Safe to adjust at runtime, e.g.
+// from an admin endpoint.
+void SetActivitySamplePeriod(tsl::uint64 period);
+
+// Returns the current sampling period.
+tsl::uint64 GetActivitySamplePeriod();
+
+// Returns the aggregate activity counts accumulated so far.
+ActivitySampleStats GetActivitySampleStats();
+
 namespace tfw_internal {
 
 #if defined(TF_ENABLE_ACTIVITY_WATCHER)
@@ -94,12 +115,30 @@ ActivityId RecordActivityStart(std::unique_ptr<Activity> activity);
 void RecordActivityEnd(ActivityId activity_id);
 
 TF_EXPORT extern std::atomic<int> g_watcher_level;
+TF_EXPORT extern std::atomic<tsl::uint64> g_sample_period;
+TF_EXPORT extern std::atomic<tsl::uint64> g_sample_counter;
+TF_EXPORT extern std::atomic<tsl::uint64> g_num_sampled;
+TF_EXPORT extern std::atomic<tsl::uint64> g_num_aggregated;
 
 // Returns whether the activitity watcher is enabled.
 inline bool WatcherEnabled(int level = 1) {
   return g_watcher_level.load(std::memory_order_acquire) >= level;
 }
 
+// Returns whether this activity falls into the fully recorded 1-in-N sample
+// tier and updates the aggregate counters accordingly. Always returns true
+// when the sample period is 0 or 1.
+inline bool SampleActivity() {
+  const tsl::uint64 period = g_sample_period.load(std::memory_order_relaxed);
+  if (period > 1 &&
+      g_sample_counter.fetch_add(1, std::memory_order_relaxed) % period != 0) {
+    g_num_aggregated.fetch_add(1, std::memory_order_relaxed);
+    return false;
+  }
+  g_num_sampled.fetch_add(1, std::memory_order_relaxed);
+  return true;
+}
+
 #endif
 
 // NOTE: Borrowed from boost C++ libraries because std::is_invocable_r is not
@@ -133,7 +172,8 @@ template <
     std::enable_if_t<is_activity_generator<ActivityGenerator>, bool> = true>
 inline ActivityId ActivityStart(ActivityGenerator&& gen, int level = 1) {
 #if defined(TF_ENABLE_ACTIVITY_WATCHER)
-  if (TF_PREDICT_FALSE(tfw_internal::WatcherEnabled(level))) {
+  if (TF_PREDICT_FALSE(tfw_internal::WatcherEnabled(level)) &&
+      tfw_internal::SampleActivity()) {
     return tfw_internal::RecordActivityStart(
         std::forward<ActivityGenerator>(gen)());
   }
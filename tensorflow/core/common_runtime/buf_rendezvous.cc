@@ -23,6 +23,7 @@ limitations under the License.
 #include "tensorflow/core/framework/cancellation.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/hash/hash.h"
 
 namespace tensorflow {
 namespace {
@@ -35,27 +36,35 @@ void DeregisterCancellation(BufRendezvous::Hook* h) {
 }
 }  // namespace
 
+BufRendezvous::HookTableShard& BufRendezvous::ShardForKey(const string& key) {
+  return shards_[Hash64(key.data(), key.size()) % kNumShards];
+}
+
 BufRendezvous::~BufRendezvous() {
-  mutex_lock l(mu_);
-  if (!hook_table_.empty()) {
-    PurgeTable(errors::Internal("Delete called on non-empty BufRendezvous"),
-               &hook_table_);
+  for (HookTableShard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    if (!shard.table.empty()) {
+      PurgeTable(errors::Internal("Delete called on non-empty BufRendezvous"),
+                 &shard.table);
+    }
   }
 }
 
 void BufRendezvous::StartAbort(const Status& s) {
   CHECK(!s.ok());
-  HookTable dummy_table;
-  {
-    mutex_lock l(mu_);
-    // Use a "derived" status as the status for the rendezvous. Derived
-    // status messages are ignored when aggregating errors across devices: this
-    // allows us to prefer our original status message over any cancellation
-    // related errors.
-    status_.Update(StatusGroup::MakeDerived(s));
-    hook_table_.swap(dummy_table);
+  for (HookTableShard& shard : shards_) {
+    HookTable dummy_table;
+    {
+      mutex_lock l(shard.mu);
+      // Use a "derived" status as the status for the rendezvous. Derived
+      // status messages are ignored when aggregating errors across devices:
+      // this allows us to prefer our original status message over any
+      // cancellation related errors.
+      shard.status.Update(StatusGroup::MakeDerived(s));
+      shard.table.swap(dummy_table);
+    }
+    PurgeTable(s, &dummy_table);
   }
-  PurgeTable(s, &dummy_table);
 }
 
 void BufRendezvous::PurgeTable(const Status& s, HookTable* table) {
@@ -97,20 +106,21 @@ void BufRendezvous::ProvideBuf(const string& key, Device* dev,
 #endif
   Hook* h = nullptr;
   Status providebuf_status;
+  HookTableShard& shard = ShardForKey(key);
   do {
-    mutex_lock l(mu_);
-    if (!status_.ok()) {
-      providebuf_status = status_;
+    mutex_lock l(shard.mu);
+    if (!shard.status.ok()) {
+      providebuf_status = shard.status;
       break;
     } else {
       CancellationToken cancellation_token = CancellationManager::kInvalidToken;
-      auto it = hook_table_.find(key);
-      if (it == hook_table_.end()) {
+      auto it = shard.table.find(key);
+      if (it == shard.table.end()) {
         if (cancellation_manager != nullptr) {
           cancellation_token = cancellation_manager->get_cancellation_token();
         }
         h = new Hook(cancellation_manager, cancellation_token);
-        it = hook_table_.insert(std::make_pair(key, h)).first;
+        it = shard.table.insert(std::make_pair(key, h)).first;
       } else {
         if (it->second->prod_cb != nullptr) {
           providebuf_status = errors::Internal(
@@ -128,7 +138,7 @@ void BufRendezvous::ProvideBuf(const string& key, Device* dev,
       if (h->cons_cb != nullptr) {
         // If consumer is waiting, kick off right away, removing Hook from
         // table.
-        hook_table_.erase(it);
+        shard.table.erase(it);
       } else {
         if (cancellation_manager != nullptr &&
             !cancellation_manager->RegisterCallback(
@@ -137,7 +147,7 @@ void BufRendezvous::ProvideBuf(const string& key, Device* dev,
           // already cancelled, call done immediately with cancelled status.
           providebuf_status = errors::Cancelled(
               "Operation was cancelled for BufRendezvous key ", key);
-          hook_table_.erase(it);
+          shard.table.erase(it);
           delete h;
         }
         h = nullptr;
@@ -183,14 +193,15 @@ void BufRendezvous::ConsumeBuf(const string& key, const string& device_name,
     return;
   }
   Hook* existing_hook = nullptr;
+  HookTableShard& shard = ShardForKey(key);
   do {
-    mutex_lock l(mu_);
-    if (!status_.ok()) {
-      consumebuf_status = status_;
+    mutex_lock l(shard.mu);
+    if (!shard.status.ok()) {
+      consumebuf_status = shard.status;
       break;
     }
-    auto it = hook_table_.find(key);
-    if (it != hook_table_.end()) {
+    auto it = shard.table.find(key);
+    if (it != shard.table.end()) {
       // Prepare to consume immediately.
       if (it->second->cons_cb) {
         consumebuf_status =
@@ -198,7 +209,7 @@ void BufRendezvous::ConsumeBuf(const string& key, const string& device_name,
         break;
       }
       existing_hook = it->second;
-      hook_table_.erase(it);
+      shard.table.erase(it);
       existing_hook->cons_cb = done;
     } else {
       // Hang consumer callback on the Hook.
@@ -215,7 +226,7 @@ void BufRendezvous::ConsumeBuf(const string& key, const string& device_name,
       } else {
         Hook* h = new Hook(cancellation_manager, cancellation_token);
         h->cons_cb = done;
-        it = hook_table_.insert(std::make_pair(key, h)).first;
+        it = shard.table.insert(std::make_pair(key, h)).first;
         return;
       }
     }
@@ -236,11 +247,12 @@ void BufRendezvous::ConsumeBuf(const string& key, const string& device_name,
 void BufRendezvous::CancelHook(const string& key) {
   Hook* h = nullptr;
   {
-    mutex_lock l(mu_);
-    auto it = hook_table_.find(key);
-    if (it == hook_table_.end()) return;
+    HookTableShard& shard = ShardForKey(key);
+    mutex_lock l(shard.mu);
+    auto it = shard.table.find(key);
+    if (it == shard.table.end()) return;
     h = it->second;
-    hook_table_.erase(it);
+    shard.table.erase(it);
   }
   if (h != nullptr) {
     auto s = errors::Cancelled("Operation was cancelled for BufRendezvous key ",
@@ -262,12 +274,14 @@ void BufRendezvous::DoneWithHook(Hook* h) {
 }
 
 void BufRendezvous::LogContents() {
-  mutex_lock l(mu_);
   LOG(INFO) << strings::StrCat("BufRendezvous ",
                                strings::Hex(reinterpret_cast<uint64>(this)),
                                " step_id=", step_id_, " current contents:");
-  for (const auto& it : hook_table_) {
-    LOG(INFO) << it.first << ":" << it.second->DebugString();
+  for (HookTableShard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& it : shard.table) {
+      LOG(INFO) << it.first << ":" << it.second->DebugString();
+    }
   }
 }
 
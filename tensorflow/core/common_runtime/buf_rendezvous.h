@@ -121,12 +121,24 @@ class BufRendezvous {
   void LogContents();
 
  protected:
+  typedef absl::flat_hash_map<string, Hook*> HookTable;
+
+  // The hook table is sharded by key hash so that concurrent collective
+  // instances, which always use distinct keys, do not all contend on a
+  // single mutex every step.  The abort status is replicated per shard so
+  // each operation takes exactly one lock.
+  struct HookTableShard {
+    mutex mu;
+    Status status TF_GUARDED_BY(mu);
+    HookTable table TF_GUARDED_BY(mu);
+  };
+  static constexpr int kNumShards = 16;
+
+  HookTableShard& ShardForKey(const string& key);
+
   const uint64 step_id_;
   const DeviceMgr* const dev_mgr_;  // Not owned.
-  mutex mu_;
-  Status status_ TF_GUARDED_BY(mu_);
-  typedef absl::flat_hash_map<string, Hook*> HookTable;
-  HookTable hook_table_ TF_GUARDED_BY(mu_);
+  HookTableShard shards_[kNumShards];
 
   void PurgeTable(const Status& s, HookTable* table);
 };
@@ -770,24 +770,69 @@ void CollectiveParamResolverLocal::CompleteInstanceFromInitializedIRec(
   //  We may need to wait for the group, if this is a broadcast, for source
   //  discovery.
   if (cp->instance.type == BROADCAST_COLLECTIVE) {
-    WaitForGroup(ir, cp, [col_impl, ir, device, cp, done](InstanceRec* irec) {
-      Status s;
-      if (ir != irec) {
-        s = errors::Internal("Expected ir ", ir, " and irec ", irec,
-                             " to be equal");
-      } else {
-        mutex_lock l(irec->mu);
-        s = irec->status;
-        cp->source_rank = irec->source_rank;
-      }
-      if (s.ok()) {
-        s = col_impl->InitializeCollectiveParams(cp);
-      }
-      done(s);
-    });
+    WaitForGroup(ir, cp,
+                 [this, col_impl, ir, device, cp, done](InstanceRec* irec) {
+                   Status s;
+                   if (ir != irec) {
+                     s = errors::Internal("Expected ir ", ir, " and irec ",
+                                          irec, " to be equal");
+                   } else {
+                     mutex_lock l(irec->mu);
+                     s = irec->status;
+                     cp->source_rank = irec->source_rank;
+                   }
+                   if (s.ok()) {
+                     s = InitializeCollectiveParamsWithCache(col_impl, cp);
+                   }
+                   done(s);
+                 });
   } else {
-    done(col_impl->InitializeCollectiveParams(cp));
+    done(InitializeCollectiveParamsWithCache(col_impl, cp));
+  }
+}
+
+Status CollectiveParamResolverLocal::InitializeCollectiveParamsWithCache(
+    CollectiveImplementationInterface* col_impl, CollectiveParams* cp) {
+  // User-specified subdiv offsets are rare and may legitimately differ
+  // between otherwise identical instances, so they bypass the cache.
+  if (!cp->instance.impl_details.subdiv_offsets.empty()) {
+    return col_impl->InitializeCollectiveParams(cp);
+  }
+  // Everything InitializeCollectiveParams computes is a deterministic
+  // function of the group membership, which is fixed once FinishGroup has
+  // run, and of this signature.
+  const string signature = strings::StrCat(
+      cp->group.group_key, ";", cp->instance.impl_details.collective_name, ";",
+      DataTypeString(cp->instance.data_type), ";",
+      cp->instance.shape.DebugString(), ";",
+      cp->instance.impl_details.max_subdivs_per_device, ";", cp->default_rank,
+      ";", cp->source_rank);
+  {
+    mutex_lock l(impl_cache_mu_);
+    auto it = impl_details_cache_.find(signature);
+    if (it != impl_details_cache_.end()) {
+      const ResolvedImplDetails& resolved = it->second;
+      cp->instance.impl_details.subdiv_offsets = resolved.subdiv_offsets;
+      cp->instance.impl_details.subdiv_permutations =
+          resolved.subdiv_permutations;
+      cp->instance.impl_details.subdiv_source_rank =
+          resolved.subdiv_source_rank;
+      cp->subdiv_rank = resolved.subdiv_rank;
+      return absl::OkStatus();
+    }
+  }
+  TF_RETURN_IF_ERROR(col_impl->InitializeCollectiveParams(cp));
+  {
+    mutex_lock l(impl_cache_mu_);
+    ResolvedImplDetails& resolved = impl_details_cache_[signature];
+    resolved.subdiv_offsets = cp->instance.impl_details.subdiv_offsets;
+    resolved.subdiv_permutations =
+        cp->instance.impl_details.subdiv_permutations;
+    resolved.subdiv_source_rank =
+        cp->instance.impl_details.subdiv_source_rank;
+    resolved.subdiv_rank = cp->subdiv_rank;
   }
+  return absl::OkStatus();
 }
 
 void CollectiveParamResolverLocal::WaitForGroup(InstanceRec* ir,
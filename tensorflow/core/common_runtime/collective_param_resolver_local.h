@@ -165,6 +165,28 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
                                            const StatusCallback& done)
       TF_LOCKS_EXCLUDED(ir->mu);
 
+  // The fields written by
+  // CollectiveImplementationInterface::InitializeCollectiveParams, cached so
+  // that equivalent instances do not recompute them.  See
+  // InitializeCollectiveParamsWithCache.
+  struct ResolvedImplDetails {
+    std::vector<int> subdiv_offsets;
+    std::vector<std::vector<int>> subdiv_permutations;
+    std::vector<int> subdiv_source_rank;
+    std::vector<int> subdiv_rank;
+  };
+
+  // Runs col_impl->InitializeCollectiveParams(cp), reusing a previously
+  // computed result when an instance with the same group, collective
+  // implementation, data type, shape and ranks has already been resolved.
+  // Instance keys churn every step for collective V2 ops but the expensive
+  // part of instance resolution (ring orderings and subdivision permutations)
+  // depends only on that signature, so steady-state resolution becomes a
+  // single hash lookup.
+  Status InitializeCollectiveParamsWithCache(
+      CollectiveImplementationInterface* col_impl, CollectiveParams* cp)
+      TF_LOCKS_EXCLUDED(impl_cache_mu_);
+
   // Complete instance params after waiting for group.
   // Precondition: *cp has complete group data and default_rank.
   void WaitForGroup(InstanceRec* ir, CollectiveParams* cp, const IRConsumer& f)
@@ -206,6 +228,9 @@ class CollectiveParamResolverLocal : public ParamResolverInterface {
   gtl::FlatMap<int32_t, gtl::FlatMap<std::tuple<int64_t, int32_t>,
                                      std::unique_ptr<InstanceRec>, TupleHash>>
       instance_table_ TF_GUARDED_BY(instance_mu_);
+  mutex impl_cache_mu_;
+  gtl::FlatMap<string, ResolvedImplDetails> impl_details_cache_
+      TF_GUARDED_BY(impl_cache_mu_);
   mutex status_mu_;
   Status status_ TF_GUARDED_BY(status_mu_);
 };
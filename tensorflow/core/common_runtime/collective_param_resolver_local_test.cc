@@ -208,6 +208,71 @@ TEST_F(CollectiveParamResolverLocalTest, CompleteParamsReduction1Task) {
   }
 }
 
+TEST_F(CollectiveParamResolverLocalTest, ReusesCachedImplDetails) {
+  // Two reduction instances that differ only in instance key must resolve to
+  // identical implementation details, with the second resolution served from
+  // the impl details cache rather than recomputed.
+  auto complete_params = [this](int instance_key,
+                                CollectiveParams* cps[NUM_DEVS]) {
+    Status statuses[NUM_DEVS];
+    Notification note[NUM_DEVS];
+    for (int i = 0; i < NUM_DEVS; ++i) {
+      cps[i] = new CollectiveParams();
+      CollectiveParams* cp = cps[i];
+      cp->group.group_key = 1;
+      cp->group.group_size = 3;
+      cp->group.device_type = DeviceType("CPU");
+      cp->group.num_tasks = 1;
+      cp->instance.instance_key = instance_key;
+      cp->instance.type = REDUCTION_COLLECTIVE;
+      cp->instance.data_type = DataType(DT_FLOAT);
+      cp->instance.shape = TensorShape({5});
+      // Leave subdiv_offsets empty so that subdivisions are generated
+      // dynamically and the resolution is cacheable.
+      cp->is_source = false;
+      Env::Default()->SchedClosure([this, i, cp, &note, &statuses]() {
+        string device =
+            strings::StrCat("/job:localhost/replica:0/task:0/device:CPU:", i);
+        prl_->CompleteParamsAsync(GetDeviceAttributes(device), cp,
+                                  nullptr /*CancellationManager*/,
+                                  [&statuses, &note, i](const Status& s) {
+                                    statuses[i] = s;
+                                    note[i].Notify();
+                                  });
+      });
+    }
+    for (int i = 0; i < NUM_DEVS; ++i) {
+      note[i].WaitForNotification();
+      TF_ASSERT_OK(statuses[i]);
+    }
+  };
+
+  CollectiveParams* first[NUM_DEVS];
+  complete_params(7, first);
+  {
+    mutex_lock l(prl_->impl_cache_mu_);
+    // One entry per participating rank.
+    EXPECT_EQ(prl_->impl_details_cache_.size(), NUM_DEVS);
+  }
+
+  CollectiveParams* second[NUM_DEVS];
+  complete_params(8, second);
+  {
+    mutex_lock l(prl_->impl_cache_mu_);
+    // The new instance key did not add cache entries.
+    EXPECT_EQ(prl_->impl_details_cache_.size(), NUM_DEVS);
+  }
+  for (int i = 0; i < NUM_DEVS; ++i) {
+    EXPECT_EQ(first[i]->instance.impl_details.subdiv_offsets,
+              second[i]->instance.impl_details.subdiv_offsets);
+    EXPECT_EQ(first[i]->instance.impl_details.subdiv_permutations,
+              second[i]->instance.impl_details.subdiv_permutations);
+    EXPECT_EQ(first[i]->subdiv_rank, second[i]->subdiv_rank);
+    first[i]->Unref();
+    second[i]->Unref();
+  }
+}
+
 void InitializeCollectiveParamsForBroadcast(int instance_key, int device_idx,
                                             bool is_source,
                                             CollectiveParams* cp) {
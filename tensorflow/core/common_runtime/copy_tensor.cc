@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/copy_tensor.h"
 
+#include <algorithm>
 #include <atomic>
 #include <utility>
 #include <vector>
@@ -26,6 +27,7 @@ limitations under the License.
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/reffed_status_callback.h"
 
 namespace tensorflow {
@@ -52,6 +54,61 @@ std::vector<RegistrationInfo>* MutableRegistry() {
   return registry;
 }
 
+// Chunk size in bytes for pipelined host-to-device copies, read from the
+// environment variable TF_HOST_TO_DEVICE_COPY_CHUNK_BYTES.  When positive,
+// host-to-device copies larger than twice this size are split into
+// row-aligned chunks that are issued back to back, so that staging of chunk
+// N+1 into pinned memory overlaps the DMA of chunk N instead of the transfer
+// being one serial stage-then-copy.  Zero (the default) preserves the single
+// contiguous copy.
+int64_t HostToDeviceCopyChunkBytes() {
+  static const int64_t chunk_bytes = [] {
+    int64_t value;
+    Status s = ReadInt64FromEnvVar("TF_HOST_TO_DEVICE_COPY_CHUNK_BYTES",
+                                   /*default_val=*/0, &value);
+    if (!s.ok()) {
+      LOG(WARNING) << s.message();
+      return int64_t{0};
+    }
+    return value;
+  }();
+  return chunk_bytes;
+}
+
+// Copies `input` to the already-allocated `output` as a sequence of
+// chunk-sized sub-copies along dimension 0.  `done` is invoked with the first
+// error, if any, once all chunks have completed.
+void CopyHostToDeviceChunked(const Tensor* input, Device* dst, Tensor* output,
+                             DeviceContext* recv_dev_context,
+                             StatusCallback done, bool sync_dst_compute,
+                             int64_t chunk_bytes) {
+  const int64_t dim0 = input->dim_size(0);
+  const int64_t bytes_per_row = input->TotalBytes() / dim0;
+  const int64_t rows_per_chunk =
+      std::max<int64_t>(1, chunk_bytes / bytes_per_row);
+  auto* status_cb = new ReffedStatusCallback(std::move(done));
+  core::ScopedUnref status_cb_unref(status_cb);
+  for (int64_t begin = 0; begin < dim0; begin += rows_per_chunk) {
+    const int64_t end = std::min(dim0, begin + rows_per_chunk);
+    // The slices alias the full tensors' buffers; they are heap-allocated so
+    // that they (and hence their buffer references) outlive this loop until
+    // the asynchronous chunk copy completes.
+    auto* input_chunk = new Tensor(input->Slice(begin, end));
+    auto* output_chunk = new Tensor(output->Slice(begin, end));
+    status_cb->Ref();
+    auto chunk_done = [status_cb, input_chunk,
+                       output_chunk](const Status& s) {
+      status_cb->UpdateStatus(s);
+      status_cb->Unref();
+      delete input_chunk;
+      delete output_chunk;
+    };
+    recv_dev_context->CopyCPUTensorToDevice(input_chunk, dst, output_chunk,
+                                            std::move(chunk_done),
+                                            sync_dst_compute);
+  }
+}
+
 void CopyHostToDevice(const Tensor* input, Allocator* cpu_allocator,
                       Allocator* out_allocator, StringPiece edge_name,
                       Device* dst, Tensor* output,
@@ -114,6 +171,14 @@ void CopyHostToDevice(const Tensor* input, Allocator* cpu_allocator,
     *output = *input;
     done(absl::OkStatus());
   } else {
+    const int64_t chunk_bytes = HostToDeviceCopyChunkBytes();
+    if (chunk_bytes > 0 && input->dims() > 0 && input->dim_size(0) > 1 &&
+        input->TotalBytes() > 2 * static_cast<uint64>(chunk_bytes) &&
+        DMAHelper::CanUseDMA(input) && output->shape() == input->shape()) {
+      CopyHostToDeviceChunked(input, dst, output, recv_dev_context,
+                              std::move(done), sync_dst_compute, chunk_bytes);
+      return;
+    }
     recv_dev_context->CopyCPUTensorToDevice(input, dst, output, std::move(done),
                                             sync_dst_compute);
   }
@@ -21,8 +21,12 @@ namespace tensorflow {
 // Types of per-request cost.
 inline constexpr char kTpuCostName[] = "tpu";
 inline constexpr char kGcuCostName[] = "gcu";
+inline constexpr char kCpuCostName[] = "cpu";
 inline constexpr char kNoOpCostName[] = "no_op";
 
+// Names of per-request metrics.
+inline constexpr char kAllocatedBytesMetricName[] = "allocated_bytes";
+
 // Each type of per-request cost could have the following versions.
 //
 // A server may have costs that cannot be directly attributed to a specific
@@ -15,13 +15,16 @@ limitations under the License.
 
 #include "tensorflow/core/common_runtime/device/device_event_mgr.h"
 
+#include <algorithm>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <utility>
 
 #include "tensorflow/core/platform/stacktrace.h"
 #include "tensorflow/core/platform/stream_executor.h"
 #include "tensorflow/core/protobuf/config.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/thread_annotations.h"
 
 namespace tensorflow {
@@ -33,6 +36,20 @@ namespace {
 //  - Should EventMgrs be shared between devices on a machine with multiple
 //  devices of the same type?
 static const int kNumThreads = 2;
+
+// Bounds for the adaptive polling delay.  When the oldest pending event is
+// predicted to complete within kBusyPollThresholdUsecs the polling loop does
+// not sleep at all; otherwise the delay starts at kMinPollDelayUsecs and
+// doubles on every empty poll up to polling_active_delay_usecs.
+static const int64_t kMinPollDelayUsecs = 1;
+static const int64_t kBusyPollThresholdUsecs = 2;
+
+bool AdaptivePollingEnabled() {
+  bool enabled = false;
+  TF_CHECK_OK(ReadBoolFromEnvVar("TF_GPU_ADAPTIVE_EVENT_POLLING",
+                                 /*default_val=*/false, &enabled));
+  return enabled;
+}
 }  // namespace
 
 namespace device_event_mgr {
@@ -100,6 +117,7 @@ EventMgr::EventMgr(se::StreamExecutor* se, const GPUOptions& gpu_options)
       polling_active_delay_usecs_(gpu_options.polling_active_delay_usecs()
                                       ? gpu_options.polling_active_delay_usecs()
                                       : 10),
+      adaptive_polling_(AdaptivePollingEnabled()),
       threadpool_(Env::Default(), "Device_Event_Manager", kNumThreads) {
   device_event_mgr::InitThreadpoolLabels(&threadpool_);
   StartPollingLoop();
@@ -109,8 +127,8 @@ EventMgr::~EventMgr() {
   StopPollingLoop();
 
   for (auto& [stream, stream_callbacks] : callbacks_) {
-    for (auto& [event, callback] : stream_callbacks) {
-      threadpool_.Schedule(std::move(callback));
+    for (auto& pending : stream_callbacks) {
+      threadpool_.Schedule(std::move(pending.callback));
     }
   }
   // The threadpool's destructor will block waiting for all outstanding
@@ -146,6 +164,7 @@ void EventMgr::StopPollingLoop() {
 void EventMgr::PollLoop() {
   while (true) {
     bool events_still_pending;
+    int64_t delay_usecs = polling_active_delay_usecs_;
     {
       mutex_lock l(mu_);
       if (stop_polling_) {
@@ -154,17 +173,50 @@ void EventMgr::PollLoop() {
       if (callbacks_.empty()) {
         events_pending_.wait(l);
       }
-      PollEvents(/*stream=*/nullptr);  // poll all streams
+      const int retired = PollEvents(/*stream=*/nullptr);  // poll all streams
       events_still_pending = !callbacks_.empty();
+      if (adaptive_polling_ && events_still_pending) {
+        delay_usecs = SuggestedPollDelayUsecs(retired);
+      }
     }
 
-    if (events_still_pending) {
-      Env::Default()->SleepForMicroseconds(polling_active_delay_usecs_);
+    if (events_still_pending && delay_usecs > 0) {
+      Env::Default()->SleepForMicroseconds(delay_usecs);
     }
   }
   polling_stopped_->Notify();
 }
 
+int64_t EventMgr::SuggestedPollDelayUsecs(int just_retired) {
+  if (just_retired > 0) {
+    // Completions are flowing; poll at the fastest rate.
+    poll_backoff_usecs_ = kMinPollDelayUsecs;
+  } else {
+    poll_backoff_usecs_ =
+        std::min<int64_t>(poll_backoff_usecs_ * 2, polling_active_delay_usecs_);
+  }
+  if (ewma_event_duration_ns_ == 0) {
+    return poll_backoff_usecs_;
+  }
+
+  // Predict the completion of the oldest pending event from the typical
+  // record-to-completion duration, and busy-poll once it is imminent so the
+  // callback does not wait out a full sleep interval.
+  int64_t oldest_record_ns = std::numeric_limits<int64_t>::max();
+  for (const auto& [stream, stream_callbacks] : callbacks_) {
+    oldest_record_ns =
+        std::min(oldest_record_ns, stream_callbacks.front().record_time_ns);
+  }
+  const int64_t remaining_usecs =
+      (oldest_record_ns + ewma_event_duration_ns_ -
+       static_cast<int64_t>(Env::Default()->NowNanos())) /
+      1000;
+  if (remaining_usecs <= kBusyPollThresholdUsecs) {
+    return 0;
+  }
+  return std::min(remaining_usecs, poll_backoff_usecs_);
+}
+
 void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
   VLOG(2) << "EnqueueCallback with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
@@ -180,7 +232,9 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
   stream->RecordEvent(e.get()).IgnoreError();
 
   bool was_empty = callbacks_.empty();
-  callbacks_[stream].push_back({std::move(e), std::move(func)});
+  callbacks_[stream].push_back(
+      {std::move(e), std::move(func),
+       static_cast<int64_t>(Env::Default()->NowNanos())});
 
   // Wake up the polling thread if it was sleeping.
   if (was_empty) {
@@ -195,11 +249,14 @@ void EventMgr::EnqueueCallback(se::Stream* stream, std::function<void()> func) {
 // spikes of up to several hundred outstanding.  (If GPUKernelTracker
 // is used to cap pending kernels there should never be more than
 // that many.)
-void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
+int EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
   VLOG(2) << "PollEvents with one or more callbacks pending on "
           << callbacks_.size() << " streams and " << free_events_.size()
           << " unused event objects.";
 
+  int num_retired = 0;
+  const int64_t now_ns = static_cast<int64_t>(Env::Default()->NowNanos());
+
   // Polls the events for one stream.
   //
   // `stream_it` should be an iterator into callbacks_.  Modifies stream_it so
@@ -210,7 +267,7 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
 
         auto it = stream_callbacks.begin();
         while (it != stream_callbacks.end()) {
-          auto& [event, callback] = *it;
+          auto& [event, callback, record_time_ns] = *it;
 
           se::Event::Status s = event->PollForStatus();
           bool keep_looping = true;
@@ -229,6 +286,17 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
             case se::Event::Status::kComplete:
               free_events_.push_back(std::move(event));
               threadpool_.Schedule(std::move(callback));
+              ++num_retired;
+              if (adaptive_polling_) {
+                // Completion was observed at most one polling interval after
+                // it occurred, so this over-estimates slightly; predictions
+                // based on it err toward polling late rather than spinning.
+                const int64_t duration_ns = now_ns - record_time_ns;
+                ewma_event_duration_ns_ =
+                    ewma_event_duration_ns_ == 0
+                        ? duration_ns
+                        : (7 * ewma_event_duration_ns_ + duration_ns) / 8;
+              }
               // std::deque::erase() does invalidate iterators, so we can't
               // erase `it` here.  Instead, we'll wait until the end of the loop
               // over stream_callbacks and erase all of the completed events at
@@ -266,6 +334,7 @@ void EventMgr::PollEvents(se::Stream* stream /*=nullptr*/) {
       poll_events_for_stream_it(stream_it);
     }
   }
+  return num_retired;
 }
 
 EventMgrFactory* EventMgrFactory::Singleton() {
@@ -78,8 +78,21 @@ class EventMgr {
   friend class TEST_EventMgrHelper;
   friend class EventMgrFactory;
 
+  // A callback waiting on its event to complete.
+  struct PendingCallback {
+    std::unique_ptr<se::Event> event;
+    std::function<void()> callback;
+    // When the event was recorded on the stream, used to predict its
+    // completion in adaptive polling mode.
+    int64_t record_time_ns;
+  };
+
   se::StreamExecutor* const exec_;
   const int32 polling_active_delay_usecs_;
+  // Whether the polling loop adapts its delay to observed event durations
+  // (TF_GPU_ADAPTIVE_EVENT_POLLING); when false, the loop sleeps a fixed
+  // polling_active_delay_usecs_ between polls.
+  const bool adaptive_polling_;
   mutex mu_;
   condition_variable events_pending_ TF_GUARDED_BY(mu_);
 
@@ -92,10 +105,20 @@ class EventMgr {
 
   // This function should be called at roughly the same tempo as QueueTensors()
   // to check whether pending events have recorded, and then retire them.
+  // Returns the number of events retired.
   //
   // If `stream` is not null, we only poll events for that stream.  Otherwise we
   // poll events for all streams.
-  void PollEvents(se::Stream* stream = nullptr)
+  int PollEvents(se::Stream* stream = nullptr)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Returns how long the polling loop should sleep before its next poll, in
+  // microseconds, while events are pending.  Returns 0 to request a
+  // busy-poll when the oldest pending event is predicted to complete
+  // imminently; backs off toward polling_active_delay_usecs_ while polls
+  // retire nothing.  `just_retired` is the result of the preceding
+  // PollEvents call.
+  int64_t SuggestedPollDelayUsecs(int just_retired)
       TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
   // An internal polling loop that runs at a low frequency to clear straggler
@@ -110,10 +133,15 @@ class EventMgr {
   std::vector<std::unique_ptr<se::Event>> free_events_ TF_GUARDED_BY(mu_);
 
   // Callbacks waiting on their events to complete.
-  absl::flat_hash_map<
-      se::Stream*,
-      std::deque<std::pair<std::unique_ptr<se::Event>, std::function<void()>>>>
-      callbacks_ TF_GUARDED_BY(mu_);
+  absl::flat_hash_map<se::Stream*, std::deque<PendingCallback>> callbacks_
+      TF_GUARDED_BY(mu_);
+
+  // Exponential moving average of the time from event record to observed
+  // completion, used to predict when the next pending event will complete.
+  int64_t ewma_event_duration_ns_ TF_GUARDED_BY(mu_) = 0;
+  // Current adaptive polling delay, raised while polls come up empty and
+  // reset when events retire.
+  int64_t poll_backoff_usecs_ TF_GUARDED_BY(mu_) = 1;
 
   bool stop_polling_ TF_GUARDED_BY(mu_);
   std::unique_ptr<Notification> polling_stopped_;
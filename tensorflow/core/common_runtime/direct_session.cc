@@ -34,6 +34,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/function.h"
 #include "tensorflow/core/common_runtime/graph_constructor.h"
 #include "tensorflow/core/common_runtime/graph_optimizer.h"
+#include "tensorflow/core/common_runtime/lightweight_step_stats_collector.h"
 #include "tensorflow/core/common_runtime/local_session_selection.h"
 #include "tensorflow/core/common_runtime/memory_types.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
@@ -48,7 +49,9 @@ limitations under the License.
 #include "tensorflow/core/framework/logging.h"
 #include "tensorflow/core/framework/metrics.h"
 #include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/op.h"
 #include "tensorflow/core/framework/run_handler.h"
+#include "tensorflow/core/framework/run_handler_util.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/algorithm.h"
@@ -69,10 +72,12 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/nccl/collective_communicator.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/byte_order.h"
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/numa.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/device_profiler_session.h"
@@ -100,10 +105,23 @@ Status NewThreadPoolFromThreadPoolOptions(
   const string& name = thread_pool_options.global_name();
   if (name.empty()) {
     // Session-local threadpool.
+    ThreadOptions thread_opts;
+    if (options.config.experimental().use_numa_affinity() &&
+        port::NUMAEnabled()) {
+      // Pin each session-local pool to one NUMA node, assigning pools to
+      // nodes round-robin like ThreadPoolDeviceFactory does for CPU devices.
+      // Keeping an inter-op worker on one node means the continuation tasks
+      // it runs stay close to the caches and memory its previous tasks
+      // touched.  Global named pools are left unpinned since they are shared
+      // across sessions that may index them differently.
+      thread_opts.numa_node = pool_number % port::NUMANumNodes();
+      VLOG(1) << "Pinning direct session inter op pool " << pool_number
+              << " to NUMA node " << thread_opts.numa_node;
+    }
     VLOG(1) << "Direct session inter op parallelism threads for pool "
             << pool_number << ": " << num_threads;
     *pool = new thread::ThreadPool(
-        options.env, ThreadOptions(), strings::StrCat("Compute", pool_number),
+        options.env, thread_opts, strings::StrCat("Compute", pool_number),
         num_threads, !options.config.experimental().disable_thread_spinning(),
         /*allocator=*/nullptr);
     *owned = true;
@@ -194,12 +212,35 @@ class DirectSessionFactory : public SessionFactory {
     if (options.config.graph_options().build_cost_model() > 0) {
       EnableCPUAllocatorFullStats();
     }
-    std::vector<std::unique_ptr<Device>> devices;
-    TF_RETURN_IF_ERROR(DeviceFactory::AddDevices(
-        options, "/job:localhost/replica:0/task:0", &devices));
 
-    DirectSession* session = new DirectSession(
-        options, new StaticDeviceMgr(std::move(devices)), this);
+    // Sessions with the same nonempty group key share one device set (and
+    // with it the per-device resource managers, so that resources in named
+    // containers are created only once per group).  The devices are created
+    // by the first session in the group and released with its last member.
+    const string& group_key = experimental_config.session_group_key();
+    std::shared_ptr<const DeviceMgr> device_mgr;
+    if (!group_key.empty()) {
+      mutex_lock l(sessions_lock_);
+      auto iter = session_groups_.find(group_key);
+      if (iter == session_groups_.end()) {
+        std::vector<std::unique_ptr<Device>> devices;
+        TF_RETURN_IF_ERROR(DeviceFactory::AddDevices(
+            options, "/job:localhost/replica:0/task:0", &devices));
+        iter = session_groups_.emplace(group_key, SessionGroup{}).first;
+        iter->second.device_mgr =
+            std::make_shared<StaticDeviceMgr>(std::move(devices));
+      }
+      ++iter->second.num_sessions;
+      device_mgr = iter->second.device_mgr;
+    } else {
+      std::vector<std::unique_ptr<Device>> devices;
+      TF_RETURN_IF_ERROR(DeviceFactory::AddDevices(
+          options, "/job:localhost/replica:0/task:0", &devices));
+      device_mgr = std::make_shared<StaticDeviceMgr>(std::move(devices));
+    }
+
+    DirectSession* session =
+        new DirectSession(options, std::move(device_mgr), this);
     {
       mutex_lock l(sessions_lock_);
       sessions_.push_back(session);
@@ -238,6 +279,16 @@ class DirectSessionFactory : public SessionFactory {
       session_metadata_keys_.erase(GetMetadataKey(
           session->options().config.experimental().session_metadata()));
     }
+    const string& group_key =
+        session->options().config.experimental().session_group_key();
+    if (!group_key.empty()) {
+      auto iter = session_groups_.find(group_key);
+      if (iter != session_groups_.end() && --iter->second.num_sessions == 0) {
+        // The deregistered session may still hold the last reference to the
+        // shared devices; they are destroyed with it.
+        session_groups_.erase(iter);
+      }
+    }
   }
 
  private:
@@ -245,10 +296,19 @@ class DirectSessionFactory : public SessionFactory {
     return absl::StrCat(metadata.name(), "/", metadata.version());
   }
 
+  // Sessions created with the same session_group_key share these devices;
+  // see ConfigProto.Experimental.session_group_key.
+  struct SessionGroup {
+    std::shared_ptr<const DeviceMgr> device_mgr;
+    int num_sessions = 0;
+  };
+
   mutex sessions_lock_;
   std::vector<DirectSession*> sessions_ TF_GUARDED_BY(sessions_lock_);
   absl::flat_hash_set<string> session_metadata_keys_
       TF_GUARDED_BY(sessions_lock_);
+  std::unordered_map<string, SessionGroup> session_groups_
+      TF_GUARDED_BY(sessions_lock_);
 };
 
 class DirectSessionRegistrar {
@@ -302,6 +362,18 @@ static RunHandlerPool* GetOrCreateRunHandlerPool(
   return pool;
 }
 
+// Whether to use the run-handler pool for requests that do not set
+// use_run_handler_pool themselves.  Serving systems that multiplex small and
+// large requests over one DirectSession often cannot attach RunOptions to
+// every Run call; TF_USE_RUN_HANDLER_POOL=true opts the whole process into
+// run-handler inter-op scheduling, which gives each request a bounded share
+// of the worker threads with cross-request work stealing.
+static bool UseRunHandlerPoolByDefault() {
+  static const bool use_run_handler_pool =
+      ParamFromEnvBoolWithDefault("TF_USE_RUN_HANDLER_POOL", false);
+  return use_run_handler_pool;
+}
+
 bool DirectSession::ShouldUseRunHandlerPool(
     const RunOptions& run_options) const {
   if (options_.config.use_per_session_threads()) return false;
@@ -319,10 +391,10 @@ bool DirectSession::ShouldUseRunHandlerPool(
 }
 
 DirectSession::DirectSession(const SessionOptions& options,
-                             const DeviceMgr* device_mgr,
+                             std::shared_ptr<const DeviceMgr> device_mgr,
                              DirectSessionFactory* const factory)
     : options_(options),
-      device_mgr_(device_mgr),
+      device_mgr_(std::move(device_mgr)),
       factory_(factory),
       cancellation_manager_(new CancellationManager()),
       operation_timeout_in_ms_(options_.config.operation_timeout_in_ms()) {
@@ -399,6 +471,12 @@ DirectSession::~DirectSession() {
   for (auto d : device_mgr_->ListDevices()) {
     d->op_segment()->RemoveHold(session_handle_);
   }
+  if (!options_.config.experimental().session_group_key().empty()) {
+    // This session's private resources live in its per-session container on
+    // the shared devices; drop them now rather than when the whole session
+    // group winds down.
+    device_mgr_->ClearContainers({session_handle_});
+  }
   functions_.clear();
   delete cancellation_manager_;
   for (const auto& p_and_owned : thread_pools_) {
@@ -436,10 +514,49 @@ Status DirectSession::Extend(GraphDef&& graph) {
   return ExtendLocked(std::move(graph));
 }
 
+void DirectSession::ScopeDefaultContainers(GraphDef* graph) {
+  const auto scope_node = [this](NodeDef* node) {
+    auto iter = node->mutable_attr()->find("container");
+    if (iter != node->mutable_attr()->end()) {
+      if (iter->second.value_case() == AttrValue::kS &&
+          iter->second.s().empty()) {
+        iter->second.set_s(session_handle_);
+      }
+      return;
+    }
+    // The attr may be omitted and filled in from the op definition's default
+    // (the empty string) at kernel construction time; add it explicitly so
+    // the default resolves to the per-session container instead.
+    const OpDef* op_def = nullptr;
+    if (!OpRegistry::Global()->LookUpOpDef(node->op(), &op_def).ok()) {
+      return;
+    }
+    for (const auto& attr : op_def->attr()) {
+      if (attr.name() == "container" && attr.type() == "string") {
+        (*node->mutable_attr())["container"].set_s(session_handle_);
+        return;
+      }
+    }
+  };
+  for (NodeDef& node : *graph->mutable_node()) {
+    scope_node(&node);
+  }
+  for (FunctionDef& function : *graph->mutable_library()->mutable_function()) {
+    for (NodeDef& node : *function.mutable_node_def()) {
+      scope_node(&node);
+    }
+  }
+}
+
 Status DirectSession::ExtendLocked(GraphDef&& graph) {
   if (finalized_) {
     return errors::FailedPrecondition("Session has been finalized.");
   }
+  if (!options_.config.experimental().session_group_key().empty()) {
+    // Keep resources out of the shared default container unless the graph
+    // asks for sharing by naming a container explicitly.
+    ScopeDefaultContainers(&graph);
+  }
   if (!(flib_def_ && execution_state_)) {
     // If this is the first call, we can initialize the execution state
     // with `graph` and do not need to call `Extend()`.
@@ -619,7 +736,8 @@ Status DirectSession::RunInternal(
 
   std::unique_ptr<RunHandler> handler;
   if (ShouldUseRunHandlerPool(run_options) &&
-      run_options.experimental().use_run_handler_pool()) {
+      (run_options.experimental().use_run_handler_pool() ||
+       UseRunHandlerPoolByDefault())) {
     VLOG(1) << "Using RunHandler to scheduler inter-op closures.";
     handler = GetOrCreateRunHandlerPool(options_)->Get(
         step_id, call_timeout,
@@ -694,6 +812,12 @@ Status DirectSession::RunInternal(
     run_state.collector.reset(
         new StepStatsCollector(run_metadata->mutable_step_stats()));
     args.stats_collector = run_state.collector.get();
+  } else {
+    // Full tracing is not requested; collect fixed-cost timing records for
+    // sampled steps if TF_STEP_STATS_SAMPLE_PERIOD is set.
+    run_state.lightweight_collector =
+        LightweightStepStatsCollector::CreateIfSampled(executor_step_count);
+    args.stats_collector = run_state.lightweight_collector.get();
   }
 
   std::unique_ptr<DeviceProfilerSession> device_profiler_session;
@@ -794,6 +918,10 @@ Status DirectSession::RunInternal(
   if (run_state.collector) {
     run_state.collector->Finalize();
   }
+  if (run_state.lightweight_collector != nullptr && run_metadata != nullptr) {
+    run_state.lightweight_collector->ToStepStats(
+        run_metadata->mutable_step_stats());
+  }
 
   // Build and return the cost model as instructed.
   if (update_cost_model) {
@@ -1601,6 +1729,44 @@ Status DirectSession::GetOrCreateExecutors(
   return absl::OkStatus();
 }
 
+Status DirectSession::WarmStartExecutors(
+    absl::Span<const RunSignature> signatures) {
+  TF_RETURN_IF_ERROR(CheckNotClosed());
+  TF_RETURN_IF_ERROR(CheckGraphCreated("WarmStartExecutors()"));
+  if (signatures.empty()) return absl::OkStatus();
+
+  // `GetOrCreateExecutors` tolerates concurrent callers (creation happens
+  // outside `executor_lock_` and insertion deduplicates), so the signatures
+  // can be built in parallel.
+  std::vector<Status> statuses(signatures.size());
+  BlockingCounter counter(signatures.size());
+  thread::ThreadPool* pool = thread_pools_[0].first;
+  for (size_t i = 0; i < signatures.size(); ++i) {
+    auto build_executors = [this, &signatures, &statuses, &counter, i]() {
+      const RunSignature& signature = signatures[i];
+      DebugOptions debug_options;
+      RunStateArgs run_state_args(debug_options);
+      ExecutorsAndKeys* executors_and_keys = nullptr;
+      statuses[i] =
+          GetOrCreateExecutors(signature.input_names, signature.output_names,
+                               signature.target_nodes, &executors_and_keys,
+                               &run_state_args);
+      counter.DecrementCount();
+    };
+    if (pool != nullptr && signatures.size() > 1) {
+      pool->Schedule(std::move(build_executors));
+    } else {
+      build_executors();
+    }
+  }
+  counter.Wait();
+
+  for (const Status& s : statuses) {
+    TF_RETURN_IF_ERROR(s);
+  }
+  return absl::OkStatus();
+}
+
 Status DirectSession::CreateGraphs(
     const BuildGraphOptions& subgraph_options,
     std::unordered_map<string, std::unique_ptr<Graph>>* outputs,
@@ -1876,6 +2042,7 @@ Status DirectSession::MakeCallable(const CallableOptions& callable_options,
   RunStateArgs run_state_args(callable_options.run_options().debug_options());
   TF_RETURN_IF_ERROR(
       CreateExecutors(callable_options, &ek, &func_info, &run_state_args));
+  PrepareCallableFastPath(ek.get());
   {
     mutex_lock l(callables_lock_);
     *out_handle = next_callable_handle_++;
@@ -1884,6 +2051,121 @@ Status DirectSession::MakeCallable(const CallableOptions& callable_options,
   return absl::OkStatus();
 }
 
+void DirectSession::PrepareCallableFastPath(ExecutorsAndKeys* ek) {
+  const RunOptions& run_options = ek->callable_options.run_options();
+  // The fast path executes synchronously on the calling thread, so it is
+  // restricted to single-partition callables without timeouts, and skips the
+  // per-call setup in RunInternal() for features that the callable's options
+  // statically rule out.
+  if (ek->items.size() != 1) return;
+  if (ek->collective_graph_key != BuildGraphOptions::kNoCollectiveGraphKey) {
+    return;
+  }
+  if (run_options.trace_level() != RunOptions::NO_TRACE) return;
+  if (!run_options.debug_options().debug_tensor_watch_opts().empty()) return;
+  if (run_options.timeout_in_ms() > 0 || operation_timeout_in_ms_ > 0) return;
+  if (run_options.report_tensor_allocations_upon_oom()) return;
+  if (run_options.output_partition_graphs()) return;
+  if (options_.config.graph_options().build_cost_model() > 0) return;
+  if (options_.config.experimental().has_session_metadata()) return;
+  if (ShouldUseRunHandlerPool(run_options) &&
+      (run_options.experimental().use_run_handler_pool() ||
+       UseRunHandlerPoolByDefault())) {
+    return;
+  }
+
+  thread::ThreadPool* pool;
+  if (run_in_caller_thread_ || run_options.inter_op_thread_pool() == -1) {
+    pool = nullptr;
+  } else if (run_options.inter_op_thread_pool() < -1 ||
+             run_options.inter_op_thread_pool() >=
+                 static_cast<int32>(thread_pools_.size())) {
+    // Leave the callable on the regular path so that RunInternal() reports
+    // the invalid thread pool index.
+    return;
+  } else {
+    pool = thread_pools_[run_options.inter_op_thread_pool()].first;
+  }
+  ek->fast_path_inline_kernels = (pool == nullptr);
+
+  thread::ThreadPool* device_thread_pool =
+      ek->items[0].device->tensorflow_device_thread_pool();
+  ek->fast_path_pool = device_thread_pool ? device_thread_pool : pool;
+  ek->fast_path_eligible = true;
+}
+
+Status DirectSession::RunCallableFastPath(int64_t step_id,
+                                          ExecutorsAndKeys* executors_and_keys,
+                                          CallFrameInterface* call_frame) {
+  const uint64 start_time_usecs = options_.env->NowMicros();
+  const int64_t executor_step_count =
+      executors_and_keys->step_count.fetch_add(1);
+  RunState run_state(step_id, &devices_);
+
+  profiler::TraceMeProducer activity(
+      // To TraceMeConsumers in ExecutorState::Process/Finish.
+      [&] {
+        return profiler::TraceMeEncode(
+            "SessionRun", {{"id", step_id}, {"_r", 1} /*root_event*/});
+      },
+      profiler::ContextType::kTfExecutor, step_id,
+      profiler::TraceMeLevel::kInfo);
+
+  run_state.lightweight_collector =
+      LightweightStepStatsCollector::CreateIfSampled(executor_step_count);
+
+  // Register this step with session's cancellation manager, so that
+  // `Session::Close()` will cancel the step.
+  CancellationManager step_cancellation_manager(cancellation_manager_);
+  if (step_cancellation_manager.IsCancelled()) {
+    return errors::Cancelled("Run call was cancelled");
+  }
+
+  thread::ThreadPool* pool = executors_and_keys->fast_path_pool;
+
+  Executor::Args args;
+  args.step_id = step_id;
+  args.call_frame = call_frame;
+  args.session_config = &options_.config;
+  args.session_state = &session_state_;
+  args.session_handle = session_handle_;
+  args.tensor_store = &run_state.tensor_store;
+  args.step_container = &run_state.step_container;
+  args.cancellation_manager = &step_cancellation_manager;
+  args.stats_collector = run_state.lightweight_collector.get();
+  args.sync_on_finish = sync_on_finish_;
+  args.run_all_kernels_inline = executors_and_keys->fast_path_inline_kernels;
+  args.start_time_usecs = start_time_usecs;
+  if (pool == nullptr) {
+    args.runner = [](const Executor::Args::Closure& c) { c(); };
+  } else {
+    args.runner = [pool](Executor::Args::Closure c) {
+      pool->Schedule(std::move(c));
+    };
+  }
+
+  PrivateIntraProcessRendezvous rendezvous(device_mgr_.get());
+  args.rendezvous = &rendezvous;
+
+  Status run_status = executors_and_keys->items[0].executor->Run(args);
+  if (step_cancellation_manager.IsCancelled()) {
+    run_status.Update(errors::Cancelled("Run call was cancelled"));
+  }
+  TF_RETURN_IF_ERROR(run_status);
+
+  // Save the output tensors of this run we choose to keep.
+  if (!run_state.tensor_store.empty()) {
+    TF_RETURN_IF_ERROR(run_state.tensor_store.SaveTensors(
+        {executors_and_keys->callable_options.fetch().begin(),
+         executors_and_keys->callable_options.fetch().end()},
+        &session_state_));
+  }
+
+  metrics::UpdateGraphExecTime(options_.env->NowMicros() - start_time_usecs);
+
+  return absl::OkStatus();
+}
+
 class DirectSession::RunCallableCallFrame : public CallFrameInterface {
  public:
   RunCallableCallFrame(DirectSession* session,
@@ -2015,9 +2297,17 @@ class DirectSession::RunCallableCallFrame : public CallFrameInterface {
     LogMemory::RecordStep(step_id, run_state_args.handle);
   }
 
-  TF_RETURN_IF_ERROR(RunInternal(
-      step_id, executors_and_keys->callable_options.run_options(), &call_frame,
-      executors_and_keys.get(), run_metadata, threadpool_options));
+  if (executors_and_keys->fast_path_eligible && run_metadata == nullptr &&
+      threadpool_options.inter_op_threadpool == nullptr &&
+      threadpool_options.intra_op_threadpool == nullptr) {
+    TF_RETURN_IF_ERROR(
+        RunCallableFastPath(step_id, executors_and_keys.get(), &call_frame));
+  } else {
+    TF_RETURN_IF_ERROR(RunInternal(
+        step_id, executors_and_keys->callable_options.run_options(),
+        &call_frame, executors_and_keys.get(), run_metadata,
+        threadpool_options));
+  }
 
   if (fetch_tensors != nullptr) {
     size_t output_size = 0;
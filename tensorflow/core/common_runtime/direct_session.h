@@ -29,6 +29,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/device_set.h"
 #include "tensorflow/core/common_runtime/executor.h"
 #include "tensorflow/core/common_runtime/graph_execution_state.h"
+#include "tensorflow/core/common_runtime/lightweight_step_stats_collector.h"
 #include "tensorflow/core/common_runtime/process_function_library_runtime.h"
 #include "tensorflow/core/common_runtime/rendezvous_mgr.h"
 #include "tensorflow/core/common_runtime/session_factory.h"
@@ -56,11 +57,14 @@ class DirectSession : public Session {
  public:
   typedef std::function<void(Session*)> CloseCallback;
 
-  // Takes ownership of 'device_mgr'.
+  // 'device_mgr' is shared so that sessions in the same session group (see
+  // ConfigProto.Experimental.session_group_key) can reuse one device set;
+  // ungrouped sessions are the sole owner of theirs.
   // 'factory' is used to unregister the DirectSession with 'factory' when its
   // closed. This ensures that Reset requests from the 'factory' don't get sent
   // to sessions that are already closed.
-  DirectSession(const SessionOptions& options, const DeviceMgr* device_mgr,
+  DirectSession(const SessionOptions& options,
+                std::shared_ptr<const DeviceMgr> device_mgr,
                 DirectSessionFactory* factory);
   ~DirectSession() override;
 
@@ -135,6 +139,25 @@ class DirectSession : public Session {
 
   ::tensorflow::Status Finalize() override;
 
+  // A feed/fetch/target signature for which executors can be pre-built with
+  // `WarmStartExecutors()`.
+  struct RunSignature {
+    std::vector<string> input_names;
+    std::vector<string> output_names;
+    std::vector<string> target_nodes;
+  };
+
+  // Pre-builds and caches the executors for each of the given Run signatures,
+  // in parallel on the session's inter-op thread pool. Without this, the
+  // first Run() with a new signature pays for graph pruning and kernel
+  // instantiation; calling this after Create() (or Extend()) with the
+  // signatures that will be served makes first-request latency equal to
+  // steady state.
+  //
+  // NOTE: Experimental and subject to change.
+  ::tensorflow::Status WarmStartExecutors(
+      absl::Span<const RunSignature> signatures);
+
   const SessionOptions& options() const { return options_; }
 
  private:
@@ -176,6 +199,20 @@ class DirectSession : public Session {
     CallableOptions callable_options;
 
     int64_t collective_graph_key = BuildGraphOptions::kNoCollectiveGraphKey;
+
+    // Pre-resolved state for the low-overhead `RunCallable()` path, filled in
+    // by `PrepareCallableFastPath()` when the callable is created. When
+    // `fast_path_eligible` is true the callable has a single partition, no
+    // collectives, and RunOptions that request no tracing, debugging,
+    // timeouts or cost modelling, so `RunCallableFastPath()` can skip the
+    // corresponding per-call setup that `RunInternal()` performs.
+    bool fast_path_eligible = false;
+    // Whether kernels should run inline on the calling thread.
+    bool fast_path_inline_kernels = false;
+    // The inter-op pool to schedule closures on; nullptr means the calling
+    // thread. Pre-resolved from the callable's RunOptions and the device's
+    // dedicated thread pool, if any. Not owned.
+    thread::ThreadPool* fast_path_pool = nullptr;
   };
 
   // A FunctionInfo object is created for every unique set of feeds/fetches.
@@ -201,6 +238,7 @@ class DirectSession : public Session {
     Status status TF_GUARDED_BY(mu);
     std::unique_ptr<CollectiveExecutor::Handle> collective_executor;
     std::unique_ptr<StepStatsCollector> collector;
+    std::unique_ptr<LightweightStepStatsCollector> lightweight_collector;
     TensorStore tensor_store;
     ScopedStepContainer step_container;
 
@@ -269,6 +307,20 @@ class DirectSession : public Session {
       RunMetadata* run_metadata,
       const thread::ThreadPoolOptions& threadpool_options);
 
+  // Inspects `ek` and its RunOptions and, when every per-call feature that
+  // `RunInternal()` handles (tracing, debugging, collectives, timeouts, cost
+  // models, RunHandler pools) is statically known to be unused, marks the
+  // callable as eligible for `RunCallableFastPath()` and pre-resolves its
+  // inter-op thread pool. Called once from `MakeCallable()`.
+  void PrepareCallableFastPath(ExecutorsAndKeys* ek);
+
+  // Runs a callable that `PrepareCallableFastPath()` marked as eligible,
+  // synchronously on the calling thread. Mirrors the synchronous branch of
+  // `RunInternal()` minus the setup that eligibility makes unnecessary.
+  ::tensorflow::Status RunCallableFastPath(int64_t step_id,
+                                           ExecutorsAndKeys* executors_and_keys,
+                                           CallFrameInterface* call_frame);
+
   // Returns whether inter-op execution uses a global pool or the input
   // `run_options` requests being run on inter_op_thread_pool = 0 in case
   // multiple pools are configured.
@@ -277,6 +329,12 @@ class DirectSession : public Session {
   ::tensorflow::Status ExtendLocked(GraphDef&& graph)
       TF_EXCLUSIVE_LOCKS_REQUIRED(graph_state_lock_);
 
+  // For sessions in a session group: rewrites every node (including function
+  // bodies) that leaves its `container` attr empty to use a per-session
+  // container, so that only resources explicitly placed in a named container
+  // are shared with the other sessions in the group.
+  void ScopeDefaultContainers(GraphDef* graph);
+
   ::tensorflow::Status ResourceHandleToInputTensor(
       const Tensor& resource_tensor, Tensor* retrieved_tensor);
 
@@ -335,8 +393,9 @@ class DirectSession : public Session {
 
   const SessionOptions options_;
 
-  // Device structures.
-  const std::unique_ptr<const DeviceMgr> device_mgr_;
+  // Device structures.  Shared with the other sessions in this session's
+  // session group, if it belongs to one.
+  const std::shared_ptr<const DeviceMgr> device_mgr_;
   std::vector<Device*> devices_;  // not owned
   DeviceSet device_set_;
 
@@ -838,6 +838,69 @@ TEST(DirectSessionTest, KeepsStateAcrossRunsOfSession) {
   EXPECT_EQ(20.0, outputs[0].flat<float>()(0));
 }
 
+TEST(DirectSessionTest, SessionGroupSharesNamedContainers) {
+  SessionOptions options;
+  options.config.mutable_experimental()->set_session_group_key("group");
+
+  auto build_graph = [](GraphDef* def, string* shared_var_name,
+                        string* private_var_name, string* init_name,
+                        string* private_init_name) {
+    Graph g(OpRegistry::Global());
+    // A variable explicitly placed in a named container: shared across the
+    // session group.
+    Node* shared_var = test::graph::Var(&g, DT_FLOAT, TensorShape({10}));
+    shared_var->AddAttr("container", "weights");
+    shared_var->AddAttr("shared_name", "w");
+    // A variable left in the default container: private to each session.
+    Node* private_var = test::graph::Var(&g, DT_FLOAT, TensorShape({10}));
+    private_var->AddAttr("shared_name", "p");
+
+    Tensor twenty(DT_FLOAT, TensorShape({10}));
+    for (int i = 0; i < 10; ++i) {
+      twenty.flat<float>()(i) = 20.0;
+    }
+    Node* twenty_node = test::graph::Constant(&g, twenty);
+    Node* init = test::graph::Assign(&g, shared_var, twenty_node);
+    Node* private_init = test::graph::Assign(&g, private_var, twenty_node);
+    g.ToGraphDef(def);
+    *shared_var_name = shared_var->name();
+    *private_var_name = private_var->name();
+    *init_name = init->name();
+    *private_init_name = private_init->name();
+  };
+
+  GraphDef def_a;
+  string shared_var_a, private_var_a, init_a, private_init_a;
+  build_graph(&def_a, &shared_var_a, &private_var_a, &init_a,
+              &private_init_a);
+  std::unique_ptr<Session> session_a(NewSession(options));
+  ASSERT_TRUE(session_a != nullptr);
+  TF_ASSERT_OK(session_a->Create(def_a));
+
+  // Initialize both variables through the first session.
+  std::vector<Tensor> outputs;
+  TF_ASSERT_OK(session_a->Run({}, {init_a, private_init_a}, {}, &outputs));
+
+  GraphDef def_b;
+  string shared_var_b, private_var_b, init_b, private_init_b;
+  build_graph(&def_b, &shared_var_b, &private_var_b, &init_b,
+              &private_init_b);
+  std::unique_ptr<Session> session_b(NewSession(options));
+  ASSERT_TRUE(session_b != nullptr);
+  TF_ASSERT_OK(session_b->Create(def_b));
+
+  // The second session reads the value stored by the first one.
+  TF_ASSERT_OK(session_b->Run({}, {shared_var_b + ":0"}, {}, &outputs));
+  ASSERT_EQ(1, outputs.size());
+  ASSERT_TRUE(outputs[0].IsInitialized());
+  EXPECT_EQ(20.0, outputs[0].flat<float>()(0));
+
+  // The default-container variable stays per-session, so it is still
+  // uninitialized in the second session even though the first session ran
+  // its initializer.
+  EXPECT_FALSE(session_b->Run({}, {private_var_b + ":0"}, {}, &outputs).ok());
+}
+
 TEST(DirectSessionTest, MultipleFeedTest) {
   GraphDef def;
   Graph g(OpRegistry::Global());
@@ -994,6 +1057,48 @@ TEST(DirectSessionTest, MultipleFeedTest_Callable) {
   EXPECT_TRUE(absl::StrContains(s.message(), "fed more than once"));
 }
 
+TEST(DirectSessionTest, RunCallableFastPath_RepeatedCalls) {
+  // Repeated calls to a fixed-signature callable take the pre-bound fast
+  // path when no RunMetadata is requested; a call with RunMetadata falls
+  // back to the regular path. Both must produce identical results.
+  GraphDef def;
+  Graph g(OpRegistry::Global());
+
+  Tensor initial_value(DT_FLOAT, TensorShape({}));
+  initial_value.scalar<float>()() = 0.0;
+  Node* feed = test::graph::Constant(&g, initial_value);
+  Node* identity = test::graph::Identity(&g, feed);
+
+  g.ToGraphDef(&def);
+
+  auto session = CreateSession();
+  ASSERT_TRUE(session != nullptr);
+  TF_ASSERT_OK(session->Create(def));
+
+  Session::CallableHandle handle;
+  TF_ASSERT_OK(session->MakeCallable(
+      MakeCallableOptions({feed->name()}, {identity->name() + ":0"}, {}),
+      &handle));
+
+  Tensor value(DT_FLOAT, TensorShape({}));
+  std::vector<Tensor> outputs;
+  for (int i = 0; i < 10; ++i) {
+    value.scalar<float>()() = static_cast<float>(i);
+    TF_ASSERT_OK(session->RunCallable(handle, {value}, &outputs, nullptr));
+    ASSERT_EQ(1, outputs.size());
+    EXPECT_EQ(static_cast<float>(i), outputs[0].flat<float>()(0));
+  }
+
+  RunMetadata run_metadata;
+  value.scalar<float>()() = 42.0;
+  TF_ASSERT_OK(
+      session->RunCallable(handle, {value}, &outputs, &run_metadata));
+  ASSERT_EQ(1, outputs.size());
+  EXPECT_EQ(42.0, outputs[0].flat<float>()(0));
+
+  TF_ASSERT_OK(session->ReleaseCallable(handle));
+}
+
 TEST(DirectSessionTest, TestTensorConnectionUseTwice) {
   Graph graph(OpRegistry::Global());
 
@@ -297,12 +297,17 @@ inline tensorflow::Fprint128 CacheKeyHelper(StringPiece s, uint64 b) {
 }  // namespace
 
 tensorflow::Fprint128 AttrBuilder::CacheKey(const StringPiece device) {
-  if (!cached_cache_key_ || device != device_for_cached_cache_key_) {
-    cached_cache_key_ = BuildCacheKeyForDevice(device);
-    device_for_cached_cache_key_ = string(device);
+  for (const auto& entry : cached_cache_keys_) {
+    if (device == entry.first) {
+      return entry.second;
+    }
   }
-
-  return *cached_cache_key_;
+  if (cached_cache_keys_.size() == kMaxCachedCacheKeys) {
+    cached_cache_keys_.erase(cached_cache_keys_.begin());
+  }
+  cached_cache_keys_.emplace_back(string(device),
+                                  BuildCacheKeyForDevice(device));
+  return cached_cache_keys_.back().second;
 }
 
 tensorflow::Fprint128 AttrBuilder::BuildCacheKeyForDevice(
@@ -107,8 +107,7 @@ class AttrBuilder : public AbstractOpAttrs {
     num_inputs_ = 0;
     encoded_attrs_.clear();
     node_def_finalized_ = false;
-    cached_cache_key_ = std::nullopt;
-    device_for_cached_cache_key_.clear();
+    cached_cache_keys_.clear();
   }
 
   const string& op_name() const { return op_name_; }
@@ -122,7 +121,7 @@ class AttrBuilder : public AbstractOpAttrs {
     SetAttrValue(value, &attr_tmp_);
     AddAttrIfNotPresent(attr_name, attr_tmp_);
     node_def_finalized_ = false;
-    cached_cache_key_ = std::nullopt;
+    cached_cache_keys_.clear();
     return *this;
   }
 
@@ -130,7 +129,7 @@ class AttrBuilder : public AbstractOpAttrs {
 
   AttrBuilder& Set(StringPiece attr_name, const AttrValue& value) {
     AddAttrIfNotPresent(attr_name, value);
-    cached_cache_key_ = std::nullopt;
+    cached_cache_keys_.clear();
     return *this;
   }
 
@@ -205,8 +204,15 @@ class AttrBuilder : public AbstractOpAttrs {
   bool node_def_initialized_;
   bool node_def_finalized_;
 
-  std::optional<tensorflow::Fprint128> cached_cache_key_;
-  string device_for_cached_cache_key_;
+  // Memoized cache keys, one entry per device name the key has been requested
+  // for since the last attribute mutation.  An eager op dispatch asks for the
+  // key under two device names (the caller's device spec and the resolved
+  // device), so a single-entry memo thrashes when an op is reused as a
+  // compiled handle across many Execute() calls; keeping a small per-device
+  // set makes steady-state reuse recompute no fingerprints at all.
+  static constexpr int kMaxCachedCacheKeys = 4;
+  gtl::InlinedVector<std::pair<string, tensorflow::Fprint128>, 2>
+      cached_cache_keys_;
 };
 
 template <>
@@ -473,6 +473,7 @@ void EagerContext::ClearCachesAndDefaultExecutor() {
     mutex_lock ml(cache_mu_);
     default_executor_.WaitForAllPendingNodes().IgnoreError();
     kernel_cache_.clear();
+    PublishKernelCacheSnapshot();
     for (auto& entry : registered_functions_) {
       entry.second->cached_kernel_keys->clear();
     }
@@ -1134,6 +1135,7 @@ Status EagerContext::RemoveFunction(const string& func) {
       for (auto& key : *registered_function->cached_kernel_keys) {
         kernel_cache_.erase(key);
       }
+      PublishKernelCacheSnapshot();
       registered_functions_.erase(func);
     }
     registered_function->Unref();
@@ -1213,11 +1215,27 @@ Status EagerContext::SyncExecutors() {
   return sg.as_summary_status();
 }
 
+void EagerContext::PublishKernelCacheSnapshot() {
+  auto snapshot = std::make_shared<KernelCacheMap>();
+  snapshot->reserve(kernel_cache_.size());
+  for (const auto& entry : kernel_cache_) {
+    entry.second->Ref();
+    snapshot->emplace(entry.first, core::RefCountPtr<KernelAndDevice>(
+                                       entry.second.get()));
+  }
+  std::atomic_store(&kernel_cache_snapshot_,
+                    std::shared_ptr<const KernelCacheMap>(std::move(snapshot)));
+}
+
 core::RefCountPtr<KernelAndDevice> EagerContext::GetCachedKernel(
     Fprint128 cache_key) {
-  tf_shared_lock l(cache_mu_);
-  auto iter = kernel_cache_.find(cache_key);
-  if (iter == kernel_cache_.end()) {
+  // Lock-free: look up in the latest published snapshot instead of taking
+  // cache_mu_.  A concurrent mutation at worst makes this lookup behave as if
+  // it had happened just before the mutation.
+  std::shared_ptr<const KernelCacheMap> snapshot =
+      std::atomic_load(&kernel_cache_snapshot_);
+  auto iter = snapshot->find(cache_key);
+  if (iter == snapshot->end()) {
     return nullptr;
   }
   core::RefCountPtr<KernelAndDevice> new_ref(iter->second.get());
@@ -1244,6 +1262,7 @@ core::RefCountPtr<KernelAndDevice> EagerContext::AddKernelToCache(
   core::RefCountPtr<KernelAndDevice> new_ref(kernel.get());
   new_ref->Ref();
   kernel_cache_[cache_key] = std::move(new_ref);
+  PublishKernelCacheSnapshot();
   auto* registered_function =
       gtl::FindPtrOrNull(registered_functions_, kernel->name());
 
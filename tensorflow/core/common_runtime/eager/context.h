@@ -773,9 +773,21 @@ class EagerContext : public ImmediateExecutionContext, public core::RefCounted {
 
     std::unique_ptr<std::vector<Fprint128>> cached_kernel_keys;
   };
-  std::unordered_map<Fprint128, core::RefCountPtr<KernelAndDevice>,
-                     Fprint128Hasher>
-      kernel_cache_ TF_GUARDED_BY(cache_mu_);
+  using KernelCacheMap =
+      std::unordered_map<Fprint128, core::RefCountPtr<KernelAndDevice>,
+                         Fprint128Hasher>;
+  KernelCacheMap kernel_cache_ TF_GUARDED_BY(cache_mu_);
+  // Read-only snapshot of kernel_cache_, republished (copy-on-write) under
+  // cache_mu_ after every cache mutation and read with std::atomic_load, so
+  // kernel cache hits never take cache_mu_.  Mutations are rare (kernel
+  // compilation, function removal, cache clearing) compared to lookups, which
+  // happen on every eager op dispatch.  The snapshot holds its own references
+  // to the kernels, so a kernel obtained from a stale snapshot stays valid
+  // even if it has been concurrently erased from kernel_cache_.
+  std::shared_ptr<const KernelCacheMap> kernel_cache_snapshot_ =
+      std::make_shared<const KernelCacheMap>();
+  // Rebuilds kernel_cache_snapshot_ from kernel_cache_.
+  void PublishKernelCacheSnapshot() TF_EXCLUSIVE_LOCKS_REQUIRED(cache_mu_);
   std::unordered_map<string, RegisteredFunction*> registered_functions_
       TF_GUARDED_BY(cache_mu_);
 
@@ -126,12 +126,44 @@ Status EagerExecutor::SyncExecute(EagerNode* node) {
 
   // Inline execution in sync mode.
   s = node->Run();
-  tensorflow::mutex_lock l(node_queue_mutex_);
-  NotifyWaiters(id);
+  // Only take node_queue_mutex_ if somebody is actually waiting; in the
+  // common synchronous case the notification map is empty and locking it per
+  // node would serialize otherwise-independent threads on this executor.
+  if (has_node_done_notifications_.load(std::memory_order_acquire)) {
+    tensorflow::mutex_lock l(node_queue_mutex_);
+    NotifyWaiters(id);
+  }
   return s;
 }
 
 Status EagerExecutor::AddOrExecute(std::unique_ptr<EagerNode> node) {
+  // Inline execution of ordinary nodes in sync mode, bypassing the NodeItem
+  // bookkeeping entirely: nothing can be waiting on a node that has not been
+  // queued, so on success there is nobody to notify and no state to update.
+  // Async and remote nodes, and the error path, go through the regular
+  // NodeItem machinery below.
+  if (!Async() && node->AsAsync() == nullptr &&
+      node->AsAsyncRemoteExecuteNode() == nullptr) {
+    const uint64 id = next_node_id_++;
+    Status s = node->Prepare();
+    if (!s.ok()) {
+      node->Abort(s);
+      return s;
+    }
+    s = node->Run();
+    if (s.ok()) {
+      return s;
+    }
+    // Defer to NodeDone() for the error handling (executor poisoning and
+    // waiter notification).
+    core::RefCountPtr<NodeItem> error_item(new NodeItem);
+    error_item->id = id;
+    error_item->node = std::move(node);
+    error_item->state = NodeState::kPENDING;
+    NodeDone(error_item, s, /*from_queue=*/false);
+    return s;
+  }
+
   Status status;
   core::RefCountPtr<NodeItem> item(new NodeItem);
   item->id = next_node_id_++;
@@ -211,6 +243,7 @@ tensorflow::Status EagerExecutor::WaitForAllPendingNodesLocked(
   auto last_id = next_node_id_ - 1;
   DVLOG(3) << "Wait for Node: [id " << last_id << "] ";
   node_done_notifications_.insert(std::make_pair(last_id, &cond));
+  has_node_done_notifications_.store(true, std::memory_order_release);
   cond.wait(*lock);
   // Note that we could be woken up if an error occurs, even though the node has
   // not actually executed.
@@ -341,6 +374,8 @@ void EagerExecutor::NotifyWaiters(uint64 id) {
       it->second->notify_all();
     }
     node_done_notifications_.erase(range.first, range.second);
+    has_node_done_notifications_.store(!node_done_notifications_.empty(),
+                                       std::memory_order_release);
   }
 }
 
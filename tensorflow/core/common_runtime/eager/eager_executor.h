@@ -249,6 +249,11 @@ class EagerExecutor {
   std::multimap<uint64, condition_variable*, std::less<uint64>>
       node_done_notifications_ TF_GUARDED_BY(node_queue_mutex_);
 
+  // Mirrors node_done_notifications_.empty(); written under node_queue_mutex_
+  // and read without it, so that the synchronous execution paths can skip
+  // taking the mutex per node when nobody is waiting.
+  std::atomic<bool> has_node_done_notifications_{false};
+
   // thread_exited_notification_ is notified by the `thread_` right before it
   // exits.
   Notification thread_exited_notification_;
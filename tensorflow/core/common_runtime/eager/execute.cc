@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/lib/core/refcount.h"
+#include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/platform.h"
 #include "tensorflow/core/platform/protobuf.h"
@@ -132,6 +133,25 @@ bool SendAsProtosWhenPossible() {
   return send_as_protos_when_possible;
 }
 
+// Opt-in speculative pipelining of dependent remote ops. When a function's
+// remote input lives on the same task that will run the function, the request
+// producing that input was enqueued on the same ordered streaming channel, so
+// the handle placeholder can be sent immediately instead of blocking until
+// the producer's response arrives; the remote executor resolves placeholders
+// in enqueue order. A chain of N dependent remote calls then costs roughly
+// one round trip instead of N. Off by default because callers that drive the
+// same target from multiple eager executors get no cross-stream ordering
+// guarantee, which this fast path does not check.
+bool PipelineDependentRemoteOps() {
+  static bool pipeline_dependent_remote_ops = []() {
+    bool result;
+    TF_CHECK_OK(tsl::ReadBoolFromEnvVar(
+        "TF_EAGER_PIPELINE_DEPENDENT_REMOTE_OPS", false, &result));
+    return result;
+  }();
+  return pipeline_dependent_remote_ops;
+}
+
 const string& DeviceNameOrUnspecified(Device* device) {
   static string* unspecified_string = new string("<unspecified>");
   return (device == nullptr) ? *unspecified_string : device->name();
@@ -1900,6 +1920,16 @@ Status EagerRemoteExecute(EagerOperation* op, TensorHandle** retvals,
         // before sending it to the multi-device function device.
         bool wait_until_ready =
             SkipRemoteHandleWaitReady() ? false : op->is_function();
+        // If the input already lives on the task that will run this function,
+        // the request producing it went out on the same ordered streaming
+        // channel, so its placeholder can be forwarded without blocking on
+        // readiness. Component functions bypass the streaming channel and are
+        // handled separately (see execute_node.cc).
+        if (wait_until_ready && PipelineDependentRemoteOps() &&
+            input->Type() == TensorHandle::HandleType::REMOTE &&
+            ctx.OnSameTask(op_device, input_device)) {
+          wait_until_ready = false;
+        }
         TF_RETURN_IF_ERROR(ctx.RemoteMgr()->SerializeRemoteTensorHandle(
             input, wait_until_ready, input_handle, input_device,
             *input_device_name, serialize_resource_dtype_and_shape));
@@ -2234,6 +2264,91 @@ Status EagerExecute(EagerOperation* op, TensorHandle** retvals,
   return DoEagerExecute(op, retvals, num_retvals);
 }
 
+Status EagerExecuteBatch(
+    EagerOperation* op,
+    absl::Span<const absl::InlinedVector<TensorHandle*, 4>> input_sets,
+    absl::Span<std::vector<TensorHandle*>> retvals) {
+  if (input_sets.size() != retvals.size()) {
+    return errors::InvalidArgument(
+        "EagerExecuteBatch expects one retval vector per input set but got ",
+        input_sets.size(), " input sets and ", retvals.size(),
+        " retval vectors");
+  }
+  if (input_sets.empty()) {
+    return absl::OkStatus();
+  }
+  EagerContext& ctx = op->EagerContext();
+  if (op->Executor().Async() || !op->IsLocal() || op->is_function()) {
+    return errors::InvalidArgument(
+        "EagerExecuteBatch supports synchronous execution of local primitive "
+        "ops only");
+  }
+
+  // Resolve the kernel once against the first input set.  The resolution is
+  // only valid for the remaining sets if they agree on input dtypes and
+  // devices, which is checked below.
+  for (TensorHandle* h : input_sets[0]) {
+    TF_RETURN_IF_ERROR(op->AddInput(h));
+  }
+  core::RefCountPtr<KernelAndDevice> kernel;
+  int num_retvals = 0;
+  Status s =
+      GetOrCreateKernelAndDevice(op, /*retvals=*/nullptr, &num_retvals, &kernel);
+  if (!s.ok()) {
+    op->Clear();
+    return s;
+  }
+  const int num_inputs = input_sets[0].size();
+  for (size_t i = 1; i < input_sets.size(); ++i) {
+    if (input_sets[i].size() != static_cast<size_t>(num_inputs)) {
+      op->Clear();
+      return errors::InvalidArgument(
+          "EagerExecuteBatch input set ", i, " has ", input_sets[i].size(),
+          " inputs but the first set has ", num_inputs);
+    }
+    for (int j = 0; j < num_inputs; ++j) {
+      if (input_sets[i][j]->dtype != input_sets[0][j]->dtype ||
+          input_sets[i][j]->device() != input_sets[0][j]->device()) {
+        op->Clear();
+        return errors::InvalidArgument(
+            "EagerExecuteBatch input ", j, " of set ", i,
+            " does not match the dtype and device of the first input set");
+      }
+    }
+  }
+
+  const int num_outputs = kernel->num_outputs();
+  const int64_t num_instances = input_sets.size();
+  std::vector<Status> statuses(num_instances);
+  auto run_instance = [&](int64_t i) {
+    retvals[i].assign(num_outputs, nullptr);
+    statuses[i] = EagerKernelExecute(
+        &ctx, input_sets[i], /*eager_func_params=*/absl::nullopt, kernel,
+        /*graph_collector=*/nullptr, op->GetCancellationManager(),
+        absl::MakeSpan(retvals[i]), op->GetStackTrace());
+  };
+  thread::ThreadPool* pool = ctx.GetThreadPool();
+  if (pool == nullptr || num_instances == 1) {
+    for (int64_t i = 0; i < num_instances; ++i) {
+      run_instance(i);
+    }
+  } else {
+    BlockingCounter counter(num_instances);
+    for (int64_t i = 0; i < num_instances; ++i) {
+      pool->Schedule([&run_instance, &counter, i]() {
+        run_instance(i);
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+  op->Clear();
+  for (int64_t i = 0; i < num_instances; ++i) {
+    TF_RETURN_IF_ERROR(statuses[i]);
+  }
+  return absl::OkStatus();
+}
+
 namespace {
 
 Status LocalEagerCopyToDevice(TensorHandle* h, EagerContext* ctx,
@@ -45,6 +45,22 @@ namespace tensorflow {
 Status EagerExecute(EagerOperation* op, TensorHandle** retvals,
                     int* num_retvals);
 
+// Executes `op` once per entry of `input_sets`, resolving the kernel a single
+// time and running the instances across the context's thread pool (or inline
+// when no pool is configured). This avoids the per-instance dispatch overhead
+// of N separate EagerExecute calls when applying the same op to many
+// independent input tensors.
+//
+// `op` must be a local primitive op on a synchronous executor, and must have
+// no inputs set; the input sets must all agree on input dtypes and devices
+// (the first set is used to resolve the kernel). On success, retvals[i] holds
+// the outputs of instance i; on failure the first error is returned and
+// retvals contents are unspecified.
+Status EagerExecuteBatch(
+    EagerOperation* op,
+    absl::Span<const absl::InlinedVector<TensorHandle*, 4>> input_sets,
+    absl::Span<std::vector<TensorHandle*>> retvals);
+
 // Low-level utility to execute the kernel specified by `kernel` on
 // `kernel->device()`, with the inputs op_inputs, in the context 'ctx'.
 Status EagerKernelExecute(
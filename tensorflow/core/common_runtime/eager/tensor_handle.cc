@@ -219,6 +219,75 @@ Status TensorHandle::ExtractPackedHandle(const int index,
                                                                      handle);
 }
 
+namespace {
+
+// Per-thread recycling pool backing TensorHandle::operator new/delete.
+
+// Set once this thread's TensorHandlePool has been destroyed.  A plain bool
+// has no destructor, so it stays valid through TLS teardown; handles are
+// routinely released during EagerContext shutdown while static and
+// thread-local destructors are in flight, and such a release must go to the
+// global heap instead of re-entering the destroyed pool.
+thread_local bool tensor_handle_pool_destroyed = false;
+
+class TensorHandlePool {
+ public:
+  static TensorHandlePool& Get() {
+    static thread_local TensorHandlePool pool;
+    return pool;
+  }
+
+  ~TensorHandlePool() {
+    tensor_handle_pool_destroyed = true;
+    for (void* ptr : free_list_) ::operator delete(ptr);
+  }
+
+  void* Allocate() {
+    if (free_list_.empty()) {
+      return nullptr;
+    }
+    void* ptr = free_list_.back();
+    free_list_.pop_back();
+    return ptr;
+  }
+
+  // Returns false if the pool is full, in which case the caller should free
+  // 'ptr' itself.
+  bool Release(void* ptr) {
+    if (free_list_.size() >= kMaxPooledHandles) {
+      return false;
+    }
+    free_list_.push_back(ptr);
+    return true;
+  }
+
+ private:
+  // Bounds the memory a thread's pool can hold on to; 64 handles is plenty
+  // for the outputs in flight of a typical eager loop iteration.
+  static constexpr size_t kMaxPooledHandles = 64;
+
+  std::vector<void*> free_list_;
+};
+
+}  // namespace
+
+void* TensorHandle::operator new(size_t size) {
+  if (size == sizeof(TensorHandle) && !tensor_handle_pool_destroyed) {
+    if (void* ptr = TensorHandlePool::Get().Allocate()) {
+      return ptr;
+    }
+  }
+  return ::operator new(size);
+}
+
+void TensorHandle::operator delete(void* ptr, size_t size) {
+  if (size == sizeof(TensorHandle) && !tensor_handle_pool_destroyed &&
+      TensorHandlePool::Get().Release(ptr)) {
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 TensorHandle* TensorHandle::CreateLocalHandle(const tensorflow::Tensor& t) {
   // TODO(b/136608821): Move away from nullptr
   tensorflow::Tensor tensor = t;
@@ -74,6 +74,15 @@ class TensorHandle : public ImmediateExecutionTensorHandle {
 #endif  // IS_MOBILE_PLATFORM
 
  public:
+  // TensorHandles are allocated at a high rate (one per eager op output) and
+  // are nearly always short-lived, so they are recycled through a small
+  // per-thread free list instead of hitting the global heap on every op.
+  // LocalTensorHandleData lives inline in data_, so this covers the handle's
+  // entire bookkeeping allocation.  A handle released on a different thread
+  // than it was allocated on simply migrates to that thread's pool.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
   // TensorHandle with no assigned device
   static TensorHandle* CreateLocalHandle(const tensorflow::Tensor& t);
   static TensorHandle* CreateLocalHandle(tensorflow::Tensor&& t, Device* d,
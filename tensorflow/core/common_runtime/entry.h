@@ -15,10 +15,16 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_COMMON_RUNTIME_ENTRY_H_
 #define TENSORFLOW_CORE_COMMON_RUNTIME_ENTRY_H_
 
+#include <atomic>
+#include <vector>
+
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/gtl/manual_constructor.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
 
 namespace tensorflow {
 
@@ -136,6 +142,71 @@ struct Entry {
 // TODO(b/152925936): Re-evaluate this constant with current usage patterns.
 typedef gtl::InlinedVector<Entry, 4> EntryVector;
 
+// A recycling pool of `Entry` activation buffers.
+//
+// The executor allocates one `Entry` array per live iteration to hold the
+// in-flight input values for the nodes in a frame. For large graphs this is
+// the dominant scheduler-side heap allocation in each step, so the pool
+// retains released buffers (grouped by size) and hands them back to later
+// steps running against the same executor. Thread-safe.
+class EntryBufferPool {
+ public:
+  EntryBufferPool() = default;
+
+  ~EntryBufferPool() {
+    for (auto& size_and_buffers : free_lists_) {
+      for (Entry* buffer : size_and_buffers.second) {
+        delete[] buffer;
+      }
+    }
+  }
+
+  // Returns a buffer of `size` entries, all in the `NO_VALUE` state.
+  Entry* Acquire(int size) {
+    {
+      mutex_lock l(mu_);
+      auto it = free_lists_.find(size);
+      if (it != free_lists_.end() && !it->second.empty()) {
+        Entry* buffer = it->second.back();
+        it->second.pop_back();
+        num_reuses_.fetch_add(1, std::memory_order_relaxed);
+        return buffer;
+      }
+    }
+    num_allocations_.fetch_add(1, std::memory_order_relaxed);
+    return new Entry[size];
+  }
+
+  // Returns `buffer`, previously obtained from `Acquire(size)`, to the pool.
+  void Release(Entry* buffer, int size) {
+    // Reset each entry so that a recycled buffer is indistinguishable from a
+    // freshly allocated one (drops any values left behind by dead nodes and
+    // clears stale allocator attributes).
+    for (int i = 0; i < size; ++i) {
+      buffer[i] = Entry();
+    }
+    mutex_lock l(mu_);
+    free_lists_[size].push_back(buffer);
+  }
+
+  // Cumulative reuse statistics, for verifying pool effectiveness.
+  int64_t num_allocations() const {
+    return num_allocations_.load(std::memory_order_relaxed);
+  }
+  int64_t num_reuses() const {
+    return num_reuses_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  mutex mu_;
+  gtl::FlatMap<int, std::vector<Entry*>> free_lists_ TF_GUARDED_BY(mu_);
+  std::atomic<int64_t> num_allocations_{0};
+  std::atomic<int64_t> num_reuses_{0};
+
+  EntryBufferPool(const EntryBufferPool&) = delete;
+  void operator=(const EntryBufferPool&) = delete;
+};
+
 }  // namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_COMMON_RUNTIME_ENTRY_H_
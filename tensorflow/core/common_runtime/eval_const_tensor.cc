@@ -18,6 +18,7 @@ limitations under the License.
 #include <cstdint>
 #include <deque>
 #include <limits>
+#include <list>
 #include <memory>
 #include <optional>
 #include <string>
@@ -37,13 +38,18 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/types.pb.h"
 #include "tensorflow/core/framework/versions.pb.h"
 #include "tensorflow/core/graph/graph.h"
 #include "tensorflow/core/graph/node_builder.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
 #include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/platform/fingerprint.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/statusor.h"
 #include "tensorflow/core/platform/strcat.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace {
@@ -249,6 +255,104 @@ std::string OutputName(const NodeOutput& output) {
   return strings::StrCat(output.first->name(), ":", output.second);
 }
 
+// Computes a fingerprint identifying the subgraph evaluation: the nodes to
+// run, the constant input tensors, and the requested output. Returns null if
+// some input tensor cannot be hashed cheaply from its flat byte contents
+// (e.g. string tensors), in which case the evaluation is not cached.
+//
+// Per-node and per-input hashes are combined commutatively because neither
+// the node ids assigned during extraction nor the order of `inputs` (built
+// from a hash map) are stable across imports of identical graphs.
+std::optional<uint64_t> FingerprintSubgraph(const Subgraph& subgraph,
+                                            absl::string_view output_name) {
+  uint64_t fingerprint = Fingerprint64(output_name);
+  for (const Node* node : subgraph.graph.op_nodes()) {
+    fingerprint += DeterministicProtoHash64(node->def());
+  }
+  for (const auto& [name, tensor] : subgraph.inputs) {
+    if (!DataTypeCanUseMemcpy(tensor.dtype())) {
+      return std::nullopt;
+    }
+    uint64_t input_fingerprint = Fingerprint64(name);
+    input_fingerprint = FingerprintCat64(input_fingerprint, tensor.dtype());
+    for (const int64_t dim : tensor.shape().dim_sizes()) {
+      input_fingerprint = FingerprintCat64(input_fingerprint, dim);
+    }
+    fingerprint += FingerprintCat64(input_fingerprint,
+                                    Fingerprint64(tensor.tensor_data()));
+  }
+  return fingerprint;
+}
+
+// Process-wide cache of constant subgraph evaluation results. Importing a
+// family of near-identical graphs extracts and runs the same constant cones
+// over and over during shape inference; keying each evaluation by the
+// fingerprint above lets every import after the first skip the GraphRunner.
+// The cache holds at most TF_CONST_SUBGRAPH_CACHE_SIZE_MB megabytes of
+// tensor data (64 by default, 0 disables caching), evicting the least
+// recently used entries.
+class ConstantSubgraphCache {
+ public:
+  static ConstantSubgraphCache* Global() {
+    static ConstantSubgraphCache* cache = new ConstantSubgraphCache();
+    return cache;
+  }
+
+  std::optional<Tensor> Lookup(uint64_t fingerprint) {
+    std::optional<Tensor> result;
+    if (max_bytes_ == 0) {
+      return result;
+    }
+    mutex_lock l(mu_);
+    auto it = entries_.find(fingerprint);
+    if (it != entries_.end()) {
+      lru_.splice(lru_.begin(), lru_, it->second.lru_position);
+      result = it->second.tensor;
+    }
+    return result;
+  }
+
+  void Insert(uint64_t fingerprint, const Tensor& tensor) {
+    const int64_t bytes = tensor.TotalBytes();
+    if (max_bytes_ == 0 || bytes > max_bytes_) {
+      return;
+    }
+    mutex_lock l(mu_);
+    if (entries_.contains(fingerprint)) {
+      return;
+    }
+    while (total_bytes_ + bytes > max_bytes_) {
+      auto oldest = entries_.find(lru_.back());
+      total_bytes_ -= oldest->second.tensor.TotalBytes();
+      entries_.erase(oldest);
+      lru_.pop_back();
+    }
+    lru_.push_front(fingerprint);
+    entries_.emplace(fingerprint, Entry{tensor, lru_.begin()});
+    total_bytes_ += bytes;
+  }
+
+ private:
+  ConstantSubgraphCache() {
+    int64_t budget_mb = 64;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_CONST_SUBGRAPH_CACHE_SIZE_MB",
+                                    budget_mb, &budget_mb));
+    max_bytes_ = budget_mb > 0 ? budget_mb << 20 : 0;
+  }
+
+  struct Entry {
+    Tensor tensor;
+    std::list<uint64_t>::iterator lru_position;
+  };
+
+  int64_t max_bytes_;
+  mutex mu_;
+  int64_t total_bytes_ TF_GUARDED_BY(mu_) = 0;
+  absl::flat_hash_map<uint64_t, Entry> entries_ TF_GUARDED_BY(mu_);
+  // Fingerprints in recency order, most recently used first.
+  std::list<uint64_t> lru_ TF_GUARDED_BY(mu_);
+};
+
 // Assuming that the subgraph ending at `target_node` is constant-foldable,
 // returns it along with all constant inputs necessary for evaluation.
 // Otherwise, returns null.
@@ -393,6 +497,19 @@ absl::StatusOr<std::optional<Tensor>> EvaluateConstantTensor(
       ExtractConstantSubgraph(node, refiner, lookup, runner->op_registry,
                               runner->graph_def_version));
   if (subgraph != nullptr) {
+    const std::string output_name = OutputName({&node, node_output});
+
+    // Identical constant subgraphs are often re-evaluated across imports of
+    // similar graphs; consult the process-wide cache before running.
+    const std::optional<uint64_t> fingerprint =
+        FingerprintSubgraph(*subgraph, output_name);
+    if (fingerprint.has_value()) {
+      result = ConstantSubgraphCache::Global()->Lookup(*fingerprint);
+      if (result.has_value()) {
+        return result;
+      }
+    }
+
     GraphRunner* graph_runner = runner->graph_runner;
     std::unique_ptr<GraphRunner> tmp_graph_runner;
     if (graph_runner == nullptr) {
@@ -406,7 +523,7 @@ absl::StatusOr<std::optional<Tensor>> EvaluateConstantTensor(
     std::vector<Tensor> outputs;
     auto status =
         graph_runner->Run(&subgraph->graph, function_library, subgraph->inputs,
-                          {OutputName({&node, node_output})}, &outputs);
+                          {output_name}, &outputs);
 
     // A graph may contain errors such as shape incompatibility or division by
     // zero. Errors like that are usually uncovered by a full-graph analysis or
@@ -414,6 +531,9 @@ absl::StatusOr<std::optional<Tensor>> EvaluateConstantTensor(
     // used. Suppress execution errors for this reason (best effort).
     if (status.ok()) {
       result = std::move(outputs[0]);
+      if (fingerprint.has_value()) {
+        ConstantSubgraphCache::Global()->Insert(*fingerprint, *result);
+      }
     }
   }
 
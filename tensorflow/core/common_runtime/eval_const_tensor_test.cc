@@ -199,6 +199,23 @@ TEST_F(EvaluateConstantTensorTest, ConstantFolding) {
   WithRunner().ExpectTensor(result, test::AsScalar<int32_t>(5 + 7));
 }
 
+TEST_F(EvaluateConstantTensorTest, CachedEvaluationIsKeyedOnInputs) {
+  auto arg = ops::_Arg(scope_, DT_INT32, 0);
+  auto result = ops::Add(scope_, arg, ops::Const(scope_, 1));
+
+  cache_.emplace(std::make_pair(arg.node(), 0), test::AsScalar<int32_t>(3));
+  WithRunner().ExpectTensor(result, test::AsScalar<int32_t>(3 + 1));
+
+  // Re-evaluation of the identical subgraph hits the process-wide cache and
+  // must return the same value.
+  WithRunner().ExpectTensor(result, test::AsScalar<int32_t>(3 + 1));
+
+  // Changing a fed value changes the fingerprint, so the result cached for
+  // the old value must not be reused.
+  cache_[std::make_pair(arg.node(), 0)] = test::AsScalar<int32_t>(10);
+  WithRunner().ExpectTensor(result, test::AsScalar<int32_t>(10 + 1));
+}
+
 TEST_F(EvaluateConstantTensorTest, DoNotEvalPlaceholderWithDefault) {
   auto tensor = test::AsTensor<float>({1, 2, 3});
   auto result1 = ops::Identity(scope_, tensor);
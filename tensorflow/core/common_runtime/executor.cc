@@ -73,6 +73,7 @@ limitations under the License.
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
+#include "tensorflow/core/profiler/lib/perf_counters.h"
 #include "tensorflow/core/profiler/lib/context_types.h"
 #include "tensorflow/core/profiler/lib/scoped_annotation.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
@@ -147,7 +148,9 @@ typedef gtl::InlinedVector<AllocatorAttributes, 4> AllocatorAttributeVec;
 
 class ExecutorImpl : public Executor {
  public:
-  explicit ExecutorImpl(const LocalExecutorParams& p) : immutable_state_(p) {}
+  explicit ExecutorImpl(const LocalExecutorParams& p,
+                        bool lock_free_dispatch = false)
+      : immutable_state_(p), lock_free_dispatch_(lock_free_dispatch) {}
 
   Status Initialize(const Graph& graph) {
     TF_RETURN_IF_ERROR(immutable_state_.Initialize(graph));
@@ -226,6 +229,11 @@ class ExecutorImpl : public Executor {
   ImmutableExecutorState immutable_state_;
   KernelStats kernel_stats_;
 
+  // If true, ready-node batches are dispatched to the inter-op pool through a
+  // shared lock-free claim counter instead of one closure per node. This
+  // reduces thread-pool queue contention for graphs with many cheap nodes.
+  const bool lock_free_dispatch_;
+
   ExecutorImpl(const ExecutorImpl&) = delete;
   void operator=(const ExecutorImpl&) = delete;
 };
@@ -284,7 +292,8 @@ class ExecutorState {
  public:
   ExecutorState(const Executor::Args& args,
                 const ImmutableExecutorState& immutable_state_,
-                ExecutorImpl::KernelStats* kernel_stats_);
+                ExecutorImpl::KernelStats* kernel_stats_,
+                bool lock_free_dispatch);
   ~ExecutorState();
 
   void RunAsync(Executor::DoneCallback done);
@@ -340,6 +349,16 @@ class ExecutorState {
   // REQUIRES: `!ready->empty()`.
   void ScheduleReady(TaggedNodeSeq* ready, TaggedNodeReadyQueue* inline_ready);
 
+  // Dispatches the nodes in `*ready` to the thread pool through a shared
+  // lock-free claim counter: a small number of claiming tasks is enqueued and
+  // each task repeatedly claims the next unprocessed node with a relaxed
+  // fetch_add. Compared with enqueuing one closure per node, this bounds the
+  // number of thread-pool queue operations (each of which takes the pool's
+  // lock) by `kLockFreeDispatchFanOut` regardless of batch size.
+  //
+  // This method leaves `*ready` in a moved-from state.
+  void ScheduleReadyLockFree(TaggedNodeSeq* ready, int64_t scheduled_nsec);
+
   // A wrapper for runner_ to keep track of the pending queue length. Op
   // execution should dispatch work using this function instead of using runner_
   // directly.
@@ -370,6 +389,11 @@ class ExecutorState {
   // TODO(fishx): Make it configurable if necessary.
   static constexpr uint64 kInlineScheduleReadyThreshold = 500;
 
+  // Maximum number of claiming tasks enqueued per ready batch when lock-free
+  // dispatch is enabled. Sized to keep a typical inter-op pool busy without
+  // oversubscribing the pool's queue.
+  static constexpr size_t kLockFreeDispatchFanOut = 8;
+
   // Not owned.
   RendezvousInterface* rendezvous_;
   CollectiveExecutor* collective_executor_ = nullptr;
@@ -398,6 +422,7 @@ class ExecutorState {
   Executor::Args::Runner runner_;
   bool sync_on_finish_;
   const bool run_all_kernels_inline_;
+  const bool lock_free_dispatch_;
 
   PropagatorStateType propagator_;
 
@@ -419,7 +444,7 @@ class ExecutorState {
 template <class PropagatorStateType>
 ExecutorState<PropagatorStateType>::ExecutorState(
     const Executor::Args& args, const ImmutableExecutorState& immutable_state,
-    ExecutorImpl::KernelStats* kernel_stats)
+    ExecutorImpl::KernelStats* kernel_stats, bool lock_free_dispatch)
     : vlog_(VLOG_IS_ON(1)),
       log_memory_(LogMemory::IsEnabled()),
       step_id_(args.step_id),
@@ -448,6 +473,7 @@ ExecutorState<PropagatorStateType>::ExecutorState(
       runner_(args.runner),
       sync_on_finish_(args.sync_on_finish),
       run_all_kernels_inline_(args.run_all_kernels_inline),
+      lock_free_dispatch_(lock_free_dispatch),
       propagator_(immutable_state, step_id_, vlog_),
       num_outstanding_ops_(0) {
   if (args.user_intra_op_threadpool != nullptr) {
@@ -578,6 +604,9 @@ bool MightTrace(const tsl::tracing::EventCollector* event_collector,
 
   if (tsl::profiler::ScopedAnnotation::IsEnabled()) return true;
 
+  // Hardware counter sampling piggybacks on the traced kernel path.
+  if (profiler::PerfCounterProfiler::IsEnabled()) return true;
+
   return tsl::profiler::TraceMe::Active(
       tsl::profiler::GetTFTraceMeLevel(is_expensive));
 }
@@ -603,6 +632,8 @@ Status ExecutorState<PropagatorStateType>::ProcessSync(
               ctx, /*verbose=*/tsl::profiler::TfOpDetailsEnabled());
         },
         tsl::profiler::GetTFTraceMeLevel(is_expensive));
+    profiler::PerfCounterProfiler::ScopedSample perf_sample(
+        op_kernel->type_string_view());
     device->Compute(op_kernel, &ctx);
   } else if (kernel_stats_->HasExpensiveMarker(item)) {
     KernelTimer timer;
@@ -1302,10 +1333,39 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
     const TaggedNode* curr_expensive_node = nullptr;
     TaggedNodeSeq expensive_nodes;
     if (inline_ready == nullptr) {
-      // Schedule to run all the ready ops in thread pool.
+      if (lock_free_dispatch_ && ready->size() > 1) {
+        ScheduleReadyLockFree(ready, scheduled_nsec);
+        ready->clear();
+        return;
+      }
+      // Batch all statically-cheap ready nodes into a single closure, so that
+      // a chain of inexpensive kernels (Identity/Const/Shape/Reshape etc.)
+      // costs one dispatch instead of a scheduling round-trip per node. Once
+      // running, `ProcessInline` keeps chaining through their inexpensive
+      // successors. Expensive nodes still get a thread each.
+      TaggedNodeSeq cheap_nodes;
       for (auto& tagged_node : *ready) {
-        RunTask([=]() { Process(tagged_node, scheduled_nsec); },
-                /*sample_rate=*/ready->size());
+        if (!tagged_node.get_is_dead() &&
+            tagged_node.get_node_item().is_trivially_cheap) {
+          cheap_nodes.push_back(tagged_node);
+        } else {
+          RunTask([=]() { Process(tagged_node, scheduled_nsec); },
+                  /*sample_rate=*/ready->size());
+        }
+      }
+      if (cheap_nodes.size() == 1) {
+        RunTask([this, tagged_node = cheap_nodes.front(), scheduled_nsec]() {
+          Process(tagged_node, scheduled_nsec);
+        });
+      } else if (!cheap_nodes.empty()) {
+        RunTask([this, cheap_nodes = std::move(cheap_nodes),
+                 scheduled_nsec]() {
+          TaggedNodeReadyQueue inline_batch;
+          for (auto& tagged_node : cheap_nodes) {
+            inline_batch.push_back(tagged_node);
+          }
+          ProcessInline(&inline_batch, scheduled_nsec);
+        });
       }
     } else {
       for (auto& tagged_node : *ready) {
@@ -1331,7 +1391,9 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
       }
     }
     if (!expensive_nodes.empty()) {
-      if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
+      if (lock_free_dispatch_ && expensive_nodes.size() > 1) {
+        ScheduleReadyLockFree(&expensive_nodes, scheduled_nsec);
+      } else if (expensive_nodes.size() < kInlineScheduleReadyThreshold) {
         for (auto& tagged_node : expensive_nodes) {
           RunTask(std::bind(&ExecutorState::Process, this, tagged_node,
                             scheduled_nsec),
@@ -1375,6 +1437,33 @@ void ExecutorState<PropagatorStateType>::ScheduleReady(
   ready->clear();
 }
 
+template <class PropagatorStateType>
+void ExecutorState<PropagatorStateType>::ScheduleReadyLockFree(
+    TaggedNodeSeq* ready, int64_t scheduled_nsec) {
+  // The batch outlives the claiming tasks; each task holds a reference.
+  struct SharedBatch {
+    explicit SharedBatch(TaggedNodeSeq n) : nodes(std::move(n)) {}
+    const TaggedNodeSeq nodes;
+    // Index of the next unclaimed node. Aligned to avoid false sharing with
+    // the (immutable) node storage.
+    alignas(64) std::atomic<size_t> next{0};
+  };
+  auto batch = std::make_shared<SharedBatch>(std::move(*ready));
+  const size_t num_nodes = batch->nodes.size();
+  const size_t num_tasks = std::min(num_nodes, kLockFreeDispatchFanOut);
+  for (size_t i = 0; i < num_tasks; ++i) {
+    RunTask(
+        [this, batch, scheduled_nsec]() {
+          size_t index;
+          while ((index = batch->next.fetch_add(
+                      1, std::memory_order_relaxed)) < batch->nodes.size()) {
+            Process(batch->nodes[index], scheduled_nsec);
+          }
+        },
+        /*sample_rate=*/num_nodes);
+  }
+}
+
 template <class PropagatorStateType>
 void ExecutorState<PropagatorStateType>::ScheduleFinish() {
   // Checks condition to decide if needs to invoke Finish(). If there are
@@ -1514,14 +1603,17 @@ void ExecutorState<PropagatorStateType>::Finish() {
 void ExecutorImpl::RunAsyncInternal(const Args& args, DoneCallback done) {
   if (OpOrderDeterminismRequired()) {
     (new ExecutorState<OrderedPropagatorState>(args, immutable_state_,
-                                               &kernel_stats_))
+                                               &kernel_stats_,
+                                               lock_free_dispatch_))
         ->RunAsync(std::move(done));
   } else if (immutable_state_.requires_control_flow_support()) {
-    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_))
+    (new ExecutorState<PropagatorState>(args, immutable_state_, &kernel_stats_,
+                                        lock_free_dispatch_))
         ->RunAsync(std::move(done));
   } else {
     (new ExecutorState<SimplePropagatorState>(args, immutable_state_,
-                                              &kernel_stats_))
+                                              &kernel_stats_,
+                                              lock_free_dispatch_))
         ->RunAsync(std::move(done));
   }
 }
@@ -1575,6 +1667,30 @@ class DefaultExecutorRegistrar {
 };
 static DefaultExecutorRegistrar registrar;
 
+// Experimental executor type that dispatches ready-node batches through a
+// shared lock-free claim counter (see `ScheduleReadyLockFree`). Select it by
+// setting the `executor_type` graph option to "LOCK_FREE" to A/B against the
+// default executor.
+class LockFreeExecutorRegistrar {
+ public:
+  LockFreeExecutorRegistrar() {
+    ExecutorFactory::Register("LOCK_FREE", new Factory);
+  }
+
+ private:
+  class Factory : public ExecutorFactory {
+    Status NewExecutor(const LocalExecutorParams& params, const Graph& graph,
+                       std::unique_ptr<Executor>* out_executor) override {
+      auto impl =
+          std::make_unique<ExecutorImpl>(params, /*lock_free_dispatch=*/true);
+      TF_RETURN_IF_ERROR(impl->Initialize(graph));
+      *out_executor = std::move(impl);
+      return absl::OkStatus();
+    }
+  };
+};
+static LockFreeExecutorRegistrar lock_free_registrar;
+
 }  // namespace
 
 }  // namespace tensorflow
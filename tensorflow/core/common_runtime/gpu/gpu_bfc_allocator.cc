@@ -80,6 +80,28 @@ bool GetGarbageCollectionValue() {
       << " Using the default value \"true\".";
   return true;
 }
+
+double GetDefragmentationThresholdValue(double orig_value) {
+  const char* defragmentation_threshold_string =
+      std::getenv("TF_GPU_DEFRAGMENTATION_THRESHOLD");
+  if (defragmentation_threshold_string == nullptr) {
+    return orig_value;
+  }
+
+  char* end = nullptr;
+  double parsed_value = std::strtod(defragmentation_threshold_string, &end);
+  if (end != defragmentation_threshold_string && *end == '\0' &&
+      parsed_value >= 0.0 && parsed_value <= 1.0) {
+    return parsed_value;
+  }
+
+  LOG(ERROR)
+      << "The TF_GPU_DEFRAGMENTATION_THRESHOLD environment variable is set but"
+      << " could not be parsed: \"" << defragmentation_threshold_string
+      << "\". Valid values are numbers in [0, 1]. Using original config value"
+      << " of " << orig_value << ".";
+  return orig_value;
+}
 }  // anonymous namespace
 
 GPUBFCAllocator::GPUBFCAllocator(
@@ -95,6 +117,8 @@ GPUBFCAllocator::GPUBFCAllocator(
           o.garbage_collection = GetGarbageCollectionValue();
         }
         o.fragmentation_fraction = opts.fragmentation_fraction;
+        o.defragmentation_threshold =
+            GetDefragmentationThresholdValue(opts.defragmentation_threshold);
         return o;
       }()) {}
 
@@ -45,6 +45,13 @@ class GPUBFCAllocator : public tsl::BFCAllocator {
     std::optional<bool> garbage_collection;
 
     double fragmentation_fraction = 0;
+
+    // Overridden by TF_GPU_DEFRAGMENTATION_THRESHOLD if that envvar is set.
+    // When positive, wholly free memory regions are proactively returned to
+    // the GPU driver whenever the fragmentation metric exceeds this
+    // fraction; see BFCAllocator::Options::defragmentation_threshold.
+    double defragmentation_threshold = 0.0;
+
     bool allow_retry_on_failure = true;
   };
 
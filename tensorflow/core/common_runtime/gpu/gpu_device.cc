@@ -352,6 +352,22 @@ class BaseGPUDevice::StreamGroupFactory {
         VLOG(2) << "Created device_to_device_stream[" << stream_group_within_gpu
                 << "] = " << group->device_to_device.back();
       }
+
+      group->compute_streams.push_back(group->compute);
+      int64_t num_compute_streams = 1;
+      TF_CHECK_OK(ReadInt64FromEnvVar("TF_GPU_NUM_COMPUTE_STREAMS", 1,
+                                      &num_compute_streams));
+      if (num_compute_streams < 1 || num_compute_streams > 4) {
+        LOG(ERROR) << "Illegal TF_GPU_NUM_COMPUTE_STREAMS="
+                   << num_compute_streams << " set to 1 instead.";
+        num_compute_streams = 1;
+      }
+      for (int i = 1; i < num_compute_streams; ++i) {
+        se::Stream* stream = GetInitializedStream(executor, priority);
+        group->compute_streams.push_back(stream);
+        VLOG(2) << "Created compute stream[" << stream_group_within_gpu << "]["
+                << i << "] = " << stream;
+      }
     }
     return group;
   }
@@ -368,6 +384,17 @@ class BaseGPUDevice::StreamGroupFactory {
     mutex_lock guard(lock_);
     for (auto& item : streams_) {
       auto& stream = item.second;
+      while (stream.compute_streams.size() > 1) {
+        auto back = stream.compute_streams.back();
+        if (back && back != stream.compute) {
+#ifndef TF_GPU_USE_PJRT  // When PJRT is used, streams are managed by
+                         // PjRtClient.
+          delete back;
+#endif
+        }
+        stream.compute_streams.pop_back();
+      }
+      stream.compute_streams.clear();
       if (stream.compute) {
 #ifndef TF_GPU_USE_PJRT  // When PJRT is used, streams are managed by
                          // PjRtClient.
@@ -530,6 +557,7 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
   stream_group.priority =
       GetPriority(tf_device_id_.value(), options.config.gpu_options());
   stream_group.compute = xla_local_device_state->compute_stream();
+  stream_group.compute_streams.push_back(stream_group.compute);
   stream_group.host_to_device = xla_local_device_state->host_to_device_stream();
   stream_group.device_to_host = xla_local_device_state->GetDeviceToHostStream();
   std::vector<se::Stream*> d2d_streams_from_local_devices_state =
@@ -564,7 +592,6 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
 #endif
                            stream_->host_to_device, stream_->device_to_host,
                            stream_->device_to_device, host_memory_allocator);
-
   em_ = EventMgrFactory::Singleton()->GetEventMgr(executor_,
                                                   options.config.gpu_options());
 
@@ -593,6 +620,19 @@ Status BaseGPUDevice::Init(const SessionOptions& options) {
         timestamped_allocator_ ? gpu_allocator_ : nullptr, em_));
   }
 
+  multi_stream_ = stream_->compute_streams.size() > 1;
+  if (multi_stream_ && !timestamped_allocator_) {
+    // The BFC allocator frees a buffer when its refcount drops, i.e. at kernel
+    // *enqueue* time; reusing it immediately is only safe on the stream that
+    // freed it.  With several compute streams the allocator must hold freed
+    // memory back until the safe frontier has passed the freeing kernel, which
+    // is exactly what the timestamped allocator provides.
+    LOG(WARNING) << "TF_GPU_NUM_COMPUTE_STREAMS > 1 requires "
+                    "GPUOptions::experimental::timestamped_allocator; "
+                    "falling back to a single compute stream for " << name();
+    multi_stream_ = false;
+  }
+
   accelerator_device_info_ = new DeviceBase::AcceleratorDeviceInfo;
   accelerator_device_info_->stream = stream_->compute;
   accelerator_device_info_->default_context = device_context_;
@@ -854,9 +894,89 @@ Status BaseGPUDevice::Sync() {
   // enqueued the operation has completed.  We do use other streams for copies
   // and collectives, but in those cases the (Async)OpKernels themselves block
   // until the queued operation has finished.
+  if (stream_->compute_streams.size() > 1) {
+    for (se::Stream* compute : stream_->compute_streams) {
+      TF_RETURN_IF_ERROR(compute->BlockHostUntilDone());
+    }
+    return OkStatus();
+  }
   return stream_->compute->BlockHostUntilDone();
 }
 
+namespace {
+
+// Device context handed to a single executor run in multi-stream mode.  The
+// constructor makes the assigned compute stream wait for the current tails of
+// the device's other compute streams, so this executor's kernels are ordered
+// after the already-enqueued producers of its inputs -- in particular
+// call-frame arguments written by a caller running on a different stream,
+// which are handed over without a copy.  The destructor enqueues the reverse
+// fence; ExecutorState destroys its device context before invoking the done
+// callback, so consumers of this executor's outputs (e.g. a caller reading
+// function results) are ordered after its kernels no matter which stream they
+// run on.  Both fences are device-side only and never block the host.
+class MultiStreamGPUDeviceContext : public GPUDeviceContext {
+ public:
+  MultiStreamGPUDeviceContext(
+      int stream_id, gtl::InlinedVector<se::Stream*, 4> compute_streams,
+#if TENSORFLOW_USE_ROCM
+      se::Stream* nccl_stream,
+#endif
+      se::Stream* host_to_device_stream, se::Stream* device_to_host_stream,
+      gtl::InlinedVector<se::Stream*, 4> device_to_device_stream,
+      Allocator* host_memory_allocator)
+      : GPUDeviceContext(stream_id, compute_streams[stream_id],
+#if TENSORFLOW_USE_ROCM
+                         nccl_stream,
+#endif
+                         host_to_device_stream, device_to_host_stream,
+                         std::move(device_to_device_stream),
+                         host_memory_allocator),
+        compute_streams_(std::move(compute_streams)) {
+    for (se::Stream* other : compute_streams_) {
+      if (other != stream()) {
+        // A failed wait leaves the stream in an error state, which the
+        // executor surfaces through RefreshStatus/Sync.
+        stream()->WaitFor(other).IgnoreError();
+      }
+    }
+  }
+
+  ~MultiStreamGPUDeviceContext() override {
+    for (se::Stream* other : compute_streams_) {
+      if (other != stream()) {
+        other->WaitFor(stream()).IgnoreError();
+      }
+    }
+  }
+
+ private:
+  gtl::InlinedVector<se::Stream*, 4> compute_streams_;
+};
+
+}  // namespace
+
+Status BaseGPUDevice::TryGetDeviceContext(DeviceContext** out_context) {
+  if (!multi_stream_) {
+    // Single-stream mode: fall back to the default context.
+    *out_context = nullptr;
+    return OkStatus();
+  }
+  const int index =
+      next_compute_stream_.fetch_add(1, std::memory_order_relaxed) %
+      stream_->compute_streams.size();
+  *out_context = new MultiStreamGPUDeviceContext(
+      index, stream_->compute_streams,
+#if TENSORFLOW_USE_ROCM
+      stream_->nccl,
+#endif
+      stream_->host_to_device, stream_->device_to_host,
+      stream_->device_to_device, device_context_->host_memory_allocator());
+  VLOG(1) << "Assigned executor on " << name() << " to compute stream["
+          << index << "]";
+  return OkStatus();
+}
+
 void BaseGPUDevice::ComputeAsync(AsyncOpKernel* op_kernel,
                                  OpKernelContext* context,
                                  AsyncOpKernel::DoneCallback done) {
@@ -1289,9 +1409,13 @@ void BaseGPUDevice::ReinitializeDevice(OpKernelContext* context,
   ConcretePerOpGpuDevice* concrete_device =
       static_cast<ConcretePerOpGpuDevice*>(device);
   DCHECK(concrete_device);
-  DCHECK_EQ(stream_id, 0);
+  se::Stream* compute_stream = stream_->compute;
+  if (stream_id > 0) {
+    DCHECK_LT(stream_id, stream_->compute_streams.size());
+    compute_stream = stream_->compute_streams[stream_id];
+  }
   const gpuStream_t gpu_stream = reinterpret_cast<gpuStream_t>(
-      stream_->compute->platform_specific_handle().stream);
+      compute_stream->platform_specific_handle().stream);
   concrete_device->Reinitialize(context, gpu_stream, tf_device_id_, allocator,
                                 scratch_);
 }
@@ -1310,7 +1434,7 @@ Status BaseGPUDevice::ReinitializeGpuDevice(OpKernelContext* context,
     const int stream_id = gpu_dc->stream_id();
     VLOG(1) << "  eigen_gpu_device(" << dc << ") => stream[" << stream_id
             << "]";
-    CHECK_EQ(stream_id, 0);
+    CHECK_LT(stream_id, static_cast<int>(stream_->compute_streams.size()));
     ReinitializeDevice(context, device, stream_id, allocator);
   } else {
     ReinitializeDevice(context, device, 0, allocator);
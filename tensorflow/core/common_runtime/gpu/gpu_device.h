@@ -26,6 +26,7 @@ limitations under the License.
 #define TF_GPU_USE_PJRT
 #endif  // PLATFORM_GOOGLE && TF_PLATFORM_LINUX_X86_64
 
+#include <atomic>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -100,6 +101,10 @@ class BaseGPUDevice : public LocalDevice {
 
   struct StreamGroup {
     se::Stream* compute = nullptr;
+    // All compute streams of the group, including `compute` at index 0. More
+    // than one entry is present only when multi-stream execution is enabled
+    // via TF_GPU_NUM_COMPUTE_STREAMS.
+    gtl::InlinedVector<se::Stream*, 4> compute_streams;
 #if TENSORFLOW_USE_ROCM
     se::Stream* nccl = nullptr;
 #endif
@@ -177,6 +182,20 @@ class BaseGPUDevice : public LocalDevice {
 
   se::Stream* compute_stream() { return stream_->compute; }
 
+  // When multi-stream execution is enabled (TF_GPU_NUM_COMPUTE_STREAMS > 1
+  // together with GPUOptions::experimental::timestamped_allocator), assigns
+  // each executor run one of the device's compute streams round-robin, so
+  // that independent subgraphs (partitions and function bodies) run
+  // concurrently on the GPU. The returned context fences its stream against
+  // the other compute streams on creation and destruction, ordering this
+  // executor's kernels after the already-enqueued producers of its inputs and
+  // before any later consumers of its outputs (call-frame tensors cross
+  // executor boundaries without a copy); the timestamped allocator keeps
+  // memory freed on one stream from being reused on another until the
+  // freeing kernel has retired. In single-stream mode, returns nullptr so
+  // callers fall back to the default context, preserving existing behavior.
+  Status TryGetDeviceContext(DeviceContext** out_context) override;
+
   // Given the compute stream for a GPU or virtual GPU, return the TfDeviceId
   // for the GPU or vGPU.
   static std::optional<tsl::TfDeviceId> FindTfDeviceId(se::Stream* compute);
@@ -209,6 +228,11 @@ class BaseGPUDevice : public LocalDevice {
   mutex scratch_init_mutex_;
   char* scratch_ = nullptr;
   GPUDeviceContext* device_context_;
+  // True when TryGetDeviceContext() hands out per-run multi-stream contexts;
+  // requires extra compute streams and the timestamped allocator (see Init).
+  bool multi_stream_ = false;
+  // Round-robin cursor for assigning executors to compute streams.
+  std::atomic<int> next_compute_stream_{0};
   DeviceBase::AcceleratorDeviceInfo* accelerator_device_info_ = nullptr;
   mutex trace_mu_;
   tsl::TfDeviceId tf_device_id_;
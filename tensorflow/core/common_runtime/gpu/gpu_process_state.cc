@@ -42,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/gpu/gpu_cudamalloc_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_debug_allocator.h"
 #include "tensorflow/core/common_runtime/gpu/gpu_id_manager.h"
+#include "tensorflow/core/common_runtime/gpu/pinned_host_buffer_pool.h"
 #include "tensorflow/core/common_runtime/pool_allocator.h"
 #include "tensorflow/core/common_runtime/shared_counter.h"
 #include "tensorflow/core/framework/log_memory.h"
@@ -374,6 +375,23 @@ Allocator* GPUProcessState::GetGpuHostAllocator(const GPUOptions& options,
       // at the cost of performance.
       allocator = new TrackingAllocator(allocator, true);
     }
+
+    // Optionally layer a size-class recycling pool over the pinned BFC
+    // allocator. Repeated alloc/free of same-sized staging buffers on the
+    // feed path (e.g. tensors allocated with gpu_compatible allocator
+    // attributes) is then satisfied from per-thread free lists without
+    // taking the BFC lock or growing the pinned region.
+    bool use_buffer_pool = false;
+    Status status = tsl::ReadBoolFromEnvVar("TF_GPU_HOST_BUFFER_POOL",
+                                            /*default_val=*/false,
+                                            &use_buffer_pool);
+    if (!status.ok()) {
+      LOG(ERROR) << "GetGpuHostAllocator: " << status.message();
+    }
+    if (use_buffer_pool) {
+      allocator =
+          new PinnedHostBufferPool(allocator, PinnedHostBufferPool::Options());
+    }
 #ifdef TF_GPU_USE_PJRT
     // Ownership of the GPU host allocator will be transferred to PJRT.
     AllocatorParts gpu_host_allocator({
@@ -0,0 +1,177 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/pinned_host_buffer_pool.h"
+
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/lib/core/bits.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/logging.h"
+
+namespace tensorflow {
+
+// Per-thread free lists, one per size class. The cache flushes its contents
+// into the pool's shared free lists when the owning thread exits, so the
+// pool must outlive every thread that touched it.
+struct PinnedHostBufferPool::ThreadCache {
+  PinnedHostBufferPool* pool = nullptr;
+  std::vector<std::vector<void*>> free_lists;
+  size_t cached_bytes = 0;
+
+  ~ThreadCache() {
+    for (int size_class = 0; size_class < static_cast<int>(free_lists.size());
+         ++size_class) {
+      for (void* ptr : free_lists[size_class]) {
+        pool->ReturnToSharedList(size_class, ptr);
+      }
+    }
+  }
+};
+
+PinnedHostBufferPool::PinnedHostBufferPool(Allocator* underlying,
+                                           const Options& options)
+    : underlying_(underlying),
+      options_(options),
+      pooling_enabled_(underlying->TracksAllocationSizes()) {
+  CHECK_LE(options_.min_size_class_log2, options_.max_size_class_log2);
+  shared_free_lists_.resize(num_size_classes());
+  if (!pooling_enabled_) {
+    LOG(WARNING) << "PinnedHostBufferPool over " << underlying_->Name()
+                 << " disabled: underlying allocator does not track "
+                    "allocation sizes";
+  }
+}
+
+PinnedHostBufferPool::~PinnedHostBufferPool() {
+  mutex_lock l(mu_);
+  for (int size_class = 0; size_class < num_size_classes(); ++size_class) {
+    for (void* ptr : shared_free_lists_[size_class]) {
+      underlying_->DeallocateRaw(ptr);
+    }
+    shared_free_lists_[size_class].clear();
+  }
+  shared_bytes_ = 0;
+}
+
+std::string PinnedHostBufferPool::Name() {
+  return strings::StrCat(underlying_->Name(), "_pool");
+}
+
+int PinnedHostBufferPool::SizeClassForRequest(size_t alignment,
+                                              size_t num_bytes) const {
+  if (!pooling_enabled_ || num_bytes == 0 ||
+      alignment > Allocator::kAllocatorAlignment) {
+    return -1;
+  }
+  const int log2 = std::max(Log2Ceiling64(num_bytes),
+                            options_.min_size_class_log2);
+  if (log2 > options_.max_size_class_log2) return -1;
+  return log2 - options_.min_size_class_log2;
+}
+
+int PinnedHostBufferPool::SizeClassForFree(const void* ptr) const {
+  if (!pooling_enabled_) return -1;
+  // Pooled buffers were requested from the underlying allocator at exactly
+  // their class size, so the recorded requested size identifies the class.
+  const size_t bytes = underlying_->RequestedSize(ptr);
+  const int log2 = Log2Floor64(bytes);
+  if (log2 < options_.min_size_class_log2 ||
+      log2 > options_.max_size_class_log2 || (size_t{1} << log2) != bytes) {
+    return -1;
+  }
+  return log2 - options_.min_size_class_log2;
+}
+
+PinnedHostBufferPool::ThreadCache* PinnedHostBufferPool::GetThreadCache() {
+  // A thread may touch several pools (e.g. one per NUMA node), so the
+  // thread-local slot holds one cache per pool.
+  thread_local std::vector<std::unique_ptr<ThreadCache>> caches;
+  for (const auto& cache : caches) {
+    if (cache->pool == this) return cache.get();
+  }
+  auto cache = std::make_unique<ThreadCache>();
+  cache->pool = this;
+  cache->free_lists.resize(num_size_classes());
+  caches.push_back(std::move(cache));
+  return caches.back().get();
+}
+
+void* PinnedHostBufferPool::AllocateRaw(size_t alignment, size_t num_bytes) {
+  const int size_class = SizeClassForRequest(alignment, num_bytes);
+  if (size_class < 0) {
+    return underlying_->AllocateRaw(alignment, num_bytes);
+  }
+  const size_t class_bytes = SizeClassBytes(size_class);
+
+  ThreadCache* cache = GetThreadCache();
+  std::vector<void*>& free_list = cache->free_lists[size_class];
+  if (!free_list.empty()) {
+    void* ptr = free_list.back();
+    free_list.pop_back();
+    cache->cached_bytes -= class_bytes;
+    return ptr;
+  }
+
+  {
+    mutex_lock l(mu_);
+    std::vector<void*>& shared = shared_free_lists_[size_class];
+    if (!shared.empty()) {
+      void* ptr = shared.back();
+      shared.pop_back();
+      shared_bytes_ -= class_bytes;
+      return ptr;
+    }
+  }
+
+  return underlying_->AllocateRaw(Allocator::kAllocatorAlignment, class_bytes);
+}
+
+void PinnedHostBufferPool::DeallocateRaw(void* ptr) {
+  if (ptr == nullptr) return;
+  const int size_class = SizeClassForFree(ptr);
+  if (size_class < 0) {
+    underlying_->DeallocateRaw(ptr);
+    return;
+  }
+  const size_t class_bytes = SizeClassBytes(size_class);
+
+  ThreadCache* cache = GetThreadCache();
+  if (cache->cached_bytes + class_bytes <= options_.max_bytes_per_thread) {
+    cache->free_lists[size_class].push_back(ptr);
+    cache->cached_bytes += class_bytes;
+    return;
+  }
+  ReturnToSharedList(size_class, ptr);
+}
+
+void PinnedHostBufferPool::ReturnToSharedList(int size_class, void* ptr) {
+  const size_t class_bytes = SizeClassBytes(size_class);
+  {
+    mutex_lock l(mu_);
+    if (shared_bytes_ + class_bytes <= options_.max_shared_bytes) {
+      shared_free_lists_[size_class].push_back(ptr);
+      shared_bytes_ += class_bytes;
+      return;
+    }
+  }
+  underlying_->DeallocateRaw(ptr);
+}
+
+}  // namespace tensorflow
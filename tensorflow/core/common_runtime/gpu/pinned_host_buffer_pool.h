@@ -0,0 +1,130 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_GPU_PINNED_HOST_BUFFER_POOL_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_GPU_PINNED_HOST_BUFFER_POOL_H_
+
+#include <optional>
+#include <vector>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// An allocator wrapper that recycles buffers through power-of-two size
+// classes with small per-thread caches, intended to sit in front of the
+// pinned gpu-host BFC allocator. Host-to-device staging buffers on the feed
+// path are allocated and freed at high rates with a small set of sizes;
+// satisfying those requests from a thread-local free list avoids both the
+// shared BFC lock and any chance of pinning new host memory on the critical
+// path.
+//
+// Allocations are rounded up to the nearest size class and recycled on free.
+// When a thread cache exceeds its byte budget, buffers overflow into shared
+// per-class free lists; when those exceed their budget, buffers are returned
+// to the underlying allocator. Requests outside the size-class range (or
+// with stronger-than-default alignment) pass through unchanged.
+//
+// Instances are expected to live for the process lifetime, like the
+// allocators they wrap: per-thread caches flush into the shared free lists
+// when their thread exits and assume the pool is still alive.
+// This class is thread safe.
+class PinnedHostBufferPool : public Allocator {
+ public:
+  struct Options {
+    // Smallest and largest recycled allocation, as log2 of bytes. Requests
+    // below the minimum are rounded up to it; requests above the maximum
+    // bypass the pool.
+    int min_size_class_log2 = 8;   // 256B
+    int max_size_class_log2 = 26;  // 64MB
+
+    // Maximum bytes a single thread cache may hold before freed buffers
+    // overflow into the shared free lists.
+    size_t max_bytes_per_thread = 16 << 20;
+
+    // Maximum bytes the shared free lists may hold before freed buffers are
+    // returned to the underlying allocator.
+    size_t max_shared_bytes = 256 << 20;
+  };
+
+  // Does not take ownership of `underlying`, which must outlive the pool.
+  PinnedHostBufferPool(Allocator* underlying, const Options& options);
+  ~PinnedHostBufferPool() override;
+
+  std::string Name() override;
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override;
+  void DeallocateRaw(void* ptr) override;
+
+  bool TracksAllocationSizes() const override {
+    return underlying_->TracksAllocationSizes();
+  }
+  size_t RequestedSize(const void* ptr) const override {
+    return underlying_->RequestedSize(ptr);
+  }
+  size_t AllocatedSize(const void* ptr) const override {
+    return underlying_->AllocatedSize(ptr);
+  }
+  std::optional<AllocatorStats> GetStats() override {
+    return underlying_->GetStats();
+  }
+  bool ClearStats() override { return underlying_->ClearStats(); }
+  AllocatorMemoryType GetMemoryType() const override {
+    return underlying_->GetMemoryType();
+  }
+
+ private:
+  struct ThreadCache;
+
+  // Returns the size-class index for an allocation request, or -1 if the
+  // request should bypass the pool.
+  int SizeClassForRequest(size_t alignment, size_t num_bytes) const;
+
+  // Returns the size-class index a freed buffer belongs to, based on the
+  // rounded size recorded by the underlying allocator, or -1 if the buffer
+  // did not come from a size class.
+  int SizeClassForFree(const void* ptr) const;
+
+  size_t SizeClassBytes(int size_class) const {
+    return size_t{1} << (options_.min_size_class_log2 + size_class);
+  }
+
+  int num_size_classes() const {
+    return options_.max_size_class_log2 - options_.min_size_class_log2 + 1;
+  }
+
+  // Returns this thread's cache for this pool, creating it on first use.
+  ThreadCache* GetThreadCache();
+
+  // Moves a buffer to the shared free list of its class, or returns it to
+  // the underlying allocator if the shared budget is exhausted.
+  void ReturnToSharedList(int size_class, void* ptr) TF_LOCKS_EXCLUDED(mu_);
+
+  Allocator* underlying_;  // not owned
+  const Options options_;
+  // Pooling requires the underlying allocator to report rounded request
+  // sizes on free; without that every request passes through.
+  const bool pooling_enabled_;
+
+  mutex mu_;
+  std::vector<std::vector<void*>> shared_free_lists_ TF_GUARDED_BY(mu_);
+  size_t shared_bytes_ TF_GUARDED_BY(mu_) = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_GPU_PINNED_HOST_BUFFER_POOL_H_
@@ -0,0 +1,164 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/gpu/pinned_host_buffer_pool.h"
+
+#include <cstdlib>
+#include <thread>
+#include <unordered_map>
+
+#include "tensorflow/core/framework/allocator.h"
+#include "tensorflow/core/platform/mem.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+// A malloc-backed allocator that counts allocations and frees and tracks
+// requested sizes, standing in for the pinned gpu_host_bfc allocator.
+class CountingAllocator : public Allocator {
+ public:
+  string Name() override { return "counting"; }
+
+  void* AllocateRaw(size_t alignment, size_t num_bytes) override {
+    void* ptr = port::AlignedMalloc(num_bytes, alignment);
+    mutex_lock l(mu_);
+    ++num_allocs_;
+    sizes_[ptr] = num_bytes;
+    return ptr;
+  }
+
+  void DeallocateRaw(void* ptr) override {
+    {
+      mutex_lock l(mu_);
+      ++num_frees_;
+      sizes_.erase(ptr);
+    }
+    port::AlignedFree(ptr);
+  }
+
+  bool TracksAllocationSizes() const override { return true; }
+
+  size_t RequestedSize(const void* ptr) const override {
+    mutex_lock l(mu_);
+    auto it = sizes_.find(ptr);
+    CHECK(it != sizes_.end());
+    return it->second;
+  }
+
+  int64_t num_allocs() const {
+    mutex_lock l(mu_);
+    return num_allocs_;
+  }
+  int64_t num_frees() const {
+    mutex_lock l(mu_);
+    return num_frees_;
+  }
+
+ private:
+  mutable mutex mu_;
+  int64_t num_allocs_ TF_GUARDED_BY(mu_) = 0;
+  int64_t num_frees_ TF_GUARDED_BY(mu_) = 0;
+  std::unordered_map<const void*, size_t> sizes_ TF_GUARDED_BY(mu_);
+};
+
+TEST(PinnedHostBufferPoolTest, RecyclesWithinSizeClass) {
+  CountingAllocator underlying;
+  PinnedHostBufferPool pool(&underlying, PinnedHostBufferPool::Options());
+
+  void* p1 = pool.AllocateRaw(Allocator::kAllocatorAlignment, 1000);
+  EXPECT_NE(p1, nullptr);
+  EXPECT_EQ(underlying.num_allocs(), 1);
+  // Requests are rounded up to the nearest power-of-two class.
+  EXPECT_EQ(pool.RequestedSize(p1), 1024);
+
+  pool.DeallocateRaw(p1);
+  EXPECT_EQ(underlying.num_frees(), 0);
+
+  // Any request in the same class is served from the free list.
+  void* p2 = pool.AllocateRaw(Allocator::kAllocatorAlignment, 600);
+  EXPECT_EQ(p2, p1);
+  EXPECT_EQ(underlying.num_allocs(), 1);
+  pool.DeallocateRaw(p2);
+}
+
+TEST(PinnedHostBufferPoolTest, DistinguishesSizeClasses) {
+  CountingAllocator underlying;
+  PinnedHostBufferPool pool(&underlying, PinnedHostBufferPool::Options());
+
+  void* small = pool.AllocateRaw(Allocator::kAllocatorAlignment, 512);
+  void* large = pool.AllocateRaw(Allocator::kAllocatorAlignment, 4096);
+  pool.DeallocateRaw(small);
+  pool.DeallocateRaw(large);
+
+  EXPECT_EQ(pool.AllocateRaw(Allocator::kAllocatorAlignment, 512), small);
+  EXPECT_EQ(pool.AllocateRaw(Allocator::kAllocatorAlignment, 4096), large);
+  pool.DeallocateRaw(small);
+  pool.DeallocateRaw(large);
+}
+
+TEST(PinnedHostBufferPoolTest, OversizedRequestsBypassThePool) {
+  CountingAllocator underlying;
+  PinnedHostBufferPool::Options options;
+  options.max_size_class_log2 = 12;  // 4KB
+  PinnedHostBufferPool pool(&underlying, options);
+
+  void* big = pool.AllocateRaw(Allocator::kAllocatorAlignment, 8192);
+  EXPECT_NE(big, nullptr);
+  EXPECT_EQ(underlying.num_allocs(), 1);
+  pool.DeallocateRaw(big);
+  // Bypassed buffers go straight back to the underlying allocator.
+  EXPECT_EQ(underlying.num_frees(), 1);
+}
+
+TEST(PinnedHostBufferPoolTest, SharedBudgetBoundsCachedBytes) {
+  CountingAllocator underlying;
+  PinnedHostBufferPool::Options options;
+  options.max_bytes_per_thread = 0;   // force everything to the shared lists
+  options.max_shared_bytes = 2048;    // room for exactly two 1KB buffers
+  PinnedHostBufferPool pool(&underlying, options);
+
+  void* ptrs[3];
+  for (void*& ptr : ptrs) {
+    ptr = pool.AllocateRaw(Allocator::kAllocatorAlignment, 1024);
+  }
+  for (void* ptr : ptrs) {
+    pool.DeallocateRaw(ptr);
+  }
+  // Two buffers fit in the shared budget; the third went back underneath.
+  EXPECT_EQ(underlying.num_frees(), 1);
+}
+
+TEST(PinnedHostBufferPoolTest, ThreadCacheFlushesOnThreadExit) {
+  CountingAllocator underlying;
+  PinnedHostBufferPool pool(&underlying, PinnedHostBufferPool::Options());
+
+  void* ptr = nullptr;
+  std::thread worker([&pool, &ptr]() {
+    ptr = pool.AllocateRaw(Allocator::kAllocatorAlignment, 2048);
+    pool.DeallocateRaw(ptr);
+  });
+  worker.join();
+
+  // The worker's cached buffer moved to the shared free lists at thread
+  // exit, so this thread can recycle it.
+  EXPECT_EQ(pool.AllocateRaw(Allocator::kAllocatorAlignment, 2048), ptr);
+  EXPECT_EQ(underlying.num_allocs(), 1);
+  pool.DeallocateRaw(ptr);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -45,13 +45,17 @@ limitations under the License.
 #include "tensorflow/core/graph/graph_debug_info_builder.h"
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/flatmap.h"
 #include "tensorflow/core/lib/gtl/flatset.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/strings/scanner.h"
 #include "tensorflow/core/lib/strings/str_util.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/public/version.h"
 
@@ -107,7 +111,8 @@ class GraphConstructor {
           importing(false),
           validate_nodes(in.validate_nodes),
           validate_colocation_constraints(false),
-          add_default_attributes(in.add_default_attributes) {}
+          add_default_attributes(in.add_default_attributes),
+          parallel_node_validation(in.parallel_node_validation) {}
     Options(const ImportGraphDefOptions& in)  // NOLINT(runtime/explicit)
         : allow_internal_ops(false),
           expect_device_spec(false),
@@ -161,6 +166,11 @@ class GraphConstructor {
     // value to the Node when they are missing from the NodeDef.
     bool add_default_attributes = true;
 
+    // If true, op lookup and attribute validation run in a parallel pre-pass.
+    // Only used when `importing` is false. See
+    // GraphConstructorOptions::parallel_node_validation.
+    bool parallel_node_validation = false;
+
     string default_device;
   };
 
@@ -1185,6 +1195,54 @@ Status GraphConstructor::Convert() {
         g_->AddFunctionLibrary(*std::move(library), library_traces));
   }
 
+  // Optionally resolve OpDefs and validate node attributes for all nodes in
+  // parallel before the topological construction pass below. The pass itself
+  // stays single-threaded (it mutates `g_`), but for graphs with hundreds of
+  // thousands of nodes op-registry lookups and attribute validation dominate
+  // conversion time and are independent per node.
+  std::vector<const OpDef*> pre_resolved_op_defs;
+  bool nodes_prevalidated = false;
+  if (!opts_.importing && opts_.parallel_node_validation &&
+      node_def_count() > 1) {
+    const int num_nodes = node_def_count();
+    pre_resolved_op_defs.resize(num_nodes, nullptr);
+    mutex status_mu;
+    Status validation_status;
+    thread::ThreadPool pool(Env::Default(), "graph_node_validation",
+                            port::MaxParallelism());
+    // Cost estimate (in ns) per node for the ParallelFor sharding heuristic.
+    constexpr int64_t kCostPerNode = 2500;
+    pool.ParallelFor(
+        num_nodes, kCostPerNode, [&](int64_t begin, int64_t end) {
+          for (int64_t i = begin; i < end; ++i) {
+            const NodeDef& node_def = get_node_def(i);
+            const OpDef* op_def;
+            Status s = g_->op_registry()->LookUpOpDef(node_def.op(), &op_def);
+            if (s.ok()) {
+              pre_resolved_op_defs[i] = op_def;
+              if (opts_.validate_nodes) {
+                if (opts_.add_default_attributes) {
+                  // Validate against a defaults-applied copy; the defaults are
+                  // applied to the node def itself when it is consumed below.
+                  NodeDef with_defaults = node_def;
+                  AddDefaultsToNodeDef(*op_def, &with_defaults);
+                  s = ValidateNodeDef(with_defaults, *op_def);
+                } else {
+                  s = ValidateNodeDef(node_def, *op_def);
+                }
+              }
+            }
+            if (!s.ok()) {
+              mutex_lock l(status_mu);
+              validation_status.Update(s);
+              return;
+            }
+          }
+        });
+    TF_RETURN_IF_ERROR(validation_status);
+    nodes_prevalidated = true;
+  }
+
   std::vector<InputInfo> inputs;
   int processed = 0;
 
@@ -1299,12 +1357,16 @@ Status GraphConstructor::Convert() {
       TF_RETURN_IF_ERROR(ModifyNodeDefForImport(&node_def));
     } else {
       const OpDef* op_def;
-      TF_RETURN_IF_ERROR(
-          g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+      if (nodes_prevalidated) {
+        op_def = pre_resolved_op_defs[o];
+      } else {
+        TF_RETURN_IF_ERROR(
+            g_->op_registry()->LookUpOpDef(node_def.op(), &op_def));
+      }
       if (opts_.add_default_attributes) {
         AddDefaultsToNodeDef(*op_def, &node_def);
       }
-      if (opts_.validate_nodes) {
+      if (opts_.validate_nodes && !nodes_prevalidated) {
         TF_RETURN_IF_ERROR(ValidateNodeDef(node_def, *op_def));
       }
     }
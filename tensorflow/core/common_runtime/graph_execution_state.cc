@@ -277,6 +277,10 @@ Status GraphExecutionState::Extend(
     auto base_graph = std::make_unique<Graph>(OpRegistry::Global());
     TF_RETURN_IF_ERROR(ConvertGraphDefToGraph(
         {}, *new_execution_state->original_graph_def_, base_graph.get()));
+    // Carry forward the placement decisions already made for the nodes of
+    // the current graph, so the Placer run in InitBaseGraph only needs to
+    // resolve constraints for the nodes added by this extension.
+    CarryForwardPlacements(base_graph.get());
     TF_RETURN_IF_ERROR(
         new_execution_state->InitBaseGraph(std::move(base_graph)));
   }
@@ -288,6 +292,23 @@ Status GraphExecutionState::Extend(
   return absl::OkStatus();
 }
 
+void GraphExecutionState::CarryForwardPlacements(Graph* new_graph) const {
+  if (graph_ == nullptr) return;
+  std::unordered_map<string, string> placements;
+  for (const Node* n : graph_->op_nodes()) {
+    if (n->has_assigned_device_name()) {
+      placements[n->name()] = n->assigned_device_name();
+    }
+  }
+  if (placements.empty()) return;
+  for (Node* n : new_graph->op_nodes()) {
+    auto iter = placements.find(n->name());
+    if (iter != placements.end()) {
+      n->set_assigned_device_name(iter->second);
+    }
+  }
+}
+
 void GraphExecutionState::SaveStatefulNodes(Graph* graph) {
   for (Node* n : graph->nodes()) {
     if (n->op_def().is_stateful()) {
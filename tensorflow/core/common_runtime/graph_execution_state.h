@@ -193,6 +193,14 @@ class GraphExecutionState {
   void SaveStatefulNodes(Graph* graph);
   void RestoreStatefulNodes(Graph* graph);
 
+  // Copies the device assignments from this state's placed graph to the
+  // matching nodes of `new_graph`. Used by Extend() so that placement of the
+  // combined graph is incremental: carried-over nodes keep their existing
+  // assignment (the Placer only pins them via LimitToAssignedDevice) and full
+  // constraint resolution runs only for the newly added nodes and their
+  // colocation frontier.
+  void CarryForwardPlacements(Graph* new_graph) const;
+
   // Extract the subset of the graph that needs to be run, adding feed/fetch
   // ops as needed.
   Status PruneGraph(const BuildGraphOptions& options, Graph* graph,
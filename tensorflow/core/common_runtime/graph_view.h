@@ -85,6 +85,10 @@ struct NodeItem {
                                     // node's input types.
   bool is_distributed_communication : 1;  // True iff the op is registered to
                                           // use distributed communication.
+  bool is_trivially_cheap : 1;  // True iff the kernel is synchronous and
+                                // statically reports !IsExpensive(), e.g.
+                                // Identity/Const/Shape/Reshape. Used to batch
+                                // cheap nodes into a single dispatch.
 
   // The kernel for this node.
   OpKernel* kernel = nullptr;
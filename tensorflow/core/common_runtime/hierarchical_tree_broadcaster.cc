@@ -75,6 +75,21 @@ int HierarchicalTreeBroadcaster::GetDeviceTask(
   return -1;
 }
 
+// The broadcast is staged hierarchically: subdiv 0 is a binary tree over one
+// representative device per task, and the remaining subdivs are binary trees
+// over the devices within each task.  Each task therefore receives the tensor
+// over the network exactly once, regardless of how many devices it holds;
+// fan-out to the other local devices happens via local DMA in the intra-task
+// stage.
+//
+// The task is the unit of locality here.  Group metadata (CollGroupMember)
+// carries no host identity, so two worker processes on the same machine are
+// indistinguishable from processes on different machines and each runs its
+// own inter-task receive.  Deployments that want intra-host traffic to stay
+// off the NIC should run one task per host spanning all of its devices; an
+// explicit intra-host stage across co-located processes would need both a
+// host id in the group metadata and a cross-process transport, neither of
+// which exists in the collectives stack.
 Status HierarchicalTreeBroadcaster::InitializeCollectiveParams(
     CollectiveParams* col_params) {
   CHECK_EQ(col_params->instance.type, BROADCAST_COLLECTIVE);
@@ -155,6 +155,8 @@ Status ImmutableExecutorState::Initialize(const Graph& graph) {
     }
     item->const_tensor = const_tensor;
     item->is_noop = (item->kernel->type_string_view() == "NoOp");
+    item->is_trivially_cheap =
+        !item->kernel_is_async && !item->kernel->IsExpensive();
     item->is_enter = IsEnter(n);
     if (item->is_enter) {
       bool is_constant_enter;
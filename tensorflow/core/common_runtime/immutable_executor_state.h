@@ -21,6 +21,7 @@ limitations under the License.
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "tensorflow/core/common_runtime/entry.h"
 #include "tensorflow/core/common_runtime/graph_view.h"
 #include "tensorflow/core/common_runtime/local_executor_params.h"
 #include "tensorflow/core/common_runtime/pending_counts.h"
@@ -101,6 +102,11 @@ class ImmutableExecutorState {
 
   bool requires_control_flow_support() const { return requires_control_flow_; }
 
+  // Pool of per-iteration `Entry` activation buffers. The pool is shared by
+  // all steps that execute against this state, so steady-state Run() calls
+  // reuse the buffers released by earlier steps instead of hitting the heap.
+  EntryBufferPool* entry_buffer_pool() const { return &entry_buffer_pool_; }
+
   // Copies the pending counts for nodes in this graph to the given array.
   //
   // This method provides a more efficient way of initializing
@@ -155,6 +161,13 @@ class ImmutableExecutorState {
   // Shallow copies of the constant tensors used in the graph.
   std::vector<Tensor> const_tensors_;
 
+  // Recycled `Entry` activation buffers. This is per-step scratch state rather
+  // than graph structure, but it lives here so that the buffers survive across
+  // the executions that share this executor. `mutable` because the pool is
+  // used through const references to this object; it is internally
+  // thread-safe.
+  mutable EntryBufferPool entry_buffer_pool_;
+
   ImmutableExecutorState(const ImmutableExecutorState&) = delete;
   void operator=(const ImmutableExecutorState&) = delete;
 };
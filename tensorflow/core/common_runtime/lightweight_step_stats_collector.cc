@@ -0,0 +1,169 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/lightweight_step_stats_collector.h"
+
+#include <algorithm>
+#include <memory>
+
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/step_stats.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_description.pb.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/util/env_var.h"
+
+namespace tensorflow {
+
+class LightweightStepStatsCollector::LightweightNodeExecStats
+    : public NodeExecStatsInterface {
+ public:
+  LightweightNodeExecStats(LightweightStepStatsCollector* collector,
+                           const NodeDef* node)
+      : collector_(collector) {
+    record_.node = node;
+  }
+
+  void Done(const string& device) override {
+    NodeExecRecord* slot = collector_->ClaimRecord();
+    if (slot != nullptr) {
+      record_.device_index = collector_->DeviceIndex(device);
+      *slot = record_;
+    }
+    delete this;
+  }
+
+  void RecordExecutorStarted() override {
+    record_.all_start_nanos = Env::Default()->NowNanos();
+  }
+
+  void RecordComputeStarted() override {
+    record_.op_start_rel_nanos =
+        Env::Default()->NowNanos() - record_.all_start_nanos;
+  }
+
+  void RecordComputeEnded() override {
+    record_.op_end_rel_nanos =
+        Env::Default()->NowNanos() - record_.all_start_nanos;
+  }
+
+  void RecordExecutorEnded() override {
+    record_.all_end_rel_nanos =
+        Env::Default()->NowNanos() - record_.all_start_nanos;
+  }
+
+  bool TrackAllocations() const override { return false; }
+
+  void SetMemory(OpKernelContext* ctx) override {}
+
+  void SetOutput(int slot, const Tensor* tensor) override {
+    record_.output_bytes += tensor->TotalBytes();
+  }
+
+  void SetScheduled(int64_t nanos) override {}
+
+ private:
+  NodeExecRecord record_ = {};
+  LightweightStepStatsCollector* const collector_;  // Not owned.
+};
+
+std::unique_ptr<LightweightStepStatsCollector>
+LightweightStepStatsCollector::CreateIfSampled(int64_t step_count) {
+  static const int64_t period = [] {
+    int64_t period = 0;
+    TF_CHECK_OK(
+        ReadInt64FromEnvVar("TF_STEP_STATS_SAMPLE_PERIOD", 0, &period));
+    return period;
+  }();
+  if (period <= 0 || step_count % period != 0) {
+    return nullptr;
+  }
+  return std::make_unique<LightweightStepStatsCollector>();
+}
+
+LightweightStepStatsCollector::LightweightStepStatsCollector(
+    size_t max_records) {
+  records_.resize(max_records);
+}
+
+NodeExecStatsInterface* LightweightStepStatsCollector::CreateNodeExecStats(
+    const NodeDef* node) {
+  return new LightweightNodeExecStats(this, node);
+}
+
+size_t LightweightStepStatsCollector::num_records() const {
+  return std::min(num_claimed_.load(std::memory_order_relaxed),
+                  records_.size());
+}
+
+LightweightStepStatsCollector::NodeExecRecord*
+LightweightStepStatsCollector::ClaimRecord() {
+  const size_t ix = num_claimed_.fetch_add(1, std::memory_order_relaxed);
+  if (ix >= records_.size()) {
+    return nullptr;
+  }
+  return &records_[ix];
+}
+
+int32 LightweightStepStatsCollector::DeviceIndex(const string& device) {
+  mutex_lock l(mu_);
+  const int32 end = static_cast<int32>(device_names_.size());
+  for (int32 i = 0; i < end; ++i) {
+    if (device_names_[i] == device) {
+      return i;
+    }
+  }
+  device_names_.push_back(device);
+  return end;
+}
+
+void LightweightStepStatsCollector::ToStepStats(StepStats* step_stats) const {
+  std::vector<DeviceStepStats*> dev_stats;
+  {
+    mutex_lock l(mu_);
+    dev_stats.reserve(device_names_.size());
+    for (const string& device : device_names_) {
+      DeviceStepStats* ds = step_stats->add_dev_stats();
+      ds->set_device(device);
+      dev_stats.push_back(ds);
+    }
+  }
+  for (size_t i = 0, end = num_records(); i < end; ++i) {
+    const NodeExecRecord& record = records_[i];
+    NodeExecStats* stats =
+        dev_stats[record.device_index]->add_node_stats();
+    stats->set_node_name(record.node->name());
+    stats->set_all_start_micros(record.all_start_nanos /
+                                EnvTime::kMicrosToNanos);
+    stats->set_all_start_nanos(record.all_start_nanos);
+    stats->set_op_start_rel_micros(record.op_start_rel_nanos /
+                                   EnvTime::kMicrosToNanos);
+    stats->set_op_start_rel_nanos(record.op_start_rel_nanos);
+    stats->set_op_end_rel_micros(record.op_end_rel_nanos /
+                                 EnvTime::kMicrosToNanos);
+    stats->set_op_end_rel_nanos(record.op_end_rel_nanos);
+    stats->set_all_end_rel_micros(record.all_end_rel_nanos /
+                                  EnvTime::kMicrosToNanos);
+    stats->set_all_end_rel_nanos(record.all_end_rel_nanos);
+    if (record.output_bytes > 0) {
+      stats->add_output()
+          ->mutable_tensor_description()
+          ->mutable_allocation_description()
+          ->set_requested_bytes(record.output_bytes);
+    }
+  }
+}
+
+}  // namespace tensorflow
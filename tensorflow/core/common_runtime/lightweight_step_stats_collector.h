@@ -0,0 +1,105 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_LIGHTWEIGHT_STEP_STATS_COLLECTOR_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_LIGHTWEIGHT_STEP_STATS_COLLECTOR_H_
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/step_stats_collector.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/platform/thread_annotations.h"
+#include "tensorflow/core/platform/types.h"
+
+namespace tensorflow {
+
+// Fixed-cost statistics collection suitable for always-on use.
+//
+// The full StepStatsCollector allocates and fills a NodeExecStats proto per
+// node execution, which makes RunOptions.trace_level too expensive to leave
+// enabled in production. This collector instead writes fixed-size POD records
+// into an array preallocated at construction, so steady-state collection does
+// no heap allocation and no proto work; the per-node cost is a few clock
+// reads and an atomic increment. The records can be expanded into a regular
+// StepStats off the hot path with ToStepStats().
+//
+// Combined with step sampling (see CreateIfSampled), this allows collecting
+// op timing from long-running jobs continuously: only every Nth step pays the
+// already small collection cost.
+class LightweightStepStatsCollector : public StepStatsCollectorInterface {
+ public:
+  // Timing and output size of one node execution. Times follow the
+  // NodeExecStats convention: an absolute start plus ends relative to it.
+  // `node` points into the executed graph and must outlive the collector.
+  struct NodeExecRecord {
+    const NodeDef* node;
+    int32 device_index;
+    int64_t all_start_nanos;
+    int64_t op_start_rel_nanos;
+    int64_t op_end_rel_nanos;
+    int64_t all_end_rel_nanos;
+    int64_t output_bytes;
+  };
+
+  static constexpr size_t kDefaultMaxRecords = 1 << 14;
+
+  // Returns a collector if `step_count` falls on the sampling period
+  // configured via TF_STEP_STATS_SAMPLE_PERIOD (a period of N samples every
+  // Nth step; 0, the default, disables sampling), otherwise nullptr.
+  static std::unique_ptr<LightweightStepStatsCollector> CreateIfSampled(
+      int64_t step_count);
+
+  explicit LightweightStepStatsCollector(
+      size_t max_records = kDefaultMaxRecords);
+
+  NodeExecStatsInterface* CreateNodeExecStats(const NodeDef* node) override;
+  string ReportAllocsOnResourceExhausted(absl::string_view err) override {
+    return "";
+  }
+
+  // Number of completed records. Executions past the preallocated capacity
+  // are dropped. Records are complete once their node's `Done` has run;
+  // typically this is read after the step has finished.
+  size_t num_records() const;
+  const NodeExecRecord& record(size_t i) const { return records_[i]; }
+
+  // Expands the collected records into NodeExecStats grouped per device.
+  // This is exactly the proto work that collection avoids, so call it off
+  // the hot path, e.g. when a sampled step's results are exported. The
+  // aggregate output size of each node is reported as the requested bytes of
+  // a single output slot.
+  void ToStepStats(StepStats* step_stats) const;
+
+ private:
+  class LightweightNodeExecStats;
+
+  // Returns the slot for a completed record, or nullptr when the array is
+  // full.
+  NodeExecRecord* ClaimRecord();
+  // Interns `device` and returns its index. Devices are few, so records
+  // store a small index instead of the name.
+  int32 DeviceIndex(const string& device);
+
+  std::vector<NodeExecRecord> records_;
+  std::atomic<size_t> num_claimed_{0};
+  mutable mutex mu_;
+  std::vector<string> device_names_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_LIGHTWEIGHT_STEP_STATS_COLLECTOR_H_
@@ -0,0 +1,112 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/common_runtime/lightweight_step_stats_collector.h"
+
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/step_stats.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_description.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+NodeDef MakeNode(const string& name) {
+  NodeDef node;
+  node.set_name(name);
+  node.set_op("NoOp");
+  return node;
+}
+
+// Drives a node-stats object through the calls the executor makes for one
+// node execution.
+void SimulateExecution(LightweightStepStatsCollector* collector,
+                       const NodeDef* node, const string& device,
+                       const Tensor* output = nullptr) {
+  NodeExecStatsInterface* stats = collector->CreateNodeExecStats(node);
+  stats->RecordExecutorStarted();
+  stats->RecordComputeStarted();
+  stats->RecordComputeEnded();
+  if (output != nullptr) {
+    stats->SetOutput(0, output);
+  }
+  stats->RecordExecutorEnded();
+  stats->Done(device);
+}
+
+TEST(LightweightStepStatsCollectorTest, RecordsAndConvertsToStepStats) {
+  const NodeDef node_a = MakeNode("a");
+  const NodeDef node_b = MakeNode("b");
+  Tensor output(DT_FLOAT, TensorShape({16}));
+
+  LightweightStepStatsCollector collector;
+  SimulateExecution(&collector, &node_a, "/device:CPU:0", &output);
+  SimulateExecution(&collector, &node_b, "/device:CPU:1");
+  ASSERT_EQ(collector.num_records(), 2);
+
+  const auto& record = collector.record(0);
+  EXPECT_EQ(record.node, &node_a);
+  EXPECT_GT(record.all_start_nanos, 0);
+  EXPECT_LE(record.op_start_rel_nanos, record.op_end_rel_nanos);
+  EXPECT_LE(record.op_end_rel_nanos, record.all_end_rel_nanos);
+  EXPECT_EQ(record.output_bytes, output.TotalBytes());
+
+  StepStats step_stats;
+  collector.ToStepStats(&step_stats);
+  ASSERT_EQ(step_stats.dev_stats_size(), 2);
+  ASSERT_EQ(step_stats.dev_stats(0).node_stats_size(), 1);
+  const NodeExecStats& stats = step_stats.dev_stats(0).node_stats(0);
+  EXPECT_EQ(stats.node_name(), "a");
+  EXPECT_EQ(stats.all_start_nanos(), record.all_start_nanos);
+  EXPECT_EQ(stats.all_end_rel_nanos(), record.all_end_rel_nanos);
+  ASSERT_EQ(stats.output_size(), 1);
+  EXPECT_EQ(
+      stats.output(0).tensor_description().allocation_description().requested_bytes(),
+      output.TotalBytes());
+}
+
+TEST(LightweightStepStatsCollectorTest, SharesDeviceIndexAcrossRecords) {
+  const NodeDef node_a = MakeNode("a");
+  const NodeDef node_b = MakeNode("b");
+
+  LightweightStepStatsCollector collector;
+  SimulateExecution(&collector, &node_a, "/device:CPU:0");
+  SimulateExecution(&collector, &node_b, "/device:CPU:0");
+
+  StepStats step_stats;
+  collector.ToStepStats(&step_stats);
+  ASSERT_EQ(step_stats.dev_stats_size(), 1);
+  EXPECT_EQ(step_stats.dev_stats(0).node_stats_size(), 2);
+}
+
+TEST(LightweightStepStatsCollectorTest, DropsRecordsPastCapacity) {
+  const NodeDef node = MakeNode("a");
+
+  LightweightStepStatsCollector collector(/*max_records=*/2);
+  for (int i = 0; i < 5; ++i) {
+    SimulateExecution(&collector, &node, "/device:CPU:0");
+  }
+  EXPECT_EQ(collector.num_records(), 2);
+
+  StepStats step_stats;
+  collector.ToStepStats(&step_stats);
+  ASSERT_EQ(step_stats.dev_stats_size(), 1);
+  EXPECT_EQ(step_stats.dev_stats(0).node_stats_size(), 2);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -22,6 +22,7 @@ limitations under the License.
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/prefetch.h"
 #include "tensorflow/core/util/port.h"
 
 namespace tensorflow {
@@ -99,6 +100,14 @@ class PendingCounts {
 
   ~PendingCounts() { delete[] bytes_; }
 
+  // Issues a prefetch for the counts addressed by `h`. Per-node counts are
+  // scattered across the backing byte array, so callers that walk a node's
+  // successor list can hide the cache miss by prefetching one edge ahead of
+  // the count they are about to adjust.
+  void prefetch(Handle h) const {
+    port::prefetch<port::PREFETCH_HINT_T0>(bytes_ + h.byte_offset_);
+  }
+
   void set_initial_count(Handle h, size_t pending_count) {
     if (h.is_large_) {
       std::atomic<LargeCounts>* c_ptr = Large(h);
@@ -813,6 +813,10 @@ Status ProcessFunctionLibraryRuntime::InstantiateMultiDevice(
     }
   }
 
+  // Resolve the per-call execution plan once, so the run paths can replay it
+  // without per-call lookups.
+  PrepareCallPlan(data.get());
+
   *handle = AddMultiDeviceHandle(std::move(data), function_key);
   VLOG(1) << "Instantiated MultiDevice function \"" << function_name
           << "\" with handle " << *handle;
@@ -924,6 +928,29 @@ std::vector<string> ProcessFunctionLibraryRuntime::GetOrderedSubgraphs(
   return subgraph_keys;
 }
 
+void ProcessFunctionLibraryRuntime::PrepareCallPlan(
+    MultiDeviceFunctionData* data) const {
+  const std::vector<string> subgraph_keys = GetOrderedSubgraphs(data);
+  data->prepared_components.reserve(subgraph_keys.size());
+  for (const string& target : subgraph_keys) {
+    const auto iter = data->glue_.find(target);
+    DCHECK(iter != data->glue_.end());
+    MultiDeviceFunctionData::PreparedComponent component;
+    component.target = &iter->first;
+    component.comp_data = &iter->second;
+    component.flr = GetFLR(target);
+    if (component.flr != nullptr) {
+      // When the target device has a private thread pool, its runner replaces
+      // the caller's runner for this component.
+      thread::ThreadPool* pool =
+          component.flr->device()->tensorflow_device_thread_pool();
+      component.device_runner =
+          (pool == nullptr) ? nullptr : component.flr->runner();
+    }
+    data->prepared_components.push_back(component);
+  }
+}
+
 Status ProcessFunctionLibraryRuntime::RunMultiDeviceSync(
     const FunctionLibraryRuntime::Options& opts,
     FunctionLibraryRuntime::Handle outer_handle, std::vector<FunctionRet>* rets,
@@ -953,10 +980,11 @@ Status ProcessFunctionLibraryRuntime::RunMultiDeviceSync(
   //
   // We assume that the partitioning has a valid deadlock-free ordering and the
   // safety of running synchronously has already been confirmed by this point.
-  std::vector<string> subgraph_keys = GetOrderedSubgraphs(data);
-
-  for (const string& target : subgraph_keys) {
-    const ComponentFunctionData& comp_data = data->glue_.at(target);
+  // The ordering and the per-component FLRs and runners were resolved at
+  // instantiation by `PrepareCallPlan()`.
+  for (const auto& component : data->prepared_components) {
+    const string& target = *component.target;
+    const ComponentFunctionData& comp_data = *component.comp_data;
     FunctionLibraryRuntime::Handle comp_handle = comp_data.handle;
 
     opts_copy.args_alloc_attrs = comp_data.arg_alloc_attrs;
@@ -972,13 +1000,14 @@ Status ProcessFunctionLibraryRuntime::RunMultiDeviceSync(
 
     VLOG(1) << "Running component function on device " << target << " from "
             << data->function_name_ << " with handle " << comp_handle;
-    FunctionLibraryRuntime* flr = GetFLR(target);
+    FunctionLibraryRuntime* flr = component.flr;
     if (flr != nullptr) {
       opts_copy.remote_execution = false;
       // When target device has private thread pool, use the target device
       // runner
-      thread::ThreadPool* pool = flr->device()->tensorflow_device_thread_pool();
-      opts_copy.runner = (pool == nullptr) ? opts.runner : flr->runner();
+      opts_copy.runner = (component.device_runner == nullptr)
+                             ? opts.runner
+                             : component.device_runner;
       VLOG(4) << "    with " << opts_copy.DebugString();
 
       std::vector<Tensor> comp_tensor_rets;
@@ -1044,15 +1073,17 @@ void ProcessFunctionLibraryRuntime::RunMultiDeviceAsync(
   }
 
   auto* refcounted_done = new ReffedStatusCallback(std::move(done));
-  for (int i = 0; i < data->glue_.size(); ++i) {
+  for (int i = 0; i < data->prepared_components.size(); ++i) {
     refcounted_done->Ref();
   }
 
   FunctionLibraryRuntime::Options opts_copy = opts;
-  for (const auto& pair : data->glue_) {
-    const string& target = pair.first;
-    const ComponentFunctionData& comp_data = pair.second;
-    FunctionLibraryRuntime::Handle comp_handle = pair.second.handle;
+  // The per-component FLRs and runners were resolved at instantiation by
+  // `PrepareCallPlan()`.
+  for (const auto& component : data->prepared_components) {
+    const string& target = *component.target;
+    const ComponentFunctionData& comp_data = *component.comp_data;
+    FunctionLibraryRuntime::Handle comp_handle = comp_data.handle;
 
     opts_copy.args_alloc_attrs = comp_data.arg_alloc_attrs;
     opts_copy.rets_alloc_attrs = comp_data.ret_alloc_attrs;
@@ -1070,9 +1101,10 @@ void ProcessFunctionLibraryRuntime::RunMultiDeviceAsync(
     std::vector<FunctionRet>* comp_rets = new std::vector<FunctionRet>;
     rets->resize(data->num_outputs_);
 
-    auto component_fn_callback = [comp_rets, rets, comp_data, refcounted_done,
-                                  cm, local_cm, data, comp_handle,
-                                  target](const Status& status) {
+    auto component_fn_callback = [comp_rets, rets,
+                                  comp_data = component.comp_data,
+                                  refcounted_done, cm, local_cm, data,
+                                  comp_handle, target](const Status& status) {
       if (!status.ok()) {
         VLOG(2) << "Component function execution on target " << target
                 << " from " << data->function_name_ << " with handle "
@@ -1089,7 +1121,7 @@ void ProcessFunctionLibraryRuntime::RunMultiDeviceAsync(
                 << " from " << data->function_name_ << " with handle "
                 << comp_handle << " succeeded.";
         for (int i = 0; i < comp_rets->size(); ++i) {
-          (*rets)[comp_data.ret_indices[i]] = (*comp_rets)[i];
+          (*rets)[comp_data->ret_indices[i]] = (*comp_rets)[i];
         }
       }
       delete comp_rets;
@@ -1097,13 +1129,14 @@ void ProcessFunctionLibraryRuntime::RunMultiDeviceAsync(
       refcounted_done->Unref();
     };
 
-    FunctionLibraryRuntime* flr = GetFLR(target);
+    FunctionLibraryRuntime* flr = component.flr;
     if (flr != nullptr) {
       opts_copy.remote_execution = false;
       // When target device has private thread pool, use the target device
       // runner
-      thread::ThreadPool* pool = flr->device()->tensorflow_device_thread_pool();
-      opts_copy.runner = (pool == nullptr) ? opts.runner : flr->runner();
+      opts_copy.runner = (component.device_runner == nullptr)
+                             ? opts.runner
+                             : component.device_runner;
 
       VLOG(1) << "Running component function on device " << target << " from "
               << data->function_name_ << " with handle " << comp_handle;
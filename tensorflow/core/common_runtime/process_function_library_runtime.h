@@ -320,6 +320,27 @@ class ProcessFunctionLibraryRuntime {
     // Maps the device name to the information about the component function
     // be run on this device.
     std::unordered_map<string, ComponentFunctionData> glue_;
+
+    // A precomputed execution plan for one component function. The plan is
+    // built once by `PrepareCallPlan()` after all component functions are
+    // instantiated, and is replayed on every run, so the per-call hot path
+    // performs no FLR, device thread pool or subgraph-order lookups.
+    struct PreparedComponent {
+      // Points at the corresponding entry in `glue_`.
+      const string* target = nullptr;
+      const ComponentFunctionData* comp_data = nullptr;
+      // The local FLR of the component's target device; nullptr if the
+      // component runs through the distributed runtime.
+      FunctionLibraryRuntime* flr = nullptr;
+      // The target device's private thread pool runner, or nullptr to use the
+      // caller's runner.
+      std::function<void(std::function<void()>)>* device_runner = nullptr;
+    };
+
+    // Components in deadlock-free execution order for the synchronous path
+    // (send-only subgraphs first); the asynchronous path launches all of
+    // them.
+    std::vector<PreparedComponent> prepared_components;
   };
 
   struct CleanUpItem {
@@ -423,6 +444,11 @@ class ProcessFunctionLibraryRuntime {
   std::vector<string> GetOrderedSubgraphs(
       const MultiDeviceFunctionData* data) const;
 
+  // Builds `data->prepared_components`: resolves, once per instantiation, the
+  // execution order, local FLRs and device runners that the multi-device run
+  // paths would otherwise look up on every call.
+  void PrepareCallPlan(MultiDeviceFunctionData* data) const;
+
   Status PrepareRunMultiDevice(const FunctionLibraryRuntime::Options& opts,
                                FunctionLibraryRuntime::Handle handle,
                                const MultiDeviceFunctionData** data) const;
@@ -21,6 +21,7 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/hash.h"
+#include "tensorflow/core/platform/prefetch.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 
 namespace tensorflow {
@@ -39,8 +40,9 @@ PropagatorState::PropagatorState(const ImmutableExecutorState& immutable_state,
 
   // Initialize iteration 0.
   root_frame_->SetIteration(
-      0, new PropagatorState::IterationState(0, root_frame_->pending_counts,
-                                             root_frame_->total_input_tensors));
+      0, new PropagatorState::IterationState(
+             0, root_frame_->pending_counts, root_frame_->total_input_tensors,
+             immutable_state_.entry_buffer_pool()));
 
   outstanding_frames_.emplace(root_frame_->frame_id, root_frame_);
 }
@@ -290,8 +292,10 @@ void PropagatorState::FindOrCreateChildFrame(FrameState* frame,
   // Initialize iteration 0.
   {
     mutex_lock l(temp->mu);
-    temp->SetIteration(0, new IterationState(0, temp->pending_counts,
-                                             temp->total_input_tensors));
+    temp->SetIteration(
+        0, new IterationState(0, temp->pending_counts,
+                              temp->total_input_tensors,
+                              immutable_state_.entry_buffer_pool()));
   }
 
   {
@@ -437,7 +441,18 @@ int PropagatorState::FrameState::ActivateNodesFastPathInternal(
   } while (0);
 
   Entry* input_tensors = iter_state->input_tensors;
-  for (const EdgeInfo& e : item->output_edges()) {
+  const gtl::ArraySlice<EdgeInfo> output_edges = item->output_edges();
+  const int num_output_edges = output_edges.size();
+  for (int i = 0; i < num_output_edges; ++i) {
+    const EdgeInfo& e = output_edges[i];
+    // The destination activation slots and pending counts are scattered
+    // across their backing arrays, so walk one edge ahead of the store and
+    // count adjustment below to hide the cache misses.
+    if (i + 1 < num_output_edges) {
+      const EdgeInfo& next = output_edges[i + 1];
+      port::prefetch<port::PREFETCH_HINT_T0>(&input_tensors[next.input_slot]);
+      iter_state->prefetch_counts(immutable_state.pending_ids()[next.dst_id]);
+    }
     const int dst_id = e.dst_id;
     const PendingCounts::Handle dst_pending_id =
         immutable_state.pending_ids()[dst_id];
@@ -459,7 +474,15 @@ int PropagatorState::FrameState::ActivateNodesFastPathInternal(
     MAYBE_ADD_TO_READY(dst_id, adjust_result);
   }
 
-  for (const ControlEdgeInfo& e : item->output_control_edges()) {
+  const gtl::ArraySlice<ControlEdgeInfo> output_control_edges =
+      item->output_control_edges();
+  const int num_output_control_edges = output_control_edges.size();
+  for (int i = 0; i < num_output_control_edges; ++i) {
+    const ControlEdgeInfo& e = output_control_edges[i];
+    if (i + 1 < num_output_control_edges) {
+      iter_state->prefetch_counts(
+          immutable_state.pending_ids()[output_control_edges[i + 1].dst_id]);
+    }
     const int dst_id = e.dst_id;
     const PendingCounts::Handle dst_pending_id =
         immutable_state.pending_ids()[dst_id];
@@ -754,7 +777,8 @@ PropagatorState::FrameState::IncrementIteration(TaggedNodeSeq* ready) {
 
   // Initialize the next iteration.
   IterationState* next_iter =
-      new IterationState(iteration_count, pending_counts, total_input_tensors);
+      new IterationState(iteration_count, pending_counts, total_input_tensors,
+                         immutable_state.entry_buffer_pool());
   SetIteration(iteration_count, next_iter);
   num_outstanding_iterations++;
   {
@@ -127,11 +127,13 @@ class PropagatorState {
   struct IterationState {
     explicit IterationState(int64_t iter_num,
                             const PendingCounts* pending_counts,
-                            int total_input_tensors)
+                            int total_input_tensors, EntryBufferPool* pool)
         : iter_num(iter_num),
-          input_tensors(new Entry[total_input_tensors]),
+          input_tensors(pool->Acquire(total_input_tensors)),
           outstanding_ops(0),
           outstanding_frame_count(0),
+          pool_(pool),
+          num_input_tensors_(total_input_tensors),
           counts(*pending_counts) {  // Initialize with copy of *pending_counts
     }
 
@@ -153,6 +155,9 @@ class PropagatorState {
 
     // The number of outstanding frames for each iteration.
     int outstanding_frame_count;
+    // Prefetches the pending counts addressed by "h"; see
+    // PendingCounts::prefetch.
+    void prefetch_counts(PendingCounts::Handle h) const { counts.prefetch(h); }
     int pending(PendingCounts::Handle h) { return counts.pending(h); }
     int decrement_pending(PendingCounts::Handle h, int v) {
       return counts.decrement_pending(h, v);
@@ -206,9 +211,14 @@ class PropagatorState {
       return counts.adjust_for_activation_atomic(h, increment_dead);
     }
 
-    ~IterationState() { delete[] input_tensors; }
+    ~IterationState() { pool_->Release(input_tensors, num_input_tensors_); }
 
    private:
+    // The pool from which `input_tensors` was acquired, and its size. The
+    // buffer is returned to the pool (rather than freed) when the iteration
+    // is garbage collected, so subsequent iterations and steps can reuse it.
+    EntryBufferPool* const pool_;
+    const int num_input_tensors_;
     PendingCounts counts;
   };
 
@@ -0,0 +1,89 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/request_cost_attribution.h"
+
+#include <cstdint>
+
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_constants.h"
+
+#if !defined(_WIN32) && !defined(__wasm__)
+#include <time.h>
+#define TF_REQUEST_COST_HAS_THREAD_CPU_CLOCK 1
+#endif
+
+namespace tensorflow {
+namespace {
+
+// The innermost active scope of the calling thread.
+thread_local ScopedRequestCostAttribution* current_scope = nullptr;
+
+// CPU time consumed by the calling thread, in nanoseconds. Returns 0 on
+// platforms without a thread CPU clock, degrading attribution to
+// allocation-only rather than failing.
+int64_t ThreadCpuTimeNs() {
+#if defined(TF_REQUEST_COST_HAS_THREAD_CPU_CLOCK)
+  struct timespec ts;
+  if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &ts) != 0) return 0;
+  return static_cast<int64_t>(ts.tv_sec) * 1000000000 + ts.tv_nsec;
+#else
+  return 0;
+#endif
+}
+
+}  // namespace
+
+void RequestCostAttribution::ExportToRequestCost(
+    RequestCost* request_cost) const {
+  if (request_cost == nullptr) return;
+  request_cost->RecordCost(
+      {{kCpuCostName, absl::Nanoseconds(TotalCpuTimeNs())}});
+  request_cost->RecordMetrics(
+      {{kAllocatedBytesMetricName,
+        static_cast<double>(TotalAllocatedBytes())}});
+}
+
+ScopedRequestCostAttribution::ScopedRequestCostAttribution(
+    RequestCostAttribution* attribution)
+    : attribution_(attribution), parent_(current_scope) {
+  if (attribution_ == nullptr) return;
+  start_cpu_time_ns_ = ThreadCpuTimeNs();
+  current_scope = this;
+}
+
+ScopedRequestCostAttribution::~ScopedRequestCostAttribution() {
+  if (attribution_ == nullptr) return;
+  current_scope = parent_;
+  const int64_t cpu_time_ns = ThreadCpuTimeNs() - start_cpu_time_ns_;
+  attribution_->Flush(cpu_time_ns, allocated_bytes_);
+  if (parent_ != nullptr && parent_->attribution_ != nullptr) {
+    // Exclude this scope's CPU time from the enclosing scope so nested
+    // tokens don't double-bill the same cycles.
+    parent_->start_cpu_time_ns_ += cpu_time_ns;
+  }
+}
+
+void ScopedRequestCostAttribution::RecordAllocatedBytes(int64_t bytes) {
+  if (current_scope != nullptr) {
+    current_scope->allocated_bytes_ += bytes;
+  }
+}
+
+RequestCostAttribution* ScopedRequestCostAttribution::Current() {
+  return current_scope != nullptr ? current_scope->attribution_ : nullptr;
+}
+
+}  // namespace tensorflow
@@ -0,0 +1,106 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_ATTRIBUTION_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_ATTRIBUTION_H_
+
+#include <atomic>
+#include <cstdint>
+
+#include "tensorflow/core/common_runtime/request_cost.h"
+
+namespace tensorflow {
+
+// Tallies resource usage (CPU time, allocated bytes) that should be billed to
+// one request, across all the threads that execute work on its behalf.
+//
+// The existing RequestCost plumbing attributes a whole batch's cost from the
+// batching thread only, so CPU burned by executor threads is invisible and
+// attribution through batching is lossy. RequestCostAttribution is the
+// request token that closes this gap: each participating thread opens a
+// ScopedRequestCostAttribution referencing the token, accumulates usage in
+// plain per-thread counters while the scope is open, and flushes them with a
+// single atomic add when the scope closes. The totals can then be exported
+// into the request's RequestCost when the RPC finishes.
+class RequestCostAttribution {
+ public:
+  RequestCostAttribution() = default;
+  RequestCostAttribution(const RequestCostAttribution&) = delete;
+  RequestCostAttribution& operator=(const RequestCostAttribution&) = delete;
+
+  // Total CPU time tallied by closed scopes, in nanoseconds.
+  int64_t TotalCpuTimeNs() const {
+    return cpu_time_ns_.load(std::memory_order_relaxed);
+  }
+
+  // Total allocated bytes tallied by closed scopes.
+  int64_t TotalAllocatedBytes() const {
+    return allocated_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // Exports the tallied totals into `request_cost` as a "cpu" cost and an
+  // "allocated_bytes" metric. Expected to be called at the end of processing
+  // an rpc request, after all scopes have closed.
+  void ExportToRequestCost(RequestCost* request_cost) const;
+
+ private:
+  friend class ScopedRequestCostAttribution;
+
+  void Flush(int64_t cpu_time_ns, int64_t allocated_bytes) {
+    cpu_time_ns_.fetch_add(cpu_time_ns, std::memory_order_relaxed);
+    allocated_bytes_.fetch_add(allocated_bytes, std::memory_order_relaxed);
+  }
+
+  std::atomic<int64_t> cpu_time_ns_{0};
+  std::atomic<int64_t> allocated_bytes_{0};
+};
+
+// Attributes the enclosing scope's resource usage on this thread to the given
+// request token. The thread's CPU time spent inside the scope is measured
+// automatically; allocations are added via RecordAllocatedBytes. Scopes can
+// nest: usage recorded in a nested scope goes to the innermost token only.
+//
+// Thread-compatible: one scope belongs to one thread, but any number of
+// threads may hold scopes on the same RequestCostAttribution concurrently.
+class ScopedRequestCostAttribution {
+ public:
+  // A null `attribution` makes the scope a no-op, so call sites don't need to
+  // special-case requests without cost tracking.
+  explicit ScopedRequestCostAttribution(RequestCostAttribution* attribution);
+  ~ScopedRequestCostAttribution();
+
+  ScopedRequestCostAttribution(const ScopedRequestCostAttribution&) = delete;
+  ScopedRequestCostAttribution& operator=(const ScopedRequestCostAttribution&) =
+      delete;
+
+  // Adds to the innermost active scope of the calling thread, if any. This is
+  // a plain thread-local increment; the token's atomics are only touched when
+  // the scope closes.
+  static void RecordAllocatedBytes(int64_t bytes);
+
+  // Returns the token of the innermost active scope of the calling thread, or
+  // nullptr. Lets code that spawns work on other threads propagate the token.
+  static RequestCostAttribution* Current();
+
+ private:
+  RequestCostAttribution* attribution_;
+  ScopedRequestCostAttribution* parent_;
+  int64_t start_cpu_time_ns_ = 0;
+  int64_t allocated_bytes_ = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_REQUEST_COST_ATTRIBUTION_H_
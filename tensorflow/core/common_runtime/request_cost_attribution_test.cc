@@ -0,0 +1,114 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/common_runtime/request_cost_attribution.h"
+
+#include <thread>
+#include <vector>
+
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include "absl/time/time.h"
+#include "tensorflow/core/common_runtime/cost_constants.h"
+#include "tensorflow/core/common_runtime/request_cost.h"
+
+namespace tensorflow {
+namespace {
+
+using ::testing::DoubleEq;
+using ::testing::Pair;
+using ::testing::UnorderedElementsAre;
+
+TEST(RequestCostAttributionTest, StartsEmpty) {
+  RequestCostAttribution attribution;
+  EXPECT_EQ(attribution.TotalCpuTimeNs(), 0);
+  EXPECT_EQ(attribution.TotalAllocatedBytes(), 0);
+}
+
+TEST(RequestCostAttributionTest, NoActiveScopeIsANoOp) {
+  ScopedRequestCostAttribution::RecordAllocatedBytes(100);
+  EXPECT_EQ(ScopedRequestCostAttribution::Current(), nullptr);
+}
+
+TEST(RequestCostAttributionTest, NullAttributionIsANoOp) {
+  ScopedRequestCostAttribution scope(nullptr);
+  EXPECT_EQ(ScopedRequestCostAttribution::Current(), nullptr);
+  ScopedRequestCostAttribution::RecordAllocatedBytes(100);
+}
+
+TEST(RequestCostAttributionTest, ScopeFlushesOnClose) {
+  RequestCostAttribution attribution;
+  {
+    ScopedRequestCostAttribution scope(&attribution);
+    EXPECT_EQ(ScopedRequestCostAttribution::Current(), &attribution);
+    ScopedRequestCostAttribution::RecordAllocatedBytes(100);
+    ScopedRequestCostAttribution::RecordAllocatedBytes(200);
+    // Counters are per thread and only flushed when the scope closes.
+    EXPECT_EQ(attribution.TotalAllocatedBytes(), 0);
+  }
+  EXPECT_EQ(attribution.TotalAllocatedBytes(), 300);
+  EXPECT_EQ(ScopedRequestCostAttribution::Current(), nullptr);
+}
+
+TEST(RequestCostAttributionTest, NestedScopeBillsInnermostToken) {
+  RequestCostAttribution outer_attribution;
+  RequestCostAttribution inner_attribution;
+  {
+    ScopedRequestCostAttribution outer_scope(&outer_attribution);
+    ScopedRequestCostAttribution::RecordAllocatedBytes(100);
+    {
+      ScopedRequestCostAttribution inner_scope(&inner_attribution);
+      EXPECT_EQ(ScopedRequestCostAttribution::Current(), &inner_attribution);
+      ScopedRequestCostAttribution::RecordAllocatedBytes(50);
+    }
+    EXPECT_EQ(ScopedRequestCostAttribution::Current(), &outer_attribution);
+  }
+  EXPECT_EQ(outer_attribution.TotalAllocatedBytes(), 100);
+  EXPECT_EQ(inner_attribution.TotalAllocatedBytes(), 50);
+}
+
+TEST(RequestCostAttributionTest, AccumulatesAcrossThreads) {
+  RequestCostAttribution attribution;
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&attribution] {
+      ScopedRequestCostAttribution scope(&attribution);
+      ScopedRequestCostAttribution::RecordAllocatedBytes(25);
+    });
+  }
+  for (auto& thread : threads) thread.join();
+  EXPECT_EQ(attribution.TotalAllocatedBytes(), 100);
+}
+
+TEST(RequestCostAttributionTest, ExportsToRequestCost) {
+  RequestCostAttribution attribution;
+  {
+    ScopedRequestCostAttribution scope(&attribution);
+    ScopedRequestCostAttribution::RecordAllocatedBytes(1024);
+  }
+  RequestCost request_cost;
+  attribution.ExportToRequestCost(&request_cost);
+
+  EXPECT_THAT(
+      request_cost.GetCosts(),
+      UnorderedElementsAre(
+          Pair(kCpuCostName, absl::Nanoseconds(attribution.TotalCpuTimeNs()))));
+  EXPECT_THAT(request_cost.GetMetrics(),
+              UnorderedElementsAre(
+                  Pair(kAllocatedBytesMetricName, DoubleEq(1024.0))));
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -39,6 +39,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 // Set true for greater intelligibility of debug mode log messages.
 #define READABLE_KEYS false
@@ -46,7 +47,13 @@ limitations under the License.
 // depends on the number of subdivisions specified in the algorithm.  If the
 // user does not specify the number of subdivisions we may infer the number
 // dynamically so that the resulting chunk size does not exceed
-// kMaxChunkSizeBytes, empirically set at 4 MiB.
+// kMaxChunkSizeBytes, empirically set at 4 MiB.  Because every chunk
+// traverses every link in the ring, the chunk size also sets the pipelining
+// depth: smaller chunks mean more subdivisions and more transfers in flight
+// on each link, at the cost of more per-chunk overhead.  The best value
+// depends on the interconnect (PCIe rings want smaller chunks than NVLink
+// rings), so the default can be overridden with the
+// TF_COLLECTIVE_RING_MAX_CHUNK_BYTES environment variable.
 constexpr size_t kMaxChunkSizeBytes = (4 * 1024 * 1024);
 // kMaxSubdivsPerDeviceDefault is used to give an upper bound on the number of
 // subdivisions dynamically generated when user does not provide the parameter
@@ -107,6 +114,20 @@ RingAlg::RingAlg(CollectiveType type, const string& name)
       num_subdivs_(-1) {}
 
 namespace {
+// Returns the chunk size cap used when inferring the number of subdivisions,
+// honoring the TF_COLLECTIVE_RING_MAX_CHUNK_BYTES override.  Read on every
+// params initialization (not a hot path) so tests can vary it.
+size_t MaxChunkSizeBytes() {
+  int64_t value;
+  Status status = ReadInt64FromEnvVar("TF_COLLECTIVE_RING_MAX_CHUNK_BYTES",
+                                      kMaxChunkSizeBytes, &value);
+  if (!status.ok() || value <= 0) {
+    if (!status.ok()) LOG(WARNING) << status;
+    return kMaxChunkSizeBytes;
+  }
+  return static_cast<size_t>(value);
+}
+
 Status GenerateSubdivsInCollectiveParams(CollectiveParams* col_params) {
   // This function generates subdivision_offsets. Expect it to be empty when
   // called.
@@ -140,6 +161,7 @@ Status GenerateSubdivsInCollectiveParams(CollectiveParams* col_params) {
   int num_subdivs = 0;
   const size_t tensor_size = col_params->instance.shape.num_elements() *
                              DataTypeSize(col_params->instance.data_type);
+  const size_t max_chunk_size_bytes = MaxChunkSizeBytes();
   size_t chunk_size;
   do {
     ++num_subdivs;
@@ -147,7 +169,7 @@ Status GenerateSubdivsInCollectiveParams(CollectiveParams* col_params) {
     chunk_size = tensor_size / num_chunks;
     VLOG(2) << "num_subdivs " << num_subdivs << " num_chunks " << num_chunks
             << " chunk_size " << chunk_size;
-  } while (chunk_size > kMaxChunkSizeBytes && num_subdivs < kMaxNumSubdivs);
+  } while (chunk_size > max_chunk_size_bytes && num_subdivs < kMaxNumSubdivs);
   if (num_subdivs <= 0) {
     return errors::Internal("Unexpected num_subdivs ", num_subdivs, " in ",
                             col_params->instance.impl_details.collective_name);
@@ -356,6 +356,27 @@ TEST_F(RingReducerInitParamsTest, AutomaticSubdivUsesDefault) {
   RunSubdivPermsTest(cp.get(), {{0, 1, 2, 3}, {0, 1, 2, 3}}, {0, 0});
 }
 
+TEST_F(RingReducerInitParamsTest, AutomaticSubdivChunkSizeOverride) {
+  const int kNumDevsPerWorker = 1;
+  const int kNumWorkers = 4;
+  auto test_env =
+      CreateCollectiveTestEnv(kNumWorkers, kNumDevsPerWorker, DEVICE_CPU);
+  auto cp =
+      CreateCollectiveParams(*test_env, /*rank*/ 0, "RingReduce",
+                             REDUCTION_COLLECTIVE, DT_FLOAT, TensorShape({1}));
+
+  cp->default_rank = 0;
+  cp->instance.impl_details.subdiv_offsets.clear();
+  cp->instance.impl_details.max_subdivs_per_device = 0;
+  cp->instance.shape = TensorShape({104857600 / DataTypeSize(DT_FLOAT)});
+  // With the default 4 MiB cap this shape generates 2 subdivs (see
+  // AutomaticSubdivUsesDefault).  Raising the cap to 32 MiB makes the 25 MiB
+  // single-subdiv chunks acceptable.
+  setenv("TF_COLLECTIVE_RING_MAX_CHUNK_BYTES", "33554432", 1 /* overwrite */);
+  RunSubdivPermsTest(cp.get(), {{0, 1, 2, 3}}, {0});
+  unsetenv("TF_COLLECTIVE_RING_MAX_CHUNK_BYTES");
+}
+
 TEST_F(RingReducerInitParamsTest, AutomaticSubdivDisabled) {
   const int kNumDevsPerWorker = 1;
   const int kNumWorkers = 4;
@@ -0,0 +1,225 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// Microbenchmarks for fixed runtime overheads: executor per-op dispatch,
+// output propagation fan-out, local rendezvous send/recv, function call
+// dispatch and per-step container churn. These are intended for regression
+// tracking across releases; run with --benchmark_format=json to produce
+// output that can be trended in CI.
+
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/common_runtime/device_factory.h"
+#include "tensorflow/core/common_runtime/device_mgr.h"
+#include "tensorflow/core/common_runtime/graph_constructor.h"
+#include "tensorflow/core/common_runtime/kernel_benchmark_testlib.h"
+#include "tensorflow/core/common_runtime/process_function_library_runtime.h"
+#include "tensorflow/core/framework/control_flow.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/rendezvous.h"
+#include "tensorflow/core/framework/resource_mgr.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/graph/testlib.h"
+#include "tensorflow/core/lib/core/notification.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/public/session_options.h"
+#include "tensorflow/core/public/version.h"
+
+namespace tensorflow {
+namespace {
+
+// Measures per-op dispatch overhead with a linear chain of no-op nodes. Every
+// node has exactly one control input, so the time per item is dominated by
+// the executor's per-node bookkeeping rather than kernel work or scheduling
+// fan-out.
+void BM_ExecutorOpDispatchChain(::testing::benchmark::State& state) {
+  const int chain_length = state.range(0);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Node* prev = test::graph::NoOp(g, {});
+  for (int i = 1; i < chain_length; ++i) {
+    prev = test::graph::NoOp(g, {prev});
+  }
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetItemsProcessed(chain_length *
+                          static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ExecutorOpDispatchChain)
+    ->UseRealTime()
+    ->Arg(64)
+    ->Arg(1024)
+    ->Arg(16384);
+
+// Measures PropagateOutputs scaling: a single no-op node with `fanout`
+// downstream no-op consumers, so completing the producer makes all consumers
+// ready at once.
+void BM_ExecutorPropagateFanOut(::testing::benchmark::State& state) {
+  const int fanout = state.range(0);
+
+  Graph* g = new Graph(OpRegistry::Global());
+  Node* producer = test::graph::NoOp(g, {});
+  for (int i = 0; i < fanout; ++i) {
+    test::graph::NoOp(g, {producer});
+  }
+  FixupSourceAndSinkEdges(g);
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetItemsProcessed((fanout + 1) *
+                          static_cast<int64_t>(state.iterations()));
+}
+BENCHMARK(BM_ExecutorPropagateFanOut)
+    ->UseRealTime()
+    ->Arg(1)
+    ->Arg(16)
+    ->Arg(256)
+    ->Arg(4096);
+
+Rendezvous::ParsedKey MakeSendRecvKey(const string& name) {
+  const string key = Rendezvous::CreateKey(
+      "/job:localhost/replica:0/task:0/device:CPU:0", 1,
+      "/job:localhost/replica:0/task:0/device:CPU:1", name, FrameAndIter(0, 0));
+  Rendezvous::ParsedKey parsed;
+  TF_CHECK_OK(Rendezvous::ParseKey(key, &parsed));
+  return parsed;
+}
+
+// Measures the local rendezvous fast path: a send immediately consumed by a
+// recv on the same key, round-tripping a scalar tensor.
+void BM_LocalRendezvousSendRecv(::testing::benchmark::State& state) {
+  Rendezvous* rendez = NewLocalRendezvous();
+  const Rendezvous::ParsedKey key = MakeSendRecvKey("foo");
+  Tensor orig(DT_FLOAT, TensorShape({}));
+  orig.scalar<float>()() = 3.14;
+  Tensor val(DT_FLOAT, TensorShape({}));
+  bool is_dead = false;
+  Rendezvous::Args args;
+
+  for (auto s : state) {
+    TF_CHECK_OK(rendez->Send(key, args, orig, is_dead));
+    TF_CHECK_OK(rendez->Recv(key, args, &val, &is_dead));
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+  rendez->Unref();
+}
+BENCHMARK(BM_LocalRendezvousSendRecv);
+
+// Measures the fixed cost of dispatching a trivial instantiated function
+// through the FunctionLibraryRuntime. The function body (XTimesTwo on four
+// floats) is negligible, so the time per iteration is dominated by call
+// frame setup, executor launch and completion plumbing.
+void BM_FunctionCallOverhead(::testing::benchmark::State& state) {
+  SessionOptions options;
+  std::vector<std::unique_ptr<Device>> devices;
+  TF_CHECK_OK(DeviceFactory::AddDevices(
+      options, "/job:localhost/replica:0/task:0", &devices));
+  auto device_mgr = std::make_unique<StaticDeviceMgr>(std::move(devices));
+
+  FunctionDefLibrary proto;
+  *proto.add_function() = test::function::XTimesTwo();
+  FunctionLibraryDefinition lib_def(OpRegistry::Global(), proto);
+  OptimizerOptions optimizer_opts;
+  ProcessFunctionLibraryRuntime pflr(device_mgr.get(), Env::Default(),
+                                     &options.config, TF_GRAPH_DEF_VERSION,
+                                     &lib_def, optimizer_opts);
+  FunctionLibraryRuntime* flr =
+      pflr.GetFLR("/job:localhost/replica:0/task:0/cpu:0");
+  CHECK(flr != nullptr);
+
+  FunctionLibraryRuntime::Handle handle;
+  TF_CHECK_OK(flr->Instantiate(
+      "XTimesTwo", test::function::Attrs({{"T", DT_FLOAT}}), &handle));
+
+  Tensor x = test::AsTensor<float>({1, 2, 3, 4});
+  FunctionLibraryRuntime::Options opts;
+  for (auto s : state) {
+    std::vector<Tensor> out;
+    Notification done;
+    Status status;
+    flr->Run(opts, handle, {x}, &out, [&status, &done](const Status& s) {
+      status = s;
+      done.Notify();
+    });
+    done.WaitForNotification();
+    TF_CHECK_OK(status);
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()));
+
+  TF_CHECK_OK(flr->ReleaseHandle(handle));
+}
+BENCHMARK(BM_FunctionCallOverhead);
+
+class StubResource : public ResourceBase {
+ public:
+  string DebugString() const override { return "stub"; }
+};
+
+// Measures per-step container churn: every step creates and destroys a
+// ScopedStepContainer, optionally touching it with a resource creation so
+// the destructor has to run the cleanup callback. The first range argument
+// is the number of concurrent threads, the second is whether the container
+// is touched.
+void BM_ScopedStepContainerChurn(::testing::benchmark::State& state) {
+  const int num_threads = state.range(0);
+  const bool touch = state.range(1) != 0;
+  constexpr int kChurnPerTask = 256;
+
+  ResourceMgr rm;
+  auto cleanup = [&rm](const string& name) { rm.Cleanup(name).IgnoreError(); };
+  thread::ThreadPool pool(Env::Default(), "step_container_churn", num_threads);
+
+  int64_t next_step_id = 1;
+  for (auto s : state) {
+    BlockingCounter counter(num_threads);
+    for (int t = 0; t < num_threads; ++t) {
+      const int64_t base_step_id = next_step_id;
+      next_step_id += kChurnPerTask;
+      pool.Schedule([&rm, &cleanup, &counter, base_step_id, touch]() {
+        for (int i = 0; i < kChurnPerTask; ++i) {
+          ScopedStepContainer container(base_step_id + i, cleanup);
+          if (touch) {
+            TF_CHECK_OK(container.Create(&rm, "stub", new StubResource));
+          }
+        }
+        counter.DecrementCount();
+      });
+    }
+    counter.Wait();
+  }
+  state.SetItemsProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_threads * kChurnPerTask);
+}
+BENCHMARK(BM_ScopedStepContainerChurn)
+    ->UseRealTime()
+    ->ArgPair(1, 0)
+    ->ArgPair(1, 1)
+    ->ArgPair(4, 0)
+    ->ArgPair(4, 1)
+    ->ArgPair(16, 0)
+    ->ArgPair(16, 1);
+
+}  // namespace
+}  // namespace tensorflow
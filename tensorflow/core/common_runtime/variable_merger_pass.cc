@@ -13,7 +13,7 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
-#include "tensorflow/core/tpu/graph_rewrite/variable_merger_pass.h"
+#include "tensorflow/core/common_runtime/variable_merger_pass.h"
 
 #include <algorithm>
 #include <utility>
@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/types/span.h"
 #include "xla/status_macros.h"
 #include "tensorflow/core/common_runtime/optimization_registry.h"
+#include "tensorflow/core/config/flag_defs.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/node_def_util.h"
@@ -209,4 +210,22 @@ Status VariableMergerPass::Run(const GraphOptimizationPassOptions& options) {
   return absl::OkStatus();
 }
 
+// The TPU bridge registers VariableMergerPass unconditionally. The merge is
+// just as applicable to resource-variable-heavy CPU/GPU serving graphs, where
+// per-variable ReadVariableOp dispatch and locking add up; for those it is
+// rolled out behind a flag. A second run over an already-merged graph is a
+// no-op, so enabling the flag in a TPU build is harmless.
+class FlagGatedVariableMergerPass : public VariableMergerPass {
+ public:
+  Status Run(const GraphOptimizationPassOptions& options) override {
+    if (!flags::Global().enable_merge_variable_reads.value()) {
+      return absl::OkStatus();
+    }
+    return VariableMergerPass::Run(options);
+  }
+};
+
+REGISTER_OPTIMIZATION(OptimizationPassRegistry::POST_REWRITE_FOR_EXEC, 0,
+                      FlagGatedVariableMergerPass);
+
 }  // namespace tensorflow
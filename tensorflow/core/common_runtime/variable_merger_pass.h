@@ -29,8 +29,8 @@ limitations under the License.
 // It then merges ReadVariablesOp that have no control inputs and originate from
 // the same handle op into a single large ReadVariablesOp.
 
-#ifndef TENSORFLOW_CORE_TPU_GRAPH_REWRITE_VARIABLE_MERGER_PASS_H_
-#define TENSORFLOW_CORE_TPU_GRAPH_REWRITE_VARIABLE_MERGER_PASS_H_
+#ifndef TENSORFLOW_CORE_COMMON_RUNTIME_VARIABLE_MERGER_PASS_H_
+#define TENSORFLOW_CORE_COMMON_RUNTIME_VARIABLE_MERGER_PASS_H_
 
 #include "tensorflow/core/common_runtime/optimization_registry.h"
 #include "tensorflow/core/graph/graph.h"
@@ -45,4 +45,4 @@ class VariableMergerPass : public GraphOptimizationPass {
 
 }  // namespace tensorflow
 
-#endif  // TENSORFLOW_CORE_TPU_GRAPH_REWRITE_VARIABLE_MERGER_PASS_H_
+#endif  // TENSORFLOW_CORE_COMMON_RUNTIME_VARIABLE_MERGER_PASS_H_
@@ -64,6 +64,10 @@ class Flags {
   // TODO(b/341325107): Make this behavior the default and remove the flag.
   TF_DECLARE_FLAG(enable_function_pruning_before_inlining, false,
                   "If true, functions will be pruned before inlining.")
+  TF_DECLARE_FLAG(enable_merge_variable_reads, false,
+                  "If true, VarHandleOps and ReadVariableOps are merged into "
+                  "their fused multi-variable forms on all devices, not just "
+                  "in the TPU bridge.")
   // LINT.ThenChange(//tensorflow/core/config/flags_api_wrapper.cc)
 };
 
@@ -91,6 +91,7 @@ Status CompressElement(const std::vector<Tensor>& element,
   nonmemcpyable.resize_uninitialized(total_nonmemcpyable_size);
   char* nonmemcpyable_pos = nonmemcpyable.mdata();
   int nonmemcpyable_component_index = 0;
+  out->mutable_component_metadata()->Reserve(element.size());
   for (int i = 0; i < element.size(); ++i) {
     const auto& component = element[i];
     CompressedComponentMetadata* metadata =
@@ -107,6 +107,7 @@ constexpr char kSlackOpt[] = "slack";
 constexpr char kSlackPeriodOpt[] = "slack_period";
 constexpr char kMakeDeterministicOpt[] = "make_deterministic";
 constexpr char kFilterParallelizationOpt[] = "filter_parallelization";
+constexpr char kFilterPushdownOpt[] = "filter_pushdown";
 constexpr char kWarmStartOpt[] = "warm_start";
 
 void DefaultOptimizationGraphRewrites(
@@ -793,6 +794,26 @@ Status CopyBatch(AnyContext ctx,
   const size_t num_tuple_components = batch_elements.at(0).size();
   out_tensors->reserve(num_tuple_components);
   const int64_t num_batch_elements = batch_elements.size();
+  // Fast path for a batch of a single element: the batch component is the
+  // element itself with a leading dimension of 1, so the element's buffer can
+  // be aliased instead of allocated and copied. `batch_elements` is consumed
+  // by this function, so the aliased buffer ends up uniquely owned by the
+  // output.
+  if (num_batch_elements == 1) {
+    for (size_t component_index = 0; component_index < num_tuple_components;
+         ++component_index) {
+      Tensor& element = batch_elements.front()[component_index];
+      TensorShape batch_component_shape({1});
+      batch_component_shape.AppendShape(element.shape());
+      out_tensors->emplace_back();
+      if (!out_tensors->back().CopyFrom(element, batch_component_shape)) {
+        return errors::Internal(
+            "Failed to create a batch slice view of a tensor with shape ",
+            element.shape().DebugString());
+      }
+    }
+    return absl::OkStatus();
+  }
   for (size_t component_index = 0; component_index < num_tuple_components;
        ++component_index) {
     const Tensor& first_element = batch_elements.at(0)[component_index];
@@ -1000,6 +1021,8 @@ REGISTER_DATASET_EXPERIMENT("autotune_buffer_optimization",
                             RandomJobSamplePercentage<0>, IndependentHostTasks);
 REGISTER_DATASET_EXPERIMENT(kFilterParallelizationOpt,
                             RandomJobSamplePercentage<0>, AllTasks);
+REGISTER_DATASET_EXPERIMENT(kFilterPushdownOpt, RandomJobSamplePercentage<0>,
+                            AllTasks);
 REGISTER_DATASET_EXPERIMENT("min_outer_interleave_parallelism",
                             RandomJobSamplePercentage<0>, AllTasks);
 REGISTER_DATASET_EXPERIMENT("reduce_interleave_prefetch",
@@ -59,9 +59,14 @@ absl::Status GlobalShuffleIterator::GetNext(IteratorContext* ctx,
         " which is not globally shuffled."));
   }
 
-  absl::MutexLock l(&mu_);
-  TF_ASSIGN_OR_RETURN(int64_t output_index,
-                      ctx->index_mapper()(element_count_++));
+  // The lock is only needed to claim the next element position. The random
+  // access read itself is stateless, so it happens outside the critical
+  // section to allow concurrent callers to read from the source in parallel.
+  int64_t output_index;
+  {
+    absl::MutexLock l(&mu_);
+    TF_ASSIGN_OR_RETURN(output_index, ctx->index_mapper()(element_count_++));
+  }
   absl::Status status =
       dataset_->Get(AnyContext(ctx), output_index, out_tensors);
   if (absl::IsOutOfRange(status)) {
@@ -70,7 +70,9 @@ class GlobalShuffleIterator {
   explicit GlobalShuffleIterator(const DatasetBase* dataset)
       : dataset_(dataset) {}
 
-  // Returns the next shuffled element.
+  // Returns the next shuffled element. Safe to call from multiple threads:
+  // the element position is claimed under a lock, but the random access read
+  // of the source dataset runs unlocked so reads proceed in parallel.
   // REQUIRES: ctx->index_mapper() != nullptr.
   absl::Status GetNext(IteratorContext* ctx, std::vector<Tensor>* out_tensors,
                        bool* end_of_sequence);
@@ -0,0 +1,415 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// End-to-end benchmarks for reference tf.data input pipelines, complementing
+// the per-kernel microbenchmarks under `tensorflow/core/kernels/data/`. Each
+// benchmark assembles a full pipeline graph, executes it with the standalone
+// tf.data runtime, and reports elements/s and bytes/s through the benchmark
+// counters (use `--benchmark_format=<json|csv>` for machine-readable output
+// suitable for trend tracking). `GetNext` latency and throughput are
+// additionally exported to the tf.data metrics registry via
+// `IteratorMetricsCollector`, and the autotuning model's processing time
+// snapshot is reported as a counter to attribute time across stages.
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "absl/status/statusor.h"
+#include "absl/time/time.h"
+#include "tensorflow/core/data/metric_utils.h"
+#include "tensorflow/core/data/standalone.h"
+#include "tensorflow/core/framework/function.h"
+#include "tensorflow/core/framework/function.pb.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/graph.pb.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor.pb.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/framework/types.pb.h"
+#include "tensorflow/core/lib/io/record_writer.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/test.h"
+#include "tensorflow/core/platform/test_benchmark.h"
+#include "tensorflow/core/platform/tstring.h"
+
+namespace tensorflow {
+namespace data {
+namespace {
+
+using ::tensorflow::test::AsScalar;
+using ::tensorflow::test::AsTensor;
+using ::tensorflow::test::function::GDef;
+using ::tensorflow::test::function::NDef;
+
+NodeDef Int64Const(const std::string& name, int64_t value) {
+  return NDef(name, "Const", /*inputs=*/{},
+              {{"value", AsScalar<int64_t>(value)}, {"dtype", DT_INT64}});
+}
+
+NodeDef StringConst(const std::string& name, const tstring& value) {
+  return NDef(name, "Const", /*inputs=*/{},
+              {{"value", AsScalar<tstring>(value)}, {"dtype", DT_STRING}});
+}
+
+NodeDef BoolConst(const std::string& name, bool value) {
+  return NDef(name, "Const", /*inputs=*/{},
+              {{"value", AsScalar<bool>(value)}, {"dtype", DT_BOOL}});
+}
+
+NodeDef FilenamesConst(const std::string& name,
+                       const std::vector<tstring>& filenames) {
+  return NDef(
+      name, "Const", /*inputs=*/{},
+      {{"value", AsTensor<tstring>(
+                     filenames,
+                     TensorShape({static_cast<int64_t>(filenames.size())}))},
+       {"dtype", DT_STRING}});
+}
+
+// Writes `num_files` TFRecord files, each holding `records_per_file` records
+// that contain a serialized float tensor of `record_bytes` bytes.
+std::vector<tstring> WriteTFRecordFiles(int num_files, int records_per_file,
+                                        int record_bytes) {
+  Tensor element(DT_FLOAT,
+                 {record_bytes / static_cast<int64_t>(sizeof(float))});
+  element.flat<float>().setConstant(1.0f);
+  TensorProto proto;
+  element.AsProtoTensorContent(&proto);
+  const std::string record = proto.SerializeAsString();
+
+  std::vector<tstring> filenames;
+  for (int i = 0; i < num_files; ++i) {
+    std::string filename;
+    CHECK(Env::Default()->LocalTempFilename(&filename));
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(Env::Default()->NewWritableFile(filename, &file));
+    io::RecordWriter writer(file.get());
+    for (int j = 0; j < records_per_file; ++j) {
+      TF_CHECK_OK(writer.WriteRecord(record));
+    }
+    TF_CHECK_OK(writer.Close());
+    TF_CHECK_OK(file->Close());
+    filenames.push_back(filename);
+  }
+  return filenames;
+}
+
+// Writes `num_files` text files with `lines_per_file` lines whose lengths
+// cycle between 1 and 2 * `mean_line_bytes` - 1 bytes, so the produced
+// elements are ragged.
+std::vector<tstring> WriteTextFiles(int num_files, int lines_per_file,
+                                    int mean_line_bytes) {
+  std::vector<tstring> filenames;
+  for (int i = 0; i < num_files; ++i) {
+    std::string contents;
+    for (int j = 0; j < lines_per_file; ++j) {
+      const int line_bytes = 1 + (i + j) % (2 * mean_line_bytes - 1);
+      contents.append(line_bytes, 'x');
+      contents.push_back('\n');
+    }
+    std::string filename;
+    CHECK(Env::Default()->LocalTempFilename(&filename));
+    TF_CHECK_OK(WriteStringToFile(Env::Default(), filename, contents));
+    filenames.push_back(filename);
+  }
+  return filenames;
+}
+
+void DeleteFiles(const std::vector<tstring>& filenames) {
+  for (const tstring& filename : filenames) {
+    Env::Default()->DeleteFile(filename).IgnoreError();
+  }
+}
+
+// Function deserializing a record produced by `WriteTFRecordFiles` back into
+// a float tensor; this is the parse stage of the TFRecord reference pipeline.
+FunctionDef ParseTensorFn() {
+  return FunctionDefHelper::Create(
+      /*function_name=*/"ParseTensorFn",
+      /*in_def=*/{"record: string"},
+      /*out_def=*/{"parsed: float"},
+      /*attr_def=*/{},
+      /*node_def=*/
+      {{{"output"}, "ParseTensor", {"record"}, {{"out_type", DT_FLOAT}}}},
+      /*ret_def=*/{{"parsed", "output:output:0"}});
+}
+
+// Function mapping a filename to a TFRecordDataset reading it; this is the
+// per-shard reader of the interleave reference pipeline.
+FunctionDef TFRecordDatasetFn() {
+  return FunctionDefHelper::Create(
+      /*function_name=*/"TFRecordDatasetFn",
+      /*in_def=*/{"filename: string"},
+      /*out_def=*/{"handle: variant"},
+      /*attr_def=*/{},
+      /*node_def=*/
+      {{{"compression"},
+        "Const",
+        {},
+        {{"dtype", DT_STRING}, {"value", AsScalar<tstring>("")}}},
+       {{"buffer"},
+        "Const",
+        {},
+        {{"dtype", DT_INT64}, {"value", AsScalar<int64_t>(1 << 20)}}},
+       {{"records"},
+        "TFRecordDataset",
+        {"filename", "compression:output:0", "buffer:output:0"},
+        {}}},
+      /*ret_def=*/{{"handle", "records:handle:0"}});
+}
+
+// tf.data.TFRecordDataset(filenames)
+//     .map(tf.io.parse_tensor, num_parallel_calls)
+//     .shuffle(shuffle_buffer)
+//     .batch(batch_size, drop_remainder=True)
+//     .prefetch(8)
+GraphDef TFRecordPipelineGraph(const std::vector<tstring>& filenames,
+                               int64_t num_parallel_calls,
+                               int64_t shuffle_buffer, int64_t batch_size) {
+  return GDef(
+      {FilenamesConst("filenames", filenames),
+       StringConst("compression", ""),
+       Int64Const("read_buffer", 1 << 20),
+       NDef("records", "TFRecordDataset",
+            /*inputs=*/{"filenames", "compression", "read_buffer"}, {}),
+       Int64Const("num_parallel_calls", num_parallel_calls),
+       NDef("parse", "ParallelMapDatasetV2",
+            /*inputs=*/{"records", "num_parallel_calls"},
+            {{"f", FunctionDefHelper::FunctionRef("ParseTensorFn")},
+             {"Targuments", {}},
+             {"output_types", absl::Span<const DataType>{DT_FLOAT}},
+             {"output_shapes",
+              absl::Span<const PartialTensorShape>{PartialTensorShape({-1})}}}),
+       Int64Const("shuffle_buffer", shuffle_buffer),
+       Int64Const("seed", 42),
+       Int64Const("seed2", 7),
+       NDef("shuffle", "ShuffleDataset",
+            /*inputs=*/{"parse", "shuffle_buffer", "seed", "seed2"},
+            {{"output_types", absl::Span<const DataType>{DT_FLOAT}},
+             {"output_shapes",
+              absl::Span<const PartialTensorShape>{PartialTensorShape({-1})}}}),
+       Int64Const("batch_size", batch_size),
+       BoolConst("drop_remainder", true),
+       NDef("batch", "BatchDatasetV2",
+            /*inputs=*/{"shuffle", "batch_size", "drop_remainder"},
+            {{"output_types", absl::Span<const DataType>{DT_FLOAT}},
+             {"output_shapes",
+              absl::Span<const PartialTensorShape>{
+                  PartialTensorShape({batch_size, -1})}}}),
+       Int64Const("prefetch_buffer", 8),
+       NDef("prefetch", "PrefetchDataset",
+            /*inputs=*/{"batch", "prefetch_buffer"},
+            {{"output_types", absl::Span<const DataType>{DT_FLOAT}},
+             {"output_shapes",
+              absl::Span<const PartialTensorShape>{
+                  PartialTensorShape({batch_size, -1})}}}),
+       NDef("dataset", "_Retval", /*inputs=*/{"prefetch"},
+            {{"T", DT_VARIANT}, {"index", 0}})},
+      {ParseTensorFn()});
+}
+
+// tf.data.Dataset.from_tensor_slices(filenames)
+//     .interleave(tf.data.TFRecordDataset, cycle_length,
+//                 num_parallel_calls=cycle_length)
+GraphDef InterleavePipelineGraph(const std::vector<tstring>& filenames,
+                                 int64_t cycle_length) {
+  return GDef(
+      {FilenamesConst("filenames", filenames),
+       NDef("files", "TensorSliceDataset", /*inputs=*/{"filenames"},
+            {{"Toutput_types", absl::Span<const DataType>{DT_STRING}},
+             {"output_shapes", absl::Span<const TensorShape>{TensorShape()}}}),
+       Int64Const("cycle_length", cycle_length),
+       Int64Const("block_length", 1),
+       Int64Const("buffer_output_elements", 16),
+       Int64Const("prefetch_input_elements", 2),
+       Int64Const("num_parallel_calls", cycle_length),
+       NDef("interleave", "ParallelInterleaveDatasetV4",
+            /*inputs=*/
+            {"files", "cycle_length", "block_length", "buffer_output_elements",
+             "prefetch_input_elements", "num_parallel_calls"},
+            {{"f", FunctionDefHelper::FunctionRef("TFRecordDatasetFn")},
+             {"Targuments", {}},
+             {"output_types", absl::Span<const DataType>{DT_STRING}},
+             {"output_shapes", absl::Span<const TensorShape>{TensorShape()}}}),
+       NDef("dataset", "_Retval", /*inputs=*/{"interleave"},
+            {{"T", DT_VARIANT}, {"index", 0}})},
+      {TFRecordDatasetFn()});
+}
+
+// tf.data.TextLineDataset(filenames)
+//     .shuffle(shuffle_buffer)
+//     .batch(batch_size, drop_remainder=True)
+GraphDef TextPipelineGraph(const std::vector<tstring>& filenames,
+                           int64_t shuffle_buffer, int64_t batch_size) {
+  return GDef(
+      {FilenamesConst("filenames", filenames),
+       StringConst("compression", ""),
+       Int64Const("read_buffer", 1 << 20),
+       NDef("lines", "TextLineDataset",
+            /*inputs=*/{"filenames", "compression", "read_buffer"}, {}),
+       Int64Const("shuffle_buffer", shuffle_buffer),
+       Int64Const("seed", 42),
+       Int64Const("seed2", 7),
+       NDef("shuffle", "ShuffleDataset",
+            /*inputs=*/{"lines", "shuffle_buffer", "seed", "seed2"},
+            {{"output_types", absl::Span<const DataType>{DT_STRING}},
+             {"output_shapes", absl::Span<const TensorShape>{TensorShape()}}}),
+       Int64Const("batch_size", batch_size),
+       BoolConst("drop_remainder", true),
+       NDef("batch", "BatchDatasetV2",
+            /*inputs=*/{"shuffle", "batch_size", "drop_remainder"},
+            {{"output_types", absl::Span<const DataType>{DT_STRING}},
+             {"output_shapes",
+              absl::Span<const PartialTensorShape>{
+                  PartialTensorShape({batch_size})}}}),
+       NDef("dataset", "_Retval", /*inputs=*/{"batch"},
+            {{"T", DT_VARIANT}, {"index", 0}})},
+      {});
+}
+
+// Runs the pipeline described by `graph_def` for the benchmark duration,
+// rewinding it outside of the measurement whenever it is exhausted, and
+// reports elements/s, bytes/s and the model's processing time snapshot.
+// `elements_per_call` is the number of pipeline elements that one `GetNext`
+// call yields (i.e. the batch size for batched pipelines).
+void RunPipelineBenchmark(::testing::benchmark::State& state,
+                          const GraphDef& graph_def,
+                          int64_t elements_per_call) {
+  std::unique_ptr<standalone::Dataset> dataset;
+  TF_CHECK_OK(standalone::Dataset::FromGraph({}, graph_def, &dataset));
+  std::unique_ptr<standalone::Iterator> iterator;
+  TF_CHECK_OK(dataset->MakeIterator(&iterator));
+  IteratorMetricsCollector metrics_collector(DEVICE_CPU, *Env::Default());
+
+  int64_t num_elements = 0;
+  int64_t num_bytes = 0;
+  for (auto s : state) {
+    std::vector<Tensor> outputs;
+    bool end_of_input = false;
+    absl::Time start_time = metrics_collector.RecordStart();
+    Status status = iterator->GetNext(&outputs, &end_of_input);
+    metrics_collector.RecordStop(start_time, outputs);
+    TF_CHECK_OK(status);
+    if (end_of_input) {
+      state.PauseTiming();
+      TF_CHECK_OK(dataset->MakeIterator(&iterator));
+      state.ResumeTiming();
+      continue;
+    }
+    num_elements += elements_per_call;
+    for (const Tensor& t : outputs) {
+      num_bytes += t.TotalBytes();
+    }
+  }
+  state.SetItemsProcessed(num_elements);
+  state.SetBytesProcessed(num_bytes);
+  if (iterator->model() != nullptr) {
+    state.counters["model_processing_time_ns"] = static_cast<double>(
+        iterator->model()->ComputeSnapshotProcessingTimeNsec());
+  }
+}
+
+// Reference pipeline: read TFRecords, parse, shuffle, batch and prefetch.
+// Arguments: number of parallel parse calls, record size in bytes.
+void BM_TFRecordParseShuffleBatch(::testing::benchmark::State& state) {
+  const int64_t num_parallel_calls = state.range(0);
+  const int64_t record_bytes = state.range(1);
+  const std::vector<tstring> filenames =
+      WriteTFRecordFiles(/*num_files=*/4, /*records_per_file=*/512,
+                         /*record_bytes=*/record_bytes);
+  RunPipelineBenchmark(
+      state,
+      TFRecordPipelineGraph(filenames, num_parallel_calls,
+                            /*shuffle_buffer=*/1024, /*batch_size=*/32),
+      /*elements_per_call=*/32);
+  DeleteFiles(filenames);
+}
+
+BENCHMARK(BM_TFRecordParseShuffleBatch)
+    ->ArgPair(1, 1024)
+    ->ArgPair(4, 1024)
+    ->ArgPair(16, 1024)
+    ->ArgPair(4, 16 << 10);
+
+// Reference pipeline: interleave reads across many TFRecord shards.
+// Argument: cycle length, which also bounds the reader parallelism.
+void BM_InterleaveTFRecord(::testing::benchmark::State& state) {
+  const int64_t cycle_length = state.range(0);
+  const std::vector<tstring> filenames =
+      WriteTFRecordFiles(/*num_files=*/16, /*records_per_file=*/512,
+                         /*record_bytes=*/1024);
+  RunPipelineBenchmark(state, InterleavePipelineGraph(filenames, cycle_length),
+                       /*elements_per_call=*/1);
+  DeleteFiles(filenames);
+}
+
+BENCHMARK(BM_InterleaveTFRecord)->Arg(1)->Arg(4)->Arg(16);
+
+// Reference pipeline: read ragged text lines, shuffle and batch them.
+// Argument: mean line length in bytes.
+void BM_RaggedTextShuffleBatch(::testing::benchmark::State& state) {
+  const int64_t mean_line_bytes = state.range(0);
+  const std::vector<tstring> filenames =
+      WriteTextFiles(/*num_files=*/4, /*lines_per_file=*/4096,
+                     /*mean_line_bytes=*/mean_line_bytes);
+  RunPipelineBenchmark(state,
+                       TextPipelineGraph(filenames, /*shuffle_buffer=*/1024,
+                                         /*batch_size=*/64),
+                       /*elements_per_call=*/64);
+  DeleteFiles(filenames);
+}
+
+BENCHMARK(BM_RaggedTextShuffleBatch)->Arg(16)->Arg(256)->Arg(4096);
+
+// Reference pipeline: checkpoint and restore a stateful pipeline, as done
+// when resuming from a snapshot. The shuffle buffer dominates the size of
+// the checkpoint.
+void BM_IteratorSaveRestore(::testing::benchmark::State& state) {
+  const int64_t shuffle_buffer = state.range(0);
+  const std::vector<tstring> filenames =
+      WriteTFRecordFiles(/*num_files=*/4, /*records_per_file=*/512,
+                         /*record_bytes=*/1024);
+  std::unique_ptr<standalone::Dataset> dataset;
+  TF_CHECK_OK(standalone::Dataset::FromGraph(
+      {},
+      TFRecordPipelineGraph(filenames, /*num_parallel_calls=*/4,
+                            shuffle_buffer, /*batch_size=*/32),
+      &dataset));
+  std::unique_ptr<standalone::Iterator> iterator;
+  TF_CHECK_OK(dataset->MakeIterator(&iterator));
+  // Fill the shuffle buffer so that the checkpoint has a realistic size.
+  std::vector<Tensor> outputs;
+  bool end_of_input = false;
+  TF_CHECK_OK(iterator->GetNext(&outputs, &end_of_input));
+
+  for (auto s : state) {
+    absl::StatusOr<std::vector<Tensor>> saved = iterator->Save();
+    TF_CHECK_OK(saved.status());
+    TF_CHECK_OK(iterator->Restore(*saved));
+  }
+  state.SetItemsProcessed(state.iterations());
+  DeleteFiles(filenames);
+}
+
+BENCHMARK(BM_IteratorSaveRestore)->Arg(1)->Arg(1024);
+
+}  // namespace
+}  // namespace data
+}  // namespace tensorflow
@@ -174,6 +174,7 @@ class IteratorStateVariant {
  public:
   IteratorStateVariant() = default;
   IteratorStateVariant(const IteratorStateVariant& other);
+  IteratorStateVariant(IteratorStateVariant&& other) = default;
   IteratorStateVariant& operator=(IteratorStateVariant&& other) = default;
   IteratorStateVariant& operator=(const IteratorStateVariant& other) = delete;
 
@@ -126,6 +126,15 @@ class CrossTrainerCache {
     bool cache_hit;
   };
 
+  // A cached element along with its size estimate from insertion time. The
+  // size is remembered so that eviction does not re-measure the element, and
+  // so that the bytes freed always match the bytes that were accounted when
+  // the element was inserted.
+  struct CachedElement {
+    std::shared_ptr<const ElementType> element;
+    size_t size_bytes;
+  };
+
   // Returns the next element and metrics about this query.
   StatusOr<CacheQueryResult> GetCacheQueryResult(const std::string& trainer_id);
 
@@ -166,7 +175,7 @@ class CrossTrainerCache {
   Status status_ TF_GUARDED_BY(mu_) = absl::OkStatus();
 
   // `cache_` stores the cached elements.
-  std::deque<std::shared_ptr<const ElementType>> cache_ TF_GUARDED_BY(mu_);
+  std::deque<CachedElement> cache_ TF_GUARDED_BY(mu_);
   size_t cache_size_bytes_ TF_GUARDED_BY(mu_) = 0;
   size_t cache_start_index_ TF_GUARDED_BY(mu_) = 0;
 
@@ -262,7 +271,7 @@ CrossTrainerCache<ElementType>::GetElement(const std::string& trainer_id)
   }
 
   std::shared_ptr<const ElementType> result =
-      cache_[element_index - cache_start_index_];
+      cache_[element_index - cache_start_index_].element;
   trainer_to_element_index_map_[trainer_id] = element_index + 1;
   return result;
 }
@@ -292,7 +301,9 @@ Status CrossTrainerCache<ElementType>::ExtendCache() TF_LOCKS_EXCLUDED(mu_) {
   mutex_lock l(mu_);
   TF_RETURN_IF_ERROR(status_);
   FreeSpace(new_element_size_bytes);
-  cache_.push_back(std::make_shared<ElementType>(std::move(element)));
+  cache_.push_back(
+      CachedElement{std::make_shared<ElementType>(std::move(element)),
+                    new_element_size_bytes});
   cache_size_bytes_ += new_element_size_bytes;
   return absl::OkStatus();
 }
@@ -303,8 +314,7 @@ void CrossTrainerCache<ElementType>::FreeSpace(size_t new_element_size_bytes)
   size_t num_elements_discarded = 0;
   while (!cache_.empty() &&
          cache_size_bytes_ + new_element_size_bytes > max_cache_size_bytes_) {
-    size_t free_bytes =
-        cachable_sequence_->GetElementSizeBytes(*cache_.front());
+    size_t free_bytes = cache_.front().size_bytes;
     cache_.pop_front();
     cache_size_bytes_ -= free_bytes;
     ++cache_start_index_;
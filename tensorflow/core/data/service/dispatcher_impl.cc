@@ -258,11 +258,14 @@ Status DataServiceDispatcherImpl::Start() {
           *iteration, split_providers_[iteration->iteration_id]));
     }
   }
-  for (const auto& client_id : state_.ListActiveClientIds()) {
-    // Conservatively pretend we just received a heartbeat from all clients, so
-    // that we don't garbage collect iterations too early.
-    latest_client_heartbeats_time_[client_id] =
-        absl::FromUnixMicros(env_->NowMicros());
+  {
+    mutex_lock l(client_heartbeats_mu_);
+    for (const auto& client_id : state_.ListActiveClientIds()) {
+      // Conservatively pretend we just received a heartbeat from all clients,
+      // so that we don't garbage collect iterations too early.
+      latest_client_heartbeats_time_[client_id] =
+          absl::FromUnixMicros(env_->NowMicros());
+    }
   }
   // Initialize the journal writer in `Start` so that we fail fast in case it
   // can't be initialized.
@@ -932,7 +935,11 @@ Status DataServiceDispatcherImpl::AcquireIterationClientId(
   acquire_iteration_client->set_iteration_id(iteration->iteration_id);
   TF_RETURN_IF_ERROR(Apply(update));
   // Does not release clients before they start to read from the dataset.
-  latest_client_heartbeats_time_[iteration_client_id] = absl::InfiniteFuture();
+  {
+    mutex_lock l(client_heartbeats_mu_);
+    latest_client_heartbeats_time_[iteration_client_id] =
+        absl::InfiniteFuture();
+  }
   return absl::OkStatus();
 }
 
@@ -1061,14 +1068,76 @@ Status DataServiceDispatcherImpl::AssignTask(std::shared_ptr<const Task> task)
   return absl::OkStatus();
 }
 
+Status DataServiceDispatcherImpl::PopulateClientHeartbeatResponse(
+    const ClientHeartbeatRequest* request,
+    const std::shared_ptr<const Iteration>& iteration,
+    ClientHeartbeatResponse* response) {
+  if (!iteration->pending_tasks.empty()) {
+    response->set_block_round(iteration->pending_tasks.front().target_round);
+  }
+
+  VLOG(3) << "Received target processing time for iteration "
+          << iteration->iteration_id << " from iteration_client_id "
+          << request->iteration_client_id() << ". Time in nanoseconds: "
+          << request->target_processing_time_nsec();
+  Status auto_scaler_status = auto_scaler_.ReportTargetProcessingTime(
+      iteration->iteration_id, request->iteration_client_id(),
+      absl::Nanoseconds(request->target_processing_time_nsec()));
+  if (!auto_scaler_status.ok()) {
+    VLOG(1) << "Failed to report target processing time for Iteration "
+            << iteration->iteration_id << " and consumer ID "
+            << request->iteration_client_id()
+            << " to tf.data service AutoScaler: " << auto_scaler_status;
+  }
+
+  std::vector<std::shared_ptr<const Task>> tasks;
+  TF_RETURN_IF_ERROR(state_.TasksForIteration(iteration->iteration_id, tasks));
+  for (const auto& task : tasks) {
+    TaskInfo* task_info = response->mutable_task_info()->Add();
+    task_info->set_worker_address(task->worker_address);
+    *task_info->mutable_transfer_servers() = {task->transfer_servers.begin(),
+                                              task->transfer_servers.end()};
+    *task_info->mutable_worker_tags() = {task->worker_tags.begin(),
+                                         task->worker_tags.end()};
+    task_info->set_task_id(task->task_id);
+    task_info->set_iteration_id(iteration->iteration_id);
+    task_info->set_worker_uid(task->worker_uid);
+    task_info->set_starting_round(task->starting_round);
+  }
+  response->set_iteration_finished(iteration->finished);
+  response->set_deployment_mode(config_.deployment_mode());
+  VLOG(4) << "Found " << response->task_info_size()
+          << " tasks for iteration client id "
+          << request->iteration_client_id();
+  return absl::OkStatus();
+}
+
 Status DataServiceDispatcherImpl::ClientHeartbeat(
     const ClientHeartbeatRequest* request, ClientHeartbeatResponse* response) {
   TF_RETURN_IF_ERROR(CheckStarted());
-  mutex_lock l(mu_);
   VLOG(4) << "Received heartbeat from client id "
           << request->iteration_client_id();
-  latest_client_heartbeats_time_[request->iteration_client_id()] =
-      absl::FromUnixMicros(env_->NowMicros());
+  {
+    mutex_lock l(client_heartbeats_mu_);
+    latest_client_heartbeats_time_[request->iteration_client_id()] =
+        absl::FromUnixMicros(env_->NowMicros());
+  }
+  {
+    // Fast path: a heartbeat that carries no round-robin round for an
+    // iteration with no pending tasks only reads dispatcher state, so it can
+    // be served under a shared lock, concurrently with other heartbeats.
+    tf_shared_lock l(mu_);
+    std::shared_ptr<const Iteration> iteration;
+    Status s = state_.IterationForIterationClientId(
+        request->iteration_client_id(), iteration);
+    if (s.ok() && !iteration->garbage_collected &&
+        request->optional_current_round_case() !=
+            ClientHeartbeatRequest::kCurrentRound &&
+        iteration->pending_tasks.empty()) {
+      return PopulateClientHeartbeatResponse(request, iteration, response);
+    }
+  }
+  mutex_lock l(mu_);
   std::shared_ptr<const Iteration> iteration;
   Status s = state_.IterationForIterationClientId(
       request->iteration_client_id(), iteration);
@@ -1129,44 +1198,7 @@ Status DataServiceDispatcherImpl::ClientHeartbeat(
       TF_RETURN_IF_ERROR(Apply(update));
     }
   }
-  if (!iteration->pending_tasks.empty()) {
-    response->set_block_round(iteration->pending_tasks.front().target_round);
-  }
-
-  VLOG(3) << "Received target processing time for iteration "
-          << iteration->iteration_id << " from iteration_client_id "
-          << request->iteration_client_id() << ". Time in nanoseconds: "
-          << request->target_processing_time_nsec();
-  Status auto_scaler_status = auto_scaler_.ReportTargetProcessingTime(
-      iteration->iteration_id, request->iteration_client_id(),
-      absl::Nanoseconds(request->target_processing_time_nsec()));
-  if (!auto_scaler_status.ok()) {
-    VLOG(1) << "Failed to report target processing time for Iteration "
-            << iteration->iteration_id << " and consumer ID "
-            << request->iteration_client_id()
-            << " to tf.data service AutoScaler: " << auto_scaler_status;
-  }
-
-  std::vector<std::shared_ptr<const Task>> tasks;
-  TF_RETURN_IF_ERROR(state_.TasksForIteration(iteration->iteration_id, tasks));
-  for (const auto& task : tasks) {
-    TaskInfo* task_info = response->mutable_task_info()->Add();
-    task_info->set_worker_address(task->worker_address);
-    *task_info->mutable_transfer_servers() = {task->transfer_servers.begin(),
-                                              task->transfer_servers.end()};
-    *task_info->mutable_worker_tags() = {task->worker_tags.begin(),
-                                         task->worker_tags.end()};
-    task_info->set_task_id(task->task_id);
-    task_info->set_iteration_id(iteration->iteration_id);
-    task_info->set_worker_uid(task->worker_uid);
-    task_info->set_starting_round(task->starting_round);
-  }
-  response->set_iteration_finished(iteration->finished);
-  response->set_deployment_mode(config_.deployment_mode());
-  VLOG(4) << "Found " << response->task_info_size()
-          << " tasks for iteration client id "
-          << request->iteration_client_id();
-  return absl::OkStatus();
+  return PopulateClientHeartbeatResponse(request, iteration, response);
 }
 
 Status DataServiceDispatcherImpl::GetWorkers(const GetWorkersRequest* request,
@@ -1179,6 +1211,11 @@ Status DataServiceDispatcherImpl::GetWorkers(const GetWorkersRequest* request,
     WorkerInfo* info = response->add_workers();
     info->set_address(worker->address);
   }
+  std::optional<int64_t> optimal_number_of_workers =
+      auto_scaler_.GetOptimalNumberOfWorkers();
+  if (optimal_number_of_workers.has_value()) {
+    response->set_optimal_number_of_workers(*optimal_number_of_workers);
+  }
   VLOG(3) << "Returning list of " << response->workers_size()
           << " workers from GetWorkers";
   return absl::OkStatus();
@@ -1443,8 +1480,13 @@ Status DataServiceDispatcherImpl::ReleaseMissingClients()
     TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
   int64_t now = env_->NowMicros();
   for (const auto& client_id : state_.ListActiveClientIds()) {
+    absl::Time latest_heartbeat_time;
+    {
+      mutex_lock l(client_heartbeats_mu_);
+      latest_heartbeat_time = latest_client_heartbeats_time_[client_id];
+    }
     if (absl::FromUnixMicros(now) >
-        latest_client_heartbeats_time_[client_id] +
+        latest_heartbeat_time +
             absl::Milliseconds(config_.client_timeout_ms())) {
       LOG(INFO) << "Releasing timed-out client with id " << client_id;
       RemoveClientFromAutoScaler(client_id);
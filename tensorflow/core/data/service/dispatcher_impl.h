@@ -258,6 +258,13 @@ class DataServiceDispatcherImpl {
   void ReportProcessingTimesFromActiveTasks(
       const std::vector<ActiveTask>& active_tasks,
       const std::string& worker_address) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  // Fills in the task list and iteration status for a client heartbeat
+  // response. Only reads dispatcher state, so it may be called with `mu_` held
+  // in either shared or exclusive mode.
+  Status PopulateClientHeartbeatResponse(
+      const ClientHeartbeatRequest* request,
+      const std::shared_ptr<const DispatcherState::Iteration>& iteration,
+      ClientHeartbeatResponse* response) TF_SHARED_LOCKS_REQUIRED(mu_);
   // Acquires an iteration client id to read from the given iteration and sets
   // `iteration_client_id`.
   Status AcquireIterationClientId(
@@ -373,9 +380,14 @@ class DataServiceDispatcherImpl {
   // Map from task id to a TaskRemover which determines when to remove the task.
   absl::flat_hash_map<int64_t, std::shared_ptr<TaskRemover>>
       remove_task_requests_ TF_GUARDED_BY(mu_);
+  // Uses a separate mutex for `latest_client_heartbeats_time_` so that client
+  // heartbeats can record their arrival time without the exclusive `mu_`. This
+  // is a leaf lock: it may be acquired while holding `mu_`, and no other lock
+  // may be acquired while holding it.
+  mutable mutex client_heartbeats_mu_ TF_ACQUIRED_AFTER(mu_);
   // Map from client id to the time of the client's last heartbeat.
   absl::flat_hash_map<int64_t, absl::Time> latest_client_heartbeats_time_
-      TF_GUARDED_BY(mu_);
+      TF_GUARDED_BY(client_heartbeats_mu_);
   // Map from worker address to the time of the worker's last heartbeat.
   absl::flat_hash_map<std::string, absl::Time> latest_worker_heartbeats_time_
       TF_GUARDED_BY(mu_);
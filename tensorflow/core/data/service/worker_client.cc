@@ -144,8 +144,11 @@ class GrpcDataTransferClient : public DataTransferClient {
     switch (resp.element_case()) {
       case GetElementResponse::kCompressed: {
         Tensor tensor(DT_VARIANT, TensorShape{});
-        tensor.scalar<Variant>()() = std::move(resp.compressed());
-        result.components.push_back(tensor);
+        // NOTE: `mutable_compressed()` is needed for the move to actually
+        // steal the compressed data; moving from the `const` accessor would
+        // silently copy it.
+        tensor.scalar<Variant>()() = std::move(*resp.mutable_compressed());
+        result.components.push_back(std::move(tensor));
         break;
       }
       case GetElementResponse::kUncompressed:
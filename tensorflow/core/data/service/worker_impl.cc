@@ -100,7 +100,13 @@ Status MoveElementToResponse(std::vector<Tensor>&& element,
         "it produced ",
         variant.TypeName());
   }
-  *resp.mutable_compressed() = *compressed;
+  if (element[0].RefCountIsOne()) {
+    *resp.mutable_compressed() = std::move(*compressed);
+  } else {
+    // The tensor buffer is shared (e.g. with the cross-trainer cache), so the
+    // compressed data must be copied to keep the shared element intact.
+    *resp.mutable_compressed() = *compressed;
+  }
   return absl::OkStatus();
 }
 
@@ -387,7 +387,7 @@ Status Reader::Create(Env* env, const std::string& filename,
 }
 
 Status Reader::SkipRecords(int64_t num_records) {
-  // TODO(frankchn): Optimize to not parse the entire Tensor and actually skip.
+  // Fallback for readers that do not support skipping at the record level.
   for (int i = 0; i < num_records; ++i) {
     std::vector<Tensor> unused_tensors;
     TF_RETURN_IF_ERROR(ReadTensors(&unused_tensors));
@@ -527,13 +527,8 @@ class Reader::Dataset : public DatasetBase {
                                    current_checkpoint_id_);
     }
 
-    // TODO(frankchn): Optimize this to not parse every single element.
     Status AdvanceToStartIndex(IteratorContext* ctx) {
-      for (int64_t i = 0; i < start_index_; ++i) {
-        std::vector<Tensor> unused;
-        TF_RETURN_IF_ERROR(reader_->ReadTensors(&unused));
-      }
-      return absl::OkStatus();
+      return reader_->SkipRecords(start_index_);
     }
 
     std::unique_ptr<Reader> reader_;
@@ -781,6 +776,18 @@ absl::StatusOr<std::vector<Tensor>> TFRecordReaderImpl::GetTensors() {
   return tensors;
 }
 
+Status TFRecordReaderImpl::Skip(int64_t num_tensors) {
+  while (num_tensors > 0) {
+    const int num_to_skip =
+        static_cast<int>(std::min<int64_t>(num_tensors, INT_MAX));
+    int num_skipped = 0;
+    TF_RETURN_IF_ERROR(
+        record_reader_->SkipRecords(&offset_, num_to_skip, &num_skipped));
+    num_tensors -= num_skipped;
+  }
+  return absl::OkStatus();
+}
+
 absl::StatusOr<Tensor> TFRecordReaderImpl::Parse(const tstring& record) {
   TensorProto proto;
   if (!proto.ParseFromArray(record.data(), record.size())) {
@@ -808,6 +815,12 @@ Status TFRecordReader::ReadTensors(std::vector<Tensor>* read_tensors) {
   return absl::OkStatus();
 }
 
+Status TFRecordReader::SkipRecords(int64_t num_records) {
+  // Each element is stored as one record per component, so skip
+  // `num_records * dtypes_.size()` records without parsing them.
+  return reader_impl_.Skip(num_records * dtypes_.size());
+}
+
 CustomReader::CustomReader(const std::string& filename,
                            const string& compression_type, const int version,
                            const DataTypeVector& dtypes)
@@ -912,6 +925,20 @@ Status CustomReader::ReadTensors(std::vector<Tensor>* read_tensors) {
   return absl::OkStatus();
 }
 
+Status CustomReader::SkipRecords(int64_t num_records) {
+  // Version 1 snappy elements are stored as a metadata record followed by a
+  // compressed data record; all other configurations store one record per
+  // element.
+  const int64_t records_per_element =
+      (version_ == 0 || compression_type_ != io::compression::kSnappy) ? 1 : 2;
+  for (int64_t i = 0; i < num_records; ++i) {
+    for (int64_t j = 0; j < records_per_element; ++j) {
+      TF_RETURN_IF_ERROR(SkipRecord());
+    }
+  }
+  return absl::OkStatus();
+}
+
 Status CustomReader::ReadTensorsV0(std::vector<Tensor>* read_tensors) {
   experimental::SnapshotRecord record;
 #if defined(PLATFORM_GOOGLE)
@@ -990,6 +1017,13 @@ Status CustomReader::ReadRecord(tstring* record) {
   return input_stream_->ReadNBytes(length, record);
 }
 
+Status CustomReader::SkipRecord() {
+  tstring header;
+  TF_RETURN_IF_ERROR(input_stream_->ReadNBytes(kHeaderSize, &header));
+  uint64 length = core::DecodeFixed64(header.data());
+  return input_stream_->SkipNBytes(length);
+}
+
 #if defined(TF_CORD_SUPPORT)
 Status CustomReader::ReadRecord(absl::Cord* record) {
   tstring header;
@@ -267,6 +267,10 @@ class TFRecordReaderImpl {
   // Reads all Tensors in the input file.
   absl::StatusOr<std::vector<Tensor>> GetTensors();
 
+  // Skips the next `num_tensors` Tensors in the input file, without parsing
+  // the skipped records.
+  Status Skip(int64_t num_tensors);
+
   // Returns the number of bytes read.
   uint64_t BytesRead() const { return bytes_read_; }
 
@@ -301,6 +305,11 @@ class TFRecordReader : public Reader {
   // end of file, or an error status if there is an error.
   Status ReadTensors(std::vector<Tensor>* read_tensors) override;
 
+  // Skips `num_records` elements by skipping over the underlying records
+  // without parsing them, making restoring an iterator to a given element
+  // index much cheaper than reading and discarding the skipped elements.
+  Status SkipRecords(int64_t num_records) override;
+
   // Returns the number of bytes read.
   uint64_t BytesRead() const { return reader_impl_.BytesRead(); }
 
@@ -332,6 +341,10 @@ class CustomReader : public Reader {
 
   Status ReadTensors(std::vector<Tensor>* read_tensors) override;
 
+  // Skips `num_records` elements by skipping over the underlying records
+  // without decompressing or parsing them.
+  Status SkipRecords(int64_t num_records) override;
+
   ~CustomReader() override = default;
 
  protected:
@@ -340,6 +353,9 @@ class CustomReader : public Reader {
  private:
   Status ReadTensorsV0(std::vector<Tensor>* read_tensors);
 
+  // Skips over a single length-prefixed record in the input stream.
+  Status SkipRecord();
+
   Status SnappyUncompress(
       const experimental::SnapshotTensorMetadata* metadata,
       std::vector<Tensor>* simple_tensors,
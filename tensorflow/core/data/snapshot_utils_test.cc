@@ -19,6 +19,7 @@ limitations under the License.
 #include <string>
 #include <vector>
 
+#include "absl/status/status.h"
 #include "tensorflow/core/data/service/test_util.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/lib/core/status_test_util.h"
@@ -99,6 +100,65 @@ TEST(SnapshotUtilTest, CombinationRoundTripTest) {
   SnapshotRoundTrip(io::compression::kSnappy, 2);
 }
 
+void SnapshotSkipRoundTrip(std::string compression_type, int version) {
+  // Generate ground-truth tensors for writing and reading.
+  std::vector<Tensor> tensors;
+  tensorflow::DataTypeVector dtypes;
+  GenerateTensorVector(dtypes, tensors);
+
+  std::string filename;
+  EXPECT_TRUE(Env::Default()->LocalTempFilename(&filename));
+
+  std::unique_ptr<Writer> writer;
+  TF_ASSERT_OK(Writer::Create(tensorflow::Env::Default(), filename,
+                              compression_type, version, dtypes, &writer));
+
+  for (int i = 0; i < 100; ++i) {
+    TF_ASSERT_OK(writer->WriteTensors(tensors));
+  }
+  TF_ASSERT_OK(writer->Close());
+
+  std::unique_ptr<Reader> reader;
+  TF_ASSERT_OK(Reader::Create(Env::Default(), filename, compression_type,
+                              version, dtypes, &reader));
+
+  // Skip half of the elements, then verify that the remaining elements are
+  // read back intact.
+  TF_ASSERT_OK(reader->SkipRecords(50));
+  for (int i = 0; i < 50; ++i) {
+    std::vector<Tensor> read_tensors;
+    TF_ASSERT_OK(reader->ReadTensors(&read_tensors));
+    EXPECT_EQ(tensors.size(), read_tensors.size());
+    for (int j = 0; j < read_tensors.size(); ++j) {
+      TensorProto proto;
+      TensorProto read_proto;
+
+      tensors[j].AsProtoTensorContent(&proto);
+      read_tensors[j].AsProtoTensorContent(&read_proto);
+
+      std::string proto_serialized, read_proto_serialized;
+      proto.AppendToString(&proto_serialized);
+      read_proto.AppendToString(&read_proto_serialized);
+      EXPECT_EQ(proto_serialized, read_proto_serialized);
+    }
+  }
+
+  std::vector<Tensor> unused;
+  EXPECT_TRUE(absl::IsOutOfRange(reader->ReadTensors(&unused)));
+
+  TF_ASSERT_OK(Env::Default()->DeleteFile(filename));
+}
+
+TEST(SnapshotUtilTest, CombinationSkipRoundTripTest) {
+  SnapshotSkipRoundTrip(io::compression::kNone, 1);
+  SnapshotSkipRoundTrip(io::compression::kGzip, 1);
+  SnapshotSkipRoundTrip(io::compression::kSnappy, 1);
+
+  SnapshotSkipRoundTrip(io::compression::kNone, 2);
+  SnapshotSkipRoundTrip(io::compression::kGzip, 2);
+  SnapshotSkipRoundTrip(io::compression::kSnappy, 2);
+}
+
 TEST(SnapshotUtilTest, MetadataFileRoundTrip) {
   experimental::DistributedSnapshotMetadata metadata_in;
   metadata_in.set_compression(io::compression::kGzip);
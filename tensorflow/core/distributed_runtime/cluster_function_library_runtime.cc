@@ -28,12 +28,39 @@ limitations under the License.
 #include "tensorflow/core/framework/node_def_builder.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/graph/node_builder.h"
-#include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/protobuf/named_tensor.pb.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Converts the recv tensors in "*resp" back into "*rets", in recv_keys order.
+Status TensorsFromRunGraphResponse(RunGraphResponse* resp,
+                                   const std::vector<string>& recv_keys,
+                                   std::vector<Tensor>* rets) {
+  std::map<string, TensorProto*> mapped_recvs;
+  for (auto& recv : *resp->mutable_recv()) {
+    mapped_recvs[recv.name()] = recv.mutable_tensor();
+  }
+
+  for (const auto& recv_key : recv_keys) {
+    TensorProto* tp = mapped_recvs[recv_key];
+    if (tp == nullptr) {
+      return errors::Internal("Could not find key: ", recv_key);
+    }
+    Tensor t;
+    if (!t.FromProto(*tp)) {
+      return errors::Internal("Could not convert tensor proto: ",
+                              tp->DebugString());
+    }
+    rets->push_back(t);
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace
+
 /* static */
 Status ClusterFunctionLibraryRuntime::ConstructFunctionGraph(
     const OpDef& sig, AttrSlice attrs,
@@ -295,42 +322,159 @@ void ClusterFunctionLibraryRuntime::Run(
   wi->RunGraphAsync(
       call_options, req, resp,
       [call_options, req, resp, rets, recv_keys, done](const Status& status) {
-        Status* local_status = new Status(status);
-        auto cleanup =
-            gtl::MakeCleanup([call_options, req, resp, local_status, done] {
-              done(*local_status);
-              delete call_options;
-              delete req;
-              delete resp;
-              delete local_status;
-            });
-        if (!local_status->ok()) {
-          return;
-        }
-        std::map<string, TensorProto*> mapped_recvs;
-        for (auto& recv : *resp->mutable_recv()) {
-          mapped_recvs[recv.name()] = recv.mutable_tensor();
-        }
-
-        for (const auto& recv_key : recv_keys) {
-          TensorProto* tp = mapped_recvs[recv_key];
-          if (tp == nullptr) {
-            local_status->Update(
-                errors::Internal("Could not find key: ", recv_key));
-            return;
-          }
-          Tensor t;
-          if (t.FromProto(*tp)) {
-            rets->push_back(t);
-          } else {
-            local_status->Update(errors::Internal(
-                "Could not convert tensor proto: ", tp->DebugString()));
-            return;
-          }
+        Status s = status;
+        if (s.ok()) {
+          s = TensorsFromRunGraphResponse(resp, recv_keys, rets);
         }
+        done(s);
+        delete call_options;
+        delete req;
+        delete resp;
       });
 }
 
+void ClusterFunctionLibraryRuntime::InstantiateOnTargets(
+    const string& function_name, const FunctionLibraryDefinition& lib_def,
+    AttrSlice attrs, const FunctionLibraryRuntime::InstantiateOptions& options,
+    const std::vector<string>& targets,
+    std::vector<FunctionLibraryRuntime::LocalHandle>* handles,
+    FunctionLibraryRuntime::DoneCallback done) {
+  const int n = targets.size();
+  handles->clear();
+  handles->resize(n, kInvalidLocalHandle);
+  if (n == 0) {
+    done(absl::OkStatus());
+    return;
+  }
+
+  struct MulticastState {
+    mutex mu;
+    int pending TF_GUARDED_BY(mu);
+    Status status TF_GUARDED_BY(mu);
+  };
+  auto* state = new MulticastState;
+  state->pending = n;
+
+  // The registration graphs still have to be constructed per target since
+  // the target is baked into their rendezvous keys, but the registration
+  // RPCs all proceed concurrently.
+  for (int i = 0; i < n; ++i) {
+    FunctionLibraryRuntime::InstantiateOptions target_options = options;
+    target_options.target = targets[i];
+    Instantiate(function_name, lib_def, attrs, target_options, &(*handles)[i],
+                [state, done](const Status& s) {
+                  bool last;
+                  Status status;
+                  {
+                    mutex_lock l(state->mu);
+                    state->status.Update(s);
+                    last = (--state->pending == 0);
+                    if (last) status = state->status;
+                  }
+                  if (last) {
+                    delete state;
+                    done(status);
+                  }
+                });
+  }
+}
+
+void ClusterFunctionLibraryRuntime::RunOnTargets(
+    const FunctionLibraryRuntime::Options& opts,
+    const std::vector<FunctionLibraryRuntime::LocalHandle>& handles,
+    absl::Span<const Tensor> args, std::vector<std::vector<Tensor>>* rets,
+    std::function<void(int, const Status&)> target_done,
+    FunctionLibraryRuntime::DoneCallback done) {
+  const int n = handles.size();
+  rets->clear();
+  rets->resize(n);
+  if (n == 0) {
+    done(absl::OkStatus());
+    return;
+  }
+
+  // Serialize the arguments once; each per-target request copies the
+  // resulting protos instead of re-encoding the tensors for every RPC.
+  std::vector<TensorProto> arg_protos(args.size());
+  for (size_t i = 0; i < args.size(); ++i) {
+    args[i].AsProtoTensorContent(&arg_protos[i]);
+  }
+
+  struct FanOutState {
+    mutex mu;
+    int pending TF_GUARDED_BY(mu);
+    Status status TF_GUARDED_BY(mu);
+  };
+  auto* state = new FanOutState;
+  state->pending = n;
+  auto finish_target = [state, done](const Status& s) {
+    bool last;
+    Status status;
+    {
+      mutex_lock l(state->mu);
+      state->status.Update(s);
+      last = (--state->pending == 0);
+      if (last) status = state->status;
+    }
+    if (last) {
+      delete state;
+      done(status);
+    }
+  };
+
+  for (int i = 0; i < n; ++i) {
+    FunctionData* function_data = nullptr;
+    {
+      mutex_lock l(mu_);
+      CHECK_LE(handles[i], function_data_.size());
+      function_data = &function_data_[handles[i]];
+    }
+
+    WorkerInterface* wi = function_data->wi;
+    if (wi == nullptr) {
+      Status s = errors::Internal("Could not find worker");
+      if (target_done) target_done(i, s);
+      finish_target(s);
+      continue;
+    }
+
+    RunGraphRequest* req = new RunGraphRequest;
+    req->set_session_handle(worker_session_->session_name());
+    req->set_create_worker_session_called(create_worker_session_called_);
+    req->set_graph_handle(function_data->graph_handle);
+    req->set_step_id(opts.step_id);
+    int j = 0;
+    for (const auto& send_key : function_data->send_keys) {
+      NamedTensorProto* send = req->add_send();
+      send->set_name(send_key);
+      *send->mutable_tensor() = arg_protos[j];
+      j++;
+    }
+    const std::vector<string>& recv_keys = function_data->recv_keys;
+    for (const auto& recv_key : recv_keys) {
+      req->add_recv_key(recv_key);
+    }
+
+    RunGraphResponse* resp = new RunGraphResponse();
+    CallOptions* call_options = new CallOptions();
+    std::vector<Tensor>* target_rets = &(*rets)[i];
+    wi->RunGraphAsync(call_options, req, resp,
+                      [call_options, req, resp, target_rets, recv_keys,
+                       target_done, finish_target, i](const Status& status) {
+                        Status s = status;
+                        if (s.ok()) {
+                          s = TensorsFromRunGraphResponse(resp, recv_keys,
+                                                          target_rets);
+                        }
+                        delete call_options;
+                        delete req;
+                        delete resp;
+                        if (target_done) target_done(i, s);
+                        finish_target(s);
+                      });
+  }
+}
+
 void ClusterFunctionLibraryRuntime::Run(
     const FunctionLibraryRuntime::Options& opts,
     FunctionLibraryRuntime::LocalHandle handle,
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_CLUSTER_FUNCTION_LIBRARY_RUNTIME_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_CLUSTER_FUNCTION_LIBRARY_RUNTIME_H_
 
+#include <functional>
 #include <memory>
 #include <utility>
 #include <vector>
@@ -57,6 +58,33 @@ class ClusterFunctionLibraryRuntime : public DistributedFunctionLibraryRuntime {
            absl::Span<const FunctionArg> args, std::vector<FunctionRet>* rets,
            FunctionLibraryRuntime::DoneCallback done) override;
 
+  // Instantiates `function_name` on every worker in `targets` with a single
+  // call.  The registration RPCs are issued concurrently rather than one at a
+  // time.  `handles` is resized to `targets.size()`; `(*handles)[i]` holds
+  // the handle for `targets[i]` once `done` is invoked with an OK status.
+  // `options.target` is ignored in favor of the entries in `targets`.
+  void InstantiateOnTargets(
+      const string& function_name, const FunctionLibraryDefinition& lib_def,
+      AttrSlice attrs, const FunctionLibraryRuntime::InstantiateOptions& options,
+      const std::vector<string>& targets,
+      std::vector<FunctionLibraryRuntime::LocalHandle>* handles,
+      FunctionLibraryRuntime::DoneCallback done);
+
+  // Runs the functions behind `handles` (typically obtained from
+  // InstantiateOnTargets()) with the same arguments on all of their targets
+  // at once.  The argument tensors are serialized once and the resulting
+  // protos are shared across the per-target requests instead of being
+  // re-encoded for each RPC.  `(*rets)[i]` receives the outputs of
+  // `handles[i]`.  If `target_done` is set it is invoked with the index and
+  // status of each target as its results arrive; `done` is invoked once with
+  // the first error (or OK) after all targets have finished.
+  void RunOnTargets(const FunctionLibraryRuntime::Options& opts,
+                    const std::vector<FunctionLibraryRuntime::LocalHandle>& handles,
+                    absl::Span<const Tensor> args,
+                    std::vector<std::vector<Tensor>>* rets,
+                    std::function<void(int, const Status&)> target_done,
+                    FunctionLibraryRuntime::DoneCallback done);
+
   void CleanUp(uint64 step_id, FunctionLibraryRuntime::LocalHandle handle,
                FunctionLibraryRuntime::DoneCallback done) override;
 
@@ -405,6 +405,49 @@ TEST_F(ClusterFunctionLibraryRuntimeTest, DISABLED_InstantiateAndRun) {
   test::ExpectTensorEqual<int32>(y, test::AsTensor<int32>({2, 4, 6, 8}));
 }
 
+TEST_F(ClusterFunctionLibraryRuntimeTest, DISABLED_MulticastInstantiateAndRun) {
+  FunctionDefLibrary proto;
+  *(proto.add_function()) = test::function::XTimesTwoInt32();
+  FunctionLibraryDefinition lib_def(OpRegistry::Global(), proto);
+  FunctionLibraryRuntime::InstantiateOptions instantiate_opts;
+  std::vector<string> targets = {"/job:localhost/replica:0/task:0/cpu:0",
+                                 "/job:localhost/replica:0/task:1/cpu:0"};
+
+  std::vector<FunctionLibraryRuntime::LocalHandle> handles;
+  Status status;
+  Notification instantiate_done;
+  cluster_flr_->InstantiateOnTargets(
+      "XTimesTwoInt32", lib_def, {}, instantiate_opts, targets, &handles,
+      [&status, &instantiate_done](const Status& s) {
+        status = s;
+        instantiate_done.Notify();
+      });
+  instantiate_done.WaitForNotification();
+  TF_ASSERT_OK(status);
+  ASSERT_EQ(handles.size(), targets.size());
+
+  FunctionLibraryRuntime::Options opts;
+  auto x = test::AsTensor<int32>({1, 2, 3, 4});
+  std::vector<std::vector<Tensor>> rets;
+  std::vector<Status> target_statuses(targets.size());
+  Notification run_done;
+  cluster_flr_->RunOnTargets(
+      opts, handles, {x}, &rets,
+      [&target_statuses](int i, const Status& s) { target_statuses[i] = s; },
+      [&status, &run_done](const Status& s) {
+        status = s;
+        run_done.Notify();
+      });
+  run_done.WaitForNotification();
+  TF_ASSERT_OK(status);
+  for (size_t i = 0; i < targets.size(); ++i) {
+    TF_EXPECT_OK(target_statuses[i]);
+    ASSERT_EQ(rets[i].size(), 1);
+    test::ExpectTensorEqual<int32>(rets[i][0],
+                                   test::AsTensor<int32>({2, 4, 6, 8}));
+  }
+}
+
 TEST_F(ClusterFunctionLibraryRuntimeTest,
        DISABLED_InstantiateAndRunAttrSubstitution) {
   FunctionDefLibrary proto;
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/graph_mgr.h"
 
 #include <chrono>  // NOLINT(build/c++11)
+#include <unordered_set>
 #include <vector>
 
 #include "absl/status/status.h"
@@ -333,6 +334,40 @@ Status GraphMgr::Register(const string& handle, const GraphDef& gdef,
   return absl::OkStatus();
 }
 
+Status GraphMgr::ResolveFunctionLibraryDelta(
+    const protobuf::Map<string, uint64>& function_fingerprints,
+    GraphDef* gdef) {
+  FunctionDefLibrary* library = gdef->mutable_library();
+  std::unordered_set<string> arrived;
+  mutex_lock l(function_cache_mu_);
+  // Cache the definitions that were shipped with this request under their
+  // master-supplied fingerprints.
+  for (const FunctionDef& fdef : library->function()) {
+    const string& name = fdef.signature().name();
+    auto it = function_fingerprints.find(name);
+    if (it != function_fingerprints.end()) {
+      cached_functions_.emplace(it->second, fdef);
+      arrived.insert(name);
+    }
+  }
+  // Restore the definitions the master omitted because an earlier
+  // registration already shipped them.
+  for (const auto& name_and_fingerprint : function_fingerprints) {
+    if (arrived.count(name_and_fingerprint.first) > 0) continue;
+    auto it = cached_functions_.find(name_and_fingerprint.second);
+    if (it == cached_functions_.end()) {
+      return errors::InvalidArgument(
+          "Function ", name_and_fingerprint.first, " with fingerprint ",
+          name_and_fingerprint.second,
+          " was omitted from the registration request but is not cached by "
+          "this session. The master and worker function caches are out of "
+          "sync; possibly, this worker just restarted.");
+    }
+    *library->add_function() = it->second;
+  }
+  return absl::OkStatus();
+}
+
 Status GraphMgr::Deregister(const string& handle) {
   Item* item = nullptr;
   // Removes one item from table_.
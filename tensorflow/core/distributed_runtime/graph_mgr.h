@@ -107,6 +107,14 @@ class GraphMgr {
   void RecvOutputsAsync(const int64_t step_id, NamedTensors* out,
                         StatusCallback done);
 
+  // Restores function definitions that the master omitted from "*gdef"
+  // because an earlier registration in this session already shipped them,
+  // and caches the definitions that did arrive under their master-supplied
+  // fingerprints. See RegisterGraphRequest.function_fingerprints.
+  Status ResolveFunctionLibraryDelta(
+      const protobuf::Map<string, uint64>& function_fingerprints,
+      GraphDef* gdef);
+
   // Deregisters a graph.
   Status Deregister(const string& handle);
 
@@ -174,6 +182,12 @@ class GraphMgr {
   // mechanism to gc these graphs.
   std::unordered_map<string, Item*> table_;
 
+  // Function definitions shipped by earlier registrations in this session,
+  // content-addressed by their master-supplied fingerprints.
+  mutex function_cache_mu_;
+  std::unordered_map<uint64, FunctionDef> cached_functions_
+      TF_GUARDED_BY(function_cache_mu_);
+
   void StartParallelExecutors(
       const string& handle, int64_t step_id, Item* item, Rendezvous* rendezvous,
       CollectiveExecutor::Handle* ce_handle, StepStatsCollector* collector,
@@ -57,17 +57,84 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/blocking_counter.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/protobuf/config.pb.h"
 #include "tensorflow/core/public/session_options.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/tracing.h"
 #include "tsl/protobuf/coordination_config.pb.h"
 
 namespace tensorflow {
 
+namespace {
+
+// Content-addressed function shipping is gated behind an env var because it
+// changes the RegisterGraph wire contract: workers that predate the
+// function_fingerprints request field would receive graphs with missing
+// function definitions.
+bool DeltaGraphShippingEnabled() {
+  static bool enabled = []() {
+    bool result;
+    TF_CHECK_OK(
+        ReadBoolFromEnvVar("TF_MASTER_DELTA_GRAPH_SHIPPING", false, &result));
+    return result;
+  }();
+  return enabled;
+}
+
+}  // namespace
+
+// Tracks which function definitions have already been shipped to each worker
+// in this session. Definitions are content-addressed by a fingerprint of
+// their serialized form, so re-registering after a minor graph change ships
+// only the functions a worker has not seen yet; the worker restores the rest
+// from its per-session cache (see GraphMgr::ResolveFunctionLibraryDelta).
+class ShippedFunctionTracker {
+ public:
+  // Fingerprints every function in gdef's library into *fingerprints (keyed
+  // by function name) and removes from the library the definitions already
+  // shipped to `worker`. Returns the fingerprints of the definitions left in
+  // the library; pass them to MarkShipped() once registration on `worker`
+  // succeeds.
+  std::vector<uint64> PrepareDelta(
+      const string& worker, GraphDef* gdef,
+      protobuf::Map<string, uint64>* fingerprints) {
+    FunctionDefLibrary* library = gdef->mutable_library();
+    if (library->function().empty()) return {};
+    std::vector<uint64> new_fingerprints;
+    FunctionDefLibrary pruned;
+    *pruned.mutable_gradient() = library->gradient();
+    mutex_lock l(mu_);
+    std::unordered_set<uint64>& shipped = shipped_[worker];
+    for (FunctionDef& fdef : *library->mutable_function()) {
+      const uint64 fp = Fingerprint64(fdef.SerializeAsString());
+      (*fingerprints)[fdef.signature().name()] = fp;
+      if (shipped.count(fp) == 0) {
+        new_fingerprints.push_back(fp);
+        *pruned.add_function() = std::move(fdef);
+      }
+    }
+    *library = std::move(pruned);
+    return new_fingerprints;
+  }
+
+  // Records that `worker` now caches the given function fingerprints.
+  void MarkShipped(const string& worker,
+                   const std::vector<uint64>& fingerprints) {
+    mutex_lock l(mu_);
+    shipped_[worker].insert(fingerprints.begin(), fingerprints.end());
+  }
+
+ private:
+  mutex mu_;
+  std::unordered_map<string, std::unordered_set<uint64>> shipped_
+      TF_GUARDED_BY(mu_);
+};
+
 // MasterSession wraps ClientGraph in a reference counted object.
 // This way, MasterSession can clear up the cache mapping Run requests to
 // compiled graphs while the compiled graph is still being used.
@@ -80,7 +147,8 @@ class MasterSession::ReffedClientGraph : public core::RefCounted {
                     const SessionOptions& session_opts,
                     const StatsPublisherFactory& stats_publisher_factory,
                     bool is_partial, WorkerCacheInterface* worker_cache,
-                    bool should_deregister)
+                    bool should_deregister,
+                    ShippedFunctionTracker* shipped_functions)
       : session_handle_(handle),
         bg_opts_(bopts),
         client_graph_before_register_(std::move(client_graph)),
@@ -88,6 +156,7 @@ class MasterSession::ReffedClientGraph : public core::RefCounted {
         is_partial_(is_partial),
         callable_opts_(bopts.callable_options),
         worker_cache_(worker_cache),
+        shipped_functions_(shipped_functions),
         should_deregister_(should_deregister),
         collective_graph_key_(
             client_graph_before_register_->collective_graph_key) {
@@ -242,6 +311,8 @@ class MasterSession::ReffedClientGraph : public core::RefCounted {
   const bool is_partial_;
   const CallableOptions callable_opts_;
   WorkerCacheInterface* const worker_cache_;  // Not owned.
+  // Null unless delta graph shipping is enabled. Not owned.
+  ShippedFunctionTracker* const shipped_functions_;
 
   struct NodeDetails {
     explicit NodeDetails(string type_string, string detail_text)
@@ -472,6 +543,9 @@ Status MasterSession::ReffedClientGraph::DoRegisterPartitions(
     RegisterGraphRequest req;
     RegisterGraphResponse resp;
     Status status;
+    // Fingerprints of function definitions shipped for the first time in
+    // this call; recorded in shipped_functions_ once the call succeeds.
+    std::vector<uint64> new_fingerprints;
   };
   const int num = partitions_.size();
   gtl::InlinedVector<Call, 4> calls(num);
@@ -484,6 +558,11 @@ Status MasterSession::ReffedClientGraph::DoRegisterPartitions(
     c->req.mutable_graph_def()->Swap(&graph_partitions[part.name]);
     StripDefaultAttributes(*OpRegistry::Global(),
                            c->req.mutable_graph_def()->mutable_node());
+    if (shipped_functions_ != nullptr) {
+      c->new_fingerprints = shipped_functions_->PrepareDelta(
+          part.name, c->req.mutable_graph_def(),
+          c->req.mutable_function_fingerprints());
+    }
     *c->req.mutable_config_proto() = session_opts_.config;
     *c->req.mutable_graph_options() = session_opts_.config.graph_options();
     *c->req.mutable_debug_options() =
@@ -501,6 +580,11 @@ Status MasterSession::ReffedClientGraph::DoRegisterPartitions(
     Call* c = &calls[i];
     s.Update(c->status);
     partitions_[i].graph_handle = c->resp.graph_handle();
+    if (c->status.ok() && shipped_functions_ != nullptr &&
+        !c->new_fingerprints.empty()) {
+      shipped_functions_->MarkShipped(partitions_[i].name,
+                                      c->new_fingerprints);
+    }
   }
   return s;
 }
@@ -1243,6 +1327,8 @@ MasterSession::MasterSession(
       devices_(std::move(device_set)),
       filtered_worker_list_(std::move(filtered_worker_list)),
       stats_publisher_factory_(std::move(stats_publisher_factory)),
+      shipped_functions_(DeltaGraphShippingEnabled() ? new ShippedFunctionTracker
+                                                     : nullptr),
       graph_version_(0),
       run_graphs_(5),
       partial_run_graphs_(5) {
@@ -1563,7 +1649,7 @@ Status MasterSession::StartStep(const BuildGraphOptions& opts, bool is_partial,
       auto entry = new ReffedClientGraph(
           handle_, opts, std::move(client_graph), session_opts_,
           stats_publisher_factory_, is_partial, worker_cache,
-          !should_delete_worker_sessions_);
+          !should_delete_worker_sessions_, shipped_functions_.get());
       iter = m->insert({hash, entry}).first;
       VLOG(1) << "Preparing to execute new graph";
     }
@@ -2029,10 +2115,10 @@ Status MasterSession::MakeCallable(const MakeCallableRequest& req,
     }
     std::unique_ptr<ClientGraph> client_graph;
     TF_RETURN_IF_ERROR(execution_state_->BuildGraph(opts, &client_graph));
-    callable = new ReffedClientGraph(handle_, opts, std::move(client_graph),
-                                     session_opts_, stats_publisher_factory_,
-                                     false /* is_partial */, get_worker_cache(),
-                                     !should_delete_worker_sessions_);
+    callable = new ReffedClientGraph(
+        handle_, opts, std::move(client_graph), session_opts_,
+        stats_publisher_factory_, false /* is_partial */, get_worker_cache(),
+        !should_delete_worker_sessions_, shipped_functions_.get());
   }
 
   Status s = BuildAndRegisterPartitions(callable);
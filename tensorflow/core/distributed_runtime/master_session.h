@@ -36,6 +36,7 @@ namespace tensorflow {
 
 class Device;
 struct MasterEnv;
+class ShippedFunctionTracker;
 
 // A session encapsulates a graph computation (resource allocation,
 // placement, execution, etc.).
@@ -135,6 +136,11 @@ class MasterSession : public core::RefCounted {
 
   StatsPublisherFactory stats_publisher_factory_;
 
+  // Tracks which function definitions have been shipped to each worker so
+  // that re-registrations send only the missing ones. Null unless delta
+  // graph shipping is enabled. See master_session.cc for details.
+  const std::unique_ptr<ShippedFunctionTracker> shipped_functions_;
+
   std::atomic_ulong last_access_time_usec_;
 
   std::atomic<int64_t> partial_run_handle_counter_ = {0};
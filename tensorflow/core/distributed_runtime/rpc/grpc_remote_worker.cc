@@ -58,6 +58,7 @@ class GrpcRemoteWorker : public WorkerInterface {
         cleanupgraph_(Method(GrpcWorkerMethod::kCleanupGraph)),
         cleanupall_(Method(GrpcWorkerMethod::kCleanupAll)),
         recvtensor_(Method(GrpcWorkerMethod::kRecvTensor)),
+        recvtensors_(Method(GrpcWorkerMethod::kRecvTensors)),
         recvbuf_(Method(GrpcWorkerMethod::kRecvBuf)),
         logging_(Method(GrpcWorkerMethod::kLogging)),
         tracing_(Method(GrpcWorkerMethod::kTracing)),
@@ -257,6 +258,19 @@ class GrpcRemoteWorker : public WorkerInterface {
     IssueRequest(request, response, recvtensor_, callback, call_opts);
   }
 
+  void RecvTensorsAsync(CallOptions* call_opts,
+                        const RecvTensorsRequest* request,
+                        std::vector<TensorResponse>* responses,
+                        StatusCallback done) override {
+    VLOG(1) << "RecvTensorsAsync req: " << request->DebugString();
+    // Unlike the fan-out default, issue a single multiplexed RPC and
+    // demultiplex the response with the optimized parse function.
+    new RPCState<std::vector<TensorResponse>>(
+        &stub_, cq_, recvtensors_, *request, responses, std::move(done),
+        call_opts, callback_threadpool_, MaxRetries(),
+        /*fail_fast=*/true, &target_, GrpcMaybeParseTensorsResponse);
+  }
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override {
     IssueRequest(request, response, logging_, done);
@@ -325,6 +339,7 @@ class GrpcRemoteWorker : public WorkerInterface {
   const ::grpc::string cleanupgraph_;
   const ::grpc::string cleanupall_;
   const ::grpc::string recvtensor_;
+  const ::grpc::string recvtensors_;
   const ::grpc::string recvbuf_;
   const ::grpc::string logging_;
   const ::grpc::string tracing_;
@@ -15,6 +15,9 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_tensor_coding.h"
 
+#include <utility>
+#include <vector>
+
 #include "grpcpp/support/byte_buffer.h"
 #include "grpcpp/support/slice.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
@@ -250,5 +253,37 @@ void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
   }
 }
 
+void EncodeTensorsToByteBuffer(const std::vector<bool>& is_dead,
+                               const std::vector<Tensor>& val, bool require_ack,
+                               ::grpc::ByteBuffer* result) {
+  CHECK_EQ(is_dead.size(), val.size());
+  // Encode each tensor individually, then frame each encoding as one
+  // element of the RecvTensorsResponse.tensor repeated field by prefixing
+  // it with the field tag and submessage length.  The framed slices are
+  // assembled into a single ByteBuffer without copying the per-tensor
+  // encodings, so tensor data shared by EncodeTensorToByteBuffer stays
+  // shared in "*result".
+  std::vector<::grpc::Slice> slices;
+  for (size_t i = 0; i < val.size(); i++) {
+    ::grpc::ByteBuffer tensor_buf;
+    EncodeTensorToByteBuffer(is_dead[i], val[i], require_ack, &tensor_buf);
+
+    static const int kMaxVarintBytes = 10;
+    gtl::InlinedVector<char, 2 * kMaxVarintBytes> header(2 * kMaxVarintBytes);
+    io::ProtoEncodeHelper e(header.data(), header.size());
+    e.WriteVarlengthBeginning(RecvTensorsResponse::kTensorFieldNumber,
+                              tensor_buf.Length());
+    slices.emplace_back(e.data(), e.size());
+
+    std::vector<::grpc::Slice> tensor_slices;
+    CHECK(tensor_buf.Dump(&tensor_slices).ok());
+    for (auto& slice : tensor_slices) {
+      slices.push_back(std::move(slice));
+    }
+  }
+  ::grpc::ByteBuffer tmp(slices.data(), slices.size());
+  result->Swap(&tmp);
+}
+
 }  // namespace grpc
 }  // namespace tensorflow
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_TENSOR_CODING_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_TENSOR_CODING_H_
 
+#include <vector>
+
 #include "grpcpp/impl/codegen/byte_buffer.h"
 
 namespace tensorflow {
@@ -49,6 +51,19 @@ void EncodeRecvTensorResponseToByteBuffer(const RecvTensorResponse& proto,
 void EncodeTensorToByteBuffer(bool is_dead, const Tensor& val, bool require_ack,
                               ::grpc::ByteBuffer* result);
 
+// Encode the pairs {is_dead[i], val[i]} into a byte buffer that is
+// parseable as a RecvTensorsResponse protocol buffer whose i-th tensor()
+// submessage holds val[i].  Each tensor is encoded as it would be by
+// EncodeTensorToByteBuffer, so large tensor contents are shared with
+// "*result" rather than copied.
+//
+// REQUIRES: is_dead.size() == val.size()
+//
+// Discards original contents of *result.
+void EncodeTensorsToByteBuffer(const std::vector<bool>& is_dead,
+                               const std::vector<Tensor>& val, bool require_ack,
+                               ::grpc::ByteBuffer* result);
+
 }  // namespace grpc
 }  // namespace tensorflow
 
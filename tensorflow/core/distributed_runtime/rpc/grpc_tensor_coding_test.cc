@@ -17,6 +17,9 @@ limitations under the License.
 
 #include "grpcpp/support/byte_buffer.h"
 #include "grpcpp/support/slice.h"
+#include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
+#include "tensorflow/core/framework/device_attributes.pb.h"
+#include "tensorflow/core/framework/device_base.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
@@ -100,4 +103,103 @@ TEST_F(GrpcTensorCodingTest, Simple) {
 
 TEST_F(GrpcTensorCodingTest, StringTensor) { DoTestForStrings(DT_STRING); }
 
+namespace {
+class DummyDevice : public DeviceBase {
+ public:
+  explicit DummyDevice(Env* env) : DeviceBase(env) {
+    attr_.set_device_type("CPU");
+  }
+
+  const DeviceAttributes& attributes() const override { return attr_; }
+
+  Allocator* GetAllocator(AllocatorAttributes attr) override {
+    return cpu_allocator();
+  }
+
+ private:
+  DeviceAttributes attr_;
+};
+}  // namespace
+
+// A tensor large enough for EncodeTensorToByteBuffer to share its backing
+// store with the ByteBuffer should parse back into a tensor that aliases
+// that same backing store, with no copy of the contents on either side.
+TEST_F(GrpcTensorCodingTest, ZeroCopyParse) {
+  Tensor a(DT_FLOAT, TensorShape({1024}));
+  std::vector<float> v(1024);
+  for (int i = 0; i < 1024; i++) v[i] = i;
+  test::FillValues<float>(&a, v);
+
+  ::grpc::ByteBuffer buf;
+  grpc::EncodeTensorToByteBuffer(/*is_dead=*/false, a, /*require_ack=*/false,
+                                 &buf);
+
+  TensorResponse response;
+  DummyDevice cpu_device(Env::Default());
+  response.InitAlloc(&cpu_device, AllocatorAttributes());
+  ASSERT_TRUE(GrpcMaybeParseTensorResponse(&buf, &response));
+
+  const Tensor& result = response.tensor();
+  EXPECT_EQ(a.DebugString(), result.DebugString());
+  // The parsed tensor aliases the sender's buffer, which the encoded
+  // ByteBuffer shares rather than copies.
+  EXPECT_EQ(a.tensor_data().data(), result.tensor_data().data());
+}
+
+// A multiplexed encoding should parse back into the same tensors, both via
+// the generated RecvTensorsResponse proto and via the optimized
+// demultiplexing parser.  Large tensors keep their zero-copy property
+// through the multiplexed path.
+TEST_F(GrpcTensorCodingTest, Batched) {
+  Tensor small(DT_INT32, TensorShape({3}));
+  test::FillValues<int32>(&small, {1, 2, 3});
+  Tensor large(DT_FLOAT, TensorShape({1024}));
+  std::vector<float> v(1024);
+  for (int i = 0; i < 1024; i++) v[i] = i;
+  test::FillValues<float>(&large, v);
+  Tensor empty(DT_FLOAT, TensorShape({0}));
+
+  std::vector<Tensor> tensors = {small, large, empty};
+  std::vector<bool> is_dead = {false, false, true};
+
+  ::grpc::ByteBuffer buf;
+  grpc::EncodeTensorsToByteBuffer(is_dead, tensors, /*require_ack=*/false,
+                                  &buf);
+
+  // Check against the generated proto parser.
+  {
+    std::vector<::grpc::Slice> slices;
+    (void)buf.Dump(&slices);
+    string tmp;
+    for (const auto& s : slices) {
+      tmp.append(reinterpret_cast<const char*>(s.begin()), s.size());
+    }
+    RecvTensorsResponse proto;
+    ASSERT_TRUE(proto.ParseFromString(tmp));
+    ASSERT_EQ(proto.tensor_size(), 3);
+    for (int i = 0; i < 3; i++) {
+      EXPECT_EQ(proto.tensor(i).is_dead(), is_dead[i]);
+      Tensor result;
+      EXPECT_TRUE(result.FromProto(proto.tensor(i).tensor()));
+      EXPECT_EQ(tensors[i].DebugString(), result.DebugString());
+    }
+  }
+
+  // Check the optimized demultiplexing parser.
+  DummyDevice cpu_device(Env::Default());
+  std::vector<TensorResponse> responses(3);
+  for (auto& response : responses) {
+    response.InitAlloc(&cpu_device, AllocatorAttributes());
+  }
+  ASSERT_TRUE(GrpcMaybeParseTensorsResponse(&buf, &responses));
+  for (int i = 0; i < 3; i++) {
+    EXPECT_EQ(responses[i].metadata().is_dead(), is_dead[i]);
+    EXPECT_EQ(tensors[i].DebugString(), responses[i].tensor().DebugString());
+  }
+  // The large tensor aliases the sender's buffer, which the encoded
+  // ByteBuffer shares rather than copies.
+  EXPECT_EQ(large.tensor_data().data(),
+            responses[1].tensor().tensor_data().data());
+}
+
 }  // namespace tensorflow
@@ -15,10 +15,61 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_util.h"
 
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/tensor.h"
 
 namespace tensorflow {
 
+namespace {
+
+// TensorBuffer backed by a ::grpc::Slice.  The slice is refcounted, so the
+// memory outlives both this Source and the ByteBuffer the slice came from.
+class GrpcSliceTensorBuffer : public TensorBuffer {
+ public:
+  GrpcSliceTensorBuffer(::grpc::Slice slice, size_t offset, size_t length)
+      : TensorBuffer(const_cast<uint8_t*>(slice.begin()) + offset),
+        slice_(std::move(slice)),
+        length_(length) {}
+
+  size_t size() const override { return length_; }
+
+  TensorBuffer* root_buffer() override { return this; }
+
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(length_);
+    proto->set_allocator_name("grpc_slice");
+  }
+
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  ::grpc::Slice slice_;
+  size_t length_;
+};
+
+}  // namespace
+
+TensorBuffer* GrpcByteSource::AliasTensorContent(size_t offset,
+                                                 size_t length) {
+  std::vector<::grpc::Slice> slices;
+  if (!buffer_->Dump(&slices).ok()) return nullptr;
+  size_t slice_begin = 0;
+  for (auto& slice : slices) {
+    const size_t slice_end = slice_begin + slice.size();
+    if (offset >= slice_begin && offset + length <= slice_end) {
+      return new GrpcSliceTensorBuffer(std::move(slice), offset - slice_begin,
+                                       length);
+    }
+    slice_begin = slice_end;
+  }
+  // The requested bytes span multiple slices; the caller will copy instead.
+  return nullptr;
+}
+
 bool GrpcMaybeParseTensorResponse(::grpc::ByteBuffer* src,
                                   TensorResponse* dst) {
   ::tensorflow::GrpcByteSource byte_source(src);
@@ -26,4 +77,15 @@ bool GrpcMaybeParseTensorResponse(::grpc::ByteBuffer* src,
   return s.ok();
 }
 
+bool GrpcMaybeParseTensorsResponse(::grpc::ByteBuffer* src,
+                                   std::vector<TensorResponse>* dst) {
+  ::tensorflow::GrpcByteSource byte_source(src);
+  std::vector<TensorResponse*> responses;
+  responses.reserve(dst->size());
+  for (auto& response : *dst) {
+    responses.push_back(&response);
+  }
+  return ParseTensorsFrom(&byte_source, responses).ok();
+}
+
 }  // namespace tensorflow
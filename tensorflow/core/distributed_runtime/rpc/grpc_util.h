@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <memory>
 #include <string>
+#include <vector>
 
 #include "grpcpp/grpcpp.h"
 #include "grpcpp/impl/codegen/proto_utils.h"
@@ -50,6 +51,12 @@ class GrpcByteSource : public TensorResponse::Source {
     return stream_;
   }
 
+  // Returns a TensorBuffer aliasing the requested byte range if it lies
+  // within a single slice of the underlying ByteBuffer; the buffer holds a
+  // reference on the slice so the memory stays valid after the ByteBuffer
+  // is destroyed.
+  TensorBuffer* AliasTensorContent(size_t offset, size_t length) override;
+
  private:
   void DeleteStream() {
     if (stream_) {
@@ -67,6 +74,12 @@ inline string GrpcIdKey() { return "tf-rpc"; }
 // Decode a TensorResponse without extra copying. This function is an optimized
 // variant of tsl::GrpcMaybeParseProto.
 bool GrpcMaybeParseTensorResponse(::grpc::ByteBuffer* src, TensorResponse* dst);
+
+// Decode the multiplexed RecvTensorsResponse in "src" into the entries of
+// "dst", which must already be initialized with InitAlloc and match the
+// number of tensors in the payload.
+bool GrpcMaybeParseTensorsResponse(::grpc::ByteBuffer* src,
+                                   std::vector<TensorResponse>* dst);
 }  // namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_GRPC_UTIL_H_
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/grpc_worker_service.h"
 
+#include <chrono>
 #include <deque>
 #include <memory>
 #include <unordered_map>
@@ -55,6 +56,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/scoped_memory_debug_annotation.h"
 #include "tensorflow/core/protobuf/transport_options.pb.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tsl/platform/tracing.h"
 #include "tsl/protobuf/rpc_options.pb.h"
 
@@ -95,6 +97,23 @@ namespace {
     ENQUEUE_REQUEST(method, supports_cancel);                                  \
   }
 
+// Busy-poll window for the worker's completion-queue threads. After servicing
+// an event, each thread polls its queue without blocking until this many
+// microseconds pass with no new event, and only then parks in a blocking
+// Next(). Parking costs tens of microseconds of wakeup latency per RPC, which
+// is significant for small RPCs at fine step granularity; the spin window
+// bounds the extra CPU to idle tails between bursts. 0 (the default) always
+// blocks.
+int64_t CompletionQueueSpinUs() {
+  static int64_t spin_us = []() {
+    int64_t result;
+    TF_CHECK_OK(
+        tsl::ReadInt64FromEnvVar("TF_GRPC_WORKER_CQ_SPIN_US", 0, &result));
+    return result;
+  }();
+  return spin_us;
+}
+
 // GrpcWorkerService spawns one or more GrpcWorkerServiceThreads to service
 // requests.  Each thread operates on an independent completion queue.
 class GrpcWorkerServiceThread {
@@ -158,15 +177,45 @@ class GrpcWorkerServiceThread {
          ++i) {
       EnqueueRecvTensorRequestRaw();
     }
+    for (int i = 0;
+         i < gtl::FindWithDefault(
+                 queue_depth_, static_cast<int>(GrpcWorkerMethod::kRecvTensors),
+                 100);
+         ++i) {
+      EnqueueRecvTensorsRequestRaw();
+    }
 
     void* tag;
     bool ok;
 
+    const int64_t spin_us = CompletionQueueSpinUs();
+    Env* env = worker_->env()->env;
     while (cq_->Next(&tag, &ok)) {
       tsl::UntypedCall<GrpcWorkerServiceThread>::Tag* callback_tag =
           static_cast<tsl::UntypedCall<GrpcWorkerServiceThread>::Tag*>(tag);
       CHECK(callback_tag);
       callback_tag->OnCompleted(this, ok);
+      // Busy-poll tier: while events keep arriving within the spin window,
+      // service them without parking the thread. See CompletionQueueSpinUs().
+      uint64 spin_deadline_us = spin_us > 0 ? env->NowMicros() + spin_us : 0;
+      while (spin_us > 0) {
+        const auto next_status =
+            cq_->AsyncNext(&tag, &ok, std::chrono::system_clock::now());
+        if (next_status == ::grpc::CompletionQueue::SHUTDOWN) {
+          return;
+        }
+        if (next_status == ::grpc::CompletionQueue::GOT_EVENT) {
+          callback_tag =
+              static_cast<tsl::UntypedCall<GrpcWorkerServiceThread>::Tag*>(tag);
+          CHECK(callback_tag);
+          callback_tag->OnCompleted(this, ok);
+          spin_deadline_us = env->NowMicros() + spin_us;
+          continue;
+        }
+        if (env->NowMicros() >= spin_deadline_us) {
+          break;
+        }
+      }
     }
   }
 
@@ -239,25 +288,32 @@ class GrpcWorkerServiceThread {
     ENQUEUE_REQUEST(MarkRecvFinished, false);
   }
 
+  // Per-call state that outlives the handler closure. Allocated as a single
+  // block: RunGraph is a high-rate method and the separate CallOptions and
+  // wrapper allocations were a measurable slice of worker heap churn.
+  struct RunGraphCallState {
+    explicit RunGraphCallState(
+        WorkerCall<RunGraphRequest, RunGraphResponse>* call)
+        : wrapped_request(&call->request), wrapped_response(&call->response) {}
+    CallOptions call_opts;
+    ProtoRunGraphRequest wrapped_request;
+    NonOwnedProtoRunGraphResponse wrapped_response;
+  };
+
   void RunGraphHandler(WorkerCall<RunGraphRequest, RunGraphResponse>* call) {
     Schedule([this, call]() {
-      CallOptions* call_opts = new CallOptions;
-      ProtoRunGraphRequest* wrapped_request =
-          new ProtoRunGraphRequest(&call->request);
-      NonOwnedProtoRunGraphResponse* wrapped_response =
-          new NonOwnedProtoRunGraphResponse(&call->response);
-      call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
-      worker_->RunGraphAsync(call_opts, wrapped_request, wrapped_response,
-                             [call, call_opts, wrapped_request,
-                              wrapped_response](const Status& s) {
+      RunGraphCallState* state = new RunGraphCallState(call);
+      call->SetCancelCallback(
+          [state]() { state->call_opts.StartCancel(); });
+      worker_->RunGraphAsync(&state->call_opts, &state->wrapped_request,
+                             &state->wrapped_response,
+                             [call, state](const Status& s) {
                                VLOG(3) << "RunGraph::Done";
                                if (!s.ok()) {
                                  VLOG(3) << "Bad response from RunGraph:" << s;
                                }
                                call->ClearCancelCallback();
-                               delete call_opts;
-                               delete wrapped_request;
-                               delete wrapped_response;
+                               delete state;
                                call->SendResponse(ToGrpcStatus(s));
                              });
     });
@@ -284,6 +340,26 @@ class GrpcWorkerServiceThread {
     EnqueueRecvTensorRequestRaw();
   }
 
+  void RecvTensorsHandlerRaw(
+      WorkerCall<RecvTensorsRequest, ::grpc::ByteBuffer>* call) {
+    Schedule([this, call]() {
+      CallOptions* call_opts = new CallOptions;
+      call->SetCancelCallback([call_opts]() { call_opts->StartCancel(); });
+
+      worker_->GrpcRecvTensorsAsync(
+          call_opts, &call->request, &call->response,
+          [call, call_opts](const Status& s) {
+            call->ClearCancelCallback();
+            delete call_opts;
+            if (!s.ok()) {
+              VLOG(3) << "Bad response from RecvTensors:" << s;
+            }
+            call->SendResponse(ToGrpcStatus(s));
+          });
+    });
+    EnqueueRecvTensorsRequestRaw();
+  }
+
   void RecvBufHandler(WorkerCall<RecvBufRequest, RecvBufResponse>* call) {
     Schedule([this, call]() {
       CallOptions* call_opts = new CallOptions;
@@ -353,6 +429,19 @@ class GrpcWorkerServiceThread {
     }
   }
 
+  void EnqueueRecvTensorsRequestRaw() {
+    mutex_lock l(shutdown_mu_);
+    if (!is_shutdown_) {
+      tsl::Call<GrpcWorkerServiceThread, grpc::WorkerService::AsyncService,
+                RecvTensorsRequest, ::grpc::ByteBuffer>::
+          EnqueueRequestForMethod(
+              worker_service_, cq_.get(),
+              static_cast<int>(GrpcWorkerMethod::kRecvTensors),
+              &GrpcWorkerServiceThread::RecvTensorsHandlerRaw,
+              true /* supports cancel*/);
+    }
+  }
+
   GrpcWorker* const worker_ = nullptr;  // Not owned.
   std::unique_ptr<::grpc::ServerCompletionQueue> cq_;
   std::unique_ptr<Thread> thread_;
@@ -416,6 +505,21 @@ class GrpcWorkerService : public tsl::AsyncServiceInterface {
   void operator=(const GrpcWorkerService&) = delete;
 };
 
+// Byte budget for finished responses retained by the worker's RPC response
+// cache. The cache makes idempotent recvs retryable after transient network
+// failures, so it is on by default; the budget bounds worker memory when a
+// receiver dies before acking. Set to 0 to restore the old behavior, where
+// the cache exists (unbounded) only if RPCOptions.cache_rpc_response is set.
+int64_t ResponseCacheBytes() {
+  static int64_t response_cache_bytes = []() {
+    int64_t result;
+    TF_CHECK_OK(tsl::ReadInt64FromEnvVar("TF_GRPC_WORKER_RESPONSE_CACHE_BYTES",
+                                         64 << 20, &result));
+    return result;
+  }();
+  return response_cache_bytes;
+}
+
 }  // namespace
 
 GrpcWorker::GrpcWorker(WorkerEnv* worker_env, const ConfigProto& config)
@@ -424,14 +528,14 @@ GrpcWorker::GrpcWorker(WorkerEnv* worker_env, const ConfigProto& config)
           config.experimental().recv_buf_max_chunk() > 0
               ? config.experimental().recv_buf_max_chunk()
               : (config.experimental().recv_buf_max_chunk() < 0 ? 0 : 4096)) {
-  if (config.rpc_options().cache_rpc_response()) {
+  if (config.rpc_options().cache_rpc_response() || ResponseCacheBytes() > 0) {
     EnableResponseCache();
   }
 }
 
 void GrpcWorker::EnableResponseCache() {
   VLOG(3) << "Enabling gRPC tensor response cache.";
-  response_cache_ = std::make_unique<RpcResponseCache>();
+  response_cache_ = std::make_unique<RpcResponseCache>(ResponseCacheBytes());
 }
 
 // GrpcRecvTensorAsync: unlike the other Worker methods, which use protocol
@@ -554,6 +658,123 @@ void GrpcWorker::GrpcRecvTensorAsync(CallOptions* opts,
       });
 }
 
+// GrpcRecvTensorsAsync: receives one tensor per rendezvous key in the
+// request and encodes them all into a single multiplexed ByteBuffer
+// response.  The response cache is not consulted: batched requests carry a
+// request_id only for retry *detection*, and retried batches fail rather
+// than wait on rendezvous entries that were consumed by the first attempt.
+void GrpcWorker::GrpcRecvTensorsAsync(CallOptions* opts,
+                                      const RecvTensorsRequest* request,
+                                      ::grpc::ByteBuffer* response,
+                                      StatusCallback done) {
+  VLOG(3) << "GrpcRecvTensorsAsync req: " << request->DebugString();
+  const int64_t step_id = request->step_id();
+  const int num_tensors = request->rendezvous_key_size();
+
+  Status s = recent_request_ids_.TrackUnique(
+      request->request_id(), "RecvTensors (GrpcWorker)", *request);
+
+  // Parse every key up front so that a malformed key fails the request
+  // before any rendezvous state is touched.
+  std::vector<Rendezvous::ParsedKey> parsed(num_tensors);
+  std::vector<Device*> src_devs(num_tensors, nullptr);
+  for (int i = 0; s.ok() && i < num_tensors; ++i) {
+    s = Rendezvous::ParseKey(request->rendezvous_key(i), &parsed[i]);
+    if (s.ok()) {
+      s = PrepareRecvTensor(parsed[i], &src_devs[i]);
+    }
+  }
+  if (!s.ok()) {
+    done(s);
+    return;
+  }
+  if (num_tensors == 0) {
+    grpc::EncodeTensorsToByteBuffer({}, {}, /*require_ack=*/false, response);
+    done(absl::OkStatus());
+    return;
+  }
+
+  struct RecvState {
+    explicit RecvState(int n) : tensors(n), is_dead(n, false), pending(n) {}
+    std::vector<Tensor> tensors;
+    std::vector<bool> is_dead;
+    mutex mu;
+    int pending TF_GUARDED_BY(mu);
+    Status status TF_GUARDED_BY(mu);
+  };
+  auto state = std::make_shared<RecvState>(num_tensors);
+
+  // As in GrpcRecvTensorAsync, a cancellation at any time before the last
+  // tensor is produced should abort the whole step.
+  opts->SetCancelCallback([this, step_id]() {
+    LOG(WARNING) << "RecvTensors cancelled for " << step_id;
+    AbortStep(step_id);
+  });
+
+  auto recv_finished = [opts, response, state, done](int i,
+                                                     const Status& status,
+                                                     const Tensor& val,
+                                                     bool is_dead) {
+    bool last = false;
+    Status result;
+    {
+      mutex_lock l(state->mu);
+      state->status.Update(status);
+      state->tensors[i] = val;
+      state->is_dead[i] = is_dead;
+      last = (--state->pending == 0);
+      if (last) result = state->status;
+    }
+    if (!last) return;
+    opts->ClearCancelCallback();
+    if (result.ok()) {
+      grpc::EncodeTensorsToByteBuffer(state->is_dead, state->tensors,
+                                      /*require_ack=*/false, response);
+    }
+    done(result);
+  };
+
+  for (int i = 0; i < num_tensors; ++i) {
+    Device* src_dev = src_devs[i];
+    env_->rendezvous_mgr->RecvLocalAsync(
+        step_id, parsed[i],
+        [i, src_dev, request, recv_finished](
+            const Status& status, const Rendezvous::Args& send_args,
+            const Rendezvous::Args& recv_args, const Tensor& val,
+            const bool is_dead) {
+          if (!status.ok()) {
+            recv_finished(i, status, val, is_dead);
+            return;
+          }
+
+          const bool on_host = send_args.alloc_attrs.on_host();
+          if (!src_dev->tensorflow_accelerator_device_info() || on_host) {
+            recv_finished(i, status, val, is_dead);
+            return;
+          }
+
+          // Accelerator-resident tensors are copied to host memory before
+          // being encoded on the wire, as in GrpcRecvTensorAsync above.
+          DeviceContext* send_dev_context = send_args.device_context;
+          AllocatorAttributes alloc_attrs;
+          alloc_attrs.set_gpu_compatible(true);
+          alloc_attrs.set_on_host(true);
+          Allocator* alloc = src_dev->GetAllocator(alloc_attrs);
+          Tensor* copy = new Tensor(alloc, val.dtype(), val.shape());
+          CHECK(send_dev_context)
+              << "send dev name: " << src_dev->name() << " gpu_info: "
+              << src_dev->tensorflow_accelerator_device_info();
+
+          CopyDeviceToHost(&val, alloc, alloc, request->rendezvous_key(i),
+                           src_dev, copy, send_dev_context,
+                           [i, copy, is_dead, recv_finished](const Status& s) {
+                             recv_finished(i, s, *copy, is_dead);
+                             delete copy;
+                           });
+        });
+  }
+}
+
 namespace {
 // If RecvBufRespExtra.tensor_content is a single large string, then gRPC
 // can stall on the recv side when the string buffer needs to be enlarged,
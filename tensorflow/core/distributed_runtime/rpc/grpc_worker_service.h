@@ -51,6 +51,14 @@ class GrpcWorker : public Worker {
                                    ::grpc::ByteBuffer* response,
                                    StatusCallback done);
 
+  // Receives every tensor named by request->rendezvous_key() and encodes
+  // them into a single multiplexed response, avoiding the per-RPC cost of
+  // one RecvTensor call per tensor.
+  virtual void GrpcRecvTensorsAsync(CallOptions* opts,
+                                    const RecvTensorsRequest* request,
+                                    ::grpc::ByteBuffer* response,
+                                    StatusCallback done);
+
   void LoggingAsync(const LoggingRequest* request, LoggingResponse* response,
                     StatusCallback done) override;
 
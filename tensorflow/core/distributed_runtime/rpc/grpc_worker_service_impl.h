@@ -79,6 +79,7 @@ enum class GrpcWorkerMethod {
   kCleanupGraph,
   kCleanupAll,
   kRecvTensor,
+  kRecvTensors,
   kRecvBuf,
   kLogging,
   kTracing,
@@ -15,14 +15,18 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/rpc/rpc_rendezvous_mgr.h"
 
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/common_runtime/device_mgr.h"
 #include "tensorflow/core/common_runtime/dma_helper.h"
 #include "tensorflow/core/common_runtime/process_util.h"
 #include "tensorflow/core/distributed_runtime/request_id.h"
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
-#include "tensorflow/core/distributed_runtime/worker_cache.h"
 #include "tensorflow/core/distributed_runtime/worker_interface.h"
+#include "tensorflow/core/distributed_runtime/worker_session.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/strings/numbers.h"
@@ -31,11 +35,36 @@ limitations under the License.
 #include "tensorflow/core/platform/macros.h"
 #include "tensorflow/core/platform/notification.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 
 namespace {
 
+// Dwell time for coalescing remote tensor receives.  When positive, recvs
+// destined to the same remote worker that are issued within the window are
+// sent as one multiplexed RecvTensors RPC instead of one RecvTensor RPC
+// per tensor, which matters when a step pulls many small tensors.  Off by
+// default since the dwell adds up to this much latency to the first recv
+// of each batch.
+int64_t RecvTensorBatchWindowUsec() {
+  static const int64_t window = []() -> int64_t {
+    int64_t result;
+    TF_CHECK_OK(
+        ReadInt64FromEnvVar("TF_RECV_TENSOR_BATCH_WINDOW_US", 0, &result));
+    return result;
+  }();
+  return window;
+}
+
+// One remote recv waiting to be coalesced into a RecvTensors RPC.
+struct PendingRecv {
+  std::shared_ptr<WorkerSession::RecvChannel> channel;
+  Rendezvous::ParsedKey parsed;
+  Rendezvous::Args args;
+  Rendezvous::DoneCallback done;
+};
+
 class RpcRemoteRendezvous : public BaseRemoteRendezvous {
  public:
   RpcRemoteRendezvous(const WorkerEnv* env, int64_t step_id)
@@ -49,6 +78,20 @@ class RpcRemoteRendezvous : public BaseRemoteRendezvous {
  private:
   ~RpcRemoteRendezvous() override {}
 
+  // Issues a single RecvTensor RPC for "parsed" on the channel's worker.
+  void StartRecvTensorCall(std::shared_ptr<WorkerSession::RecvChannel> channel,
+                           const Rendezvous::ParsedKey& parsed,
+                           const Rendezvous::Args& recv_args,
+                           DoneCallback done);
+
+  // Sends the recvs that have accumulated for "src_worker" as one
+  // RecvTensors RPC (or as a plain RecvTensor call if only one is pending).
+  void FlushBatch(const string& src_worker);
+
+  mutex batch_mu_;
+  std::unordered_map<string, std::vector<PendingRecv>> pending_batches_
+      TF_GUARDED_BY(batch_mu_);
+
   RpcRemoteRendezvous(const RpcRemoteRendezvous&) = delete;
   void operator=(const RpcRemoteRendezvous&) = delete;
 };
@@ -115,10 +158,11 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
     return status_;
   }
 
-  void ReleaseWorker(WorkerCacheInterface* worker_cache) {
+  void ReleaseWorker() {
     DCHECK_NE(static_cast<WorkerInterface*>(nullptr), wi_)
         << "RpcRecvTensorCall::ReleaseWorker() called twice.";
-    worker_cache->ReleaseWorker(src_worker_, wi_);
+    // The worker is owned by the session's standing recv channel, not by
+    // this call; just drop the borrowed pointer.
     wi_ = nullptr;
   }
 
@@ -167,8 +211,6 @@ class RpcRecvTensorCall : public BaseRecvTensorCall {
     abort_checked->Notify();
   }
 
-  string src_worker_;
-  string src_rel_device_;
   WorkerInterface* wi_;  // Not owned.
   AllocatorAttributes alloc_attrs_;
   Device* dst_device_;
@@ -230,47 +272,186 @@ static RpcRecvTensorFreeList* get_call_freelist() {
   return call_freelist;
 }
 
+// Retrieves a batch of tensors from one remote worker with a single
+// multiplexed RecvTensors RPC.  Unlike RpcRecvTensorCall these calls are
+// not pooled; the allocation is amortized over the whole batch.
+class RpcRecvTensorsCall : public BaseRecvTensorCall {
+ public:
+  RpcRecvTensorsCall(int64_t step_id, std::vector<PendingRecv> recvs)
+      : recvs_(std::move(recvs)), responses_(recvs_.size()) {
+    req_.set_step_id(step_id);
+    req_.set_request_id(GetUniqueRequestId());
+    for (size_t i = 0; i < recvs_.size(); i++) {
+      StringPiece key = recvs_[i].parsed.FullKey();
+      req_.add_rendezvous_key(key.data(), key.size());
+      responses_[i].InitAlloc(recvs_[i].channel->dst_device,
+                              recvs_[i].args.alloc_attrs);
+    }
+  }
+
+  void Start(std::function<void()> recv_done) override {
+    auto abort_checked = std::make_shared<Notification>();
+    auto cb = [this, abort_checked,
+               recv_done = std::move(recv_done)](const Status& s) {
+      // Make sure the Rendezvous abort checking is finished before running
+      // the callback, which might destroy the current call object.
+      abort_checked->WaitForNotification();
+      if (!s.ok()) {
+        mutex_lock l(mu_);
+        status_.Update(s);
+      }
+      recv_done();
+    };
+    // All recvs in a batch share one channel; its worker issues the RPC.
+    recvs_[0].channel->worker->RecvTensorsAsync(&opts_, &req_, &responses_,
+                                                std::move(cb));
+
+    // Check if the rendezvous was aborted after sending out the RPC, for
+    // the same reason as RpcRecvTensorCall::StartRTCall above.
+    Status s;
+    {
+      mutex_lock l(mu_);
+      s = status_;
+    }
+    if (!s.ok()) {
+      opts_.StartCancel();
+    }
+    abort_checked->Notify();
+  }
+
+  void StartAbort(const Status& s) override {
+    {
+      mutex_lock l(mu_);
+      status_.Update(s);
+    }
+    opts_.StartCancel();
+  }
+
+  Status status() const override {
+    mutex_lock l(mu_);
+    return status_;
+  }
+
+  const Rendezvous::Args& recv_args() const { return recvs_[0].args; }
+
+  // Completes every pending recv.  On success each recv observes its own
+  // parsed tensor; on error all recvs observe "s".
+  void Done(const Status& s) {
+    for (size_t i = 0; i < recvs_.size(); i++) {
+      recvs_[i].done(s, Rendezvous::Args(), recvs_[i].args,
+                     responses_[i].tensor(),
+                     responses_[i].metadata().is_dead());
+    }
+  }
+
+ private:
+  std::vector<PendingRecv> recvs_;
+  CallOptions opts_;
+  RecvTensorsRequest req_;
+  std::vector<TensorResponse> responses_;
+
+  mutable mutex mu_;
+  Status status_ TF_GUARDED_BY(mu_);
+
+  RpcRecvTensorsCall(const RpcRecvTensorsCall&) = delete;
+  void operator=(const RpcRecvTensorsCall&) = delete;
+};
+
 void RpcRemoteRendezvous::RecvFromRemoteAsync(
     const Rendezvous::ParsedKey& parsed, const Rendezvous::Args& recv_args,
     DoneCallback done) {
   CHECK(is_initialized());
-  Status s;
 
-  // Prepare a RecvTensor call that can handle being aborted.
-  RpcRecvTensorCall* call = get_call_freelist()->New();
+  // Resolving the source worker and destination device happens once per
+  // (src, dst) device pair; later steps reuse the session's standing channel.
+  WorkerSession* sess = session();
+  std::shared_ptr<WorkerSession::RecvChannel> channel;
+  Status s = sess->GetOrCreateRecvChannel(parsed.src_device, parsed.dst_device,
+                                          &channel);
+  if (!s.ok()) {
+    done(s, Args(), recv_args, Tensor{}, false);
+    return;
+  }
+
+  const int64_t window_usec = RecvTensorBatchWindowUsec();
+  if (window_usec <= 0) {
+    StartRecvTensorCall(std::move(channel), parsed, recv_args,
+                        std::move(done));
+    return;
+  }
 
-  // key.src_device identifies a remote device.
-  if (!DeviceNameUtils::SplitDeviceName(parsed.src_device, &call->src_worker_,
-                                        &call->src_rel_device_)) {
-    s = errors::Internal(parsed.src_device,
-                         " is invalid remote source device.");
+  // Batching enabled: park this recv until the window for its source
+  // worker expires.  The first recv parked for a worker schedules the
+  // flush; the Ref keeps this rendezvous alive until the flush has run.
+  bool first_in_batch = false;
+  string src_worker = channel->src_worker;
+  {
+    mutex_lock l(batch_mu_);
+    std::vector<PendingRecv>& batch = pending_batches_[src_worker];
+    first_in_batch = batch.empty();
+    batch.push_back(
+        PendingRecv{std::move(channel), parsed, recv_args, std::move(done)});
   }
-  WorkerSession* sess = session();
-  std::shared_ptr<WorkerCacheInterface> worker_cache =
-      sess->GetSharedWorkerCache();
-  // The worker will be released in a subsequent call to
-  // `sess->worker_cache()->ReleaseWorker()` (if the call has not yet been
-  // initialized) or `call->ReleaseWorker()` (if it has been initialized).
-  WorkerInterface* rwi = worker_cache->GetOrCreateWorker(call->src_worker_);
-  if (s.ok() && rwi == nullptr) {
-    s = errors::Internal("No worker known as ", call->src_worker_);
+  if (first_in_batch) {
+    Ref();
+    env_->env->SchedClosureAfter(window_usec, [this, src_worker]() {
+      FlushBatch(src_worker);
+      Unref();
+    });
   }
+}
 
-  Device* dst_device;
-  if (s.ok()) {
-    s = sess->device_mgr()->LookupDevice(parsed.dst_device, &dst_device);
+void RpcRemoteRendezvous::FlushBatch(const string& src_worker) {
+  std::vector<PendingRecv> batch;
+  {
+    mutex_lock l(batch_mu_);
+    auto it = pending_batches_.find(src_worker);
+    if (it == pending_batches_.end()) return;
+    batch.swap(it->second);
+    pending_batches_.erase(it);
   }
-  if (!s.ok()) {
-    if (rwi != nullptr) {
-      sess->worker_cache()->ReleaseWorker(call->src_worker_, rwi);
-    }
-    get_call_freelist()->Release(call);
-    done(s, Args(), recv_args, Tensor{}, false);
+  if (batch.size() == 1) {
+    // Nothing to coalesce; the regular path reuses pooled call objects and
+    // participates in the sender's response cache.
+    PendingRecv& p = batch[0];
+    StartRecvTensorCall(std::move(p.channel), p.parsed, p.args,
+                        std::move(p.done));
+    return;
+  }
+
+  RpcRecvTensorsCall* call = new RpcRecvTensorsCall(step_id_, std::move(batch));
+
+  // Record "call" in calls_ so that it can be aborted cleanly.
+  RegisterCall(call, call->recv_args());
+
+  // RendezvousMgr already aborted, shouldn't send RPC call any more
+  if (!call->status().ok()) {
+    DeregisterCall(call, call->recv_args());
+    call->Done(call->status());
+    delete call;
     return;
   }
 
-  call->Init(rwi, step_id_, parsed.FullKey(), recv_args.alloc_attrs, dst_device,
-             recv_args, std::move(done));
+  Ref();
+  call->Start([this, call]() {
+    DeregisterCall(call, call->recv_args());
+    Status s = call->status();
+    call->Done(s);
+    delete call;
+    Unref();
+  });
+}
+
+void RpcRemoteRendezvous::StartRecvTensorCall(
+    std::shared_ptr<WorkerSession::RecvChannel> channel,
+    const Rendezvous::ParsedKey& parsed, const Rendezvous::Args& recv_args,
+    DoneCallback done) {
+  // Prepare a RecvTensor call that can handle being aborted.
+  RpcRecvTensorCall* call = get_call_freelist()->New();
+
+  call->Init(channel->worker, step_id_, parsed.FullKey(),
+             recv_args.alloc_attrs, channel->dst_device, recv_args,
+             std::move(done));
 
   // Record "call" in calls_ so that it can be aborted cleanly.
   RegisterCall(call, recv_args);
@@ -278,27 +459,22 @@ void RpcRemoteRendezvous::RecvFromRemoteAsync(
   // RendezvousMgr already aborted, shouldn't send RPC call any more
   if (!call->status().ok()) {
     DeregisterCall(call, recv_args);
-    // NOTE: `*sess` can potentially be deleted before we return from
-    // `call->done()(...)`, so we must release the worker before calling the
-    // callback.
-    call->ReleaseWorker(sess->worker_cache());
+    call->ReleaseWorker();
     call->done()(call->status(), Args(), Args(), Tensor(), false);
     get_call_freelist()->Release(call);
     return;
   }
 
-  // Start "call".
+  // Start "call".  The captured channel keeps the worker alive until the
+  // call completes, even if the session is updated or deleted meanwhile.
   Ref();
-  call->Start([this, call, recv_args, worker_cache]() {
+  call->Start([this, call, recv_args, channel]() {
     // Removes "call" from calls_. Prevent StartAbort().
     DeregisterCall(call, recv_args);
     // If StartAbort was called prior to DeregisterCall, then the
     // current status should be bad.
     Status s = call->status();
-    // NOTE: `*session()` can potentially be deleted before we return from
-    // `call->done()(...)`, so we must release the worker before calling the
-    // callback.
-    call->ReleaseWorker(session()->worker_cache());
+    call->ReleaseWorker();
     call->done()(s, Args(), call->recv_args(), call->tensor(), call->is_dead());
     get_call_freelist()->Release(call);
     Unref();
@@ -103,6 +103,10 @@ void RpcResponseCache::RequestFinished(int64_t request_id, const Tensor& tensor,
     entry_copy = entry;
 
     entry.callbacks.clear();
+
+    finished_bytes_ += tensor.TotalBytes();
+    finished_order_.push_back(request_id);
+    DiscardOldestFinishedEntries();
   }
 
   for (auto& cb : entry_copy.callbacks) {
@@ -112,20 +116,56 @@ void RpcResponseCache::RequestFinished(int64_t request_id, const Tensor& tensor,
 
 void RpcResponseCache::EraseRequestId(int64_t request_id) {
   mutex_lock m(mu_);
-  response_cache_.erase(request_id);
+  EraseEntry(request_id);
 }
 
 void RpcResponseCache::CleanEntriesForStep(int64_t step_id) {
   mutex_lock m(mu_);
   // Remove all cache entries whose step id is the given step_id
-  for (auto it = response_cache_.begin(), last = response_cache_.end();
-       it != last;) {
-    if (it->second.step_id == step_id) {
-      VLOG(1) << "Erase stale RpcResponseCache entry " << it->first;
-      it = response_cache_.erase(it);
-    } else {
-      ++it;
+  std::vector<int64_t> erase_ids;
+  for (const auto& it : response_cache_) {
+    if (it.second.step_id == step_id) {
+      erase_ids.push_back(it.first);
+    }
+  }
+  for (int64_t request_id : erase_ids) {
+    VLOG(1) << "Erase stale RpcResponseCache entry " << request_id;
+    EraseEntry(request_id);
+  }
+}
+
+void RpcResponseCache::EraseEntry(int64_t request_id) {
+  auto it = response_cache_.find(request_id);
+  if (it == response_cache_.end()) return;
+  if (it->second.state == ResponseCacheEntry::State::FINISHED) {
+    finished_bytes_ -= it->second.tensor.TotalBytes();
+  }
+  response_cache_.erase(it);
+}
+
+void RpcResponseCache::DiscardOldestFinishedEntries() {
+  // Drop ids that were already erased by acks or step cleanup; in the common
+  // case where every response is acked this keeps finished_order_ from
+  // growing without bound, since acks arrive in roughly finish order.
+  auto front_entry = [this]() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    auto it = response_cache_.find(finished_order_.front());
+    return it == response_cache_.end() ||
+                   it->second.state != ResponseCacheEntry::State::FINISHED
+               ? response_cache_.end()
+               : it;
+  };
+  while (!finished_order_.empty() && front_entry() == response_cache_.end()) {
+    finished_order_.pop_front();
+  }
+  while (max_finished_bytes_ > 0 && finished_bytes_ > max_finished_bytes_ &&
+         !finished_order_.empty()) {
+    auto it = front_entry();
+    if (it != response_cache_.end()) {
+      VLOG(1) << "RpcResponseCache over budget; discarding entry " << it->first;
+      finished_bytes_ -= it->second.tensor.TotalBytes();
+      response_cache_.erase(it);
     }
+    finished_order_.pop_front();
   }
 }
 
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_RPC_RESPONSE_CACHE_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_RPC_RPC_RESPONSE_CACHE_H_
 
+#include <deque>
 #include <memory>
 #include <unordered_map>
 #include <vector>
@@ -43,6 +44,13 @@ class RpcResponseCache {
   using FinishResponseCB = std::function<void(
       const Tensor& tensor, bool is_dead, const Status& status)>;
 
+  // `max_finished_bytes` bounds the total size of the tensors retained for
+  // FINISHED entries; the oldest finished entries are discarded to stay
+  // within the budget. 0 means unbounded, which relies entirely on receiver
+  // acks and step cleanup to reclaim entries.
+  explicit RpcResponseCache(int64_t max_finished_bytes = 0)
+      : max_finished_bytes_(max_finished_bytes) {}
+
   // Add the given request to the cache.
   // If the request is in the cache,
   //    If it is finished, invoke `cb` immediately
@@ -86,10 +94,25 @@ class RpcResponseCache {
     std::vector<FinishResponseCB> callbacks;
   };
 
+  // Erases the entry with the given request_id, updating the finished-bytes
+  // accounting if it was FINISHED.
+  void EraseEntry(int64_t request_id) TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  // Discards the oldest finished entries until finished_bytes_ is within
+  // max_finished_bytes_, and drops ids already erased by acks or step
+  // cleanup from the front of finished_order_.
+  void DiscardOldestFinishedEntries() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
+  const int64_t max_finished_bytes_;
+
   mutex mu_;
   // response_cache_ is expected to be small, as entries are cleared immediately
   // on ack from the receiver.
   gtl::FlatMap<int64_t, ResponseCacheEntry> response_cache_ TF_GUARDED_BY(mu_);
+  // request_ids of FINISHED entries in finish order; may contain ids that
+  // were since erased.
+  std::deque<int64_t> finished_order_ TF_GUARDED_BY(mu_);
+  int64_t finished_bytes_ TF_GUARDED_BY(mu_) = 0;
 };
 
 }  // namespace tensorflow
@@ -15,11 +15,16 @@ limitations under the License.
 
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "google/protobuf/any.pb.h"
 
 #include "tensorflow/core/common_runtime/device.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
+#include "tensorflow/core/lib/core/errors.h"
 
 namespace tensorflow {
 
@@ -27,6 +32,7 @@ TensorResponse::Source::~Source() {}
 
 void TensorResponse::Clear() {
   on_host_ = false;
+  can_alias_content_ = false;
   device_ = nullptr;
   alloc_attrs_ = AllocatorAttributes();
   allocator_ = nullptr;
@@ -47,6 +53,12 @@ void TensorResponse::InitAlloc(DeviceBase* d, const AllocatorAttributes& aa) {
   if (alloc_attrs_.on_host() || da.device_type() == "CPU") {
     on_host_ = true;
   }
+  // A tensor that aliases transport-owned memory bypasses allocator_, so we
+  // only allow it when the caller needs plain host memory.  Callers that set
+  // gpu_compatible or nic_compatible need specially registered memory (e.g.
+  // cuda-pinned pages) that the transport's buffers do not provide.
+  can_alias_content_ = on_host_ && !alloc_attrs_.gpu_compatible() &&
+                       !alloc_attrs_.nic_compatible();
   allocator_ = device_->GetAllocator(alloc_attrs_);
 }
 
@@ -144,7 +156,8 @@ bool ReadNestedMessage(protobuf::io::CodedInputStream* input,
 }  // namespace
 
 bool TensorResponse::ParseTensorSubmessage(
-    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta) {
+    protobuf::io::CodedInputStream* input, TensorProto* tensor_meta,
+    Source* source) {
   bool seen_tensor_content = false;
   while (true) {
     auto p = input->ReadTagWithCutoff(127);
@@ -195,12 +208,33 @@ bool TensorResponse::ParseTensorSubmessage(
         if (!ReadVarintSizeAsInt(input, &num_bytes)) return false;
         seen_tensor_content = true;
         TensorShape shape(tensor_meta->tensor_shape());
+        if (can_alias_content_ &&
+            shape.num_elements() * DataTypeSize(tensor_meta->dtype()) ==
+                num_bytes) {
+          // Try to make the tensor alias the transport's buffer directly,
+          // avoiding a copy of the contents.  Only use the aliased region if
+          // it satisfies the alignment that allocator-backed tensors normally
+          // provide.
+          TensorBuffer* buf =
+              source->AliasTensorContent(input->CurrentPosition(), num_bytes);
+          if (buf != nullptr) {
+            if (reinterpret_cast<uintptr_t>(buf->data()) %
+                    Allocator::kAllocatorAlignment ==
+                0) {
+              if (!input->Skip(num_bytes)) {
+                buf->Unref();
+                return false;
+              }
+              tensor_ = Tensor(tensor_meta->dtype(), shape, buf);
+              buf->Unref();
+              break;
+            }
+            buf->Unref();
+          }
+        }
         Tensor t(allocator_, tensor_meta->dtype(), shape);
         StringPiece buf = t.tensor_data();
         if (static_cast<size_t>(num_bytes) != buf.size()) return false;
-        // TODO(jeff,sanjay): Figure out a way to avoid this copy if
-        // the underlying ZeroCopyInputStream data is properly aligned
-        // and compatible with what allocator_ wants.
         if (!input->ReadRaw(const_cast<char*>(buf.data()), num_bytes))
           return false;
         tensor_ = std::move(t);
@@ -233,7 +267,7 @@ bool TensorResponse::ParseFast(Source* source) {
         std::pair<protobuf::io::CodedInputStream::Limit, int> p =
             input.IncrementRecursionDepthAndPushLimit(length);
         if (p.second < 0 ||
-            !ParseTensorSubmessage(&input, meta_.mutable_tensor())) {
+            !ParseTensorSubmessage(&input, meta_.mutable_tensor(), source)) {
           return false;
         }
         if (!input.DecrementRecursionDepthAndPopLimit(p.first)) {
@@ -275,6 +309,85 @@ bool TensorResponse::ParseFast(Source* source) {
   return false;
 }
 
+namespace {
+
+// Exposes the byte range [base, base + length) of a wrapped Source as a
+// Source of its own, so that one submessage of a multiplexed response can
+// be handed to TensorResponse::ParseFrom unchanged.
+class SubrangeSource : public TensorResponse::Source {
+ public:
+  SubrangeSource(TensorResponse::Source* wrapped, int base, int length)
+      : wrapped_(wrapped), base_(base), length_(length) {}
+
+  protobuf::io::ZeroCopyInputStream* contents() override {
+    // Re-derive the limited view on every call: the wrapped contents()
+    // rewinds to the beginning of the full response by contract.
+    protobuf::io::ZeroCopyInputStream* stream = wrapped_->contents();
+    stream->Skip(base_);
+    limiting_.reset(new protobuf::io::LimitingInputStream(stream, length_));
+    return limiting_.get();
+  }
+
+  TensorBuffer* AliasTensorContent(size_t offset, size_t length) override {
+    return wrapped_->AliasTensorContent(base_ + offset, length);
+  }
+
+ private:
+  TensorResponse::Source* wrapped_;  // Not owned.
+  const int base_;
+  const int length_;
+  std::unique_ptr<protobuf::io::LimitingInputStream> limiting_;
+};
+
+}  // namespace
+
+Status ParseTensorsFrom(TensorResponse::Source* source,
+                        const std::vector<TensorResponse*>& responses) {
+  // First pass: record the byte range of each RecvTensorResponse submessage
+  // without touching its contents.
+  std::vector<std::pair<int, int>> ranges;  // {offset, length} pairs
+  ranges.reserve(responses.size());
+  {
+    protobuf::io::CodedInputStream input(source->contents());
+    while (true) {
+      auto p = input.ReadTagWithCutoff(127);
+      if (!p.second) {
+        if (GetTagFieldNumber(p.first) != 0) {
+          return errors::InvalidArgument("Cannot parse tensors response");
+        }
+        break;
+      }
+      if (GetTagFieldNumber(p.first) !=
+              RecvTensorsResponse::kTensorFieldNumber ||
+          GetTagWireType(p.first) != WIRETYPE_LENGTH_DELIMITED) {
+        return errors::InvalidArgument("Cannot parse tensors response");
+      }
+      int length;
+      if (!ReadVarintSizeAsInt(&input, &length)) {
+        return errors::InvalidArgument("Cannot parse tensors response");
+      }
+      const int offset = input.CurrentPosition();
+      if (!input.Skip(length)) {
+        return errors::InvalidArgument("Truncated tensors response");
+      }
+      ranges.push_back({offset, length});
+    }
+  }
+  if (ranges.size() != responses.size()) {
+    return errors::InvalidArgument("Expected ", responses.size(),
+                                   " tensors in response, got ",
+                                   ranges.size());
+  }
+  // Second pass: parse each submessage through a view restricted to its
+  // range, preserving the fast path (including content aliasing) of the
+  // single-tensor decoder.
+  for (size_t i = 0; i < ranges.size(); i++) {
+    SubrangeSource sub(source, ranges[i].first, ranges[i].second);
+    TF_RETURN_IF_ERROR(responses[i]->ParseFrom(&sub));
+  }
+  return absl::OkStatus();
+}
+
 bool TensorResponse::ParseSlow(Source* source) {
   if (!meta_.ParseFromZeroCopyStream(source->contents())) {
     return false;
@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_CODING_H_
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_CODING_H_
 
+#include <vector>
+
 #include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/lib/core/status.h"
@@ -63,6 +65,16 @@ class TensorResponse {
     // Ownership of the returned stream is retained by the Source and
     // should not be deleted by the caller.
     virtual ::tensorflow::protobuf::io::ZeroCopyInputStream* contents() = 0;
+
+    // If the "length" bytes starting at byte "offset" of the serialized
+    // response occupy a single memory region whose lifetime the transport
+    // can extend beyond this Source, returns a TensorBuffer aliasing those
+    // bytes; the caller owns a reference on the result.  Returns nullptr
+    // when the bytes are not contiguous or their lifetime cannot be
+    // extended, in which case the caller must copy them out of contents().
+    virtual TensorBuffer* AliasTensorContent(size_t offset, size_t length) {
+      return nullptr;
+    }
   };
 
   // Parse the RecvTensorResponse encoded in the data yielded by
@@ -92,11 +104,12 @@ class TensorResponse {
 
  private:
   bool ParseTensorSubmessage(protobuf::io::CodedInputStream* input,
-                             TensorProto* tensor_meta);
+                             TensorProto* tensor_meta, Source* source);
   bool ParseFast(Source* source);
   bool ParseSlow(Source* source);
 
   bool on_host_ = false;
+  bool can_alias_content_ = false;
   DeviceBase* device_ = nullptr;
   AllocatorAttributes alloc_attrs_;
   Allocator* allocator_ = nullptr;
@@ -105,6 +118,14 @@ class TensorResponse {
   RecvTensorResponse meta_;
 };
 
+// Splits the serialized RecvTensorsResponse yielded by source->contents()
+// into its RecvTensorResponse submessages and parses the i-th submessage
+// into *responses[i].  Each TensorResponse must already have been
+// initialized with InitAlloc.  Fails if the payload does not hold exactly
+// responses.size() submessages.
+Status ParseTensorsFrom(TensorResponse::Source* source,
+                        const std::vector<TensorResponse*>& responses);
+
 }  // namespace tensorflow
 
 #endif  // TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_TENSOR_CODING_H_
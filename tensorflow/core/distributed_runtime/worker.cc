@@ -27,7 +27,9 @@ limitations under the License.
 #include "tensorflow/core/distributed_runtime/tensor_coding.h"
 #include "tensorflow/core/distributed_runtime/worker_session.h"
 #include "tensorflow/core/framework/collective.h"
+#include "tensorflow/core/framework/node_def_util.h"
 #include "tensorflow/core/profiler/lib/device_profiler_session.h"
+#include "tensorflow/core/util/device_name_utils.h"
 #include "tsl/platform/tracing.h"
 #include "tsl/protobuf/distributed_runtime_payloads.pb.h"
 
@@ -74,6 +76,36 @@ void Worker::DeleteWorkerSessionAsync(CallOptions* opts,
   done(s);
 }
 
+namespace {
+
+// Pre-establishes the session's standing recv channels for the statically
+// known cross-worker edges of a newly registered graph, so the first steps
+// do not pay for endpoint resolution. Failures are ignored here; they
+// surface on the step that actually uses the edge.
+void WarmupRecvChannels(WorkerSession* session, const GraphDef& gdef) {
+  for (const NodeDef& ndef : gdef.node()) {
+    if (ndef.op() != "_Recv" && ndef.op() != "_HostRecv") continue;
+    string send_device;
+    string recv_device;
+    if (!TryGetNodeAttr(ndef, "send_device", &send_device) ||
+        !TryGetNodeAttr(ndef, "recv_device", &recv_device)) {
+      continue;
+    }
+    DeviceNameUtils::ParsedName src;
+    DeviceNameUtils::ParsedName dst;
+    if (!DeviceNameUtils::ParseFullName(send_device, &src) ||
+        !DeviceNameUtils::ParseFullName(recv_device, &dst) ||
+        DeviceNameUtils::IsSameAddressSpace(src, dst)) {
+      continue;
+    }
+    std::shared_ptr<WorkerSession::RecvChannel> unused;
+    session->GetOrCreateRecvChannel(send_device, recv_device, &unused)
+        .IgnoreError();
+  }
+}
+
+}  // namespace
+
 void Worker::RegisterGraphAsync(const RegisterGraphRequest* request,
                                 RegisterGraphResponse* response,
                                 StatusCallback done) {
@@ -86,11 +118,30 @@ void Worker::RegisterGraphAsync(const RegisterGraphRequest* request,
     session = env_->session_mgr->LegacySession();
   }
   if (s.ok()) {
-    s = session->graph_mgr()->Register(
-        request->session_handle(), request->graph_def(),
-        request->graph_options(), request->debug_options(),
-        request->config_proto(), request->collective_graph_key(), session.get(),
-        session->cluster_flr(), response->mutable_graph_handle());
+    if (request->function_fingerprints().empty()) {
+      s = session->graph_mgr()->Register(
+          request->session_handle(), request->graph_def(),
+          request->graph_options(), request->debug_options(),
+          request->config_proto(), request->collective_graph_key(),
+          session.get(), session->cluster_flr(),
+          response->mutable_graph_handle());
+    } else {
+      // The master shipped only the function definitions this session has
+      // not seen yet; restore the rest from the per-session cache.
+      GraphDef gdef = request->graph_def();
+      s = session->graph_mgr()->ResolveFunctionLibraryDelta(
+          request->function_fingerprints(), &gdef);
+      if (s.ok()) {
+        s = session->graph_mgr()->Register(
+            request->session_handle(), gdef, request->graph_options(),
+            request->debug_options(), request->config_proto(),
+            request->collective_graph_key(), session.get(),
+            session->cluster_flr(), response->mutable_graph_handle());
+      }
+    }
+  }
+  if (s.ok()) {
+    WarmupRecvChannels(session.get(), request->graph_def());
   }
   done(s);
 }
@@ -17,11 +17,17 @@ limitations under the License.
 #define TENSORFLOW_CORE_DISTRIBUTED_RUNTIME_WORKER_INTERFACE_H_
 
 #include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
 
 #include "tensorflow/core/distributed_runtime/call_options.h"
 #include "tensorflow/core/distributed_runtime/message_wrappers.h"
+#include "tensorflow/core/distributed_runtime/tensor_coding.h"
 #include "tensorflow/core/lib/core/notification.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/protobuf/worker.pb.h"
 
@@ -30,9 +36,6 @@ namespace tensorflow {
 // Status callback.
 typedef std::function<void(const Status&)> StatusCallback;
 
-// Custom decoder for a response to RecvTensorAsync.
-class TensorResponse;
-
 // Interface for talking with the TensorFlow Worker service.
 class WorkerInterface {
  public:
@@ -106,6 +109,63 @@ class WorkerInterface {
                                TensorResponse* response,
                                StatusCallback done) = 0;
 
+  // Receives one tensor per rendezvous key in "*request" in a single
+  // logical operation.  "*responses" must hold one TensorResponse per key,
+  // each already initialized with InitAlloc.  The default implementation
+  // fans out to one RecvTensorAsync call per key; transports that support
+  // multiplexed transfers override this with a single round trip.
+  virtual void RecvTensorsAsync(CallOptions* opts,
+                                const RecvTensorsRequest* request,
+                                std::vector<TensorResponse>* responses,
+                                StatusCallback done) {
+    const int n = request->rendezvous_key_size();
+    DCHECK_EQ(n, static_cast<int>(responses->size()));
+    if (n == 0) {
+      done(absl::OkStatus());
+      return;
+    }
+    struct FanOutState {
+      explicit FanOutState(int n) : requests(n), call_opts(n), pending(n) {}
+      std::vector<RecvTensorRequest> requests;
+      std::vector<CallOptions> call_opts;
+      mutex mu;
+      int pending TF_GUARDED_BY(mu);
+      Status status TF_GUARDED_BY(mu);
+      StatusCallback done;
+    };
+    auto state = std::make_shared<FanOutState>(n);
+    state->done = std::move(done);
+    if (opts != nullptr) {
+      opts->SetCancelCallback([state]() {
+        for (auto& call_opts : state->call_opts) {
+          call_opts.StartCancel();
+        }
+      });
+    }
+    for (int i = 0; i < n; ++i) {
+      RecvTensorRequest* req = &state->requests[i];
+      req->set_step_id(request->step_id());
+      req->set_rendezvous_key(request->rendezvous_key(i));
+      // Leave request_id at zero: retry detection applies to the batched
+      // request as a whole, not its per-key parts.
+      RecvTensorAsync(&state->call_opts[i], req, &(*responses)[i],
+                      [state, opts](const Status& s) {
+                        bool last = false;
+                        Status status;
+                        {
+                          mutex_lock l(state->mu);
+                          state->status.Update(s);
+                          last = (--state->pending == 0);
+                          if (last) status = state->status;
+                        }
+                        if (last) {
+                          if (opts != nullptr) opts->ClearCancelCallback();
+                          state->done(status);
+                        }
+                      });
+    }
+  }
+
   virtual void LoggingAsync(const LoggingRequest* request,
                             LoggingResponse* response, StatusCallback done) = 0;
 
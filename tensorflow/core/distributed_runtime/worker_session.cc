@@ -20,6 +20,8 @@ limitations under the License.
 #include <vector>
 
 #include "tensorflow/core/lib/monitoring/gauge.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/util/device_name_utils.h"
 
 namespace tensorflow {
 
@@ -146,6 +148,49 @@ WorkerSession::WorkerSession(
   worker_session_created->GetCell()->Set(true);
 }
 
+WorkerSession::RecvChannel::~RecvChannel() {
+  if (worker != nullptr) {
+    worker_cache->ReleaseWorker(src_worker, worker);
+  }
+}
+
+Status WorkerSession::GetOrCreateRecvChannel(
+    StringPiece src_device, StringPiece dst_device,
+    std::shared_ptr<RecvChannel>* out) {
+  const string key = strings::StrCat(src_device, ";", dst_device);
+  {
+    mutex_lock l(recv_channels_mu_);
+    auto it = recv_channels_.find(key);
+    if (it != recv_channels_.end()) {
+      *out = it->second;
+      return absl::OkStatus();
+    }
+  }
+
+  auto channel = std::make_shared<RecvChannel>();
+  if (!DeviceNameUtils::SplitDeviceName(src_device, &channel->src_worker,
+                                        &channel->src_rel_device)) {
+    return errors::Internal(src_device, " is invalid remote source device.");
+  }
+  channel->worker_cache = GetSharedWorkerCache();
+  channel->worker =
+      channel->worker_cache->GetOrCreateWorker(channel->src_worker);
+  if (channel->worker == nullptr) {
+    return errors::Internal("No worker known as ", channel->src_worker);
+  }
+  TF_RETURN_IF_ERROR(
+      device_mgr()->LookupDevice(dst_device, &channel->dst_device));
+
+  mutex_lock l(recv_channels_mu_);
+  auto& slot = recv_channels_[key];
+  if (slot == nullptr) {
+    // Lost races destroy `channel`, releasing its worker reference.
+    slot = std::move(channel);
+  }
+  *out = slot;
+  return absl::OkStatus();
+}
+
 Status WorkerSession::UpdateWorkerCacheAndDevices(
     std::unique_ptr<WorkerCacheInterface> new_worker_cache,
     std::vector<std::unique_ptr<Device>> added_remote_devices,
@@ -155,6 +200,12 @@ Status WorkerSession::UpdateWorkerCacheAndDevices(
     worker_cache_ = std::shared_ptr<WorkerCacheInterface>(
         new WorkerFreeListCache(std::move(new_worker_cache)));
   }
+  {
+    // Drop channels resolved against the old worker cache; in-flight Recvs
+    // keep theirs alive through the shared pointer they hold.
+    mutex_lock l(recv_channels_mu_);
+    recv_channels_.clear();
+  }
   TF_RETURN_IF_ERROR(remote_device_mgr_->RemoveDevices(removed_remote_devices));
   TF_RETURN_IF_ERROR(
       remote_device_mgr_->AddDevices(std::move(added_remote_devices)));
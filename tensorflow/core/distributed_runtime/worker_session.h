@@ -19,6 +19,7 @@ limitations under the License.
 #include <functional>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 #include "tensorflow/core/common_runtime/device_mgr.h"
@@ -87,6 +88,31 @@ class WorkerSession {
     return worker_cache_;
   }
 
+  // A resolved endpoint for one statically known cross-worker recv edge.
+  // Resolving the source worker and destination device requires name parsing
+  // and cache lookups on every Recv; for short steps this fixed cost adds up,
+  // so the resolution is done once per (src, dst) device pair and the
+  // standing channel is reused by every subsequent step's Recv on that edge.
+  struct RecvChannel {
+    ~RecvChannel();
+    string src_worker;
+    string src_rel_device;
+    // Keeps the cache that created `worker` alive across worker cache
+    // updates so the worker can be released to it.
+    std::shared_ptr<WorkerCacheInterface> worker_cache;
+    WorkerInterface* worker = nullptr;
+    Device* dst_device = nullptr;  // Local to this session; not owned.
+  };
+
+  // Returns the standing channel for tensors flowing from "src_device" to
+  // "dst_device", creating it on first use. Returns an error if the source
+  // device name cannot be parsed, the source worker is unknown, or the
+  // destination device is not local to this session. Callers should hold the
+  // returned shared pointer for the duration of any RPC issued on the
+  // channel's worker.
+  Status GetOrCreateRecvChannel(StringPiece src_device, StringPiece dst_device,
+                                std::shared_ptr<RecvChannel>* out);
+
   // Update an existing worker session with new set of remote workers and
   // devices. Added devices will be owned by the worker session, and removed
   // devices will be freed by their names.
@@ -116,6 +142,13 @@ class WorkerSession {
   std::shared_ptr<WorkerCacheInterface> worker_cache_
       TF_GUARDED_BY(worker_session_state_mu_);
 
+  // Standing recv channels keyed by "<src_device>;<dst_device>". Entries
+  // persist for the lifetime of the session (or until the worker cache is
+  // replaced) so per-step Recvs skip endpoint re-resolution.
+  mutex recv_channels_mu_;
+  std::unordered_map<string, std::shared_ptr<RecvChannel>> recv_channels_
+      TF_GUARDED_BY(recv_channels_mu_);
+
   // graph_mgr keeps track of the registered graphs of this session.
   //
   // Note: graph_mgr must be deleted before rendezvous_mgr!
@@ -2321,6 +2321,37 @@ Status BroadcastBinaryOpOutputShapeFnHelper(InferenceContext* c,
   const int32_t rank_y = c->Rank(shape_y);
   const int32_t rank_out = std::max(rank_x, rank_y);
 
+  // Fast paths for the overwhelmingly common cases, which avoid materializing
+  // a fresh shape: a scalar operand broadcasts to the other operand's shape,
+  // and identically shaped operands broadcast to themselves. These cover most
+  // elementwise ops in real graphs (tensor op tensor of the same shape, and
+  // tensor op constant scalar).
+  if (rank_x == 0) {
+    *out = shape_y;
+    return OkStatus();
+  }
+  if (rank_y == 0) {
+    *out = shape_x;
+    return OkStatus();
+  }
+  if (rank_x == rank_y) {
+    bool shapes_equal = true;
+    for (int i = 0; i < rank_x; ++i) {
+      DimensionHandle dim_x = c->Dim(shape_x, i);
+      DimensionHandle dim_y = c->Dim(shape_y, i);
+      if (dim_x.SameHandle(dim_y)) continue;
+      if (!c->ValueKnown(dim_x) || !c->ValueKnown(dim_y) ||
+          c->Value(dim_x) != c->Value(dim_y)) {
+        shapes_equal = false;
+        break;
+      }
+    }
+    if (shapes_equal) {
+      *out = shape_x;
+      return OkStatus();
+    }
+  }
+
   // To compute the broadcast dimensions, we zip together shape_x and shape_y
   // and
   // pad with 1 to make them the same length.
@@ -3047,6 +3047,13 @@ bool Model::UpsizeBuffers(std::shared_ptr<Node> snapshot, int64_t ram_budget) {
   // Compute available memory.
   double available_ram_bytes =
       static_cast<double>(ram_budget) - TotalMaximumBufferedBytes(snapshot);
+  if (available_ram_bytes <= 0) {
+    // The pipeline is already at or over its memory budget. Without this
+    // check, buffers whose cost cannot be estimated yet (no elements
+    // buffered) would still be doubled below, growing the model without
+    // bound under memory pressure.
+    return false;
+  }
 
   // Compute the max memory used by all buffers that should be upsized.
   double max_buffered_bytes = 0;
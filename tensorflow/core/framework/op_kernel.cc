@@ -26,6 +26,7 @@ limitations under the License.
 
 #include "absl/base/call_once.h"
 #include "absl/container/flat_hash_set.h"
+#include "absl/memory/memory.h"
 #include "absl/strings/match.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
@@ -339,10 +340,44 @@ OpKernelContext::OpKernelContext(Params* params)
     : OpKernelContext(
           params, static_cast<int>(params->op_kernel->output_types().size())) {}
 
+std::vector<std::unique_ptr<OpKernelContext::TrackingState>>*
+OpKernelContext::GetTrackingStatePool() {
+  static thread_local std::vector<std::unique_ptr<TrackingState>> pool;
+  return &pool;
+}
+
+std::unique_ptr<OpKernelContext::TrackingState>
+OpKernelContext::AcquireTrackingState() {
+  auto* pool = GetTrackingStatePool();
+  if (pool->empty()) {
+    return std::make_unique<TrackingState>();
+  }
+  std::unique_ptr<TrackingState> state = std::move(pool->back());
+  pool->pop_back();
+  return state;
+}
+
+void OpKernelContext::ReleaseTrackingState(std::unique_ptr<TrackingState> state)
+    TF_NO_THREAD_SAFETY_ANALYSIS {
+  static constexpr size_t kMaxPooledTrackingStates = 16;
+  auto* pool = GetTrackingStatePool();
+  if (pool->size() >= kMaxPooledTrackingStates) {
+    return;
+  }
+  // No other thread can reference the state once the owning context is being
+  // destroyed, so the guarded fields can be reset without taking the mutexes.
+  state->wrapped_allocators.clear();
+  state->temp_memory_allocated = 0;
+  state->persistent_memory_allocated = 0;
+  state->temp_tensor_buffer_and_size.clear();
+  state->persistent_alloc_ids.clear();
+  pool->push_back(std::move(state));
+}
+
 OpKernelContext::OpKernelContext(Params* params, int num_outputs)
     : params_(params), outputs_(num_outputs) {
   if (params_->track_allocations) {
-    tracking_state_ = std::make_unique<TrackingState>();
+    tracking_state_ = AcquireTrackingState();
   }
 
   params_->ensure_eigen_gpu_device();
@@ -371,6 +406,9 @@ OpKernelContext::~OpKernelContext() {
       wrapped_allocator.second->GetRecordsAndUnRef();
     }
   }
+  if (tracking_state_) {
+    ReleaseTrackingState(std::move(tracking_state_));
+  }
 }
 
 Allocator* OpKernelContext::get_allocator(AllocatorAttributes attr) {
@@ -1148,11 +1186,25 @@ struct KernelRegistration {
   std::unique_ptr<kernel_factory::OpKernelFactory> factory;
 };
 
+// A registration record as captured by a REGISTER_KERNEL_BUILDER static
+// initializer, before it has been indexed for lookup.  Keeping static
+// initialization down to appending one of these (no proto copy, no key
+// construction, no hashing) keeps process startup cheap for binaries with
+// many linked-in kernels; see IndexPendingRegistrations below.
+struct PendingKernelRegistration {
+  std::unique_ptr<const KernelDef> def;
+  string kernel_class_name;
+  std::unique_ptr<kernel_factory::OpKernelFactory> factory;
+};
+
 // This maps from 'op_type' + DeviceType to the set of KernelDefs and
 // factory functions for instantiating the OpKernel that matches the
 // KernelDef.
 struct KernelRegistry {
   mutex mu;
+  // Records appended by static initializers; folded into `registry` on first
+  // lookup by IndexPendingRegistrations.
+  std::vector<PendingKernelRegistration> pending TF_GUARDED_BY(mu);
   std::unordered_multimap<string, KernelRegistration> registry
       TF_GUARDED_BY(mu);
 };
@@ -1314,11 +1366,36 @@ void* GlobalKernelRegistry() {
   return global_kernel_registry;
 }
 
+// Indexes any registration records accumulated by static initializers since
+// the last lookup.  Registration at static-initialization time only appends
+// records, so a process pays the key construction, KernelDef copy and hash
+// insertion costs on the first registry lookup rather than at startup; a
+// binary that never constructs a kernel never builds the index at all.
+static void IndexPendingRegistrations(KernelRegistry* registry) {
+  mutex_lock l(registry->mu);
+  if (registry->pending.empty()) return;
+  registry->registry.reserve(registry->registry.size() +
+                             registry->pending.size());
+  for (PendingKernelRegistration& pending : registry->pending) {
+    string key = Key(pending.def->op(), DeviceType(pending.def->device_type()),
+                     pending.def->label());
+    registry->registry.emplace(
+        std::move(key),
+        KernelRegistration(*pending.def, pending.kernel_class_name,
+                           std::move(pending.factory)));
+  }
+  registry->pending.clear();
+  registry->pending.shrink_to_fit();
+}
+
 static KernelRegistry* GlobalKernelRegistryTyped() {
 #ifdef AUTOLOAD_DYNAMIC_KERNELS
   LoadDynamicKernels();
 #endif  // AUTOLOAD_DYNAMIC_KERNELS
   auto* registry = reinterpret_cast<KernelRegistry*>(GlobalKernelRegistry());
+  // Index records from static registration (and from any kernel libraries
+  // just loaded above) before callers read the registry.
+  IndexPendingRegistrations(registry);
   // Update or disable JIT kernels based on user configuration. This is a
   // temporary fallback as part of the initial release of JIT kernels.
   static absl::once_flag setup_or_disable_jit;
@@ -1331,10 +1408,6 @@ namespace kernel_factory {
 void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
                                      StringPiece kernel_class_name,
                                      std::unique_ptr<OpKernelFactory> factory) {
-  const string key =
-      Key(kernel_def->op(), DeviceType(kernel_def->device_type()),
-          kernel_def->label());
-
   // To avoid calling LoadDynamicKernels DO NOT CALL GlobalKernelRegistryTyped
   // here.
   // InitInternal gets called by static initializers, so it ends up executing
@@ -1342,13 +1415,18 @@ void OpKernelRegistrar::InitInternal(const KernelDef* kernel_def,
   // before some file libraries can initialize, which in turn crashes the
   // program flakily. Until we get rid of static initializers in kernel
   // registration mechanism, we have this workaround here.
+  //
+  // Only record the registration here; the lookup index is built lazily by
+  // IndexPendingRegistrations so that startup does no per-kernel work beyond
+  // this append.
   auto global_registry =
       reinterpret_cast<KernelRegistry*>(GlobalKernelRegistry());
   mutex_lock l(global_registry->mu);
-  global_registry->registry.emplace(
-      key,
-      KernelRegistration(*kernel_def, kernel_class_name, std::move(factory)));
-  delete kernel_def;
+  PendingKernelRegistration pending;
+  pending.def = absl::WrapUnique(kernel_def);
+  pending.kernel_class_name = string(kernel_class_name);
+  pending.factory = std::move(factory);
+  global_registry->pending.push_back(std::move(pending));
 }
 
 OpKernel* OpKernelRegistrar::PtrOpKernelFactory::Create(
@@ -1324,6 +1324,14 @@ class OpKernelContext {
   };
   std::unique_ptr<TrackingState> tracking_state_;
 
+  // When allocation tracking is enabled (e.g. while collecting step stats),
+  // every node execution needs a fresh TrackingState, which at tens of
+  // thousands of nodes per step is pure allocator churn.  TrackingStates are
+  // therefore recycled through a small per-thread pool.
+  static std::vector<std::unique_ptr<TrackingState>>* GetTrackingStatePool();
+  static std::unique_ptr<TrackingState> AcquireTrackingState();
+  static void ReleaseTrackingState(std::unique_ptr<TrackingState> state);
+
   // For access to `params_->op_kernel`.
   friend void CheckNotInComputeAsync(OpKernelContext* ctx,
                                      const char* correct_macro_name);
@@ -70,12 +70,17 @@ class RendezvousInterface {
 
     ParsedKey& operator=(const ParsedKey& b);
     StringPiece FullKey() const { return buf_; }
+    // Hash of FullKey(), computed once by ParseKey so that rendezvous
+    // implementations keyed by the hash do not have to rehash the key on
+    // every Send/Recv.
+    uint64 FullKeyHash() const { return hash_; }
 
    private:
     friend class Rendezvous;
     friend class SendOp;
     friend class RecvOp;
     std::string buf_;
+    uint64 hash_ = 0;
   };
 
   // The caller is a tensor producer and it sends a message (a tensor
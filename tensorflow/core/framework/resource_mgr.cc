@@ -79,6 +79,7 @@ Status ValidateDevice(OpKernelContext* ctx, const ResourceHandle& p) {
 
 Status ResourceMgr::InsertDebugTypeName(uint64 hash_code,
                                         const string& type_name) {
+  mutex_lock l(debug_type_names_mu_);
   auto iter = debug_type_names_.emplace(hash_code, type_name);
   if (iter.first->second != type_name) {
     return errors::AlreadyExists("Duplicate hash code found for type ",
@@ -88,6 +89,7 @@ Status ResourceMgr::InsertDebugTypeName(uint64 hash_code,
 }
 
 const char* ResourceMgr::DebugTypeName(uint64 hash_code) const {
+  mutex_lock l(debug_type_names_mu_);
   auto type_name_iter = debug_type_names_.find(hash_code);
   if (type_name_iter == debug_type_names_.end()) {
     return "<unknown>";
@@ -138,45 +140,37 @@ ResourceMgr::ResourceMgr(const string& default_container)
 ResourceMgr::~ResourceMgr() { Clear(); }
 
 void ResourceMgr::Clear() {
-  // We do the deallocation outside of the lock to avoid a potential deadlock
+  // We do the deallocation outside of the locks to avoid a potential deadlock
   // in case any of the destructors access the resource manager.
-  absl::flat_hash_map<string, Container*> tmp_containers;
-  {
-    mutex_lock l(mu_);
-    tmp_containers = std::move(containers_);
-    containers_.clear();  // reinitialize after move.
+  std::vector<Container*> tmp_containers;
+  for (Shard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& p : shard.containers) {
+      tmp_containers.push_back(p.second);
+    }
+    shard.containers.clear();
   }
-  for (const auto& p : tmp_containers) {
-    delete p.second;
+  for (Container* container : tmp_containers) {
+    delete container;
   }
 }
 
 string ResourceMgr::DebugString() const {
-  mutex_lock l(mu_);
-  struct Line {
-    const string* container;
-    const string type;
-    const string* resource;
-    const string detail;
-  };
-  std::vector<Line> lines;
-  for (const auto& p : containers_) {
-    const string& container = p.first;
-    for (const auto& q : *p.second) {
-      const Key& key = q.first;
-      const char* type = DebugTypeName(key.first);
-      const core::RefCountPtr<ResourceBase> resource = q.second.GetResource();
-      Line l{&container, port::Demangle(type), q.second.name.get(),
-             resource ? resource->DebugString() : "<nullptr>"};
-      lines.push_back(l);
-    }
-  }
   std::vector<string> text;
-  text.reserve(lines.size());
-  for (const Line& line : lines) {
-    text.push_back(strings::Printf(
-        "%-20s | %-40s | %-40s | %-s", line.container->c_str(),
-        line.type.c_str(), line.resource->c_str(), line.detail.c_str()));
+  for (const Shard& shard : shards_) {
+    mutex_lock l(shard.mu);
+    for (const auto& p : shard.containers) {
+      const string& container = p.first;
+      for (const auto& q : *p.second) {
+        const Key& key = q.first;
+        const char* type = DebugTypeName(key.first);
+        const core::RefCountPtr<ResourceBase> resource = q.second.GetResource();
+        text.push_back(strings::Printf(
+            "%-20s | %-40s | %-40s | %-s", container.c_str(),
+            port::Demangle(type).c_str(), q.second.name->c_str(),
+            resource ? resource->DebugString().c_str() : "<nullptr>"));
+      }
+    }
   }
   std::sort(text.begin(), text.end());
   return absl::StrJoin(text, "\n");
@@ -184,9 +178,10 @@ string ResourceMgr::DebugString() const {
 
 Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
                              const string& name, ResourceBase* resource,
-                             bool owns_resource) {
-  Container* container = [&]() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    Container** ptr = &containers_[container_name];
+                             bool owns_resource) TF_NO_THREAD_SAFETY_ANALYSIS {
+  Shard& s = shard(container_name);
+  Container* container = [&]() {
+    Container** ptr = &s.containers[container_name];
     if (*ptr == nullptr) {
       *ptr = new Container;
     }
@@ -202,8 +197,8 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
   if (owns_resource) {
     resource_and_name.resource = core::RefCountPtr<ResourceBase>(resource);
   } else {
-    auto cleanup_fn = [this, container, type, borrowed_name]() {
-      mutex_lock l(mu_);
+    auto cleanup_fn = [shard = &s, container, type, borrowed_name]() {
+      mutex_lock l(shard->mu);
       auto iter = container->find({type.hash_code(), borrowed_name});
       if (iter != container->end()) {
         container->erase(iter);
@@ -227,7 +222,7 @@ Status ResourceMgr::DoCreate(const string& container_name, TypeIndex type,
 
 Status ResourceMgr::Lookup(const ResourceHandle& handle,
                            ResourceBase** resource) const {
-  tf_shared_lock l(mu_);
+  tf_shared_lock l(shard(handle.container()).mu);
   return DoLookup(handle.container(), handle.hash_code(),
                   /*type_name=*/"ResourceBase", handle.name(), resource);
 }
@@ -241,8 +236,10 @@ Status ResourceMgr::DoLookup(const string& container, TypeIndex type,
 Status ResourceMgr::DoLookup(const string& container, uint64 type_hash_code,
                              const string& type_name,
                              const string& resource_name,
-                             ResourceBase** resource) const {
-  const Container* b = gtl::FindPtrOrNull(containers_, container);
+                             ResourceBase** resource) const
+    TF_NO_THREAD_SAFETY_ANALYSIS {
+  const Container* b = gtl::FindPtrOrNull(shard(container).containers,
+                                          container);
   if (b == nullptr) {
     return errors::NotFound("Container ", container,
                             " does not exist. (Could not find resource: ",
@@ -267,8 +264,9 @@ Status ResourceMgr::PopResourceAndName(const string& container,
                                        const string& resource_name,
                                        const string& type_name,
                                        ResourceAndName& resource_and_name) {
-  mutex_lock l(mu_);
-  Container* b = gtl::FindPtrOrNull(containers_, container);
+  Shard& s = shard(container);
+  mutex_lock l(s.mu);
+  Container* b = gtl::FindPtrOrNull(s.containers, container);
   if (b == nullptr) {
     return errors::NotFound("Container ", container, " does not exist.");
   }
@@ -311,23 +309,24 @@ Status ResourceMgr::Delete(const ResourceHandle& handle) {
 }
 
 Status ResourceMgr::Cleanup(const string& container) {
+  Shard& s = shard(container);
   {
-    tf_shared_lock l(mu_);
-    if (!gtl::FindOrNull(containers_, container)) {
+    tf_shared_lock l(s.mu);
+    if (!gtl::FindOrNull(s.containers, container)) {
       // Nothing to cleanup.
       return OkStatus();
     }
   }
   Container* b = nullptr;
   {
-    mutex_lock l(mu_);
-    auto iter = containers_.find(container);
-    if (iter == containers_.end()) {
+    mutex_lock l(s.mu);
+    auto iter = s.containers.find(container);
+    if (iter == s.containers.end()) {
       // Nothing to cleanup, it's OK (concurrent cleanup).
       return OkStatus();
     }
     b = iter->second;
-    containers_.erase(iter);
+    s.containers.erase(iter);
   }
   CHECK(b != nullptr);
   delete b;
@@ -87,16 +87,13 @@ class ScopedStepContainer {
   // prefix: optional string prefix to disambiguate step containers.
   ScopedStepContainer(const int64_t step_id,
                       std::function<void(const string&)> cleanup)
-      : step_id_(step_id),
-        container_(strings::StrCat("__per_step_", step_id)),
-        cleanup_(cleanup),
-        dirty_(false) {}
+      : step_id_(step_id), cleanup_(cleanup), dirty_(false) {}
 
   ScopedStepContainer(const int64_t step_id,
                       std::function<void(const string&)> cleanup,
                       const std::string& prefix)
       : step_id_(step_id),
-        container_(strings::StrCat("__", prefix, "_per_step_", step_id)),
+        prefix_(prefix),
         cleanup_(cleanup),
         dirty_(false) {}
 
@@ -107,7 +104,7 @@ class ScopedStepContainer {
     // clean.
     if (dirty_) {
       mutex_lock ml(mu_);
-      cleanup_(container_);
+      cleanup_(name());
       dirty_ = false;
     }
   }
@@ -139,8 +136,28 @@ class ScopedStepContainer {
   int64_t StepId() const { return step_id_; }
 
  private:
+  // Returns the container name, building it on first use.  Most steps never
+  // touch their step container, so the name is not materialized until a
+  // resource operation actually needs it.
+  const std::string& name() const {
+    if (!name_initialized_.load(std::memory_order_acquire)) {
+      mutex_lock ml(name_mu_);
+      if (!name_initialized_.load(std::memory_order_relaxed)) {
+        container_ = prefix_.empty()
+                         ? strings::StrCat("__per_step_", step_id_)
+                         : strings::StrCat("__", prefix_, "_per_step_",
+                                           step_id_);
+        name_initialized_.store(true, std::memory_order_release);
+      }
+    }
+    return container_;
+  }
+
   const int64_t step_id_;
-  const std::string container_;
+  const std::string prefix_;
+  mutable std::string container_;
+  mutable mutex name_mu_;
+  mutable std::atomic<bool> name_initialized_{false};
   const std::function<void(const string&)> cleanup_;
   mutex mu_;
   mutable std::atomic<bool> dirty_ TF_GUARDED_BY(mu_);
@@ -195,9 +212,10 @@ class ResourceMgr {
   Status Lookup(const ResourceHandle& handle,
                 ResourceBase** resource) const TF_MUST_USE_RESULT;
 
-  // Similar to Lookup, but looks up multiple resources at once, with only a
-  // single lock acquisition.  If containers_and_names[i] is uninitialized
-  // then this function does not modify resources[i].
+  // Similar to Lookup, but looks up multiple resources at once, taking each
+  // container's shard lock at most once per entry.  If
+  // containers_and_names[i] is uninitialized then this function does not
+  // modify resources[i].
   template <typename T, bool use_dynamic_cast = false>
   Status LookupMany(absl::Span<std::pair<const string*, const string*> const>
                         containers_and_names,
@@ -273,31 +291,47 @@ class ResourceMgr {
   typedef absl::flat_hash_map<Key, ResourceAndName, KeyHash, KeyEqual>
       Container;
 
+  // Containers are partitioned across a fixed number of shards by a hash of
+  // the container name, and each shard is guarded by its own reader/writer
+  // mutex. Operations on a resource only take the lock of the shard owning
+  // its container, so concurrent lookups against different containers do not
+  // contend on a single process-wide lock.
+  static constexpr int kNumShards = 16;
+  struct Shard {
+    mutable mutex mu;
+    absl::flat_hash_map<string, Container*> containers TF_GUARDED_BY(mu);
+  };
+
   const std::string default_container_;
-  mutable mutex mu_;
-  absl::flat_hash_map<string, Container*> containers_ TF_GUARDED_BY(mu_);
+  mutable Shard shards_[kNumShards];
 
+  // Returns the shard owning "container".
+  Shard& shard(const std::string& container) const {
+    return shards_[Hash64(container.data(), container.size()) % kNumShards];
+  }
+
+  // The LookupInternal/DoCreate/DoLookup helpers below require the caller to
+  // hold shard(container).mu (shared for lookups, exclusive for creation);
+  // this cannot be expressed with thread-safety annotations because the lock
+  // is selected dynamically by container name.
   template <typename T, bool use_dynamic_cast = false>
   Status LookupInternal(const std::string& container, const std::string& name,
-                        T** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+                        T** resource) const TF_MUST_USE_RESULT;
   Status LookupInternal(const std::string& container, uint64 type_hash_code,
-                        const std::string& name, ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+                        const std::string& name,
+                        ResourceBase** resource) const TF_MUST_USE_RESULT;
 
   Status DoCreate(const std::string& container, TypeIndex type,
                   const std::string& name, ResourceBase* resource,
-                  bool owns_resource)
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+                  bool owns_resource) TF_MUST_USE_RESULT;
 
   Status DoLookup(const std::string& container, TypeIndex type,
-                  const std::string& name, ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+                  const std::string& name,
+                  ResourceBase** resource) const TF_MUST_USE_RESULT;
   Status DoLookup(const std::string& container, uint64 type_hash_code,
                   const std::string& type_name,
                   const std::string& resource_name,
-                  ResourceBase** resource) const
-      TF_SHARED_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+                  ResourceBase** resource) const TF_MUST_USE_RESULT;
 
   Status DoDelete(const std::string& container, uint64 type_hash_code,
                   const std::string& resource_name,
@@ -313,16 +347,18 @@ class ResourceMgr {
       ResourceAndName& resource_and_name) TF_MUST_USE_RESULT;
   // Inserts the type name for 'hash_code' into the hash_code to type name map.
   Status InsertDebugTypeName(uint64 hash_code, const std::string& type_name)
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) TF_MUST_USE_RESULT;
+      TF_MUST_USE_RESULT;
 
   // Returns the type name for the 'hash_code'.
   // Returns "<unknown>" if a resource with such a type was never inserted into
   // the container.
-  const char* DebugTypeName(uint64 hash_code) const
-      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+  const char* DebugTypeName(uint64 hash_code) const;
 
-  // Map from type hash_code to type name.
-  std::unordered_map<uint64, string> debug_type_names_ TF_GUARDED_BY(mu_);
+  // Map from type hash_code to type name. This map has its own lock so that
+  // it can be consulted while holding any shard lock.
+  mutable mutex debug_type_names_mu_;
+  std::unordered_map<uint64, string> debug_type_names_
+      TF_GUARDED_BY(debug_type_names_mu_);
 
   ResourceMgr(const ResourceMgr&) = delete;
   void operator=(const ResourceMgr&) = delete;
@@ -641,7 +677,7 @@ Status ResourceMgr::Create(const std::string& container,
                            const std::string& name, T* resource) {
   CheckDeriveFromResourceBase<T>();
   CHECK(resource != nullptr);
-  mutex_lock l(mu_);
+  mutex_lock l(shard(container).mu);
   return DoCreate(container, TypeIndex::Make<T>(), name, resource,
                   /* owns_resource */ true);
 }
@@ -650,7 +686,7 @@ template <typename T>
 Status ResourceMgr::CreateUnowned(const std::string& container,
                                   const std::string& name, T* resource) {
   CheckDeriveFromResourceBase<T>();
-  mutex_lock l(mu_);
+  mutex_lock l(shard(container).mu);
   return DoCreate(container, TypeIndex::Make<T>(), name, resource,
                   /* owns_resource */ false);
 }
@@ -659,7 +695,7 @@ template <typename T, bool use_dynamic_cast>
 Status ResourceMgr::Lookup(const std::string& container,
                            const std::string& name, T** resource) const {
   CheckDeriveFromResourceBase<T>();
-  tf_shared_lock l(mu_);
+  tf_shared_lock l(shard(container).mu);
   return LookupInternal<T, use_dynamic_cast>(container, name, resource);
 }
 
@@ -669,10 +705,10 @@ Status ResourceMgr::LookupMany(
         containers_and_names,
     std::vector<core::RefCountPtr<T>>* resources) const {
   CheckDeriveFromResourceBase<T>();
-  tf_shared_lock l(mu_);
   resources->resize(containers_and_names.size());
   for (size_t i = 0; i < containers_and_names.size(); ++i) {
     T* resource;
+    tf_shared_lock l(shard(*containers_and_names[i].first).mu);
     Status s = LookupInternal<T, use_dynamic_cast>(
         *containers_and_names[i].first, *containers_and_names[i].second,
         &resource);
@@ -716,11 +752,11 @@ Status ResourceMgr::LookupOrCreate(const std::string& container,
   *resource = nullptr;
   Status s;
   {
-    tf_shared_lock l(mu_);
+    tf_shared_lock l(shard(container).mu);
     s = LookupInternal<T, use_dynamic_cast>(container, name, resource);
     if (s.ok()) return s;
   }
-  mutex_lock l(mu_);
+  mutex_lock l(shard(container).mu);
   s = LookupInternal<T, use_dynamic_cast>(container, name, resource);
   if (s.ok()) return s;
   TF_RETURN_IF_ERROR(creator(resource));
@@ -989,14 +1025,14 @@ ResourceHandle ScopedStepContainer::MakeResourceHandle(
     const std::string& name, const DeviceBase& device) {
   mutex_lock ml(mu_);
   dirty_ = true;
-  return tensorflow::MakeResourceHandle(container_, name, device,
+  return tensorflow::MakeResourceHandle(this->name(), name, device,
                                         TypeIndex::Make<T>(), {});
 }
 
 template <typename T>
 Status ScopedStepContainer::Lookup(ResourceMgr* rm, const std::string& name,
                                    T** resource) const {
-  return rm->Lookup<T>(container_, name, resource);
+  return rm->Lookup<T>(this->name(), name, resource);
 }
 
 template <typename T>
@@ -1006,7 +1042,7 @@ Status ScopedStepContainer::LookupOrCreate(ResourceMgr* rm,
                                            std::function<Status(T**)> creator) {
   mutex_lock ml(mu_);
   dirty_ = true;
-  return rm->LookupOrCreate<T>(container_, name, resource, creator);
+  return rm->LookupOrCreate<T>(this->name(), name, resource, creator);
 }
 
 template <typename T>
@@ -1014,12 +1050,12 @@ Status ScopedStepContainer::Create(ResourceMgr* rm, const std::string& name,
                                    T* resource) {
   mutex_lock ml(mu_);
   dirty_ = true;
-  return rm->Create<T>(container_, name, resource);
+  return rm->Create<T>(this->name(), name, resource);
 }
 
 template <typename T>
 Status ScopedStepContainer::Delete(ResourceMgr* rm, const std::string& name) {
-  return rm->Delete<T>(container_, name);
+  return rm->Delete<T>(this->name(), name);
 }
 
 }  //  end namespace tensorflow
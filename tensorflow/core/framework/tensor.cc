@@ -97,6 +97,14 @@ class BufferBase : public TensorBuffer {
   explicit BufferBase(Allocator* alloc, void* data_ptr)
       : TensorBuffer(data_ptr), alloc_(alloc) {}
 
+  // A buffer object is heap-allocated for every tensor, including the
+  // scalars and small shape vectors churned out by shape functions.  The
+  // objects are recycled through a small per-thread free list, which removes
+  // a malloc/free pair per tensor; a buffer released on another thread
+  // simply migrates to that thread's pool.
+  static void* operator new(size_t size);
+  static void operator delete(void* ptr, size_t size);
+
   TensorBuffer* root_buffer() override { return this; }
 
   bool GetAllocatedBytes(size_t* out_bytes) const override {
@@ -159,6 +167,73 @@ class Buffer : public BufferBase {
   void operator=(const Buffer&) = delete;
 };
 
+// Per-thread recycling pool backing BufferBase::operator new/delete.  All
+// Buffer<T> instantiations have the same object size, so the pool holds a
+// single size class and anything else falls through to the global heap.
+constexpr size_t kPooledBufferObjectSize = sizeof(Buffer<float>);
+
+// Set once this thread's TensorBufferPool has been destroyed.  A plain bool
+// has no destructor, so it stays valid through TLS teardown; a Buffer
+// released after the pool is gone (e.g. another thread-local destructor
+// dropping its last Tensor reference) must go to the global heap instead of
+// re-entering the destroyed pool.
+thread_local bool tensor_buffer_pool_destroyed = false;
+
+class TensorBufferPool {
+ public:
+  static TensorBufferPool& Get() {
+    static thread_local TensorBufferPool pool;
+    return pool;
+  }
+
+  ~TensorBufferPool() {
+    tensor_buffer_pool_destroyed = true;
+    for (void* ptr : free_list_) ::operator delete(ptr);
+  }
+
+  void* Allocate() {
+    if (free_list_.empty()) {
+      return nullptr;
+    }
+    void* ptr = free_list_.back();
+    free_list_.pop_back();
+    return ptr;
+  }
+
+  // Returns false if the pool is full, in which case the caller should free
+  // 'ptr' itself.
+  bool Release(void* ptr) {
+    if (free_list_.size() >= kMaxPooledBuffers) {
+      return false;
+    }
+    free_list_.push_back(ptr);
+    return true;
+  }
+
+ private:
+  // Bounds the memory a thread's pool can hold on to (64 * ~32 bytes).
+  static constexpr size_t kMaxPooledBuffers = 64;
+
+  std::vector<void*> free_list_;
+};
+
+void* BufferBase::operator new(size_t size) {
+  if (size == kPooledBufferObjectSize && !tensor_buffer_pool_destroyed) {
+    if (void* ptr = TensorBufferPool::Get().Allocate()) {
+      return ptr;
+    }
+  }
+  return ::operator new(size);
+}
+
+void BufferBase::operator delete(void* ptr, size_t size) {
+  if (size == kPooledBufferObjectSize && !tensor_buffer_pool_destroyed &&
+      TensorBufferPool::Get().Release(ptr)) {
+    return;
+  }
+  ::operator delete(ptr);
+}
+
 void LogUnexpectedSize(int64_t actual, int64_t expected) {
   LOG(ERROR) << "Input size was " << actual << " and expected " << expected;
 }
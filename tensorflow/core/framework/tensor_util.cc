@@ -16,12 +16,17 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_util.h"
 
 #include <cmath>
+#include <functional>
 #include <vector>
 
+#include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/type_traits.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/framework/variant.h"
+#include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/core/stringpiece.h"
 #include "tensorflow/core/platform/protobuf.h"
 #include "tensorflow/core/platform/tensor_coding.h"
@@ -30,6 +35,62 @@ limitations under the License.
 namespace tensorflow {
 namespace tensor {
 
+namespace {
+
+// A TensorBuffer backed by caller-owned memory. Invokes the caller's
+// reclamation callback when the last referencing Tensor goes away.
+class UserProvidedTensorBuffer : public TensorBuffer {
+ public:
+  UserProvidedTensorBuffer(void* data, size_t len, std::function<void()> done)
+      : TensorBuffer(data), len_(len), done_(std::move(done)) {}
+
+  ~UserProvidedTensorBuffer() override {
+    if (done_) done_();
+  }
+
+  size_t size() const override { return len_; }
+  TensorBuffer* root_buffer() override { return this; }
+  void FillAllocationDescription(AllocationDescription* proto) const override {
+    proto->set_requested_bytes(len_);
+    proto->set_allocated_bytes(len_);
+  }
+  bool OwnsMemory() const override { return false; }
+
+ private:
+  const size_t len_;
+  std::function<void()> done_;
+};
+
+}  // namespace
+
+Status MakeTensorFromUserBuffer(DataType dtype, const TensorShape& shape,
+                                void* data, size_t len,
+                                std::function<void()> done, Tensor* out) {
+  if (!DataTypeCanUseMemcpy(dtype)) {
+    return errors::InvalidArgument(
+        "Cannot wrap a user buffer as a tensor of non-memcpyable type ",
+        DataTypeString(dtype));
+  }
+  if (reinterpret_cast<uintptr_t>(data) % Allocator::kAllocatorAlignment !=
+      0) {
+    return errors::InvalidArgument(
+        "User buffer must be aligned to ", Allocator::kAllocatorAlignment,
+        " bytes to be wrapped as a tensor without copying");
+  }
+  const size_t expected_len = shape.num_elements() * DataTypeSize(dtype);
+  if (len != expected_len) {
+    return errors::InvalidArgument("User buffer is ", len, " bytes but shape ",
+                                   shape.DebugString(), " with type ",
+                                   DataTypeString(dtype), " requires ",
+                                   expected_len, " bytes");
+  }
+  auto* buf = new UserProvidedTensorBuffer(data, len, std::move(done));
+  *out = Tensor(dtype, shape, buf);
+  // The Tensor constructor takes its own reference on the buffer.
+  buf->Unref();
+  return absl::OkStatus();
+}
+
 Tensor DeepCopy(const Tensor& other) {
   Tensor tmp = Tensor(other.dtype(), other.shape());
   DeepCopy(other, &tmp);
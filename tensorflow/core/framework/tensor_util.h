@@ -17,6 +17,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_FRAMEWORK_TENSOR_UTIL_H_
 
 #include <algorithm>
+#include <functional>
 #include <vector>
 
 #include "tensorflow/core/framework/tensor.h"
@@ -29,6 +30,24 @@ limitations under the License.
 namespace tensorflow {
 namespace tensor {
 
+// Wraps a caller-owned buffer into a Tensor without copying.
+//
+// `data` must remain valid and unmodified until `done` is invoked. `done` is
+// called exactly once, when the last Tensor referencing the buffer is
+// destroyed, and may be used to reclaim or recycle the buffer. This enables a
+// zero-copy feed path: wrapping a (correctly aligned) input batch with this
+// function and passing the resulting Tensor to Session::Run avoids the memcpy
+// that constructing a Tensor from user data would otherwise incur.
+//
+// REQUIRES: `dtype` is a simple type for which DataTypeCanUseMemcpy() is true
+//           (i.e. not tstring, variant or resource).
+// REQUIRES: `data` is aligned to Allocator::kAllocatorAlignment bytes.
+// REQUIRES: `len` == `shape.num_elements() * DataTypeSize(dtype)`.
+Status MakeTensorFromUserBuffer(DataType dtype, const TensorShape& shape,
+                                void* data, size_t len,
+                                std::function<void()> done,
+                                Tensor* out) TF_MUST_USE_RESULT;
+
 // DeepCopy returns a tensor whose contents are a deep copy of the
 // contents of 'other'.  This function is intended only for
 // convenience, not speed.
@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tensorflow/core/graph/graph_partition.h"
 
+#include <algorithm>
 #include <deque>
 #include <memory>
 #include <queue>
@@ -39,6 +40,9 @@ limitations under the License.
 #include "tensorflow/core/graph/node_builder.h"
 #include "tensorflow/core/graph/tensor_id.h"
 #include "tensorflow/core/lib/core/errors.h"
+#include "tensorflow/core/lib/core/threadpool.h"
+#include "tensorflow/core/platform/cpu_info.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/device_name_utils.h"
 #include "tensorflow/core/util/dump_graph.h"
@@ -968,12 +972,26 @@ void SetIncarnation(const PartitionOptions& opts, GraphDef* gdef) {
   }
 }
 
+namespace {
+
+// Bookkeeping for building the body of one partition. Other than the
+// send/recv nodes inserted by the sequential first pass of Partition(), a
+// partition is built from its own nodes only, so the builds are independent
+// of each other and can run concurrently.
+struct PartitionBuild {
+  string name;
+  GraphDef* gdef = nullptr;
+  // The nodes assigned to this partition, in Graph::op_nodes() order.
+  std::vector<Node*> nodes;
+  std::unique_ptr<GraphDebugInfoBuilder> debug_builder;
+  Status status;
+};
+
+}  // namespace
+
 Status Partition(const PartitionOptions& opts, Graph* g,
                  std::unordered_map<string, GraphDef>* partitions) {
-  // TODO(b/290689453) Refactor this into smaller functions
   Status status;
-  absl::flat_hash_map<string, std::unique_ptr<GraphDebugInfoBuilder>>
-      debug_info_builders;
   partitions->clear();
 
   GraphInfo g_info;
@@ -992,7 +1010,48 @@ Status Partition(const PartitionOptions& opts, Graph* g,
   status = BuildMemoryDeviceInfo(*g, &g_info);
   if (!status.ok()) return status;
 
-  string dstp;
+  // Cache the partition of every node; node_to_loc is caller provided and
+  // potentially expensive, and is otherwise evaluated once per node plus once
+  // per edge. This also creates every partition up front, so the map is not
+  // resized while the partition bodies are built in parallel below.
+  std::vector<GraphDef*> node_graph(g->num_node_ids(), nullptr);
+  std::vector<PartitionBuild> builds;
+  {
+    std::unordered_map<string, int> build_index;
+    for (Node* node : g->op_nodes()) {
+      const string loc = opts.node_to_loc(node);
+      auto result = build_index.emplace(loc, builds.size());
+      if (result.second) {
+        builds.emplace_back();
+        builds.back().name = loc;
+        builds.back().gdef = &(*partitions)[loc];
+      }
+      PartitionBuild& build = builds[result.first->second];
+      build.nodes.push_back(node);
+      node_graph[node->id()] = build.gdef;
+    }
+  }
+
+  // Shared edge analysis: remember one representative non-ref data edge for
+  // every (src node, dst partition) pair that requires a transfer. A control
+  // edge between such a pair can then ride on the tensor that is transferred
+  // anyway, instead of introducing a dummy constant with its own send/recv
+  // pair.
+  absl::flat_hash_map<std::pair<int, GraphDef*>, const Edge*> data_transfers;
+  for (const Edge* edge : g->edges()) {
+    if (edge->IsControlEdge()) continue;
+    const Node* src = edge->src();
+    const Node* dst = edge->dst();
+    if (!src->IsOp() || !dst->IsOp()) continue;
+    if (node_graph[src->id()] == node_graph[dst->id()] &&
+        !NeedSameDeviceSendRecv(edge, g_info)) {
+      continue;
+    }
+    if (IsRefType(src->output_type(edge->src_output()))) continue;
+    data_transfers.emplace(std::make_pair(src->id(), node_graph[dst->id()]),
+                           edge);
+  }
+
   std::vector<const Edge*> inputs;
   DupRecvTable dup_recv(3);
   // For a node dst, 'ref_recvs' remembers the recvs introduced by a ref
@@ -1002,49 +1061,22 @@ Status Partition(const PartitionOptions& opts, Graph* g,
   std::vector<NodeDef*> ref_recvs;
   std::vector<string> ref_control_inputs;
 
+  // For every edge that is rewired to a recv, the name of the recv node to
+  // use. Filled by the send/recv pass below and consumed when the partition
+  // bodies are materialized.
+  absl::flat_hash_map<const Edge*, string> edge_to_recv;
+  // Per node, the number of its control-flow control edges that have been
+  // redirected to real recv nodes by the send/recv pass.
+  std::vector<int32_t> redirected_control_flow_edges(g->num_node_ids(), 0);
+
+  // First pass: insert the send/recv pairs (and dummy constants for control
+  // transfers without a data tensor to ride on) for every edge that crosses
+  // a partition boundary. This pass is sequential: it names new nodes and
+  // dedups transfers across all partitions.
   int32_t num_data = 0;
   int32_t num_control = 0;
   for (Node* dst : g->op_nodes()) {
-    dstp = opts.node_to_loc(dst);
-    GraphDef* dst_graph = &(*partitions)[dstp];
-    NodeDef* dst_def = dst_graph->add_node();
-    NodeDebugInfo debug_info(dst->def());
-    if (opts.can_make_destructive_changes && !opts.scheduling_for_recvs) {
-      // TODO(b/327983931): Add static_assert to catch the case where fields are
-      // added to `NodeDef`.
-      *dst_def->mutable_name() =
-          dst->def().name();  // Must be retained for access via `Node::name()`.
-      *dst_def->mutable_op() =
-          dst->def()
-              .op();  // Must be retained for access via `Node::type_string()`.
-      // Do not copy `input` or `device` because these are overwritten below.
-      // After this point, the other fields of `dst->def()` should no longer be
-      // accessed.
-      *dst_def->mutable_attr() = std::move(*dst->mutable_def()->mutable_attr());
-      if (dst->def().has_experimental_debug_info()) {
-        *dst_def->mutable_experimental_debug_info() =
-            std::move(*dst->mutable_def()->mutable_experimental_debug_info());
-      }
-      if (dst->def().has_experimental_type()) {
-        *dst_def->mutable_experimental_type() =
-            std::move(*dst->mutable_def()->mutable_experimental_type());
-      }
-    } else {
-      *dst_def = dst->def();
-    }
-    MergeDebugInfo(debug_info, dst_def);
-    dst_def->set_device(dst->assigned_device_name());
-    dst_def->clear_input();  // Inputs are filled below
-    if (opts.need_to_record_start_times) {
-      int64_t start_time;
-      status = GetNodeAttr(*dst_def, "_start_time", &start_time);
-      if (errors::IsNotFound(status)) {
-        start_time = opts.start_times[dst->id()].value();
-        AddNodeAttr("_start_time", start_time, dst_def);
-      } else if (!status.ok()) {
-        return status;
-      }
-    }
+    GraphDef* dst_graph = node_graph[dst->id()];
 
     // Arrange the incoming edges to dst so that input[i] holds the
     // input flowing into slot numbered i. Trailing entries in input[]
@@ -1054,16 +1086,12 @@ Status Partition(const PartitionOptions& opts, Graph* g,
     ref_recvs.clear();
     ref_control_inputs.clear();
     const Edge* control_flow_edge = nullptr;
-    int32_t num_control_flow_edges = 0;
     int32_t num_input_edges = 0;
     for (const Edge* edge : dst->in_edges()) {
       if (edge->IsControlEdge()) {
         if (IsMerge(edge->src()) && IsControlLoop(edge->src())) {
-          // This is one of the control edges added for control flow. There
-          // can be multiple such edges as the dest node may have multiple
-          // remote inputs. We keep track of the number of such edges.
+          // This is one of the control edges added for control flow.
           control_flow_edge = edge;
-          ++num_control_flow_edges;
         } else {
           inputs.push_back(edge);
         }
@@ -1080,16 +1108,16 @@ Status Partition(const PartitionOptions& opts, Graph* g,
                                      " inputs for ", dst->name());
     }
 
-    // Process in order so that all data edges are added as inputs to
-    // dst in Edge::dst_input() order.
+    // Process in order so that new nodes are named deterministically, and
+    // all data edges are later added as inputs to dst in Edge::dst_input()
+    // order.
     for (const Edge* edge : inputs) {
       const Node* src = edge->src();
       if (!src->IsOp()) continue;  // Skip Sink/Source nodes.
 
-      GraphDef* src_graph = &(*partitions)[opts.node_to_loc(src)];
+      GraphDef* src_graph = node_graph[src->id()];
       if (src_graph == dst_graph && !NeedSameDeviceSendRecv(edge, g_info)) {
         // Same partition and compatible memory types:
-        Graph::AddInput(dst_def, src->name(), edge->src_output());
         if (edge->IsControlEdge() ||
             !IsRefType(src->output_type(edge->src_output()))) {
           ref_control_inputs.push_back(src->name());
@@ -1115,19 +1143,26 @@ Status Partition(const PartitionOptions& opts, Graph* g,
         }
       }
 
+      // A control edge rides on a data tensor that is transferred between
+      // the same (src, dst partition) pair anyway, if there is one.
+      const Edge* transfer_edge = edge;
+      if (edge->IsControlEdge()) {
+        auto data_iter = data_transfers.find({src->id(), dst_graph});
+        if (data_iter != data_transfers.end()) {
+          transfer_edge = data_iter->second;
+        }
+      }
+
       // Check whether there is already a send/recv pair transferring
       // the same tensor/control from the src to dst partition.
-      const bool on_host = IsDstInputOnHost(edge, g_info);
-      DupRecvKey key{src->id(), edge->src_output(), dst_graph, on_host};
+      const bool on_host = IsDstInputOnHost(transfer_edge, g_info);
+      DupRecvKey key{src->id(), transfer_edge->src_output(), dst_graph,
+                     on_host};
       auto iter = dup_recv.find(key);
       if (iter != dup_recv.end()) {
         // We found one. Reuse the data/control transferred already.
         const string& recv_node_name = iter->second.recv->name();
-        if (edge->IsControlEdge()) {
-          Graph::AddInput(dst_def, recv_node_name, Graph::kControlSlot);
-        } else {
-          Graph::AddInput(dst_def, recv_node_name, 0);
-        }
+        edge_to_recv[edge] = recv_node_name;
         ref_control_inputs.push_back(recv_node_name);
 
         // We want the start_time for the recv to be the smallest of the start
@@ -1140,13 +1175,13 @@ Status Partition(const PartitionOptions& opts, Graph* g,
       }
 
       NodeDefBuilder::NodeOut send_from;
-      if (edge->IsControlEdge()) {
+      if (transfer_edge->IsControlEdge()) {
         // Insert a dummy const node that will generate a tiny
         // data element to be sent from send to recv.
         VLOG(1) << "Send/Recv control: " << src->assigned_device_name() << "["
                 << src->name() << "] -> " << dst->assigned_device_name() << "["
                 << dst->name() << "]";
-        NodeDef* dummy = AddDummyConst(opts, src_graph, edge, &status);
+        NodeDef* dummy = AddDummyConst(opts, src_graph, transfer_edge, &status);
         if (!status.ok()) return status;
         // Set the start time for this dummy node.
         if (opts.scheduling_for_recvs) {
@@ -1155,32 +1190,33 @@ Status Partition(const PartitionOptions& opts, Graph* g,
         Graph::AddInput(dummy, src->name(), Graph::kControlSlot);
         send_from.Reset(dummy->name(), 0, DT_FLOAT);
       } else {
-        send_from.Reset(src->name(), edge->src_output(), EdgeType(edge));
+        send_from.Reset(src->name(), transfer_edge->src_output(),
+                        EdgeType(transfer_edge));
       }
 
       string tensor_name_attr;
       if (opts.get_tensor_name_attr) {
-        tensor_name_attr = opts.get_tensor_name_attr(edge);
+        tensor_name_attr = opts.get_tensor_name_attr(transfer_edge);
       } else {
-        tensor_name_attr =
-            strings::StrCat("edge_", edge->id(), "_", edge->src()->name());
+        tensor_name_attr = strings::StrCat("edge_", transfer_edge->id(), "_",
+                                           transfer_edge->src()->name());
       }
 
-      if (VLOG_IS_ON(1) && IsConstant(edge->src())) {
-        LOG(WARNING) << "Send/Recv constant: " << edge->src()->name() << " ["
-                     << edge->src()->assigned_device_name() << "] -> ["
-                     << edge->dst()->assigned_device_name() << "]";
+      if (VLOG_IS_ON(1) && IsConstant(src)) {
+        LOG(WARNING) << "Send/Recv constant: " << src->name() << " ["
+                     << src->assigned_device_name() << "] -> ["
+                     << transfer_edge->dst()->assigned_device_name() << "]";
       }
 
       // Need to split edge by placing matching send/recv nodes on
       // the src/dst sides of the edge.
-      NodeDef* send = AddSend(opts, g_info, src_graph, edge, send_from,
+      NodeDef* send = AddSend(opts, g_info, src_graph, transfer_edge, send_from,
                               send_start_time, tensor_name_attr, &status);
       if (!status.ok()) return status;
 
       NodeDef* real_recv = nullptr;
-      NodeDef* recv = AddRecv(opts, g_info, dst_graph, edge, &real_recv,
-                              tensor_name_attr, &status);
+      NodeDef* recv = AddRecv(opts, g_info, dst_graph, transfer_edge,
+                              &real_recv, tensor_name_attr, &status);
       if (!status.ok()) return status;
 
       // Fix up the control flow edge.
@@ -1193,13 +1229,13 @@ Status Partition(const PartitionOptions& opts, Graph* g,
       } else if (control_flow_edge != nullptr) {
         // Redirect control edge to the real recv since this is not the same
         // device send/recv.
-        --num_control_flow_edges;
+        ++redirected_control_flow_edges[dst->id()];
         Graph::AddInput(real_recv, control_flow_edge->src()->name(),
                         Graph::kControlSlot);
       }
 
-      if (!edge->IsControlEdge() &&
-          IsRefType(src->output_type(edge->src_output()))) {
+      if (!transfer_edge->IsControlEdge() &&
+          IsRefType(src->output_type(transfer_edge->src_output()))) {
         AddNodeAttr("_start_time", recv_start_time, recv);
         if (real_recv != recv) {
           AddNodeAttr("_start_time", recv_start_time, real_recv);
@@ -1215,12 +1251,11 @@ Status Partition(const PartitionOptions& opts, Graph* g,
         ref_control_inputs.push_back(recv->name());
       }
 
+      edge_to_recv[edge] = recv->name();
       if (edge->IsControlEdge()) {
         ++num_control;
-        Graph::AddInput(dst_def, recv->name(), Graph::kControlSlot);
       } else {
         ++num_data;
-        Graph::AddInput(dst_def, recv->name(), 0);
       }
     }
 
@@ -1233,27 +1268,136 @@ Status Partition(const PartitionOptions& opts, Graph* g,
     // NOTE(yuanbyu): This may impact performance because it defers the
     // execution of recvs until all the other inputs become available.
     AddReadControl(ref_recvs, ref_control_inputs);
+  }
 
-    // Add back the control edges for control flow that are not used.
-    if (control_flow_edge != nullptr) {
-      for (int i = 0; i < num_control_flow_edges; ++i) {
-        Graph::AddInput(dst_def, control_flow_edge->src()->name(),
-                        Graph::kControlSlot);
+  // Second pass: materialize the body of every partition. A partition only
+  // writes to its own GraphDef here, so partitions are built in parallel.
+  const auto build_partition = [&opts, &edge_to_recv,
+                                &redirected_control_flow_edges](
+                                   PartitionBuild* build) {
+    GraphDef* dst_graph = build->gdef;
+    std::vector<const Edge*> inputs;
+    for (Node* dst : build->nodes) {
+      NodeDef* dst_def = dst_graph->add_node();
+      NodeDebugInfo debug_info(dst->def());
+      if (opts.can_make_destructive_changes && !opts.scheduling_for_recvs) {
+        // TODO(b/327983931): Add static_assert to catch the case where fields
+        // are added to `NodeDef`.
+        *dst_def->mutable_name() =
+            dst->def()
+                .name();  // Must be retained for access via `Node::name()`.
+        *dst_def->mutable_op() =
+            dst->def()
+                .op();  // Must be retained for access via `Node::type_string()`.
+        // Do not copy `input` or `device` because these are overwritten below.
+        // After this point, the other fields of `dst->def()` should no longer
+        // be accessed.
+        *dst_def->mutable_attr() =
+            std::move(*dst->mutable_def()->mutable_attr());
+        if (dst->def().has_experimental_debug_info()) {
+          *dst_def->mutable_experimental_debug_info() =
+              std::move(*dst->mutable_def()->mutable_experimental_debug_info());
+        }
+        if (dst->def().has_experimental_type()) {
+          *dst_def->mutable_experimental_type() =
+              std::move(*dst->mutable_def()->mutable_experimental_type());
+        }
+      } else {
+        *dst_def = dst->def();
+      }
+      MergeDebugInfo(debug_info, dst_def);
+      dst_def->set_device(dst->assigned_device_name());
+      dst_def->clear_input();  // Inputs are filled below
+      if (opts.need_to_record_start_times) {
+        int64_t start_time;
+        Status s = GetNodeAttr(*dst_def, "_start_time", &start_time);
+        if (errors::IsNotFound(s)) {
+          start_time = opts.start_times[dst->id()].value();
+          AddNodeAttr("_start_time", start_time, dst_def);
+        } else if (!s.ok()) {
+          build->status = s;
+          return;
+        }
+      }
+
+      // Arrange the incoming edges the same way the send/recv pass did:
+      // input[i] holds the input flowing into slot numbered i, trailing
+      // entries hold control edges.
+      inputs.clear();
+      inputs.resize(dst->num_inputs(), nullptr);
+      const Edge* control_flow_edge = nullptr;
+      int32_t num_control_flow_edges = 0;
+      for (const Edge* edge : dst->in_edges()) {
+        if (edge->IsControlEdge()) {
+          if (IsMerge(edge->src()) && IsControlLoop(edge->src())) {
+            // There can be multiple such edges as the dest node may have
+            // multiple remote inputs. We keep track of the number of such
+            // edges.
+            control_flow_edge = edge;
+            ++num_control_flow_edges;
+          } else {
+            inputs.push_back(edge);
+          }
+        } else {
+          inputs[edge->dst_input()] = edge;
+        }
+      }
+
+      // Process in order so that all data edges are added as inputs to
+      // dst in Edge::dst_input() order.
+      for (const Edge* edge : inputs) {
+        const Node* src = edge->src();
+        if (!src->IsOp()) continue;  // Skip Sink/Source nodes.
+
+        auto recv_iter = edge_to_recv.find(edge);
+        if (recv_iter != edge_to_recv.end()) {
+          // The edge crosses to another partition (or incompatible memory on
+          // the same device); feed dst from the recv inserted for it.
+          Graph::AddInput(dst_def, recv_iter->second,
+                          edge->IsControlEdge() ? Graph::kControlSlot : 0);
+        } else {
+          // Same partition and compatible memory types:
+          Graph::AddInput(dst_def, src->name(), edge->src_output());
+        }
       }
-    }
 
-    // For each partition, lazily create a GraphDebugInfoBuilder. Gather stack
-    // traces for the nodes in that partition into the builder.
-    const std::shared_ptr<AbstractStackTrace>& stack_trace =
-        dst->GetStackTrace();
-    if (stack_trace != nullptr) {
-      std::unique_ptr<GraphDebugInfoBuilder>& builder =
-          debug_info_builders[dstp];
-      if (!builder) {
-        builder = std::make_unique<GraphDebugInfoBuilder>();
+      // Add back the control edges for control flow that were not redirected
+      // to recv nodes by the send/recv pass.
+      if (control_flow_edge != nullptr) {
+        const int32_t leftover = num_control_flow_edges -
+                                 redirected_control_flow_edges[dst->id()];
+        for (int32_t i = 0; i < leftover; ++i) {
+          Graph::AddInput(dst_def, control_flow_edge->src()->name(),
+                          Graph::kControlSlot);
+        }
+      }
+
+      // Lazily create a GraphDebugInfoBuilder per partition, and gather the
+      // stack traces for the nodes in that partition into it.
+      const std::shared_ptr<AbstractStackTrace>& stack_trace =
+          dst->GetStackTrace();
+      if (stack_trace != nullptr) {
+        if (!build->debug_builder) {
+          build->debug_builder = std::make_unique<GraphDebugInfoBuilder>();
+        }
+        build->debug_builder->AccumulateStackTrace(stack_trace, dst->name());
       }
-      builder->AccumulateStackTrace(stack_trace, dst->name());
     }
+  };
+
+  if (builds.size() > 1) {
+    thread::ThreadPool pool(
+        Env::Default(), "build_partitions",
+        std::min<int>(builds.size(), port::MaxParallelism()));
+    for (PartitionBuild& build : builds) {
+      pool.Schedule([&build_partition, &build] { build_partition(&build); });
+    }
+    // The pool destructor waits for all partitions to finish.
+  } else if (!builds.empty()) {
+    build_partition(&builds[0]);
+  }
+  for (const PartitionBuild& build : builds) {
+    if (!build.status.ok()) return build.status;
   }
 
   const FunctionLibraryDefinition* flib_def = opts.flib_def;
@@ -1287,11 +1431,9 @@ Status Partition(const PartitionOptions& opts, Graph* g,
           << ", data=" << num_data;
   // For each partition, build the GraphDebugInfo for all of its nodes' stack
   // traces, and add it to the GraphDef for that partition.
-  for (auto& it : *partitions) {
-    const auto& builder_iter = debug_info_builders.find(it.first);
-    if (builder_iter != debug_info_builders.end()) {
-      GraphDef& gdef = it.second;
-      *gdef.mutable_debug_info() = builder_iter->second->Build();
+  for (const PartitionBuild& build : builds) {
+    if (build.debug_builder) {
+      *build.gdef->mutable_debug_info() = build.debug_builder->Build();
     }
   }
   if (VLOG_IS_ON(2)) {
@@ -377,21 +377,40 @@ TEST_F(GraphPartitionTest, CrossDevice_DataControl) {
   string b = "/job:a/replica:0/task:0/cpu:1";
   a1 = FloatInput(scope_a_.WithOpName("A1"));
   _Send(scope_a_.WithOpName("A1/_0"), a1, "edge_1_A1", a, 82, b);
-  auto c =
-      Const(scope_a_.WithOpName("A1/ctrl/_2").WithControlDependencies(a1), {});
-  // NOTE: Send 0 A1/_1 -> A1/_2 is not necessarily needed. We could
-  // use A1/_0 -> A1/_4 as the control as a minor optimization.
-  _Send(scope_a_.WithOpName("A1/_3"), c, "edge_3_A1", a, 82, b);
   ExpectMatchA();
 
-  auto recv1 =
-      _Recv(scope_b_.WithOpName("A1/_4"), DT_FLOAT, "edge_3_A1", a, 82, b);
-  auto id1 = Identity(scope_b_.WithOpName("A1/_5"), recv1);
-  auto recv2 =
+  // The control edge A1 -> B3 rides on the data tensor that is transferred
+  // for B2 anyway, so there is a single send/recv pair.
+  auto recv =
       _Recv(scope_b_.WithOpName("A1/_1"), DT_FLOAT, "edge_1_A1", a, 82, b);
   b1 = FloatInput(scope_b_.WithOpName("B1"));
-  Combine(scope_b_.WithOpName("B2"), recv2, b1);
-  FloatInput(scope_b_.WithOpName("B3").WithControlDependencies(id1));
+  Combine(scope_b_.WithOpName("B2"), recv, b1);
+  FloatInput(scope_b_.WithOpName("B3").WithControlDependencies(recv));
+  ExpectMatchB();
+}
+
+TEST_F(GraphPartitionTest, CrossDevice_ControlThenData) {
+  auto a1 = FloatInput(in_.WithOpName("A1"));
+  auto b1 = FloatInput(in_.WithOpName("B1"));
+  FloatInput(in_.WithOpName("B3").WithControlDependencies(a1));
+  Combine(in_.WithOpName("B2"), a1, b1);
+
+  Partition(ToGraphDef(), &partitions_);
+  EXPECT_EQ(2, partitions_.size());
+
+  string a = "/job:a/replica:0/task:0/cpu:0";
+  string b = "/job:a/replica:0/task:0/cpu:1";
+  a1 = FloatInput(scope_a_.WithOpName("A1"));
+  _Send(scope_a_.WithOpName("A1/_0"), a1, "edge_2_A1", a, 82, b);
+  ExpectMatchA();
+
+  // Same as CrossDevice_DataControl, but with the control consumer processed
+  // before the data consumer: the transfer is still shared.
+  auto recv =
+      _Recv(scope_b_.WithOpName("A1/_1"), DT_FLOAT, "edge_2_A1", a, 82, b);
+  b1 = FloatInput(scope_b_.WithOpName("B1"));
+  FloatInput(scope_b_.WithOpName("B3").WithControlDependencies(recv));
+  Combine(scope_b_.WithOpName("B2"), recv, b1);
   ExpectMatchB();
 }
 
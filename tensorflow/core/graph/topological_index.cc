@@ -0,0 +1,152 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/graph/topological_index.h"
+
+#include <algorithm>
+#include <utility>
+#include <vector>
+
+#include "tensorflow/core/lib/core/errors.h"
+
+namespace tensorflow {
+
+TopologicalIndex::TopologicalIndex(const Graph* graph) : graph_(graph) {
+  position_.resize(graph_->num_node_ids(), -1);
+  visited_.resize(graph_->num_node_ids(), 0);
+  // Iterative DFS over every node, including nodes not reachable from the
+  // graph's source node; reverse post-order is a topological order.
+  std::vector<const Node*> postorder;
+  postorder.reserve(graph_->num_nodes());
+  std::vector<std::pair<const Node*, bool>> stack;
+  ++visit_epoch_;
+  for (const Node* root : graph_->nodes()) {
+    if (visited_[root->id()] == visit_epoch_) continue;
+    stack.emplace_back(root, false);
+    while (!stack.empty()) {
+      const Node* node = stack.back().first;
+      const bool expanded = stack.back().second;
+      stack.pop_back();
+      if (expanded) {
+        postorder.push_back(node);
+        continue;
+      }
+      if (visited_[node->id()] == visit_epoch_) continue;
+      visited_[node->id()] = visit_epoch_;
+      stack.emplace_back(node, true);
+      for (const Edge* edge : node->out_edges()) {
+        if (visited_[edge->dst()->id()] != visit_epoch_) {
+          stack.emplace_back(edge->dst(), false);
+        }
+      }
+    }
+  }
+  for (auto it = postorder.rbegin(); it != postorder.rend(); ++it) {
+    position_[(*it)->id()] = next_position_++;
+  }
+}
+
+void TopologicalIndex::AddNode(const Node* node) {
+  if (node->id() >= static_cast<int>(position_.size())) {
+    position_.resize(node->id() + 1, -1);
+    visited_.resize(node->id() + 1, 0);
+  }
+  position_[node->id()] = next_position_++;
+}
+
+bool TopologicalIndex::CollectRegion(const Node* start, int64_t min_pos,
+                                     int64_t max_pos, bool forward,
+                                     const Node* forbidden,
+                                     std::vector<int>* region) {
+  std::vector<const Node*> stack;
+  stack.push_back(start);
+  visited_[start->id()] = visit_epoch_;
+  while (!stack.empty()) {
+    const Node* node = stack.back();
+    stack.pop_back();
+    region->push_back(node->id());
+    for (const Edge* edge : forward ? node->out_edges() : node->in_edges()) {
+      const Node* next = forward ? edge->dst() : edge->src();
+      if (next == forbidden) return false;
+      const int64_t pos = position_[next->id()];
+      if (pos < min_pos || pos > max_pos) continue;
+      if (visited_[next->id()] == visit_epoch_) continue;
+      visited_[next->id()] = visit_epoch_;
+      stack.push_back(next);
+    }
+  }
+  return true;
+}
+
+Status TopologicalIndex::AddEdge(const Node* src, const Node* dst) {
+  if (src == dst) {
+    return errors::InvalidArgument("Edge from ", src->name(),
+                                   " to itself would create a cycle");
+  }
+  const int64_t src_pos = position_[src->id()];
+  const int64_t dst_pos = position_[dst->id()];
+  if (src_pos < dst_pos) {
+    // The edge already agrees with the order.
+    return OkStatus();
+  }
+
+  // Pearce-Kelly: only nodes with positions in [dst_pos, src_pos] can be
+  // affected.  Nodes reachable forward from dst within the window must move
+  // after nodes reaching src backward within it.
+  ++visit_epoch_;
+  std::vector<int> forward_region;
+  if (!CollectRegion(dst, dst_pos, src_pos, /*forward=*/true, src,
+                     &forward_region)) {
+    return errors::InvalidArgument("Edge from ", src->name(), " to ",
+                                   dst->name(), " would create a cycle");
+  }
+  ++visit_epoch_;
+  std::vector<int> backward_region;
+  CollectRegion(src, dst_pos, src_pos, /*forward=*/false, nullptr,
+                &backward_region);
+
+  // Reuse the union's positions: backward region first, forward region after
+  // it, each keeping its internal relative order.
+  auto by_position = [this](int a, int b) {
+    return position_[a] < position_[b];
+  };
+  std::sort(backward_region.begin(), backward_region.end(), by_position);
+  std::sort(forward_region.begin(), forward_region.end(), by_position);
+
+  std::vector<int64_t> slots;
+  slots.reserve(backward_region.size() + forward_region.size());
+  for (int id : backward_region) slots.push_back(position_[id]);
+  for (int id : forward_region) slots.push_back(position_[id]);
+  std::sort(slots.begin(), slots.end());
+
+  size_t slot = 0;
+  for (int id : backward_region) position_[id] = slots[slot++];
+  for (int id : forward_region) position_[id] = slots[slot++];
+  return OkStatus();
+}
+
+std::vector<Node*> TopologicalIndex::GetOrder() const {
+  std::vector<Node*> order;
+  order.reserve(graph_->num_nodes());
+  for (Node* node : graph_->nodes()) {
+    order.push_back(node);
+  }
+  std::sort(order.begin(), order.end(), [this](const Node* a, const Node* b) {
+    return position_[a->id()] < position_[b->id()];
+  });
+  return order;
+}
+
+}  // namespace tensorflow
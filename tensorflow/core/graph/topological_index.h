@@ -0,0 +1,95 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPH_TOPOLOGICAL_INDEX_H_
+#define TENSORFLOW_CORE_GRAPH_TOPOLOGICAL_INDEX_H_
+
+#include <vector>
+
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status.h"
+
+namespace tensorflow {
+
+// An incrementally maintained topological order over a Graph, for passes that
+// interleave many small edits with order queries.  Recomputing a full order
+// with GetReversePostOrder costs O(V+E) per query; this index instead updates
+// the order in place using the Pearce-Kelly algorithm, touching only the
+// nodes whose relative order an edit could actually change.  Edge and node
+// removals never invalidate a topological order and cost nothing.
+//
+// The index does not observe the Graph; the caller must report mutations:
+//
+//   TopologicalIndex index(graph);
+//   Node* n = graph->AddNode(...);
+//   index.AddNode(n);
+//   graph->AddEdge(src, dst, x, y);
+//   TF_RETURN_IF_ERROR(index.AddEdge(src, dst));  // fails on a cycle
+//   ...
+//   if (index.ComesBefore(a, b)) { ... }
+//
+// AddEdge rejects edges that would create a cycle *without* modifying the
+// order, so the caller can test-and-revert speculative edits cheaply.
+// This class is not thread safe.
+class TopologicalIndex {
+ public:
+  // Builds the initial order in O(V+E).  `graph` must outlive the index and
+  // must be acyclic.
+  explicit TopologicalIndex(const Graph* graph);
+
+  // Registers a node added to the graph after construction.  The node is
+  // placed after all existing nodes, which is correct while it has no edges.
+  void AddNode(const Node* node);
+
+  // Updates the order for a newly added src->dst edge.  Returns an
+  // InvalidArgument error (and leaves the order untouched) if the edge
+  // closes a cycle.  Amortized cost is proportional to the size of the
+  // affected region between dst and src, which is empty for edges that
+  // already agree with the order.
+  Status AddEdge(const Node* src, const Node* dst);
+
+  // Edge and node removals only relax ordering constraints, so the current
+  // order remains valid and there is nothing to report.
+
+  // Returns true iff `a` precedes `b` in the maintained order.
+  bool ComesBefore(const Node* a, const Node* b) const {
+    return position_[a->id()] < position_[b->id()];
+  }
+
+  // Returns the graph's nodes in the maintained topological order.
+  std::vector<Node*> GetOrder() const;
+
+ private:
+  // Collects nodes reachable from `start` along out (forward=true) or in
+  // (forward=false) edges whose positions lie within [min_pos, max_pos].
+  // Returns false if `forbidden` is reached, which signals a cycle.
+  bool CollectRegion(const Node* start, int64_t min_pos, int64_t max_pos,
+                     bool forward, const Node* forbidden,
+                     std::vector<int>* region);
+
+  const Graph* graph_;  // not owned
+  // Node id -> position.  Only relative values matter; positions are unique
+  // among live nodes and ids are never reused by Graph.
+  std::vector<int64_t> position_;
+  int64_t next_position_ = 0;
+  // Scratch marker per node id for CollectRegion, versioned to avoid
+  // clearing between edits.
+  mutable std::vector<uint64_t> visited_;
+  uint64_t visit_epoch_ = 0;
+};
+
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPH_TOPOLOGICAL_INDEX_H_
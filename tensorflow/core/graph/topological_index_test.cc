@@ -0,0 +1,118 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/graph/topological_index.h"
+
+#include <string>
+#include <vector>
+
+#include "tensorflow/core/framework/node_def_builder.h"
+#include "tensorflow/core/framework/op.h"
+#include "tensorflow/core/graph/graph.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/lib/random/simple_philox.h"
+#include "tensorflow/core/lib/strings/strcat.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace {
+
+REGISTER_OP("TopoIndexTestOp");
+
+Node* AddTestNode(Graph* g, const string& name) {
+  NodeDef def;
+  TF_CHECK_OK(NodeDefBuilder(name, "TopoIndexTestOp").Finalize(&def));
+  Status s;
+  Node* n = g->AddNode(def, &s);
+  TF_CHECK_OK(s);
+  return n;
+}
+
+// Checks that the index's order is consistent with every edge in the graph.
+void ExpectValidOrder(const Graph& g, const TopologicalIndex& index) {
+  for (const Edge* e : g.edges()) {
+    EXPECT_TRUE(index.ComesBefore(e->src(), e->dst()))
+        << e->src()->name() << " should precede " << e->dst()->name();
+  }
+}
+
+TEST(TopologicalIndexTest, MaintainsOrderUnderInsertions) {
+  Graph g(OpRegistry::Global());
+  Node* a = AddTestNode(&g, "a");
+  Node* b = AddTestNode(&g, "b");
+  Node* c = AddTestNode(&g, "c");
+  TopologicalIndex index(&g);
+  Node* d = AddTestNode(&g, "d");
+  index.AddNode(d);
+
+  // Add edges that contradict whatever initial order was chosen, forcing
+  // reorders: d -> c -> b -> a.
+  g.AddControlEdge(d, c);
+  TF_ASSERT_OK(index.AddEdge(d, c));
+  g.AddControlEdge(c, b);
+  TF_ASSERT_OK(index.AddEdge(c, b));
+  g.AddControlEdge(b, a);
+  TF_ASSERT_OK(index.AddEdge(b, a));
+
+  ExpectValidOrder(g, index);
+  EXPECT_TRUE(index.ComesBefore(d, a));
+  std::vector<Node*> order = index.GetOrder();
+  ASSERT_EQ(order.size(), g.num_nodes());
+}
+
+TEST(TopologicalIndexTest, DetectsCycle) {
+  Graph g(OpRegistry::Global());
+  Node* a = AddTestNode(&g, "a");
+  Node* b = AddTestNode(&g, "b");
+  Node* c = AddTestNode(&g, "c");
+  TopologicalIndex index(&g);
+
+  g.AddControlEdge(a, b);
+  TF_ASSERT_OK(index.AddEdge(a, b));
+  g.AddControlEdge(b, c);
+  TF_ASSERT_OK(index.AddEdge(b, c));
+
+  EXPECT_FALSE(index.AddEdge(c, a).ok());
+  EXPECT_FALSE(index.AddEdge(a, a).ok());
+  // A rejected edge leaves the order untouched.
+  ExpectValidOrder(g, index);
+}
+
+TEST(TopologicalIndexTest, RandomInsertionsStayConsistent) {
+  Graph g(OpRegistry::Global());
+  constexpr int kNumNodes = 200;
+  std::vector<Node*> nodes;
+  nodes.reserve(kNumNodes);
+  for (int i = 0; i < kNumNodes; ++i) {
+    nodes.push_back(AddTestNode(&g, strings::StrCat("n", i)));
+  }
+  TopologicalIndex index(&g);
+
+  // Add random edges consistent with a hidden order (reversed creation
+  // order, so nearly every insertion forces a reorder).
+  random::PhiloxRandom philox(301, 17);
+  random::SimplePhilox rnd(&philox);
+  for (int i = 0; i < 1000; ++i) {
+    const int src = rnd.Uniform(kNumNodes);
+    const int dst = rnd.Uniform(kNumNodes);
+    if (src <= dst) continue;
+    g.AddControlEdge(nodes[src], nodes[dst]);
+    TF_ASSERT_OK(index.AddEdge(nodes[src], nodes[dst]));
+  }
+  ExpectValidOrder(g, index);
+}
+
+}  // namespace
+}  // namespace tensorflow
@@ -649,7 +649,7 @@ class SymbolicShapeRefiner {
       const GraphView& graph,
       const absl::flat_hash_map<string, absl::flat_hash_set<int>>& fed_ports,
       const bool aggressive_shape_inference)
-      : graph_(graph),
+      : graph_(&graph),
         function_library_(OpRegistry::Global(), graph.graph()->library()),
         fed_ports_(fed_ports),
         aggressive_shape_inference_(aggressive_shape_inference) {
@@ -657,7 +657,22 @@ class SymbolicShapeRefiner {
     node_to_context_.reserve(graph.graph()->node_size());
   }
 
-  const GraphView& graph() const { return graph_; }
+  const GraphView& graph() const { return *graph_; }
+
+  // Re-points the refiner at a graph view rebuilt after an in-place mutation
+  // of the underlying graph, and forgets the contexts of the dirty nodes so
+  // that their next update re-reads op, inputs and attributes. Contexts of
+  // untouched nodes, and the shapes already inferred for them, are preserved.
+  // The graph's function library must not have changed: the refiner keeps its
+  // instantiations from construction time.
+  void SwapGraphView(const GraphView& graph,
+                     const std::vector<const NodeDef*>& dirty_nodes) {
+    graph_ = &graph;
+    graph_def_version_ = graph.graph()->versions().producer();
+    for (const NodeDef* node : dirty_nodes) {
+      node_to_context_.erase(node);
+    }
+  }
 
   struct NodeContext {
     const OpRegistrationData* op_data;
@@ -828,7 +843,7 @@ class SymbolicShapeRefiner {
             "Function inputs should not contain control nodes.");
       }
 
-      const NodeDef* input_node = graph_.GetNode(input_tensor.node());
+      const NodeDef* input_node = graph_->GetNode(input_tensor.node());
       if (input_node == nullptr) {
         return errors::FailedPrecondition(input_tensor.node(),
                                           " was not found in the graph.");
@@ -901,7 +916,7 @@ class SymbolicShapeRefiner {
     for (int i = grappler_function_item.inputs().size() - 1; i >= 0; --i) {
       const string& input = function_node->input(i);
       const string node_name = NodeName(input);
-      const NodeDef* input_node = graph_.GetNode(node_name);
+      const NodeDef* input_node = graph_->GetNode(node_name);
       if (IsConstant(*input_node)) {
         TF_CHECK_OK(
             ReplaceInputWithConst(*input_node, i, &grappler_function_item));
@@ -1004,7 +1019,7 @@ class SymbolicShapeRefiner {
 
     for (int dst_input = 0; dst_input < ic->num_inputs(); ++dst_input) {
       const GraphView::InputPort port(node, dst_input);
-      const GraphView::OutputPort fanin = graph_.GetRegularFanin(port);
+      const GraphView::OutputPort fanin = graph_->GetRegularFanin(port);
       int src_output = fanin.port_id;
       const NodeDef* src = fanin.node;
       NodeContext* src_ctx = GetNodeContext(src);
@@ -2042,7 +2057,7 @@ class SymbolicShapeRefiner {
     return false;
   }
 
-  const GraphView& graph_;
+  const GraphView* graph_;  // Not owned; see SwapGraphView().
   int graph_def_version_;
   absl::flat_hash_map<const NodeDef*, NodeContext> node_to_context_;
   absl::flat_hash_map<ShapeId, ShapeHandle> unknown_shapes_;
@@ -2514,21 +2529,44 @@ Status GraphProperties::UpdateEnqueue(
   return absl::OkStatus();
 }
 
+GraphProperties::~GraphProperties() {}
+
 Status GraphProperties::InferStatically(bool assume_valid_feeds,
                                         bool aggressive_shape_inference,
                                         bool include_input_tensor_values,
                                         bool include_output_tensor_values) {
-  FunctionLibraryDefinition function_library(OpRegistry::Global(),
-                                             item_.graph.library());
-  absl::flat_hash_map<string, absl::flat_hash_set<int>> fed_ports;
+  shape_refiner_.reset();
+  graph_view_.reset();
+  aggressive_shape_inference_ = aggressive_shape_inference;
+  include_input_tensor_values_ = include_input_tensor_values;
+  include_output_tensor_values_ = include_output_tensor_values;
+  fed_ports_.clear();
   if (!assume_valid_feeds) {
     for (const auto& feed : item_.feed) {
       SafeTensorId tensor_id = ParseTensorName(feed.first);
-      fed_ports[tensor_id.node()].insert(tensor_id.index());
+      fed_ports_[tensor_id.node()].insert(tensor_id.index());
     }
   }
+  return RunShapeInference(/*dirty_nodes=*/nullptr);
+}
+
+Status GraphProperties::UpdateStatically(const std::vector<string>& dirty_nodes) {
+  if (shape_refiner_ == nullptr) {
+    return errors::FailedPrecondition(
+        "UpdateStatically requires a previous successful InferStatically "
+        "call.");
+  }
+  return RunShapeInference(&dirty_nodes);
+}
 
-  GraphView graph_view(&item_.graph);
+Status GraphProperties::RunShapeInference(
+    const std::vector<string>* dirty_nodes) {
+  FunctionLibraryDefinition function_library(OpRegistry::Global(),
+                                             item_.graph.library());
+  // Graph mutations invalidate the fanout maps, so the view is rebuilt on
+  // every inference; it is cheap compared to running the shape functions.
+  graph_view_ = std::make_unique<GraphView>(&item_.graph);
+  GraphView& graph_view = *graph_view_;
 
   // List the resources and the nodes using them. Also collect the Merge nodes,
   // fed nodes, and primary inputs.
@@ -2570,7 +2608,7 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
     } else if (IsNextIteration(node)) {
       ++num_loops;
     }
-    if (fed_ports.find(node.name()) != fed_ports.end()) {
+    if (fed_ports_.find(node.name()) != fed_ports_.end()) {
       fed_nodes.insert(&node);
     }
   }
@@ -2602,23 +2640,46 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
     }
   }
 
-  // Heap-allocate SymbolicShapeRefiner in order to not consume a large amount
-  // of stack space.
-  auto refiner = std::make_unique<SymbolicShapeRefiner>(
-      graph_view, fed_ports, aggressive_shape_inference);
+  if (dirty_nodes == nullptr) {
+    // Heap-allocate SymbolicShapeRefiner in order to not consume a large
+    // amount of stack space.
+    shape_refiner_ = std::make_unique<SymbolicShapeRefiner>(
+        graph_view, fed_ports_, aggressive_shape_inference_);
+  } else {
+    // Keep the contexts inferred by the previous run and only invalidate the
+    // dirty nodes.
+    std::vector<const NodeDef*> dirty;
+    dirty.reserve(dirty_nodes->size());
+    for (const string& node_name : *dirty_nodes) {
+      const NodeDef* node = graph_view.GetNode(node_name);
+      // Nodes deleted after being dirtied have nothing to re-infer.
+      if (node != nullptr) dirty.push_back(node);
+    }
+    shape_refiner_->SwapGraphView(graph_view, dirty);
+  }
+  SymbolicShapeRefiner* refiner = shape_refiner_.get();
 
   TopoQueue new_shapes(topo_order);
-  // Also seed the propagation of shapes in the fanout of primary inputs.
-  for (const NodeDef* node : primary_inputs) {
-    new_shapes.push(node);
-  }
-  // Also seed the propagation of shapes in the fanout of fed nodes.
-  for (const NodeDef* node : fed_nodes) {
-    new_shapes.push(node);
+  if (dirty_nodes == nullptr) {
+    // Seed the propagation of shapes in the fanout of primary inputs.
+    for (const NodeDef* node : primary_inputs) {
+      new_shapes.push(node);
+    }
+    // Also seed the propagation of shapes in the fanout of fed nodes.
+    for (const NodeDef* node : fed_nodes) {
+      new_shapes.push(node);
+    }
+  } else {
+    // Re-propagation stops as soon as a node's output shapes come out
+    // unchanged, so only the affected cones of the dirty nodes are visited.
+    for (const string& node_name : *dirty_nodes) {
+      const NodeDef* node = graph_view.GetNode(node_name);
+      if (node != nullptr) new_shapes.push(node);
+    }
   }
   // Propagate shapes normally.
   TF_RETURN_IF_ERROR(
-      PropagateShapes(refiner.get(), &new_shapes, resource_handles, num_loops));
+      PropagateShapes(refiner, &new_shapes, resource_handles, num_loops));
 
   // Track shapes globally across the graph.
   std::unique_ptr<SymbolicShapeManager> shape_manager =
@@ -2630,7 +2691,7 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
       continue;
     }
     // Skip any information that comes from fed nodes.
-    if (fed_ports.find(node.name()) != fed_ports.end()) {
+    if (fed_ports_.find(node.name()) != fed_ports_.end()) {
       VLOG(2) << "Skipping feed node shape: " << node.name();
       continue;
     }
@@ -2655,9 +2716,15 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
     }
   }
 
-  TF_RETURN_IF_ERROR(ValidateSymbolicShapeManager(item_.graph, refiner.get(),
+  TF_RETURN_IF_ERROR(ValidateSymbolicShapeManager(item_.graph, refiner,
                                                   shape_manager.get()));
 
+  // Re-runs refill the property maps from scratch: the symbolic shape
+  // manager is rebuilt each time, so properties of untouched nodes can
+  // change representation even though their shapes are unchanged.
+  Clear();
+  incompatible_shape_nodes_.clear();
+
   for (const NodeDef& node : item_.graph.node()) {
     VLOG(4) << "Filling in graph properties for node: " << node.name();
     auto ctx = refiner->GetNodeContext(&node);
@@ -2681,7 +2748,7 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
                                           &input_properties[i]);
         input.port_id = i;
         GraphView::OutputPort fanin = graph_view.GetRegularFanin(input);
-        if (include_input_tensor_values) {
+        if (include_input_tensor_values_) {
           // Export tensor value to input_properties.value.
           if (IsConstant(*fanin.node)) {
             const TensorProto& raw_val =
@@ -2717,7 +2784,7 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
         auto converted_output_tensors_as_shapes =
             ReplaceUnknownDimFromConstWithUnknownDim(
                 ic, ctx->output_tensors_as_shapes);
-        if (include_output_tensor_values) {
+        if (include_output_tensor_values_) {
           // Export tensor value to output_properties.value.
           if (IsConstant(node)) {
             // TODO(rmlarsen): Eliminate this copy.
@@ -2741,11 +2808,11 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
       }
     }
 
-    if (aggressive_shape_inference && ctx->shape_incompatible)
+    if (aggressive_shape_inference_ && ctx->shape_incompatible)
       incompatible_shape_nodes_.insert(node.name());
   }
 
-  if (aggressive_shape_inference && !incompatible_shape_nodes_.empty())
+  if (aggressive_shape_inference_ && !incompatible_shape_nodes_.empty())
     LOG(WARNING) << incompatible_shape_nodes_.size()
                  << " nodes have incompatible output shapes.";
 
@@ -2753,7 +2820,7 @@ Status GraphProperties::InferStatically(bool assume_valid_feeds,
   VerboseLogUnknownDimensionSources(item_.graph, input_properties_,
                                     output_properties_);
 
-  TF_RETURN_IF_ERROR(VerboseShapeInferenceLogging(item_.graph, refiner.get(),
+  TF_RETURN_IF_ERROR(VerboseShapeInferenceLogging(item_.graph, refiner,
                                                   shape_manager.get()));
 
   return absl::OkStatus();
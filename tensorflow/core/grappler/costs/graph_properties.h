@@ -16,11 +16,13 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_GRAPPLER_COSTS_GRAPH_PROPERTIES_H_
 #define TENSORFLOW_CORE_GRAPPLER_COSTS_GRAPH_PROPERTIES_H_
 
+#include <memory>
 #include <unordered_map>
 #include <unordered_set>
 #include <vector>
 
 #include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "tensorflow/core/framework/shape_inference.h"
 #include "tensorflow/core/grappler/clusters/cluster.h"
 #include "tensorflow/core/grappler/costs/op_performance_data.pb.h"
@@ -69,6 +71,7 @@ ABSL_CONST_INIT const char kOutputTypes[] = "_output_dtype_vector";
 // Outputs TensorShapeProto vector.
 ABSL_CONST_INIT const char kOutputShapes[] = "_output_shape_vector";
 
+class GraphView;
 class SymbolicShapeRefiner;
 class TopoQueue;
 
@@ -82,6 +85,7 @@ class GraphProperties {
  public:
   // The item must outlive the properties
   explicit GraphProperties(const GrapplerItem& item) : item_(item) {}
+  ~GraphProperties();
 
   // Infer the shapes through abstract interpretation. Feed information can be
   // incorrect so it should be discarded to ensure correctness of the analysis.
@@ -114,6 +118,16 @@ class GraphProperties {
                            /*aggressive_shape_inference=*/false,
                            /*include_tensor_values=*/true);
   }
+
+  // Incrementally re-infers properties after an in-place mutation of the
+  // item's graph. `dirty_nodes` must name every node that was added or whose
+  // op, inputs or attributes have changed since the last inference; shapes
+  // are then re-propagated only through the dirty nodes' transitive fanout
+  // instead of from every primary input. Reuses the options of the last
+  // InferStatically() call and requires it to have succeeded; returns
+  // FailedPrecondition otherwise. The graph's function library must not have
+  // changed.
+  Status UpdateStatically(const std::vector<string>& dirty_nodes);
   // Infer the shape by running the graph on the specified cluster and recording
   // the shapes of the processed tensors.
   Status InferDynamically(Cluster* cluster);
@@ -200,6 +214,12 @@ class GraphProperties {
           resource_handles,
       int num_loops) const;
 
+  // Shared implementation of InferStatically() and UpdateStatically(). If
+  // `dirty_nodes` is null, runs full inference from the primary inputs with a
+  // fresh refiner; otherwise re-propagates from the dirty nodes through the
+  // refiner retained by the previous run.
+  Status RunShapeInference(const std::vector<string>* dirty_nodes);
+
   // Data members
   const GrapplerItem& item_;
   absl::flat_hash_map<string, std::vector<OpInfo::TensorProperties>>
@@ -211,6 +231,16 @@ class GraphProperties {
   // Nodes with output shape incompatible between shape inference and
   // annotation.
   std::unordered_set<string> incompatible_shape_nodes_;
+
+  // State retained by InferStatically() so that UpdateStatically() can
+  // re-propagate shapes from dirty nodes only. The graph view is rebuilt on
+  // every inference; the refiner keeps its per-node contexts across runs.
+  std::unique_ptr<GraphView> graph_view_;
+  std::unique_ptr<SymbolicShapeRefiner> shape_refiner_;
+  absl::flat_hash_map<string, absl::flat_hash_set<int>> fed_ports_;
+  bool aggressive_shape_inference_ = false;
+  bool include_input_tensor_values_ = true;
+  bool include_output_tensor_values_ = true;
 };
 
 // Helper function for GraphProperties.
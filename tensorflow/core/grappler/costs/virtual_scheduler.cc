@@ -26,6 +26,7 @@ limitations under the License.
 #include "absl/strings/str_replace.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
 #include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
 #include "tensorflow/core/framework/node_def.pb.h"
 #include "tensorflow/core/framework/tensor.pb.h"
 #include "tensorflow/core/framework/tensor_description.pb.h"
@@ -1381,6 +1382,34 @@ int64_t SchedulerState::GetOrCalculateOutputSize(const NodeState& node_state,
   return CalculateOutputSize(node_state.output_properties, port_num);
 }
 
+void SchedulerState::ImportMeasuredCosts(const CostGraphDef& cost_graph) {
+  for (const auto& cost_node : cost_graph.node()) {
+    Costs costs;
+    // CostGraphDef::Node times are in microseconds, Costs::Duration in
+    // nanoseconds.
+    costs.compute_time = Costs::MicroSeconds(cost_node.compute_time());
+    costs.memory_time = Costs::MicroSeconds(cost_node.memory_time());
+    if (cost_node.compute_cost() > 0) {
+      costs.execution_time = Costs::MicroSeconds(cost_node.compute_cost());
+    } else {
+      costs.execution_time = costs.compute_time + costs.memory_time;
+    }
+    costs.temporary_memory = cost_node.temporary_memory_size();
+    costs.persistent_memory = cost_node.persistent_memory_size();
+    // Measured costs are accurate by definition.
+    costs.inaccurate = false;
+    measured_costs_[cost_node.name()] = costs;
+  }
+}
+
+const Costs* SchedulerState::MaybeGetMeasuredCosts(const NodeDef* node) const {
+  auto it = measured_costs_.find(node->name());
+  if (it == measured_costs_.end()) {
+    return nullptr;
+  }
+  return &it->second;
+}
+
 VirtualScheduler::~VirtualScheduler() {}
 
 VirtualScheduler::VirtualScheduler(const bool use_static_shapes,
@@ -1423,8 +1452,11 @@ OpContext VirtualScheduler::GetCurrNode() {
 bool VirtualScheduler::MarkCurrNodeExecuted(const Costs& node_costs) {
   // Update graph_costs_ and per-op costs.
   const NodeDef* node = ready_nodes_->GetCurrNode();
+  // Prefer measured costs over the caller's analytical estimate when a
+  // profile was imported for this node.
+  const Costs* measured_costs = scheduler_state_->MaybeGetMeasuredCosts(node);
   auto new_nodes = scheduler_state_->MarkNodeExecuted(
-      node, node_costs,
+      node, measured_costs != nullptr ? *measured_costs : node_costs,
       scheduler_state_->CreateOpContext(ready_nodes_->GetCurrNode()));
   // Add the set of new nodes obtained from MarkNodeExecuted() to ready_nodes_.
   for (auto node : new_nodes) {
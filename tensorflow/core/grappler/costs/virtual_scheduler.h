@@ -379,6 +379,14 @@ class SchedulerState {
     return &node_map_;
   }
 
+  // Imports measured per-node costs, e.g. a CostGraphDef collected via the
+  // DirectSession cost model. Nodes present in the cost graph are scheduled
+  // with their measured costs instead of the caller's analytical estimate,
+  // which makes downstream optimizers rank rewrites by observed time.
+  void ImportMeasuredCosts(const CostGraphDef& cost_graph);
+  // Returns the measured costs of the node, or nullptr if none were imported.
+  const Costs* MaybeGetMeasuredCosts(const NodeDef* node) const;
+
   virtual OpContext CreateOpContext(const NodeDef* node) const;
   std::vector<const NodeDef*> MarkNodeExecuted(
       const NodeDef* node, const Costs& node_costs, const OpContext& op_context,
@@ -449,6 +457,10 @@ class SchedulerState {
   Costs graph_costs_;                   // Graph cost.
   std::map<string, Costs> op_to_cost_;  // Per-op cost.
 
+  // Measured per-node costs imported with ImportMeasuredCosts(), keyed by
+  // node name.
+  std::unordered_map<string, Costs> measured_costs_;
+
   // Auxiliary data structures for constructing NodeState and DeviceState.
   std::unique_ptr<GraphProperties> graph_properties_;  // Initialized in Init().
   Cluster* cluster_;                                   // Not owned.
@@ -527,6 +539,12 @@ class VirtualScheduler {
   void enable_mem_usage_tracking() {
     scheduler_state_->enable_mem_usage_tracking();
   }
+  // Imports measured per-node costs (e.g. the CostGraphDef collected via
+  // DirectSession cost model tracking). Subsequent MarkCurrNodeExecuted()
+  // calls use the measured costs for nodes present in the cost graph.
+  void ImportMeasuredCosts(const CostGraphDef& cost_graph) {
+    scheduler_state_->ImportMeasuredCosts(cost_graph);
+  }
 
  protected:
   // The state of the scheduler and the execution of the graph is encapsulated
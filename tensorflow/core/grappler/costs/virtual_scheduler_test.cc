@@ -22,6 +22,7 @@ limitations under the License.
 #include "absl/strings/match.h"
 #include "tensorflow/cc/ops/standard_ops.h"
 #include "tensorflow/core/framework/allocation_description.pb.h"
+#include "tensorflow/core/framework/cost_graph.pb.h"
 #include "tensorflow/core/framework/tensor_description.pb.h"
 #include "tensorflow/core/framework/tensor_shape.pb.h"
 #include "tensorflow/core/grappler/clusters/virtual_cluster.h"
@@ -2424,6 +2425,31 @@ TEST_F(VirtualSchedulerTest, SummaryCostTest) {
   EXPECT_EQ(0, c.num_ops_with_unknown_shapes);
 }
 
+// Measured costs imported from a profile should override the analytical
+// estimates for the nodes present in the cost graph.
+TEST_F(VirtualSchedulerTest, SummaryCostMeasuredCostsTest) {
+  CreateGrapplerItemWithMatmulChain();
+  InitScheduler();
+
+  // Pretend a profiler measured each MatMul at 3 seconds.
+  CostGraphDef cost_graph;
+  for (const auto& name : {"ab", "abc", "abcd", "abcde"}) {
+    CostGraphDef::Node* cost_node = cost_graph.add_node();
+    cost_node->set_name(name);
+    cost_node->set_compute_cost(3000000);  // In microseconds.
+  }
+  scheduler_->ImportMeasuredCosts(cost_graph);
+
+  auto ops_executed = RunScheduler("");
+  Costs c = scheduler_->Summary();
+
+  // RandomUniform - 5 * 1s
+  // Matmuls - 4 * 3s (measured)
+  // Misc - 5 * 1us
+  EXPECT_EQ(17000005, c.execution_time.asMicroSeconds().count());
+  EXPECT_FALSE(c.inaccurate);
+}
+
 // Like the above SummaryCostTest, but makes sure the stepstats timeline is
 // correct.
 TEST_F(VirtualSchedulerTest, SummaryCostStepStatsTest) {
@@ -4231,6 +4231,153 @@ class SimplifyEmbeddingLookupStage : public ArithmeticOptimizerStage {
   }
 };
 
+// Fuses a gather feeding a dense segment reduction into a single sparse
+// segment reduction, i.e. rewrites
+//
+//     gathered_rows = tf.gather(params, indices)
+//     result = tf.math.segment_<sum|mean>(gathered_rows, segment_ids)
+//
+// into
+//
+//     result = tf.sparse.segment_<sum|mean>(params, indices, segment_ids)
+//
+// The two forms compute the same value, but the fused form accumulates rows
+// of `params` directly into the per-segment outputs and never materializes
+// the gathered rows, saving a copy of the full minibatch of embeddings.
+class FuseGatherSegmentReductionStage : public ArithmeticOptimizerStage {
+ public:
+  explicit FuseGatherSegmentReductionStage(
+      const GraphOptimizerContext& ctx,
+      const ArithmeticOptimizerContext& ctx_ext)
+      : ArithmeticOptimizerStage("FuseGatherSegmentReductionStage", ctx,
+                                 ctx_ext) {}
+  ~FuseGatherSegmentReductionStage() override = default;
+
+  bool IsSupported(const NodeDef* node) const override {
+    return node->op() == "SegmentSum" || node->op() == "SegmentMean";
+  }
+
+  Status TrySimplify(NodeDef* reduction_node,
+                     string* simplified_node_name) override {
+    if (IsInPreserveSet(*reduction_node)) return absl::OkStatus();
+
+    // The sparse reductions support fewer element types than the dense ones:
+    // SparseSegmentSum has no complex kernels, and SparseSegmentMean is only
+    // registered for floating-point types.
+    const bool is_mean = reduction_node->op() == "SegmentMean";
+    DataType element_type;
+    TF_RETURN_IF_ERROR(GetNodeAttr(*reduction_node, "T", &element_type));
+    if (is_mean) {
+      if (!DataTypeIsFloating(element_type)) return absl::OkStatus();
+    } else {
+      if (!DataTypeIsFloating(element_type) &&
+          !DataTypeIsInteger(element_type))
+        return absl::OkStatus();
+    }
+
+    // Input 0 (data) of the reduction node must be a tf.gather() on the 0th
+    // axis.
+    NodeDef* gather_node = nullptr;
+    TF_RETURN_IF_ERROR(GetInputNode(reduction_node->input(0), &gather_node));
+    if (!IsGather(*gather_node) || IsInPreserveSet(*gather_node) ||
+        gather_node->device() != reduction_node->device())
+      return absl::OkStatus();
+    if (gather_node->op() == "GatherV2" && !IsAxis0(*gather_node, 2))
+      return absl::OkStatus();
+    if (HasNodeAttr(*gather_node, "batch_dims")) {
+      int64_t batch_dims;
+      TF_RETURN_IF_ERROR(GetNodeAttr(*gather_node, "batch_dims", &batch_dims));
+      if (batch_dims != 0) return absl::OkStatus();
+    }
+
+    DataType gather_index_type;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(*gather_node, "Tindices", &gather_index_type));
+    DataType segment_ids_type;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(*reduction_node, "Tindices", &segment_ids_type));
+
+    const string gather_input = reduction_node->input(0);
+    reduction_node->set_op(is_mean ? "SparseSegmentMean" : "SparseSegmentSum");
+    reduction_node->mutable_attr()->erase("Tindices");
+    SetDataTypeToAttr(gather_index_type, "Tidx", reduction_node);
+    SetDataTypeToAttr(segment_ids_type, "Tsegmentids", reduction_node);
+
+    // Insert the gather's indices as input 1 of the reduction node, shifting
+    // segment_ids to input 2 (and any control inputs past it).
+    reduction_node->add_input(gather_node->input(1));
+    for (int i = reduction_node->input_size() - 1; i > 1; --i) {
+      reduction_node->mutable_input()->SwapElements(i, i - 1);
+    }
+    ctx().node_map->AddOutput(NodeName(gather_node->input(1)),
+                              reduction_node->name());
+
+    // Input 0 (data) of the reduction node becomes input 0 (params) of the
+    // gather node.
+    const OpInfo::TensorProperties* gather_input_properties;
+    TF_RETURN_IF_ERROR(
+        GetTensorProperties(gather_node->input(0), &gather_input_properties));
+    if (gather_input_properties->dtype() == DT_RESOURCE) {
+      // If the input is a ResourceGather, we need to add
+      // ReadVariableOp.
+      NodeDef* variable_node = nullptr;
+      TF_RETURN_IF_ERROR(GetInputNode(gather_node->input(0), &variable_node));
+      NodeDef* read_var_node = ctx().optimized_graph->add_node();
+      read_var_node->set_name(OptimizedNodeName(
+          ParseNodeScopeAndName(reduction_node->name()), "ReadVar"));
+      read_var_node->set_op("ReadVariableOp");
+      read_var_node->add_input(gather_node->input(0));
+      read_var_node->set_device(variable_node->device());
+
+      // The Variable and the Gather node should have the same
+      // dtype, but it might not be set on both nodes.
+      auto attr = read_var_node->mutable_attr();
+      if (variable_node->attr().count("dtype")) {
+        SetAttrValue(variable_node->attr().at("dtype").type(),
+                     &(*attr)["dtype"]);
+      }
+      if (gather_node->attr().count("dtype")) {
+        SetAttrValue(gather_node->attr().at("dtype").type(), &(*attr)["dtype"]);
+      }
+      // Copy the _class attr from the Gather node should it exist in case
+      // of location constraints with the variable.
+      if (gather_node->attr().count("_class")) {
+        (*attr)["_class"] = gather_node->attr().at("_class");
+      }
+      if (variable_node->attr().count("shape")) {
+        SetAttrValue(variable_node->attr().at("shape").shape(),
+                     &(*attr)["_output_shapes"]);
+      }
+
+      ctx().node_map->AddNode(read_var_node->name(), read_var_node);
+      reduction_node->set_input(0, read_var_node->name());
+      ctx().node_map->UpdateInput(reduction_node->name(), gather_input,
+                                  read_var_node->name());
+    } else {
+      reduction_node->set_input(0, gather_node->input(0));
+      ctx().node_map->UpdateInput(reduction_node->name(), gather_input,
+                                  gather_node->input(0));
+    }
+    *simplified_node_name = reduction_node->name();
+    return absl::OkStatus();
+  }
+
+ private:
+  bool IsAxis0(const NodeDef& node, int axis_input) {
+    Tensor axis_tensor;
+    if (!GetTensorFromConstNode(node.input(axis_input), &axis_tensor))
+      return false;
+    if (axis_tensor.NumElements() != 1) return false;
+    if (axis_tensor.dtype() == DT_INT32) {
+      return axis_tensor.flat<int32>()(0) == 0;
+    } else if (axis_tensor.dtype() == DT_INT64) {
+      return axis_tensor.flat<int64_t>()(0) == 0;
+    } else {
+      return false;
+    }
+  }
+};
+
 // Eliminates unnecessary casts before sparse segment reduction operations.
 //
 // Existing graphs and library code would often insert a cast from DT_INT64 to
@@ -4368,6 +4515,8 @@ Status ArithmeticOptimizer::SimplifyArithmeticOps(bool can_use_shapes) {
     pipeline.AddStage<UnaryOpsComposition>(ctx, ctx_ext);
   if (options_.remove_stack_slice_same_axis)
     pipeline.AddStage<RemoveStackSliceSameAxis>(ctx, ctx_ext);
+  if (options_.fuse_gather_segment_reduction)
+    pipeline.AddStage<FuseGatherSegmentReductionStage>(ctx, ctx_ext);
   if (options_.simplify_embedding_lookup)
     pipeline.AddStage<SimplifyEmbeddingLookupStage>(ctx, ctx_ext);
   if (options_.remove_cast_into_segment_reduction)
@@ -4673,6 +4673,85 @@ TEST_F(ArithmeticOptimizerTest, SimplifyAggregationBFloat16) {
   test::ExpectTensorEqual<bfloat16>(tensors[0], tensors_expected[0]);
 }
 
+TEST_F(ArithmeticOptimizerTest, FuseGatherSegmentReduction) {
+  for (bool use_mean : {false, true}) {
+    tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+    Output embeddings = ops::Const(s.WithOpName("embeddings"),
+                                   {1.0f, 2.0f, 3.0f, 4.0f}, {2, 2});
+    Output indices = ops::Const(s.WithOpName("indices"), {0, 0, 1, 0, 1, 0, 1});
+    Output segment_ids =
+        ops::Const(s.WithOpName("segment_ids"), {0, 1, 1, 2, 2, 2, 2});
+    Output gathered_rows =
+        ops::Gather(s.WithOpName("gathered_rows"), embeddings, indices);
+    Output result =
+        use_mean ? Output(ops::SegmentMean(s.WithOpName("result"),
+                                           gathered_rows, segment_ids))
+                 : Output(ops::SegmentSum(s.WithOpName("result"), gathered_rows,
+                                          segment_ids));
+    Output id = ops::Identity(s.WithOpName("id"), result);
+
+    GrapplerItem item;
+    TF_CHECK_OK(s.ToGraphDef(&item.graph));
+    item.fetch = {"id"};
+    auto tensors_expected = EvaluateNodes(item.graph, item.fetch);
+    ASSERT_EQ(tensors_expected.size(), 1);
+
+    GraphDef output;
+    ArithmeticOptimizer optimizer;
+    EnableOnlyFuseGatherSegmentReduction(&optimizer);
+    OptimizeAndPrune(&optimizer, &item, &output);
+
+    for (const auto& node : output.node()) {
+      if (node.name() == "result") {
+        EXPECT_EQ(node.op(),
+                  use_mean ? "SparseSegmentMean" : "SparseSegmentSum");
+        EXPECT_EQ(node.input(0), "embeddings");
+        EXPECT_EQ(node.input(1), "indices");
+        EXPECT_EQ(node.input(2), "segment_ids");
+      }
+      EXPECT_NE(node.op(), "Gather");
+    }
+
+    auto tensors = EvaluateNodes(output, item.fetch);
+    ASSERT_EQ(tensors.size(), 1);
+    test::ExpectTensorEqual<float>(tensors[0], tensors_expected[0]);
+  }
+}
+
+TEST_F(ArithmeticOptimizerTest, FuseGatherSegmentReductionNotOnComplex) {
+  // SparseSegmentSum has no complex kernels, so the fusion must leave a
+  // complex-valued SegmentSum untouched.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  Output real = ops::Const(s.WithOpName("real"), {1.0f, 3.0f}, {2, 1});
+  Output embeddings = ops::Complex(s.WithOpName("embeddings"), real, real);
+  Output indices = ops::Const(s.WithOpName("indices"), {0, 1, 1});
+  Output segment_ids = ops::Const(s.WithOpName("segment_ids"), {0, 0, 1});
+  Output gathered_rows =
+      ops::Gather(s.WithOpName("gathered_rows"), embeddings, indices);
+  Output result =
+      ops::SegmentSum(s.WithOpName("result"), gathered_rows, segment_ids);
+  Output id = ops::Identity(s.WithOpName("id"), result);
+
+  GrapplerItem item;
+  TF_CHECK_OK(s.ToGraphDef(&item.graph));
+  item.fetch = {"id"};
+
+  GraphDef output;
+  ArithmeticOptimizer optimizer;
+  EnableOnlyFuseGatherSegmentReduction(&optimizer);
+  OptimizeAndPrune(&optimizer, &item, &output);
+
+  bool found_gather = false;
+  for (const auto& node : output.node()) {
+    if (node.name() == "result") {
+      EXPECT_EQ(node.op(), "SegmentSum");
+      EXPECT_EQ(node.input(0), "gathered_rows");
+    }
+    if (node.name() == "gathered_rows") found_gather = true;
+  }
+  EXPECT_TRUE(found_gather);
+}
+
 TEST_F(ArithmeticOptimizerTest, SimplifyEmbeddingLookup) {
   for (DataType unique_idx_type : {DT_INT32, DT_INT64}) {
     tensorflow::Scope s = tensorflow::Scope::NewRootScope();
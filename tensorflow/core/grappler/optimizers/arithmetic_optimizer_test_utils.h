@@ -238,6 +238,11 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     optimizer->options_.remove_stack_slice_same_axis = true;
   }
 
+  void EnableOnlyFuseGatherSegmentReduction(ArithmeticOptimizer* optimizer) {
+    DisableAllStages(optimizer);
+    optimizer->options_.fuse_gather_segment_reduction = true;
+  }
+
   void EnableOnlySimplifyEmbeddingLookup(ArithmeticOptimizer* optimizer) {
     DisableAllStages(optimizer);
     optimizer->options_.simplify_embedding_lookup = true;
@@ -277,6 +282,7 @@ class ArithmeticOptimizerTest : public GrapplerTest {
     options.replace_mul_with_square = false;
     options.simplify_aggregation = false;
     options.unary_ops_composition = false;
+    options.fuse_gather_segment_reduction = false;
     options.simplify_embedding_lookup = false;
     options.remove_cast_into_segment_reduction = false;
     optimizer->options_ = options;
@@ -52,10 +52,12 @@ limitations under the License.
 #include "tensorflow/core/platform/cpu_info.h"
 #include "tensorflow/core/platform/denormal.h"
 #include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/setround.h"
 #include "tensorflow/core/platform/tensor_coding.h"
 #include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/bcast.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/overflow.h"
 #include "tensorflow/core/util/saved_tensor_slice_util.h"
 
@@ -67,6 +69,30 @@ using TensorVector = gtl::InlinedVector<TensorValue, 4>;
 const int64_t kMaxConstantSize = 100 * 1024;
 
 namespace {
+// Upper bound on the total size of the tensors materialized by constant
+// folding for a single graph. Once the budget is exhausted further foldings
+// are skipped and the compute is kept instead; this caps the load-time
+// memory footprint of folded graphs. 0 (the default) disables the budget.
+int64_t FoldedConstantsBudgetBytes() {
+  static const int64_t budget_bytes = []() {
+    int64_t bytes;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_GRAPPLER_CONSTANT_FOLDING_BUDGET_BYTES",
+                                    /*default_val=*/0, &bytes));
+    return bytes;
+  }();
+  return budget_bytes;
+}
+
+// Content fingerprint of a folded constant: two constants with the same
+// fingerprint hold the same value and are placed on the same device, so
+// consumers of one can be rewired to the other.
+uint64 FoldedConstantFingerprint(const NodeDef& const_node,
+                                 const string& device) {
+  return FingerprintCat64(
+      Fingerprint64(const_node.attr().at("value").SerializeAsString()),
+      Fingerprint64(device));
+}
+
 template <typename T>
 bool AllValuesAre(const TensorProto& proto, const T& value) {
   Tensor tensor;
@@ -1414,6 +1440,21 @@ Status ConstantFolding::EvaluateOneFoldable(const NodeDef& node,
         *result_too_large = true;
         return s;
       }
+      const int64_t budget_bytes = FoldedConstantsBudgetBytes();
+      if (budget_bytes > 0) {
+        const int64_t encoded_size =
+            outputs->at(i).attr().at("value").tensor().ByteSizeLong();
+        if (folded_constants_bytes_ + encoded_size > budget_bytes) {
+          // Keep the compute: materializing this result would push the graph
+          // past the folding budget.
+          *result_too_large = true;
+          return absl::ResourceExhaustedError(absl::StrCat(
+              "Can't fold ", node.name(), ", materializing its value (",
+              encoded_size, " bytes) would exceed the constant folding budget (",
+              folded_constants_bytes_, " of ", budget_bytes, " bytes used)"));
+        }
+        folded_constants_bytes_ += encoded_size;
+      }
     } else {
       // Create an empty NodeDef to identify dead outputs (e.g. the output of a
       // switch that's not selected by the switch predicate).
@@ -1565,9 +1606,44 @@ Status ConstantFolding::FoldNode(NodeDef* node, GraphDef* output_graph,
       }
     }
 
+    // Constants without control dependencies are candidates for content-hash
+    // deduplication: rewiring a consumer to an identical constant folded
+    // earlier in this pass is safe since there are no dependencies to drop.
+    const bool poolable = const_node->input().empty();
+    const uint64 fingerprint =
+        poolable ? FoldedConstantFingerprint(*const_node, node->device()) : 0;
+
     // We rewrite the existing node if it only has a single output, and
     // create new nodes otherwise.
     if (const_nodes.size() == 1) {
+      if (poolable && has_fetch_ &&
+          nodes_to_preserve_.find(node->name()) == nodes_to_preserve_.end()) {
+        auto it = folded_constants_.find(fingerprint);
+        if (it != folded_constants_.end() && it->second != node->name() &&
+            node_map_->GetNode(it->second) != nullptr) {
+          // An identical constant was already materialized during this pass:
+          // rewire the fanout to it instead of duplicating its value. The
+          // folded node is swept at the end of FoldGraph() once nothing
+          // consumes it.
+          auto consumers = node_map_->GetOutputs(node->name());
+          for (NodeDef* consumer : consumers) {
+            for (int j = 0; j < consumer->input_size(); ++j) {
+              int port;
+              string input_name = ParseNodeName(consumer->input(j), &port);
+              if (input_name == node->name() && port >= 0) {
+                node_map_->UpdateInput(consumer->name(), node->name(),
+                                       it->second);
+                *consumer->mutable_input(j) = it->second;
+              }
+            }
+          }
+          if (FoldedConstantsBudgetBytes() > 0) {
+            folded_constants_bytes_ -=
+                const_node->attr().at("value").tensor().ByteSizeLong();
+          }
+          break;
+        }
+      }
       node->set_op("Const");
       // Note we need to clear the inputs in NodeMap before we clear the inputs
       // in the node, otherwise NodeMap would see empty inputs and effectively
@@ -1579,8 +1655,25 @@ Status ConstantFolding::FoldNode(NodeDef* node, GraphDef* output_graph,
         node_map_->AddOutput(NodeName(input), node->name());
       }
       *node->mutable_attr() = const_node->attr();
+      if (poolable) {
+        folded_constants_[fingerprint] = node->name();
+      }
       break;
     } else {
+      if (poolable) {
+        auto it = folded_constants_.find(fingerprint);
+        if (it != folded_constants_.end() &&
+            node_map_->GetNode(it->second) != nullptr) {
+          // Point the rewiring below at the identical pooled constant instead
+          // of materializing a duplicate.
+          const_node->set_name(it->second);
+          if (FoldedConstantsBudgetBytes() > 0) {
+            folded_constants_bytes_ -=
+                const_node->attr().at("value").tensor().ByteSizeLong();
+          }
+          continue;
+        }
+      }
       if (node_map_->GetNode(const_node->name())) {
         // Intended name already exists.
         return absl::AlreadyExistsError(strings::StrCat(
@@ -1593,6 +1686,9 @@ Status ConstantFolding::FoldNode(NodeDef* node, GraphDef* output_graph,
       for (const auto& input : added_node->input()) {
         node_map_->AddOutput(NodeName(input), added_node->name());
       }
+      if (poolable) {
+        folded_constants_[fingerprint] = added_node->name();
+      }
       // All the constant nodes encoding output values have the same control
       // dependencies (since these are the control dependencies of the node
       // we're trying to fold). Record one such constant node.
@@ -4026,6 +4122,7 @@ Status ConstantFolding::RunOptimizationPass(Cluster* cluster,
   graph_ = &item->graph;
   node_map_.reset(new NodeMap(graph_));
   nodes_allowlist_.clear();
+  folded_constants_.clear();
   // Fold fetch nodes iff it has a single fanout. Note that if a fetch node
   // has a single fanout, it would be rewritten as a constant with the same
   // node name, and therefore users are still able to fetch it. This is not
@@ -4082,6 +4179,7 @@ Status ConstantFolding::Optimize(Cluster* cluster, const GrapplerItem& item,
   }
 
   has_fetch_ = !item.fetch.empty();
+  folded_constants_bytes_ = 0;
   GrapplerItem item_to_optimize = item;
   GraphProperties properties(item_to_optimize);
   // It's possible to feed a placeholder with a tensor of any shape: make sure
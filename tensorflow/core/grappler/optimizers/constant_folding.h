@@ -335,6 +335,14 @@ class ConstantFolding : public GraphOptimizer {
   absl::flat_hash_set<string> nodes_allowlist_;
   absl::flat_hash_set<string> feed_nodes_;
   absl::flat_hash_map<string, bool> maybe_foldable_nodes_;
+  // Constants materialized by the current optimization pass, keyed by a
+  // fingerprint of their value and device. Used by FoldNode() to rewire
+  // consumers to an existing identical constant instead of materializing a
+  // duplicate. Cleared at the start of each pass.
+  absl::flat_hash_map<uint64, string> folded_constants_;
+  // Total bytes of constant values materialized so far, checked against
+  // TF_GRAPPLER_CONSTANT_FOLDING_BUDGET_BYTES. Accumulates across passes.
+  int64_t folded_constants_bytes_ = 0;
   bool has_fetch_;
   bool graph_modified_;
   bool graph_contains_assign_or_inplace_op_;
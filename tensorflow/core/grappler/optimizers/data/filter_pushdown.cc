@@ -0,0 +1,115 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/filter_pushdown.h"
+
+#include <string>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/graph/tensor_id.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/grappler/utils/topological_sort.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kFilterDataset[] = "FilterDataset";
+constexpr char kPrefetchDataset[] = "PrefetchDataset";
+
+// Returns the number of nodes that consume an output of `node_name`, ignoring
+// nodes scheduled for deletion.
+int NumFanouts(const GraphDef& graph, absl::string_view node_name,
+               const absl::flat_hash_set<string>& nodes_to_delete) {
+  int num_fanouts = 0;
+  for (const NodeDef& node : graph.node()) {
+    if (nodes_to_delete.contains(node.name())) continue;
+    for (const string& input : node.input()) {
+      if (ParseTensorName(input).node() == node_name) ++num_fanouts;
+    }
+  }
+  return num_fanouts;
+}
+
+}  // namespace
+
+Status FilterPushdown::OptimizeAndCollectStats(Cluster* cluster,
+                                               const GrapplerItem& item,
+                                               GraphDef* output,
+                                               OptimizationStats* stats) {
+  GraphDef sorted_old_graph = item.graph;
+  TF_RETURN_IF_ERROR(TopologicalSort(&sorted_old_graph));
+  *output = sorted_old_graph;
+
+  MutableGraphView graph(output);
+  absl::flat_hash_set<string> nodes_to_delete;
+
+  for (const NodeDef& node : sorted_old_graph.node()) {
+    if (node.op() != kFilterDataset) continue;
+    const NodeDef* filter_node = graph.GetNode(node.name());
+    // TODO(b/148614315): Support captured inputs.
+    if (filter_node == nullptr || filter_node->input_size() != 1) continue;
+
+    // Walk down the chain of prefetches below the filter. A prefetch with
+    // other consumers cannot be crossed, since pushing the filter below it
+    // would change the elements those consumers see.
+    const NodeDef* bottom_prefetch = nullptr;
+    const NodeDef* input = graph_utils::GetInputNode(*filter_node, graph);
+    while (input != nullptr && input->op() == kPrefetchDataset &&
+           NumFanouts(*output, input->name(), nodes_to_delete) == 1) {
+      bottom_prefetch = input;
+      input = graph_utils::GetInputNode(*input, graph);
+    }
+    if (bottom_prefetch == nullptr) continue;
+
+    // `AddNode` below may reallocate the node buffer, so capture everything
+    // needed for rewiring by name first.
+    const string filter_name = filter_node->name();
+    const string top_prefetch_name = filter_node->input(0);
+    const string bottom_prefetch_name = bottom_prefetch->name();
+    const string bottom_prefetch_input = bottom_prefetch->input(0);
+
+    NodeDef pushed_down_filter = *filter_node;
+    graph_utils::SetUniqueGraphNodeName("pushed_down_filter", graph.graph(),
+                                        &pushed_down_filter);
+    pushed_down_filter.set_input(0, bottom_prefetch_input);
+    const NodeDef* new_filter_node =
+        graph.AddNode(std::move(pushed_down_filter));
+
+    TF_RETURN_IF_ERROR(graph.UpdateFanin(bottom_prefetch_name,
+                                         ParseTensorName(bottom_prefetch_input),
+                                         {new_filter_node->name(), 0}));
+    TF_RETURN_IF_ERROR(graph.UpdateFanouts(filter_name, top_prefetch_name));
+    nodes_to_delete.insert(filter_name);
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(FilterPushdown, "filter_pushdown");
+
+}  // namespace grappler
+}  // namespace tensorflow
@@ -0,0 +1,148 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/filter_pushdown.h"
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_test_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using graph_tests_utils::MakeFilterNode;
+using graph_tests_utils::MakePrefetchNode;
+
+TEST(FilterPushdownTest, PushFilterBelowPrefetch) {
+  using test::function::NDef;
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("buffer_size", "Const", {}, {{"value", 2}, {"dtype", DT_INT64}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"}, {}),
+       MakePrefetchNode("prefetch", "range", "buffer_size"),
+       MakeFilterNode("filter", "prefetch")},
+      // FunctionLib
+      {
+          test::function::IsZero(),
+      });
+
+  FilterPushdown optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("filter", output));
+  ASSERT_TRUE(
+      graph_utils::ContainsGraphNodeWithName("pushed_down_filter", output));
+  const NodeDef& filter_node = output.node(
+      graph_utils::FindGraphNodeWithName("pushed_down_filter", output));
+  EXPECT_EQ(filter_node.input(0), "range");
+  const NodeDef& prefetch_node =
+      output.node(graph_utils::FindGraphNodeWithName("prefetch", output));
+  EXPECT_EQ(prefetch_node.input(0), "pushed_down_filter");
+}
+
+TEST(FilterPushdownTest, PushFilterBelowChainOfPrefetches) {
+  using test::function::NDef;
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("buffer_size", "Const", {}, {{"value", 2}, {"dtype", DT_INT64}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"}, {}),
+       MakePrefetchNode("prefetch1", "range", "buffer_size"),
+       MakePrefetchNode("prefetch2", "prefetch1", "buffer_size"),
+       MakeFilterNode("filter", "prefetch2")},
+      // FunctionLib
+      {
+          test::function::IsZero(),
+      });
+
+  FilterPushdown optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("filter", output));
+  ASSERT_TRUE(
+      graph_utils::ContainsGraphNodeWithName("pushed_down_filter", output));
+  const NodeDef& filter_node = output.node(
+      graph_utils::FindGraphNodeWithName("pushed_down_filter", output));
+  EXPECT_EQ(filter_node.input(0), "range");
+  const NodeDef& prefetch_node =
+      output.node(graph_utils::FindGraphNodeWithName("prefetch1", output));
+  EXPECT_EQ(prefetch_node.input(0), "pushed_down_filter");
+}
+
+TEST(FilterPushdownTest, NoPushdownWithoutPrefetch) {
+  using test::function::NDef;
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"}, {}),
+       MakeFilterNode("filter", "range")},
+      // FunctionLib
+      {
+          test::function::IsZero(),
+      });
+
+  FilterPushdown optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("filter", output));
+  const NodeDef& filter_node =
+      output.node(graph_utils::FindGraphNodeWithName("filter", output));
+  EXPECT_EQ(filter_node.input(0), "range");
+}
+
+TEST(FilterPushdownTest, NoPushdownPastSharedPrefetch) {
+  using test::function::NDef;
+  GrapplerItem item;
+  // The prefetch has a second consumer, so the filter must stay put.
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("buffer_size", "Const", {}, {{"value", 2}, {"dtype", DT_INT64}}),
+       NDef("filename", "Const", {}, {{"value", ""}, {"dtype", DT_STRING}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"}, {}),
+       MakePrefetchNode("prefetch", "range", "buffer_size"),
+       MakeFilterNode("filter", "prefetch"),
+       NDef("cache", "CacheDataset", {"prefetch", "filename"}, {})},
+      // FunctionLib
+      {
+          test::function::IsZero(),
+      });
+
+  FilterPushdown optimizer;
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(nullptr, item, &output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName("filter", output));
+  const NodeDef& filter_node =
+      output.node(graph_utils::FindGraphNodeWithName("filter", output));
+  EXPECT_EQ(filter_node.input(0), "prefetch");
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
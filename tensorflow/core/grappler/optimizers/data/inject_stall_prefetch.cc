@@ -0,0 +1,201 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/inject_stall_prefetch.h"
+
+#include "absl/algorithm/container.h"
+#include "absl/container/flat_hash_set.h"
+#include "tensorflow/core/framework/model.h"
+#include "tensorflow/core/framework/node_def.pb.h"
+#include "tensorflow/core/grappler/clusters/cluster.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/mutable_graph_view.h"
+#include "tensorflow/core/grappler/op_types.h"
+#include "tensorflow/core/grappler/optimizers/custom_graph_optimizer_registry.h"
+#include "tensorflow/core/grappler/optimizers/data/function_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/grappler/utils.h"
+#include "tensorflow/core/platform/protobuf.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+constexpr char kBufferSizeMin[] = "buffer_size_min";
+constexpr char kMapDataset[] = "MapDataset";
+constexpr char kParallelMapDataset[] = "ParallelMapDatasetV2";
+constexpr char kPrefetchDataset[] = "PrefetchDataset";
+
+constexpr std::array<const char*, 8> kAsyncDatasetOps = {
+    "ExperimentalMapAndBatchDataset",
+    "MapAndBatchDataset",
+    "ParallelBatchDataset",
+    "ParallelInterleaveDatasetV2",
+    "ParallelInterleaveDatasetV3",
+    "ParallelInterleaveDatasetV4",
+    "ParallelMapDataset",
+    "ParallelMapDatasetV2",
+};
+
+bool IsAsyncDatasetOp(const NodeDef& node) {
+  return absl::c_any_of(kAsyncDatasetOps, [&node](const char* dataset_op) {
+    return node.op() == dataset_op;
+  });
+}
+
+NodeDef MakeParallelMap(const string& name, MutableGraphView* graph) {
+  // The inputs of the node to be parallelized could be changed by the
+  // optimization pass, so we need to look it up in the modified graph.
+  int index = graph_utils::FindGraphNodeWithName(name, *graph->graph());
+  DCHECK_NE(index, -1) << "Failed to find node " << name
+                       << " in the optimized graph.";
+  NodeDef parallel_map = graph->graph()->node(index);
+  graph_utils::SetUniqueGraphNodeName(kParallelMapDataset, graph->graph(),
+                                      &parallel_map);
+  parallel_map.set_op(kParallelMapDataset);
+  auto* num_parallel_calls = graph_utils::AddScalarConstNode(
+      static_cast<int64_t>(data::model::kAutotune), graph);
+  parallel_map.add_input(num_parallel_calls->name());
+  parallel_map.mutable_attr()->erase("force_synchronous");
+  AddNodeAttr("deterministic", "true", &parallel_map);
+
+  return parallel_map;
+}
+
+}  // namespace
+
+Status InjectStallPrefetch::OptimizeAndCollectStats(Cluster* cluster,
+                                                    const GrapplerItem& item,
+                                                    GraphDef* output,
+                                                    OptimizationStats* stats) {
+  *output = item.graph;
+  if (stall_node_names_.empty()) {
+    VLOG(1) << "The optimization inject_stall_prefetch is not applied without "
+               "stall statistics from a profiling run.";
+    return absl::OkStatus();
+  }
+  MutableGraphView graph(output);
+
+  // If the GrapplerItem is derived from a FunctionDef, we don't optimize it:
+  // stall statistics are collected for the main dataset pipeline.
+  if (graph_utils::IsItemDerivedFromFunctionDef(item, graph)) {
+    return absl::OkStatus();
+  }
+
+  FunctionLibraryDefinition function_library(OpRegistry::Global(),
+                                             item.graph.library());
+
+  // Datasets that already feed a `prefetch` don't need another one.
+  absl::flat_hash_set<string> already_prefetched;
+  for (const NodeDef& node : item.graph.node()) {
+    if (node.op() == kPrefetchDataset) {
+      NodeDef* prefetched_node = graph_utils::GetInputNode(node, graph);
+      if (prefetched_node) {
+        already_prefetched.insert(prefetched_node->name());
+      }
+    }
+  }
+
+  absl::flat_hash_set<string> nodes_to_delete;
+  for (const NodeDef& node : item.graph.node()) {
+    if (!stall_node_names_.contains(node.name())) continue;
+
+    if (node.op() == kMapDataset) {
+      // A stalled synchronous `map` becomes `parallel_map(AUTOTUNE)`.
+      auto* function =
+          function_library.Find(node.attr().at("f").func().name());
+      if (function_utils::IsFunctionStateful(function_library, *function,
+                                             true) ||
+          (node.attr().contains("force_synchronous") &&
+           node.attr().at("force_synchronous").b())) {
+        VLOG(1) << "Not parallelizing stalled map node " << node.name()
+                << ": its function is stateful or forced synchronous.";
+        continue;
+      }
+      auto* parallel_map = graph.AddNode(MakeParallelMap(node.name(), &graph));
+      TF_RETURN_IF_ERROR(
+          graph.UpdateFanouts(node.name(), parallel_map->name()));
+      nodes_to_delete.insert(node.name());
+      stats->num_changes++;
+      continue;
+    }
+
+    if (node.op() == kPrefetchDataset) {
+      // A stalled `prefetch(N)` is resized to `prefetch(AUTOTUNE,
+      // buffer_size_min=N)`, so autotuning can only grow the buffer.
+      NodeDef* prefetch_node = graph.GetNode(node.name());
+      NodeDef* buffer_size_node = graph.GetNode(prefetch_node->input(1));
+      if (buffer_size_node->op() != "Const") {
+        VLOG(1) << "Not resizing stalled prefetch node " << node.name()
+                << ": its buffer_size input is not constant.";
+        continue;
+      }
+      int64_t initial_buffer_size =
+          buffer_size_node->attr().at("value").tensor().int64_val(0);
+      if (initial_buffer_size == data::model::kAutotune) continue;
+      NodeDef* autotune_value =
+          graph_utils::AddScalarConstNode(data::model::kAutotune, &graph);
+      TF_RETURN_IF_ERROR(graph.UpdateFanin(prefetch_node->name(),
+                                           {buffer_size_node->name(), 0},
+                                           {autotune_value->name(), 0}));
+      (*prefetch_node->mutable_attr())[kBufferSizeMin].set_i(
+          initial_buffer_size);
+      stats->num_changes++;
+      continue;
+    }
+
+    if (IsAsyncDatasetOp(node) || already_prefetched.contains(node.name())) {
+      // The handoff is already decoupled from its consumer.
+      continue;
+    }
+
+    // Insert `prefetch(AUTOTUNE)` after the stalled dataset.
+    NodeDef prefetch_node;
+    graph_utils::SetUniqueGraphNodeName(
+        strings::StrCat("inject/stall_prefetch_", node.name()), graph.graph(),
+        &prefetch_node);
+    prefetch_node.set_op(kPrefetchDataset);
+    // `input_dataset` input
+    *prefetch_node.mutable_input()->Add() = node.name();
+    // `buffer_size` input
+    NodeDef* autotune_value =
+        graph_utils::AddScalarConstNode(data::model::kAutotune, &graph);
+    *prefetch_node.mutable_input()->Add() = autotune_value->name();
+
+    // Set `output_types` and `output_shapes` attributes by copying the
+    // relevant attrs from the input node. If we fail to set the attributes,
+    // we skip this node: it's likely not a dataset.
+    if (!graph_utils::CopyShapesAndTypesAttrs(node, &prefetch_node)) {
+      VLOG(1) << "Not prefetching stalled node " << node.name()
+              << ": it has no output_shapes/output_types attributes.";
+      continue;
+    }
+
+    TF_RETURN_IF_ERROR(
+        graph_utils::SetMetadataName(prefetch_node.name(), &prefetch_node));
+
+    auto* added_node = graph.AddNode(std::move(prefetch_node));
+    TF_RETURN_IF_ERROR(graph.UpdateFanouts(node.name(), added_node->name()));
+    stats->num_changes++;
+  }
+
+  TF_RETURN_IF_ERROR(graph.DeleteNodes(nodes_to_delete));
+  return absl::OkStatus();
+}
+
+REGISTER_GRAPH_OPTIMIZER_AS(InjectStallPrefetch, "inject_stall_prefetch");
+
+}  // namespace grappler
+}  // namespace tensorflow
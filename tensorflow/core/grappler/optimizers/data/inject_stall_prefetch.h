@@ -0,0 +1,78 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_INJECT_STALL_PREFETCH_H_
+#define TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_INJECT_STALL_PREFETCH_H_
+
+#include <string>
+
+#include "absl/container/flat_hash_set.h"
+#include "absl/strings/str_split.h"
+#include "tensorflow/core/framework/attr_value.pb.h"
+#include "tensorflow/core/grappler/optimizers/data/optimizer_base.h"
+
+namespace tensorflow {
+namespace grappler {
+
+constexpr char kStallNodeNames[] = "stall_node_names";
+
+// Rewrites an input pipeline based on iterator stall statistics collected in a
+// profiling run (see the iterator busy/wait metrics recorded by
+// `tensorflow/core/data/metric_utils.cc`). The optimizer is configured with
+// the names of the dataset nodes whose consumers were observed waiting; at
+// every such handoff point it makes the producer asynchronous:
+//  - `map` nodes with stateless functions become `parallel_map(AUTOTUNE)`,
+//  - `prefetch(N)` buffers are resized to
+//    `prefetch(AUTOTUNE, buffer_size_min=N)`,
+//  - any other dataset gets a `prefetch(AUTOTUNE)` inserted after it, unless
+//    it is already asynchronous or already followed by a `prefetch`.
+// The rewritten pipeline can then be serialized and pinned for production.
+class InjectStallPrefetch : public TFDataOptimizerBase {
+ public:
+  InjectStallPrefetch() = default;
+  ~InjectStallPrefetch() override = default;
+
+  std::string name() const override { return "inject_stall_prefetch"; };
+
+  bool UsesFunctionLibrary() const override { return false; }
+
+  Status Init(
+      const tensorflow::RewriterConfig_CustomGraphOptimizer* config) override {
+    if (!config) return absl::OkStatus();
+
+    auto it = config->parameter_map().find(kStallNodeNames);
+    if (it != config->parameter_map().end()) {
+      for (absl::string_view node_name :
+           absl::StrSplit(it->second.s(), ',', absl::SkipEmpty())) {
+        stall_node_names_.insert(std::string(node_name));
+      }
+    }
+    return absl::OkStatus();
+  }
+
+  Status OptimizeAndCollectStats(Cluster* cluster, const GrapplerItem& item,
+                                 GraphDef* output,
+                                 OptimizationStats* stats) override;
+
+ protected:
+  // Names of the dataset nodes where the profiling run observed consumer
+  // waits, as recorded in the original (unrewritten) pipeline.
+  absl::flat_hash_set<std::string> stall_node_names_;
+};
+
+}  // namespace grappler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_GRAPPLER_OPTIMIZERS_DATA_INJECT_STALL_PREFETCH_H_
@@ -0,0 +1,160 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tensorflow/core/grappler/optimizers/data/inject_stall_prefetch.h"
+
+#include "tensorflow/core/framework/attr_value_util.h"
+#include "tensorflow/core/framework/function_testlib.h"
+#include "tensorflow/core/framework/tensor_testutil.h"
+#include "tensorflow/core/grappler/grappler_item.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_test_utils.h"
+#include "tensorflow/core/grappler/optimizers/data/graph_utils.h"
+#include "tensorflow/core/lib/core/status_test_util.h"
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace grappler {
+namespace {
+
+using graph_tests_utils::MakeMapNode;
+using test::function::NDef;
+
+constexpr char kParallelMapDataset[] = "ParallelMapDatasetV2";
+constexpr char kPrefetchDataset[] = "PrefetchDataset";
+
+Status OptimizeWithInjectStallPrefetch(const GrapplerItem& item,
+                                       GraphDef* output,
+                                       const string& stall_node_names) {
+  InjectStallPrefetch optimizer;
+  RewriterConfig_CustomGraphOptimizer config;
+  (*config.mutable_parameter_map())[kStallNodeNames].set_s(stall_node_names);
+  TF_RETURN_IF_ERROR(optimizer.Init(&config));
+  return optimizer.Optimize(nullptr, item, output);
+}
+
+GrapplerItem MakeRangeMapItem() {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", absl::Span<const TensorShape>{}},
+             {"output_types", absl::Span<const DataType>{}}}),
+       MakeMapNode("map", "range", "XTimesTwo"),
+       NDef("Sink", "Identity", {"map"}, {})},
+      // FunctionLib
+      {
+          test::function::XTimesTwo(),
+      });
+  item.fetch.push_back("Sink");
+  return item;
+}
+
+TEST(InjectStallPrefetchTest, NoStatsNoRewrite) {
+  GrapplerItem item = MakeRangeMapItem();
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, ""));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp(kPrefetchDataset, output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp(kParallelMapDataset, output));
+}
+
+TEST(InjectStallPrefetchTest, ParallelizesStalledMap) {
+  GrapplerItem item = MakeRangeMapItem();
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, "map"));
+  EXPECT_TRUE(graph_utils::ContainsNodeWithOp(kParallelMapDataset, output));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName("map", output));
+}
+
+TEST(InjectStallPrefetchTest, PrefetchesStalledDataset) {
+  GrapplerItem item = MakeRangeMapItem();
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, "range"));
+  EXPECT_TRUE(graph_utils::ContainsNodeWithOp(kPrefetchDataset, output));
+  EXPECT_TRUE(graph_utils::ContainsGraphNodeWithName(
+      "inject/stall_prefetch_range", output));
+  // The injected prefetch reads from the stalled dataset, and the map now
+  // reads from the prefetch.
+  int map_index = graph_utils::FindGraphNodeWithName("map", output);
+  ASSERT_NE(map_index, -1);
+  EXPECT_EQ(output.node(map_index).input(0), "inject/stall_prefetch_range");
+}
+
+TEST(InjectStallPrefetchTest, ResizesStalledPrefetch) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", absl::Span<const TensorShape>{}},
+             {"output_types", absl::Span<const DataType>{}}}),
+       NDef("buffer_size", "Const", {},
+            {{"value", static_cast<int64_t>(2)}, {"dtype", DT_INT64}}),
+       NDef("prefetch", kPrefetchDataset, {"range", "buffer_size"},
+            {{"output_shapes", absl::Span<const TensorShape>{}},
+             {"output_types", absl::Span<const DataType>{}}}),
+       NDef("Sink", "Identity", {"prefetch"}, {})});
+  item.fetch.push_back("Sink");
+
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, "prefetch"));
+  int prefetch_index = graph_utils::FindGraphNodeWithName("prefetch", output);
+  ASSERT_NE(prefetch_index, -1);
+  const NodeDef& prefetch_node = output.node(prefetch_index);
+  EXPECT_EQ(prefetch_node.attr().at("buffer_size_min").i(), 2);
+  int buffer_size_index =
+      graph_utils::FindGraphNodeWithName(prefetch_node.input(1), output);
+  ASSERT_NE(buffer_size_index, -1);
+  EXPECT_EQ(output.node(buffer_size_index).attr().at("value").tensor().int64_val(0),
+            -1);
+}
+
+TEST(InjectStallPrefetchTest, AlreadyPrefetchedDatasetIsLeftAlone) {
+  GrapplerItem item;
+  item.graph = test::function::GDef(
+      {NDef("start", "Const", {}, {{"value", 0}, {"dtype", DT_INT32}}),
+       NDef("stop", "Const", {}, {{"value", 10}, {"dtype", DT_INT32}}),
+       NDef("step", "Const", {}, {{"value", 1}, {"dtype", DT_INT32}}),
+       NDef("range", "RangeDataset", {"start", "stop", "step"},
+            {{"output_shapes", absl::Span<const TensorShape>{}},
+             {"output_types", absl::Span<const DataType>{}}}),
+       NDef("buffer_size", "Const", {},
+            {{"value", static_cast<int64_t>(2)}, {"dtype", DT_INT64}}),
+       NDef("prefetch", kPrefetchDataset, {"range", "buffer_size"},
+            {{"output_shapes", absl::Span<const TensorShape>{}},
+             {"output_types", absl::Span<const DataType>{}}}),
+       NDef("Sink", "Identity", {"prefetch"}, {})});
+  item.fetch.push_back("Sink");
+
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, "range"));
+  EXPECT_FALSE(graph_utils::ContainsGraphNodeWithName(
+      "inject/stall_prefetch_range", output));
+}
+
+TEST(InjectStallPrefetchTest, FromFunctionDef) {
+  GrapplerItem item = MakeRangeMapItem();
+  item.graph.mutable_node(item.graph.node_size() - 1)->set_op("_Retval");
+  GraphDef output;
+  TF_ASSERT_OK(OptimizeWithInjectStallPrefetch(item, &output, "range,map"));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp(kPrefetchDataset, output));
+  EXPECT_FALSE(graph_utils::ContainsNodeWithOp(kParallelMapDataset, output));
+}
+
+}  // namespace
+}  // namespace grappler
+}  // namespace tensorflow
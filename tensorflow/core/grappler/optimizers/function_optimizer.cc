@@ -54,6 +54,7 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils.h"
 #include "tensorflow/core/grappler/utils/functions.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -1203,6 +1204,37 @@ void AddFrameForwardingControlEdge(const std::vector<ControlFlowInfo>& info,
   }
 }
 
+// Inlining a small function body is almost always profitable: the fixed
+// per-call cost of a PartitionedCallOp (kernel dispatch, executor and frame
+// setup, rendezvous) easily dwarfs the cost of executing a handful of cheap
+// ops. Function bodies with at most this many nodes are inlined even if they
+// are marked with the '_noinline' attribute. 0 disables the override, so only
+// aggressive mode ignores '_noinline'.
+int64_t InlineTinyFunctionThresholdNodes() {
+  static const int64_t threshold_nodes = []() {
+    int64_t nodes;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_GRAPPLER_INLINE_TINY_FUNCTION_NODES",
+                                    16, &nodes));
+    return nodes;
+  }();
+  return threshold_nodes;
+}
+
+// Upper bound on the number of nodes function inlining may add to the main
+// graph. Nested or widely replicated function calls can blow up the graph,
+// and with it the cost of every downstream optimizer pass; once the budget is
+// exhausted the remaining calls are kept as function calls and dispatched
+// through the function library runtime as before. 0 means unlimited.
+int64_t FunctionInliningBudgetNodes() {
+  static const int64_t budget_nodes = []() {
+    int64_t nodes;
+    TF_CHECK_OK(ReadInt64FromEnvVar(
+        "TF_GRAPPLER_FUNCTION_INLINING_BUDGET_NODES", 0, &nodes));
+    return nodes;
+  }();
+  return budget_nodes;
+}
+
 // Inlines all function calls that are safe for inlining into the main graph.
 // Also lowers control flow V2 ops (functional If/While) into the V1 low level
 // ops (Switch/Merge/...).
@@ -1255,6 +1287,11 @@ Status InlineFunctionCalls(const GrapplerItem& item,
   std::vector<ControlFlowInfo> control_flow_info;
   TF_RETURN_IF_ERROR(BuildControlFlowInfo(graph.get(), &control_flow_info));
 
+  const int64_t inlining_budget_nodes = FunctionInliningBudgetNodes();
+  const int64_t tiny_function_threshold_nodes =
+      InlineTinyFunctionThresholdNodes();
+  int64_t inlined_nodes = 0;
+
   // Function inlining always adds new nodes to the end of the list, so we keep
   // iterating until we are out of nodes.
   for (int i = 2; i < graph->num_node_ids(); ++i) {
@@ -1294,9 +1331,26 @@ Status InlineFunctionCalls(const GrapplerItem& item,
     std::unique_ptr<FunctionBody> fbody;
     TF_RETURN_IF_ERROR(MakeFunctionBodyForInlining(*n, flib_def, &fbody));
 
+    // Keep the function call if inlining its body would take the graph over
+    // the inlining budget. Inlined bodies can themselves contain function
+    // calls, so the budget also bounds transitive expansion.
+    const int64_t fbody_nodes = fbody->graph->num_nodes();
+    if (inlining_budget_nodes > 0 &&
+        inlined_nodes + fbody_nodes > inlining_budget_nodes) {
+      VLOG(2) << "Skip inlining function call node: " << n->name()
+              << " (inlining budget of " << inlining_budget_nodes
+              << " nodes exhausted: already inlined " << inlined_nodes
+              << " nodes, function body has " << fbody_nodes << " nodes)";
+      continue;
+    }
+
     InlineFunctionBodyOptions inline_options;
-    // Ignore '_noinline' flag in aggressive mode.
-    inline_options.ignore_noinline = is_aggressive;
+    // Ignore '_noinline' flag in aggressive mode, and for tiny function
+    // bodies, where the per-call executor overhead exceeds the cost of the
+    // body itself.
+    inline_options.ignore_noinline =
+        is_aggressive || (tiny_function_threshold_nodes > 0 &&
+                          fbody_nodes <= tiny_function_threshold_nodes);
 
     // Function calls created after inlining If/While ops are always inlined as
     // multi-device functions and are not required to pass additional Grappler
@@ -1361,6 +1415,7 @@ Status InlineFunctionCalls(const GrapplerItem& item,
 
       TF_RETURN_IF_ERROR(InlineFunctionBody(flib_def, graph.get(), n,
                                             fbody.get(), inline_options));
+      inlined_nodes += fbody_nodes;
       inlined_function_names.push_back(
           fbody->record->fdef().signature().name());
 
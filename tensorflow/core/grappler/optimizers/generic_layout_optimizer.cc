@@ -456,8 +456,10 @@ Status EraseOutputShapeAttrs(TransposeContext* context) {
 
 // When there is a GPU, the computation graph is converted to NCHW format.
 // When there is only CPU, there will be no conversion by default, unless user
-// chose to convert the graph to a desired format. Currently, NCHW -> NHWC
-// format conversion is available on CPU.
+// chose to convert the graph to a desired format. NCHW -> NHWC and
+// NHWC -> NCHW format conversions are available on CPU; the latter is the
+// channel-major order that blocked-layout CPU kernels (e.g. oneDNN's NCHWc
+// formats) convert to and from at their boundaries.
 Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
                                         const GrapplerItem& item,
                                         GraphDef* output) {
@@ -494,12 +496,9 @@ Status GenericLayoutOptimizer::Optimize(Cluster* cluster,
       case RewriterConfig::NCHW_TO_NHWC:
         context.AssignDeviceAndDataFormats(kCPU, kNCHW, kNHWC);
         break;
-      // TODO(intel-tf): Add functionality for NHWC_TO_NCHW layout conversion on
-      // CPU.
       case RewriterConfig::NHWC_TO_NCHW:
-        return errors::Aborted(
-            "Conversion from NHWC to NCHW is currently not  available for "
-            "CPU.");
+        context.AssignDeviceAndDataFormats(kCPU, kNHWC, kNCHW);
+        break;
       default:
         *output = item.graph;
         VLOG(2) << "No layout conversion will take place for CPU.";
@@ -385,6 +385,65 @@ TEST_F(GenericLayoutOptimizerTest, CPUDevice) {
 #endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
 }
 
+TEST_F(GenericLayoutOptimizerTest, CPUDeviceNHWCToNCHW) {
+#if (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  GTEST_SKIP() << "CUDA or ROCm is enabled";
+#endif  // (GOOGLE_CUDA || TENSORFLOW_USE_ROCM)
+  // NHWC -> NCHW conversion on CPU: the graph is rewritten to the
+  // channel-major order preferred by blocked-layout CPU kernels, with layout
+  // conversions only at the boundaries of the converted chain.
+  tensorflow::Scope s = tensorflow::Scope::NewRootScope();
+  TensorShape input_shape({8, 4, 4, 3});
+  Tensor input_data(DT_FLOAT, input_shape);
+  test::FillIota<float>(&input_data, 1.0f);
+  Output input =
+      ops::Const(s.WithOpName("Input"), Input::Initializer(input_data));
+  TensorShape filter_shape({2, 2, 3, 2});
+  Tensor filter_data(DT_FLOAT, filter_shape);
+  test::FillIota<float>(&filter_data, 1.0f);
+  Output filter =
+      ops::Const(s.WithOpName("Filter"), Input::Initializer(filter_data));
+  Output conv = ops::Conv2D(s.WithOpName("Conv2D").WithDevice("/CPU:0"), input,
+                            filter, {1, 1, 1, 1}, "VALID",
+                            ops::Conv2D::Attrs().DataFormat("NHWC"));
+  Output fetch = ops::Identity(s.WithOpName("Fetch"), {conv});
+  GrapplerItem item;
+  TF_ASSERT_OK(s.ToGraphDef(&item.graph));
+
+  GenericLayoutOptimizer optimizer(RewriterConfig::DEFAULT,
+                                   RewriterConfig::NHWC_TO_NCHW);
+  GraphDef output;
+  TF_ASSERT_OK(optimizer.Optimize(virtual_cluster_.get(), item, &output));
+
+  Status status;
+  utils::GraphView graph_view(&output, &status);
+  TF_ASSERT_OK(status);
+
+  auto* input_transpose_node =
+      graph_view.GetNode("Conv2D-0-TransposeNHWCToNCHW-LayoutOptimizer");
+  ASSERT_NE(input_transpose_node, nullptr);
+  ASSERT_EQ(input_transpose_node->NumRegularFanins(), 2);
+  VerifyRegularFaninMatch(input_transpose_node, 0, "Input", 0);
+
+  auto* conv_node = graph_view.GetNode("Conv2D");
+  ASSERT_NE(conv_node, nullptr);
+  ASSERT_EQ(conv_node->NumRegularFanins(), 2);
+  VerifyRegularFaninMatch(conv_node, 0, input_transpose_node->GetName(), 0);
+  VerifyRegularFaninMatch(conv_node, 1, "Filter", 0);
+  VerifyDataFormatAttributeMatch(conv_node, "NCHW");
+
+  auto* output_transpose_node =
+      graph_view.GetNode("Conv2D-0-0-TransposeNCHWToNHWC-LayoutOptimizer");
+  ASSERT_NE(output_transpose_node, nullptr);
+  ASSERT_EQ(output_transpose_node->NumRegularFanins(), 2);
+  VerifyRegularFaninMatch(output_transpose_node, 0, conv_node->GetName(), 0);
+
+  auto* fetch_node = graph_view.GetNode("Fetch");
+  ASSERT_NE(fetch_node, nullptr);
+  ASSERT_EQ(fetch_node->NumRegularFanins(), 1);
+  VerifyRegularFaninMatch(fetch_node, 0, output_transpose_node->GetName(), 0);
+}
+
 TEST_F(GenericLayoutOptimizerTest, NoOptimizeIntegerConvolution) {
   tensorflow::Scope s = tensorflow::Scope::NewRootScope();
   auto conv = SimpleConv2D<int32>(&s, 4, 2, "VALID", "");
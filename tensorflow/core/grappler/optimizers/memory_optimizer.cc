@@ -30,7 +30,9 @@ limitations under the License.
 #include "tensorflow/core/grappler/clusters/virtual_cluster.h"
 #include "tensorflow/core/grappler/costs/graph_memory.h"
 #include "tensorflow/core/grappler/costs/graph_properties.h"
+#include "tensorflow/core/grappler/costs/op_level_cost_estimator.h"
 #include "tensorflow/core/grappler/costs/utils.h"
+#include "tensorflow/core/grappler/costs/virtual_placer.h"
 #include "tensorflow/core/grappler/graph_topology_view.h"
 #include "tensorflow/core/grappler/grappler_item.h"
 #include "tensorflow/core/grappler/mutable_graph_view.h"
@@ -43,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/str_util.h"
 #include "tensorflow/core/protobuf/rewriter_config.pb.h"
 #include "tensorflow/core/util/device_name_utils.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace grappler {
@@ -440,9 +443,218 @@ void RecomputeSubgraph(
   }
 }
 
+// Per-device recomputation memory budget in bytes. 0 means "use the memory
+// size the device reports", which is the same number the BFC allocator is
+// sized from.
+int64_t RecomputationMemoryBudgetBytes() {
+  static const int64_t budget_bytes = []() {
+    int64_t bytes;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_GRAPPLER_RECOMPUTATION_BUDGET_BYTES", 0,
+                                    &bytes));
+    return bytes;
+  }();
+  return budget_bytes;
+}
+
+// Predicts the execution cost of recomputing `node` using the analytical cost
+// model.
+Costs::NanoSeconds PredictRecomputeCost(const GraphProperties& properties,
+                                        const OpLevelCostEstimator& estimator,
+                                        const VirtualPlacer& placer,
+                                        const NodeDef& node) {
+  OpContext op_context;
+  op_context.op_info.set_op(node.op());
+  *op_context.op_info.mutable_attr() = node.attr();
+
+  std::vector<OpInfo::TensorProperties> inputs =
+      properties.GetInputProperties(node.name());
+  for (auto& input : inputs) {
+    op_context.op_info.add_inputs()->Swap(&input);
+  }
+  std::vector<OpInfo::TensorProperties> outputs =
+      properties.GetOutputProperties(node.name());
+  for (auto& output : outputs) {
+    op_context.op_info.add_outputs()->Swap(&output);
+  }
+
+  DeviceProperties device = placer.get_device(node);
+  op_context.op_info.mutable_device()->Swap(&device);
+
+  return std::max(estimator.PredictCosts(op_context).execution_time,
+                  Costs::NanoSeconds(1));
+}
+
+// Budget-driven recomputation planning. When the cluster reports device memory
+// sizes we know how far each device's peak usage is over budget, so instead of
+// recomputing every cheap subgraph we keep a min-recompute-cost subset whose
+// estimated savings cover the deficit, and recompute nothing at all when the
+// graph already fits. Returns false when planning is not possible (no cluster,
+// no memory or shape estimates); in that case all candidate subgraphs are kept
+// and the rewrite behaves as before.
+bool PlanRecomputationsAgainstMemoryBudget(
+    Cluster* cluster, const GrapplerItem& item,
+    std::vector<RecomputedSubGraph>* recomputed_subgraphs) {
+  if (cluster == nullptr || recomputed_subgraphs->empty()) {
+    return false;
+  }
+
+  const int64_t budget_override = RecomputationMemoryBudgetBytes();
+  std::unordered_map<string, int64_t> budgets;
+  for (const auto& device : cluster->GetDevices()) {
+    const DeviceProperties& prop = device.second;
+    if (budget_override > 0) {
+      budgets[device.first] = budget_override;
+    } else if (prop.memory_size() > 0) {
+      budgets[device.first] = prop.memory_size();
+    }
+  }
+  if (budgets.empty()) {
+    VLOG(1) << "Available memory unknown for every device: recomputing all "
+               "candidate subgraphs";
+    return false;
+  }
+
+  GraphMemory memory(item);
+  Status s = memory.InferStatically(cluster->GetDevices());
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer memory usage: " << s.message();
+    return false;
+  }
+  // How many bytes each device is over budget at its peak. The total acts as
+  // a shared pool for subgraphs whose device we can't match up (e.g. nodes
+  // without a device assignment).
+  std::unordered_map<string, int64_t> deficits;
+  int64_t total_deficit = 0;
+  for (const auto& budget : budgets) {
+    const GraphMemory::MemoryUsage& mem_usage =
+        memory.GetPeakMemoryUsage(budget.first);
+    const int64_t deficit = mem_usage.used_memory - budget.second;
+    if (deficit > 0) {
+      deficits[budget.first] = deficit;
+      total_deficit += deficit;
+    }
+  }
+  if (deficits.empty()) {
+    VLOG(1) << "Peak memory usage is within budget on every device: "
+            << "skipping recomputation of " << recomputed_subgraphs->size()
+            << " candidate subgraphs";
+    recomputed_subgraphs->clear();
+    return true;
+  }
+
+  GraphProperties properties(item);
+  s = properties.InferStatically(/*assume_valid_feeds=*/true,
+                                 /*aggressive_shape_inference=*/false,
+                                 /*include_tensor_values=*/false);
+  if (!s.ok()) {
+    VLOG(1) << "Failed to infer shapes: " << s.message();
+    return false;
+  }
+  OpLevelCostEstimator estimator;
+  VirtualPlacer placer(cluster->GetDevices());
+
+  // Estimate for every candidate subgraph the cost of recomputing its source
+  // nodes, and the activation bytes the recomputation releases: the source
+  // outputs consumed by target (gradient) nodes are the tensors that would
+  // otherwise stay live from the forward pass until the backward pass.
+  struct SubGraphPlan {
+    int index;
+    string device;
+    Costs::NanoSeconds recompute_cost;
+    int64_t bytes_saved;
+  };
+  std::vector<SubGraphPlan> plans;
+  const int num_subgraphs = recomputed_subgraphs->size();
+  for (int i = 0; i < num_subgraphs; ++i) {
+    const RecomputedSubGraph& subgraph = (*recomputed_subgraphs)[i];
+    SubGraphPlan plan;
+    plan.index = i;
+    plan.recompute_cost = 0;
+    plan.bytes_saved = 0;
+    std::unordered_set<string> source_names;
+    for (const NodeDef* source : subgraph.recomputed_source_nodes) {
+      if (plan.device.empty()) {
+        plan.device = source->device();
+      }
+      source_names.insert(source->name());
+      plan.recompute_cost +=
+          PredictRecomputeCost(properties, estimator, placer, *source);
+    }
+    std::set<string> saved_tensors;
+    for (const NodeDef* target : subgraph.target_nodes) {
+      for (const string& input : target->input()) {
+        if (!IsControlInput(input) &&
+            source_names.count(NodeName(input)) > 0) {
+          saved_tensors.insert(input);
+        }
+      }
+    }
+    for (const string& tensor : saved_tensors) {
+      int position;
+      const string node_name = ParseNodeName(tensor, &position);
+      const std::vector<OpInfo::TensorProperties>& props =
+          properties.GetOutputProperties(node_name);
+      if (position >= 0 && position < static_cast<int>(props.size())) {
+        plan.bytes_saved += CalculateTensorSize(props[position]);
+      }
+    }
+    plans.push_back(plan);
+  }
+
+  // Cheapest recomputation per byte saved first.
+  std::sort(plans.begin(), plans.end(),
+            [](const SubGraphPlan& first, const SubGraphPlan& second) {
+              return static_cast<double>(first.recompute_cost.count()) *
+                         second.bytes_saved <
+                     static_cast<double>(second.recompute_cost.count()) *
+                         first.bytes_saved;
+            });
+
+  std::unordered_set<int> selected;
+  for (const SubGraphPlan& plan : plans) {
+    if (plan.bytes_saved <= 0) {
+      continue;
+    }
+    auto it = deficits.find(plan.device);
+    if (it != deficits.end()) {
+      if (it->second <= 0) {
+        continue;
+      }
+      it->second -= plan.bytes_saved;
+      total_deficit -= plan.bytes_saved;
+    } else if (budgets.count(plan.device) > 0) {
+      // The device is under budget; recomputing would only waste compute.
+      continue;
+    } else {
+      if (total_deficit <= 0) {
+        continue;
+      }
+      total_deficit -= plan.bytes_saved;
+    }
+    VLOG(1) << "Will recompute a "
+            << (*recomputed_subgraphs)[plan.index]
+                   .recomputed_source_nodes.size()
+            << " node subgraph saving " << plan.bytes_saved
+            << " bytes at an estimated cost of " << plan.recompute_cost
+            << " on device '" << plan.device << "'";
+    selected.insert(plan.index);
+  }
+
+  std::vector<RecomputedSubGraph> planned_subgraphs;
+  planned_subgraphs.reserve(selected.size());
+  for (int i = 0; i < num_subgraphs; ++i) {
+    if (selected.count(i) > 0) {
+      planned_subgraphs.push_back(std::move((*recomputed_subgraphs)[i]));
+    }
+  }
+  recomputed_subgraphs->swap(planned_subgraphs);
+  return true;
+}
+
 void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
                                 const string& recomputation_targets_name_scope,
-                                GraphDef* graph, const GrapplerItem& item) {
+                                GraphDef* graph, const GrapplerItem& item,
+                                Cluster* cluster) {
   // The topological numberings and NodeMap will be stale as soon as we start
   // modifying the graph in RecomputeSubgraph. However, RecomputeSubgraph only
   // looks up nodes which were in the original graph, and preserves the graph
@@ -497,6 +709,13 @@ void RecomputationRewritingPass(RewriterConfig::MemOptType optimization_level,
         },
         is_target);
   }
+  if (optimization_level != RewriterConfig::MANUAL &&
+      !recomputed_subgraphs.empty() &&
+      PlanRecomputationsAgainstMemoryBudget(cluster, item,
+                                            &recomputed_subgraphs)) {
+    VLOG(1) << "Planned recomputation against the device memory budget: "
+            << recomputed_subgraphs.size() << " subgraphs selected";
+  }
   if (!recomputed_subgraphs.empty()) {
     std::unordered_map<const NodeDef*, int> topological_numbering;
     for (int node_number = 0; node_number < graph->node().size();
@@ -1397,7 +1616,7 @@ Status MemoryOptimizer::Optimize(Cluster* cluster, const GrapplerItem& item,
   if (run_recomputation_pass) {
     RecomputationRewritingPass(optimization_level_,
                                recomputation_targets_name_scope_,
-                               &optimized_item.graph, item);
+                               &optimized_item.graph, item, cluster);
   }
 
   std::unordered_set<string> skip_list;
@@ -19,7 +19,9 @@ limitations under the License.
 #include <functional>
 #include <string>
 #include <type_traits>
+#include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/status/status.h"
 #include "absl/strings/match.h"
@@ -61,9 +63,16 @@ limitations under the License.
 #include "tensorflow/core/grappler/utils/tpu.h"
 #include "tensorflow/core/grappler/verifiers/structure_verifier.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/map_util.h"
+#include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/lib/strings/proto_serialization.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/fingerprint.h"
 #include "tensorflow/core/platform/logging.h"
+#include "tensorflow/core/public/version.h"
 #include "tensorflow/core/util/dump_graph.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/util.h"
 #include "tensorflow/core/util/xla_config_registry.h"
 
@@ -888,7 +897,10 @@ Status MetaOptimizer::OptimizeGraph(
                                    }) != optimization_result.results.end();
 
   // Record graph optimization result.
-  optimization_results_.push_back(optimization_result);
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.push_back(optimization_result);
+  }
 
   if (is_optimized) {
     TF_RETURN_IF_ERROR(TopologicalSort(optimized_graph));
@@ -1048,6 +1060,62 @@ void PropagateTFDataAttrs(const FunctionLibraryDefinition& flib,
   }
 }
 
+namespace {
+
+// Number of threads used to optimize the reachable functions of one library
+// pass in parallel. Functions are independent of each other once the main
+// graph pass has run, so their optimization pipelines can proceed
+// concurrently; results are merged back into the library in deterministic
+// (library) order. 1 runs the old sequential loop.
+int64_t FunctionOptimizationThreads() {
+  static int64_t threads = []() {
+    int64_t result;
+    TF_CHECK_OK(tsl::ReadInt64FromEnvVar(
+        "TF_GRAPPLER_FUNCTION_OPTIMIZATION_THREADS", 4, &result));
+    return result;
+  }();
+  return threads;
+}
+
+bool FunctionOptimizationCacheEnabled() {
+  static bool enabled = []() {
+    bool result;
+    TF_CHECK_OK(tsl::ReadBoolFromEnvVar(
+        "TF_GRAPPLER_FUNCTION_OPTIMIZATION_CACHE", true, &result));
+    return result;
+  }();
+  return enabled;
+}
+
+// Process-wide cache of optimized function bodies. The key fingerprints the
+// function item's graph -- the body together with its reachable library -- and
+// the optimization context, so a hit can only occur when re-running the
+// pipeline would see byte-identical inputs. On warm model reloads the
+// function library is typically unchanged and the whole library pass becomes
+// a lookup.
+struct OptimizedFunctionEntry {
+  FunctionDef optimized_func;
+  // Specialized functions created for the body's instantiation contexts.
+  std::vector<FunctionDef> new_funcs;
+};
+
+struct OptimizedFunctionCache {
+  mutex mu;
+  std::unordered_map<uint64, OptimizedFunctionEntry> entries TF_GUARDED_BY(mu);
+};
+
+OptimizedFunctionCache* FunctionOptimizationCache() {
+  static OptimizedFunctionCache* cache = new OptimizedFunctionCache;
+  return cache;
+}
+
+// Bounds the cache; when full it is dropped wholesale, which is simpler than
+// an eviction order and fine for a cache whose entries arrive in batches of
+// whole function libraries.
+constexpr int kFunctionOptimizationCacheMaxEntries = 4096;
+
+}  // namespace
+
 Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
                                           GraphDef* optimized_graph) {
   tensorflow::metrics::ScopedCounter<2> timings(
@@ -1055,7 +1123,10 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       {kGrapplerCategory, "*"});
 
   VLOG(1) << "Starting optimization for grappler item: " << item.id;
-  optimization_results_.clear();
+  {
+    mutex_lock l(optimization_results_mu_);
+    optimization_results_.clear();
+  }
 
   // Constructs a FunctionLibraryDefinition with functions that are reachable
   // from the nodes of the graph.
@@ -1084,9 +1155,11 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       item.optimization_options().optimize_function_library;
   const auto producer = item.graph.versions().producer();
 
-  // 1. Optimize main graph
-  TF_RETURN_IF_ERROR(
-      OptimizeGraph(cluster, GrapplerItem(item), optimized_graph));
+  // 1. Optimize main graph. The graph is by far the largest part of the item,
+  // so hand it off to the optimization pipeline instead of copying it; the
+  // remaining (small) fields are still needed below to build the TFG item.
+  TF_RETURN_IF_ERROR(OptimizeGraph(
+      cluster, item.WithGraph(std::move(item.graph)), optimized_graph));
   VLOG(1) << "Optimized main graph.";
   GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
 
@@ -1166,13 +1239,16 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
   // Optimize each function only once.
   absl::flat_hash_set<string> optimized_funcs;
+  const uint64 cfg_fingerprint = Fingerprint64(cfg_.SerializeAsString());
   while (optimize_function_library) {
     optimize_function_library = false;
+    GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
 
-    int function_idx = 0;
+    // Collect the candidates of this pass up front; they are all optimized
+    // against the library as it stands at the start of the pass, which makes
+    // the per-function pipelines independent of each other.
+    std::vector<const FunctionDef*> candidates;
     for (const FunctionDef& func : optimized_graph->library().function()) {
-      GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
-
       const string& func_name = func.signature().name();
 
       // Skip functions that are not reachable from the optimized graph.
@@ -1193,18 +1269,36 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       if (data::IsTFDataFunction(func)) continue;
 
       VLOG(3) << "Optimize function: function=" << func_name << " ["
-              << function_idx++ << " of "
+              << candidates.size() << " of "
               << optimized_graph->library().function_size() << "]";
 
       // Function optimization might specialize nested function calls, so we
       // have to reset the flag and do at least one more pass over the library.
       optimize_function_library = true;
       optimized_funcs.insert(func_name);
+      candidates.push_back(&func);
+    }
+    if (candidates.empty()) break;
+
+    struct FunctionOptimizationResult {
+      Status status;
+      uint64 cache_key = 0;
+      bool from_cache = false;
+      FunctionDef optimized_func;
+      // Specialized functions created for the body's instantiation contexts.
+      std::vector<FunctionDef> new_funcs;
+    };
+    std::vector<FunctionOptimizationResult> results(candidates.size());
+
+    const auto optimize_function = [&](int candidate_idx) {
+      const FunctionDef& func = *candidates[candidate_idx];
+      FunctionOptimizationResult& result = results[candidate_idx];
+      const string& func_name = func.signature().name();
 
       // Make a GrapplerItem from a FunctionDef.
       GrapplerFunctionItem func_item;
-      TF_RETURN_IF_ERROR(
-          MakeGrapplerFunctionItem(func, flib, producer, &func_item));
+      result.status = MakeGrapplerFunctionItem(func, flib, producer, &func_item);
+      if (!result.status.ok()) return;
 
       // If we need to compute the gradient of optimized function at runtime, we
       // can't perform non-differentiable rewrites.
@@ -1216,7 +1310,9 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       // available to the main graph, because after partitioning the function
       // call node might execute on a remote worker.
       if (!func_item.devices().empty()) {
-        return errors::Internal("GrapplerFunctionItem devices must be empty.");
+        result.status =
+            errors::Internal("GrapplerFunctionItem devices must be empty.");
+        return;
       }
 
       // We are not allowed to prune certain types of ops from the graph
@@ -1226,6 +1322,32 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
       func_item.optimization_options().allow_pruning_stateful_and_dataset_ops =
           false;
 
+      if (FunctionOptimizationCacheEnabled()) {
+        // The function item's graph carries the body plus its reachable
+        // library, so the fingerprint covers every nested function the
+        // optimizers can see.
+        uint64 key = Fingerprint64(func_item.graph.SerializeAsString());
+        key = FingerprintCat64(key, cfg_fingerprint);
+        key = FingerprintCat64(key, producer);
+        key = FingerprintCat64(
+            key,
+            (func_item.optimization_options().allow_non_differentiable_rewrites
+                 ? 1
+                 : 0) |
+                (is_tpu_graph ? 2 : 0));
+        result.cache_key = key;
+        OptimizedFunctionCache* cache = FunctionOptimizationCache();
+        mutex_lock l(cache->mu);
+        auto it = cache->entries.find(key);
+        if (it != cache->entries.end()) {
+          VLOG(3) << "Reusing cached optimization of function " << func_name;
+          result.optimized_func = it->second.optimized_func;
+          result.new_funcs = it->second.new_funcs;
+          result.from_cache = true;
+          return;
+        }
+      }
+
       // Optimize function body graph.
       GraphDef optimized_func_graph;
       if (is_tpu_graph) {
@@ -1249,36 +1371,85 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
         *func_item.graph.mutable_library() =
             GetFunctionDefLibraryStub(*func_item_function_library);
 
-        TF_RETURN_IF_ERROR(implementation_selector.Optimize(
-            cluster, func_item, &optimized_func_graph));
+        result.status = implementation_selector.Optimize(cluster, func_item,
+                                                         &optimized_func_graph);
       } else {
+        // The body graph dominates the item's size, and `func_item` gets a
+        // fresh body from SwapFunctionBody below, so move the graph into the
+        // copy instead of duplicating it.
+        GraphDef func_body = std::move(func_item.graph);
         GrapplerFunctionItem func_item_copy = func_item;
-        TF_RETURN_IF_ERROR(OptimizeGraph(cluster, std::move(func_item_copy),
-                                         &optimized_func_graph));
+        func_item_copy.graph = std::move(func_body);
+        result.status = OptimizeGraph(cluster, std::move(func_item_copy),
+                                      &optimized_func_graph);
       }
+      if (!result.status.ok()) return;
 
       // Function body optimization might have created new specialized
-      // functions for each instantiation context. Add them to the library.
+      // functions for each instantiation context. Collect the ones not in the
+      // pass-start library so the merge below can add them.
       for (const FunctionDef& func_def :
            optimized_func_graph.library().function()) {
         if (flib.Find(func_def.signature().name()) == nullptr) {
-          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+          result.new_funcs.push_back(func_def);
         }
       }
 
-      // Convert optimized graph back to FunctionDef.
-      FunctionDef optimized_func;
+      // Convert optimized graph back to FunctionDef, resolving newly created
+      // specializations against a private extension of the library.
+      FunctionLibraryDefinition func_flib(flib);
+      for (const FunctionDef& func_def : result.new_funcs) {
+        result.status = func_flib.AddFunctionDef(func_def);
+        if (!result.status.ok()) return;
+      }
       func_item.SwapFunctionBody(std::move(optimized_func_graph));
-      TF_RETURN_IF_ERROR(MakeFunctionDef(func_item, flib, &optimized_func));
+      result.status = MakeFunctionDef(func_item, func_flib,
+                                      &result.optimized_func);
+      if (!result.status.ok()) return;
+
+      if (FunctionOptimizationCacheEnabled()) {
+        OptimizedFunctionCache* cache = FunctionOptimizationCache();
+        mutex_lock l(cache->mu);
+        if (cache->entries.size() >= kFunctionOptimizationCacheMaxEntries) {
+          cache->entries.clear();
+        }
+        cache->entries[result.cache_key] = {result.optimized_func,
+                                            result.new_funcs};
+      }
+    };
+
+    const int64_t num_threads =
+        std::min<int64_t>(FunctionOptimizationThreads(), candidates.size());
+    if (num_threads > 1) {
+      thread::ThreadPool pool(Env::Default(), "grappler_function_optimization",
+                              num_threads);
+      for (int i = 0; i < candidates.size(); ++i) {
+        pool.Schedule([&optimize_function, i]() { optimize_function(i); });
+      }
+      // ThreadPool joins all scheduled work on destruction.
+    } else {
+      for (int i = 0; i < candidates.size(); ++i) {
+        GRAPPLER_RETURN_IF_DEADLINE_EXCEEDED();
+        optimize_function(i);
+      }
+    }
 
+    // Merge the results back into the shared library in library order, so the
+    // outcome does not depend on scheduling.
+    for (int i = 0; i < candidates.size(); ++i) {
+      TF_RETURN_IF_ERROR(results[i].status);
+      for (const FunctionDef& func_def : results[i].new_funcs) {
+        if (flib.Find(func_def.signature().name()) == nullptr) {
+          TF_RETURN_IF_ERROR(flib.AddFunctionDef(func_def));
+        }
+      }
       // Replace optimized function with a new FunctionDef.
-      TF_RETURN_IF_ERROR(flib.ReplaceFunction(func_name, optimized_func));
+      TF_RETURN_IF_ERROR(flib.ReplaceFunction(
+          candidates[i]->signature().name(), results[i].optimized_func));
     }
 
-    // If optimized at least one function, update the graph library.
-    if (optimize_function_library) {
-      *optimized_graph->mutable_library() = flib.ToProto();
-    }
+    // Optimized at least one function, so update the graph library.
+    *optimized_graph->mutable_library() = flib.ToProto();
   }
 
   // Run module-level TFG optimizations at the end of the meta-optimizer.
@@ -1321,6 +1492,7 @@ Status MetaOptimizer::OptimizeConsumeItem(Cluster* cluster, GrapplerItem&& item,
 
 string MetaOptimizer::GetResultString() const {
   std::string result_string;
+  mutex_lock l(optimization_results_mu_);
   for (const GraphOptimizationResult& graph_result : optimization_results_) {
     absl::StrAppend(&result_string,
                     "Optimization results for grappler item: ", graph_result.id,
@@ -1366,14 +1538,93 @@ bool MetaOptimizerEnabled(const ConfigProto& cfg) {
          !rewrite_cfg.custom_optimizers().empty();
 }
 
+namespace {
+
+// Directory of a persistent cache of optimized graphs, keyed by a fingerprint
+// of the input graph and the optimization context. Empty disables the cache
+// (the default). With the cache enabled, a restarted process that loads an
+// unchanged model reuses the optimized graph written by the previous run
+// instead of re-running the whole optimization pipeline.
+const string& GraphOptimizationCacheDir() {
+  static const string* dir = []() {
+    string result;
+    TF_CHECK_OK(tsl::ReadStringFromEnvVar("TF_GRAPPLER_GRAPH_CACHE_DIR", "",
+                                          &result));
+    return new string(result);
+  }();
+  return *dir;
+}
+
+// Fingerprints everything that determines the optimizer output: the graph,
+// the rewriter configuration, the item's fetch/keep/device context and the
+// TensorFlow version. A cache that survives process restarts must not
+// survive binary or configuration changes.
+uint64 GraphOptimizationCacheKey(const GrapplerItem& item,
+                                 const ConfigProto& cfg) {
+  uint64 key = DeterministicProtoHash64(item.graph);
+  key = FingerprintCat64(
+      key, DeterministicProtoHash64(cfg.graph_options().rewrite_options()));
+  for (const string& fetch : item.fetch) {
+    key = FingerprintCat64(key, Fingerprint64(fetch));
+  }
+  for (const string& keep : item.keep_ops) {
+    key = FingerprintCat64(key, Fingerprint64(keep));
+  }
+  for (const string& device : item.devices()) {
+    key = FingerprintCat64(key, Fingerprint64(device));
+  }
+  const auto& opt_options = item.optimization_options();
+  key = FingerprintCat64(
+      key, (opt_options.allow_non_differentiable_rewrites ? 1 : 0) |
+               (opt_options.allow_pruning_stateful_and_dataset_ops ? 2 : 0) |
+               (opt_options.optimize_function_library ? 4 : 0) |
+               (opt_options.is_eager_mode ? 8 : 0));
+  return FingerprintCat64(key, Fingerprint64(TF_VERSION_STRING));
+}
+
+string GraphOptimizationCachePath(const string& cache_dir, uint64 key) {
+  return io::JoinPath(
+      cache_dir,
+      absl::StrCat("optimized_graph_", absl::Hex(key, absl::kZeroPad16), ".pb"));
+}
+
+}  // namespace
+
 Status RunMetaOptimizer(GrapplerItem&& item, const ConfigProto& cfg,
                         DeviceBase* cpu_device, Cluster* cluster,
                         GraphDef* optimized_graph) {
+  const string& cache_dir = GraphOptimizationCacheDir();
+  string cache_path;
+  if (!cache_dir.empty()) {
+    cache_path =
+        GraphOptimizationCachePath(cache_dir, GraphOptimizationCacheKey(item, cfg));
+    if (ReadBinaryProto(Env::Default(), cache_path, optimized_graph).ok()) {
+      VLOG(1) << "Reusing optimized graph from cache: " << cache_path;
+      return absl::OkStatus();
+    }
+    // A failed or partial read must not leak into the optimizer output.
+    optimized_graph->Clear();
+  }
+
   MetaOptimizer optimizer(cpu_device, cfg);
   optimizer.set_deadline_usec(
       DeadlineMicroSeconds(cfg.graph_options().rewrite_options()));
-  return optimizer.OptimizeConsumeItem(cluster, std::move(item),
-                                       optimized_graph);
+  TF_RETURN_IF_ERROR(optimizer.OptimizeConsumeItem(cluster, std::move(item),
+                                                   optimized_graph));
+
+  if (!cache_path.empty()) {
+    // Write-then-rename so concurrent processes sharing the cache directory
+    // only ever observe complete entries.
+    const string tmp_path =
+        absl::StrCat(cache_path, ".tmp.", Env::Default()->NowMicros());
+    Status s = WriteBinaryProto(Env::Default(), tmp_path, *optimized_graph);
+    if (s.ok()) s = Env::Default()->RenameFile(tmp_path, cache_path);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to write optimized graph cache entry "
+                   << cache_path << ": " << s;
+    }
+  }
+  return absl::OkStatus();
 }
 
 Status OptimizeGraph(
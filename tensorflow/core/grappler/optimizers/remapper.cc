@@ -92,6 +92,8 @@ constexpr char kFusedDepthwiseConv2dNative[] = "_FusedDepthwiseConv2dNative";
 constexpr char kFusedBatchNormEx[] = "_FusedBatchNormEx";
 constexpr char kFusedBatchNormGradEx[] = "_FusedBatchNormGradEx";
 constexpr char kTensorToHashBucket[] = "_TensorToHashBucketFast";
+constexpr char kFusedScaledDotProductAttention[] =
+    "_FusedScaledDotProductAttention";
 constexpr char kLeakyRelu[] = "LeakyRelu";
 constexpr char kMklFusedMish[] = "_MklFusedMish";
 constexpr char kRelu[] = "Relu";
@@ -388,6 +390,18 @@ bool BlasLtMatmulEnabled() {
   return is_enabled;
 }
 
+// The attention fusion replaces a differentiable subgraph with a CPU-only
+// forward kernel, so it stays opt-in for inference workloads.
+bool FusedAttentionEnabled() {
+  static bool is_enabled = [] {
+    bool is_enabled = false;
+    TF_CHECK_OK(tensorflow::ReadBoolFromEnvVar(
+        "TF_GRAPPLER_FUSE_ATTENTION", /*default_val=*/false, &is_enabled));
+    return is_enabled;
+  }();
+  return is_enabled;
+}
+
 bool IsGpuCompatibleDataFormat(const RemapperContext& ctx,
                                const NodeDef* conv2d) {
   DCHECK(IsConv2D(*conv2d)) << "Expected Conv2D op";
@@ -2956,6 +2970,130 @@ bool FindFusedBatchMatMul(RemapperContext* ctx, int node_index,
   return found_op_type_match;
 }
 
+// Matches the attention core softmax(QK^T * scale) V and rewrites it into
+// _FusedScaledDotProductAttention, whose CPU kernel runs a streaming softmax
+// over the score rows instead of materializing the score and softmax
+// matrices. Opt-in via TF_GRAPPLER_FUSE_ATTENTION.
+bool FindScaledDotProductAttention(RemapperContext* ctx, int node_index,
+                                   std::map<string, int>* matched_nodes_map,
+                                   std::set<int>* remove_node_indices,
+                                   std::vector<string>* input_node_names,
+                                   bool* scale_is_reciprocal) {
+  if (!FusedAttentionEnabled()) return false;
+
+  using utils::MatchingDirection;
+  using utils::NodeStatus;
+  // clang-format off
+  utils::OpTypePattern attention_pattern =
+    {"BatchMatMulV2", "output", NodeStatus::kReplace,
+      {
+        {"Softmax", "softmax", NodeStatus::kRemove,
+          {
+            {"Mul|Div", "scale", NodeStatus::kRemove,
+              {
+                {"BatchMatMulV2", "scores", NodeStatus::kRemove,
+                  {
+                    {"*", "query", NodeStatus::kRemain},
+                    {"*", "key", NodeStatus::kRemain}
+                  }
+                },
+                {"Const|Cast", "scale_value", NodeStatus::kRemain}
+              }
+            }
+          }
+        },
+        {"*", "value", NodeStatus::kRemain}
+      }
+    };
+  // clang-format on
+
+  utils::SubGraphMatcher<MatchingDirection::kFollowInputs> graph_matcher(
+      &(ctx->graph_view));
+  matched_nodes_map->clear();
+  remove_node_indices->clear();
+  if (!graph_matcher.GetMatchedNodes(attention_pattern, ctx->nodes_to_preserve,
+                                     ctx->graph_view.GetNode(node_index),
+                                     matched_nodes_map, remove_node_indices)) {
+    return false;
+  }
+
+  NodeDef* output_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("output"))->node();
+  if (!NodeIsOnCpu(output_node_def)) return false;
+  // The fused kernel is float only.
+  if (!HasDataType(output_node_def, DT_FLOAT)) return false;
+
+  // The kernel computes QK^T with contiguous key rows and a plain weighted
+  // sum of the value rows, i.e. the canonical attention layout.
+  const auto adjoint_attr = [](const NodeDef& node, const string& attr_name) {
+    auto attr = node.attr().find(attr_name);
+    return attr != node.attr().end() && attr->second.b();
+  };
+  NodeDef* scores_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scores"))->node();
+  if (adjoint_attr(*scores_node_def, "adj_x") ||
+      !adjoint_attr(*scores_node_def, "adj_y")) {
+    return false;
+  }
+  if (adjoint_attr(*output_node_def, "adj_x") ||
+      adjoint_attr(*output_node_def, "adj_y")) {
+    return false;
+  }
+
+  if (!ctx->inferred_graph_properties) {
+    Status s = ctx->graph_properties.InferStatically(
+        /*assume_valid_feeds=*/true,
+        /*aggressive_shape_inference=*/false,
+        /*include_input_tensor_values=*/false,
+        /*include_output_tensor_values=*/true);
+    if (!s.ok()) return false;
+    ctx->inferred_graph_properties = true;
+  }
+
+  // The scale must be a single coefficient.
+  NodeDef* scale_value_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scale_value"))->node();
+  auto scale_props =
+      ctx->graph_properties.GetOutputProperties(scale_value_node_def->name());
+  if (scale_props.empty() || NumCoefficients(scale_props[0].shape()) != 1) {
+    return false;
+  }
+
+  // BatchMatMulV2 broadcasts batch dimensions; the fused kernel does not.
+  // Require statically known, equal batch dimensions for Q, K and V.
+  const auto& scores_props =
+      ctx->graph_properties.GetInputProperties(scores_node_def->name());
+  const auto& output_props =
+      ctx->graph_properties.GetInputProperties(output_node_def->name());
+  if (scores_props.size() < 2 || output_props.size() < 2) return false;
+  const auto& query_shape = scores_props[0].shape();
+  const auto& key_shape = scores_props[1].shape();
+  const auto& value_shape = output_props[1].shape();
+  const int rank = Rank(query_shape);
+  if (rank < 2 || Rank(key_shape) != rank || Rank(value_shape) != rank) {
+    return false;
+  }
+  for (int dim = 0; dim < rank - 2; ++dim) {
+    const int64_t dim_size = query_shape.dim(dim).size();
+    if (dim_size < 0 || key_shape.dim(dim).size() != dim_size ||
+        value_shape.dim(dim).size() != dim_size) {
+      return false;
+    }
+  }
+
+  NodeDef* scale_node_def =
+      ctx->graph_view.GetNode(matched_nodes_map->at("scale"))->node();
+  *scale_is_reciprocal = IsAnyDiv(*scale_node_def);
+
+  input_node_names->clear();
+  input_node_names->resize(4);
+  input_node_names->at(0) = scores_node_def->input(0);
+  input_node_names->at(1) = scores_node_def->input(1);
+  input_node_names->at(2) = output_node_def->input(1);
+  input_node_names->at(3) = scale_value_node_def->name();
+  return true;
+}
+
 // Helper function to check if the reduction axes for a given input
 // shape align with instance normalization's mean computation.
 // Mean reduction axes for instance norm are expected to be:
@@ -4369,6 +4507,38 @@ Status AddFusedBatchMatMul(RemapperContext* ctx,
   return absl::OkStatus();
 }
 
+Status AddFusedScaledDotProductAttention(
+    RemapperContext* ctx, const std::map<string, int>& matched_nodes_map,
+    const std::set<int>& remove_node_indices,
+    const std::vector<string>& input_node_names,
+    std::vector<bool>* invalidated_nodes, std::vector<bool>* nodes_to_delete,
+    bool scale_is_reciprocal) {
+  auto* output_node =
+      ctx->graph_view.GetNode(matched_nodes_map.at("output"))->node();
+
+  NodeDef fused_node;
+  fused_node.set_name(output_node->name());
+  fused_node.set_op(kFusedScaledDotProductAttention);
+  fused_node.set_device(output_node->device());
+  for (const auto& name : input_node_names) fused_node.add_input(name);
+
+  auto* attr = fused_node.mutable_attr();
+  (*attr)["T"] = output_node->attr().at("T");
+  SetAttrValue(scale_is_reciprocal, &(*attr)["scale_is_reciprocal"]);
+
+  utils::Mutation* mutation = ctx->graph_view.GetMutationBuilder();
+  Status status;
+  mutation->AddNode(std::move(fused_node), &status);
+  TF_RETURN_IF_ERROR(status);
+  TF_RETURN_IF_ERROR(mutation->Apply());
+  (*invalidated_nodes)[matched_nodes_map.at("output")] = true;
+
+  for (const auto& node_idx : remove_node_indices) {
+    (*nodes_to_delete)[node_idx] = true;
+  }
+  return absl::OkStatus();
+}
+
 // Helper function to get data of type T from a given tensor and
 // return them in a vector and casted to type U.
 // Note - use this function only when type cast is safe from T to U.
@@ -5091,6 +5261,23 @@ Status Remapper::Optimize(Cluster* cluster, const GrapplerItem& item,
       continue;
     }
 
+    // Remap softmax(QK^T * scale) V into _FusedScaledDotProductAttention.
+    std::map<string, int> attention_matched_nodes_map;
+    std::set<int> attention_remove_node_indices;
+    std::vector<string> attention_input_node_names;
+    bool scale_is_reciprocal = false;
+    if (allow_non_differentiable_rewrites &&
+        FindScaledDotProductAttention(
+            &ctx, i, &attention_matched_nodes_map,
+            &attention_remove_node_indices, &attention_input_node_names,
+            &scale_is_reciprocal)) {
+      TF_RETURN_IF_ERROR(AddFusedScaledDotProductAttention(
+          &ctx, attention_matched_nodes_map, attention_remove_node_indices,
+          attention_input_node_names, &invalidated_nodes, &nodes_to_delete,
+          scale_is_reciprocal));
+      continue;
+    }
+
     // Fusions are disabled on XLA CPU in IsCpuCompatible(...) invoked by the
     // following fusions.
     //
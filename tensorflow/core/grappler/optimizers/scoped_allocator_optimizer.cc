@@ -345,6 +345,123 @@ void DumpGraphToVLOG(const GraphDef& graph, int log_level) {
   }
 }
 
+// Returns the set of all nodes that are transitively reachable via data or
+// control edges starting at `source_nodes`.  Stop at the boundary of a frame.
+Status TransitiveFanoutWithinFrame(
+    GraphDef* graph, NodeMap* node_map,
+    const std::vector<const NodeDef*>& source_nodes,
+    absl::flat_hash_set<const NodeDef*>* fanout) {
+  std::deque<const NodeDef*> queue(source_nodes.begin(), source_nodes.end());
+  absl::flat_hash_set<const NodeDef*> visited;
+  while (!queue.empty()) {
+    const NodeDef* node = queue.front();
+    queue.pop_front();
+    if (!visited.insert(node).second) {
+      continue;
+    }
+    fanout->insert(node);
+    for (const NodeDef* output : node_map->GetOutputs(node->name())) {
+      if (!ModifiesFrameInfo(*output)) {
+        queue.push_back(output);
+      }
+      VLOG(2) << "TransitiveFanout parent: " << node->name()
+              << " child: " << output->name() << " of type " << output->op();
+    }
+  }
+
+  return absl::OkStatus();
+}
+
+// Build the ScopedAllocator node that will be assigned to allocate
+// the output tensors of the input node set.
+Status ConstructScopedAllocatorNode(
+    ScopedAllocatorOptimizer* sa_opti, GraphDef* graph, NodeMap* node_map,
+    int expected_call_count, const string& device_name, DataType dtype,
+    int sa_id, const string& sa_name,
+    const std::vector<TensorShape>& input_shapes,
+    const std::vector<InputDesc>& inputs, const TensorShape& sa_shape) {
+  VLOG(2) << "ConstructScopedAllocatorNode " << sa_name;
+  NodeDefBuilder sa_builder(sa_name, "_ScopedAllocator");
+  sa_builder.Device(device_name);
+  sa_builder.Attr("sa_name", sa_name);
+  sa_builder.Attr("T", dtype);
+  sa_builder.Attr("id", sa_id);
+  sa_builder.Attr("shapes", input_shapes);
+  sa_builder.Attr("shape", sa_shape);
+  sa_builder.Attr("expected_call_count",
+                  static_cast<int64_t>(expected_call_count));
+  NodeDef* sa_node = graph->add_node();
+  LOG_WARNING_AND_RETURN_IF_ERROR(sa_builder.Finalize(sa_node));
+  node_map->AddNode(sa_name, sa_node);
+
+  std::vector<const NodeDef*> fanout_sources;
+  fanout_sources.reserve(inputs.size());
+  for (const auto& input : inputs) {
+    fanout_sources.push_back(input.from_node_def);
+  }
+  absl::flat_hash_set<const NodeDef*> fanout;
+  TF_RETURN_IF_ERROR(
+      TransitiveFanoutWithinFrame(graph, node_map, fanout_sources, &fanout));
+
+  // Add control edges from the ScopedAllocatorOp to all of the
+  // input nodes and mark them for allocation from backing tensor.
+  for (int i = 0, end = inputs.size(); i < end; ++i) {
+    auto& nd = inputs[i];
+    if (IsArg(*nd.from_node_def)) {
+      return errors::Aborted(
+          "ScopedAllocatorOptimizer does not work well when the op inputs "
+          "are _Arg ops; skipping this optimizer for this function");
+    }
+    VLOG(2) << "To input " << i << ": " << nd.from_node_def->name()
+            << " add control input "
+            << "^" << sa_name;
+    nd.from_node_def->add_input(strings::StrCat("^", sa_name));
+    // This attribute says: allocate output_slot from
+    // ScopedAllocator instance sa_id + 1 + i.
+    ScopedAllocatorOptimizer::ExtendNodeAttr(kScopedAllocatorAttrName,
+                                             {nd.output_slot, sa_id + 1 + i},
+                                             nd.from_node_def);
+    node_map->AddOutput(sa_name, nd.from_node_def->name());
+  }
+
+  // We add control edges in order to (1) delay execution of the
+  // ScopedAllocatorOp until just before first use in order to conserve memory
+  // (2) ensure correctness in the presence of control flow related ops.
+  bool added_delay_edge = false;
+  for (auto& nd : inputs) {
+    std::vector<InputDesc> inputs_to_first;
+    LOG_WARNING_AND_RETURN_IF_ERROR(GetDataInputs(
+        graph, sa_opti->node_map(), nd.from_node_def, &inputs_to_first));
+    for (int i = 0, end = inputs_to_first.size(); i < end; ++i) {
+      if (fanout.find(inputs_to_first[i].from_node_def) != fanout.end()) {
+        VLOG(2) << "Found node " << inputs_to_first[i].from_node_def->name()
+                << " in the fanout of " << sa_name;
+        continue;
+      }
+      sa_node->add_input(
+          strings::StrCat("^", inputs_to_first[i].from_node_def->name()));
+      node_map->AddOutput(inputs_to_first[i].from_node_def->name(), sa_name);
+      added_delay_edge = true;
+      VLOG(2) << "Adding control dependency from "
+              << inputs_to_first[i].from_node_def->name() << " to "
+              << sa_node->name();
+      break;
+    }
+    if (added_delay_edge) {
+      break;
+    }
+  }
+
+  if (!added_delay_edge) {
+    LOG(WARNING) << "Found no node from which a control edge can be added to "
+                    "scoped allocator node.  If you run into issues with "
+                    "graphs that contain control flow, turn off the "
+                    "ScopedAllocatorOptimizer and file a bug.";
+  }
+
+  return absl::OkStatus();
+}
+
 }  // namespace
 
 void ScopedAllocatorOptimizer::ExtendNodeAttr(StringPiece name,
@@ -481,122 +598,6 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
     return absl::OkStatus();
   }
 
-  // Returns the set of all nodes that are transitively reachable via data or
-  // control edges starting at `source_nodes`.  Stop at the boundary of a frame.
-  Status TransitiveFanoutWithinFrame(
-      GraphDef* graph, NodeMap* node_map,
-      const std::vector<const NodeDef*>& source_nodes,
-      absl::flat_hash_set<const NodeDef*>* fanout) {
-    std::deque<const NodeDef*> queue(source_nodes.begin(), source_nodes.end());
-    absl::flat_hash_set<const NodeDef*> visited;
-    while (!queue.empty()) {
-      const NodeDef* node = queue.front();
-      queue.pop_front();
-      if (!visited.insert(node).second) {
-        continue;
-      }
-      fanout->insert(node);
-      for (const NodeDef* output : node_map->GetOutputs(node->name())) {
-        if (!ModifiesFrameInfo(*output)) {
-          queue.push_back(output);
-        }
-        VLOG(2) << "TransitiveFanout parent: " << node->name()
-                << " child: " << output->name() << " of type " << output->op();
-      }
-    }
-
-    return absl::OkStatus();
-  }
-
-  // Build the ScopedAllocator node that will be assigned to allocate
-  // the output tensors of the input node set.
-  Status ConstructScopedAllocatorNode(
-      ScopedAllocatorOptimizer* sa_opti, GraphDef* graph, NodeMap* node_map,
-      const std::vector<NodeDef*>& ops, const string& device_name,
-      DataType dtype, int sa_id, const string& sa_name,
-      const std::vector<TensorShape>& input_shapes,
-      const std::vector<InputDesc>& inputs, const TensorShape& sa_shape) {
-    VLOG(2) << "ConstructScopedAllocatorNode " << sa_name;
-    NodeDefBuilder sa_builder(sa_name, "_ScopedAllocator");
-    sa_builder.Device(device_name);
-    sa_builder.Attr("sa_name", sa_name);
-    sa_builder.Attr("T", dtype);
-    sa_builder.Attr("id", sa_id);
-    sa_builder.Attr("shapes", input_shapes);
-    sa_builder.Attr("shape", sa_shape);
-    sa_builder.Attr("expected_call_count", static_cast<int64_t>(ops.size()));
-    NodeDef* sa_node = graph->add_node();
-    LOG_WARNING_AND_RETURN_IF_ERROR(sa_builder.Finalize(sa_node));
-    node_map->AddNode(sa_name, sa_node);
-
-    std::vector<const NodeDef*> fanout_sources;
-    fanout_sources.reserve(inputs.size());
-    for (const auto& input : inputs) {
-      fanout_sources.push_back(input.from_node_def);
-    }
-    absl::flat_hash_set<const NodeDef*> fanout;
-    TF_RETURN_IF_ERROR(
-        TransitiveFanoutWithinFrame(graph, node_map, fanout_sources, &fanout));
-
-    // Add control edges from the ScopedAllocatorOp to all of the
-    // input nodes and mark them for allocation from backing tensor.
-    for (int i = 0, end = inputs.size(); i < end; ++i) {
-      auto& nd = inputs[i];
-      if (IsArg(*nd.from_node_def)) {
-        return errors::Aborted(
-            "ScopedAllocatorOptimizer does not work well when the op inputs "
-            "are _Arg ops; skipping this optimizer for this function");
-      }
-      VLOG(2) << "To input " << i << ": " << nd.from_node_def->name()
-              << " add control input "
-              << "^" << sa_name;
-      nd.from_node_def->add_input(strings::StrCat("^", sa_name));
-      // This attribute says: allocate output_slot from
-      // ScopedAllocator instance sa_id + 1 + i.
-      ScopedAllocatorOptimizer::ExtendNodeAttr(kScopedAllocatorAttrName,
-                                               {nd.output_slot, sa_id + 1 + i},
-                                               nd.from_node_def);
-      node_map->AddOutput(sa_name, nd.from_node_def->name());
-    }
-
-    // We add control edges in order to (1) delay execution of the
-    // ScopedAllocatorOp until just before first use in order to conserve memory
-    // (2) ensure correctness in the presence of control flow related ops.
-    bool added_delay_edge = false;
-    for (auto& nd : inputs) {
-      std::vector<InputDesc> inputs_to_first;
-      LOG_WARNING_AND_RETURN_IF_ERROR(GetDataInputs(
-          graph, sa_opti->node_map(), nd.from_node_def, &inputs_to_first));
-      for (int i = 0, end = inputs_to_first.size(); i < end; ++i) {
-        if (fanout.find(inputs_to_first[i].from_node_def) != fanout.end()) {
-          VLOG(2) << "Found node " << inputs_to_first[i].from_node_def->name()
-                  << " in the fanout of " << sa_name;
-          continue;
-        }
-        sa_node->add_input(
-            strings::StrCat("^", inputs_to_first[i].from_node_def->name()));
-        node_map->AddOutput(inputs_to_first[i].from_node_def->name(), sa_name);
-        added_delay_edge = true;
-        VLOG(2) << "Adding control dependency from "
-                << inputs_to_first[i].from_node_def->name() << " to "
-                << sa_node->name();
-        break;
-      }
-      if (added_delay_edge) {
-        break;
-      }
-    }
-
-    if (!added_delay_edge) {
-      LOG(WARNING) << "Found no node from which a control edge can be added to "
-                      "scoped allocator node.  If you run into issues with "
-                      "graphs that contain control flow, turn off the "
-                      "ScopedAllocatorOptimizer and file a bug.";
-    }
-
-    return absl::OkStatus();
-  }
-
   Status BuildSAConcatNode(GraphDef* graph, NodeMap* node_map,
                            const std::vector<NodeDef*>& ops,
                            const std::set<string>& op_instance_names,
@@ -855,8 +856,8 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
     string sa_name =
         strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
     TF_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
-        sa_opti, graph, node_map, ops, device_name, dtype, sa_id, sa_name,
-        input_shapes, inputs, sa_shape));
+        sa_opti, graph, node_map, /*expected_call_count=*/ops.size(),
+        device_name, dtype, sa_id, sa_name, input_shapes, inputs, sa_shape));
 
     // Build a ScopedAllocatorConcat below all of the input nodes.
     std::vector<NodeDefBuilder::NodeOut> sac_inputs;
@@ -889,12 +890,311 @@ class UnaryElementwiseRewriter : public ScopedAllocatorOptimizer::Rewriter {
   }
 };
 
+// Coalesces the inputs of a ConcatV2 node into a single ScopedAllocator
+// backing tensor.  The upstream ops are annotated to allocate their outputs
+// at the appropriate offsets within the backing tensor and the ConcatV2 node
+// is replaced by a _ScopedAllocatorConcat, which merely reinterprets the
+// backing tensor as the concatenated result, eliminating a copy of every
+// input.  Unlike UnaryElementwiseRewriter, each node is an independent
+// rewrite opportunity: the siblings being coalesced are the inputs of one
+// ConcatV2, not the node set itself.
+class ConcatCoalescingRewriter : public ScopedAllocatorOptimizer::Rewriter {
+ public:
+  ~ConcatCoalescingRewriter() override {}
+
+  int MinGroupSize() const override { return 1; }
+
+  // Extracts the axis argument of `concat`, which must be a constant scalar
+  // for the rewrite to apply.
+  Status GetConcatAxis(NodeMap* node_map, const NodeDef& concat,
+                       int num_data_inputs, int64_t* axis) {
+    if (concat.input_size() < num_data_inputs + 1) {
+      return errors::Internal("Node ", concat.name(), " has ",
+                              concat.input_size(), " inputs, expected at least ",
+                              num_data_inputs + 1);
+    }
+    int position = 0;
+    string axis_node_name =
+        ParseNodeName(concat.input(num_data_inputs), &position);
+    NodeDef* axis_node = node_map->GetNode(axis_node_name);
+    if (axis_node == nullptr) {
+      return errors::Internal("Did not find node ", axis_node_name);
+    }
+    if (!IsConstant(*axis_node)) {
+      return errors::Aborted("Axis of ", concat.name(), " is not a constant");
+    }
+    Tensor axis_tensor;
+    TF_RETURN_IF_ERROR(
+        GetNodeAttr(AttrSlice(*axis_node), "value", &axis_tensor));
+    if (axis_tensor.NumElements() != 1 ||
+        (axis_tensor.dtype() != DT_INT32 && axis_tensor.dtype() != DT_INT64)) {
+      return errors::Aborted("Axis of ", concat.name(),
+                             " is not an integer scalar");
+    }
+    *axis = axis_tensor.dtype() == DT_INT64
+                ? axis_tensor.scalar<int64_t>()()
+                : static_cast<int64_t>(axis_tensor.scalar<int32>()());
+    return absl::OkStatus();
+  }
+
+  // Decides whether the inputs of `concat` can all be allocated from a
+  // single backing tensor of which the concat output is a dense view.  On
+  // success populates the input descriptors and shapes, the concat output
+  // shape, and the 1D shape of the backing tensor.
+  Status AnalyzeConcat(ScopedAllocatorOptimizer* sa_opti, NodeMap* node_map,
+                       NodeDef* concat, DataType* dtype,
+                       std::vector<InputDesc>* inputs,
+                       std::vector<TensorShape>* input_shapes,
+                       TensorShape* concat_shape, TensorShape* sa_shape) {
+    CHECK(graph_properties_);
+    if (sa_opti->nodes_to_preserve().find(concat->name()) !=
+        sa_opti->nodes_to_preserve().end()) {
+      return errors::Aborted("Node ", concat->name(), " must be preserved");
+    }
+    TF_RETURN_IF_ERROR(GetNodeAttr(AttrSlice(*concat), "T", dtype));
+    if (Allocator::kAllocatorAlignment % DataTypeSize(*dtype) != 0) {
+      return errors::Aborted("Type ", DataTypeString(*dtype),
+                             " does not evenly divide kAllocatorAlignment");
+    }
+    int32_t num_data_inputs = 0;
+    TF_RETURN_IF_ERROR(GetNodeAttr(AttrSlice(*concat), "N", &num_data_inputs));
+    if (num_data_inputs < 2) {
+      return errors::Aborted("Too few inputs to be worth coalescing");
+    }
+    int64_t axis = -1;
+    TF_RETURN_IF_ERROR(
+        GetConcatAxis(node_map, *concat, num_data_inputs, &axis));
+    if (axis != 0) {
+      return errors::Aborted(
+          "Only axis 0 concatenation matches the layout of a ScopedAllocator "
+          "backing tensor");
+    }
+    absl::flat_hash_set<string> edge_names;
+    for (int i = 0; i < num_data_inputs; ++i) {
+      const string& edge_name = concat->input(i);
+      if (!edge_names.insert(edge_name).second) {
+        return errors::Aborted("Input ", edge_name,
+                               " feeds the concat more than once");
+      }
+      int output_slot = 0;
+      string producer_name = ParseNodeName(edge_name, &output_slot);
+      NodeDef* producer = node_map->GetNode(producer_name);
+      if (producer == nullptr) {
+        return errors::Internal("Did not find node ", producer_name);
+      }
+      if (producer->device() != concat->device()) {
+        return errors::Aborted("Input ", producer_name,
+                               " is not on the concat's device");
+      }
+      if (IsConstant(*producer)) {
+        return errors::Aborted(
+            "Input ", producer_name,
+            " is a Const op which does not use AllocatorAttributes");
+      }
+      if (IsArg(*producer) || ModifiesFrameInfo(*producer)) {
+        return errors::Aborted("Input ", producer_name,
+                               " cannot allocate from a ScopedAllocator");
+      }
+      // Check whether this output is already committed to another
+      // ScopedAllocator.
+      std::vector<int32> scope_ids;
+      Status ss = GetNodeAttr(AttrSlice(*producer), kScopedAllocatorAttrName,
+                              &scope_ids);
+      if (ss.ok()) {
+        for (int si = 0; si + 1 < static_cast<int>(scope_ids.size());
+             si += 2) {
+          if (scope_ids[si] == output_slot) {
+            return errors::Aborted("Input ", producer_name, " output ",
+                                   output_slot,
+                                   " is already assigned to scope_id ",
+                                   scope_ids[si + 1]);
+          }
+        }
+      }
+      if (!graph_properties_->HasOutputProperties(producer_name)) {
+        return errors::Aborted("Node ", producer_name, " lacks output shape");
+      }
+      const std::vector<OpInfo::TensorProperties>& prop_list =
+          graph_properties_->GetOutputProperties(producer_name);
+      if (output_slot >= static_cast<int>(prop_list.size())) {
+        return errors::Internal("Node ", producer_name,
+                                " lacks output properties for slot ",
+                                output_slot);
+      }
+      const OpInfo::TensorProperties& props = prop_list[output_slot];
+      if (props.dtype() != *dtype) {
+        return errors::Aborted("Input ", producer_name,
+                               " does not have the concat's type");
+      }
+      if (!TensorShape::IsValid(props.shape()) ||
+          props.shape().unknown_rank()) {
+        return errors::Aborted("Complete shape not known for ", producer_name);
+      }
+      TensorShape shape(props.shape());
+      if (shape.dims() == 0 || shape.num_elements() <= 0) {
+        return errors::Aborted("Input ", producer_name,
+                               " has a scalar or empty shape");
+      }
+      // Fields of a backing tensor are aligned to kAllocatorAlignment, and
+      // the concat output is a dense view of that tensor, so every input
+      // must occupy a whole number of alignment units; otherwise padding
+      // would appear between the concatenated values.
+      if ((shape.num_elements() * DataTypeSize(*dtype)) %
+              Allocator::kAllocatorAlignment !=
+          0) {
+        return errors::Aborted("Byte size of input ", producer_name,
+                               " is not a multiple of kAllocatorAlignment");
+      }
+      if (input_shapes->empty()) {
+        *concat_shape = shape;
+      } else {
+        const TensorShape& first = (*input_shapes)[0];
+        if (shape.dims() != first.dims()) {
+          return errors::Aborted("Input ", producer_name,
+                                 " rank differs from first input");
+        }
+        for (int d = 1; d < shape.dims(); ++d) {
+          if (shape.dim_size(d) != first.dim_size(d)) {
+            return errors::Aborted("Input ", producer_name,
+                                   " trailing dims differ from first input");
+          }
+        }
+        concat_shape->set_dim(0,
+                              concat_shape->dim_size(0) + shape.dim_size(0));
+      }
+      input_shapes->push_back(shape);
+      inputs->emplace_back(producer, output_slot, concat);
+    }
+    std::vector<ScopedAllocator::Field> sa_fields;
+    int64_t num_bytes = ScopedAllocatorMgr::PopulateFields(
+        0 /*scope_id*/, *input_shapes, *dtype, &sa_fields);
+    int64_t num_elts = num_bytes / DataTypeSize(*dtype);
+    if (num_elts != concat_shape->num_elements()) {
+      // Should be impossible given the alignment checks above, but the
+      // kernel would CHECK-fail on a mismatched reshape, so double-check.
+      return errors::Internal("Backing tensor with ", num_elts,
+                              " elements cannot be viewed as concat output "
+                              "with ",
+                              concat_shape->num_elements(), " elements");
+    }
+    *sa_shape = TensorShape({num_elts});
+    return absl::OkStatus();
+  }
+
+  // Rewrites a single eligible ConcatV2 node; leaves ineligible nodes
+  // untouched.
+  Status MaybeRewriteConcat(ScopedAllocatorOptimizer* sa_opti,
+                            int64_t invocation_count, GraphDef* graph,
+                            NodeMap* node_map, NodeDef* concat,
+                            bool* applied) {
+    DataType dtype = DT_INVALID;
+    std::vector<InputDesc> inputs;
+    std::vector<TensorShape> input_shapes;
+    TensorShape concat_shape;
+    TensorShape sa_shape;
+    Status eligible = AnalyzeConcat(sa_opti, node_map, concat, &dtype, &inputs,
+                                    &input_shapes, &concat_shape, &sa_shape);
+    if (!eligible.ok()) {
+      VLOG(1) << "Not coalescing inputs of " << concat->name() << ": "
+              << eligible.message();
+      return absl::OkStatus();
+    }
+
+    const string device_name = concat->device();
+    int sa_id = sa_opti->NewScopedAllocatorId(inputs.size());
+    string sa_name =
+        strings::StrCat("scoped_allocator_", sa_id, "_", invocation_count);
+    TF_RETURN_IF_ERROR(ConstructScopedAllocatorNode(
+        sa_opti, graph, node_map, /*expected_call_count=*/inputs.size(),
+        device_name, dtype, sa_id, sa_name, input_shapes, inputs, sa_shape));
+
+    // Build the _ScopedAllocatorConcat that takes the place of `concat`.
+    // Unlike the fusion case, the output keeps concat semantics for
+    // downstream consumers, so the backing tensor is reshaped to the true
+    // concatenated shape.
+    string sac_name = strings::StrCat("scoped_allocator_concat_", sa_id, "_",
+                                      invocation_count);
+    NodeDefBuilder sac_builder(sac_name, "_ScopedAllocatorConcat");
+    sac_builder.Device(device_name);
+    sac_builder.Attr("sa_name", sa_name);
+    sac_builder.Attr("id", sa_id);
+    sac_builder.Attr("T", dtype);
+    sac_builder.Attr("shape", concat_shape);
+    sac_builder.Attr("reshape", true);
+    sac_builder.Attr("N", static_cast<int>(inputs.size()));
+    sac_builder.Input(NodeDefBuilder::NodeOut(sa_name, 0, dtype));
+    std::vector<NodeDefBuilder::NodeOut> sac_inputs;
+    sac_inputs.reserve(inputs.size());
+    for (const InputDesc& nd : inputs) {
+      sac_inputs.push_back(NodeDefBuilder::NodeOut(nd.from_node_def->name(),
+                                                   nd.output_slot, dtype));
+    }
+    sac_builder.Input(sac_inputs);
+    NodeDef* sac_node = graph->add_node();
+    LOG_WARNING_AND_RETURN_IF_ERROR(sac_builder.Finalize(sac_node));
+    node_map->AddNode(sac_name, sac_node);
+    node_map->AddOutput(sa_name, sac_name);
+    for (const InputDesc& nd : inputs) {
+      node_map->AddOutput(nd.from_node_def->name(), sac_name);
+    }
+    // Carry over any control inputs of the old concat node.
+    for (const string& old_input : concat->input()) {
+      if (IsControlInput(old_input)) {
+        sac_node->add_input(old_input);
+        int position = 0;
+        node_map->AddOutput(ParseNodeName(old_input, &position), sac_name);
+      }
+    }
+
+    // Redirect the consumers of the old concat node to the new one, then
+    // remove it.  The constant axis input stays behind; if nothing else
+    // reads it, dependency pruning will clean it up.
+    auto output_nodes = node_map->GetOutputs(concat->name());
+    for (NodeDef* n : output_nodes) {
+      for (int i = 0; i < n->input_size(); ++i) {
+        int position = 0;
+        if (ParseNodeName(n->input(i), &position) == concat->name()) {
+          if (position == -1) {
+            *n->mutable_input(i) = strings::StrCat("^", sac_name);
+          } else {
+            CHECK_EQ(position, 0) << "unexpected output slot " << position
+                                  << " of " << concat->name();
+            *n->mutable_input(i) = sac_name;
+          }
+          node_map->UpdateInput(n->name(), concat->name(), sac_name);
+        }
+      }
+    }
+    node_map->RemoveInputs(concat->name());
+    node_map->RemoveOutputs(concat->name());
+    RemoveNode(concat, graph, node_map);
+
+    VLOG(1) << "Coalesced " << inputs.size() << " inputs of " << sac_name
+            << " into backing tensor " << sa_name;
+    *applied = true;
+    return absl::OkStatus();
+  }
+
+  Status Rewrite(ScopedAllocatorOptimizer* sa_opti, int64_t invocation_count,
+                 GraphDef* graph, const string& op_name,
+                 const std::vector<NodeDef*>& ops, bool* applied) override {
+    NodeMap* node_map = sa_opti->node_map();
+    for (NodeDef* concat : ops) {
+      LOG_WARNING_AND_RETURN_IF_ERROR(MaybeRewriteConcat(
+          sa_opti, invocation_count, graph, node_map, concat, applied));
+    }
+    return absl::OkStatus();
+  }
+};
+
 ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
     RewriterConfig::Toggle opt_level, const ScopedAllocatorOptions& opts)
     : opt_level_(opt_level) {
   VLOG(1) << "ScopedAllocatorOptimizer::ScopedAllocatorOptimizer";
   Rewriter* r = new UnaryElementwiseRewriter();
   to_delete_.push_back(r);
+  Rewriter* concat_rewriter = new ConcatCoalescingRewriter();
+  to_delete_.push_back(concat_rewriter);
   if (opts.enable_op_size() == 0) {
     // Opts handled by default:
     for (const auto& op_name : {"CollectiveReduce"}) {
@@ -904,7 +1204,9 @@ ScopedAllocatorOptimizer::ScopedAllocatorOptimizer(
   } else {
     for (const auto& op_name : opts.enable_op()) {
       op_name_set_.insert(op_name);
-      rewriters_[op_name] = r;
+      // ConcatV2 is handled by coalescing the inputs of each node rather
+      // than by fusing a set of parallel nodes.
+      rewriters_[op_name] = op_name == "ConcatV2" ? concat_rewriter : r;
     }
   }
 }
@@ -1127,11 +1429,12 @@ Status ScopedAllocatorOptimizer::ProcessGraphDef(
                                          &op_name, invocation_count](Tree* t) {
           VLOG(2) << "applied to tree node " << t->edge_ << " at depth "
                   << t->depth_ << " of size " << t->nodes_.size();
-          if (t->nodes_.size() > 1) {
+          const int min_group_size = rewriter->MinGroupSize();
+          if (static_cast<int>(t->nodes_.size()) >= min_group_size) {
             std::vector<std::vector<NodeDef*>> loop_groups;
             PartitionByLoopStructure(frame_view, t->nodes_, &loop_groups);
             for (auto& lg : loop_groups) {
-              if (lg.size() > 1) {
+              if (static_cast<int>(lg.size()) >= min_group_size) {
                 bool applied = false;
                 Status s = OrderNodeSet(&lg);
                 TF_RETURN_IF_ERROR(s);
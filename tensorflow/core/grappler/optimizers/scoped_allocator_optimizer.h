@@ -76,6 +76,10 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
     return repeated_outputs_;
   }
 
+  const std::unordered_set<string>& nodes_to_preserve() const {
+    return nodes_to_preserve_;
+  }
+
   // Appends values to the attr value under name in node_def, if present.
   // If not present does an assignment.
   static void ExtendNodeAttr(StringPiece name, const std::vector<int32>& values,
@@ -93,6 +97,12 @@ class ScopedAllocatorOptimizer : public GraphOptimizer {
                            const std::vector<NodeDef*>& nodes,
                            bool* applied) = 0;
 
+    // Minimum number of nodes of the target op that must occur together for
+    // Rewrite to be worth calling.  Rewriters that fuse a set of sibling
+    // nodes need at least two; rewriters that process each node
+    // independently can accept a single occurrence.
+    virtual int MinGroupSize() const { return 2; }
+
     void SetGraphProperties(const GraphProperties& graph_properties) {
       graph_properties_ = &graph_properties;
       CHECK(graph_properties_);
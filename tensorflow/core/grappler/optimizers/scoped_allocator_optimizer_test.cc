@@ -267,6 +267,40 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     TF_CHECK_OK(s.ToGraphDef(graph_def));
   }
 
+  // Constructs the following graph.
+  //
+  // a1 and a2 are Abs ops feeding an axis 0 ConcatV2.  r is an Identity
+  // consuming the concat.  Each Abs output occupies 64 bytes (16 floats), so
+  // the two outputs can be coalesced into a ScopedAllocator backing tensor
+  // with no padding between them and the ConcatV2 replaced with a view.
+  /*
+         a    b
+         |    |
+         a1   a2
+          \  /
+         concat
+           |
+           r
+  */
+  void BuildConcatGraph(GraphDef* graph_def) {
+    Scope s = Scope::NewRootScope();
+    s = s.WithDevice("/job:localhost/replica:0/task:0/device:CPU:0");
+
+    std::vector<float> a_vals(16);
+    std::vector<float> b_vals(16);
+    for (int i = 0; i < 16; ++i) {
+      a_vals[i] = -static_cast<float>(i);
+      b_vals[i] = static_cast<float>(i) - 16.0f;
+    }
+    Output a = ops::Const<float>(s.WithOpName("a"), a_vals, {2, 8});
+    Output b = ops::Const<float>(s.WithOpName("b"), b_vals, {2, 8});
+    Output a1 = ops::Abs(s.WithOpName("a1"), a);
+    Output a2 = ops::Abs(s.WithOpName("a2"), b);
+    Output concat = ops::Concat(s.WithOpName("concat"), {a1, a2}, 0);
+    Output r = ops::Identity(s.WithOpName("r"), concat);
+    TF_CHECK_OK(s.ToGraphDef(graph_def));
+  }
+
   void SetShapes(GraphDef* graph_def) {
     TensorShapeProto shape_proto;
     shape_proto.add_dim()->set_size(2);
@@ -283,7 +317,8 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
   // returns the outputs specified by `output_names` in `outputs`.
   void ExecuteGraph(const GraphDef& graph_def,
                     const std::vector<string>& output_names,
-                    std::vector<Tensor>* outputs) {
+                    std::vector<Tensor>* outputs,
+                    const string& enable_op = "Abs") {
     // Turn off all optimization except the ScopedAllocatorOptimizer
     // to avoid anything that would alter the expected graph input/output,
     // e.g. by constant folding away all calculations.
@@ -297,7 +332,7 @@ class ScopedAllocatorOptimizerTest : public ::testing::Test {
     RewriterConfig* rwcfg = gopt->mutable_rewrite_options();
     rwcfg->clear_optimizers();
     (*rwcfg->add_optimizers()) = "scoped_allocator";
-    rwcfg->mutable_scoped_allocator_opts()->add_enable_op("Abs");
+    rwcfg->mutable_scoped_allocator_opts()->add_enable_op(enable_op);
     std::unique_ptr<Session> session(CreateSession(graph_def, config));
 
     std::vector<std::pair<string, Tensor>> inputs;
@@ -596,6 +631,67 @@ TEST_F(ScopedAllocatorOptimizerTest, ConstInput) {
   }
   EXPECT_EQ(num_identity_ops, 2);
 }
+
+// Tests that the inputs of an axis 0 ConcatV2 are coalesced into a
+// ScopedAllocator backing tensor and the concat replaced with a view.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatCoalescingRewrite) {
+  GrapplerItem item;
+  BuildConcatGraph(&item.graph);
+
+  ScopedAllocatorOptions opts;
+  opts.add_enable_op("ConcatV2");
+  ScopedAllocatorOptimizer sao(RewriterConfig::ON, opts);
+
+  GraphDef optimized_graph;
+  TF_ASSERT_OK(sao.Optimize(/*cluster=*/nullptr, item, &optimized_graph));
+  NodeMap node_map(&optimized_graph);
+
+  // The ConcatV2 node is gone, replaced by a _ScopedAllocatorConcat.
+  EXPECT_EQ(node_map.GetNode("concat"), nullptr);
+  const NodeDef* sa_node = nullptr;
+  const NodeDef* sac_node = nullptr;
+  for (const NodeDef& node : optimized_graph.node()) {
+    if (node.op() == "_ScopedAllocator") {
+      sa_node = &node;
+    } else if (node.op() == "_ScopedAllocatorConcat") {
+      sac_node = &node;
+    }
+  }
+  ASSERT_NE(sa_node, nullptr);
+  ASSERT_NE(sac_node, nullptr);
+
+  // The producers allocate from the ScopedAllocator, which also feeds the
+  // _ScopedAllocatorConcat its backing tensor.
+  auto& sa_outputs = node_map.GetOutputs(sa_node->name());
+  ASSERT_EQ(sa_outputs.size(), 3);
+  std::unordered_set<string> expected = {"a1", "a2", sac_node->name()};
+  for (auto it : sa_outputs) {
+    ASSERT_NE(expected.find(it->name()), expected.end())
+        << "Failed to find " << it->name();
+  }
+
+  // The old consumer of the concat now reads the coalesced view.
+  NodeDef* r = nullptr;
+  GetNode(&node_map, "r", &r);
+  ASSERT_EQ(r->input_size(), 1);
+  EXPECT_EQ(r->input(0), sac_node->name());
+}
+
+// Builds the same graph as ConcatCoalescingRewrite but also executes it and
+// validates the output.
+TEST_F(ScopedAllocatorOptimizerTest, ConcatCoalescingExecute) {
+  GraphDef graph_def;
+  BuildConcatGraph(&graph_def);
+  std::vector<Tensor> outputs;
+  ExecuteGraph(graph_def, /*output_names=*/{"r:0"}, &outputs,
+               /*enable_op=*/"ConcatV2");
+  std::vector<float> expected(32);
+  for (int i = 0; i < 16; ++i) {
+    expected[i] = i;
+    expected[16 + i] = 16 - i;
+  }
+  ValidateValues(outputs, /*expected=*/{expected});
+}
 #endif  // ENABLE_MKL
 
 }  // namespace
@@ -19,6 +19,7 @@ limitations under the License.
 #include <algorithm>
 #include <atomic>
 #include <functional>
+#include <limits>
 #include <memory>
 #include <random>
 #include <unordered_map>
@@ -56,6 +57,10 @@ class ASBSQueue;
 // shared_batch_scheduler.h for more details). AdaptiveSharedBatchScheduler
 // (ASBS) prioritizes batches primarily by age (i.e. the batch's oldest request)
 // along with a configurable preference for scheduling larger batches first.
+// Queues can additionally declare per-request deadlines (see
+// QueueOptions::get_deadline_micros_func); a batch whose tightest deadline is
+// about to expire becomes schedulable immediately and is scheduled ahead of
+// batches selected by age.
 //
 //
 // ASBS tries to keep the system busy by maintaining an adjustable number of
@@ -157,6 +162,24 @@ class AdaptiveSharedBatchScheduler
     // A non-zero value can improve performance by limiting the scheduling of
     // nearly empty batches.
     int64_t batch_timeout_micros = 0;
+    // If non nullptr, called for each task as it is added to a batch, and
+    // should return the absolute time (in microseconds, on the scheduler
+    // Env's clock) by which the task must start processing, or nullopt if the
+    // task has no deadline.  A batch containing deadline tasks becomes
+    // schedulable - without waiting out batch_timeout_micros - once its
+    // tightest deadline is within deadline_slack_micros of expiring, and from
+    // that point is scheduled ahead of batches selected by age.  This lets a
+    // single queue serve tiers with different latency SLOs: loose-deadline
+    // requests keep accumulating into large batches while a tight-deadline
+    // member forces its batch out early.
+    std::function<absl::optional<int64_t>(const TaskType&)>
+        get_deadline_micros_func;
+    // Headroom before the tightest deadline at which a deadline batch becomes
+    // schedulable (see get_deadline_micros_func).  Should be of order the
+    // batch processing latency, so that the batch can finish (or at least
+    // start) before the deadline actually expires.  Only consulted when
+    // get_deadline_micros_func is set.
+    int64_t deadline_slack_micros = 0;
     // If non nullptr, split_input_task_func should split input_task into
     // multiple tasks, the first of which has size first_size and the remaining
     // not exceeding max_size. This function may acquire ownership of input_task
@@ -186,7 +209,8 @@ class AdaptiveSharedBatchScheduler
   }
 
  private:
-  // access to AddBatch, MaybeScheduleClosedBatches, RemoveQueue, GetEnv.
+  // access to AddBatch, BatchDeadlineUpdated, MaybeScheduleClosedBatches,
+  // RemoveQueue, GetEnv.
   friend class internal::ASBSQueue<TaskType>;
 
   explicit AdaptiveSharedBatchScheduler(const Options& options);
@@ -217,6 +241,18 @@ class AdaptiveSharedBatchScheduler
   // Notifies scheduler of non-empty batch which is eligible for processing.
   void AddBatch(const internal::ASBSBatch<TaskType>* batch);
 
+  // Notifies scheduler that a deadline task lowered a previously added
+  // batch's schedulable time to schedulable_time_micros, so any wakeup armed
+  // for the old time is too late.  Takes the time by value rather than the
+  // batch, which may already have been released and destroyed by the time
+  // this runs.
+  void BatchDeadlineUpdated(int64_t schedulable_time_micros);
+
+  // Runs MaybeScheduleNextBatch now if schedulable_time_micros has passed,
+  // otherwise arms a wakeup for it.
+  void ScheduleWakeupLocked(int64_t schedulable_time_micros)
+      TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Removes queue from scheduler.
   void RemoveQueue(const internal::ASBSQueue<TaskType>* queue);
 
@@ -349,7 +385,8 @@ class ASBSBatch : public Batch<TaskType> {
             int64_t batch_timeout_micros, uint64 traceme_context_id)
       : queue_(queue),
         creation_time_micros_(creation_time_micros),
-        schedulable_time_micros_(creation_time_micros + batch_timeout_micros),
+        timeout_schedulable_time_micros_(creation_time_micros +
+                                         batch_timeout_micros),
         traceme_context_id_(traceme_context_id) {}
 
   ~ASBSBatch() override {}
@@ -358,14 +395,53 @@ class ASBSBatch : public Batch<TaskType> {
 
   int64_t creation_time_micros() const { return creation_time_micros_; }
 
-  int64_t schedulable_time_micros() const { return schedulable_time_micros_; }
+  int64_t schedulable_time_micros() const {
+    return std::min(timeout_schedulable_time_micros_,
+                    deadline_schedulable_time_micros_.load());
+  }
+
+  // Earliest deadline among the batch's tasks, or kNoDeadline if no task has
+  // declared one.
+  int64_t min_deadline_micros() const { return min_deadline_micros_.load(); }
+
+  // True once the tightest deadline in the batch is within its queue's slack
+  // of expiring; such batches are scheduled ahead of batches selected by age.
+  bool DeadlinePressed(int64_t now_micros) const {
+    return now_micros >= deadline_schedulable_time_micros_.load();
+  }
+
+  // Records the deadline of a task just added to this batch.  Returns true if
+  // this lowered the batch's schedulable time, in which case the scheduler
+  // must be notified in case it is waiting on the old time.  Must only be
+  // called while the batch is still owned by its queue's current_batch_ (i.e.
+  // under the queue's lock); concurrent readers are handled by the atomics.
+  bool RecordTaskDeadline(int64_t deadline_micros, int64_t slack_micros) {
+    if (deadline_micros < min_deadline_micros_.load()) {
+      min_deadline_micros_.store(deadline_micros);
+    }
+    const int64_t deadline_schedulable = deadline_micros - slack_micros;
+    if (deadline_schedulable >= deadline_schedulable_time_micros_.load()) {
+      return false;
+    }
+    const bool lowered = deadline_schedulable < schedulable_time_micros();
+    deadline_schedulable_time_micros_.store(deadline_schedulable);
+    return lowered;
+  }
 
   uint64 traceme_context_id() const { return traceme_context_id_; }
 
+  static constexpr int64_t kNoDeadline =
+      (std::numeric_limits<int64_t>::max)();
+
  private:
   ASBSQueue<TaskType>* queue_;
   const int64_t creation_time_micros_;
-  const int64_t schedulable_time_micros_;
+  const int64_t timeout_schedulable_time_micros_;
+  // Earliest deadline among the batch's tasks.
+  std::atomic<int64_t> min_deadline_micros_{kNoDeadline};
+  // Time at which deadline pressure makes the batch schedulable (tightest
+  // deadline minus the queue's deadline_slack_micros).
+  std::atomic<int64_t> deadline_schedulable_time_micros_{kNoDeadline};
   const uint64 traceme_context_id_;
   ASBSBatch(const ASBSBatch&) = delete;
   void operator=(const ASBSBatch&) = delete;
@@ -467,6 +543,11 @@ Status AdaptiveSharedBatchScheduler<TaskType>::AddQueue(
           options.max_batch_size);
     }
   }
+  if (options.deadline_slack_micros < 0) {
+    return errors::InvalidArgument(
+        "deadline_slack_micros can't be negative; was ",
+        options.deadline_slack_micros);
+  }
   internal::ASBSQueue<TaskType>* asbs_queue_raw;
   queue->reset(asbs_queue_raw = new internal::ASBSQueue<TaskType>(
                    this->shared_from_this(), options));
@@ -484,8 +565,20 @@ void AdaptiveSharedBatchScheduler<TaskType>::AddBatch(
   } else {
     batches_.push_back(batch);
   }
-  int64_t delay_micros =
-      batch->schedulable_time_micros() - GetEnv()->NowMicros();
+  ScheduleWakeupLocked(batch->schedulable_time_micros());
+}
+
+template <typename TaskType>
+void AdaptiveSharedBatchScheduler<TaskType>::BatchDeadlineUpdated(
+    int64_t schedulable_time_micros) {
+  mutex_lock l(mu_);
+  ScheduleWakeupLocked(schedulable_time_micros);
+}
+
+template <typename TaskType>
+void AdaptiveSharedBatchScheduler<TaskType>::ScheduleWakeupLocked(
+    int64_t schedulable_time_micros) {
+  int64_t delay_micros = schedulable_time_micros - GetEnv()->NowMicros();
   if (delay_micros <= 0) {
     MaybeScheduleNextBatch();
     return;
@@ -570,9 +663,19 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatch() {
 
   auto best_it = batches_.end();
   double best_score = (std::numeric_limits<double>::max)();
+  // Batches under deadline pressure (tightest member within its queue's slack
+  // of expiring) pre-empt the age/fullness score; among them, earliest
+  // deadline first.
+  auto pressed_it = batches_.end();
+  int64_t pressed_deadline = internal::ASBSBatch<TaskType>::kNoDeadline;
   int64_t now_micros = GetEnv()->NowMicros();
   for (auto it = batches_.begin(); it != batches_.end(); it++) {
     if ((*it)->schedulable_time_micros() > now_micros) continue;
+    if ((*it)->DeadlinePressed(now_micros) &&
+        (*it)->min_deadline_micros() < pressed_deadline) {
+      pressed_deadline = (*it)->min_deadline_micros();
+      pressed_it = it;
+    }
     const double score =
         (*it)->creation_time_micros() -
         options_.full_batch_scheduling_boost_micros * (*it)->size() /
@@ -582,6 +685,7 @@ void AdaptiveSharedBatchScheduler<TaskType>::MaybeScheduleNextBatch() {
       best_it = it;
     }
   }
+  if (pressed_it != batches_.end()) best_it = pressed_it;
   // No schedulable batches.
   if (best_it == batches_.end()) return;
   const internal::ASBSBatch<TaskType>* batch = *best_it;
@@ -747,6 +851,9 @@ Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
   std::vector<std::unique_ptr<TaskType>> tasks_to_schedule;
   std::vector<ASBSBatch<TaskType>*> new_batches;
   bool closed_batch = false;
+  // Set when a deadline task lowers the schedulable time of a batch the
+  // scheduler already knows about, so it can re-arm its wakeup.
+  absl::optional<int64_t> lowered_schedulable_time_micros;
   {
     mutex_lock l(mu_);
     if (size > SchedulingCapacityLocked()) {
@@ -771,6 +878,10 @@ Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
           &tasks_to_schedule));
     }
     for (auto& task : tasks_to_schedule) {
+      absl::optional<int64_t> deadline_micros;
+      if (options_.get_deadline_micros_func != nullptr) {
+        deadline_micros = options_.get_deadline_micros_func(*task);
+      }
       // Can't fit within current batch, close it off and try to create another.
       if (current_batch_ &&
           current_batch_->size() + task->size() > options_.max_batch_size) {
@@ -802,6 +913,15 @@ Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
           this->current_batch_->traceme_context_id());
       current_batch_->AddTask(std::move(task));
       num_enqueued_tasks_++;
+      if (deadline_micros.has_value() &&
+          current_batch_->RecordTaskDeadline(*deadline_micros,
+                                             options_.deadline_slack_micros) &&
+          (new_batches.empty() || new_batches.back() != current_batch_)) {
+        // The scheduler already holds this batch (it was created by an earlier
+        // Schedule call) and may be waiting out its original timeout.
+        lowered_schedulable_time_micros =
+            current_batch_->schedulable_time_micros();
+      }
       // If current_batch_ is now full, allow it to be processed immediately.
       bool reached_max_tasks =
           (options_.max_tasks_per_batch.has_value() &&
@@ -819,6 +939,9 @@ Status ASBSQueue<TaskType>::Schedule(std::unique_ptr<TaskType>* task) {
   for (auto* batch : new_batches) {
     scheduler_->AddBatch(batch);
   }
+  if (lowered_schedulable_time_micros.has_value()) {
+    scheduler_->BatchDeadlineUpdated(*lowered_schedulable_time_micros);
+  }
   if (closed_batch) {
     scheduler_->MaybeScheduleClosedBatches();
   }
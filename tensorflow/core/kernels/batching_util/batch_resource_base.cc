@@ -42,6 +42,7 @@ limitations under the License.
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/cost_util.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
+#include "tensorflow/core/common_runtime/request_cost_attribution.h"
 #include "tensorflow/core/common_runtime/request_cost_accessor.h"
 #include "tensorflow/core/common_runtime/request_cost_accessor_registry.h"
 #include "tensorflow/core/framework/allocator.h"
@@ -72,6 +73,7 @@ limitations under the License.
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
 #include "tensorflow/core/profiler/lib/traceme_encode.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/incremental_barrier.h"
 #include "tsl/platform/criticality.h"
 #include "tsl/platform/errors.h"
@@ -288,6 +290,35 @@ int GetTotalTaskSize(
   return tasks_size;
 }
 
+// If the TF_BATCH_QUEUES_BY_SHAPE environment variable is true, tasks are
+// routed to batcher queues keyed by the non-batch dimensions of their inputs,
+// so only tasks that concatenate without reshaping share a batch. Models
+// taking variable-length sequences can then accept requests at their natural
+// lengths instead of pre-padding every request to the worst-case length;
+// padding within a bucket happens only along the batch dimension.
+bool BatchQueuesByShapeEnabled() {
+  static const bool enabled = [] {
+    bool value = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_BATCH_QUEUES_BY_SHAPE",
+                                   /*default_val=*/false, &value));
+    return value;
+  }();
+  return enabled;
+}
+
+// Extends `batcher_queue_name` with the non-batch dimensions of `tensors`.
+string ShapeBucketedQueueName(const string& batcher_queue_name,
+                              const OpInputList& tensors) {
+  string name = batcher_queue_name;
+  for (const Tensor& tensor : tensors) {
+    absl::StrAppend(&name, "/");
+    for (int d = 1; d < tensor.dims(); ++d) {
+      absl::StrAppend(&name, d > 1 ? "x" : "", tensor.dim_size(d));
+    }
+  }
+  return name;
+}
+
 }  // namespace
 
 std::unique_ptr<BatchResourceBase::BatchTask>
@@ -472,8 +503,11 @@ Status BatchResourceBase::RegisterInput(
   }
 
   BatcherQueueT* batcher_queue;
-  TF_RETURN_IF_ERROR(
-      LookupOrCreateBatcherQueue(batcher_queue_name, &batcher_queue));
+  TF_RETURN_IF_ERROR(LookupOrCreateBatcherQueue(
+      BatchQueuesByShapeEnabled()
+          ? ShapeBucketedQueueName(batcher_queue_name, tensors)
+          : batcher_queue_name,
+      &batcher_queue));
 
   if (!session_metadata().name().empty()) {
     absl::MutexLock lock(&outstanding_batch_mu_);
@@ -958,6 +992,10 @@ void BatchResourceBase::ProcessFuncBatch(
   std::vector<std::unique_ptr<CostMeasurement>> batch_cost_measurements =
       CreateCostMeasurements(batching_context);
 
+  // Tallies the CPU time and allocations that the threads processing this
+  // batch attribute to it; shared with the function-run callback below.
+  auto request_cost_attribution = std::make_shared<RequestCostAttribution>();
+
   auto& last_task = batch->task(batch->num_tasks() - 1);
   OpKernelContext* last_task_context = last_task.context;
   const std::string& model_name = GetModelName(last_task_context);
@@ -979,6 +1017,8 @@ void BatchResourceBase::ProcessFuncBatch(
     SplitBatchCostsAndRecordMetrics(
         /* model_name= */ model_name, /* op_name= */ op_name,
         batch_cost_measurements, processed_size, *batch);
+    SplitRequestCostAttributionAndRecord(*request_cost_attribution,
+                                         processed_size, *batch);
     // Clear the measurements before unblocking the batch task, as measurements
     // are associated with the task's thread context.
     batch_cost_measurements.clear();
@@ -994,6 +1034,13 @@ void BatchResourceBase::ProcessFuncBatch(
   auto finally =
       gtl::MakeCleanup([&cleanup_fn, &status] { cleanup_fn(status); });
 
+  // Attributes the batch formation work done on this thread (validation and
+  // input concatenation) to the batch. Closed before handing off to the
+  // function library runtime so the tally is complete when the run callback
+  // splits it.
+  std::optional<ScopedRequestCostAttribution> attribution_scope(
+      std::in_place, request_cost_attribution.get());
+
   status = ValidateBatch(*batch);
   if (!status.ok()) {
     return;
@@ -1026,6 +1073,7 @@ void BatchResourceBase::ProcessFuncBatch(
   // Releases the cleanup method here, because the callback of the function
   // library runtime will handle it now.
   finally.release();
+  attribution_scope.reset();
   ProcessFuncBatchImpl(
       last_task, args, &combined_outputs, [&](const Status& run_status) {
         Status final_status;
@@ -1038,6 +1086,10 @@ void BatchResourceBase::ProcessFuncBatch(
           // queue rather than the end.
           cleanup_fn(final_status);
         });
+        // Declared after `run_finally` so the tally is flushed before the
+        // cleanup splits it across the batch's tasks.
+        ScopedRequestCostAttribution attribution_scope(
+            request_cost_attribution.get());
         final_status = run_status;
         if (!final_status.ok()) {
           return;
@@ -1286,5 +1338,38 @@ void BatchResourceBase::SplitBatchCostsAndRecordMetrics(
   }
 }
 
+void BatchResourceBase::SplitRequestCostAttributionAndRecord(
+    const RequestCostAttribution& attribution, const int64_t processed_size,
+    BatchT& batch) {
+  const absl::Duration total_cpu_cost =
+      absl::Nanoseconds(attribution.TotalCpuTimeNs());
+  const int64_t total_allocated_bytes = attribution.TotalAllocatedBytes();
+  if ((total_cpu_cost <= absl::ZeroDuration() && total_allocated_bytes <= 0) ||
+      batch.size() == 0 || processed_size == 0) {
+    return;
+  }
+  for (int i = 0; i < batch.num_tasks(); i++) {
+    RequestCost* request_cost = batch.task(i).request_cost;
+    // Skip recording the cost if the request_cost is null.
+    if (!request_cost) continue;
+
+    // Split following the same convention as the batch cost measurements:
+    // the smeared cost assigns the padding's share to the tasks, the
+    // non-smeared cost does not.
+    const auto cost_with_smear =
+        total_cpu_cost / batch.size() * batch.task(i).size();
+    const auto cost_no_smear =
+        total_cpu_cost / processed_size * batch.task(i).size();
+    request_cost->RecordCost(
+        {{absl::StrCat(kCpuCostName, kWithSmearSuffix), cost_with_smear},
+         {absl::StrCat(kCpuCostName, kNoSmearSuffix), cost_no_smear}});
+
+    request_cost->RecordMetrics(
+        {{kAllocatedBytesMetricName,
+          static_cast<double>(total_allocated_bytes) / batch.size() *
+              batch.task(i).size()}});
+  }
+}
+
 }  // namespace serving
 }  // namespace tensorflow
@@ -28,6 +28,7 @@ limitations under the License.
 #include "absl/synchronization/blocking_counter.h"
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
+#include "tensorflow/core/common_runtime/request_cost_attribution.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
@@ -270,6 +271,14 @@ class BatchResourceBase : public ResourceBase {
           batch_cost_measurements,
       int64_t processed_size, BatchT& batch);
 
+  // Splits the CPU time and allocated bytes tallied for the whole batch by
+  // `attribution` across the batch's tasks, following the same smeared /
+  // non-smeared convention as SplitBatchCostsAndRecordMetrics, and records
+  // them in each task's request_cost.
+  static void SplitRequestCostAttributionAndRecord(
+      const RequestCostAttribution& attribution, int64_t processed_size,
+      BatchT& batch);
+
  private:
   // Implementation of calling the process batch function.
   virtual void ProcessFuncBatchImpl(
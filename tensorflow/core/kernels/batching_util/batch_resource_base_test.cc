@@ -21,12 +21,14 @@ limitations under the License.
 
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include "absl/strings/str_cat.h"
 #include "absl/strings/string_view.h"
 #include "absl/time/time.h"
 #include "tensorflow/core/common_runtime/cost_constants.h"
 #include "tensorflow/core/common_runtime/cost_measurement.h"
 #include "tensorflow/core/common_runtime/cost_measurement_registry.h"
 #include "tensorflow/core/common_runtime/request_cost.h"
+#include "tensorflow/core/common_runtime/request_cost_attribution.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -400,6 +402,56 @@ TEST(SplitBatchCostsAndRecordMetricsTest, GlobalBatchStatsProcessedSize) {
             original_cumulative_processed_size + 4);
 }
 
+TEST(SplitRequestCostAttributionAndRecordTest, SkipOnEmptyAttribution) {
+  BatchResourceBase::BatchT batch;
+  RequestCost cost;
+  batch.AddTask(MakeBatchTask(/*task_size=*/1, &cost));
+  batch.Close();
+
+  RequestCostAttribution attribution;
+  BatchResourceBase::SplitRequestCostAttributionAndRecord(
+      attribution, /*processed_size=*/16, batch);
+  EXPECT_TRUE(batch.task(0).request_cost->GetCosts().empty());
+  EXPECT_TRUE(batch.task(0).request_cost->GetMetrics().empty());
+}
+
+TEST(SplitRequestCostAttributionAndRecordTest, SplitsProportionallyToSize) {
+  BatchResourceBase::BatchT batch;
+  RequestCost cost1, cost2;
+  batch.AddTask(MakeBatchTask(/*task_size=*/1, &cost1));
+  batch.AddTask(MakeBatchTask(/*task_size=*/9, &cost2));
+  batch.Close();
+
+  RequestCostAttribution attribution;
+  {
+    ScopedRequestCostAttribution scope(&attribution);
+    ScopedRequestCostAttribution::RecordAllocatedBytes(1000);
+  }
+  BatchResourceBase::SplitRequestCostAttributionAndRecord(
+      attribution, /*processed_size=*/20, batch);
+
+  // Allocated bytes are smeared over the tasks proportionally to their sizes.
+  EXPECT_THAT(batch.task(0).request_cost->GetMetrics(),
+              UnorderedElementsAre(
+                  Pair(kAllocatedBytesMetricName, ::testing::DoubleEq(100))));
+  EXPECT_THAT(batch.task(1).request_cost->GetMetrics(),
+              UnorderedElementsAre(
+                  Pair(kAllocatedBytesMetricName, ::testing::DoubleEq(900))));
+
+  // The CPU time of the scope is not deterministic, but its split must keep
+  // the tasks' 1:9 proportion and the smear convention.
+  const auto costs1 = batch.task(0).request_cost->GetCosts();
+  const auto costs2 = batch.task(1).request_cost->GetCosts();
+  if (attribution.TotalCpuTimeNs() > 0) {
+    const std::string with_smear = absl::StrCat(kCpuCostName, kWithSmearSuffix);
+    const std::string no_smear = absl::StrCat(kCpuCostName, kNoSmearSuffix);
+    ASSERT_TRUE(costs1.contains(with_smear));
+    ASSERT_TRUE(costs2.contains(with_smear));
+    EXPECT_EQ(costs1.at(with_smear) * 9, costs2.at(with_smear));
+    EXPECT_EQ(costs1.at(no_smear) * 9, costs2.at(no_smear));
+  }
+}
+
 }  // namespace
 }  // namespace serving
 }  // namespace tensorflow
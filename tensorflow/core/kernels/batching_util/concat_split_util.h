@@ -34,9 +34,24 @@ typedef Eigen::GpuDevice GPUDevice;
 // Requires that all elements of 'inputs' have element type T. Writes to
 // 'output' using 'context' for the allocation to ensure proper device
 // placement.
+//
+// Note that a copy here is unavoidable in the general case: the batched
+// computation consumes a single dense Tensor, and there is no kernel calling
+// convention through which it could gather from a list of per-request
+// buffers. The special cases below (and their counterparts in
+// SplitEasyCases()) alias instead of copying whenever the buffers line up.
 template <typename T>
 Status Concat(OpKernelContext* context, const absl::Span<const Tensor> inputs,
               Tensor* output) {
+  // Special case: trivial 1-way concat, mirroring the 1-way split below.
+  // Aliasing matters here because request tensors can be tens of MB; a batch
+  // formed from a single task (low load, or padding disabled) should not pay
+  // for a full copy.
+  if (inputs.size() == 1) {
+    *output = inputs[0];
+    return absl::OkStatus();
+  }
+
   const int input_dims = inputs[0].dims();
   const TensorShape& input_shape = inputs[0].shape();
 
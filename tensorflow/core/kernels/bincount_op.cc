@@ -16,10 +16,13 @@ limitations under the License.
 // See docs in ../ops/math_ops.cc.
 
 #include <atomic>
+#include <vector>
 
 #include "tensorflow/core/platform/errors.h"
 #define EIGEN_USE_THREADS
 
+#include "absl/container/flat_hash_map.h"
+#include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
@@ -40,6 +43,24 @@ typedef Eigen::GpuDevice GPUDevice;
 
 namespace functor {
 
+namespace {
+
+// Above this many bins, and when the bin count also dwarfs the number of ids
+// to histogram, the per-thread dense partial histograms below are
+// counterproductive: zeroing and then reducing num_threads rows of num_bins
+// counters costs far more than the binning itself. In that regime we
+// accumulate into per-thread hash maps keyed by bin and merge only the
+// touched bins into the dense output.
+constexpr int64_t kSparseBincountMinBins = 1 << 20;
+
+template <typename Tidx>
+bool UseSparseBincountAccumulation(Tidx num_bins, int64_t arr_size) {
+  return static_cast<int64_t>(num_bins) >= kSparseBincountMinBins &&
+         static_cast<int64_t>(num_bins) > 8 * arr_size;
+}
+
+}  // namespace
+
 template <typename Tidx, typename T>
 struct BincountFunctor<CPUDevice, Tidx, T, true> {
   static Status Compute(OpKernelContext* context,
@@ -61,6 +82,27 @@ struct BincountFunctor<CPUDevice, Tidx, T, true> {
     ThreadPool* thread_pool =
         context->device()->tensorflow_cpu_worker_threads()->workers;
     const int64_t num_threads = thread_pool->NumThreads() + 1;
+    if (num_threads > 1 && UseSparseBincountAccumulation(num_bins, arr.size())) {
+      std::vector<absl::flat_hash_set<Tidx>> local_bins(num_threads);
+      thread_pool->ParallelForWithWorkerId(
+          arr.size(), 8 /* cost */,
+          [&](int64_t start_ind, int64_t limit_ind, int64_t worker_id) {
+            for (int64_t i = start_ind; i < limit_ind; i++) {
+              Tidx value = arr(i);
+              if (value < num_bins) {
+                local_bins[worker_id].insert(value);
+              }
+            }
+          });
+      output.setZero();
+      T* output_data = output.data();
+      for (const auto& bins : local_bins) {
+        for (const Tidx value : bins) {
+          output_data[value] = T(1);
+        }
+      }
+      return OkStatus();
+    }
     Tensor partial_bins_t;
     TF_RETURN_IF_ERROR(context->allocate_temp(
         DT_BOOL, TensorShape({num_threads, num_bins}), &partial_bins_t));
@@ -113,6 +155,41 @@ struct BincountFunctor<CPUDevice, Tidx, T, false> {
       return errors::InvalidArgument(
           "Input indices and weights must have the same size.");
     }
+    if (num_threads > 1 && UseSparseBincountAccumulation(num_bins, arr_size)) {
+      std::vector<absl::flat_hash_map<Tidx, T>> local_bins(num_threads);
+      thread_pool->ParallelForWithWorkerId(
+          arr_size, 8 /* cost */,
+          [&](int64_t start_ind, int64_t limit_ind, int64_t worker_id) {
+            auto& bins = local_bins[worker_id];
+            if (weights.size()) {
+              for (int64_t i = start_ind; i < limit_ind; i++) {
+                const Tidx value = arr_data[i];
+                if (value < num_bins) {
+                  bins[value] += weight_data[i];
+                }
+              }
+            } else {
+              for (int64_t i = start_ind; i < limit_ind; i++) {
+                const Tidx value = arr_data[i];
+                if (value < num_bins) {
+                  // Complex numbers don't support "++".
+                  bins[value] += T(1);
+                }
+              }
+            }
+          });
+      output.setZero();
+      T* output_data = output.data();
+      // Each thread's map holds a bin at most once, so merging thread by
+      // thread applies a fixed number of additions to each bin in a fixed
+      // order; the result is deterministic.
+      for (const auto& bins : local_bins) {
+        for (const auto& bin_and_sum : bins) {
+          output_data[bin_and_sum.first] += bin_and_sum.second;
+        }
+      }
+      return OkStatus();
+    }
     if (num_threads == 1) {
       output.setZero();
       T* output_data = output.data();
@@ -106,6 +106,25 @@ void CastOpBase::Compute(OpKernelContext* ctx) {
     work_(ctx, in, out, use_truncation_);
     out->set_dtype(external_dst_dtype_);
   } else {
+    // For element types of the same width, try to reuse the input buffer for
+    // the output: the conversion writes each element to the index it was read
+    // from, so it can run in place when the input is not shared. This elides
+    // an allocation and keeps the data in cache.
+    if (DataTypeSize(src_dtype_) == DataTypeSize(dst_dtype_) &&
+        DataTypeSize(src_dtype_) > 0) {
+      std::unique_ptr<Tensor> forwarded =
+          ctx->forward_input(0, /*output_index=*/0, src_dtype_, inp.shape(),
+                             ctx->output_memory_type(0),
+                             ctx->output_alloc_attr(0));
+      if (forwarded != nullptr) {
+        Tensor out;
+        OP_REQUIRES_OK(ctx,
+                       out.BitcastFrom(*forwarded, dst_dtype_, inp.shape()));
+        work_(ctx, inp, &out, use_truncation_);
+        ctx->set_output(0, out);
+        return;
+      }
+    }
     Tensor* out = nullptr;
     OP_REQUIRES_OK(ctx, ctx->allocate_output(0, inp.shape(), &out));
     work_(ctx, inp, out, use_truncation_);
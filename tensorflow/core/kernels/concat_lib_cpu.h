@@ -75,6 +75,38 @@ void ConcatCPUImpl(
     return;
   }
 
+  // Two-level dispatch for the sharded mode. When there are enough rows to
+  // keep the pool busy, shard on whole rows: every task walks its own row
+  // range with an input-pointer table, all copies are full-width, and the
+  // partial-row boundary search below never runs. This matters when
+  // concatenating thousands of narrow inputs, where boundary handling and
+  // split copies dominate. When there are only a few (possibly huge) rows,
+  // fall through to element-range sharding, which can split a single row
+  // across threads.
+  const int64_t dim0 = output->dimension(0);
+  if (dim0 >= 2 * worker_threads->num_threads) {
+    auto work_rows = [&sizes, &inputs, &output, &copier, &num_inputs,
+                      &row_size](int64_t row_start, int64_t row_end) {
+      T* out = output->data() + row_start * row_size;
+      std::vector<const T*> inp;
+      inp.reserve(num_inputs);
+      for (const auto& input : inputs) {
+        inp.push_back(&(*input)(row_start, 0));
+      }
+      for (int64_t i = row_start; i < row_end; ++i) {
+        for (size_t j = 0; j < num_inputs; ++j) {
+          auto size = sizes[j];
+          copier.Copy(out, inp[j], j, size);
+          out += size;
+          inp[j] += size;
+        }
+      }
+    };
+    Shard(worker_threads->num_threads, worker_threads->workers, dim0,
+          cost_per_unit * row_size, work_rows);
+    return;
+  }
+
   // Sharded mode.
   auto work = [&row_size, &sizes, &inputs, &output, &copier, &num_inputs](
                   int64_t start, int64_t end) {
@@ -62,6 +62,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor_slice.h"
 #include "tensorflow/core/kernels/conv_ops.h"
 #include "tensorflow/core/kernels/gemm_functors.h"
+#include "tensorflow/core/lib/monitoring/counter.h"
 #include "tensorflow/core/util/image_resizer_state.h"
 #include "tensorflow/core/util/mirror_pad_mode.h"
 #include "tensorflow/core/util/padding.h"
@@ -307,15 +308,32 @@ class Im2ColConvFunctor {
     // allocate a persistent buffer that will be kept around between calls. We
     // use TensorFlow's resource management to ensure that the memory will be
     // released when the session is over.
+    // Counters that expose how often the persistent buffer is reused versus
+    // allocated, to make workspace churn visible on serving fleets.
+    static auto* im2col_buffer_created_counter = monitoring::Counter<0>::New(
+        "/tensorflow/core/kernels/conv2d_gemm/im2col_buffer_created",
+        "Number of persistent im2col buffers allocated by gemm-based Conv2d.");
+    static auto* im2col_buffer_reused_counter = monitoring::Counter<0>::New(
+        "/tensorflow/core/kernels/conv2d_gemm/im2col_buffer_reused",
+        "Number of gemm-based Conv2d invocations that reused a previously "
+        "allocated persistent im2col buffer.");
     Im2ColBufferResource<T1, chunk_value_count>* im2col_buffer_resource;
+    bool created_buffer = false;
     std::function<Status(Im2ColBufferResource<T1, chunk_value_count>**)>
-        creator = [](Im2ColBufferResource<T1, chunk_value_count>** resource) {
+        creator = [&created_buffer](
+                      Im2ColBufferResource<T1, chunk_value_count>** resource) {
           *resource = new Im2ColBufferResource<T1, chunk_value_count>();
+          created_buffer = true;
           return absl::OkStatus();
         };
     OP_REQUIRES_OK(context, context->resource_manager()->LookupOrCreate(
                                 "Conv2d", "im2col_buffer",
                                 &im2col_buffer_resource, creator));
+    if (created_buffer) {
+      im2col_buffer_created_counter->GetCell()->IncrementBy(1);
+    } else {
+      im2col_buffer_reused_counter->GetCell()->IncrementBy(1);
+    }
     // This means that multiple ops can't be run simultaneously on different
     // threads, because we have a single shared resource. The platforms this is
     // aimed at have intra-op parallelism as their focus though, so it shouldn't
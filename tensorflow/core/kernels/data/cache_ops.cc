@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/cache_ops.h"
 
+#include <atomic>
+#include <memory>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/dataset.h"
 #include "tensorflow/core/framework/partial_tensor_shape.h"
@@ -35,37 +40,38 @@ string MemoryCacheManager::DebugString() const { return kMemoryCache; }
 
 void MemoryCache::Complete(std::vector<std::vector<Tensor>>&& cache) {
   mutex_lock l(mu_);
-  if (!completed_) {
-    cache_ = std::move(cache);
-    completed_ = true;
+  if (std::atomic_load(&cache_) == nullptr) {
+    std::atomic_store(&cache_,
+                      std::shared_ptr<const std::vector<std::vector<Tensor>>>(
+                          std::make_shared<std::vector<std::vector<Tensor>>>(
+                              std::move(cache))));
   }
 }
 
-bool MemoryCache::IsCompleted() {
-  tf_shared_lock l(mu_);
-  return completed_;
-}
+bool MemoryCache::IsCompleted() { return std::atomic_load(&cache_) != nullptr; }
 
 void MemoryCache::Reset() {
   mutex_lock l(mu_);
-  completed_ = false;
-  cache_.clear();
+  std::atomic_store(&cache_,
+                    std::shared_ptr<const std::vector<std::vector<Tensor>>>());
 }
 
 const std::vector<Tensor>& MemoryCache::at(int64_t index) {
-  tf_shared_lock l(mu_);
-  DCHECK(index < cache_.size());
-  return cache_[index];
+  auto cache = std::atomic_load(&cache_);
+  DCHECK(cache != nullptr);
+  DCHECK(index < cache->size());
+  return (*cache)[index];
 }
 
 size_t MemoryCache::size() {
-  tf_shared_lock l(mu_);
-  return cache_.size();
+  auto cache = std::atomic_load(&cache_);
+  return cache ? cache->size() : 0;
 }
 
 const std::vector<std::vector<Tensor>>& MemoryCache::data() {
-  tf_shared_lock l(mu_);
-  return cache_;
+  static const auto* const kEmptyCache = new std::vector<std::vector<Tensor>>();
+  auto cache = std::atomic_load(&cache_);
+  return cache ? *cache : *kEmptyCache;
 }
 
 AnonymousMemoryCacheHandleOp::AnonymousMemoryCacheHandleOp(
@@ -16,6 +16,9 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 #define TENSORFLOW_CORE_KERNELS_DATA_CACHE_OPS_H_
 
+#include <memory>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 
@@ -40,7 +43,8 @@ class MemoryCache {
   // Resets the cache.
   void Reset();
 
-  // Returns the element at the given index.
+  // Returns the element at the given index. The returned reference will be
+  // invalidated by any call to Reset().
   const std::vector<Tensor>& at(int64_t index);
 
   // Returns the size of the cache.
@@ -51,10 +55,14 @@ class MemoryCache {
   const std::vector<std::vector<Tensor>>& data();
 
  private:
+  // Serializes the rare state transitions (Complete/Reset).
   mutex mu_;
-  // Determines whether all elements of the dataset have been cached.
-  bool completed_ TF_GUARDED_BY(mu_) = false;
-  std::vector<std::vector<Tensor>> cache_ TF_GUARDED_BY(mu_);
+  // The cached elements. The contents are immutable between Complete() and
+  // Reset(), so they are published as an atomically swapped snapshot
+  // (accessed with std::atomic_load/std::atomic_store): readers index into
+  // the snapshot without taking any lock. A null snapshot means the cache has
+  // not been completed.
+  std::shared_ptr<const std::vector<std::vector<Tensor>>> cache_;
 };
 
 // A resource wrapping a shared instance of a memory cache.
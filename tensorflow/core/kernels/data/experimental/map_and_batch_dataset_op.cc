@@ -527,6 +527,47 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
       }
     }
 
+    // If the shape of every output component is statically known (which
+    // requires `drop_remainder` to be set, so that the leading batch
+    // dimension is static too), allocates the batch output up front so that
+    // map invocations write straight into their slices instead of waiting
+    // for the first invocation to complete and reveal the element shape.
+    void MaybePreallocateOutput(const std::shared_ptr<IteratorContext>& ctx,
+                                const std::shared_ptr<BatchResult>& result) {
+      const std::vector<PartialTensorShape>& output_shapes =
+          dataset()->output_shapes();
+      for (const auto& shape : output_shapes) {
+        if (!shape.IsFullyDefined()) {
+          return;
+        }
+      }
+      const DataTypeVector& output_dtypes = dataset()->output_dtypes();
+      mutex_lock l(result->mu);
+      if (result->output_allocated) {
+        return;
+      }
+      result->output.reserve(output_shapes.size());
+      for (size_t i = 0; i < output_shapes.size(); ++i) {
+        TensorShape component_shape;
+        if (!output_shapes[i].AsTensorShape(&component_shape)) {
+          result->output.clear();
+          return;
+        }
+        AllocatorAttributes attr;
+        attr.set_gpu_compatible(true);
+        result->output.emplace_back(ctx->allocator(attr), output_dtypes[i],
+                                    component_shape);
+        if (!result->output.back().IsInitialized()) {
+          // Fall back to allocation on first completion, which reports the
+          // failure through the batch's status.
+          result->output.clear();
+          return;
+        }
+      }
+      RecordBufferEnqueue(ctx.get(), result->output);
+      result->output_allocated = true;
+    }
+
     Status EnsureOutputAllocated(
         const std::shared_ptr<IteratorContext>& ctx,
         const std::shared_ptr<BatchResult>& result,
@@ -614,6 +655,11 @@ class MapAndBatchDatasetOp::Dataset : public DatasetBase {
               num_elements());
         }
         for (const auto& call : new_calls) {
+          if (call.second == 0) {
+            // First call of a new batch: try to materialize the batch buffer
+            // before any results come back.
+            MaybePreallocateOutput(ctx, call.first);
+          }
           CallFunction(ctx, call.first, call.second);
         }
         new_calls.clear();
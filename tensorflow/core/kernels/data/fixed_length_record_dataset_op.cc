@@ -140,16 +140,19 @@ class FixedLengthRecordDatasetOp::Dataset : public DatasetBase {
           const int64_t current_pos = input_buffer_->Tell();
           DCHECK_GE(file_pos_limit_, 0);
           if (current_pos < file_pos_limit_) {
-            string record;
-            TF_RETURN_IF_ERROR(
-                input_buffer_->ReadNBytes(dataset()->record_bytes_, &record));
+            // Read the record directly into the output tensor's string to
+            // avoid an intermediate copy.
+            Tensor record_tensor(ctx->allocator({}), DT_STRING, {});
+            tstring& record = record_tensor.scalar<tstring>()();
+            record.resize_uninitialized(dataset()->record_bytes_);
+            size_t bytes_read = 0;
+            TF_RETURN_IF_ERROR(input_buffer_->ReadNBytes(
+                dataset()->record_bytes_, record.mdata(), &bytes_read));
             static monitoring::CounterCell* bytes_counter =
                 metrics::GetTFDataBytesReadCounter(kDatasetType);
             bytes_counter->IncrementBy(dataset()->record_bytes_);
 
             // Produce the record as output.
-            Tensor record_tensor(ctx->allocator({}), DT_STRING, {});
-            record_tensor.scalar<tstring>()() = record;
             out_tensors->emplace_back(std::move(record_tensor));
             *end_of_sequence = false;
             return absl::OkStatus();
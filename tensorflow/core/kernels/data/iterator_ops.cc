@@ -389,7 +389,7 @@ class IteratorVariantSerializer {
     for (auto& it : data) {
       IteratorStateVariant v;
       TF_RETURN_IF_ERROR(v.InitializeFromVariantData(std::move(it)));
-      variants_.push_back(v);
+      variants_.push_back(std::move(v));
     }
     num_tensors_ = variants_.size();
     can_serialize_ = true;
@@ -420,7 +420,8 @@ class IteratorVariantSerializer {
   int64_t NumTensors() { return num_tensors_; }
 
   // Stores the IteratorStateVariant list into a pre-allocated tensor. Expects
-  // that InitializeFromIterator was called before.
+  // that InitializeFromIterator was called before. Consumes the serialized
+  // state, so it can only be called once per call to InitializeFromIterator.
   Status Serialize(Tensor* serialized) {
     if (!can_serialize_) {
       return errors::InvalidArgument(
@@ -432,8 +433,9 @@ class IteratorVariantSerializer {
         return errors::Internal(
             "Cannot serialize an empty IteratorStateVariant");
       }
-      serialized->vec<Variant>()(i) = variants_[i];
+      serialized->vec<Variant>()(i) = std::move(variants_[i]);
     }
+    can_serialize_ = false;
     return absl::OkStatus();
   }
 
@@ -903,7 +905,7 @@ AsyncOpKernel* IteratorGetNextOp::AsAsync() {
   return type_string() == "IteratorGetNextSync" ? nullptr : this;
 }
 
-void RecordElementSize(const std::vector<Tensor> element,
+void RecordElementSize(const std::vector<Tensor>& element,
                        tsl::profiler::TraceMe* traceme) {
   traceme->AppendMetadata([&]() {
     int64_t element_size = 0;
@@ -948,7 +950,7 @@ Status IteratorGetNextOp::DoCompute(OpKernelContext* ctx) {
   TF_RETURN_IF_ERROR(VerifyShapesCompatible(output_shapes_, components));
   RecordElementSize(components, &traceme);
   for (int i = 0; i < components.size(); ++i) {
-    ctx->set_output(i, components[i]);
+    ctx->set_output(i, std::move(components[i]));
   }
   return absl::OkStatus();
 }
@@ -14,6 +14,8 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/map_defun_op.h"
 
+#include <algorithm>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/framework/function.h"
 #include "tensorflow/core/framework/op_kernel.h"
@@ -213,25 +215,52 @@ void MapDefunOp::ComputeAsync(OpKernelContext* ctx, DoneCallback done) {
   auto* refcounted = new ReffedStatusCallback(std::move(callback));
 
   CancellationManager* parent_mgr = ctx->cancellation_manager();
-
-  for (size_t i = 0; i < static_cast<size_t>(compute_opts->batch_size); ++i) {
-    // We use a different cancellation manager each time the function is run
-    // to avoid the race condition between a function run error and other
-    // functions being cancelled as a result.
-    CancellationManager* c_mgr = new CancellationManager(parent_mgr);
-    opts.cancellation_manager = c_mgr;
-
-    auto* call_frame = new MapFunctionCallFrame(compute_opts, this, i);
-
+  FunctionLibraryRuntime* func_lib = ctx->function_library();
+
+  // Partition the batch into contiguous blocks and run every block as a
+  // single task on the runner. Within a block, elements run synchronously
+  // with all kernels inlined, so the per-element cost is a call frame and a
+  // cancellation manager on the block task's stack instead of a separately
+  // scheduled function call. Blocks provide the inter-element parallelism.
+  // Note that `max_intra_op_parallelism` bounds the parallelism within one
+  // function call (the runner set up by `SetRunOptions` applies it to each
+  // block task), not the number of blocks that run concurrently.
+  const int64_t batch_size = compute_opts->batch_size;
+  const int num_threads =
+      ctx->device()->tensorflow_cpu_worker_threads()->num_threads;
+  const int64_t num_blocks =
+      std::min(batch_size, static_cast<int64_t>(std::max(num_threads, 1)));
+  const int64_t block_size =
+      num_blocks > 0 ? (batch_size + num_blocks - 1) / num_blocks : 1;
+
+  for (int64_t start = 0; start < batch_size; start += block_size) {
+    const int64_t limit = std::min(start + block_size, batch_size);
     refcounted->Ref();
-    ctx->function_library()->Run(
-        opts, func_handle_, call_frame,
-        [call_frame, refcounted, c_mgr](const Status& func_status) {
-          delete c_mgr;
-          delete call_frame;
-          refcounted->UpdateStatus(func_status);
-          refcounted->Unref();
-        });
+    auto run_block = [this, func_lib, opts, compute_opts, parent_mgr,
+                      refcounted, start, limit]() {
+      FunctionLibraryRuntime::Options run_opts = opts;
+      // The block already occupies a runner thread; run the function's
+      // kernels inline to avoid per-kernel scheduling overhead and to keep
+      // the runner threads available for other blocks.
+      run_opts.run_all_kernels_inline = true;
+      Status status;
+      for (int64_t i = start; i < limit && status.ok(); ++i) {
+        // We use a different cancellation manager each time the function is
+        // run to avoid the race condition between a function run error and
+        // other functions being cancelled as a result.
+        CancellationManager c_mgr(parent_mgr);
+        run_opts.cancellation_manager = &c_mgr;
+        MapFunctionCallFrame call_frame(compute_opts, this, i);
+        status = func_lib->RunSync(run_opts, func_handle_, &call_frame);
+      }
+      refcounted->UpdateStatus(status);
+      refcounted->Unref();
+    };
+    if (opts.runner != nullptr) {
+      (*opts.runner)(std::move(run_block));
+    } else {
+      run_block();
+    }
   }
 
   // Unref 1 because refcounted is initialized with refcount = 1
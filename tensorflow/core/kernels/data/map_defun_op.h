@@ -21,9 +21,11 @@ namespace tensorflow {
 namespace data {
 
 // This op runs a given defun on slices of the input arguments. The function
-// given by "f" is assumed to be stateless, and is executed concurrently
-// on all the slices; up to batch_size (i.e. the 0th dimension of each argument)
-// functions will be scheduled at once.
+// given by "f" is assumed to be stateless. The batch (i.e. the 0th dimension
+// of each argument) is partitioned into contiguous blocks that execute
+// concurrently; within a block, the function runs synchronously on one slice
+// at a time with its kernels inlined, which keeps the per-slice dispatch
+// overhead small for cheap functions.
 //
 // The "max_intra_op_parallelism" attr, which defaults to 1, can be used to
 // limit the intra op parallelism. To limit inter-op parallelism, a user
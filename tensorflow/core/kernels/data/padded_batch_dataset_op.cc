@@ -14,6 +14,11 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/kernels/data/padded_batch_dataset_op.h"
 
+#include <algorithm>
+#include <cstring>
+#include <utility>
+#include <vector>
+
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/framework/dataset.h"
@@ -21,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_util.h"
+#include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/gtl/cleanup.h"
 #include "tensorflow/core/platform/blocking_counter.h"
@@ -276,6 +282,18 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
     }
 
    private:
+    // Returns true if the scalar `padding_value` consists of all-zero bytes,
+    // in which case padding a freshly allocated component reduces to a plain
+    // memset instead of an element-typed constant fill.
+    static bool IsZeroPaddingValue(const Tensor& padding_value) {
+      if (!DataTypeCanUseMemcpy(padding_value.dtype())) {
+        return false;
+      }
+      auto data = padding_value.tensor_data();
+      return std::all_of(data.begin(), data.end(),
+                         [](char c) { return c == 0; });
+    }
+
     // Copies the retrieved batch elements into one output tensor per tuple
     // component.
     //
@@ -288,8 +306,16 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
                      std::vector<Tensor>* out_tensors) {
       const size_t num_tuple_components = batch_elements[0].size();
       const int64_t num_batch_elements = batch_elements.size();
-      for (size_t component_index = 0; component_index < num_tuple_components;
-           ++component_index) {
+      out_tensors->resize(num_tuple_components);
+      // The padded per-element shape of each output component, used to choose
+      // between the slice and larger-slice copy paths.
+      std::vector<TensorShape> component_shapes(num_tuple_components);
+
+      // Determines the shape of padded component `component_index`, allocates
+      // the output tensor, and fills it with the padding value.
+      auto assemble_component_fn = [this, ctx, &batch_elements,
+                                    num_batch_elements, out_tensors,
+                                    &component_shapes](size_t component_index) {
         // 1. Determine the shape of the padded tensor.
         TensorShape batch_component_shape({num_batch_elements});
         const PartialTensorShape& padded_shape =
@@ -336,27 +362,41 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
           }
         }
 
-        // 2. Copy each batch element to the appropriate location in
-        // the output component tensor.
-        out_tensors->emplace_back(ctx->allocator({}),
-                                  output_dtypes()[component_index],
-                                  batch_component_shape);
-        Tensor& batch_component = out_tensors->back();
-        TF_RETURN_IF_ERROR(batch_util::SetElementZero(
-            &batch_component, dataset()->padding_values_[component_index]));
-
-        // Build the output tuple component by copying one slice from each input
-        // element in the batch.
+        // 2. Allocate the output component and pre-fill it with the padding
+        // value; the element copies below overwrite the non-padded regions.
+        Tensor& batch_component = (*out_tensors)[component_index];
+        batch_component =
+            Tensor(ctx->allocator({}), output_dtypes()[component_index],
+                   batch_component_shape);
+        const Tensor& padding_value =
+            dataset()->padding_values_[component_index];
+        if (IsZeroPaddingValue(padding_value)) {
+          auto data = batch_component.tensor_data();
+          memset(const_cast<char*>(data.data()), 0, data.size());
+        } else {
+          TF_RETURN_IF_ERROR(
+              batch_util::SetElementZero(&batch_component, padding_value));
+        }
+
         TensorShape component_shape({});
         for (int i = 1; i < batch_component_shape.dims(); ++i) {
           TF_RETURN_IF_ERROR(component_shape.AddDimWithStatus(
               batch_component_shape.dim_size(i)));
         }
-        auto copy_element_fn = [component_index, &batch_elements,
-                                &batch_component, &component_shape](int index) {
+        component_shapes[component_index] = std::move(component_shape);
+        return absl::OkStatus();
+      };
+
+      // Copies the slices for elements [begin, end) of component
+      // `component_index` into the output tensor.
+      auto copy_range_fn = [&batch_elements, &component_shapes, out_tensors](
+                               size_t component_index, int64_t begin,
+                               int64_t end) {
+        Tensor& batch_component = (*out_tensors)[component_index];
+        for (int64_t index = begin; index < end; ++index) {
           // Take the fast path if possible.
           if (batch_elements[index][component_index].shape() ==
-              component_shape) {
+              component_shapes[component_index]) {
             TF_RETURN_IF_ERROR(batch_util::CopyElementToSlice(
                 batch_elements[index][component_index], &batch_component,
                 index));
@@ -365,15 +405,59 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
                 batch_elements[index][component_index], &batch_component,
                 index));
           }
-          return absl::OkStatus();
-        };
-
-        if (dataset()->parallel_copy_ && (batch_component.AllocatedBytes() /
-                                          num_batch_elements) >= (1 << 15)) {
-          BlockingCounter counter(num_batch_elements);
-          Status status;
-          mutex status_mu;
-          const auto num_threads = ctx->runner_threadpool_size();
+        }
+        return absl::OkStatus();
+      };
+
+      if (!dataset()->parallel_copy_) {
+        for (size_t component_index = 0; component_index < num_tuple_components;
+             ++component_index) {
+          TF_RETURN_IF_ERROR(assemble_component_fn(component_index));
+          TF_RETURN_IF_ERROR(
+              copy_range_fn(component_index, 0, num_batch_elements));
+        }
+        return absl::OkStatus();
+      }
+
+      Status status;
+      mutex status_mu;
+
+      // Phase 1: shape computation, allocation, and padding fill run in
+      // parallel across components. Components write to disjoint entries of
+      // `out_tensors` and `component_shapes`.
+      {
+        BlockingCounter counter(num_tuple_components);
+        for (size_t component_index = 0; component_index < num_tuple_components;
+             ++component_index) {
+          (*ctx->runner())([component_index, &assemble_component_fn, &status,
+                            &status_mu, &counter]() {
+            Status s = assemble_component_fn(component_index);
+            {
+              mutex_lock l(status_mu);
+              status.Update(s);
+            }
+            counter.DecrementCount();
+          });
+        }
+        counter.Wait();
+      }
+      TF_RETURN_IF_ERROR(status);
+
+      // Phase 2: element copies run in parallel across components and element
+      // ranges. Components with small rows are copied as a single task, since
+      // sharding them would cost more than the copies themselves.
+      struct CopyTask {
+        size_t component_index;
+        int64_t begin;
+        int64_t end;
+      };
+      std::vector<CopyTask> tasks;
+      const auto num_threads = ctx->runner_threadpool_size();
+      for (size_t component_index = 0; component_index < num_tuple_components;
+           ++component_index) {
+        const Tensor& batch_component = (*out_tensors)[component_index];
+        if (num_threads > 1 && (batch_component.AllocatedBytes() /
+                                num_batch_elements) >= (1 << 15)) {
           const auto slice_size = num_batch_elements / num_threads;
           int64_t offset = 0;
           for (size_t i = 0; i < num_threads; ++i) {
@@ -382,27 +466,29 @@ class PaddedBatchDatasetOp::Dataset : public DatasetBase {
             // evenly, the size of some slices is incremented to guarantee their
             // sizes add up to the total number of elements.
             if (i < num_batch_elements % num_threads) ++length;
-            (*ctx->runner())([offset, length, &status, &status_mu, &counter,
-                              &copy_element_fn]() {
-              for (size_t j = offset; j < offset + length; ++j) {
-                {
-                  Status s = copy_element_fn(j);
-                  mutex_lock l(status_mu);
-                  status.Update(s);
-                }
-                counter.DecrementCount();
-              }
-            });
+            if (length > 0) {
+              tasks.push_back({component_index, offset, offset + length});
+            }
             offset += length;
           }
-          counter.Wait();
-          TF_RETURN_IF_ERROR(status);
         } else {
-          for (size_t i = 0; i < num_batch_elements; ++i) {
-            TF_RETURN_IF_ERROR(copy_element_fn(i));
-          }
+          tasks.push_back({component_index, 0, num_batch_elements});
         }
       }
+      BlockingCounter counter(tasks.size());
+      for (const CopyTask& task : tasks) {
+        (*ctx->runner())([task, &copy_range_fn, &status, &status_mu,
+                          &counter]() {
+          Status s = copy_range_fn(task.component_index, task.begin, task.end);
+          {
+            mutex_lock l(status_mu);
+            status.Update(s);
+          }
+          counter.DecrementCount();
+        });
+      }
+      counter.Wait();
+      TF_RETURN_IF_ERROR(status);
       return absl::OkStatus();
     }
 
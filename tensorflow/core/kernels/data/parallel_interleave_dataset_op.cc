@@ -1011,6 +1011,13 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
     // future worker's job is to keep `future_elements_` filled with elements.
     // Elements in `future_elements` have had their first `kPerIteratorPrefetch`
     // results computed.
+    //
+    // When `future_elements_` is already full, a future worker has nothing of
+    // its own to do, so instead of going to sleep it steals pending
+    // current-cycle work from `elements_to_process_`. This keeps all workers
+    // busy when the current cycle has more unprocessed elements than current
+    // workers (e.g. with skewed per-element processing times), and does not
+    // affect the order in which `GetNextInternal` consumes results.
     void FutureWorkerThread(std::shared_ptr<IteratorContext> ctx)
         TF_LOCKS_EXCLUDED(mu_) {
       RecordStart(ctx.get());
@@ -1025,6 +1032,7 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
         DecrementOutstandingThreads();
       };
       while (true) {
+        std::shared_ptr<Element> stolen_element;
         {
           mutex_lock l(*mu_);
           if (element) {
@@ -1035,24 +1043,59 @@ class ParallelInterleaveDatasetOp::Dataset : public DatasetBase {
               elements_to_process_.push_back(element->cycle_index);
               current_workers_cond_var_.notify_one();
             }
+            element.reset();
           }
           while (!cancelled_ && (future_elements_.size() >=
                                      dataset()->prefetch_input_elements_ ||
                                  wait_for_checkpoint_)) {
+            if (!wait_for_checkpoint_) {
+              // The future buffer is full, so steal unclaimed current-cycle
+              // work instead of idling.
+              while (!elements_to_process_.empty()) {
+                int index = elements_to_process_.front();
+                elements_to_process_.pop_front();
+                auto& e = current_elements_[index];
+                if (NeedsProcessing(e) && !e->active) {
+                  stolen_element = e;
+                  break;
+                }
+              }
+              if (stolen_element) {
+                break;
+              }
+            }
             WaitWorkerThread(ctx.get(), &future_workers_cond_var_, &l);
           }
           if (cancelled_) {
             done();
             return;
           }
-          element = MakeElement(ctx.get());
-          if (!element) {
-            done();
-            return;
+          if (stolen_element) {
+            VLOG(3) << "Future worker stole element " << stolen_element->id;
+            stolen_element->active = true;
+          } else {
+            element = MakeElement(ctx.get());
+            if (!element) {
+              done();
+              return;
+            }
+            VLOG(3) << "Future worker created element " << element->id;
+            element->active = true;
+            future_elements_.push_back(element);
           }
-          VLOG(3) << "Future worker created element " << element->id;
-          element->active = true;
-          future_elements_.push_back(element);
+        }
+        if (stolen_element) {
+          // Process the stolen element the way a current worker would, until
+          // its results buffer is full or it reaches end of input.
+          while (true) {
+            ProcessElement(ctx.get(), stolen_element);
+            mutex_lock l(*mu_);
+            if (!NeedsProcessing(stolen_element)) {
+              stolen_element->active = false;
+              break;
+            }
+          }
+          continue;
         }
         ProcessElement(ctx.get(), element);
       }
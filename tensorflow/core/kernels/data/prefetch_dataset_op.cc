@@ -214,7 +214,12 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
                buffer_limit() != 0) {
           if (legacy_autotune_) {
             auto_tuner_->RecordEmpty();
+            const int64_t old_limit = buffer_size_->value;
             buffer_size_->value = auto_tuner_->buffer_limit();
+            if (buffer_size_->value > old_limit) {
+              // The prefetch thread may be blocked on the old, smaller limit.
+              cond_var_->notify_all();
+            }
           }
           RecordStop(ctx);
           cond_var_->wait(l);
@@ -483,6 +488,8 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
         // errors.
         RecordBufferDequeue(ctx, buffer_.front().value);
       }
+      const size_t old_size = buffer_.size();
+      const int64_t old_limit = buffer_limit();
       if (legacy_autotune_) {
         auto_tuner_->RecordConsumption(buffer_.size());
         buffer_size_->value = auto_tuner_->buffer_limit();
@@ -490,12 +497,16 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
       buffer_.pop_front();
       *end_of_sequence = false;
 
-      // Wake the prefetch thread, in case it has been waiting for space
-      // in the buffer. Also wake up threads from other calls to GetNext.
-      //
-      // TODO(mrry): Consider using different condition variables for
-      // GetNext and Prefetch.
-      cond_var_->notify_all();
+      // Wake the prefetch thread only when it can actually be blocked: it
+      // waits for space only once the buffer has reached the limit, so pops
+      // from a buffer strictly below the limit have nobody to wake. (Limit
+      // growth is signaled at the sites that grow it.) Other GetNext calls
+      // block only on an empty buffer and are woken by the prefetch thread,
+      // so per-element notification from the consumer side is unnecessary.
+      if (old_size >= static_cast<size_t>(old_limit) ||
+          buffer_limit() > old_limit) {
+        cond_var_->notify_all();
+      }
       return s;
     }
 
@@ -574,8 +585,14 @@ class PrefetchDatasetOp::Dataset : public DatasetBase {
           mutex_lock l(*mu_);
           RecordBufferEnqueue(ctx.get(), buffer_element.value);
           buffer_element.created_us = EnvTime::NowMicros();
+          const bool was_empty = buffer_.empty();
           buffer_.push_back(std::move(buffer_element));
-          cond_var_->notify_all();
+          // Consumers only block on an empty buffer, so signal only on the
+          // empty -> non-empty transition instead of once per element. At high
+          // element rates this removes the condvar handoff from the hot path.
+          if (was_empty) {
+            cond_var_->notify_all();
+          }
         }
         ++num_produced;
       }
@@ -25,6 +25,7 @@ limitations under the License.
 
 #include "absl/container/flat_hash_set.h"
 #include "absl/strings/str_cat.h"
+#include "tensorflow/core/data/compression_utils.h"
 #include "tensorflow/core/data/dataset_utils.h"
 #include "tensorflow/core/data/name_utils.h"
 #include "tensorflow/core/data/serialization_utils.h"
@@ -32,6 +33,7 @@ limitations under the License.
 #include "tensorflow/core/framework/partial_tensor_shape.h"
 #include "tensorflow/core/framework/resource_mgr.h"
 #include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/variant.h"
 #include "tensorflow/core/kernels/data/random_seed_ops.h"
 #include "tensorflow/core/lib/core/errors.h"
 #include "tensorflow/core/lib/random/philox_random.h"
@@ -39,6 +41,7 @@ limitations under the License.
 #include "tensorflow/core/lib/random/random_distributions.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/stringprintf.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace data {
@@ -81,6 +84,27 @@ constexpr char kShuffleDatasetV3[] = "ShuffleDatasetV3";
 constexpr char kShuffleAndRepeatDatasetV1[] = "ShuffleAndRepeatDataset";
 constexpr char kShuffleAndRepeatDatasetV2[] = "ShuffleAndRepeatDatasetV2";
 
+// When this environment variable is set to true, buffered elements are kept
+// in compressed packed form and decompressed as they are drawn. This trades
+// CPU on insert and draw for a much smaller resident buffer when shuffling
+// large numbers of small records, where per-tensor overhead dominates.
+constexpr char kCompressShuffleBufferEnvVar[] =
+    "TF_DATA_SHUFFLE_COMPRESS_BUFFER";
+
+static bool ShuffleBufferCompressionEnabled() {
+  static const bool enabled = [] {
+    bool result = false;
+    Status s = ReadBoolFromEnvVar(kCompressShuffleBufferEnvVar,
+                                  /*default_val=*/false, &result);
+    if (!s.ok()) {
+      LOG(WARNING) << "Failed to parse " << kCompressShuffleBufferEnvVar << ": "
+                   << s;
+    }
+    return result;
+  }();
+  return enabled;
+}
+
 ShuffleDatasetOpBase::ShuffleDatasetOpBase(OpKernelConstruction* ctx)
     : UnaryDatasetOpKernel(ctx) {}
 
@@ -190,7 +214,8 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         : DatasetIterator<ShuffleDatasetBase>(params),
           seed_generator_(seed_generator),
           parent_generator_(seed_generator->seed(), seed_generator->seed2()),
-          generator_(&parent_generator_) {
+          generator_(&parent_generator_),
+          compress_buffer_(ShuffleBufferCompressionEnabled()) {
       if (params.dataset->buffer_size_ == kUnknownCardinality) {
         buffer_ = std::make_unique<std::vector<std::vector<Tensor>>>();
       } else {
@@ -241,6 +266,9 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       checkpoint_indices_.insert(slices_.front()->start % buffer_->size());
       slices_.front()->start++;
       num_elements_--;
+      if (compress_buffer_) {
+        TF_RETURN_IF_ERROR(MaybeUncompressElement(out_tensors));
+      }
       return absl::OkStatus();
     }
 
@@ -463,7 +491,7 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
           slices_.back()->reached_end_of_sequence = true;
         }
         if (!end_of_input_sequence) {
-          AddToShuffleBuffer(ctx, std::move(input_element));
+          TF_RETURN_IF_ERROR(AddToShuffleBuffer(ctx, std::move(input_element)));
           continue;
         }
         input_impl_.reset();
@@ -520,13 +548,17 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       return absl::OkStatus();
     }
 
-    void AddToShuffleBuffer(IteratorContext* ctx, std::vector<Tensor>&& element)
+    Status AddToShuffleBuffer(IteratorContext* ctx,
+                              std::vector<Tensor>&& element)
         TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
       data_produced_ = true;
       if (num_elements_ == 0) {
         VLOG(1) << "Starting to fill up shuffle buffer of size: "
                 << BufferSizeString();
       }
+      if (compress_buffer_) {
+        TF_RETURN_IF_ERROR(CompressBufferElement(&element));
+      }
       this->RecordBufferEnqueue(ctx, element);
       if (num_elements_ == buffer_->size()) {
         DCHECK(IsShuffleAll());
@@ -539,6 +571,42 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
       }
       num_elements_++;
       slices_.back()->end++;
+      return absl::OkStatus();
+    }
+
+    // Replaces `element` with a single scalar variant tensor holding its
+    // compressed packed form.
+    Status CompressBufferElement(std::vector<Tensor>* element) {
+      CompressedElement compressed;
+      TF_RETURN_IF_ERROR(CompressElement(*element, &compressed));
+      Tensor packed(DT_VARIANT, TensorShape({}));
+      packed.scalar<Variant>()() = std::move(compressed);
+      element->clear();
+      element->push_back(std::move(packed));
+      return absl::OkStatus();
+    }
+
+    // Restores an element stored by `CompressBufferElement` to its original
+    // components. Elements that are not in compressed form (e.g. restored
+    // from a checkpoint written without buffer compression) pass through
+    // unchanged.
+    Status MaybeUncompressElement(std::vector<Tensor>* element) {
+      if (element->size() != 1) {
+        return absl::OkStatus();
+      }
+      const Tensor& packed = element->front();
+      if (packed.dtype() != DT_VARIANT || packed.dims() != 0) {
+        return absl::OkStatus();
+      }
+      const CompressedElement* compressed =
+          packed.scalar<Variant>()().get<CompressedElement>();
+      if (compressed == nullptr) {
+        return absl::OkStatus();
+      }
+      std::vector<Tensor> components;
+      TF_RETURN_IF_ERROR(UncompressElement(*compressed, &components));
+      *element = std::move(components);
+      return absl::OkStatus();
     }
 
     void ClearEmptySlices() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
@@ -579,6 +647,9 @@ class ShuffleDatasetOpBase::ShuffleDatasetBase : public DatasetBase {
         TF_GUARDED_BY(mu_);
     int64_t num_random_samples_ TF_GUARDED_BY(mu_) = 0;
     bool data_produced_ TF_GUARDED_BY(mu_) = false;
+    // Whether buffered elements are stored in compressed packed form. See
+    // `kCompressShuffleBufferEnvVar`.
+    const bool compress_buffer_;
   };
 
   const DatasetBase* const input_;
@@ -15,12 +15,14 @@ limitations under the License.
 
 // See docs in ../ops/data_flow_ops.cc.
 
+#include <algorithm>
 #include <vector>
 #include "tensorflow/core/framework/bounds_check.h"
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/register_types.h"
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/types.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/util/util.h"
 
@@ -40,8 +42,8 @@ class DynamicPartitionOp_Shared : public OpKernel {
   }
 
   void ValidateAndAllocateOutputs(OpKernelContext* c, const Tensor** data,
-                                  const Tensor** partitions,
-                                  OpOutputList* Tout) {
+                                  const Tensor** partitions, OpOutputList* Tout,
+                                  gtl::InlinedVector<int, 32>* counts) {
     OP_REQUIRES_OK(c, c->input("data", data));
     OP_REQUIRES_OK(c, c->input("partitions", partitions));
     OP_REQUIRES(
@@ -53,7 +55,8 @@ class DynamicPartitionOp_Shared : public OpKernel {
             ", partitions.shape = ", (*partitions)->shape().DebugString()));
 
     // Count how many occurrences of each partition id we have in partitions
-    gtl::InlinedVector<int, 32> partition_count(num_partitions_);
+    gtl::InlinedVector<int, 32>& partition_count = *counts;
+    partition_count.resize(num_partitions_);
     auto e_partitions = (*partitions)->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
     for (int64_t i = 0; i < N; i++) {
@@ -91,71 +94,61 @@ class DynamicPartitionOp : public DynamicPartitionOp_Shared {
     const Tensor* data;
     const Tensor* partitions;
     OpOutputList outputs;
-    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs);
+    gtl::InlinedVector<int, 32> partition_count;
+    ValidateAndAllocateOutputs(c, &data, &partitions, &outputs,
+                               &partition_count);
     if (!c->status().ok()) return;
     if (num_partitions_ == 0 || data->NumElements() == 0) return;
 
     auto e_partitions = partitions->flat<int32>();
     const int64_t N = e_partitions.dimension(0);
+    const int64_t slice_size = data->NumElements() / N;
+    const T* data_base = data->flat<T>().data();
+
+    std::vector<T*> out_base(num_partitions_);
+    for (int p = 0; p < num_partitions_; p++) {
+      out_base[p] = outputs[p]->flat<T>().data();
+    }
+
+    // One cheap pass resolves every element's destination from the write
+    // cursors; the output sizes were already fixed by the counting pass in
+    // ValidateAndAllocateOutputs. The partition ids are re-validated because
+    // the input buffer may alias memory that is written concurrently.
+    std::vector<T*> dst(N);
     gtl::InlinedVector<int, 32> output_index(num_partitions_);
+    for (int64_t i = 0; i < N; i++) {
+      const int32_t p = internal::SubtleMustCopy(e_partitions(i));
+      OP_REQUIRES(c, FastBoundsCheck(p, num_partitions_),
+                  errors::InvalidArgument("indices[", i, "] is out of range"));
+      const auto oi = output_index[p];
+      OP_REQUIRES(c, oi < partition_count[p],
+                  errors::InvalidArgument(
+                      "outputs[", p, "] size: ", partition_count[p],
+                      " is not LTE output_index[", p, "] : ", oi));
+      dst[i] = out_base[p] + static_cast<int64_t>(oi) * slice_size;
+      output_index[p]++;
+    }
 
-    if (partitions->dims() == data->dims()) {
-      // Walk through data and copy the data to the appropriate output tensor
-      const auto data_flat = data->flat<T>();
-      std::vector<Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor>,
-                                   Eigen::Aligned> >
-          out_vec;
-      out_vec.reserve(num_partitions_);
-      for (int p = 0; p < num_partitions_; p++) {
-        out_vec.push_back(outputs[p]->vec<T>());
-      }
-      for (int64_t i = 0; i < N; i++) {
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i, "] is out of range"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_vec[p].size()),
-                    errors::InvalidArgument(
-                        "out_vec[", p, "] size: ", out_vec[p].size(),
-                        " is not LTE output_index[", p, "] : ", oi));
-        out_vec[p](oi) = data_flat(i);
-        output_index[p]++;
+    // The destinations are disjoint, so the copies can run in any order and
+    // in parallel without changing the result.
+    auto copy_slices = [&](int64_t begin, int64_t end) {
+      for (int64_t i = begin; i < end; ++i) {
+        std::copy_n(data_base + i * slice_size, slice_size, dst[i]);
       }
+    };
+    thread::ThreadPool* workers =
+        c->device()->tensorflow_cpu_worker_threads()->workers;
+    if (workers->NumThreads() > 0 &&
+        N * slice_size >= kMinElemsForParallelPartitionCopy) {
+      workers->ParallelFor(
+          N, static_cast<int64_t>(slice_size) * sizeof(T), copy_slices);
     } else {
-      // If data has extra dimensions, use Eigen slices
-      std::vector<Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>,
-                                   Eigen::Aligned> >
-          out_flat;
-      out_flat.reserve(num_partitions_);
-      for (int p = 0; p < num_partitions_; p++) {
-        out_flat.push_back(outputs[p]->flat_outer_dims<T>());
-      }
-
-      // Walk through data and copy the data to the appropriate output tensor
-      const int64_t slice_size = data->NumElements() / N;
-      const auto data_flat = data->shaped<T, 2>({N, slice_size});
-      Eigen::DSizes<Eigen::DenseIndex, 2> sizes(1, slice_size);
-      for (int64_t i = 0; i < N; i++) {
-        // outputs[p][output_index[p]++] = data[i]
-        const int32_t p = internal::SubtleMustCopy(e_partitions(i));
-        OP_REQUIRES(
-            c, FastBoundsCheck(p, num_partitions_),
-            errors::InvalidArgument("indices[", i,
-                                    "] has been asynchronously overwritten and "
-                                    "is no longer in range!"));
-        auto oi = output_index[p];
-        OP_REQUIRES(c, FastBoundsCheck(oi, out_flat[p].dimension(0)),
-                    errors::InvalidArgument("Size of output_index: ", oi,
-                                            " is no longer in range."));
-        Eigen::DSizes<Eigen::DenseIndex, 2> out_indices(oi, 0);
-        Eigen::DSizes<Eigen::DenseIndex, 2> data_indices(i, 0);
-        out_flat[p].slice(out_indices, sizes) =
-            data_flat.slice(data_indices, sizes);
-        output_index[p]++;
-      }
+      copy_slices(0, N);
     }
   }
+
+ private:
+  static constexpr int64_t kMinElemsForParallelPartitionCopy = 64 << 10;
 };
 
 #define REGISTER_DYNAMIC_PARTITION(T)                                     \
@@ -107,6 +107,8 @@ struct ExampleStore {
       AddExample(&serialized_example, 10, 1, 100000);
       AddExample(&serialized_example, 100, 1, 10000);
       AddExample(&serialized_example, 1000, 1, 1000);
+      // Varlen-heavy shape: many keys, each with a multi-element list.
+      AddExample(&serialized_example, 100, 128, 64);
     });
     return serialized_example;
   }
@@ -370,7 +372,8 @@ typedef BenchmarkOptions<ExampleStore<FloatFiller>, kRagged> RaggedFloat;
   BM_ParseExample(Type, 1, 1000, 1);   \
   BM_ParseExample(Type, 128, 1000, 1); \
   BM_ParseExample(Type, 512, 1000, 1); \
-  BM_ParseExample(Type, 1, 1, 1000000);
+  BM_ParseExample(Type, 1, 1, 1000000); \
+  BM_ParseExample(Type, 128, 100, 64);
 
 BM_AllParseExample(SparseString);
 BM_AllParseExample(DenseString);
@@ -410,6 +413,7 @@ BM_AllParseExample(VarLenDenseFloat);
   BM_ParseExampleV2(Type, 128, 1000, 1);  \
   BM_ParseExampleV2(Type, 512, 1000, 1);  \
   BM_ParseExampleV2(Type, 1, 1, 1000000); \
+  BM_ParseExampleV2(Type, 128, 100, 64);  \
   /* Scalar Inputs */                     \
   BM_ParseExampleV2(Type, 0, 10, 1);      \
   BM_ParseExampleV2(Type, 0, 100, 1);     \
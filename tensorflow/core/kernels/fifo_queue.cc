@@ -50,6 +50,34 @@ void FIFOQueue::DequeueLocked(OpKernelContext* ctx, Tuple* tuple) {
 
 void FIFOQueue::TryEnqueue(const Tuple& tuple, OpKernelContext* ctx,
                            DoneCallback callback) {
+  // Fast path: when there is space and no producer is already waiting, the
+  // element can be enqueued under a single lock acquisition, skipping the
+  // cancellation-callback registration and attempt bookkeeping that dominate
+  // the cost of high-rate single-element traffic. Pending producers force the
+  // slow path so that enqueues complete in arrival order.
+  {
+    bool enqueued = false;
+    bool flush = false;
+    {
+      mutex_lock l(mu_);
+      if (!closed_ && enqueue_attempts_.empty() &&
+          queues_[0].size() < static_cast<size_t>(capacity_)) {
+        for (int i = 0; i < num_components(); ++i) {
+          queues_[i].push_back(tuple[i]);
+        }
+        enqueued = true;
+        flush = !dequeue_attempts_.empty();
+      }
+    }
+    if (enqueued) {
+      if (flush) {
+        FlushUnlocked();
+      }
+      callback();
+      return;
+    }
+  }
+
   CancellationManager* cm = ctx->cancellation_manager();
   CancellationToken token = cm->get_cancellation_token();
   bool already_cancelled;
@@ -153,6 +181,31 @@ void FIFOQueue::TryEnqueueMany(const Tuple& tuple, OpKernelContext* ctx,
 }
 
 void FIFOQueue::TryDequeue(OpKernelContext* ctx, CallbackWithTuple callback) {
+  // Fast path: when an element is available and no consumer is already
+  // waiting, dequeue it under a single lock acquisition. See the matching
+  // fast path in TryEnqueue(). A dequeue that frees a slot wakes pending
+  // producers via FlushUnlocked().
+  {
+    bool dequeued = false;
+    bool flush = false;
+    Tuple tuple;
+    {
+      mutex_lock l(mu_);
+      if (dequeue_attempts_.empty() && !queues_[0].empty()) {
+        DequeueLocked(ctx, &tuple);
+        dequeued = true;
+        flush = !enqueue_attempts_.empty();
+      }
+    }
+    if (dequeued) {
+      if (flush) {
+        FlushUnlocked();
+      }
+      callback(tuple);
+      return;
+    }
+  }
+
   CancellationManager* cm = ctx->cancellation_manager();
   CancellationToken token = cm->get_cancellation_token();
   bool already_cancelled;
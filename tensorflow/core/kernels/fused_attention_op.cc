@@ -0,0 +1,163 @@
+/* Copyright 2023 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+// CPU kernel for _FusedScaledDotProductAttention, the attention core emitted
+// by the grappler remapper: softmax(query * key^T * scale) * value. The
+// softmax runs in streaming form per query row, so neither the score matrix
+// nor the softmax output is ever materialized.
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+#include "tensorflow/core/framework/op_kernel.h"
+#include "tensorflow/core/framework/register_types.h"
+#include "tensorflow/core/framework/tensor.h"
+#include "tensorflow/core/framework/tensor_shape.h"
+#include "tensorflow/core/platform/errors.h"
+#include "tensorflow/core/util/work_sharder.h"
+
+namespace tensorflow {
+
+template <typename T>
+class FusedScaledDotProductAttentionOp : public OpKernel {
+ public:
+  explicit FusedScaledDotProductAttentionOp(OpKernelConstruction* context)
+      : OpKernel(context) {
+    OP_REQUIRES_OK(context, context->GetAttr("scale_is_reciprocal",
+                                             &scale_is_reciprocal_));
+  }
+
+  void Compute(OpKernelContext* context) override {
+    const Tensor& query = context->input(0);
+    const Tensor& key = context->input(1);
+    const Tensor& value = context->input(2);
+    const Tensor& scale_tensor = context->input(3);
+
+    OP_REQUIRES(context, scale_tensor.NumElements() == 1,
+                errors::InvalidArgument("scale must have a single element, "
+                                        "got shape ",
+                                        scale_tensor.shape().DebugString()));
+    const int dims = query.dims();
+    OP_REQUIRES(context,
+                dims >= 2 && key.dims() == dims && value.dims() == dims,
+                errors::InvalidArgument(
+                    "query, key and value must have the same rank >= 2, got ",
+                    dims, ", ", key.dims(), " and ", value.dims()));
+    for (int i = 0; i < dims - 2; ++i) {
+      OP_REQUIRES(context,
+                  query.dim_size(i) == key.dim_size(i) &&
+                      query.dim_size(i) == value.dim_size(i),
+                  errors::InvalidArgument(
+                      "query, key and value must have equal batch dimensions; "
+                      "broadcasting is not supported. Got ",
+                      query.shape().DebugString(), ", ",
+                      key.shape().DebugString(), " and ",
+                      value.shape().DebugString()));
+    }
+    const int64_t depth = query.dim_size(dims - 1);
+    OP_REQUIRES(context, key.dim_size(dims - 1) == depth,
+                errors::InvalidArgument(
+                    "query and key must have the same inner dimension, got ",
+                    depth, " and ", key.dim_size(dims - 1)));
+    const int64_t num_queries = query.dim_size(dims - 2);
+    const int64_t num_keys = key.dim_size(dims - 2);
+    OP_REQUIRES(context, value.dim_size(dims - 2) == num_keys,
+                errors::InvalidArgument(
+                    "key and value must have the same number of rows, got ",
+                    num_keys, " and ", value.dim_size(dims - 2)));
+    const int64_t value_depth = value.dim_size(dims - 1);
+
+    TensorShape output_shape = query.shape();
+    output_shape.set_dim(dims - 1, value_depth);
+    Tensor* output = nullptr;
+    OP_REQUIRES_OK(context,
+                   context->allocate_output(0, output_shape, &output));
+    if (output->NumElements() == 0) return;
+    OP_REQUIRES(context, num_keys > 0,
+                errors::InvalidArgument(
+                    "key and value must have at least one row"));
+
+    T scale = scale_tensor.flat<T>()(0);
+    if (scale_is_reciprocal_) {
+      scale = static_cast<T>(1) / scale;
+    }
+
+    const int64_t batch =
+        num_queries > 0 ? query.NumElements() / (num_queries * depth) : 0;
+    const T* query_data = query.flat<T>().data();
+    const T* key_data = key.flat<T>().data();
+    const T* value_data = value.flat<T>().data();
+    T* output_data = output->flat<T>().data();
+
+    // One unit of work handles one query row: a streaming pass over the keys
+    // maintains the running softmax maximum and denominator while the output
+    // row accumulates the value rows, rescaled whenever the maximum moves.
+    auto attend_rows = [&](int64_t begin, int64_t end) {
+      for (int64_t row = begin; row < end; ++row) {
+        const int64_t b = row / num_queries;
+        const T* q_row = query_data + row * depth;
+        const T* k_base = key_data + b * num_keys * depth;
+        const T* v_base = value_data + b * num_keys * value_depth;
+        T* out_row = output_data + row * value_depth;
+
+        std::fill(out_row, out_row + value_depth, static_cast<T>(0));
+        T row_max = -std::numeric_limits<T>::infinity();
+        T denom = static_cast<T>(0);
+        for (int64_t j = 0; j < num_keys; ++j) {
+          const T* k_row = k_base + j * depth;
+          T score = static_cast<T>(0);
+          for (int64_t l = 0; l < depth; ++l) {
+            score += q_row[l] * k_row[l];
+          }
+          score *= scale;
+          if (score > row_max) {
+            const T rescale = std::exp(row_max - score);
+            denom *= rescale;
+            for (int64_t l = 0; l < value_depth; ++l) {
+              out_row[l] *= rescale;
+            }
+            row_max = score;
+          }
+          const T weight = std::exp(score - row_max);
+          denom += weight;
+          const T* v_row = v_base + j * value_depth;
+          for (int64_t l = 0; l < value_depth; ++l) {
+            out_row[l] += weight * v_row[l];
+          }
+        }
+        const T inv_denom = static_cast<T>(1) / denom;
+        for (int64_t l = 0; l < value_depth; ++l) {
+          out_row[l] *= inv_denom;
+        }
+      }
+    };
+
+    auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+    const int64_t cost_per_row = num_keys * (depth + value_depth);
+    Shard(worker_threads.num_threads, worker_threads.workers,
+          batch * num_queries, cost_per_row, attend_rows);
+  }
+
+ private:
+  bool scale_is_reciprocal_;
+};
+
+REGISTER_KERNEL_BUILDER(Name("_FusedScaledDotProductAttention")
+                            .Device(DEVICE_CPU)
+                            .TypeConstraint<float>("T"),
+                        FusedScaledDotProductAttentionOp<float>);
+
+}  // namespace tensorflow
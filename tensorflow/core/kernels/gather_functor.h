@@ -56,6 +56,11 @@ SliceIndex HandleCopies(OpKernelContext* ctx,
   // Store the value of invalidate index for printing error information, it's a
   // shared variable.
   SliceIndex result = -1;
+  // How many iterations ahead to prefetch the gathered row. The one-ahead
+  // prefetch below only hides memory latency behind a single slice copy,
+  // which is not enough for small slices gathered from tables that miss
+  // cache; a deeper prefetch gives the loads more time to complete.
+  static constexpr SliceIndex kPrefetchLookahead = 8;
   auto work = [&](int64_t start, int64_t end) {
     SliceIndex batch_idx = static_cast<SliceIndex>(start / indices_size);
     SliceIndex indices_idx = static_cast<SliceIndex>(start % indices_size);
@@ -76,6 +81,14 @@ SliceIndex HandleCopies(OpKernelContext* ctx,
           (i_next < indices_size)) {
         absl::PrefetchToLocalCache(&params(batch_idx, indices(i_next), 0));
         absl::PrefetchToLocalCache(&out(batch_idx, i_next, 0));
+        // Also prefetch further ahead within this batch. The index value has
+        // not been bounds-checked yet, but prefetching an arbitrary address
+        // is architecturally safe.
+        const SliceIndex i_ahead = indices_idx + kPrefetchLookahead;
+        if (i_ahead < (batch_idx == batch_idx_end ? indices_idx_end
+                                                  : indices_size)) {
+          absl::PrefetchToLocalCache(&params(batch_idx, indices(i_ahead), 0));
+        }
         b_next = batch_idx;
       } else if (b_next <= batch_idx_end) {
         absl::PrefetchToLocalCache(&params(b_next, indices(0), 0));
@@ -16,6 +16,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/lookup_table_op.h"
 #define EIGEN_USE_THREADS
 
+#include <memory>
 #include <string>
 #include <type_traits>
 #include <utility>
@@ -27,6 +28,7 @@ limitations under the License.
 #include "tensorflow/core/lib/gtl/inlined_vector.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/random.h"
+#include "tensorflow/core/util/env_var.h"
 
 namespace tensorflow {
 namespace lookup {
@@ -36,6 +38,26 @@ std::string UniqueNodeName(const std::string& base) {
   return strings::StrCat(base, "/", counter.fetch_add(1), "/", random::New64());
 }
 
+namespace {
+
+// Whether mutable hash tables serve Find from an immutable snapshot that
+// readers load without taking the table mutex (TF_MUTABLE_HASH_TABLE_SNAPSHOT_READS).
+// Mutations then republish the snapshot, which costs a full table copy per
+// Insert/Remove call, so this trades write-side cost for read paths that
+// scale with reader threads. Intended for serving workloads with many
+// concurrent lookups and comparatively rare sparse updates.
+bool SnapshotReadsEnabled() {
+  static const bool enabled = [] {
+    bool enabled = false;
+    TF_CHECK_OK(ReadBoolFromEnvVar("TF_MUTABLE_HASH_TABLE_SNAPSHOT_READS",
+                                   /*default_val=*/false, &enabled));
+    return enabled;
+  }();
+  return enabled;
+}
+
+}  // namespace
+
 // Lookup table that wraps an unordered_map, where the key and value data type
 // is specified. Each individual value must be a scalar. If vector values are
 // required, use MutableHashTableOfTensors.
@@ -53,7 +75,10 @@ std::string UniqueNodeName(const std::string& base) {
 template <class K, class V>
 class MutableHashTableOfScalars final : public LookupInterface {
  public:
-  MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel) {}
+  MutableHashTableOfScalars(OpKernelContext* ctx, OpKernel* kernel)
+      : snapshot_reads_(SnapshotReadsEnabled()),
+        snapshot_(snapshot_reads_ ? std::make_shared<const Table>() : nullptr) {
+  }
 
   size_t size() const override {
     tf_shared_lock l(mu_);
@@ -70,6 +95,21 @@ class MutableHashTableOfScalars final : public LookupInterface {
     int64_t default_total = default_flat.size();
     bool is_full_size_default = (total == default_total);
 
+    if (snapshot_reads_) {
+      // Serve the lookup from the last published snapshot without taking
+      // mu_, so concurrent readers do not contend with each other or with
+      // writers. A mutation racing with this call is observed either fully
+      // or not at all, which shared-lock readers also can't rule out.
+      const std::shared_ptr<const Table> snapshot =
+          std::atomic_load(&snapshot_);
+      for (int64_t i = 0; i < key_values.size(); ++i) {
+        value_values(i) = gtl::FindWithDefault(
+            *snapshot, SubtleMustCopyIfIntegral(key_values(i)),
+            is_full_size_default ? default_flat(i) : default_flat(0));
+      }
+      return absl::OkStatus();
+    }
+
     tf_shared_lock l(mu_);
     for (int64_t i = 0; i < key_values.size(); ++i) {
       // is_full_size_default is true:
@@ -98,6 +138,7 @@ class MutableHashTableOfScalars final : public LookupInterface {
       gtl::InsertOrUpdate(&table_, SubtleMustCopyIfIntegral(key_values(i)),
                           SubtleMustCopyIfIntegral(value_values(i)));
     }
+    PublishSnapshot();
     return absl::OkStatus();
   }
 
@@ -113,6 +154,7 @@ class MutableHashTableOfScalars final : public LookupInterface {
     for (int64_t i = 0; i < key_values.size(); ++i) {
       table_.erase(SubtleMustCopyIfIntegral(key_values(i)));
     }
+    PublishSnapshot();
     return absl::OkStatus();
   }
 
@@ -195,6 +237,8 @@ class MutableHashTableOfScalars final : public LookupInterface {
   }
 
  private:
+  using Table = std::unordered_map<K, V>;
+
   // Writes all keys and values into `keys` and `values`. `keys` and `values`
   // must point to tensors of size `table_.size()`.
   void ExportKeysAndValues(Tensor* keys, Tensor* values) const
@@ -208,8 +252,21 @@ class MutableHashTableOfScalars final : public LookupInterface {
     }
   }
 
+  // Publishes an immutable copy of table_ for the lock-free read path.
+  // Called at the end of every mutation, while mu_ is still held so
+  // publications cannot be reordered against each other.
+  void PublishSnapshot() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    if (snapshot_reads_) {
+      std::atomic_store(&snapshot_, std::make_shared<const Table>(table_));
+    }
+  }
+
+  const bool snapshot_reads_;
   mutable mutex mu_;
-  std::unordered_map<K, V> table_ TF_GUARDED_BY(mu_);
+  Table table_ TF_GUARDED_BY(mu_);
+  // Copy of table_ as of the last completed mutation; read with
+  // std::atomic_load and replaced wholesale, never mutated in place.
+  std::shared_ptr<const Table> snapshot_;
 };
 
 // Lookup table that wraps an unordered_map. Behaves identical to
@@ -432,11 +432,12 @@ struct LaunchBatchMatMul<CPUDevice, Scalar> {
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
     // TODO(rmlarsen): Reconsider the heuristics now that we have asynchronous
     // evaluation in Eigen Tensor.
-    if (small_dim > 1 &&
-        (batch_size == 1 || cost_per_unit > kMaxCostOuterParallelism)) {
+    if (small_dim > 1 && cost_per_unit > kMaxCostOuterParallelism) {
       // Parallelize over inner dims.
       // For large matrix products it is counter-productive to parallelize
-      // over the batch dimension.
+      // over the batch dimension. Cheap products fall through to the
+      // sequential kernel below, since the contraction setup and thread
+      // handoff cost more than the math itself.
       ParallelMatMulKernel::Run(context, in_x, in_y, adj_x, adj_y, trans_x,
                                 trans_y, bcast, out, batch_size);
       conjugate_result = adj_x;
@@ -14,6 +14,15 @@ limitations under the License.
 ==============================================================================*/
 
 // Implements a quantized eight-bit version of the matmul operation.
+//
+// This is the portable fallback implementation, built on gemmlowp (with a
+// NEON meta path on Arm). gemmlowp's public entry points pack both operands
+// on every call and dispatch to SSE4/NEON at best. On x86 serving builds the
+// oneDNN kernels under kernels/mkl/ (mkl_qmatmul_op.cc and friends, reached
+// through the _MklQuantizedMatMul* ops emitted by the graph rewrite) are the
+// intended int8 path: they dispatch to VNNI where available, cache the packed
+// weights across executions, and fuse the output scales into the GEMM
+// epilogue.
 
 #define EIGEN_USE_THREADS
 
@@ -12,9 +12,11 @@ WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
 See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
+#include <algorithm>
 #include <limits>
 #include <memory>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/core/framework/op_kernel.h"
@@ -22,6 +24,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -30,23 +33,61 @@ namespace {
 // For each slice in `(start, limit)` in `value_slices`, append
 // `params_dense_values_in[start:limit] to `values_out`.  `value_size` indicates
 // the number of scalars contained in each value params_dense_values_in[i].
+// Adjacent slices are coalesced into single bulk copies, and the copies are
+// sharded over `context`'s worker threads by output row; since every row
+// holds exactly `value_size` scalars, sharding on rows balances the number of
+// copied values per worker even when the slice lengths are skewed.
 template <typename VALUE_TYPE, typename SPLITS_TYPE>
 void WriteValueSlices(
-    const Tensor& params_dense_values_in,
+    OpKernelContext* context, const Tensor& params_dense_values_in,
     const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
     SPLITS_TYPE value_size, Tensor* values_out) {
-  const auto& params_dense_values =
-      params_dense_values_in.flat_outer_dims<VALUE_TYPE, 2>();
-  auto values = values_out->flat_outer_dims<VALUE_TYPE, 2>();
-  int out_pos = 0;
+  const VALUE_TYPE* params_dense_values =
+      params_dense_values_in.flat<VALUE_TYPE>().data();
+  VALUE_TYPE* values = values_out->flat<VALUE_TYPE>().data();
+
+  // Coalesce adjacent slices, and record the output row at which each
+  // coalesced slice starts.
+  std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>> coalesced_slices;
+  std::vector<SPLITS_TYPE> slice_out_rows;
+  coalesced_slices.reserve(value_slices.size());
+  slice_out_rows.reserve(value_slices.size() + 1);
+  SPLITS_TYPE num_rows = 0;
   for (const auto& slice : value_slices) {
-    for (int i = slice.first; i < slice.second; ++i) {
-      for (int j = 0; j < value_size; ++j) {
-        values(out_pos, j) = params_dense_values(i, j);
-      }
-      ++out_pos;
+    if (!coalesced_slices.empty() &&
+        coalesced_slices.back().second == slice.first) {
+      coalesced_slices.back().second = slice.second;
+    } else {
+      slice_out_rows.push_back(num_rows);
+      coalesced_slices.push_back(slice);
     }
+    num_rows += slice.second - slice.first;
   }
+  slice_out_rows.push_back(num_rows);
+  if (num_rows == 0) return;
+
+  // Copies the output rows [row_begin, row_end), which may span several
+  // coalesced slices.
+  auto copy_row_range = [&](int64_t row_begin, int64_t row_end) {
+    int64_t slice_ix = std::upper_bound(slice_out_rows.begin(),
+                                        slice_out_rows.end(), row_begin) -
+                       slice_out_rows.begin() - 1;
+    int64_t row = row_begin;
+    while (row < row_end) {
+      const auto& slice = coalesced_slices[slice_ix];
+      const int64_t offset = row - slice_out_rows[slice_ix];
+      const int64_t rows_copied = std::min<int64_t>(
+          row_end - row, slice.second - slice.first - offset);
+      std::copy_n(params_dense_values + (slice.first + offset) * value_size,
+                  rows_copied * value_size, values + row * value_size);
+      row += rows_copied;
+      ++slice_ix;
+    }
+  };
+  auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+  const int64_t cost_per_row = value_size * sizeof(VALUE_TYPE);
+  Shard(worker_threads->num_threads, worker_threads->workers, num_rows,
+        cost_per_row, copy_row_range);
 }
 
 }  // namespace
@@ -251,8 +292,8 @@ class RaggedGatherOpBase : public OpKernel {
     const SPLITS_TYPE value_size =
         num_elements == 0 ? 0
                           : (num_elements / params_dense_values_in.dim_size(0));
-    CallWriteValueSlices(params_dense_values_in, value_slices, value_size,
-                         values_out);
+    CallWriteValueSlices(context, params_dense_values_in, value_slices,
+                         value_size, values_out);
     return absl::OkStatus();
   }
 
@@ -263,7 +304,7 @@ class RaggedGatherOpBase : public OpKernel {
   // index type), rather than 14 (one for each index type and value type),
   // which cuts the binary size of this op from ~300k to <90k.
   virtual void CallWriteValueSlices(
-      const Tensor& params_dense_values_in,
+      OpKernelContext* context, const Tensor& params_dense_values_in,
       const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
       SPLITS_TYPE value_size, Tensor* values_out) const = 0;
 };
@@ -275,10 +316,10 @@ class RaggedGatherOp : public RaggedGatherOpBase<INDEX_TYPE, SPLITS_TYPE> {
 
  private:
   void CallWriteValueSlices(
-      const Tensor& params_dense_values_in,
+      OpKernelContext* context, const Tensor& params_dense_values_in,
       const std::vector<std::pair<SPLITS_TYPE, SPLITS_TYPE>>& value_slices,
       SPLITS_TYPE value_size, Tensor* values_out) const override {
-    WriteValueSlices<VALUE_TYPE>(params_dense_values_in, value_slices,
+    WriteValueSlices<VALUE_TYPE>(context, params_dense_values_in, value_slices,
                                  value_size, values_out);
   }
 };
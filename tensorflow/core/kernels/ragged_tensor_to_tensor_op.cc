@@ -40,6 +40,7 @@ limitations under the License.
 #include "tensorflow/core/platform/types.h"
 #include "tensorflow/core/util/bcast.h"
 #include "tensorflow/core/util/ragged_to_dense_util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -463,6 +464,24 @@ void copy_array<Eigen::half, int32>(Eigen::half* dst, const Eigen::half* src,
   slow_copy_array(dst, src, size);
 }
 
+// Fills `num_rows` rows of `row_size` values at `dst` with the (broadcast)
+// default value.  After the first row is written, the filled prefix is
+// repeatedly doubled with bulk copies, so a large padded region takes
+// O(log(num_rows)) copies rather than one small copy per row.
+template <typename VALUE_TYPE, typename INDEX_TYPE>
+void fill_default_rows(VALUE_TYPE* dst, const VALUE_TYPE* default_value,
+                       INDEX_TYPE num_rows, INDEX_TYPE row_size) {
+  if (num_rows <= 0) return;
+  copy_array<VALUE_TYPE, INDEX_TYPE>(dst, default_value, row_size);
+  INDEX_TYPE filled = row_size;
+  const INDEX_TYPE total = num_rows * row_size;
+  while (filled < total) {
+    const INDEX_TYPE nvals = std::min(filled, total - filled);
+    copy_array<VALUE_TYPE, INDEX_TYPE>(dst + filled, dst, nvals);
+    filled += nvals;
+  }
+}
+
 template <typename VALUE_TYPE, typename INDEX_TYPE>
 class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
  public:
@@ -514,8 +533,26 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
     }
 
     // Loop through the output_index vector, finding contiguous regions that
-    // should be copied.  Once we find the end of a contiguous region, copy it
-    // and add any necessary padding (with default_value).
+    // should be copied and gaps that should be padded (with default_value).
+    // The regions are recorded first, then executed below sharded over the
+    // worker threads by output row, so each worker is assigned a balanced
+    // number of values regardless of how the region sizes are skewed.
+    struct Region {
+      INDEX_TYPE src_start;  // Start in values; unused for padding regions.
+      INDEX_TYPE dst_start;  // Start in output.
+      INDEX_TYPE num_rows;
+      bool is_default;  // Fill with default_value instead of copying values.
+    };
+    std::vector<Region> regions;
+    std::vector<INDEX_TYPE> region_rows;  // Row offset of each region's start
+    INDEX_TYPE total_rows = 0;
+    auto add_region = [&](INDEX_TYPE src_start, INDEX_TYPE dst_start,
+                          INDEX_TYPE num_rows, bool is_default) {
+      if (num_rows <= 0) return;
+      regions.push_back({src_start, dst_start, num_rows, is_default});
+      region_rows.push_back(total_rows);
+      total_rows += num_rows;
+    };
     INDEX_TYPE src_start = 0;  // Start of contiguous region (in values)
     INDEX_TYPE dst_start = 0;  // Destination for contiguous region (in output)
     INDEX_TYPE dst_end = 0;    // Destination for contiguous region (in output)
@@ -534,13 +571,8 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
       // a gap (dst_i > dst_end), or a source value that shouldn't be copied
       // because it's out-of-bounds (dst_i == -1), or the end of the tensor
       // (dst_i = -1).
-      if (dst_start < dst_end) {
-        // Copy the contiguous region.
-        const VALUE_TYPE* src = values_base + src_start * value_element_size;
-        VALUE_TYPE* dst = output_base + dst_start * value_element_size;
-        INDEX_TYPE nvals = (dst_end - dst_start) * value_element_size;
-        copy_array<VALUE_TYPE, INDEX_TYPE>(dst, src, nvals);
-      }
+      add_region(src_start, dst_start, dst_end - dst_start,
+                 /*is_default=*/false);
 
       // Add any necessary padding (w/ default_value).
       if (src_i >= output_index_size) {
@@ -549,18 +581,8 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
         dst_i = output_size / value_element_size;
       }
       if (dst_i > dst_end) {
-        if (default_value_tensor.NumElements() == 1) {
-          std::fill(output_base + dst_end * value_element_size,
-                    output_base + dst_i * value_element_size, *default_value);
-          dst_end = dst_i;
-        } else {
-          while (dst_i > dst_end) {
-            VALUE_TYPE* dst = output_base + dst_end * value_element_size;
-            copy_array<VALUE_TYPE, INDEX_TYPE>(dst, default_value,
-                                               value_element_size);
-            ++dst_end;
-          }
-        }
+        add_region(0, dst_end, dst_i - dst_end, /*is_default=*/true);
+        dst_end = dst_i;
       }
 
       // Update indices.
@@ -575,6 +597,43 @@ class RaggedTensorToTensorOp : public RaggedTensorToTensorBaseOp<INDEX_TYPE> {
         dst_end = dst_start + 1;
       }
     }
+    region_rows.push_back(total_rows);
+    if (total_rows == 0) return;
+
+    const bool scalar_default = default_value_tensor.NumElements() == 1;
+    // Executes the output rows in [row_begin, row_end), which may span
+    // several regions.
+    auto execute_row_range = [&](int64_t row_begin, int64_t row_end) {
+      int64_t region_ix =
+          std::upper_bound(region_rows.begin(), region_rows.end(), row_begin) -
+          region_rows.begin() - 1;
+      int64_t row = row_begin;
+      while (row < row_end) {
+        const Region& region = regions[region_ix];
+        const INDEX_TYPE offset = row - region_rows[region_ix];
+        const INDEX_TYPE num_rows = static_cast<INDEX_TYPE>(
+            std::min<int64_t>(row_end - row, region.num_rows - offset));
+        VALUE_TYPE* dst =
+            output_base + (region.dst_start + offset) * value_element_size;
+        if (!region.is_default) {
+          copy_array<VALUE_TYPE, INDEX_TYPE>(
+              dst,
+              values_base + (region.src_start + offset) * value_element_size,
+              num_rows * value_element_size);
+        } else if (scalar_default) {
+          std::fill(dst, dst + num_rows * value_element_size, *default_value);
+        } else {
+          fill_default_rows<VALUE_TYPE, INDEX_TYPE>(
+              dst, default_value, num_rows,
+              static_cast<INDEX_TYPE>(value_element_size));
+        }
+        row += num_rows;
+        ++region_ix;
+      }
+    };
+    auto* worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    Shard(worker_threads->num_threads, worker_threads->workers, total_rows,
+          value_element_size * sizeof(VALUE_TYPE), execute_row_range);
   }
 };
 
@@ -81,6 +81,14 @@ struct FillPhiloxRandomTask;
 template <class Distribution>
 struct FillPhiloxRandomTask<Distribution, false> {
   typedef typename Distribution::ResultElementType T;
+
+  // Number of output groups generated per iteration of the unrolled loop
+  // below. Each group comes from its own generator on an interleaved counter,
+  // so the Philox rounds of the four groups form independent dependency
+  // chains that the compiler can pipeline and, where profitable, vectorize
+  // across.
+  static constexpr int kInterleavedStreams = 4;
+
   static void Run(random::PhiloxRandom gen, T* data, int64_t size,
                   int64_t start_group, int64_t limit_group, Distribution dist) {
     const int kGroupSize = Distribution::kResultElementCount;
@@ -88,9 +96,32 @@ struct FillPhiloxRandomTask<Distribution, false> {
     gen.Skip(start_group);
     int64_t offset = start_group * kGroupSize;
 
-    // First fill all the full-size groups
+    // First fill all the full-size groups. Fixed-sample distributions consume
+    // exactly one generator invocation per group (the Skip(start_group) above
+    // already depends on this), so striding each interleaved stream by
+    // kInterleavedStreams visits exactly the counters the plain loop would,
+    // and the output is bit-identical.
     int64_t limit_group_full = std::min(limit_group, size / kGroupSize);
-    for (int64_t index = start_group; index < limit_group_full; ++index) {
+    int64_t index = start_group;
+    if (limit_group_full - index >= kInterleavedStreams) {
+      random::PhiloxRandom gens[kInterleavedStreams];
+      for (int j = 0; j < kInterleavedStreams; ++j) {
+        gens[j] = gen;
+        gens[j].Skip(j);
+      }
+      for (; index + kInterleavedStreams <= limit_group_full;
+           index += kInterleavedStreams) {
+        for (int j = 0; j < kInterleavedStreams; ++j) {
+          auto samples = dist(&gens[j]);
+          std::copy(&samples[0], &samples[0] + kGroupSize,
+                    data + offset + j * kGroupSize);
+          gens[j].Skip(kInterleavedStreams - 1);
+        }
+        offset += static_cast<int64_t>(kInterleavedStreams) * kGroupSize;
+      }
+      gen.Skip(index - start_group);
+    }
+    for (; index < limit_group_full; ++index) {
       auto samples = dist(&gen);
       std::copy(&samples[0], &samples[0] + kGroupSize, data + offset);
       offset += kGroupSize;
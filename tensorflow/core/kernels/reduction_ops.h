@@ -18,6 +18,9 @@ limitations under the License.
 
 // Functor definitions for Reduction ops, must be compilable by nvcc.
 
+#include <algorithm>
+#include <vector>
+
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/framework/tensor_types.h"
@@ -48,11 +51,110 @@ struct ReducerTraits<EuclideanNormReducer<Scalar>> {
   enum { IsScalarIdentity = false };
 };
 
+// Reducers whose finalize() is the identity and whose reduce() is
+// associative, so that independently reduced chunks can be combined into the
+// same result the reducer would produce over the concatenated input.
+template <typename Reducer>
+struct ReducerIsCombinable : std::false_type {};
+template <typename Scalar>
+struct ReducerIsCombinable<Eigen::internal::SumReducer<Scalar>>
+    : std::true_type {};
+template <typename Scalar>
+struct ReducerIsCombinable<Eigen::internal::ProdReducer<Scalar>>
+    : std::true_type {};
+template <typename Scalar, int NaNPropagation>
+struct ReducerIsCombinable<Eigen::internal::MinReducer<Scalar, NaNPropagation>>
+    : std::true_type {};
+template <typename Scalar, int NaNPropagation>
+struct ReducerIsCombinable<Eigen::internal::MaxReducer<Scalar, NaNPropagation>>
+    : std::true_type {};
+template <>
+struct ReducerIsCombinable<Eigen::internal::AndReducer> : std::true_type {};
+template <>
+struct ReducerIsCombinable<Eigen::internal::OrReducer> : std::true_type {};
+
+// Columns per chunk below which the two-stage inner reduction is not
+// attempted; the per-chunk bookkeeping would outweigh the extra parallelism.
+constexpr int64_t kTwoStageReductionMinChunkCols = 1 << 15;
+
+// Fallback for devices/axes where the two-stage path does not apply.
+template <typename Device, typename OUT_T, typename IN_T,
+          typename ReductionAxes, typename Reducer>
+bool TryTwoStageInnerReduce(const Device&, OUT_T, IN_T, const ReductionAxes&,
+                            const Reducer&) {
+  return false;
+}
+
+// Two-stage inner-dimension reduction for wide matrices on CPU. Eigen's
+// inner reduction only parallelizes across the kept (row) dimension, so a
+// matrix with few rows and very many columns uses a handful of threads no
+// matter how large the pool is. Here each row is cut into column chunks that
+// are reduced independently across the pool, then the per-chunk partials are
+// combined serially in ascending chunk order, which makes the result
+// deterministic for a given shape and thread count.
+template <typename OUT_T, typename IN_T, typename Reducer>
+bool TryTwoStageInnerReduce(const Eigen::ThreadPoolDevice& d, OUT_T out,
+                            IN_T in,
+                            const Eigen::IndexList<Eigen::type2index<1>>&,
+                            const Reducer& reducer) {
+  if constexpr (static_cast<int>(IN_T::NumIndices) == 2 &&
+                ReducerIsCombinable<Reducer>::value) {
+    using Scalar = typename IN_T::Scalar;
+    const int64_t rows = in.dimension(0);
+    const int64_t cols = in.dimension(1);
+    const int64_t num_threads = d.numThreads();
+    if (num_threads <= 1 || rows == 0 || rows >= num_threads) {
+      return false;
+    }
+    const int64_t num_chunks =
+        std::min<int64_t>(num_threads, cols / kTwoStageReductionMinChunkCols);
+    if (num_chunks <= 1) {
+      return false;
+    }
+    const int64_t chunk_cols = (cols + num_chunks - 1) / num_chunks;
+    std::vector<Scalar> partials(rows * num_chunks);
+    Scalar* partials_data = partials.data();
+    auto reduce_chunks = [=, &reducer](int64_t begin, int64_t end) {
+      for (int64_t task = begin; task < end; ++task) {
+        const int64_t row = task / num_chunks;
+        const int64_t chunk = task % num_chunks;
+        const int64_t col_begin = chunk * chunk_cols;
+        const int64_t col_end = std::min(col_begin + chunk_cols, cols);
+        // Rows are contiguous in memory, so each chunk reduces as a dense
+        // rank-1 tensor, vectorized by Eigen's full reducer.
+        Eigen::TensorMap<
+            Eigen::Tensor<const Scalar, 1, Eigen::RowMajor, Eigen::DenseIndex>>
+            chunk_map(&in(row, col_begin), col_end - col_begin);
+        Eigen::Tensor<Scalar, 0, Eigen::RowMajor, Eigen::DenseIndex> partial =
+            chunk_map.reduce(Eigen::array<Eigen::DenseIndex, 1>{0}, reducer);
+        partials_data[task] = partial();
+      }
+    };
+    const Eigen::TensorOpCost cost(/*bytes_loaded=*/chunk_cols * sizeof(Scalar),
+                                   /*bytes_stored=*/sizeof(Scalar),
+                                   /*compute_cycles=*/chunk_cols);
+    d.parallelFor(rows * num_chunks, cost, std::move(reduce_chunks));
+    for (int64_t row = 0; row < rows; ++row) {
+      auto accum = reducer.initialize();
+      for (int64_t chunk = 0; chunk < num_chunks; ++chunk) {
+        reducer.reduce(partials_data[row * num_chunks + chunk], &accum);
+      }
+      out(row) = reducer.finalize(accum);
+    }
+    return true;
+  } else {
+    return false;
+  }
+}
+
 template <typename Device, typename OUT_T, typename IN_T,
           typename ReductionAxes, typename Reducer>
 struct ReduceEigenImpl {
   void operator()(const Device& d, OUT_T out, IN_T in,
                   const ReductionAxes& reduction_axes, const Reducer& reducer) {
+    if (TryTwoStageInnerReduce(d, out, in, reduction_axes, reducer)) {
+      return;
+    }
     out.device(d) = in.reduce(reduction_axes, reducer);
   }
 };
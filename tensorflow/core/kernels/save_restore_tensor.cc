@@ -15,6 +15,8 @@ limitations under the License.
 
 #include "tensorflow/core/kernels/save_restore_tensor.h"
 
+#include <algorithm>
+#include <map>
 #include <memory>
 #include <numeric>
 #include <unordered_map>
@@ -33,6 +35,7 @@ limitations under the License.
 #include "tensorflow/core/lib/strings/stringprintf.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/platform/types.h"
+#include "tensorflow/core/util/env_var.h"
 #include "tensorflow/core/util/tensor_bundle/tensor_bundle.h"
 #include "tensorflow/core/util/tensor_slice_reader.h"
 #include "tensorflow/core/util/tensor_slice_reader_cache.h"
@@ -251,6 +254,55 @@ namespace {
 // Tensors larger than this threshold will be restored from a thread-pool.
 const int64_t kLargeShapeThreshold = 16 << 20;  // 16M
 
+// Number of threads used to restore from a checkpoint when the session config
+// does not specify a restore parallelism.  Size it to the storage device: a
+// single stream rarely saturates NVMe, while spinning disks prefer fewer
+// streams.
+int64_t RestoreIOThreads() {
+  static const int64_t io_threads = []() {
+    int64_t threads;
+    TF_CHECK_OK(ReadInt64FromEnvVar("TF_RESTORE_IO_THREADS", 8, &threads));
+    return threads;
+  }();
+  return io_threads;
+}
+
+// If true, restored tensors are allocated in device-compatible (pinned) host
+// memory, so host-to-device copies of restored weights run as asynchronous
+// DMA instead of bouncing through the driver's internal staging buffer.  The
+// executor only requests such memory for tensors feeding a device send
+// directly (see SetAllocAttrsForNode in graph_view.cc); this forces it for
+// every restored tensor.  Off by default since pinning the full checkpoint
+// size is a deliberate trade against pageable host memory.
+bool RestoreUsePinnedMemory() {
+  static const bool use_pinned_memory = []() {
+    bool pinned;
+    TF_CHECK_OK(
+        ReadBoolFromEnvVar("TF_RESTORE_USE_PINNED_MEMORY", false, &pinned));
+    return pinned;
+  }();
+  return use_pinned_memory;
+}
+
+// If true, the restore plan groups tensors destined for a device (those whose
+// outputs the executor marked gpu-compatible because they feed a device send)
+// ahead of host-only tensors, and batches each group by dtype.  Device-bound
+// tensors then land in pinned memory back to back, so their host-to-device
+// copies issue as one run of same-sized DMA transfers that overlaps the
+// remaining host-only reads.  The kernel itself cannot see consumer devices
+// or fuse the copies into a single transfer; grouping is the part of that
+// plan expressible below the executor.  Off by default because it reorders
+// reads within a shard away from strict file-offset order.
+bool RestoreBatchByDtype() {
+  static const bool batch_by_dtype = []() {
+    bool batch;
+    TF_CHECK_OK(
+        ReadBoolFromEnvVar("TF_RESTORE_BATCH_BY_DTYPE", false, &batch));
+    return batch;
+  }();
+  return batch_by_dtype;
+}
+
 // A restore operation for a single tensor.  Small tensors may be restored
 // directly from the op thread to improve read locality.  Large tensors can be
 // restored from a thread pool: this requires creating a separate BundleReader
@@ -283,6 +335,14 @@ struct RestoreOp {
     return restored_full_shape.num_elements() > kLargeShapeThreshold;
   }
 
+  // Whether this tensor's output feeds a device send: the executor requests
+  // gpu-compatible memory for exactly those outputs (see SetAllocAttrsForNode
+  // in graph_view.cc), so this is the destination-device signal visible from
+  // inside the kernel.
+  bool device_bound() const {
+    return context->output_alloc_attr(idx).gpu_compatible();
+  }
+
   // Run this restore operation using a new BundleReader.
   void run_with_new_reader(BundleCache* cache) {
     BundleReader reader(tsl::Env::Default(), reader_prefix, {cache, false});
@@ -301,11 +361,19 @@ struct RestoreOp {
 
     VLOG(1) << "Restoring tensor " << idx << " : " << tensor_name << " : "
             << restored_full_shape.num_elements();
+    // Start from the executor-derived attributes so tensors feeding a device
+    // send keep their requested placement either way.
+    AllocatorAttributes alloc_attrs = context->output_alloc_attr(idx);
+    if (RestoreUsePinnedMemory()) {
+      alloc_attrs.set_on_host(true);
+      alloc_attrs.set_gpu_compatible(true);
+    }
     Tensor* restored_tensor;
     if (shape_and_slice.empty()) {
       // Lookup the full tensor.
-      TF_RETURN_IF_ERROR(
-          context->allocate_output(idx, restored_full_shape, &restored_tensor));
+      TF_RETURN_IF_ERROR(context->allocate_output(idx, restored_full_shape,
+                                                  &restored_tensor,
+                                                  alloc_attrs));
       TF_RETURN_IF_ERROR(reader->Lookup(tensor_name, restored_tensor));
     } else {
       // Lookup the slice.
@@ -324,8 +392,9 @@ struct RestoreOp {
             " does not match the shape stored in checkpoint: ",
             restored_full_shape.DebugString());
       }
-      TF_RETURN_IF_ERROR(
-          context->allocate_output(idx, parsed_slice_shape, &restored_tensor));
+      TF_RETURN_IF_ERROR(context->allocate_output(idx, parsed_slice_shape,
+                                                  &restored_tensor,
+                                                  alloc_attrs));
       TF_RETURN_IF_ERROR(
           reader->LookupSlice(tensor_name, parsed_slice, restored_tensor));
     }
@@ -417,6 +486,25 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
     }
   }
 
+  if (RestoreBatchByDtype()) {
+    // Plan device-bound tensors first, batched by dtype.  The stable sort
+    // keeps the file-offset order from SortForSequentialAccess within each
+    // (destination, dtype) group, so grouped reads still stream forward
+    // through the shard.  Large ops get the same treatment so their copies
+    // start while host-only tensors are still being read.
+    const auto by_destination_then_dtype = [](const RestoreOp* a,
+                                              const RestoreOp* b) {
+      if (a->device_bound() != b->device_bound()) {
+        return a->device_bound();
+      }
+      return a->dtype < b->dtype;
+    };
+    std::stable_sort(large_restore_ops.begin(), large_restore_ops.end(),
+                     by_destination_then_dtype);
+    std::stable_sort(small_restore_ops.begin(), small_restore_ops.end(),
+                     by_destination_then_dtype);
+  }
+
   if (context->session_config() != nullptr &&
       context->session_config()->intra_op_parallelism_threads() > 0) {
     // If an explicit restore parallelism is specified, we use it to run
@@ -442,30 +530,68 @@ Status RestoreTensorsV2(OpKernelContext* context, const Tensor& prefix,
       TF_RETURN_IF_ERROR(op.status);
     }
   } else {
-    // If no restore parallelism is specified, we run large restore ops with
-    // a modest parallelism, and small restore ops serially.
-
-    // Avoid creating a pool if there are no large restore ops.
-    std::unique_ptr<thread::ThreadPool> reader_pool;
-    if (!large_restore_ops.empty()) {
-      reader_pool.reset(
-          new thread::ThreadPool(Env::Default(), "restore_tensors", 8));
+    // If no restore parallelism is specified, we restore the shards of the
+    // bundle concurrently: large ops are scheduled individually, and each
+    // shard's small ops run as one sequential batch so its reads stay ordered
+    // by file offset within the shard.
+    std::map<int, std::vector<RestoreOp*>> small_ops_by_shard;
+    for (auto* op : small_restore_ops) {
+      int shard_id = 0;
+      // Grouping is only a scheduling hint; lookup errors are surfaced when
+      // the op runs.
+      default_reader.LookupShardId(op->tensor_name, &shard_id).IgnoreError();
+      small_ops_by_shard[shard_id].push_back(op);
+    }
+
+    // Runs one shard's small ops in order against a reader of its own, so
+    // shards stream from independent files concurrently.
+    const auto run_small_batch = [&cache](std::vector<RestoreOp*>* ops) {
+      BundleReader reader(tsl::Env::Default(), (*ops)[0]->reader_prefix,
+                          {&cache, false});
+      for (auto* op : *ops) {
+        if (!reader.status().ok()) {
+          op->status = reader.status();
+          continue;
+        }
+        // Record per-op statuses; every op must run (or fail) so the dtype
+        // validation below sees an allocated output or an error for each.
+        op->status = op->run(&reader);
+      }
+    };
+
+    const int64_t num_jobs =
+        large_restore_ops.size() + small_ops_by_shard.size();
+    if (num_jobs > 1) {
+      auto reader_pool = std::make_unique<thread::ThreadPool>(
+          Env::Default(), "restore_tensors",
+          std::min<int64_t>(std::max<int64_t>(RestoreIOThreads(), 1),
+                            num_jobs));
+      // Schedule large ops first, to prevent them from waiting on the small.
       for (auto* op : large_restore_ops) {
         reader_pool->Schedule(
             [op, &cache]() { op->run_with_new_reader(&cache); });
       }
-    }
-
-    // Read small tensors from the op thread.
-    for (auto* op : small_restore_ops) {
-      TF_RETURN_IF_ERROR(op->run(&default_reader));
-    }
+      for (auto& shard : small_ops_by_shard) {
+        auto* ops = &shard.second;
+        reader_pool->Schedule([&run_small_batch, ops]() {
+          run_small_batch(ops);
+        });
+      }
 
-    // Wait for all scheduled work to finish and check the status of all
-    // ops that ran in the pool.
-    reader_pool.reset();
-    for (auto* op : large_restore_ops) {
-      TF_RETURN_IF_ERROR(op->status);
+      // Wait for all scheduled work to finish and check the status of all
+      // ops that ran in the pool.
+      reader_pool.reset();
+      for (auto& op : restore_ops) {
+        TF_RETURN_IF_ERROR(op.status);
+      }
+    } else {
+      // A single job gains nothing from a pool; read from the op thread.
+      for (auto* op : large_restore_ops) {
+        TF_RETURN_IF_ERROR(op->run(&default_reader));
+      }
+      for (auto* op : small_restore_ops) {
+        TF_RETURN_IF_ERROR(op->run(&default_reader));
+      }
     }
   }
 
@@ -20,7 +20,9 @@ limitations under the License.
 
 #define EIGEN_USE_THREADS
 
+#include <algorithm>
 #include <atomic>
+#include <vector>
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 
@@ -102,6 +104,10 @@ class UpdateExecutor<T, Input, Update, Output, scatter_nd_op::UpdateOp::MAX> {
 
 namespace functor {
 
+// Minimum number of update elements before the parallel path is worth the
+// cost of sorting the indices.
+constexpr Eigen::DenseIndex kMinUpdateElemsForParallel = 64 << 10;
+
 // Implementation of update functor for CPU.
 template <typename T, typename Index, scatter_nd_op::UpdateOp OP, int IXDIM>
 struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
@@ -127,6 +133,10 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
           batch_strides[dim + 1] * output_shape_prefix[dim + 1];
     }
 
+    // Flatten every index up front. Out-of-bounds locations get a -1
+    // sentinel; error_loc tracks the last bad location, matching the
+    // serial loop below.
+    std::vector<Index> flat_indices(batch_size);
     for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
       Index i = 0;
       bool out_of_bounds = false;
@@ -137,18 +147,81 @@ struct ScatterNdFunctor<CPUDevice, T, Index, OP, IXDIM> {
       }
       if (TF_PREDICT_FALSE(out_of_bounds)) {
         error_loc = loc;
-        // Don't break the loop here, but continue to update the rest because
+        // Don't bail out here, but continue to update the rest because
         // the caller might ignore bad indices.
-        continue;
+        flat_indices[loc] = -1;
       } else {
-        auto input_chip = Toutput.template chip<0>(i);
-        auto output_chip = input_chip;
-        auto update_chip = Tupdates.template chip<0>(loc);
-        update_executor::UpdateExecutor<
-            CPUDevice, decltype(input_chip), decltype(update_chip),
-            decltype(output_chip), OP>::Execute(d, input_chip, update_chip,
-                                                output_chip);
+        flat_indices[loc] = i;
+      }
+    }
+
+    if (d.numThreads() > 1 &&
+        batch_size * slice_size >= kMinUpdateElemsForParallel) {
+      // Parallel path: group the updates by output row so that each row is
+      // owned by exactly one worker. Within a row the updates are applied in
+      // their original order, so the result is bit-identical to the serial
+      // path and no atomics are needed.
+      std::vector<Eigen::DenseIndex> order(batch_size);
+      for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+        order[loc] = loc;
+      }
+      std::stable_sort(order.begin(), order.end(),
+                       [&flat_indices](Eigen::DenseIndex a,
+                                       Eigen::DenseIndex b) {
+                         return flat_indices[a] < flat_indices[b];
+                       });
+      // Use a single-threaded device for the per-slice expressions so the
+      // workers don't schedule nested tasks back onto the pool.
+      const Eigen::DefaultDevice no_thread_device;
+      auto apply = [&](Eigen::DenseIndex start, Eigen::DenseIndex end) {
+        Eigen::DenseIndex pos = start;
+        // A worker only owns rows whose first update falls in its range, so
+        // skip entries that continue a row started by the previous range.
+        while (pos < end && pos > 0 &&
+               flat_indices[order[pos]] == flat_indices[order[pos - 1]]) {
+          ++pos;
+        }
+        while (pos < end) {
+          const Index i = flat_indices[order[pos]];
+          if (i < 0) {
+            // Out-of-bounds locations sort first; skip the whole group.
+            while (pos < batch_size && flat_indices[order[pos]] < 0) {
+              ++pos;
+            }
+            continue;
+          }
+          // Process the row to completion, even past the end of the range.
+          while (pos < batch_size && flat_indices[order[pos]] == i) {
+            auto input_chip = Toutput.template chip<0>(i);
+            auto output_chip = input_chip;
+            auto update_chip = Tupdates.template chip<0>(order[pos]);
+            update_executor::UpdateExecutor<
+                Eigen::DefaultDevice, decltype(input_chip),
+                decltype(update_chip), decltype(output_chip),
+                OP>::Execute(no_thread_device, input_chip, update_chip,
+                             output_chip);
+            ++pos;
+          }
+        }
+      };
+      const Eigen::TensorOpCost cost(slice_size * sizeof(T),
+                                     slice_size * sizeof(T), slice_size);
+      d.parallelFor(batch_size, cost, apply);
+      return error_loc;
+    }
+
+    for (Eigen::DenseIndex loc = 0; loc < batch_size; ++loc) {
+      const Index i = flat_indices[loc];
+      if (TF_PREDICT_FALSE(i < 0)) {
+        continue;
       }
+      auto input_chip = Toutput.template chip<0>(i);
+      auto output_chip = input_chip;
+      auto update_chip = Tupdates.template chip<0>(loc);
+      update_executor::UpdateExecutor<
+          CPUDevice, decltype(input_chip), decltype(update_chip),
+          decltype(output_chip), OP>::Execute(d, input_chip, update_chip,
+                                              output_chip);
     }
 
     return error_loc;
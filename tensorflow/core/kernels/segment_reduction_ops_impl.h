@@ -53,6 +53,7 @@ limitations under the License.
 #include "tensorflow/core/platform/logging.h"
 #include "tensorflow/core/util/determinism.h"
 #include "tensorflow/core/util/util.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 #include "tensorflow/core/common_runtime/gpu/gpu_event_mgr.h"
@@ -138,6 +139,90 @@ class SegmentReductionOp : public OpKernel {
     auto output_flat = output->flat_outer_dims<T>();
 
     Eigen::IndexList<Eigen::type2index<0> > dims_to_reduce;
+
+    // Parallel fast path: shard the input rows across the intra-op pool. Each
+    // worker first advances its range start past rows that continue a segment
+    // begun in the previous range, then reduces whole segments to completion
+    // (running past its range end if necessary). Every output row therefore
+    // has exactly one writer, no synchronization is needed, and the result is
+    // identical to the serial loop below. The segment ids are validated up
+    // front because OP_REQUIRES cannot fire from inside the workers; given
+    // sorted non-negative ids, every id is within [0, output_rows) by
+    // construction of output_rows.
+    const Eigen::ThreadPoolDevice& cpu_device = context->eigen_cpu_device();
+    constexpr int64_t kMinElemsForParallelSegmentReduction = 64 << 10;
+    if (cpu_device.numThreads() > 1 &&
+        num_indices * num_col >= kMinElemsForParallelSegmentReduction) {
+      OP_REQUIRES(context, internal::SubtleMustCopy(segment_vec(0)) >= 0,
+                  errors::InvalidArgument("segment ids must be >= 0"));
+      bool sorted = true;
+      for (int64_t i = 1; i < num_indices; ++i) {
+        if (segment_vec(i) < segment_vec(i - 1)) {
+          sorted = false;
+          break;
+        }
+      }
+      OP_REQUIRES(context, sorted,
+                  errors::InvalidArgument("segment ids are not increasing"));
+
+      Eigen::DSizes<Eigen::DenseIndex, 1> slice_shape(num_col);
+      auto reduce_segments = [&](int64_t range_begin, int64_t range_end) {
+        int64_t pos = range_begin;
+        // Rows continuing a segment begun in the previous range belong to the
+        // worker that owns that range.
+        while (pos < range_end && pos > 0 &&
+               segment_vec(pos) == segment_vec(pos - 1)) {
+          ++pos;
+        }
+        if (pos >= range_end) return;
+        Index uninitialized_row =
+            pos == 0 ? 0 : internal::SubtleMustCopy(segment_vec(pos - 1)) + 1;
+        while (pos < range_end) {
+          const Index id = internal::SubtleMustCopy(segment_vec(pos));
+          int64_t seg_end = pos + 1;
+          while (seg_end < num_indices && segment_vec(seg_end) == id) {
+            ++seg_end;
+          }
+          // Output rows with no input rows get the default value. The gap
+          // preceding this segment is only reachable from this worker, so the
+          // fill is race-free as well.
+          if (id > uninitialized_row) {
+            Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
+                id - uninitialized_row, num_col);
+            Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>,
+                             Eigen::Unaligned>
+                gap_slice(&output_flat(uninitialized_row, 0), gap_slice_shape);
+            gap_slice.setConstant(T(default_value));
+          }
+          Eigen::TensorMap<Eigen::Tensor<T, 1, Eigen::RowMajor>,
+                           Eigen::Unaligned>
+              out_slice(&output_flat(id, 0), slice_shape);
+          const T* in_slice_ptr = &input_flat(pos, 0);
+          if (seg_end - pos == 1) {
+            Eigen::TensorMap<Eigen::Tensor<const T, 1, Eigen::RowMajor>,
+                             Eigen::Unaligned>
+                in_slice(in_slice_ptr, slice_shape);
+            out_slice = in_slice;
+          } else {
+            Eigen::DSizes<Eigen::DenseIndex, 2> in_slice_shape(seg_end - pos,
+                                                               num_col);
+            Eigen::TensorMap<Eigen::Tensor<const T, 2, Eigen::RowMajor>,
+                             Eigen::Unaligned>
+                in_slice(in_slice_ptr, in_slice_shape);
+            out_slice = in_slice.reduce(dims_to_reduce, Reducer());
+          }
+          uninitialized_row = id + 1;
+          pos = seg_end;
+        }
+      };
+      const Eigen::TensorOpCost cost(
+          /*bytes_loaded=*/num_col * sizeof(T),
+          /*bytes_stored=*/num_col * sizeof(T),
+          /*compute_cycles=*/num_col);
+      cpu_device.parallelFor(num_indices, cost, reduce_segments);
+      return;
+    }
+
     Index start = 0, end = 1;
 
     Index uninitialized_index = 0;  // Index from which the output is not set.
@@ -618,20 +703,117 @@ class SparseSegmentReductionOpBase : public OpKernel {
                 errors::InvalidArgument("segment ids must be >= 0"));
     auto output_flat = output->flat_outer_dims<T>();
 
+    // Partition the indices into runs that start and end on segment
+    // boundaries. segment_ids values are required to be sorted, so each run
+    // reduces into a disjoint range of output rows and the runs can be
+    // processed in parallel.
+    auto worker_threads = context->device()->tensorflow_cpu_worker_threads();
+    // Minimum amount of reduction work to hand to a single worker.
+    constexpr int64_t kMinShardElements = int64_t{1} << 14;
+    int64_t num_shards = 1;
+    if (worker_threads->num_threads > 1) {
+      num_shards = std::max<int64_t>(
+          1, std::min<int64_t>(
+                 std::min<int64_t>(worker_threads->num_threads, num_indices),
+                 num_indices * num_col / kMinShardElements));
+    }
+    std::vector<int64_t> shard_bounds;
+    shard_bounds.reserve(num_shards + 1);
+    shard_bounds.push_back(0);
+    for (int64_t shard = 1; shard < num_shards; ++shard) {
+      int64_t pos = std::max<int64_t>(shard * num_indices / num_shards,
+                                      shard_bounds.back() + 1);
+      // Move the boundary forward to the start of the next segment so that no
+      // segment straddles two shards.
+      while (pos < num_indices && segment_vec(pos) == segment_vec(pos - 1)) {
+        ++pos;
+      }
+      if (pos >= num_indices) break;
+      shard_bounds.push_back(pos);
+    }
+    shard_bounds.push_back(num_indices);
+    num_shards = static_cast<int64_t>(shard_bounds.size()) - 1;
+
+    // Each shard only verifies that its own segment ids are increasing, so a
+    // decrease right at a shard boundary must be caught here.
+    for (int64_t shard = 1; shard < num_shards; ++shard) {
+      const int64_t pos = shard_bounds[shard];
+      OP_REQUIRES(context,
+                  internal::SubtleMustCopy(segment_vec(pos - 1)) <
+                      internal::SubtleMustCopy(segment_vec(pos)),
+                  errors::InvalidArgument("segment ids are not increasing"));
+    }
+
     // If we use DT_BFLOAT16 or DT_HALF, we need to use DT_FLOAT for
     // accumulation. We create a temp tensor to perform this accumulation for
-    // every segment.
+    // every segment, one row per shard.
     Tensor temp;
     if (input.dtype() == DT_BFLOAT16 || input.dtype() == DT_HALF) {
       TensorShape temp_shape = output_shape;
-      OP_REQUIRES_OK(context, temp_shape.SetDimWithStatus(/*d=*/0, /*size=*/1));
+      OP_REQUIRES_OK(context,
+                     temp_shape.SetDimWithStatus(/*d=*/0, /*size=*/num_shards));
       temp = tensorflow::Tensor(DT_FLOAT, temp_shape);
     }
     auto temp_flat = temp.flat_outer_dims<float>();
 
-    int64_t start = 0, end = 1;
+    if (num_shards == 1) {
+      OP_REQUIRES_OK(
+          context,
+          ReduceShard(input_flat, indices_vec, segment_vec, output_flat,
+                      temp_flat, /*temp_row=*/0, /*start_idx=*/0,
+                      /*end_idx=*/num_indices, /*first_uninitialized_row=*/0,
+                      /*row_limit=*/output_rows, output_rows));
+      return;
+    }
+
+    std::vector<absl::Status> statuses(num_shards);
+    Shard(worker_threads->num_threads, worker_threads->workers, num_shards,
+          /*cost_per_unit=*/num_indices * num_col / num_shards,
+          [&](int64_t shard_begin, int64_t shard_end) {
+            for (int64_t shard = shard_begin; shard < shard_end; ++shard) {
+              const int64_t start_idx = shard_bounds[shard];
+              const int64_t end_idx = shard_bounds[shard + 1];
+              // Rows before a shard's first segment are filled by the
+              // previous shard, whose row range extends up to that segment.
+              const SegmentId first_uninitialized_row =
+                  shard == 0
+                      ? 0
+                      : internal::SubtleMustCopy(segment_vec(start_idx));
+              const SegmentId row_limit =
+                  shard + 1 == num_shards
+                      ? static_cast<SegmentId>(output_rows)
+                      : internal::SubtleMustCopy(segment_vec(end_idx));
+              statuses[shard] = ReduceShard(
+                  input_flat, indices_vec, segment_vec, output_flat, temp_flat,
+                  /*temp_row=*/shard, start_idx, end_idx,
+                  first_uninitialized_row, row_limit, output_rows);
+            }
+          });
+    for (const absl::Status& status : statuses) {
+      OP_REQUIRES_OK(context, status);
+    }
+  }
+
+ private:
+  const DataType dtidx_;
+
+  // Reduces the run of indices [start_idx, end_idx), which must begin and end
+  // on segment boundaries, and fills rows in [first_uninitialized_row,
+  // row_limit) that have no indices with the default value. Runs handed to
+  // different workers cover disjoint output rows, so they may execute
+  // concurrently.
+  absl::Status ReduceShard(typename TTypes<T>::ConstMatrix input_flat,
+                           typename TTypes<Index>::ConstVec indices_vec,
+                           typename TTypes<SegmentId>::ConstVec segment_vec,
+                           typename TTypes<T>::Matrix output_flat,
+                           typename TTypes<float>::Matrix temp_flat,
+                           int64_t temp_row, int64_t start_idx, int64_t end_idx,
+                           SegmentId first_uninitialized_row,
+                           SegmentId row_limit, Index output_rows) {
+    const int64_t num_col = input_flat.dimension(1);
+    int64_t start = start_idx, end = start_idx + 1;
     // Index from which the output is not initialized.
-    SegmentId uninitialized_index = 0;
+    SegmentId uninitialized_index = first_uninitialized_row;
     SegmentId out_index = internal::SubtleMustCopy(segment_vec(start));
 
     while (true) {
@@ -639,22 +821,28 @@ class SparseSegmentReductionOpBase : public OpKernel {
       // used uninitialized in this function" in the Mac build (since the
       // compiler isn't smart enough to realize the code is safe).
       SegmentId next_index = 0;
-      if (end < num_indices) {
+      if (end < end_idx) {
         next_index = internal::SubtleMustCopy(segment_vec(end));
         if (out_index == next_index) {
           ++end;
           continue;
         }
         // We have a new segment here.  Verify that the segment ids are growing.
-        OP_REQUIRES(context, out_index < next_index,
-                    errors::InvalidArgument("segment ids are not increasing"));
+        if (out_index >= next_index) {
+          return errors::InvalidArgument("segment ids are not increasing");
+        }
       }
 
-      OP_REQUIRES(
-          context, FastBoundsCheck(out_index, output_rows),
-          errors::InvalidArgument(
-              "Segment id ", out_index, " out of range [0, ", output_rows,
-              "), possibly because 'segment_ids' input is not sorted."));
+      if (!FastBoundsCheck(out_index, output_rows)) {
+        return errors::InvalidArgument(
+            "Segment id ", out_index, " out of range [0, ", output_rows,
+            "), possibly because 'segment_ids' input is not sorted.");
+      }
+      // An id at or beyond the next run's first id implies a decrease later
+      // on; returning here keeps concurrent runs from writing the same rows.
+      if (out_index >= row_limit) {
+        return errors::InvalidArgument("segment ids are not increasing");
+      }
 
       // If there is a gap between two indices, we need to set that gap to the
       // default value.
@@ -667,35 +855,34 @@ class SparseSegmentReductionOpBase : public OpKernel {
       }
 
       auto out = output_flat.template chip<0>(out_index);
-      auto temp = temp_flat.template chip<0>(0);
+      auto temp = temp_flat.template chip<0>(temp_row);
       const int bad_offset = Reduce<T, Index>(input_flat, indices_vec, start,
                                               end - start, out, temp);
-      OP_REQUIRES(context, bad_offset < 0,
-                  errors::InvalidArgument(
-                      "Bad: indices[", start + bad_offset,
-                      "] == ", indices_vec(start + bad_offset),
-                      " out of range [0, ", input_flat.dimension(0), ")"));
+      if (bad_offset >= 0) {
+        return errors::InvalidArgument(
+            "Bad: indices[", start + bad_offset,
+            "] == ", indices_vec(start + bad_offset), " out of range [0, ",
+            input_flat.dimension(0), ")");
+      }
 
       start = end;
       ++end;
       uninitialized_index = out_index + 1;
       out_index = next_index;
-      if (end > num_indices) break;
+      if (end > end_idx) break;
     }
 
     // Fill the gap at the end with the default value.
-    if (uninitialized_index < output_rows) {
+    if (uninitialized_index < row_limit) {
       Eigen::DSizes<Eigen::DenseIndex, 2> gap_slice_shape(
-          output_rows - uninitialized_index, num_col);
+          row_limit - uninitialized_index, num_col);
       Eigen::TensorMap<Eigen::Tensor<T, 2, Eigen::RowMajor>, Eigen::Unaligned>
           gap_slice(&output_flat(uninitialized_index, 0), gap_slice_shape);
       gap_slice.setConstant(default_value_);
     }
+    return absl::OkStatus();
   }
 
- private:
-  const DataType dtidx_;
-
   template <typename Tin>
   using EnableIfBfloat16OrHalf =
       typename std::enable_if<std::is_same<Tin, bfloat16>::value ||
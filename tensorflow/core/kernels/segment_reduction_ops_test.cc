@@ -181,6 +181,55 @@ BM_Reduce_Arg(64, 32, 2);
 BM_Reduce_Arg(4096, 32, 2);
 BM_Reduce_Arg(4096, 128, 2);
 
+template <typename Index>
+static void BM_SparseSegmentReduction(::testing::benchmark::State& state,
+                                      const string& reduction, Index num_rows,
+                                      Index num_cols, Index segment_size) {
+  Graph* g = new Graph(OpRegistry::Global());
+
+  Tensor input(DT_FLOAT, TensorShape({num_rows, num_cols}));
+  input.flat<float>().setRandom();
+
+  const Index num_indices = num_rows;
+  Tensor indices(DataTypeToEnum<Index>::v(), TensorShape({num_indices}));
+  test::FillFn<Index>(&indices, [&num_rows](int i) -> Index {
+    return (i * 31) % num_rows;
+  });
+  Tensor segments(DT_INT32, TensorShape({num_indices}));
+  test::FillFn<int32>(&segments, [&segment_size](int i) -> int32 {
+    return i / segment_size;
+  });
+
+  Node* node;
+  TF_CHECK_OK(NodeBuilder(g->NewName("n"), reduction)
+                  .Input(test::graph::Constant(g, input))
+                  .Input(test::graph::Constant(g, indices))
+                  .Input(test::graph::Constant(g, segments))
+                  .Attr("T", DT_FLOAT)
+                  .Finalize(g, &node));
+
+  test::Benchmark("cpu", g, /*old_benchmark_api=*/false).Run(state);
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations()) *
+                          num_indices * num_cols * sizeof(float));
+}
+
+#define BM_SparseReduce(O, R, C, S)                       \
+  static void BM_SparseReduce_##O##_##R##_##C##_##S(      \
+      ::testing::benchmark::State& state) {               \
+    BM_SparseSegmentReduction<int32>(state, #O, R, C, S); \
+  }                                                       \
+  BENCHMARK(BM_SparseReduce_##O##_##R##_##C##_##S);
+
+#define BM_SparseReduce_Arg(R, C, S)          \
+  BM_SparseReduce(SparseSegmentSum, R, C, S); \
+  BM_SparseReduce(SparseSegmentMean, R, C, S);
+
+// Small enough to stay on the serial path.
+BM_SparseReduce_Arg(4096, 32, 2);
+// Large enough to be partitioned by segment across workers.
+BM_SparseReduce_Arg(65536, 128, 8);
+BM_SparseReduce_Arg(262144, 128, 128);
+
 template <DataType T>
 static void SparseSegmentMeanGradHelper(::testing::benchmark::State& state,
                                         float uniqueness, int size) {
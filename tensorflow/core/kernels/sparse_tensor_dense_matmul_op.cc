@@ -25,6 +25,8 @@ limitations under the License.
 #include "tensorflow/core/framework/op_kernel.h"
 #include "tensorflow/core/kernels/fill_functor.h"
 #include "tensorflow/core/platform/bfloat16.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tensorflow/core/util/work_sharder.h"
 
 namespace tensorflow {
 
@@ -253,11 +255,13 @@ Status MOutOfBoundsError(int64_t m, std::size_t i, int lhs_index_a,
 
 template <typename T, typename Tsum, typename Tindices, bool ADJ_A, bool ADJ_B>
 Status SparseTensorDenseMatMulImpl(
-    typename TTypes<Tsum>::Matrix out,
+    OpKernelContext* ctx, typename TTypes<Tsum>::Matrix out,
     typename TTypes<Tindices>::ConstMatrix a_indices,
     typename TTypes<T>::ConstVec a_values, typename TTypes<T>::ConstMatrix b) {
   // Vectorize certain operations above this size.
   static constexpr std::size_t kNumVectorize = 32;
+  // Run the nnz loop in parallel above this many nonzeros.
+  static constexpr std::size_t kMinNnzParallel = 16384;
 
   const std::size_t nnz = a_values.size();
   const std::size_t rhs_right = (ADJ_B ? b.dimension(0) : b.dimension(1));
@@ -265,9 +269,79 @@ Status SparseTensorDenseMatMulImpl(
   const int lhs_index_a = ADJ_A ? 1 : 0;
   const int rhs_index_a = ADJ_A ? 0 : 1;
 
-  // TODO(ebrevdo): After many failed experiments, can't find a multi-threaded
-  // approach that achieves the performance of the single threaded
-  // one.  Perhaps Eigen threadpool implementation is just too slow?
+  // Runs the nnz loop in parallel over blocks of output rows. Requires the
+  // output-row index column of a_indices to be non-decreasing (true for
+  // canonically ordered SparseTensors when ADJ_A is false): ranges are then
+  // advanced to output-row group boundaries so that each worker owns a
+  // disjoint set of output rows and accumulates them in index order, which
+  // keeps results identical to the sequential loop.
+  auto parallel_loop_nnz = [&](auto& b_passed) -> Status {
+    const int b_chip_index = ADJ_B ? 1 : 0;
+    mutex mu;
+    int64_t first_bad_i = -1;
+    Status bad_status;
+    auto record_error = [&](int64_t i, Status s) {
+      mutex_lock l(mu);
+      if (first_bad_i < 0 || i < first_bad_i) {
+        first_bad_i = i;
+        bad_status = std::move(s);
+      }
+    };
+    auto work = [&](int64_t start, int64_t limit) {
+      std::size_t i = start;
+      // Skip nonzeros belonging to an output row started in the previous
+      // range; the worker owning the row's first nonzero processes them.
+      while (i < static_cast<std::size_t>(limit) && i > 0 &&
+             a_indices(i, lhs_index_a) == a_indices(i - 1, lhs_index_a)) {
+        ++i;
+      }
+      while (i < static_cast<std::size_t>(limit)) {
+        const Tindices m = internal::SubtleMustCopy(a_indices(i, lhs_index_a));
+        // Process the whole output row, even past the end of the range.
+        while (i < nnz && a_indices(i, lhs_index_a) == m) {
+          const Tindices k =
+              internal::SubtleMustCopy(a_indices(i, rhs_index_a));
+          if (!FastBoundsCheck(k, lhs_right)) {
+            record_error(i, KOutOfBoundsError(k, i, rhs_index_a, lhs_right));
+            return;
+          }
+          if (!FastBoundsCheck(m, out.dimension(0))) {
+            record_error(i, MOutOfBoundsError(m, i, lhs_index_a,
+                                              out.dimension(0)));
+            return;
+          }
+          const T a_value = (ADJ_A) ? MaybeConj(a_values(i)) : a_values(i);
+          out.template chip<0>(m) +=
+              b_passed.template chip<b_chip_index>(k).template cast<Tsum>() *
+              static_cast<Tsum>(a_value);
+          ++i;
+        }
+      }
+    };
+    auto worker_threads = *(ctx->device()->tensorflow_cpu_worker_threads());
+    const int64_t cost_per_nnz =
+        rhs_right * (Eigen::TensorOpCost::AddCost<Tsum>() +
+                     Eigen::TensorOpCost::MulCost<Tsum>());
+    Shard(worker_threads.num_threads, worker_threads.workers, nnz,
+          cost_per_nnz, work);
+    return bad_status;
+  };
+
+  // The parallel path needs the output-row indices sorted; verify with a
+  // linear scan, which is cheap next to the multiply itself.
+  auto rows_sorted = [&]() {
+    for (std::size_t i = 1; i < nnz; ++i) {
+      if (a_indices(i, lhs_index_a) < a_indices(i - 1, lhs_index_a)) {
+        return false;
+      }
+    }
+    return true;
+  };
+
+  const bool use_parallel =
+      nnz >= kMinNnzParallel && rhs_right >= kNumVectorize &&
+      ctx->device()->tensorflow_cpu_worker_threads()->num_threads > 1 &&
+      rows_sorted();
 
   if (rhs_right < kNumVectorize) {
     // Disable vectorization if the RHS of output is too small
@@ -314,8 +388,14 @@ Status SparseTensorDenseMatMulImpl(
       Eigen::array<int, 2> shuffle{1, 0};  // preserve dimension order
       Eigen::Tensor<T, 2, Eigen::ColMajor> col_major_conj_b =
           b.swap_layout().shuffle(shuffle).conjugate();
+      if (use_parallel) {
+        return parallel_loop_nnz(col_major_conj_b);
+      }
       LOOP_NNZ(col_major_conj_b);
     } else {
+      if (use_parallel) {
+        return parallel_loop_nnz(b);
+      }
       LOOP_NNZ(b);
     }
 #undef LOOP_NNZ
@@ -340,7 +420,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
       temp_out.setZero();
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              temp_out, a_indices, a_values, b));
+              ctx, temp_out, a_indices, a_values, b));
       out = temp_out.template cast<T>();
     } else {
       out.setZero();
@@ -350,7 +430,7 @@ struct SparseTensorDenseMatMulFunctor<CPUDevice, T, Tindices, ADJ_A, ADJ_B> {
           *reinterpret_cast<typename TTypes<Tsum>::Matrix*>(&out);
       TF_RETURN_IF_ERROR(
           SparseTensorDenseMatMulImpl<T, Tsum, Tindices, ADJ_A, ADJ_B>(
-              out_workaround, a_indices, a_values, b));
+              ctx, out_workaround, a_indices, a_values, b));
     }
     return OkStatus();
   }
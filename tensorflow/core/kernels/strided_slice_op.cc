@@ -45,6 +45,7 @@ limitations under the License.
 #include "tensorflow/core/kernels/variable_ops.h"
 #include "tensorflow/core/lib/core/refcount.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/gtl/array_slice.h"
 #include "tensorflow/core/platform/errors.h"
 #include "tensorflow/core/platform/status.h"
@@ -53,23 +54,38 @@ limitations under the License.
 namespace tensorflow {
 namespace {
 
+// Row ranges copied below this many bytes in total are not worth dispatching
+// to the pool.
+constexpr int64_t kMinBytesForParallelSliceCopy = 64 << 10;
+
 template <typename T>
 struct MemCpyFunctor {
   // Returns true if the copy was made with memcpy, false otherwise.
-  bool Copy(const Tensor& input, const gtl::InlinedVector<int64_t, 4>& begin,
+  bool Copy(OpKernelContext* context, const Tensor& input,
+            const gtl::InlinedVector<int64_t, 4>& begin,
             const gtl::InlinedVector<int64_t, 4>& end, Tensor* result) {
     if (DataTypeCanUseMemcpy(DataTypeToEnum<T>::v())) {
       auto in = input.tensor<T, 2>();
       auto output = result->tensor<T, 2>();
-      // TODO(agarwal): Consider multi-threading if size[0] is large
-      for (int row_in = begin[0], row_out = 0; row_in < end[0];
-           ++row_in, ++row_out) {
-        if (row_in + 1 < end[0]) {
-          absl::PrefetchToLocalCache(&output(row_in + 1, 0));
-          absl::PrefetchToLocalCache(&in(row_in + 1, begin[1]));
+      const int64_t num_rows = end[0] - begin[0];
+      const int64_t row_bytes = (end[1] - begin[1]) * sizeof(T);
+      auto copy_rows = [&](int64_t start_row, int64_t limit_row) {
+        for (int64_t row_out = start_row; row_out < limit_row; ++row_out) {
+          const int64_t row_in = begin[0] + row_out;
+          if (row_out + 1 < limit_row) {
+            absl::PrefetchToLocalCache(&output(row_out + 1, 0));
+            absl::PrefetchToLocalCache(&in(row_in + 1, begin[1]));
+          }
+          memcpy(&output(row_out, 0), &in(row_in, begin[1]), row_bytes);
         }
-        memcpy(&output(row_out, 0), &in(row_in, begin[1]),
-               (end[1] - begin[1]) * sizeof(T));
+      };
+      thread::ThreadPool* workers =
+          context->device()->tensorflow_cpu_worker_threads()->workers;
+      if (workers->NumThreads() > 0 &&
+          num_rows * row_bytes >= kMinBytesForParallelSliceCopy) {
+        workers->ParallelFor(num_rows, row_bytes, copy_rows);
+      } else {
+        copy_rows(0, num_rows);
       }
       return true;
     }
@@ -79,7 +95,8 @@ struct MemCpyFunctor {
 
 template <>
 struct MemCpyFunctor<ResourceHandle> {
-  bool Copy(const Tensor& input, const gtl::InlinedVector<int64_t, 4>& begin,
+  bool Copy(OpKernelContext* context, const Tensor& input,
+            const gtl::InlinedVector<int64_t, 4>& begin,
             const gtl::InlinedVector<int64_t, 4>& end, Tensor* result) {
     return false;
   }
@@ -159,7 +176,7 @@ class StridedSliceOp : public OpKernel {
           input_dims == 2 && processing_shape.dims() == 2 &&
           final_shape.dims() == 2 && new_axis_mask == 0) {
         MemCpyFunctor<T> functor;
-        if (functor.Copy(input, begin, end, result)) {
+        if (functor.Copy(context, input, begin, end, result)) {
           return;
         }
       }
@@ -15,6 +15,7 @@ limitations under the License.
 
 // See docs in ../ops/string_ops.cc.
 
+#include <cstring>
 #include <string>
 
 #include "tensorflow/core/framework/kernel_def_builder.h"
@@ -64,10 +65,28 @@ class StringJoinOp : public OpKernel {
 
     std::vector<StringPiece> strings(input_list.size());
     for (size_t i = 0; i < input_shape.num_elements(); ++i) {
+      size_t total_size =
+          input_list.size() > 0 ? separator_.size() * (input_list.size() - 1)
+                                : 0;
       for (int j = 0; j < input_list.size(); ++j) {
         strings[j] = (is_scalar[j]) ? inputs[j](0) : inputs[j](i);
+        total_size += strings[j].size();
+      }
+      // Join directly into the output element; joining through an
+      // intermediate std::string would copy every output byte a second time.
+      tstring& out = output_flat(i);
+      out.resize_uninitialized(total_size);
+      char* dst = out.mdata();
+      for (int j = 0; j < input_list.size(); ++j) {
+        if (j > 0 && !separator_.empty()) {
+          memcpy(dst, separator_.data(), separator_.size());
+          dst += separator_.size();
+        }
+        if (!strings[j].empty()) {
+          memcpy(dst, strings[j].data(), strings[j].size());
+          dst += strings[j].size();
+        }
       }
-      output_flat(i) = absl::StrJoin(strings, separator_);
     }
   }
 
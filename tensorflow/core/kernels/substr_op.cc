@@ -65,12 +65,18 @@ class SubstrOp : public OpKernel {
 
       // Reshape input
       auto input = input_tensor.flat<tstring>();
-      // Allocate output
+      // Allocate output, reusing the input buffer when it is uniquely owned.
       Tensor* output_tensor = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output("output", input_tensor.shape(),
-                                              &output_tensor));
+      OP_REQUIRES_OK(context, context->forward_input_or_allocate_output(
+                                  {0}, "output", input_tensor.shape(),
+                                  &output_tensor));
       auto output = output_tensor->flat<tstring>();
+      // With a forwarded buffer each substring is taken in place: dropping
+      // the prefix and truncating only move bytes within the element's
+      // existing allocation, instead of copying into a fresh one.  This
+      // collapses chains of string transforms over a large batch into index
+      // manipulation on one buffer.
+      const bool in_place = output_tensor->SharesBufferWith(input_tensor);
       if (is_scalar) {
         // Perform Op with scalar pos/len
         const T pos =
@@ -96,7 +102,12 @@ class SubstrOp : public OpKernel {
                                           "string b'", in, "' at index ", i));
           }
           StringPiece sub_in = in.substr(byte_pos, byte_len);
-          output(i).assign(sub_in.data(), sub_in.size());
+          if (in_place) {
+            output(i).erase(0, byte_pos);
+            output(i).resize(sub_in.size());
+          } else {
+            output(i).assign(sub_in.data(), sub_in.size());
+          }
         }
       } else {
         // Perform Op element-wise with tensor pos/len
@@ -123,7 +134,12 @@ class SubstrOp : public OpKernel {
                                           "string b'", in, "' at index ", i));
           }
           StringPiece sub_in = in.substr(byte_pos, byte_len);
-          output(i).assign(sub_in.data(), sub_in.size());
+          if (in_place) {
+            output(i).erase(0, byte_pos);
+            output(i).resize(sub_in.size());
+          } else {
+            output(i).assign(sub_in.data(), sub_in.size());
+          }
         }
       }
     } else {
@@ -248,6 +248,110 @@ struct TopKFunctor<CPUDevice, T, Tidx> {
                                    ? kint64max
                                    : static_cast<int64_t>(total_cost);
     auto worker_threads = *(context->device()->tensorflow_cpu_worker_threads());
+
+    // When there are fewer rows than threads and the rows are very wide,
+    // sharding over rows leaves most of the pool idle. Select within each
+    // row in parallel instead: every worker heap-selects the top k of one
+    // column shard, then a per-row merge of the shard candidates extracts
+    // the final top k. The true top k of a row is always contained in the
+    // union of the shards' top k, and both phases break ties by smaller
+    // index, so the result is identical to the sequential path.
+    constexpr int64_t kMinShardCols = 1 << 16;
+    const int64_t num_shards = std::min<int64_t>(
+        (worker_threads.num_threads + num_rows - 1) / num_rows,
+        num_cols / kMinShardCols);
+    if (k != num_cols && num_shards > 1 &&
+        num_rows < worker_threads.num_threads &&
+        static_cast<int64_t>(k) * num_shards <= num_cols / 2) {
+      const int64_t shard_cols = (num_cols + num_shards - 1) / num_shards;
+      std::vector<Tidx> candidates(num_rows * num_shards * k);
+      std::vector<int64_t> candidate_counts(num_rows * num_shards);
+      auto select_shard = [&](int64_t start_task, int64_t limit_task) {
+        for (int64_t task = start_task; task < limit_task; ++task) {
+          const int64_t b = task / num_shards;
+          const int64_t shard = task % num_shards;
+          const T* input_data = &input(b, 0);
+          const auto stable_comp = [input_data](const Tidx a, const Tidx b) {
+            if (input_data[b] < input_data[a]) {
+              return true;
+            } else if (input_data[b] > input_data[a]) {
+              return false;
+            } else {
+              return a < b;
+            }
+          };
+          const Tidx col_begin = static_cast<Tidx>(shard * shard_cols);
+          const Tidx col_end = static_cast<Tidx>(
+              std::min<int64_t>(shard * shard_cols + shard_cols, num_cols));
+          gtl::TopN<Tidx, decltype(stable_comp)> filter(k, stable_comp);
+          filter.reserve(col_end - col_begin);
+          for (Tidx c = col_begin; c < col_end; ++c) {
+            filter.push(c);
+          }
+          int64_t num_candidates = 0;
+          Tidx* shard_candidates = &candidates[task * k];
+          for (auto it = filter.unsorted_begin(); it != filter.unsorted_end();
+               ++it) {
+            shard_candidates[num_candidates++] = *it;
+          }
+          candidate_counts[task] = num_candidates;
+        }
+      };
+      const double select_cost =
+          cmp_cost * static_cast<double>(shard_cols) *
+              Eigen::numext::log2(static_cast<float>(k + 1)) * 4 +
+          copy_cost;
+      Shard(worker_threads.num_threads, worker_threads.workers,
+            num_rows * num_shards,
+            (select_cost >= static_cast<double>(kint64max))
+                ? kint64max
+                : static_cast<int64_t>(select_cost),
+            select_shard);
+
+      auto merge_row = [&](int64_t start_batch, int64_t limit_batch) {
+        for (int64_t b = start_batch; b < limit_batch; ++b) {
+          const T* input_data = &input(b, 0);
+          const auto stable_comp = [input_data](const Tidx a, const Tidx b) {
+            if (input_data[b] < input_data[a]) {
+              return true;
+            } else if (input_data[b] > input_data[a]) {
+              return false;
+            } else {
+              return a < b;
+            }
+          };
+          // Compact this row's candidates; the final (shorter) shard may
+          // have produced fewer than k of them.
+          Tidx* row_begin = &candidates[b * num_shards * k];
+          Tidx* row_end = row_begin;
+          for (int64_t shard = 0; shard < num_shards; ++shard) {
+            const int64_t task = b * num_shards + shard;
+            const Tidx* shard_candidates = &candidates[task * k];
+            const int64_t num_candidates = candidate_counts[task];
+            if (row_end != shard_candidates) {
+              std::copy(shard_candidates, shard_candidates + num_candidates,
+                        row_end);
+            }
+            row_end += num_candidates;
+          }
+          std::partial_sort(row_begin, row_begin + k, row_end, stable_comp);
+          std::copy(row_begin, row_begin + k, &indices(b, 0));
+          std::transform(&indices(b, 0), &indices(b, k), &values(b, 0),
+                         [b, &input](const Tidx loc) { return input(b, loc); });
+        }
+      };
+      const double merge_cost =
+          cmp_cost * static_cast<double>(num_shards * k) *
+              Eigen::numext::log2(static_cast<float>(k + 1)) +
+          copy_cost;
+      Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
+            (merge_cost >= static_cast<double>(kint64max))
+                ? kint64max
+                : static_cast<int64_t>(merge_cost),
+            merge_row);
+      return OkStatus();
+    }
+
     Shard(worker_threads.num_threads, worker_threads.workers, num_rows,
           final_cost, SortIndices);
 
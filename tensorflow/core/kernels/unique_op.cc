@@ -13,9 +13,11 @@ See the License for the specific language governing permissions and
 limitations under the License.
 ==============================================================================*/
 
+#include <algorithm>
 #include <functional>
 #include <unordered_map>
 #include <utility>
+#include <vector>
 
 #include "absl/container/flat_hash_map.h"
 #include "tensorflow/core/framework/bounds_check.h"
@@ -24,6 +26,7 @@ limitations under the License.
 #include "tensorflow/core/framework/tensor.h"
 #include "tensorflow/core/framework/tensor_shape.h"
 #include "tensorflow/core/lib/core/status.h"
+#include "tensorflow/core/lib/core/threadpool.h"
 #include "tensorflow/core/lib/hash/hash.h"
 #include "tensorflow/core/platform/bfloat16.h"
 
@@ -68,6 +71,15 @@ struct UniqueOpHashMap<bfloat16, TIndex> {
   using map_type = std::unordered_map<bfloat16, TIndex>;
 };
 
+// Minimum chunk width for the sharded 1-D implementation; below
+// num_chunks * this many elements the per-chunk tables and merge pass cost
+// more than they save.
+constexpr int64_t kMinElemsPerUniqueChunk = 1 << 18;
+
+// Nominal per-chunk cost handed to ParallelFor; chunks are large, so any value
+// big enough to give each chunk its own task works.
+constexpr int64_t kUniqueCostPerChunk = kMinElemsPerUniqueChunk * 10;
+
 // `UniqueOp` computes the unique elements in the input tensor.
 //
 // * `T` is the element type.
@@ -150,26 +162,114 @@ class UniqueOp : public OpKernel {
       auto Tin = input.flat<T>();
       const int64_t N = static_cast<int64_t>(Tin.size());
 
-      typename UniqueOpHashMap<T, TIndex>::map_type uniq;
-      uniq.reserve(2 * N);
-      for (Eigen::Index i = 0, j = 0; i < N; ++i) {
-        auto it = uniq.emplace(Tin(i), j);
-        idx_vec(i) = it.first->second;
-        if (it.second) {
-          ++j;
+      thread::ThreadPool* workers =
+          context->device()->tensorflow_cpu_worker_threads()->workers;
+      const int64_t num_chunks = std::min<int64_t>(
+          workers->NumThreads() + 1, N / kMinElemsPerUniqueChunk);
+      if (num_chunks > 1) {
+        // Sharded implementation for large inputs: each worker uniquifies a
+        // contiguous chunk into a local table, recording chunk-local ids in
+        // `idx_vec`. A serial merge then walks the chunks in order, assigning
+        // global ids by first occurrence (so `y` is ordered exactly as in the
+        // serial code), after which the chunk-local ids in `idx_vec` are
+        // rewritten to global ids in parallel. The merge only touches each
+        // chunk's distinct values, which for id-dedup workloads is a small
+        // fraction of N.
+        const int64_t chunk_size = (N + num_chunks - 1) / num_chunks;
+        // First occurrence (input index) of each chunk-local unique value, in
+        // chunk-local id order.
+        std::vector<std::vector<Eigen::Index>> chunk_firsts(num_chunks);
+        workers->ParallelFor(
+            num_chunks, kUniqueCostPerChunk,
+            [&](int64_t chunk_begin, int64_t chunk_end) {
+              for (int64_t c = chunk_begin; c < chunk_end; ++c) {
+                const int64_t begin = c * chunk_size;
+                const int64_t end = std::min(N, begin + chunk_size);
+                typename UniqueOpHashMap<T, TIndex>::map_type local;
+                local.reserve(2 * (end - begin));
+                std::vector<Eigen::Index>& firsts = chunk_firsts[c];
+                TIndex j = 0;
+                for (int64_t i = begin; i < end; ++i) {
+                  auto it = local.emplace(Tin(i), j);
+                  idx_vec(i) = it.first->second;
+                  if (it.second) {
+                    firsts.push_back(i);
+                    ++j;
+                  }
+                }
+              }
+            });
+
+        int64_t num_local_uniques = 0;
+        for (const auto& firsts : chunk_firsts) {
+          num_local_uniques += firsts.size();
+        }
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * num_local_uniques);
+        // Input index of the first occurrence of each global unique value.
+        std::vector<Eigen::Index> unique_firsts;
+        std::vector<std::vector<TIndex>> local_to_global(num_chunks);
+        TIndex j = 0;
+        for (int64_t c = 0; c < num_chunks; ++c) {
+          const std::vector<Eigen::Index>& firsts = chunk_firsts[c];
+          std::vector<TIndex>& remap = local_to_global[c];
+          remap.resize(firsts.size());
+          for (size_t l = 0; l < firsts.size(); ++l) {
+            auto it = uniq.emplace(Tin(firsts[l]), j);
+            remap[l] = it.first->second;
+            if (it.second) {
+              unique_firsts.push_back(firsts[l]);
+              ++j;
+            }
+          }
         }
-      }
 
-      uniq_size = static_cast<int64_t>(uniq.size());
-      TensorShape output_shape(input.shape());
-      output_shape.set_dim(axis, uniq_size);
-      Tensor* output = nullptr;
-      OP_REQUIRES_OK(context,
-                     context->allocate_output(0, output_shape, &output));
-      auto Tout = output->flat<T>();
+        workers->ParallelFor(
+            num_chunks, kUniqueCostPerChunk,
+            [&](int64_t chunk_begin, int64_t chunk_end) {
+              for (int64_t c = chunk_begin; c < chunk_end; ++c) {
+                const int64_t begin = c * chunk_size;
+                const int64_t end = std::min(N, begin + chunk_size);
+                const std::vector<TIndex>& remap = local_to_global[c];
+                for (int64_t i = begin; i < end; ++i) {
+                  idx_vec(i) = remap[idx_vec(i)];
+                }
+              }
+            });
+
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
+
+        for (int64_t g = 0; g < uniq_size; ++g) {
+          Tout(g) = Tin(unique_firsts[g]);
+        }
+      } else {
+        typename UniqueOpHashMap<T, TIndex>::map_type uniq;
+        uniq.reserve(2 * N);
+        for (Eigen::Index i = 0, j = 0; i < N; ++i) {
+          auto it = uniq.emplace(Tin(i), j);
+          idx_vec(i) = it.first->second;
+          if (it.second) {
+            ++j;
+          }
+        }
+
+        uniq_size = static_cast<int64_t>(uniq.size());
+        TensorShape output_shape(input.shape());
+        output_shape.set_dim(axis, uniq_size);
+        Tensor* output = nullptr;
+        OP_REQUIRES_OK(context,
+                       context->allocate_output(0, output_shape, &output));
+        auto Tout = output->flat<T>();
 
-      for (const auto& it : uniq) {
-        Tout(it.second) = it.first;
+        for (const auto& it : uniq) {
+          Tout(it.second) = it.first;
+        }
       }
     } else {
       // General implementation when unique is run over multiple elements.
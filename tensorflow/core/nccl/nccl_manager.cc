@@ -14,7 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/nccl/nccl_manager.h"
 
+#include <tuple>
 #include <utility>
+#include <vector>
 
 #if GOOGLE_CUDA || TENSORFLOW_USE_ROCM
 
@@ -28,6 +30,7 @@ limitations under the License.
 #include "tensorflow/core/profiler/lib/annotated_traceme.h"
 #include "tensorflow/core/profiler/lib/connected_traceme.h"
 #include "tensorflow/core/profiler/lib/traceme.h"
+#include "tensorflow/core/util/env_var.h"
 #if GOOGLE_CUDA
 #include "xla/stream_executor/cuda/cuda_activation.h"
 #elif TENSORFLOW_USE_ROCM
@@ -713,6 +716,25 @@ size_t ComputeBufferSize(const NcclManager::Participant* p,
   }
   return num_elements * DataTypeSize(data_type);
 }
+
+// Maximum number of pending launches drained from a stream's queue and issued
+// inside a single ncclGroupStart/ncclGroupEnd pair.  Grouping lets NCCL
+// aggregate many small collectives (e.g. per-gradient allreduces) into fewer
+// fused kernel launches on the communication stream.  Overridable with
+// TF_NCCL_MAX_LAUNCH_BATCH; a value of 1 restores one-launch-at-a-time
+// behavior.
+int MaxLaunchBatch() {
+  static const int max_launch_batch = [] {
+    int64_t value = 8;
+    Status status =
+        ReadInt64FromEnvVar("TF_NCCL_MAX_LAUNCH_BATCH", 8, &value);
+    if (!status.ok()) {
+      LOG(ERROR) << "MaxLaunchBatch: " << status.message();
+    }
+    return std::max<int>(1, value);
+  }();
+  return max_launch_batch;
+}
 }  // namespace
 
 void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
@@ -726,8 +748,9 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
       comm_stream->platform_specific_handle().stream);
 
   while (true) {
-    // Find collective to run.
-    std::pair<Collective*, int> next_launch;
+    // Find collectives to run.  Drain up to MaxLaunchBatch() pending launches
+    // so they can be issued inside a single NCCL group below.
+    std::vector<std::pair<Collective*, int>> launch_batch;
     {
       VLOG(3) << "Locking mutex nccl_stream " << nccl_stream;
       mutex_lock l(nccl_stream->mu);
@@ -738,187 +761,220 @@ void NcclManager::LoopKernelLaunches(NcclStream* nccl_stream) {
         }
         nccl_stream->cv.wait(l);
       }
-      next_launch = nccl_stream->pending_launches_.back();
-      nccl_stream->pending_launches_.pop_back();
+      const int max_batch = MaxLaunchBatch();
+      while (!nccl_stream->pending_launches_.empty() &&
+             static_cast<int>(launch_batch.size()) < max_batch) {
+        launch_batch.push_back(nccl_stream->pending_launches_.back());
+        nccl_stream->pending_launches_.pop_back();
+      }
     }
 
-    // Launch the nccl kernel.
-    Collective* collective = next_launch.first;
-    tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
-                                                  collective->trace_context);
-
-    ncclDataType_t data_type = ToNcclType(collective->data_type);
-    int p_idx = next_launch.second;
-    Participant* p = collective->participants[p_idx].get();
-    auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
-    ncclResult_t nccl_result = ncclSuccess;
-    switch (collective->type) {
-      case kAllReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-
-        VLOG(2) << "call NcclAllReduce collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllReduce",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_reduce"}});
-        });
-        nccl_result = ncclAllReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, collective->reduction_op,
-                                    nccl_comm, cu_stream);
-        break;
-      }
-      case kBroadcast: {
-        const void* sendbuff = nullptr;
-        void* recvbuff = nullptr;
-        int num_elements = -1;
-        if (p->input) {
-          sendbuff = p->input->tensor_data().data();
-          num_elements = p->input->NumElements();
+    // Issue the batch inside one NCCL group so the runtime may aggregate the
+    // collectives into fewer fused kernel launches.  Launch order within the
+    // batch matches queue order, preserving the cross-stream ordering
+    // guarantee established in RunCollective.  With group semantics,
+    // individual launch errors may only surface at ncclGroupEnd, so done
+    // callbacks are scheduled after the group closes with the combined
+    // result.
+    const bool grouped = launch_batch.size() > 1;
+    if (grouped) ncclGroupStart();
+    // (collective, participant_idx, launch result) for each launch whose done
+    // callback still needs to be scheduled once the group is closed.
+    std::vector<std::tuple<Collective*, int, ncclResult_t>> launched;
+    launched.reserve(launch_batch.size());
+    for (const std::pair<Collective*, int>& next_launch : launch_batch) {
+      // Launch the nccl kernel.
+      Collective* collective = next_launch.first;
+      tensorflow::profiler::TraceMeConsumer traceme("Run Collective",
+                                                    collective->trace_context);
+
+      ncclDataType_t data_type = ToNcclType(collective->data_type);
+      int p_idx = next_launch.second;
+      Participant* p = collective->participants[p_idx].get();
+      auto nccl_comm = collective->communicator->members[p_idx].nccl_comm;
+      ncclResult_t nccl_result = ncclSuccess;
+      switch (collective->type) {
+        case kAllReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllReduce collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllReduce",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_reduce"}});
+          });
+          nccl_result = ncclAllReduce(sendbuff, recvbuff,
+                                      p->input->NumElements(), data_type,
+                                      collective->reduction_op, nccl_comm,
+                                      cu_stream);
+          break;
         }
-        if (p->output) {
-          recvbuff = const_cast<char*>(p->output->tensor_data().data());
-          num_elements = p->output->NumElements();
-        } else {
-          // Operate in-place if no output (for the src node).
-          recvbuff = const_cast<void*>(sendbuff);
+        case kBroadcast: {
+          const void* sendbuff = nullptr;
+          void* recvbuff = nullptr;
+          int num_elements = -1;
+          if (p->input) {
+            sendbuff = p->input->tensor_data().data();
+            num_elements = p->input->NumElements();
+          }
+          if (p->output) {
+            recvbuff = const_cast<char*>(p->output->tensor_data().data());
+            num_elements = p->output->NumElements();
+          } else {
+            // Operate in-place if no output (for the src node).
+            recvbuff = const_cast<void*>(sendbuff);
+          }
+          if (num_elements < 0) {
+            p->done_callback(errors::Internal(
+                "Both input and output are null in ncclBroadcast"));
+            collective->Unref();
+            continue;
+          }
+          VLOG(2) << "call NcclBroadcast collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclBroadcast",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "broadcast"}});
+          });
+          nccl_result =
+              ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
+                            collective->root_rank, nccl_comm, cu_stream);
+          break;
         }
-        if (num_elements < 0) {
-          p->done_callback(errors::Internal(
-              "Both input and output are null in ncclBroadcast"));
-          collective->Unref();
-          continue;
+        case kReduce: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff =
+              p->output ? const_cast<char*>(p->output->tensor_data().data())
+                        : nullptr;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "buffer_size",
+                {{"output_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "reduce"}});
+          });
+          nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
+                                   data_type, collective->reduction_op,
+                                   collective->root_rank, nccl_comm, cu_stream);
+          break;
+        }
+        case kAllGather: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclAllGather collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " sendbuff " << sendbuff << " sendcount "
+                  << p->input->NumElements() << " recvbuff " << recvbuff
+                  << " recvcount " << p->output->NumElements() << " nccl_comm "
+                  << nccl_comm << " comm_stream " << comm_stream
+                  << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllGather",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_gather"}});
+          });
+          nccl_result = ncclAllGather(sendbuff, recvbuff,
+                                      p->input->NumElements(), data_type,
+                                      nccl_comm, cu_stream);
+          break;
+        }
+        case kReduceScatter: {
+          const void* sendbuff = p->input->tensor_data().data();
+          void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+
+          VLOG(2) << "call NcclReduceScatter collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << sendbuff << " recvbuff " << recvbuff
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclReduceScatter",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "reduce_scatter"}});
+          });
+          nccl_result = ncclReduceScatter(
+              sendbuff, recvbuff, p->output->NumElements(), data_type,
+              collective->reduction_op, nccl_comm, cu_stream);
+          break;
+        }
+        case kAllToAll: {
+          const char* sendbuff = p->input->tensor_data().data();
+          char* recvbuff = const_cast<char*>(p->output->tensor_data().data());
+          size_t count =
+              p->input->NumElements() / collective->participants.size();
+          size_t rank_offset = count * DataTypeSize(collective->data_type);
+
+          VLOG(2) << "call Nccl All to All collective_key "
+                  << collective->collective_key << " participant " << p_idx
+                  << " num_participants " << collective->participants.size()
+                  << " sendbuff " << static_cast<const void*>(sendbuff)
+                  << " recvbuff " << static_cast<void*>(recvbuff)
+                  << " nccl_comm " << nccl_comm << " comm_stream "
+                  << comm_stream << " cuda_stream " << cu_stream;
+          profiler::AnnotatedTraceMe traceme([&] {
+            return profiler::TraceMeEncode(
+                "ncclAllToAll",
+                {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
+                 {"collective_type", "all_to_all"}});
+          });
+          // NCCL group calls nest, so this inner group folds into the batch
+          // group when one is open.
+          ncclGroupStart();
+          for (int i = 0; i < collective->participants.size(); ++i) {
+            ncclSend(sendbuff + i * rank_offset, count, data_type,
+                     collective->participants[i]->global_rank, nccl_comm,
+                     cu_stream);
+            ncclRecv(recvbuff + i * rank_offset, count, data_type,
+                     collective->participants[i]->global_rank, nccl_comm,
+                     cu_stream);
+          }
+          nccl_result = ncclGroupEnd();
+          break;
         }
-        VLOG(2) << "call NcclBroadcast collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclBroadcast",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "broadcast"}});
-        });
-        nccl_result =
-            ncclBroadcast(sendbuff, recvbuff, num_elements, data_type,
-                          collective->root_rank, nccl_comm, cu_stream);
-        break;
-      }
-      case kReduce: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff =
-            p->output ? const_cast<char*>(p->output->tensor_data().data())
-                      : nullptr;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "buffer_size",
-              {{"output_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "reduce"}});
-        });
-        nccl_result = ncclReduce(sendbuff, recvbuff, p->input->NumElements(),
-                                 data_type, collective->reduction_op,
-                                 collective->root_rank, nccl_comm, cu_stream);
-        break;
-      }
-      case kAllGather: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-
-        VLOG(2) << "call NcclAllGather collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " sendbuff " << sendbuff << " sendcount "
-                << p->input->NumElements() << " recvbuff " << recvbuff
-                << " recvcount " << p->output->NumElements() << " nccl_comm "
-                << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllGather",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_gather"}});
-        });
-        nccl_result = ncclAllGather(sendbuff, recvbuff, p->input->NumElements(),
-                                    data_type, nccl_comm, cu_stream);
-        break;
-      }
-      case kReduceScatter: {
-        const void* sendbuff = p->input->tensor_data().data();
-        void* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-
-        VLOG(2) << "call NcclReduceScatter collective_key "
-                << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << sendbuff << " recvbuff " << recvbuff
-                << " nccl_comm " << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclReduceScatter",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "reduce_scatter"}});
-        });
-        nccl_result = ncclReduceScatter(
-            sendbuff, recvbuff, p->output->NumElements(), data_type,
-            collective->reduction_op, nccl_comm, cu_stream);
-        break;
       }
-      case kAllToAll: {
-        const char* sendbuff = p->input->tensor_data().data();
-        char* recvbuff = const_cast<char*>(p->output->tensor_data().data());
-        size_t count =
-            p->input->NumElements() / collective->participants.size();
-        size_t rank_offset = count * DataTypeSize(collective->data_type);
-
-        VLOG(2) << "call Nccl All to All collective_key "
+      launched.emplace_back(collective, p_idx, nccl_result);
+    }
+    ncclResult_t group_result = grouped ? ncclGroupEnd() : ncclSuccess;
+
+    for (const auto& entry : launched) {
+      Collective* collective = std::get<0>(entry);
+      const int p_idx = std::get<1>(entry);
+      const ncclResult_t launch_result = std::get<2>(entry);
+      const ncclResult_t nccl_result =
+          launch_result != ncclSuccess ? launch_result : group_result;
+      Participant* p = collective->participants[p_idx].get();
+      // Run the done_callback when the nccl kernel finishes running.
+      auto done_callback = [collective, p_idx, nccl_result]() {
+        VLOG(2) << "done Nccl kernel collective_key "
                 << collective->collective_key << " participant " << p_idx
-                << " num_participants " << collective->participants.size()
-                << " sendbuff " << static_cast<const void*>(sendbuff)
-                << " recvbuff " << static_cast<void*>(recvbuff) << " nccl_comm "
-                << nccl_comm << " comm_stream " << comm_stream
-                << " cuda_stream " << cu_stream;
-        profiler::AnnotatedTraceMe traceme([&] {
-          return profiler::TraceMeEncode(
-              "ncclAllToAll",
-              {{"buffer_size", ComputeBufferSize(p, collective->data_type)},
-               {"collective_type", "all_to_all"}});
-        });
-        ncclGroupStart();
-        for (int i = 0; i < collective->participants.size(); ++i) {
-          ncclSend(sendbuff + i * rank_offset, count, data_type,
-                   collective->participants[i]->global_rank, nccl_comm,
-                   cu_stream);
-          ncclRecv(recvbuff + i * rank_offset, count, data_type,
-                   collective->participants[i]->global_rank, nccl_comm,
-                   cu_stream);
+                << " ncclResult " << nccl_result;
+        if (nccl_result == ncclSuccess) {
+          collective->participants[p_idx]->done_callback(OkStatus());
+        } else {
+          // Propagate the error, but note that if other members of the
+          // collective did launch their kernels, then they are hanging.
+          collective->participants[p_idx]->done_callback(errors::Unknown(
+              "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
         }
-        nccl_result = ncclGroupEnd();
-        break;
-      }
+        collective->Unref();
+      };
+      p->event_mgr->ThenExecute(comm_stream, done_callback);
     }
-
-    // Run the done_callback when the nccl kernel finishes running.
-    auto done_callback = [collective, p_idx, nccl_result]() {
-      VLOG(2) << "done Nccl kernel collective_key "
-              << collective->collective_key << " participant " << p_idx
-              << " ncclResult " << nccl_result;
-      if (nccl_result == ncclSuccess) {
-        collective->participants[p_idx]->done_callback(OkStatus());
-      } else {
-        // Propagate the error, but note that if other members of the collective
-        // did launch their kernels, then they are hanging.
-        collective->participants[p_idx]->done_callback(errors::Unknown(
-            "Error invoking NCCL: ", ncclGetErrorString(nccl_result)));
-      }
-      collective->Unref();
-    };
-    p->event_mgr->ThenExecute(comm_stream, done_callback);
   }
 }
 
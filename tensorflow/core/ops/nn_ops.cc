@@ -1291,6 +1291,39 @@ REGISTER_OP("Softmax")
 
 // --------------------------------------------------------------------------
 
+REGISTER_OP("_FusedScaledDotProductAttention")
+    .Input("query: T")
+    .Input("key: T")
+    .Input("value: T")
+    .Input("scale: T")
+    .Output("output: T")
+    .Attr("T: {float}")
+    .Attr("scale_is_reciprocal: bool = false")
+    .SetShapeFn([](InferenceContext* c) {
+      ShapeHandle query;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(0), 2, &query));
+      ShapeHandle value;
+      TF_RETURN_IF_ERROR(c->WithRankAtLeast(c->input(2), 2, &value));
+      ShapeHandle output;
+      TF_RETURN_IF_ERROR(
+          c->ReplaceDim(query, -1, c->Dim(value, -1), &output));
+      c->set_output(0, output);
+      return absl::OkStatus();
+    })
+    .Doc(R"doc(
+Computes softmax(query * key^T * scale) * value in a single pass.
+
+The softmax normalization runs in streaming form over the score rows, so
+neither the score matrix nor the softmax output is materialized. `scale` is a
+scalar; if `scale_is_reciprocal` is true the scores are divided by it instead
+of multiplied (matching a Div node in the source graph).
+
+*NOTE*: Do not invoke this operator directly in Python. Grappler is
+expected to create these operators.
+)doc");
+
+// --------------------------------------------------------------------------
+
 REGISTER_OP("LogSoftmax")
     .Input("logits: T")
     .Output("logsoftmax: T")
@@ -0,0 +1,206 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/flight_recorder.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/macros.h"
+#include "tensorflow/core/platform/mutex.h"
+#include "tsl/profiler/utils/time_utils.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+size_t RoundUpToPowerOfTwo(size_t value) {
+  size_t result = 1;
+  while (result < value) result <<= 1;
+  return result;
+}
+
+// Single-producer ring buffer owned by one thread. The owning thread is the
+// only writer; snapshots read concurrently. The publication index is released
+// after the slot is written, so a reader either sees a fully written event or
+// skips the slot being overwritten at the wrap-around point.
+class ThreadRing {
+ public:
+  explicit ThreadRing(size_t capacity)
+      : capacity_(RoundUpToPowerOfTwo(capacity)),
+        slots_(capacity_),
+        thread_id_(Env::Default()->GetCurrentThreadId()) {}
+
+  void Push(absl::string_view name, uint64_t start_time_ns,
+            uint64_t end_time_ns) {
+    const uint64_t index = next_index_.load(std::memory_order_relaxed);
+    FlightRecorder::Event& slot = slots_[index & (capacity_ - 1)];
+    const size_t name_length =
+        std::min(name.size(), FlightRecorder::Event::kMaxNameLength - 1);
+    std::memcpy(slot.name, name.data(), name_length);
+    slot.name[name_length] = '\0';
+    slot.start_time_ns = start_time_ns;
+    slot.duration_ns = end_time_ns - start_time_ns;
+    slot.thread_id = thread_id_;
+    next_index_.store(index + 1, std::memory_order_release);
+  }
+
+  // Returns true if this thread should record the current event. Sampling is
+  // per thread so that one chatty thread cannot starve the others.
+  bool Sample(uint32_t sampling_period) {
+    return (sample_counter_++ % sampling_period) == 0;
+  }
+
+  void AppendEventsTo(std::vector<FlightRecorder::Event>* events) const {
+    const uint64_t end = next_index_.load(std::memory_order_acquire);
+    const uint64_t begin = end > capacity_ ? end - capacity_ : 0;
+    for (uint64_t i = begin; i < end; ++i) {
+      events->push_back(slots_[i & (capacity_ - 1)]);
+    }
+  }
+
+ private:
+  const size_t capacity_;  // Power of two.
+  std::vector<FlightRecorder::Event> slots_;
+  const int64_t thread_id_;
+  std::atomic<uint64_t> next_index_{0};
+  uint32_t sample_counter_ = 0;
+};
+
+// Owns the per-thread rings. Rings are kept after thread exit so that a
+// snapshot can still cover recently finished threads; the memory is bounded
+// by events_per_thread * number of threads ever recorded.
+class RingRegistry {
+ public:
+  static RingRegistry& Get() {
+    static RingRegistry* registry = new RingRegistry;
+    return *registry;
+  }
+
+  ThreadRing* GetOrCreateCurrentThreadRing() {
+    thread_local ThreadRing* ring = [this] {
+      auto owned_ring = std::make_unique<ThreadRing>(
+          events_per_thread_.load(std::memory_order_relaxed));
+      ThreadRing* raw_ring = owned_ring.get();
+      mutex_lock lock(mu_);
+      rings_.push_back(std::move(owned_ring));
+      return raw_ring;
+    }();
+    return ring;
+  }
+
+  std::vector<FlightRecorder::Event> Snapshot() const {
+    std::vector<FlightRecorder::Event> events;
+    {
+      mutex_lock lock(mu_);
+      for (const auto& ring : rings_) {
+        ring->AppendEventsTo(&events);
+      }
+    }
+    std::sort(events.begin(), events.end(),
+              [](const FlightRecorder::Event& a,
+                 const FlightRecorder::Event& b) {
+                return a.start_time_ns < b.start_time_ns;
+              });
+    return events;
+  }
+
+  void SetOptions(const FlightRecorderOptions& options) {
+    events_per_thread_.store(options.events_per_thread,
+                             std::memory_order_relaxed);
+    sampling_period_.store(options.sampling_period > 0
+                               ? options.sampling_period
+                               : 1,
+                           std::memory_order_relaxed);
+  }
+
+  uint32_t sampling_period() const {
+    return sampling_period_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  RingRegistry() = default;
+
+  mutable mutex mu_;
+  std::vector<std::unique_ptr<ThreadRing>> rings_ TF_GUARDED_BY(mu_);
+  std::atomic<size_t> events_per_thread_{
+      FlightRecorderOptions().events_per_thread};
+  std::atomic<uint32_t> sampling_period_{
+      FlightRecorderOptions().sampling_period};
+};
+
+}  // namespace
+
+std::atomic<bool> FlightRecorder::enabled_{false};
+
+void FlightRecorder::Enable(const FlightRecorderOptions& options) {
+  RingRegistry::Get().SetOptions(options);
+  enabled_.store(true, std::memory_order_release);
+}
+
+void FlightRecorder::Disable() {
+  enabled_.store(false, std::memory_order_release);
+}
+
+bool FlightRecorder::IsEnabled() {
+  return enabled_.load(std::memory_order_acquire);
+}
+
+std::vector<FlightRecorder::Event> FlightRecorder::Snapshot() {
+  return RingRegistry::Get().Snapshot();
+}
+
+std::vector<FlightRecorder::Event> FlightRecorder::SnapshotLast(
+    uint64_t duration_ns) {
+  const uint64_t now_ns = tsl::profiler::GetCurrentTimeNanos();
+  const uint64_t cutoff_ns = now_ns > duration_ns ? now_ns - duration_ns : 0;
+  std::vector<Event> events = Snapshot();
+  events.erase(std::remove_if(events.begin(), events.end(),
+                              [cutoff_ns](const Event& event) {
+                                return event.start_time_ns < cutoff_ns;
+                              }),
+               events.end());
+  return events;
+}
+
+void FlightRecorder::Record(absl::string_view name, uint64_t start_time_ns,
+                            uint64_t end_time_ns) {
+  RingRegistry& registry = RingRegistry::Get();
+  ThreadRing* ring = registry.GetOrCreateCurrentThreadRing();
+  if (!ring->Sample(registry.sampling_period())) return;
+  ring->Push(name, start_time_ns, end_time_ns);
+}
+
+FlightRecorder::ScopedEvent::ScopedEvent(absl::string_view name)
+    : name_(name) {
+  if (TF_PREDICT_FALSE(IsEnabled())) {
+    start_time_ns_ = tsl::profiler::GetCurrentTimeNanos();
+  }
+}
+
+FlightRecorder::ScopedEvent::~ScopedEvent() {
+  if (start_time_ns_ != 0) {
+    Record(name_, start_time_ns_, tsl::profiler::GetCurrentTimeNanos());
+  }
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,111 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef TENSORFLOW_CORE_PROFILER_LIB_FLIGHT_RECORDER_H_
+#define TENSORFLOW_CORE_PROFILER_LIB_FLIGHT_RECORDER_H_
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "absl/strings/string_view.h"
+
+namespace tensorflow {
+namespace profiler {
+
+struct FlightRecorderOptions {
+  // Number of events retained per thread. Rounded up to a power of two.
+  // Older events are overwritten once the ring buffer is full.
+  size_t events_per_thread = 4096;
+
+  // One out of every `sampling_period` scoped events is recorded per thread.
+  // Must be >= 1. Raising this lowers both overhead and trace resolution.
+  uint32_t sampling_period = 16;
+};
+
+// Always-on, low-overhead "flight recorder" of TraceMe-style activity.
+//
+// ProfilerSession is designed for bounded, explicitly started traces and is
+// too heavy to leave enabled in production. The flight recorder instead keeps
+// a per-thread lock-free ring buffer of sampled scoped events so the last few
+// seconds of activity can be flushed on demand (e.g. from a signal handler
+// thread or an RPC) whenever a latency SLO trips.
+//
+// Recording takes two timestamps and one ring-buffer slot write on the owning
+// thread with no locks and no allocation; with the default 1/16 sampling this
+// stays well under 1% overhead for TraceMe-dense workloads. Snapshots only
+// lock the thread registry, not the writers: an event being overwritten while
+// it is read may be dropped from the snapshot, which is acceptable for a
+// best-effort diagnostic trace.
+class FlightRecorder {
+ public:
+  // A fixed-size event record. Names longer than kMaxNameLength - 1 are
+  // truncated so that recording never allocates.
+  struct Event {
+    static constexpr size_t kMaxNameLength = 56;
+    char name[kMaxNameLength];
+    uint64_t start_time_ns;
+    uint64_t duration_ns;
+    int64_t thread_id;
+  };
+
+  // Starts recording with the given options. Affects all threads. Calling
+  // Enable while already enabled updates the sampling period but keeps
+  // existing ring buffers (their capacity is fixed at creation).
+  static void Enable(const FlightRecorderOptions& options);
+
+  // Stops recording. Already recorded events remain snapshottable.
+  static void Disable();
+
+  static bool IsEnabled();
+
+  // Copies the retained events of all threads, sorted by start time.
+  static std::vector<Event> Snapshot();
+
+  // Like Snapshot(), but only returns events that started within the last
+  // `duration_ns` nanoseconds.
+  static std::vector<Event> SnapshotLast(uint64_t duration_ns);
+
+  // Records the enclosing scope as one event, subject to sampling. Intended
+  // to be used like TraceMe in code that should stay observable in
+  // production:
+  //
+  //   FlightRecorder::ScopedEvent event("MyOperation");
+  class ScopedEvent {
+   public:
+    explicit ScopedEvent(absl::string_view name);
+    ~ScopedEvent();
+
+    ScopedEvent(const ScopedEvent&) = delete;
+    ScopedEvent& operator=(const ScopedEvent&) = delete;
+
+   private:
+    absl::string_view name_;
+    uint64_t start_time_ns_ = 0;  // 0 when not recording.
+  };
+
+ private:
+  friend class ScopedEvent;
+
+  static void Record(absl::string_view name, uint64_t start_time_ns,
+                     uint64_t end_time_ns);
+
+  static std::atomic<bool> enabled_;
+};
+
+}  // namespace profiler
+}  // namespace tensorflow
+
+#endif  // TENSORFLOW_CORE_PROFILER_LIB_FLIGHT_RECORDER_H_
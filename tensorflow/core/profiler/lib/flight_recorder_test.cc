@@ -0,0 +1,129 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/flight_recorder.h"
+
+#include <cstdint>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+FlightRecorderOptions UnsampledOptions() {
+  FlightRecorderOptions options;
+  options.sampling_period = 1;
+  return options;
+}
+
+int CountEventsNamed(const std::vector<FlightRecorder::Event>& events,
+                     const std::string& name) {
+  int count = 0;
+  for (const auto& event : events) {
+    if (name == event.name) ++count;
+  }
+  return count;
+}
+
+TEST(FlightRecorderTest, DisabledByDefault) {
+  EXPECT_FALSE(FlightRecorder::IsEnabled());
+  { FlightRecorder::ScopedEvent event("NotRecorded"); }
+  EXPECT_EQ(CountEventsNamed(FlightRecorder::Snapshot(), "NotRecorded"), 0);
+}
+
+TEST(FlightRecorderTest, RecordsScopedEventsWhenEnabled) {
+  FlightRecorder::Enable(UnsampledOptions());
+  { FlightRecorder::ScopedEvent event("RecordedEvent"); }
+  FlightRecorder::Disable();
+
+  const std::vector<FlightRecorder::Event> events = FlightRecorder::Snapshot();
+  EXPECT_EQ(CountEventsNamed(events, "RecordedEvent"), 1);
+  for (const auto& event : events) {
+    if (std::string(event.name) == "RecordedEvent") {
+      EXPECT_GT(event.start_time_ns, 0);
+    }
+  }
+}
+
+TEST(FlightRecorderTest, StopsRecordingWhenDisabled) {
+  FlightRecorder::Enable(UnsampledOptions());
+  FlightRecorder::Disable();
+  { FlightRecorder::ScopedEvent event("AfterDisable"); }
+  EXPECT_EQ(CountEventsNamed(FlightRecorder::Snapshot(), "AfterDisable"), 0);
+}
+
+TEST(FlightRecorderTest, TruncatesLongNames) {
+  FlightRecorder::Enable(UnsampledOptions());
+  const std::string long_name(2 * FlightRecorder::Event::kMaxNameLength, 'x');
+  { FlightRecorder::ScopedEvent event(long_name); }
+  FlightRecorder::Disable();
+
+  const std::string truncated_name(FlightRecorder::Event::kMaxNameLength - 1,
+                                   'x');
+  EXPECT_EQ(CountEventsNamed(FlightRecorder::Snapshot(), truncated_name), 1);
+}
+
+TEST(FlightRecorderTest, RingBufferKeepsMostRecentEvents) {
+  FlightRecorderOptions options = UnsampledOptions();
+  options.events_per_thread = 4;
+  FlightRecorder::Enable(options);
+  // With per-thread capacity 4, only the last occurrences survive. Run on a
+  // dedicated thread so events recorded by other tests on this thread's ring
+  // don't interfere with the count.
+  std::thread recorder([] {
+    for (int i = 0; i < 100; ++i) {
+      FlightRecorder::ScopedEvent event("OverwrittenEvent");
+    }
+  });
+  recorder.join();
+  FlightRecorder::Disable();
+
+  EXPECT_EQ(CountEventsNamed(FlightRecorder::Snapshot(), "OverwrittenEvent"),
+            4);
+}
+
+TEST(FlightRecorderTest, SnapshotCoversMultipleThreads) {
+  FlightRecorder::Enable(UnsampledOptions());
+  std::vector<std::thread> threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back(
+        [] { FlightRecorder::ScopedEvent event("MultiThreadEvent"); });
+  }
+  for (auto& thread : threads) thread.join();
+  FlightRecorder::Disable();
+
+  const std::vector<FlightRecorder::Event> events = FlightRecorder::Snapshot();
+  EXPECT_EQ(CountEventsNamed(events, "MultiThreadEvent"), 4);
+}
+
+TEST(FlightRecorderTest, SnapshotLastFiltersOldEvents) {
+  FlightRecorder::Enable(UnsampledOptions());
+  { FlightRecorder::ScopedEvent event("RecentEvent"); }
+  FlightRecorder::Disable();
+
+  constexpr uint64_t kTenMinutesNs = 600ull * 1000 * 1000 * 1000;
+  EXPECT_GE(CountEventsNamed(FlightRecorder::SnapshotLast(kTenMinutesNs),
+                             "RecentEvent"),
+            1);
+  EXPECT_EQ(CountEventsNamed(FlightRecorder::SnapshotLast(0), "RecentEvent"),
+            0);
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
@@ -0,0 +1,192 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/perf_counters.h"
+
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <string>
+
+#include "absl/container/flat_hash_map.h"
+#include "absl/strings/string_view.h"
+#include "tensorflow/core/platform/mutex.h"
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#define TF_PERF_COUNTERS_AVAILABLE 1
+#endif
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+std::atomic<bool> profiler_enabled{false};
+std::atomic<uint32_t> profiler_sampling_period{100};
+
+// Accumulated per-op counters, shared by all threads. Only touched on
+// sampled executions, so a plain mutex is cheap enough.
+mutex& CountersMutex() {
+  static mutex* mu = new mutex;
+  return *mu;
+}
+
+absl::flat_hash_map<std::string, OpPerfCounters>& Counters() {
+  static auto* counters = new absl::flat_hash_map<std::string, OpPerfCounters>;
+  return *counters;
+}
+
+#if defined(TF_PERF_COUNTERS_AVAILABLE)
+
+// One perf event group (cycles leads; instructions and LLC misses follow)
+// bound to the owning thread. Counters are process-wide per thread, so each
+// executor thread opens its own group lazily on first sampled execution.
+class ThreadPerfEvents {
+ public:
+  ThreadPerfEvents() {
+    leader_fd_ = OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CPU_CYCLES,
+                             /*group_fd=*/-1);
+    if (leader_fd_ == -1) return;
+    instructions_fd_ = OpenCounter(PERF_TYPE_HARDWARE,
+                                   PERF_COUNT_HW_INSTRUCTIONS, leader_fd_);
+    llc_misses_fd_ =
+        OpenCounter(PERF_TYPE_HARDWARE, PERF_COUNT_HW_CACHE_MISSES, leader_fd_);
+    ioctl(leader_fd_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_fd_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+  }
+
+  ~ThreadPerfEvents() {
+    if (llc_misses_fd_ != -1) close(llc_misses_fd_);
+    if (instructions_fd_ != -1) close(instructions_fd_);
+    if (leader_fd_ != -1) close(leader_fd_);
+  }
+
+  bool IsValid() const { return leader_fd_ != -1; }
+
+  bool Read(uint64_t* cycles, uint64_t* instructions, uint64_t* llc_misses) {
+    // PERF_FORMAT_GROUP layout: nr, then one value per group member in
+    // creation order.
+    uint64_t buffer[4] = {0};
+    if (read(leader_fd_, buffer, sizeof(buffer)) < 0) return false;
+    const uint64_t nr = buffer[0];
+    *cycles = nr > 0 ? buffer[1] : 0;
+    *instructions = nr > 1 ? buffer[2] : 0;
+    *llc_misses = nr > 2 ? buffer[3] : 0;
+    return true;
+  }
+
+  // Returns true if this thread should sample the current execution.
+  bool Sample(uint32_t sampling_period) {
+    return (sample_counter_++ % sampling_period) == 0;
+  }
+
+ private:
+  static int OpenCounter(uint32_t type, uint64_t config, int group_fd) {
+    struct perf_event_attr attr;
+    std::memset(&attr, 0, sizeof(attr));
+    attr.type = type;
+    attr.size = sizeof(attr);
+    attr.config = config;
+    attr.disabled = (group_fd == -1) ? 1 : 0;
+    attr.exclude_kernel = 1;
+    attr.exclude_hv = 1;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return syscall(SYS_perf_event_open, &attr, /*pid=*/0, /*cpu=*/-1, group_fd,
+                   /*flags=*/0);
+  }
+
+  int leader_fd_ = -1;
+  int instructions_fd_ = -1;
+  int llc_misses_fd_ = -1;
+  uint32_t sample_counter_ = 0;
+};
+
+ThreadPerfEvents* GetThreadPerfEvents() {
+  thread_local ThreadPerfEvents* events = new ThreadPerfEvents;
+  return events->IsValid() ? events : nullptr;
+}
+
+#endif  // TF_PERF_COUNTERS_AVAILABLE
+
+}  // namespace
+
+bool PerfCounterProfiler::Enable(uint32_t sampling_period) {
+#if defined(TF_PERF_COUNTERS_AVAILABLE)
+  // Probe counter availability on the calling thread so Enable reports
+  // failure (e.g. perf_event_paranoid) instead of silently collecting
+  // nothing.
+  if (GetThreadPerfEvents() == nullptr) return false;
+  profiler_sampling_period.store(sampling_period > 0 ? sampling_period : 1,
+                                 std::memory_order_relaxed);
+  profiler_enabled.store(true, std::memory_order_release);
+  return true;
+#else
+  (void)sampling_period;
+  return false;
+#endif
+}
+
+void PerfCounterProfiler::Disable() {
+  profiler_enabled.store(false, std::memory_order_release);
+}
+
+bool PerfCounterProfiler::IsEnabled() {
+  return profiler_enabled.load(std::memory_order_acquire);
+}
+
+absl::flat_hash_map<std::string, OpPerfCounters> PerfCounterProfiler::Collect(
+    bool reset) {
+  mutex_lock lock(CountersMutex());
+  if (!reset) return Counters();
+  absl::flat_hash_map<std::string, OpPerfCounters> result;
+  result.swap(Counters());
+  return result;
+}
+
+PerfCounterProfiler::ScopedSample::ScopedSample(absl::string_view op_name)
+    : op_name_(op_name) {
+#if defined(TF_PERF_COUNTERS_AVAILABLE)
+  if (!IsEnabled()) return;
+  ThreadPerfEvents* events = GetThreadPerfEvents();
+  if (events == nullptr ||
+      !events->Sample(profiler_sampling_period.load(std::memory_order_relaxed))) {
+    return;
+  }
+  active_ = events->Read(&start_cycles_, &start_instructions_,
+                         &start_llc_misses_);
+#endif
+}
+
+PerfCounterProfiler::ScopedSample::~ScopedSample() {
+#if defined(TF_PERF_COUNTERS_AVAILABLE)
+  if (!active_) return;
+  ThreadPerfEvents* events = GetThreadPerfEvents();
+  uint64_t cycles, instructions, llc_misses;
+  if (events == nullptr || !events->Read(&cycles, &instructions, &llc_misses)) {
+    return;
+  }
+  mutex_lock lock(CountersMutex());
+  OpPerfCounters& op_counters = Counters()[op_name_];
+  op_counters.cycles += cycles - start_cycles_;
+  op_counters.instructions += instructions - start_instructions_;
+  op_counters.llc_misses += llc_misses - start_llc_misses_;
+  ++op_counters.samples;
+#endif
+}
+
+}  // namespace profiler
+}  // namespace tensorflow
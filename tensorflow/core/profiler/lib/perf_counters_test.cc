@@ -0,0 +1,74 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "tensorflow/core/profiler/lib/perf_counters.h"
+
+#include "tensorflow/core/platform/test.h"
+
+namespace tensorflow {
+namespace profiler {
+namespace {
+
+TEST(PerfCountersTest, DisabledByDefault) {
+  EXPECT_FALSE(PerfCounterProfiler::IsEnabled());
+  { PerfCounterProfiler::ScopedSample sample("NoOp"); }
+  EXPECT_FALSE(PerfCounterProfiler::Collect().contains("NoOp"));
+}
+
+TEST(PerfCountersTest, CollectsSampledCounters) {
+  // Hardware counters may be unavailable (non-Linux platforms, restrictive
+  // perf_event_paranoid, VMs without a PMU); that must surface through
+  // Enable rather than as missing data later.
+  if (!PerfCounterProfiler::Enable(/*sampling_period=*/1)) {
+    GTEST_SKIP() << "Hardware performance counters are not available.";
+  }
+
+  {
+    PerfCounterProfiler::ScopedSample sample("BusyLoop");
+    // Burn some cycles so the deltas are non-trivial.
+    volatile int accumulator = 0;
+    for (int i = 0; i < 100000; ++i) accumulator += i;
+  }
+  PerfCounterProfiler::Disable();
+
+  const auto counters = PerfCounterProfiler::Collect(/*reset=*/true);
+  ASSERT_TRUE(counters.contains("BusyLoop"));
+  const OpPerfCounters& op_counters = counters.at("BusyLoop");
+  EXPECT_EQ(op_counters.samples, 1);
+  EXPECT_GT(op_counters.cycles, 0);
+  EXPECT_GT(op_counters.instructions, 0);
+
+  // Collect(reset=true) cleared the accumulators.
+  EXPECT_FALSE(PerfCounterProfiler::Collect().contains("BusyLoop"));
+}
+
+TEST(PerfCountersTest, SamplingPeriodSkipsExecutions) {
+  if (!PerfCounterProfiler::Enable(/*sampling_period=*/1000000)) {
+    GTEST_SKIP() << "Hardware performance counters are not available.";
+  }
+  // The first execution on this thread was already sampled by the Enable
+  // probe in the previous test or consumed here; subsequent executions within
+  // the period must be skipped.
+  PerfCounterProfiler::Collect(/*reset=*/true);
+  { PerfCounterProfiler::ScopedSample sample("MaybeSampled"); }
+  { PerfCounterProfiler::ScopedSample sample("Skipped"); }
+  PerfCounterProfiler::Disable();
+
+  const auto counters = PerfCounterProfiler::Collect(/*reset=*/true);
+  EXPECT_FALSE(counters.contains("Skipped"));
+}
+
+}  // namespace
+}  // namespace profiler
+}  // namespace tensorflow
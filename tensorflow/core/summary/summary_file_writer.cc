@@ -14,7 +14,9 @@ limitations under the License.
 ==============================================================================*/
 #include "tensorflow/core/summary/summary_file_writer.h"
 
+#include <deque>
 #include <memory>
+#include <utility>
 
 #include "absl/strings/match.h"
 #include "absl/strings/str_cat.h"
@@ -24,12 +26,18 @@ limitations under the License.
 #include "tensorflow/core/framework/summary.pb.h"
 #include "tensorflow/core/framework/types.h"
 #include "tensorflow/core/lib/io/path.h"
+#include "tensorflow/core/platform/env.h"
+#include "tensorflow/core/platform/mutex.h"
 #include "tensorflow/core/summary/summary_converter.h"
 #include "tensorflow/core/util/events_writer.h"
 
 namespace tensorflow {
 namespace {
 
+// Upper bound on the memory held by events that have been queued but not
+// yet written to the file. Producers block once the bound is exceeded.
+constexpr uint64 kMaxQueuedBytes = 64ull << 20;  // 64MiB
+
 class SummaryFileWriter : public SummaryWriterInterface {
  public:
   SummaryFileWriter(int max_queue, int flush_millis, Env* env)
@@ -37,7 +45,11 @@ class SummaryFileWriter : public SummaryWriterInterface {
         is_initialized_(false),
         max_queue_(max_queue),
         flush_millis_(flush_millis),
-        env_(env) {}
+        env_(env),
+        queued_bytes_(0),
+        flush_requested_(false),
+        writer_busy_(false),
+        shutdown_(false) {}
 
   Status Initialize(const string& logdir, const string& filename_suffix) {
     const Status is_dir = env_->IsDirectory(logdir);
@@ -62,6 +74,10 @@ class SummaryFileWriter : public SummaryWriterInterface {
         events_writer_->InitWithSuffix(uniquified_filename_suffix),
         "Could not initialize events writer.");
     last_flush_ = env_->NowMicros();
+    // All serialization and file IO happens on this thread; the write
+    // methods only enqueue events.
+    background_thread_.reset(env_->StartThread(
+        ThreadOptions(), "summary_file_writer", [this]() { RunWriterLoop(); }));
     is_initialized_ = true;
     return absl::OkStatus();
   }
@@ -71,11 +87,24 @@ class SummaryFileWriter : public SummaryWriterInterface {
     if (!is_initialized_) {
       return errors::FailedPrecondition("Class was not properly initialized.");
     }
-    return InternalFlush();
+    flush_requested_ = true;
+    work_cv_.notify_one();
+    while (writer_status_.ok() &&
+           (flush_requested_ || !queue_.empty() || writer_busy_)) {
+      drained_cv_.wait(ml);
+    }
+    return writer_status_;
   }
 
   ~SummaryFileWriter() override {
-    (void)Flush();  // Ignore errors.
+    {
+      mutex_lock ml(mu_);
+      shutdown_ = true;
+      work_cv_.notify_one();
+    }
+    // Joins the writer thread, which drains and flushes any queued events
+    // before exiting. Errors during the final flush are ignored.
+    background_thread_.reset();
   }
 
   Status WriteTensor(int64_t global_step, Tensor t, const string& tag,
@@ -152,12 +181,22 @@ class SummaryFileWriter : public SummaryWriterInterface {
 
   Status WriteEvent(std::unique_ptr<Event> event) override {
     mutex_lock ml(mu_);
+    if (!writer_status_.ok()) {
+      return writer_status_;
+    }
+    // Backpressure: bound the memory held by unwritten events.
+    while (queued_bytes_ > kMaxQueuedBytes && writer_status_.ok() &&
+           !shutdown_) {
+      work_cv_.notify_one();
+      drained_cv_.wait(ml);
+    }
+    queued_bytes_ += event->ByteSizeLong();
     queue_.emplace_back(std::move(event));
     if (queue_.size() > max_queue_ ||
         env_->NowMicros() - last_flush_ > 1000 * flush_millis_) {
-      return InternalFlush();
+      work_cv_.notify_one();
     }
-    return absl::OkStatus();
+    return writer_status_;
   }
 
   string DebugString() const override { return "SummaryFileWriter"; }
@@ -167,15 +206,54 @@ class SummaryFileWriter : public SummaryWriterInterface {
     return static_cast<double>(env_->NowMicros()) / 1.0e6;
   }
 
-  Status InternalFlush() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
-    for (const std::unique_ptr<Event>& e : queue_) {
-      events_writer_->WriteEvent(*e);
+  void RunWriterLoop() {
+    while (true) {
+      std::deque<std::unique_ptr<Event>> pending;
+      {
+        mutex_lock ml(mu_);
+        // Sleep until there is a batch worth writing, a flush deadline or
+        // request, or shutdown. A partially filled queue is left to
+        // accumulate until the flush interval elapses.
+        while (!shutdown_ && !flush_requested_ &&
+               queue_.size() <= max_queue_ &&
+               queued_bytes_ <= kMaxQueuedBytes &&
+               (queue_.empty() ||
+                env_->NowMicros() - last_flush_ <= 1000 * flush_millis_)) {
+          if (queue_.empty()) {
+            work_cv_.wait(ml);
+          } else {
+            WaitForMilliseconds(&ml, &work_cv_, flush_millis_);
+          }
+        }
+        if (shutdown_ && queue_.empty() && !flush_requested_) {
+          return;
+        }
+        pending.swap(queue_);
+        queued_bytes_ = 0;
+        writer_busy_ = true;
+      }
+      // Serialization and file IO run without the lock so producers can
+      // keep enqueueing.
+      for (const std::unique_ptr<Event>& e : pending) {
+        events_writer_->WriteEvent(*e);
+      }
+      Status s = events_writer_->Flush();
+      {
+        mutex_lock ml(mu_);
+        writer_busy_ = false;
+        // Events enqueued while the batch was being written still need a
+        // flush, so the request is only retired once the queue is empty.
+        if (queue_.empty()) {
+          flush_requested_ = false;
+        }
+        if (writer_status_.ok() && !s.ok()) {
+          writer_status_ = errors::CreateWithUpdatedMessage(
+              s, absl::StrCat("Could not flush events file. ", s.message()));
+        }
+        last_flush_ = env_->NowMicros();
+        drained_cv_.notify_all();
+      }
     }
-    queue_.clear();
-    TF_RETURN_WITH_CONTEXT_IF_ERROR(events_writer_->Flush(),
-                                    "Could not flush events file.");
-    last_flush_ = env_->NowMicros();
-    return absl::OkStatus();
   }
 
   bool is_initialized_;
@@ -184,9 +262,21 @@ class SummaryFileWriter : public SummaryWriterInterface {
   uint64 last_flush_;
   Env* env_;
   mutex mu_;
-  std::vector<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
-  // A pointer to allow deferred construction.
-  std::unique_ptr<EventsWriter> events_writer_ TF_GUARDED_BY(mu_);
+  // Wakes the writer thread when work or shutdown is pending.
+  condition_variable work_cv_;
+  // Wakes producers and Flush() after the writer thread drains the queue.
+  condition_variable drained_cv_;
+  std::deque<std::unique_ptr<Event>> queue_ TF_GUARDED_BY(mu_);
+  uint64 queued_bytes_ TF_GUARDED_BY(mu_);
+  bool flush_requested_ TF_GUARDED_BY(mu_);
+  bool writer_busy_ TF_GUARDED_BY(mu_);
+  bool shutdown_ TF_GUARDED_BY(mu_);
+  // First error hit by the writer thread; sticky once set.
+  Status writer_status_ TF_GUARDED_BY(mu_);
+  // A pointer to allow deferred construction. Only touched by the writer
+  // thread once Initialize() has returned.
+  std::unique_ptr<EventsWriter> events_writer_;
+  std::unique_ptr<Thread> background_thread_;
   std::vector<std::pair<string, SummaryMetadata>> registered_summaries_
       TF_GUARDED_BY(mu_);
 };
@@ -28,11 +28,13 @@ namespace tensorflow {
 /// makes this summary writer suitable for file systems like GCS.
 ///
 /// It will enqueue up to max_queue summaries, and flush at least every
-/// flush_millis milliseconds. The summaries will be written to the
-/// directory specified by logdir and with the filename suffixed by
-/// filename_suffix. The caller owns a reference to result if the
-/// returned status is ok. The Env object must not be destroyed until
-/// after the returned writer.
+/// flush_millis milliseconds. Serialization and file IO happen on a
+/// background thread, so the write methods only enqueue; Flush() blocks
+/// until every queued event has reached the file. The summaries will be
+/// written to the directory specified by logdir and with the filename
+/// suffixed by filename_suffix. The caller owns a reference to result
+/// if the returned status is ok. The Env object must not be destroyed
+/// until after the returned writer.
 Status CreateSummaryFileWriter(int max_queue, int flush_millis,
                                const string& logdir,
                                const string& filename_suffix, Env* env,
@@ -15,6 +15,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTION_OPTIONS_H_
 #define TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTION_OPTIONS_H_
 
+#include <cstdint>
 #include <functional>
 #include <optional>
 #include <ostream>
@@ -100,6 +101,29 @@ struct GraphExecutionOptions {
 
   CostAnalysisOptions cost_analysis_options;
 
+  // Options for caching executables specialized to the concrete input shapes
+  // of frequently seen requests, e.g. the sequence-length buckets used in
+  // serving. Hot shapes are compiled with static input shapes, so shape
+  // inference can resolve shapes at compile time, while rare shapes keep
+  // using the dynamic-shape executable.
+  struct InputShapeSpecializationOptions {
+    // If true, `GraphExecutor::Run` maintains shape-specialized executables
+    // in addition to the dynamic-shape ones.
+    bool enable = false;
+
+    // Number of times an input-shape signature must be seen before a
+    // specialized executable is compiled for it. Shapes seen fewer times run
+    // the dynamic-shape executable.
+    int64_t specialization_trigger = 2;
+
+    // Maximum number of shape-specialized executables kept at a time. The
+    // least recently used specialization is evicted beyond this limit.
+    // Dynamic-shape executables are never evicted.
+    int64_t max_specialized_graphs = 16;
+  };
+
+  InputShapeSpecializationOptions input_shape_specialization_options;
+
   // If true, the MLRT interpreter will be used instead of the BEF executor.
   // This option is experimental.
   bool enable_mlrt = false;
@@ -560,6 +560,25 @@ void CreateSortedNamesAndOriginalIndices(absl::Span<const std::string> names,
   }
 }
 
+// Returns the signature of the concrete input shapes in the order of
+// `input_tensor_names`, e.g. "8x128;8x128x768". It is used as part of the
+// cache key for shape-specialized executables.
+std::string GetInputShapeSignature(
+    absl::Span<const std::string> input_tensor_names,
+    absl::Span<const std::pair<std::string, tensorflow::Tensor>> inputs) {
+  std::vector<std::string> shapes;
+  shapes.reserve(input_tensor_names.size());
+  for (const auto& input_name : input_tensor_names) {
+    for (const auto& [name, tensor] : inputs) {
+      if (name == input_name) {
+        shapes.push_back(absl::StrJoin(tensor.shape().dim_sizes(), "x"));
+        break;
+      }
+    }
+  }
+  return absl::StrJoin(shapes, ";");
+}
+
 }  // namespace
 
 tensorflow::Status GraphExecutor::Run(
@@ -599,13 +618,15 @@ tensorflow::Status GraphExecutor::Run(
                                                     target_tensor_names.end());
   std::sort(sorted_target_node_names.begin(), sorted_target_node_names.end());
 
-  // Load the client graph.
+  // Load the client graph. The `shared_ptr` keeps the graph alive for the
+  // duration of this request even if it is evicted from the cache.
   TF_ASSIGN_OR_RETURN(
-      LoadedClientGraph & loaded_client_graph,
+      std::shared_ptr<LoadedClientGraph> loaded_client_graph_ptr,
       GetOrCreateLoadedClientGraph(
           run_options, sorted_input_names, sorted_input_dtypes,
           sorted_output_names, sorted_target_node_names, run_options.work_queue,
           /*graph_name=*/{}, inputs));
+  LoadedClientGraph& loaded_client_graph = *loaded_client_graph_ptr;
 
   // Get a shared_ptr of the executable so that during the current request the
   // executable to use is guaranteed to be alive.
@@ -928,7 +949,7 @@ tensorflow::Status GraphExecutor::InitBytecode(
   return absl::OkStatus();
 }
 
-absl::StatusOr<std::reference_wrapper<GraphExecutor::LoadedClientGraph>>
+absl::StatusOr<std::shared_ptr<GraphExecutor::LoadedClientGraph>>
 GraphExecutor::GetOrCreateLoadedClientGraph(
     const RunOptions& run_options,
     absl::Span<const std::string> input_tensor_names,
@@ -953,15 +974,43 @@ GraphExecutor::GetOrCreateLoadedClientGraph(
 
   tensorflow::mutex_lock l(loaded_client_graphs_mu_);
 
+  const auto& specialization_options =
+      options_.input_shape_specialization_options;
+  std::string cache_key = joined_name;
+  bool specialize_shapes = false;
+  if (specialization_options.enable && graph_name.empty() &&
+      !inputs.empty() && inputs.size() == input_tensor_names.size()) {
+    const std::string specialized_key =
+        absl::StrCat(joined_name, kArgumentTypeJoiningDelimiter,
+                     GetInputShapeSignature(input_tensor_names, inputs));
+    auto& state = shape_specialization_state_;
+    if (const auto iter = loaded_client_graphs_.find(specialized_key);
+        iter != loaded_client_graphs_.end()) {
+      // Hot path: this shape signature already has a specialized executable.
+      const auto lru_iter = state.lru_index.find(specialized_key);
+      DCHECK(lru_iter != state.lru_index.end());
+      state.lru_list.splice(state.lru_list.begin(), state.lru_list,
+                            lru_iter->second);
+      return iter->second;
+    }
+    if (++state.signature_counts[specialized_key] >=
+        specialization_options.specialization_trigger) {
+      // The shape signature is hot enough; compile a specialized executable
+      // below. Rare shapes fall through to the dynamic-shape executable.
+      specialize_shapes = true;
+      cache_key = specialized_key;
+    }
+  }
+
   // Cache hit; return immediately.
-  const auto iter = loaded_client_graphs_.find(joined_name);
-  if (iter != loaded_client_graphs_.end()) return {*iter->second};
+  const auto iter = loaded_client_graphs_.find(cache_key);
+  if (iter != loaded_client_graphs_.end()) return iter->second;
 
   if (run_options.disable_compilation) {
     return tensorflow::errors::InvalidArgument(
         absl::StrCat("GraphExecutor: compilation is disabled in execution but "
                      "the compiled graph is not found for ",
-                     joined_name));
+                     cache_key));
   }
 
   // Cache miss; populate a `ClientGraph` and load it.
@@ -973,11 +1022,22 @@ GraphExecutor::GetOrCreateLoadedClientGraph(
 
     tensorflow::ArrayInfo array_info;
     array_info.imported_dtype = input_dtype;
-    array_info.shape.set_unknown_rank(true);
+    if (specialize_shapes) {
+      // Import with the concrete input shapes, so that shape inference can
+      // statically resolve shapes in the specialized executable.
+      for (const auto& [name, tensor] : inputs) {
+        if (name == input_name) {
+          tensor.shape().AsProto(&array_info.shape);
+          break;
+        }
+      }
+    } else {
+      array_info.shape.set_unknown_rank(true);
+    }
     input_nodes[input_name] = array_info;
   }
   ClientGraph client_graph{
-      run_options.name.empty() ? joined_name : run_options.name,
+      run_options.name.empty() ? cache_key : run_options.name,
       std::move(input_nodes),
       {output_tensor_names.begin(), output_tensor_names.end()},
       {target_tensor_names.begin(), target_tensor_names.end()}};
@@ -985,9 +1045,27 @@ GraphExecutor::GetOrCreateLoadedClientGraph(
                       LoadClientGraph(client_graph, work_queue, inputs));
 
   // Store the new loaded client graph in cache and return.
-  auto* loaded_client_graph_ptr = loaded_client_graph.get();
-  loaded_client_graphs_[joined_name] = std::move(loaded_client_graph);
-  return {*loaded_client_graph_ptr};
+  std::shared_ptr<LoadedClientGraph> loaded_client_graph_ptr =
+      std::move(loaded_client_graph);
+  loaded_client_graphs_[cache_key] = loaded_client_graph_ptr;
+  if (specialize_shapes) {
+    auto& state = shape_specialization_state_;
+    state.signature_counts.erase(cache_key);
+    state.lru_list.push_front(cache_key);
+    state.lru_index[cache_key] = state.lru_list.begin();
+    // Evict the least recently used specializations beyond the limit.
+    // Dynamic-shape executables are not in the LRU list and are never
+    // evicted; in-flight requests keep evicted entries alive through the
+    // returned `shared_ptr`.
+    while (state.lru_list.size() > static_cast<size_t>(
+               specialization_options.max_specialized_graphs)) {
+      const std::string& evicted_key = state.lru_list.back();
+      loaded_client_graphs_.erase(evicted_key);
+      state.lru_index.erase(evicted_key);
+      state.lru_list.pop_back();
+    }
+  }
+  return loaded_client_graph_ptr;
 }
 
 tensorflow::Status GraphExecutor::RunWithSyncInterpreter(
@@ -998,12 +1076,13 @@ tensorflow::Status GraphExecutor::RunWithSyncInterpreter(
     absl::Span<const std::string> target_tensor_names,
     absl::Span<mlrt::Value> outputs) {
   TF_ASSIGN_OR_RETURN(
-      LoadedClientGraph & loaded_client_graph,
+      std::shared_ptr<LoadedClientGraph> loaded_client_graph_ptr,
       GetOrCreateLoadedClientGraph(
           /*run_options=*/{}, input_names, input_dtypes, output_tensor_names,
           target_tensor_names,
           /*work_queue=*/nullptr,
           graph_name.empty() ? output_tensor_names[0] : graph_name));
+  LoadedClientGraph& loaded_client_graph = *loaded_client_graph_ptr;
 
   // Get a shared_ptr of the executable so that during the current request the
   // executable to use is guaranteed to be alive.
@@ -16,6 +16,7 @@ limitations under the License.
 #define TENSORFLOW_CORE_TFRT_GRAPH_EXECUTOR_GRAPH_EXECUTOR_H_
 
 #include <functional>
+#include <list>
 #include <memory>
 #include <optional>
 #include <string>
@@ -344,8 +345,11 @@ class GraphExecutor {
   tensorflow::Status InitBytecode(LoadedClientGraph* loaded_graph);
 
   // Returns a `LoadedClientGraph` given input/output tensor info. If there is
-  // no existing one yet, creates one first.
-  absl::StatusOr<std::reference_wrapper<GraphExecutor::LoadedClientGraph>>
+  // no existing one yet, creates one first. If input shape specialization is
+  // enabled and the input shapes form a hot signature, the returned graph is
+  // compiled with the concrete input shapes; the returned `shared_ptr` keeps
+  // it alive even if it is evicted from the cache during the request.
+  absl::StatusOr<std::shared_ptr<GraphExecutor::LoadedClientGraph>>
   GetOrCreateLoadedClientGraph(
       const RunOptions& run_options,
       absl::Span<const std::string> input_tensor_names,
@@ -366,13 +370,31 @@ class GraphExecutor {
   tfrt::RequestDeadlineTracker req_deadline_tracker_;
 
   tensorflow::mutex loaded_client_graphs_mu_;
-  // Caches `LoadedClientGraph` by the joined name.
-  // For pointer stability of values in `absl::flat_hash_map<>`, additional
-  // `std::unique_ptr<>` is necessary. (See https://abseil.io/tips/136.)
+  // Caches `LoadedClientGraph` by the joined name (plus the input shape
+  // signature for shape-specialized entries).
+  // `std::shared_ptr<>` provides pointer stability of values in
+  // `absl::flat_hash_map<>` (see https://abseil.io/tips/136), and keeps
+  // in-flight requests working on a specialized graph that is concurrently
+  // evicted by `max_specialized_graphs`.
   absl::flat_hash_map<std::string /*joined_name*/,
-                      std::unique_ptr<LoadedClientGraph>>
+                      std::shared_ptr<LoadedClientGraph>>
       loaded_client_graphs_ TF_GUARDED_BY(loaded_client_graphs_mu_);
 
+  // Bookkeeping for input-shape-specialized entries in
+  // `loaded_client_graphs_`. See
+  // `GraphExecutionOptions::InputShapeSpecializationOptions`.
+  struct ShapeSpecializationState {
+    // Times each specialized cache key has been requested, tracked until its
+    // specialized executable is compiled.
+    absl::flat_hash_map<std::string, int64_t> signature_counts;
+    // Specialized cache keys in LRU order; most recently used first.
+    std::list<std::string> lru_list;
+    absl::flat_hash_map<std::string, std::list<std::string>::iterator>
+        lru_index;
+  };
+  ShapeSpecializationState shape_specialization_state_
+      TF_GUARDED_BY(loaded_client_graphs_mu_);
+
   std::unique_ptr<mlrt::KernelRegistry> kernel_registry_;
 
   std::unique_ptr<tfrt::ResourceContext> resource_context_;
@@ -51,6 +51,21 @@ LoadedExecutable::LoadedExecutable(bc::Executable executable,
   for (auto function : executable_.functions()) {
     functions_[function.name().Get()] = function;
   }
+
+  // Resolve the kernel implementation for every instruction site up front, so
+  // the interpreter loop dispatches through a flat array of function pointers
+  // instead of decoding the kernel code and indexing `kernels_` per
+  // instruction.
+  dispatch_tables_.reserve(executable_.functions().size());
+  for (auto function : executable_.functions()) {
+    auto& dispatch_table = dispatch_tables_[function.name().Get()];
+    auto function_kernels = function.kernels();
+    dispatch_table.reserve(function_kernels.size());
+    for (auto kernel : function_kernels) {
+      DCHECK_LT(kernel.code(), kernels_.size());
+      dispatch_table.push_back(kernels_[kernel.code()]);
+    }
+  }
 }
 
 }  // namespace mlrt
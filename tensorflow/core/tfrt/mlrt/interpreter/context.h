@@ -91,6 +91,20 @@ class LoadedExecutable {
     return nullptr;
   }
 
+  // Returns the dispatch table for `function`: the kernel implementation for
+  // each kernel in program order. The targets are resolved once at load time,
+  // so the interpreter loop can dispatch through a flat array of function
+  // pointers instead of re-resolving the kernel code at every instruction.
+  absl::Span<const KernelImplementation> GetDispatchTable(
+      bc::Function function) const {
+    if (auto iter = dispatch_tables_.find(function.name().Get());
+        iter != dispatch_tables_.end()) {
+      return iter->second;
+    }
+
+    return {};
+  }
+
   bc::Executable executable() const { return executable_; }
 
  private:
@@ -98,6 +112,8 @@ class LoadedExecutable {
 
   absl::flat_hash_map<std::string, bc::Function> functions_;
   std::vector<KernelImplementation> kernels_;
+  absl::flat_hash_map<std::string, std::vector<KernelImplementation>>
+      dispatch_tables_;
 };
 
 // A helper structure that holds states for a kernel. Typical usuage is that a
@@ -118,13 +134,9 @@ void UnwindOnError(ExecutionContext& context, int64_t pc);
 
 class FunctionContext {
  public:
-  FunctionContext(bc::Function function, ExecutionContext* execution_context)
-      : pc_(0),
-        registers_(function.num_regs()),
-        function_object_(function),
-        execution_context_(execution_context) {
-    DCHECK(execution_context);
-  }
+  // Defined after ExecutionContext because it resolves the function's dispatch
+  // table through the loaded executable.
+  FunctionContext(bc::Function function, ExecutionContext* execution_context);
 
   FunctionContext(const FunctionContext&) = delete;
   FunctionContext& operator=(const FunctionContext&) = delete;
@@ -135,6 +147,12 @@ class FunctionContext {
 
   const bc::Function& function_object() const { return function_object_; }
 
+  // The function's kernel implementations in program order, resolved at load
+  // time.
+  absl::Span<const KernelImplementation> dispatch_table() const {
+    return dispatch_table_;
+  }
+
   absl::Span<Value> regs() { return absl::MakeSpan(registers_); }
 
   // Argument passing is via either copy or move.
@@ -207,6 +225,7 @@ class FunctionContext {
   std::vector<Value> registers_;
   std::vector<Value*> results_;
   bc::Function function_object_;
+  absl::Span<const KernelImplementation> dispatch_table_;
   KernelContext kernel_context_;
 
   ExecutionContext* execution_context_ = nullptr;
@@ -584,6 +603,17 @@ class KernelFrame {
   friend void Execute(ExecutionContext& context);
 };
 
+inline FunctionContext::FunctionContext(bc::Function function,
+                                        ExecutionContext* execution_context)
+    : pc_(0),
+      registers_(function.num_regs()),
+      function_object_(function),
+      execution_context_(execution_context) {
+  DCHECK(execution_context);
+  dispatch_table_ =
+      execution_context->loaded_executable().GetDispatchTable(function);
+}
+
 template <typename KernelClass>
 inline void KernelRegistry::Register(absl::string_view name) {
   Register(
@@ -91,7 +91,14 @@ void Execute(ExecutionContext& ctx) {
     FunctionContext* current_function = &context.function_stack_.back();
     int64_t pc = current_function->pc_;
 
-    auto kernels = context.loaded_executable().kernels();
+    // The kernel target of every instruction site was resolved at load time,
+    // so dispatch walks a flat array of function pointers in lockstep with the
+    // bytecode instead of decoding the kernel code and indexing the kernel
+    // table per instruction.
+    auto dispatch_table = current_function->dispatch_table();
+    DCHECK_EQ(dispatch_table.size(),
+              current_function->function_object().kernels().size());
+    const KernelImplementation* dispatch_iter = dispatch_table.data() + pc;
 
     auto kernel_object_iter =
         current_function->function_object().kernels().begin();
@@ -106,9 +113,9 @@ void Execute(ExecutionContext& ctx) {
     for (; context.state_ == ExecutionContext::State::kRunning; ++pc) {
       DCHECK(kernel_object_iter <
              current_function->function_object().kernels().end());
-      bc::Kernel kernel_object = *kernel_object_iter;
-      frame.set_kernel(kernel_object);
-      kernels[kernel_object.code()](frame);
+      frame.set_kernel(*kernel_object_iter);
+      (*dispatch_iter)(frame);
+      ++dispatch_iter;
       ++kernel_object_iter;
     }
 
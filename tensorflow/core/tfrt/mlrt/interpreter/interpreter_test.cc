@@ -202,6 +202,30 @@ TEST(InterpreterTest, SequentialAdd) {
   EXPECT_EQ(result.Get<int32_t>(), 100);
 }
 
+TEST(InterpreterTest, DispatchTableResolvesKernelTargets) {
+  auto buffer = CreateSequentialAddExecutable(2);
+
+  bc::Executable executable(buffer.data());
+
+  KernelRegistry kernel_registry;
+  RegisterBuiltinKernels(kernel_registry);
+  kernel_registry.Register<AddI32Kernel>();
+
+  LoadedExecutable loaded_executable(executable, kernel_registry);
+
+  auto function = loaded_executable.GetFunction("main");
+  ASSERT_TRUE(function);
+
+  // Every instruction site has its kernel target resolved at load time.
+  auto dispatch_table = loaded_executable.GetDispatchTable(function);
+  auto function_kernels = function.kernels();
+  ASSERT_EQ(dispatch_table.size(), function_kernels.size());
+  auto kernels = loaded_executable.kernels();
+  for (size_t i = 0; i < dispatch_table.size(); ++i) {
+    EXPECT_EQ(dispatch_table[i], kernels[function_kernels[i].code()]);
+  }
+}
+
 TEST(InterpreterTest, SequentialAddAttributes) {
   auto buffer = CreateSequentialAddAttributesExecutable(99);
 
@@ -27,6 +27,7 @@ limitations under the License.
 
 #include "unsupported/Eigen/CXX11/Tensor"  // from @eigen_archive
 #include "tensorflow/core/lib/core/threadpool_interface.h"
+#include "tensorflow/core/lib/monitoring/gauge.h"
 #include "tensorflow/core/lib/strings/strcat.h"
 #include "tensorflow/core/platform/context.h"
 #include "tensorflow/core/platform/denormal.h"
@@ -48,6 +49,12 @@ namespace {
 typedef typename internal::RunHandlerEnvironment::Task Task;
 typedef Eigen::RunQueue<Task, 1024> Queue;
 
+auto* run_handler_target_concurrency =
+    tensorflow::monitoring::Gauge<int64_t, 0>::New(
+        "/tfrt/run_handler_pool/adaptive_target_handlers",
+        "Target number of concurrently admitted run handlers chosen by the "
+        "adaptive handler concurrency controller.");
+
 }  // namespace
 
 namespace internal {
@@ -721,6 +728,12 @@ class RunHandlerPool::Impl {
  public:
   explicit Impl(Options options)
       : max_handlers_(options.max_concurrent_handler),
+        adaptive_concurrency_enabled_(
+            options.enable_adaptive_handler_concurrency),
+        min_handlers_(std::min(std::max(options.min_concurrent_handler, 1),
+                               options.max_concurrent_handler)),
+        adaptive_sizing_interval_(std::max(options.adaptive_sizing_interval, 1)),
+        target_handlers_(options.max_concurrent_handler),
         waiters_mu_(options.num_sub_thread_pool),
         queue_waiters_(options.num_sub_thread_pool),
         run_handler_thread_pool_(new internal::RunHandlerThreadPool(
@@ -741,6 +754,7 @@ class RunHandlerPool::Impl {
         sub_thread_pool_end_request_percentage_(
             options.sub_thread_request_percentage) {
     VLOG(1) << "Creating a RunHandlerPool with max handlers: " << max_handlers_;
+    run_handler_target_concurrency->GetCell()->Set(target_handlers_);
     free_handlers_.reserve(max_handlers_);
     handlers_.reserve(max_handlers_);
     for (int i = 0; i < max_handlers_; ++i) {
@@ -776,6 +790,15 @@ class RunHandlerPool::Impl {
     return !free_handlers_.empty();
   }
 
+  // Returns true if Get() may hand out another handler. In addition to an
+  // inactive handler being available, the adaptive controller may cap the
+  // number of concurrently admitted handlers below max_handlers_.
+  bool can_admit_handler() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_) {
+    return has_free_handler() &&
+           sorted_active_handlers_.size() < static_cast<size_t>(
+                                                target_handlers_);
+  }
+
   std::unique_ptr<RunHandler> Get(int64_t step_id, int64_t timeout_in_ms,
                                   const RunHandlerOptions& options)
       TF_LOCKS_EXCLUDED(mu_) {
@@ -788,21 +811,24 @@ class RunHandlerPool::Impl {
     RunHandler::Impl* handler_impl;
     {
       tensorflow::mutex_lock l(mu_);
-      if (!has_free_handler()) {
+      if (!can_admit_handler()) {
         tsl::profiler::TraceMe activity(
             [step_id] {
               return tsl::profiler::TraceMeEncode("WaitingForHandler",
                                                   {{"step_id", step_id}});
             },
             tsl::profiler::TraceMeLevel::kInfo);
+        const uint64_t wait_start_us = tensorflow::EnvTime::NowMicros();
         if (timeout_in_ms == 0) {
-          mu_.Await(tensorflow::Condition(this, &Impl::has_free_handler));
+          mu_.Await(tensorflow::Condition(this, &Impl::can_admit_handler));
         } else if (!mu_.AwaitWithDeadline(
-                       tensorflow::Condition(this, &Impl::has_free_handler),
+                       tensorflow::Condition(this, &Impl::can_admit_handler),
                        tensorflow::EnvTime::NowNanos() +
                            timeout_in_ms * 1000 * 1000)) {
           return nullptr;
         }
+        interval_wait_micros_ +=
+            tensorflow::EnvTime::NowMicros() - wait_start_us;
       }
       // Remove the last entry from free_handlers_ and add to the end of
       // sorted_active_handlers_.
@@ -843,6 +869,16 @@ class RunHandlerPool::Impl {
     double elapsed = (now - handler->start_time_us()) / 1000.0;
     time_hist_.Add(elapsed);
 
+    if (adaptive_concurrency_enabled_) {
+      interval_active_handlers_ += sorted_active_handlers_.size();
+      for (const auto& active_handler : sorted_active_handlers_) {
+        interval_pending_tasks_ += active_handler->tws()->GetPendingTaskCount();
+      }
+      if (++interval_releases_ >= adaptive_sizing_interval_) {
+        MaybeAdjustTargetConcurrency();
+      }
+    }
+
     // Erase from and update sorted_active_handlers_. Add it to the end of
     // free_handlers_.
     auto iter = std::find(sorted_active_handlers_.begin(),
@@ -881,6 +917,14 @@ class RunHandlerPool::Impl {
     return ret;
   }
 
+  AdaptiveConcurrencyState GetAdaptiveConcurrencyState()
+      TF_LOCKS_EXCLUDED(mu_) {
+    tensorflow::mutex_lock l(mu_);
+    AdaptiveConcurrencyState state = controller_state_;
+    state.target_concurrent_handlers = target_handlers_;
+    return state;
+  }
+
   void Quiesce() TF_LOCKS_EXCLUDED(mu_) {
     while (true) {
       {
@@ -910,12 +954,36 @@ class RunHandlerPool::Impl {
 
   void LogInfo() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
 
+  // Recomputes the adaptive handler concurrency target from the signals
+  // accumulated over the last sizing interval and resets the accumulators.
+  void MaybeAdjustTargetConcurrency() TF_EXCLUSIVE_LOCKS_REQUIRED(mu_);
+
   // Maximum number of handlers pre-created during pool construction time. The
   // number has been chosen expecting each handler might at least want 1
   // inter-op thread for execution (during compute intensive workloads like
   // inference).
   const int max_handlers_;
 
+  // Configuration of the adaptive handler concurrency controller (see
+  // Options::enable_adaptive_handler_concurrency).
+  const bool adaptive_concurrency_enabled_;
+  const int min_handlers_;
+  const int adaptive_sizing_interval_;
+
+  // Number of handlers Get() may admit concurrently. Stays at max_handlers_
+  // unless the adaptive controller is enabled.
+  int target_handlers_ TF_GUARDED_BY(mu_);
+
+  // Signals accumulated over the current sizing interval.
+  int interval_releases_ TF_GUARDED_BY(mu_) = 0;
+  uint64_t interval_wait_micros_ TF_GUARDED_BY(mu_) = 0;
+  int64_t interval_active_handlers_ TF_GUARDED_BY(mu_) = 0;
+  int64_t interval_pending_tasks_ TF_GUARDED_BY(mu_) = 0;
+
+  // Averages over the last completed sizing interval and the adjustment
+  // count; target_concurrent_handlers is filled in at snapshot time.
+  AdaptiveConcurrencyState controller_state_ TF_GUARDED_BY(mu_);
+
   Eigen::MaxSizeVector<tensorflow::mutex> waiters_mu_;
   Eigen::MaxSizeVector<internal::Waiter> queue_waiters_;
 
@@ -968,6 +1036,47 @@ void RunHandlerPool::Impl::RecomputePoolStats(
   }
 }
 
+void RunHandlerPool::Impl::MaybeAdjustTargetConcurrency() {
+  const double releases = interval_releases_;
+  const double average_wait_micros = interval_wait_micros_ / releases;
+  const double average_active = interval_active_handlers_ / releases;
+  const double average_pending = interval_pending_tasks_ / releases;
+
+  // Pending tasks per blocking thread approximates how oversubscribed the
+  // pool's threads are, while handler wait time measures steps queueing for
+  // admission.
+  const int num_blocking_threads =
+      std::max(run_handler_thread_pool()->NumBlockingThreads(), 1);
+  const double pending_per_thread = average_pending / num_blocking_threads;
+
+  int target = target_handlers_;
+  if (pending_per_thread > 1.0) {
+    // Threads are oversubscribed. Admitting fewer steps at a time reduces
+    // cross-step queueing without reducing the pool's throughput.
+    --target;
+  } else if (average_wait_micros > 0 && pending_per_thread < 0.5) {
+    // Steps are queueing for handlers while threads have spare capacity.
+    ++target;
+  }
+  target = std::min(std::max(target, min_handlers_), max_handlers_);
+  if (target != target_handlers_) {
+    target_handlers_ = target;
+    ++controller_state_.num_adjustments;
+    run_handler_target_concurrency->GetCell()->Set(target);
+    VLOG(1) << "Adjusted run handler concurrency target to " << target
+            << " (average handler wait " << average_wait_micros
+            << " us, average active handlers " << average_active
+            << ", average pending tasks " << average_pending << ")";
+  }
+  controller_state_.average_handler_wait_micros = average_wait_micros;
+  controller_state_.average_active_handlers = average_active;
+  controller_state_.average_pending_tasks = average_pending;
+  interval_releases_ = 0;
+  interval_wait_micros_ = 0;
+  interval_active_handlers_ = 0;
+  interval_pending_tasks_ = 0;
+}
+
 void RunHandlerPool::Impl::LogInfo() {
   if (iterations_++ % 50000 == 10 && VLOG_IS_ON(1)) {
     int num_active_requests = sorted_active_handlers_.size();
@@ -1040,6 +1149,11 @@ std::vector<int64_t> RunHandlerPool::GetActiveHandlerPrioritiesForTesting()
   return impl_->GetActiveHandlerPrioritiesForTesting();
 }
 
+RunHandlerPool::AdaptiveConcurrencyState
+RunHandlerPool::GetAdaptiveConcurrencyState() const {
+  return impl_->GetAdaptiveConcurrencyState();
+}
+
 void RunHandlerPool::Quiesce() const { impl_->Quiesce(); }
 
 RunHandler::RunHandler(Impl* impl) : impl_(impl) {}
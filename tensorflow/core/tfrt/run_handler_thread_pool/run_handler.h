@@ -18,6 +18,7 @@ limitations under the License.
 
 #include <atomic>
 #include <cstddef>
+#include <cstdint>
 #include <functional>
 #include <memory>
 #include <optional>
@@ -108,6 +109,38 @@ class RunHandlerPool {
 
     // If true, threads will be waken up by new tasks.
     bool enable_wake_up = true;
+
+    // If true, the pool adapts the number of concurrently admitted handlers
+    // between min_concurrent_handler and max_concurrent_handler based on
+    // measured per-step queueing and execution concurrency. Handlers above
+    // the adaptive target stay pooled and Get() blocks as if the pool were
+    // exhausted.
+    bool enable_adaptive_handler_concurrency = false;
+
+    // Lower bound for the adaptive handler concurrency target. Only used if
+    // enable_adaptive_handler_concurrency is true.
+    int min_concurrent_handler = 1;
+
+    // The number of handler releases between consecutive adaptive sizing
+    // decisions. Only used if enable_adaptive_handler_concurrency is true.
+    int adaptive_sizing_interval = 64;
+  };
+
+  // Snapshot of the adaptive handler concurrency controller. All averages are
+  // over the last completed sizing interval.
+  struct AdaptiveConcurrencyState {
+    // Current number of handlers Get() may admit concurrently. Equals
+    // Options::max_concurrent_handler when adaptation is disabled.
+    int target_concurrent_handlers = 0;
+    // Average time (in microseconds) a step spent waiting for a handler.
+    double average_handler_wait_micros = 0;
+    // Average number of active handlers observed at handler release time.
+    double average_active_handlers = 0;
+    // Average number of pending inter/intra tasks across active handlers
+    // observed at handler release time.
+    double average_pending_tasks = 0;
+    // Total number of target adjustments made since pool construction.
+    int64_t num_adjustments = 0;
   };
   explicit RunHandlerPool(Options options);
   ~RunHandlerPool();
@@ -128,6 +161,9 @@ class RunHandlerPool {
   // order of the active handler list.
   std::vector<int64_t> GetActiveHandlerPrioritiesForTesting() const;
 
+  // Returns the current state of the adaptive handler concurrency controller.
+  AdaptiveConcurrencyState GetAdaptiveConcurrencyState() const;
+
   // Block until the system is quiescent (no pending work and no inflight work).
   void Quiesce() const;
 
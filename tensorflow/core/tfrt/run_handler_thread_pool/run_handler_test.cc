@@ -137,6 +137,41 @@ TEST(RunHandlerUtilTest, IntraOpThreadPool) {
   notification.WaitForNotification();
 }
 
+TEST(RunHandlerUtilTest, AdaptiveHandlerConcurrency) {
+  int num_threads = 2;
+  RunHandlerPool::Options pool_options;
+  pool_options.num_intra_op_threads = num_threads;
+  pool_options.num_inter_op_threads = num_threads;
+  pool_options.num_threads_in_sub_thread_pool = {2};
+  pool_options.max_concurrent_handler = 4;
+  pool_options.enable_adaptive_handler_concurrency = true;
+  pool_options.min_concurrent_handler = 1;
+  pool_options.adaptive_sizing_interval = 1;
+  std::unique_ptr<RunHandlerPool> pool(new RunHandlerPool(pool_options));
+
+  // Before any step finishes, the target is the configured maximum.
+  RunHandlerPool::AdaptiveConcurrencyState state =
+      pool->GetAdaptiveConcurrencyState();
+  EXPECT_EQ(state.target_concurrent_handlers, 4);
+
+  for (int i = 0; i < 8; ++i) {
+    auto handler = pool->Get(/*step_id=*/i);
+    absl::Notification notification;
+    handler->ScheduleInterOpClosure(
+        TaskFunction([&notification]() { notification.Notify(); }));
+    notification.WaitForNotification();
+    handler.reset();
+  }
+
+  // With a sizing interval of one, every release runs the controller; the
+  // target must stay within the configured bounds and the controller must
+  // have observed this test's single-step concurrency.
+  state = pool->GetAdaptiveConcurrencyState();
+  EXPECT_GE(state.target_concurrent_handlers, 1);
+  EXPECT_LE(state.target_concurrent_handlers, 4);
+  EXPECT_GE(state.average_active_handlers, 1.0);
+}
+
 class RunHandlerThreadPoolTest
     : public testing::TestWithParam<std::tuple<bool, bool>> {
  protected:
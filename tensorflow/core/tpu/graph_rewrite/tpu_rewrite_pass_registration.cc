@@ -20,7 +20,7 @@ limitations under the License.
 #include "tensorflow/core/tpu/graph_rewrite/encapsulate_tpu_computations_pass.h"
 #include "tensorflow/core/tpu/graph_rewrite/tpu_embedding_software_deduplication_rewrite_pass.h"
 #include "tensorflow/core/tpu/graph_rewrite/update_tpu_embedding_ops_passes.h"
-#include "tensorflow/core/tpu/graph_rewrite/variable_merger_pass.h"
+#include "tensorflow/core/common_runtime/variable_merger_pass.h"
 
 namespace tensorflow {
 namespace {
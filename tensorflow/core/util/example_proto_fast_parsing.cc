@@ -589,6 +589,16 @@ void LogSparseFeatureDataLoss(StringPiece feature_name) {
   duplicated_sparse_feature->GetCell()->IncrementBy(1);
 }
 
+// Scratch space for FastParseSerializedExample, reused across the examples
+// of a minibatch so that the hot parsing loop does not allocate. Clearing the
+// members keeps their heap capacity for the next example.
+struct ExampleParseScratch {
+  parsed::Example parsed_example;
+  std::vector<int64_t> sparse_feature_last_example;
+  std::vector<int64_t> dense_feature_last_example;
+  std::vector<int64_t> ragged_feature_last_example;
+};
+
 Status FastParseSerializedExample(
     const tstring& serialized_example, const tstring& example_name,
     const size_t example_index, const Config& config,
@@ -597,18 +607,25 @@ Status FastParseSerializedExample(
     std::vector<SparseBuffer>* output_varlen_dense,
     std::vector<SparseBuffer>* output_sparse,
     std::vector<SparseBuffer>* output_ragged,
-    PerExampleFeatureStats* output_stats) {
+    PerExampleFeatureStats* output_stats, ExampleParseScratch* scratch) {
   DCHECK(output_dense != nullptr);
   DCHECK(output_sparse != nullptr);
   DCHECK(output_ragged != nullptr);
-  parsed::Example parsed_example;
+  parsed::Example& parsed_example = scratch->parsed_example;
+  parsed_example.clear();
   if (!ParseExample(serialized_example, &parsed_example)) {
     return errors::InvalidArgument("Could not parse example input, value: '",
                                    serialized_example, "'");
   }
-  std::vector<int64_t> sparse_feature_last_example(config.sparse.size(), -1);
-  std::vector<int64_t> dense_feature_last_example(config.dense.size(), -1);
-  std::vector<int64_t> ragged_feature_last_example(config.ragged.size(), -1);
+  std::vector<int64_t>& sparse_feature_last_example =
+      scratch->sparse_feature_last_example;
+  std::vector<int64_t>& dense_feature_last_example =
+      scratch->dense_feature_last_example;
+  std::vector<int64_t>& ragged_feature_last_example =
+      scratch->ragged_feature_last_example;
+  sparse_feature_last_example.assign(config.sparse.size(), -1);
+  dense_feature_last_example.assign(config.dense.size(), -1);
+  ragged_feature_last_example.assign(config.ragged.size(), -1);
 
   // Handle features present in the example.
   const size_t parsed_example_size = parsed_example.size();
@@ -1237,6 +1254,7 @@ Status FastParseExample(const Config& config,
     ragged_buffers[minibatch].resize(config.ragged.size());
     size_t start = first_example_of_minibatch(minibatch);
     size_t end = first_example_of_minibatch(minibatch + 1);
+    ExampleParseScratch scratch;
     for (size_t e = start; e < end; ++e) {
       PerExampleFeatureStats* stats = nullptr;
       if (config.collect_feature_stats) {
@@ -1247,7 +1265,7 @@ Status FastParseExample(const Config& config,
           (!example_names.empty() ? example_names[e] : "<unknown>"), e, config,
           config_index, hasher, &fixed_dense_values,
           &varlen_dense_buffers[minibatch], &sparse_buffers[minibatch],
-          &ragged_buffers[minibatch], stats);
+          &ragged_buffers[minibatch], stats, &scratch);
       if (!status_of_minibatch[minibatch].ok()) break;
     }
   };
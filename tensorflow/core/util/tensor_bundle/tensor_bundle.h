@@ -106,6 +106,8 @@ extern const int kTensorBundleVersion;
 // corresponding value is a BundleHeaderProto.
 extern const char* const kHeaderEntryKey;
 
+class BundleReader;
+
 // Builds a string-string table of tensor names to BundleEntryProto (metadata).
 //
 // On construction, attempts to create a directory given by the dirname of
@@ -119,6 +121,18 @@ class BundleWriter {
     // Alignment, in bytes, for tensor data.
     // Must be >= 1. The default size of 1 densely packs tensors.
     int data_alignment{1};
+
+    // If nonempty, this bundle may be written as a delta on top of the bundle
+    // at this prefix: AddFromBase() records a reference to the base bundle's
+    // copy of a tensor instead of rewriting its bytes.  Readers resolve such
+    // references through the base bundle, so it must outlive this one.
+    std::string base_prefix;
+
+    // Bounds the read amplification of chained delta bundles.  Once the chain
+    // from the base to its ultimate self-contained bundle is this long,
+    // AddFromBase() copies the tensor bytes forward into this bundle instead
+    // of adding another level of indirection.
+    int max_delta_chain{8};
   };
   BundleWriter(Env* env, absl::string_view prefix,
                const Options& options = Options());
@@ -127,6 +141,16 @@ class BundleWriter {
   // Across calls "key" must be unique but can be added in any order.
   Status Add(absl::string_view key, const Tensor& val);
 
+  // Records that the tensor under key "key" is unchanged since the bundle at
+  // Options::base_prefix, without rewriting its bytes.  Lookups of "key"
+  // through the written bundle read the base bundle's copy.  Once the delta
+  // chain reaches Options::max_delta_chain, the bytes are copied forward
+  // instead (compaction), so reads stay bounded.
+  //
+  // Useful for incremental checkpoints of mostly-unchanged variables.
+  // REQUIRES: Options::base_prefix is nonempty and contains "key".
+  Status AddFromBase(absl::string_view key);
+
   // Partitioned variables support.
   // A slice of a full tensor is stored in two entries in the metadata table:
   //
@@ -153,6 +177,9 @@ class BundleWriter {
   Status status() const { return status_; }
 
  private:
+  // Opens the base bundle on first use of AddFromBase().
+  Status EnsureBaseReader();
+
   Env* const env_;  // Not owned.
   const Options options_;
   const std::string prefix_;
@@ -164,6 +191,12 @@ class BundleWriter {
   std::map<std::string, BundleEntryProto> entries_;
   Status status_;
 
+  // Reader of the base bundle, opened on the first AddFromBase() call.
+  std::unique_ptr<BundleReader> base_reader_;
+  // True iff at least one entry references the base bundle, in which case the
+  // written header records Options::base_prefix.
+  bool wrote_base_reference_ = false;
+
   BundleWriter(const BundleWriter&) = delete;
   void operator=(const BundleWriter&) = delete;
 };
@@ -212,6 +245,23 @@ class BundleReader {
 
     // For tests only.
     bool enable_multi_threading_for_testing = false;
+
+    // If true, restored tensors alias read-only memory mappings of the bundle
+    // data files instead of being copied into freshly allocated buffers.  The
+    // mapped pages are backed by the file system cache, so loading is
+    // proportional to the pages actually touched, and multiple processes
+    // restoring from the same bundle share the clean pages.
+    //
+    // Only tensors whose bytes can be aliased verbatim take this path: fixed
+    // width dtypes (DataTypeCanUseMemcpy), stored at an offset aligned to
+    // Allocator::kAllocatorAlignment (see BundleWriter::Options::data_alignment)
+    // in a bundle of matching endianness.  Other tensors, and bundles on file
+    // systems that do not support memory mapping, fall back to buffered reads.
+    //
+    // Restored tensors aliasing the mapping must be treated as immutable:
+    // writing through them is an error.  The crc32c checksum is not validated
+    // on this path, since that would fault in every page up front.
+    bool use_mmap = false;
   };
   BundleReader(Env* env, absl::string_view prefix, Options options);
 
@@ -250,6 +300,26 @@ class BundleReader {
   Status LookupTensorShape(absl::string_view key,
                            TensorShape* shape) TF_MUST_USE_RESULT;
 
+  // Looks up which data file shard stores the tensor keyed by "key".  Useful
+  // for scheduling reads of different shards concurrently.
+  // REQUIRES: status().ok()
+  Status LookupShardId(absl::string_view key, int* shard_id) TF_MUST_USE_RESULT;
+
+  // Bulk-loads the metadata blocks covering "keys" (ideally sorted) into the
+  // metadata table's block cache, coalescing adjacent block reads into large
+  // sequential IOs and decoding the blocks concurrently.  Subsequent lookups
+  // of the prefetched keys are served from the cache instead of issuing
+  // per-block reads.  A no-op unless a table index cache is configured (see
+  // TF_TABLE_INDEX_CACHE_SIZE_IN_MB).  Callers that know the restore plan up
+  // front should call this once before issuing per-tensor lookups.
+  // REQUIRES: status().ok()
+  Status PrefetchMetadata(absl::Span<const tstring> keys);
+
+  // Number of delta bundles on the chain from this bundle to its ultimate
+  // self-contained base, inclusive of this one.  Zero for ordinary bundles.
+  // REQUIRES: status().ok()
+  int delta_chain_length() const { return delta_chain_length_; }
+
   // Looks up the tensor keyed by "key".  If "key" refers to a partitioned
   // tensor, attempts to look up the full contents using all stored slices.
   //
@@ -322,6 +392,17 @@ class BundleReader {
   Status GetValue(const BundleEntryProto& entry,
                   Tensor* val) TF_MUST_USE_RESULT;
 
+  // Returns the memory mapping of the data file for "shard_id", mapping it on
+  // first use.  Fails if Options::use_mmap is not set or the file system does
+  // not support memory mapping.
+  Status GetMmapRegion(int shard_id,
+                       std::shared_ptr<ReadOnlyMemoryRegion>* region)
+      TF_MUST_USE_RESULT;
+
+  // Opens the base bundle named by the header on first use, for resolving
+  // entries marked "in_base_bundle".
+  Status EnsureBaseReader() TF_MUST_USE_RESULT;
+
   // Reads the slice described by "slice_spec".  The corresponding full tensor
   // has key "ful_tensor_key" and metadata proto "full_tensor_entry".
   // REQUIRES: full_tensor_entry.slices_size() > 0
@@ -344,6 +425,14 @@ class BundleReader {
   // Owned InputBuffer objects. cache_ owns the underlying RandomAccessFiles.
   std::unordered_map<int32_t, io::InputBuffer*> data_;
 
+  // Memory mappings of the data files, keyed by shard id and opened on first
+  // use when Options::use_mmap is set.  Shared with the tensors restored from
+  // them; a mapping is released once the reader and all such tensors are gone.
+  // A null entry records a shard that could not be mapped, so the fallback is
+  // decided once per shard.
+  std::unordered_map<int32_t, std::shared_ptr<ReadOnlyMemoryRegion>>
+      mmap_regions_;
+
   // Maps each partitioned tensor's key to its stored slices (represented in a
   // TensorSliceSet).  Populated on-demand.
   std::unordered_map<std::string, checkpoint::TensorSliceSet*> tensor_slices_;
@@ -356,10 +445,19 @@ class BundleReader {
   // differs from that of the current system's processor architecture.
   bool need_to_swap_bytes_;
 
+  // Delta bundle support, populated from the header.  base_reader_ is opened
+  // lazily on the first lookup of an entry stored in the base bundle.
+  std::string base_prefix_;
+  int delta_chain_length_ = 0;
+  std::unique_ptr<BundleReader> base_reader_;
+
   friend class TensorBundleAlignmentTest;  // For testing data alignment.
 
   bool enable_multi_threading_for_testing_ = false;
 
+  // Whether restored tensors should alias memory mappings of the data files.
+  bool use_mmap_ = false;
+
   BundleReader(const BundleReader&) = delete;
   void operator=(const BundleReader&) = delete;
 };
@@ -24,6 +24,7 @@ limitations under the License.
 #endif  // _WIN32
 
 #include "absl/status/status.h"
+#include "tensorflow/core/framework/allocator.h"
 #include "tensorflow/core/framework/tensor_testutil.h"
 #include "tensorflow/core/framework/tensor_util.h"
 #include "tensorflow/core/framework/types.pb.h"
@@ -917,6 +918,66 @@ TEST(TensorBundleTest, DirectoryStructure) {
                           "merged.data-00001-of-00002"});
 }
 
+TEST(TensorBundleTest, MergeManyBundles) {
+  // Exercises the parallel metadata parse and rename phases of MergeBundles
+  // with more bundles than merge threads.
+  Env* env = Env::Default();
+  constexpr int kNumBundles = 32;
+  std::vector<tstring> prefixes;
+  for (int i = 0; i < kNumBundles; ++i) {
+    prefixes.push_back(Prefix(strings::StrCat("worker", i)));
+    BundleWriter writer(env, prefixes.back());
+    TF_EXPECT_OK(writer.Add(strings::StrCat("tensor_", i),
+                            Constant_2x3<float>(static_cast<float>(i))));
+    TF_ASSERT_OK(writer.Finish());
+  }
+
+  const string kMerged = Prefix("merged_many");
+  TF_ASSERT_OK(MergeBundles(env, prefixes, kMerged));
+
+  BundleReader reader(env, kMerged);
+  TF_ASSERT_OK(reader.status());
+  for (int i = 0; i < kNumBundles; ++i) {
+    Expect<float>(&reader, strings::StrCat("tensor_", i),
+                  Constant_2x3<float>(static_cast<float>(i)));
+  }
+}
+
+TEST(TensorBundleTest, PrefetchMetadata) {
+  Env* env = Env::Default();
+  std::vector<tstring> keys;
+  {
+    BundleWriter writer(env, Prefix("prefetch"));
+    for (int i = 0; i < 100; ++i) {
+      keys.push_back(strings::StrCat("tensor_", i));
+      TF_EXPECT_OK(writer.Add(keys.back(),
+                              Constant_2x3<float>(static_cast<float>(i))));
+    }
+    TF_ASSERT_OK(writer.Finish());
+  }
+
+  {
+    // Without an index cache the prefetch is a no-op.
+    BundleReader reader(env, Prefix("prefetch"));
+    TF_ASSERT_OK(reader.status());
+    TF_ASSERT_OK(reader.PrefetchMetadata(keys));
+  }
+
+  setenv("TF_TABLE_INDEX_CACHE_SIZE_IN_MB", "1", 1 /* overwrite */);
+  {
+    BundleReader reader(env, Prefix("prefetch"));
+    TF_ASSERT_OK(reader.status());
+    TF_ASSERT_OK(reader.PrefetchMetadata(keys));
+    // Prefetching twice is fine: already-cached blocks are skipped.
+    TF_ASSERT_OK(reader.PrefetchMetadata(keys));
+    for (int i = 0; i < 100; ++i) {
+      Expect<float>(&reader, keys[i],
+                    Constant_2x3<float>(static_cast<float>(i)));
+    }
+  }
+  unsetenv("TF_TABLE_INDEX_CACHE_SIZE_IN_MB");
+}
+
 TEST(TensorBundleTest, SortForSequentialAccess) {
   Env* env = Env::Default();
   const std::vector<string> kBundlePrefixes = {Prefix("worker0"),
@@ -1270,6 +1331,121 @@ TEST_F(TensorBundleAlignmentTest, AlignmentTest) {
   }
 }
 
+TEST(TensorBundleTest, DeltaBundle) {
+  {
+    BundleWriter base(Env::Default(), Prefix("base"));
+    TF_EXPECT_OK(base.Add("changed", Constant_2x3<float>(1)));
+    TF_EXPECT_OK(base.Add("unchanged", Constant_2x3<float>(2)));
+    TF_ASSERT_OK(base.Finish());
+  }
+  {
+    BundleWriter::Options opts;
+    opts.base_prefix = Prefix("base");
+    BundleWriter delta(Env::Default(), Prefix("delta"), opts);
+    TF_EXPECT_OK(delta.Add("changed", Constant_2x3<float>(3)));
+    TF_EXPECT_OK(delta.AddFromBase("unchanged"));
+    TF_ASSERT_OK(delta.Finish());
+  }
+  BundleReader reader(Env::Default(), Prefix("delta"));
+  TF_ASSERT_OK(reader.status());
+  EXPECT_EQ(reader.delta_chain_length(), 1);
+  Expect<float>(&reader, "changed", Constant_2x3<float>(3));
+  Expect<float>(&reader, "unchanged", Constant_2x3<float>(2));
+}
+
+TEST(TensorBundleTest, DeltaBundleCompaction) {
+  {
+    BundleWriter base(Env::Default(), Prefix("chain_0"));
+    TF_EXPECT_OK(base.Add("foo", Constant_2x3<float>(0)));
+    TF_ASSERT_OK(base.Finish());
+  }
+  // With max_delta_chain = 1, the second delta must copy the tensor bytes
+  // forward and become self-contained again.
+  for (int i = 1; i <= 2; ++i) {
+    BundleWriter::Options opts;
+    opts.base_prefix = Prefix(strings::StrCat("chain_", i - 1));
+    opts.max_delta_chain = 1;
+    BundleWriter delta(Env::Default(), Prefix(strings::StrCat("chain_", i)),
+                       opts);
+    TF_EXPECT_OK(delta.AddFromBase("foo"));
+    TF_ASSERT_OK(delta.Finish());
+  }
+  BundleReader delta_reader(Env::Default(), Prefix("chain_1"));
+  TF_ASSERT_OK(delta_reader.status());
+  EXPECT_EQ(delta_reader.delta_chain_length(), 1);
+  Expect<float>(&delta_reader, "foo", Constant_2x3<float>(0));
+  BundleReader compacted_reader(Env::Default(), Prefix("chain_2"));
+  TF_ASSERT_OK(compacted_reader.status());
+  EXPECT_EQ(compacted_reader.delta_chain_length(), 0);
+  Expect<float>(&compacted_reader, "foo", Constant_2x3<float>(0));
+}
+
+TEST(TensorBundleTest, LookupShardId) {
+  {
+    BundleWriter writer(Env::Default(), Prefix("shard"));
+    TF_EXPECT_OK(writer.Add("foo", Constant_2x3<float>(1)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader reader(Env::Default(), Prefix("shard"));
+  TF_ASSERT_OK(reader.status());
+  int shard_id = -1;
+  TF_ASSERT_OK(reader.LookupShardId("foo", &shard_id));
+  EXPECT_EQ(shard_id, 0);
+  Status s = reader.LookupShardId("bar", &shard_id);
+  EXPECT_TRUE(absl::IsNotFound(s)) << s;
+}
+
+TEST(TensorBundleTest, UseMmap) {
+  {
+    BundleWriter::Options opts;
+    opts.data_alignment = Allocator::kAllocatorAlignment;
+    BundleWriter writer(Env::Default(), Prefix("mmap"), opts);
+    TF_EXPECT_OK(writer.Add("foo", Constant_100x100<float>(3)));
+    TF_EXPECT_OK(
+        writer.Add("strs", test::AsTensor<tstring>({"hello", "world"})));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options opts;
+  opts.use_mmap = true;
+  BundleReader reader(Env::Default(), Prefix("mmap"), opts);
+  TF_ASSERT_OK(reader.status());
+  // Fixed width tensors alias the mapping; string tensors fall back to the
+  // copying path. Both restore the stored values.
+  Expect<float>(&reader, "foo", Constant_100x100<float>(3));
+  Expect<tstring>(&reader, "strs", test::AsTensor<tstring>({"hello", "world"}));
+
+  // Where the platform supports memory mapping, repeated lookups of an
+  // aligned fixed width tensor return tensors aliasing the same mapped bytes.
+  std::unique_ptr<ReadOnlyMemoryRegion> region;
+  if (Env::Default()
+          ->NewReadOnlyMemoryRegionFromFile(DataFilename(Prefix("mmap"), 0, 1),
+                                            &region)
+          .ok()) {
+    Tensor t1;
+    Tensor t2;
+    TF_ASSERT_OK(reader.Lookup("foo", &t1));
+    TF_ASSERT_OK(reader.Lookup("foo", &t2));
+    EXPECT_EQ(t1.data(), t2.data());
+  }
+}
+
+TEST(TensorBundleTest, UseMmapUnalignedFallback) {
+  {
+    // Densely packed bundle: most entries are not aligned for aliasing and
+    // must take the buffered read path.
+    BundleWriter writer(Env::Default(), Prefix("mmap_unaligned"));
+    TF_EXPECT_OK(writer.Add("first", Constant(true, TensorShape({1}))));
+    TF_EXPECT_OK(writer.Add("second", Constant_2x3<float>(7)));
+    TF_ASSERT_OK(writer.Finish());
+  }
+  BundleReader::Options opts;
+  opts.use_mmap = true;
+  BundleReader reader(Env::Default(), Prefix("mmap_unaligned"), opts);
+  TF_ASSERT_OK(reader.status());
+  Expect<bool>(&reader, "first", Constant(true, TensorShape({1})));
+  Expect<float>(&reader, "second", Constant_2x3<float>(7));
+}
+
 static void BM_BundleAlignment(::testing::benchmark::State& state) {
   {
     const int alignment = state.range(0);
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include "xla/tsl/util/env_var.h"
 #include "tensorflow/core/platform/blocking_counter.h"
+#include "tensorflow/core/platform/env.h"
 #include "tensorflow/core/platform/logging.h"
 #include "tsl/profiler/lib/traceme.h"
 
@@ -83,6 +84,45 @@ void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
       max_parallelism);
 }
 
+int64_t SharderCostProfile::cost_per_unit(int64_t fallback) const {
+  if (num_updates_.load(std::memory_order_relaxed) < kMinUpdates) {
+    return fallback;
+  }
+  return std::max(
+      int64_t{1},
+      static_cast<int64_t>(ewma_cost_per_unit_.load(std::memory_order_relaxed)));
+}
+
+void SharderCostProfile::Update(int64_t units, int64_t elapsed_ns) {
+  if (units <= 0) return;
+  const double measured = static_cast<double>(elapsed_ns) / units;
+  double current = ewma_cost_per_unit_.load(std::memory_order_relaxed);
+  double next;
+  do {
+    // Seed the average with the first measurement so early estimates are not
+    // dragged down by the zero initial value.
+    next = current == 0.0 ? measured : (1 - kAlpha) * current + kAlpha * measured;
+  } while (!ewma_cost_per_unit_.compare_exchange_weak(
+      current, next, std::memory_order_relaxed));
+  num_updates_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           SharderCostProfile* cost_profile, int64_t default_cost_per_unit,
+           std::function<void(int64_t, int64_t)> work) {
+  DCHECK(cost_profile != nullptr);
+  // Time each executed block on its own thread, so the learned per-unit cost
+  // is independent of how many shards ran concurrently.
+  auto timed_work = [&work, cost_profile](int64_t start, int64_t limit) {
+    const uint64 start_ns = Env::Default()->NowNanos();
+    work(start, limit);
+    cost_profile->Update(limit - start, Env::Default()->NowNanos() - start_ns);
+  };
+  Shard(max_parallelism, workers, total,
+        cost_profile->cost_per_unit(default_cost_per_unit),
+        std::move(timed_work));
+}
+
 // DEPRECATED: Prefer threadpool->ParallelFor with SchedulingStrategy, which
 // allows you to specify the strategy for choosing shard sizes, including using
 // a fixed shard size.
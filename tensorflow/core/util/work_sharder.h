@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 #define TENSORFLOW_CORE_UTIL_WORK_SHARDER_H_
 
+#include <atomic>
 #include <functional>
 
 #include "tensorflow/core/lib/core/threadpool.h"
@@ -84,6 +85,58 @@ class ScopedPerThreadMaxParallelism {
   int previous_ = -1;
 };
 
+// A learned per-callsite cost profile for Shard().  Caller-provided
+// cost_per_unit estimates are often wrong by orders of magnitude, producing
+// shards that are too small (per-shard overhead dominates) or too large
+// (parallelism goes unused).  A SharderCostProfile replaces the static guess
+// with an exponentially weighted moving average of per-unit cost measured
+// from the actual work blocks.  Typical usage is one static instance per
+// callsite:
+//
+//   static SharderCostProfile* profile = new SharderCostProfile();
+//   Shard(max_parallelism, workers, total, profile, cost_per_unit_guess,
+//         std::move(work));
+//
+// The caller's estimate is used until enough blocks have been measured.
+// This class is thread safe.
+class SharderCostProfile {
+ public:
+  SharderCostProfile() = default;
+
+  // Returns the learned cost per unit in nanoseconds, or `fallback` until
+  // enough measurements have been recorded.
+  int64_t cost_per_unit(int64_t fallback) const;
+
+  // Records that a work block of `units` units took `elapsed_ns` wall
+  // nanoseconds on one thread.
+  void Update(int64_t units, int64_t elapsed_ns);
+
+  int64_t num_updates() const {
+    return num_updates_.load(std::memory_order_relaxed);
+  }
+
+ private:
+  // Weight of a new measurement in the moving average.
+  static constexpr double kAlpha = 0.25;
+  // Number of measured blocks before the learned estimate is trusted over
+  // the caller's.
+  static constexpr int64_t kMinUpdates = 4;
+
+  std::atomic<double> ewma_cost_per_unit_{0.0};
+  std::atomic<int64_t> num_updates_{0};
+};
+
+// Like Shard() above, but draws cost_per_unit from `cost_profile` once the
+// profile has seen enough measured blocks, falling back to
+// `default_cost_per_unit` before that.  Every executed work block feeds its
+// measured time back into the profile, so repeated calls converge to
+// near-optimal grain sizes regardless of the quality of the static estimate.
+//
+// REQUIRES: cost_profile != nullptr, plus the requirements of Shard() above.
+void Shard(int max_parallelism, thread::ThreadPool* workers, int64_t total,
+           SharderCostProfile* cost_profile, int64_t default_cost_per_unit,
+           std::function<void(int64_t, int64_t)> work);
+
 // Implementation details for Shard().
 class Sharder {
  public:
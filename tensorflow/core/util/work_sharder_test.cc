@@ -93,6 +93,41 @@ TEST(Shard, OverflowTest) {
   }
 }
 
+TEST(SharderCostProfile, LearnsFromMeasurements) {
+  SharderCostProfile profile;
+  // Until enough blocks are measured, the caller's estimate wins.
+  EXPECT_EQ(profile.cost_per_unit(123), 123);
+
+  // 100 units taking 100us each measurement -> 1000ns per unit.
+  for (int i = 0; i < 4; ++i) {
+    profile.Update(100, 100 * 1000);
+  }
+  EXPECT_EQ(profile.num_updates(), 4);
+  EXPECT_EQ(profile.cost_per_unit(123), 1000);
+
+  // The average tracks a change in measured cost.
+  for (int i = 0; i < 100; ++i) {
+    profile.Update(100, 400 * 1000);
+  }
+  EXPECT_NEAR(profile.cost_per_unit(123), 4000, 100);
+}
+
+TEST(Shard, WithCostProfile) {
+  thread::ThreadPool threads(Env::Default(), "test", 16);
+  SharderCostProfile profile;
+  const int64_t total = 1000;
+  for (int round = 0; round < 3; ++round) {
+    std::atomic<int64_t> num_elements(0);
+    Shard(8, &threads, total, &profile, /*default_cost_per_unit=*/1000,
+          [&num_elements](int64_t start, int64_t limit) {
+            num_elements += limit - start;
+          });
+    EXPECT_EQ(num_elements.load(), total);
+  }
+  // Every executed block feeds the profile.
+  EXPECT_GT(profile.num_updates(), 0);
+}
+
 void BM_Sharding(::testing::benchmark::State& state) {
   const int arg = state.range(0);
 
@@ -1163,7 +1163,26 @@ void AddDTensorFunctionAttr(FunctionDef& function_def) {
 
 tensorflow::Fprint128 ExecutableManagerImpl::CacheKeyForDTensorOperation(
     const DTensorOperation& doperation) const {
-  return tensorflow::Fingerprint128(doperation.name);
+  if (!doperation.is_func()) {
+    return tensorflow::Fingerprint128(doperation.name);
+  }
+  // Function names are regenerated on every retracing, so keying on the name
+  // would miss the cache for retracings whose structure did not change.
+  // Fingerprint the function body with the generated signature name cleared
+  // instead.
+  mutex_lock lock(function_fingerprint_mu_);
+  auto iter = function_fingerprints_.find(doperation.name);
+  if (iter != function_fingerprints_.end()) {
+    return iter->second;
+  }
+  FunctionDef function_def = *doperation.function_def;
+  function_def.mutable_signature()->clear_name();
+  std::string serialized;
+  SerializeToStringDeterministic(function_def, &serialized);
+  const tensorflow::Fprint128 fingerprint =
+      tensorflow::Fingerprint128(serialized);
+  function_fingerprints_.emplace(doperation.name, fingerprint);
+  return fingerprint;
 }
 
 absl::flat_hash_map<int, NodeDef>
@@ -463,14 +463,24 @@ class ExecutableManagerImpl {
   absl::flat_hash_map<int, NodeDef> GetConstantFoldableTensors(
       const std::vector<TensorWithLayout*>& inputs);
 
-  // Cache key for dtensor operation name, which includes the op name
-  // and the input shapes. This is needed as a higher level cache for constant
-  // folding.
+  // Cache key for the dtensor operation. This is needed as a higher level
+  // cache for constant folding. Eager ops key on the op name. Function ops
+  // key on a fingerprint of the function body with the trace-generated
+  // signature name canonicalized away, so that retracings of a structurally
+  // unchanged function share cache entries instead of re-running the whole
+  // MLIR lowering (including layout propagation).
   tensorflow::Fprint128 CacheKeyForDTensorOperation(
       const DTensorOperation& doperation) const;
 
  private:
   ExecutableManagerImpl() = default;
+
+  mutable mutex function_fingerprint_mu_;
+  // Memoized structural fingerprints of traced functions, keyed by the
+  // generated function name. A FunctionDef registered under a given name is
+  // immutable, so memoization is safe.
+  mutable absl::flat_hash_map<std::string, tensorflow::Fprint128>
+      function_fingerprints_ TF_GUARDED_BY(function_fingerprint_mu_);
 };
 
 struct ExecutionManagerStats {
@@ -622,7 +632,8 @@ void AddDTensorFunctionAttr(FunctionDef& function_def);
 // Cache key computation should consider all features of an op that affects
 // the SPMD lowering. The cache keys of two ops must be different if the
 // translated functions are different.
-// - op name and attr
+// - op name (for function ops, a structural fingerprint of the function
+//   body rather than the trace-generated name) and attr
 // - input shapes and layouts
 // - default layout of outputs.
 // - default mesh.
@@ -632,9 +643,19 @@ StatusOr<tensorflow::Fprint128> ExecutableManager<T>::CacheKeyForGraph(
     const DTensorOperation& doperation, const NameAttrList& attributes,
     const std::vector<TensorWithLayout*>& inputs,
     const std::vector<const Layout*>& output_layouts) {
-  tensorflow::Fprint128 cache_key = tensorflow::Fingerprint128(doperation.name);
+  tensorflow::Fprint128 cache_key =
+      executable_manager_impl_.CacheKeyForDTensorOperation(doperation);
   std::string serialized;
-  SerializeToStringDeterministic(attributes, &serialized);
+  if (doperation.is_func()) {
+    // The attribute list of a traced function carries the trace-generated
+    // function name; drop it so that structurally identical retracings
+    // serialize identically.
+    NameAttrList attributes_without_name = attributes;
+    attributes_without_name.clear_name();
+    SerializeToStringDeterministic(attributes_without_name, &serialized);
+  } else {
+    SerializeToStringDeterministic(attributes, &serialized);
+  }
   cache_key =
       FingerprintCat128(cache_key, tensorflow::Fingerprint128(serialized));
   cache_key = FingerprintCat128(
@@ -55,6 +55,9 @@ CreateDTensorAllReduceScatterOptimization();
 std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
 CreateDTensorAllReduceCombineOptimization();
 
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+CreateDTensorAllToAllCombineOptimization();
+
 std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
 CreateDTensorMixedPrecisionReducePass();
 
@@ -0,0 +1,385 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include <algorithm>
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+#include "absl/log/check.h"
+#include "absl/log/log.h"
+#include "llvm/ADT/DenseSet.h"
+#include "llvm/ADT/SmallVector.h"
+#include "llvm/ADT/StringMap.h"
+#include "llvm/Support/raw_ostream.h"
+#include "mlir/Analysis/TopologicalSortUtils.h"  // from @llvm-project
+#include "mlir/Dialect/Func/IR/FuncOps.h"  // from @llvm-project
+#include "mlir/IR/Block.h"  // from @llvm-project
+#include "mlir/IR/Builders.h"  // from @llvm-project
+#include "mlir/IR/BuiltinOps.h"  // from @llvm-project
+#include "mlir/IR/BuiltinTypes.h"  // from @llvm-project
+#include "mlir/IR/Location.h"  // from @llvm-project
+#include "mlir/IR/Value.h"  // from @llvm-project
+#include "mlir/IR/Visitors.h"  // from @llvm-project
+#include "mlir/Pass/Pass.h"  // from @llvm-project
+#include "mlir/Support/LLVM.h"  // from @llvm-project
+#include "mlir/Support/LogicalResult.h"  // from @llvm-project
+#include "tensorflow/compiler/mlir/tensorflow/analysis/side_effect_analysis.h"
+#include "tensorflow/compiler/mlir/tensorflow/ir/tf_device.h"
+#include "tensorflow/compiler/mlir/tensorflow/ir/tf_ops.h"
+#include "tensorflow/compiler/mlir/tensorflow/transforms/collection_ops_util.h"
+#include "tensorflow/dtensor/cc/tensor_layout.h"
+#include "tensorflow/dtensor/mlir/dtensor_dialect/ir/dtensor_attributes.h"
+#include "tensorflow/dtensor/mlir/dtensor_location.h"
+#include "tensorflow/dtensor/mlir/ir/tf_dtensor.h"
+#include "tensorflow/dtensor/mlir/layout_parsing.h"
+
+namespace tensorflow {
+namespace dtensor {
+
+namespace {
+#define GEN_PASS_DEF_DTENSORALLTOALLCOMBINEOPTIMIZATION
+#include "tensorflow/dtensor/mlir/dtensor_passes.h.inc"
+
+namespace ops_util = ::mlir::TF::collection_ops_util;
+
+// Returns true if `successor` depends on `predecessor`, either through MLIR
+// value use-def chains or indirectly through side effects.
+bool DependsOn(mlir::Operation* successor, mlir::Operation* predecessor,
+               const mlir::TF::detail::SideEffectAnalysisInfo& info) {
+  llvm::SmallVector<mlir::Operation*, 4> to_visit;
+  llvm::SmallPtrSet<mlir::Operation*, 4> visited;
+  to_visit.push_back(predecessor);
+  while (!to_visit.empty()) {
+    mlir::Operation* producer = to_visit.pop_back_val();
+    if (visited.contains(producer)) continue;
+    visited.insert(producer);
+    if (successor == producer) return true;
+    for (mlir::Operation* user : producer->getUsers()) {
+      if (visited.contains(user)) continue;
+      to_visit.push_back(user);
+    }
+    for (mlir::Operation* user : info.DirectControlSuccessors(producer)) {
+      if (visited.contains(user)) continue;
+      to_visit.push_back(user);
+    }
+  }
+  return false;
+}
+
+// Signature describing which all-to-alls can be stacked together: they must
+// exchange tensors of the same local type with the same input and output
+// layouts, and therefore over the same mesh with the same group assignment
+// and split/concat dimensions.
+std::string AllToAllSignature(mlir::TF::DTensorAllToAllOp all_to_all) {
+  std::string signature;
+  llvm::raw_string_ostream os(signature);
+  os << all_to_all.getInput().getType() << ";"
+     << all_to_all.getInputLayout().ToString() << ";"
+     << all_to_all.getOutputLayout().ToString();
+  return os.str();
+}
+
+// Merge all-to-alls in the group into one all-to-all.
+//
+// Requirements:
+//   - The group should have at least two all-to-alls.
+//   - They should be located next to each other in the parent block.
+//   - They should all have the same input type and the same input and output
+//     layouts.
+//
+// Every input is reshaped to rank+1 with a leading dimension of one and the
+// results are concatenated into one stacked tensor. A single all-to-all over
+// the stacked tensor replaces the group; its layouts are the original layouts
+// left-padded with a replicated dimension, so the lowering derives the same
+// exchange shifted by the stacking dimension. Afterwards, every result is
+// sliced back out and reshaped to the original output shape.
+mlir::LogicalResult MergeAllToAllGroup(
+    std::vector<mlir::TF::DTensorAllToAllOp>& all_to_all_group) {
+  int num_all_to_alls = all_to_all_group.size();
+  DCHECK(num_all_to_alls > 1)
+      << "All-to-all group size expected to be greater than 1.";
+  mlir::TF::DTensorAllToAllOp first = all_to_all_group[0];
+  auto input_type =
+      mlir::dyn_cast<mlir::RankedTensorType>(first.getInput().getType());
+  auto output_type =
+      mlir::dyn_cast<mlir::RankedTensorType>(first.getOutput().getType());
+  if (!input_type || !input_type.hasStaticShape() || !output_type ||
+      !output_type.hasStaticShape()) {
+    return first.emitOpError(
+        "requires static shapes to combine DTensorAllToAllOp");
+  }
+
+  const Layout src_layout = first.getInputLayout();
+  const Layout tgt_layout = first.getOutputLayout();
+  const Layout stacked_src_layout = src_layout.LeftPad(src_layout.rank() + 1);
+  const Layout stacked_tgt_layout = tgt_layout.LeftPad(tgt_layout.rank() + 1);
+
+  mlir::OpBuilder builder(first);
+  mlir::Location loc = first.getLoc();
+
+  // Reshape every input to rank+1 with a leading dimension of one, and stack
+  // the inputs along that dimension.
+  std::vector<int64_t> expanded_shape;
+  expanded_shape.reserve(input_type.getRank() + 1);
+  expanded_shape.push_back(1);
+  expanded_shape.insert(expanded_shape.end(), input_type.getShape().begin(),
+                        input_type.getShape().end());
+  llvm::SmallVector<mlir::Value, 4> expanded_inputs;
+  expanded_inputs.reserve(num_all_to_alls);
+  for (mlir::TF::DTensorAllToAllOp& all_to_all : all_to_all_group) {
+    expanded_inputs.push_back(builder.create<mlir::TF::ReshapeOp>(
+        DT_LOC2(all_to_all.getLoc(), "CombinedAllToAllStack"),
+        all_to_all.getInput(),
+        ops_util::GetR1Const(expanded_shape, builder, all_to_all.getLoc())));
+  }
+  std::vector<int64_t> stacked_input_shape = expanded_shape;
+  stacked_input_shape[0] = num_all_to_alls;
+  auto stacked = builder.create<mlir::TF::ConcatV2Op>(
+      DT_LOC2(loc, "CombinedAllToAllStack"),
+      mlir::RankedTensorType::get(stacked_input_shape,
+                                  input_type.getElementType()),
+      expanded_inputs, ops_util::CreateScalarConst(0, builder, loc));
+
+  // Exchange the stacked tensor with a single all-to-all.
+  std::vector<int64_t> stacked_output_shape;
+  stacked_output_shape.reserve(output_type.getRank() + 1);
+  stacked_output_shape.push_back(num_all_to_alls);
+  stacked_output_shape.insert(stacked_output_shape.end(),
+                              output_type.getShape().begin(),
+                              output_type.getShape().end());
+  auto merged_all_to_all = builder.create<mlir::TF::DTensorAllToAllOp>(
+      loc,
+      mlir::RankedTensorType::get(stacked_output_shape,
+                                  output_type.getElementType()),
+      stacked,
+      mlir::dtensor::LayoutAttr::get(builder.getContext(), stacked_src_layout),
+      mlir::dtensor::LayoutAttr::get(builder.getContext(),
+                                     stacked_tgt_layout));
+  SetSingleLayoutOnOp(merged_all_to_all, stacked_tgt_layout);
+
+  // Slice out every result and drop the stacking dimension.
+  std::vector<int64_t> slice_size = stacked_output_shape;
+  slice_size[0] = 1;
+  for (int i = 0; i < num_all_to_alls; ++i) {
+    mlir::TF::DTensorAllToAllOp& all_to_all = all_to_all_group[i];
+    mlir::Location all_to_all_loc = all_to_all.getLoc();
+    std::vector<int64_t> slice_begin(slice_size.size(), 0);
+    slice_begin[0] = i;
+    auto slice = builder.create<mlir::TF::SliceOp>(
+        DT_LOC2(all_to_all_loc, "PostCombinedAllToAllSlice"),
+        mlir::RankedTensorType::get(slice_size, output_type.getElementType()),
+        /*input=*/merged_all_to_all.getOutput(),
+        /*begin=*/ops_util::GetR1Const(slice_begin, builder, all_to_all_loc),
+        /*size=*/ops_util::GetR1Const(slice_size, builder, all_to_all_loc));
+    auto replacement = builder.create<mlir::TF::ReshapeOp>(
+        DT_LOC2(all_to_all_loc, "PostCombinedAllToAllReshape"),
+        slice.getResult(),
+        ops_util::GetR1Const(output_type.getShape(), builder, all_to_all_loc));
+    all_to_all.replaceAllUsesWith(replacement.getResult());
+  }
+  for (mlir::TF::DTensorAllToAllOp& all_to_all : all_to_all_group) {
+    all_to_all.erase();
+  }
+  return mlir::success();
+}
+
+// Move all-to-alls in the group together and combine them.
+mlir::LogicalResult CombineAllToAllOps(
+    std::vector<mlir::TF::DTensorAllToAllOp>& all_to_all_group) {
+  // A single op has nothing to combine with.
+  int num_all_to_alls = all_to_all_group.size();
+  if (num_all_to_alls <= 1) return mlir::success();
+
+  mlir::TF::DTensorAllToAllOp final_all_to_all =
+      all_to_all_group[num_all_to_alls - 1];
+  for (int i = num_all_to_alls - 2; i >= 0; --i) {
+    mlir::TF::DTensorAllToAllOp all_to_all = all_to_all_group[i];
+    all_to_all->moveBefore(final_all_to_all);
+  }
+  return MergeAllToAllGroup(all_to_all_group);
+}
+
+// Groups all-to-alls that are independent of each other, layer by layer, so
+// that combining a group cannot create a dependency cycle. All-to-alls in
+// different blocks exist in the same ClusterOp, so one or both of them must
+// be inside a control flow region; they are conservatively treated as
+// dependent. See the all-reduce combine optimization for a discussion of the
+// layering.
+std::vector<std::vector<mlir::TF::DTensorAllToAllOp>>
+createIndependentAllToAllGroups(
+    const std::vector<mlir::TF::DTensorAllToAllOp>& ordered_all_to_alls,
+    const mlir::TF::detail::SideEffectAnalysisInfo& info) {
+  // Build a reverse adjacency matrix from node to its dependents.
+  auto num_all_to_alls = ordered_all_to_alls.size();
+  std::vector<std::vector<int>> dependents(num_all_to_alls,
+                                           std::vector<int>());
+  for (int i = 0; i < num_all_to_alls - 1; ++i) {
+    mlir::TF::DTensorAllToAllOp requirement = ordered_all_to_alls[i];
+    for (int j = i + 1; j < num_all_to_alls; ++j) {
+      mlir::TF::DTensorAllToAllOp dependent = ordered_all_to_alls[j];
+      DCHECK(!DependsOn(requirement, dependent,
+                        info));  // guaranteed by program order
+      if (requirement->getBlock() != dependent->getBlock() ||
+          DependsOn(dependent, requirement, info)) {
+        dependents[i].push_back(j);
+      }
+    }
+  }
+
+  // Traverse the adjacency matrix layer by layer from last op to find
+  // combination groups.
+  std::vector<std::vector<mlir::TF::DTensorAllToAllOp>> all_to_all_groups;
+  std::set<int> fulfilled;
+  while (fulfilled.size() < ordered_all_to_alls.size()) {
+    std::vector<mlir::TF::DTensorAllToAllOp> group;
+    std::vector<int64_t> group_ids;
+    for (int i = dependents.size() - 1; i >= 0; i--) {
+      if (fulfilled.count(i) > 0) continue;  // Already added op
+      bool all_deps_added = true;
+      for (int j = dependents[i].size() - 1; j >= 0; j--) {
+        if (fulfilled.count(dependents[i][j]) == 0) {
+          all_deps_added = false;
+          break;
+        }
+      }
+      if (all_deps_added) {
+        group_ids.push_back(i);
+      }
+    }
+
+    std::sort(group_ids.begin(), group_ids.end(),
+              [](const int64_t lhs, const int64_t rhs) { return lhs < rhs; });
+
+    for (auto x : group_ids) {
+      group.push_back(ordered_all_to_alls[x]);
+      fulfilled.insert(x);
+    }
+    all_to_all_groups.push_back(group);
+  }
+  return all_to_all_groups;
+}
+
+std::vector<std::vector<mlir::TF::DTensorAllToAllOp>>
+createSubgroupsBySignature(
+    std::vector<std::vector<mlir::TF::DTensorAllToAllOp>> all_to_all_groups) {
+  std::vector<std::vector<mlir::TF::DTensorAllToAllOp>>
+      all_to_all_new_groups;
+  // Combine all-to-alls of the same signature.
+  for (const auto& all_to_all_group : all_to_all_groups) {
+    llvm::StringMap<std::vector<mlir::TF::DTensorAllToAllOp>>
+        all_to_alls_by_signature;
+    for (mlir::TF::DTensorAllToAllOp all_to_all : all_to_all_group) {
+      all_to_alls_by_signature[AllToAllSignature(all_to_all)].push_back(
+          all_to_all);
+    }
+    for (auto& signature_pair : all_to_alls_by_signature) {
+      all_to_all_new_groups.push_back(signature_pair.second);
+    }
+  }
+  VLOG(4) << "current number of groups: " << all_to_all_new_groups.size()
+          << " after grouping by signature.";
+  return all_to_all_new_groups;
+}
+
+struct DTensorAllToAllCombineOptimization
+    : public impl::DTensorAllToAllCombineOptimizationBase<
+          DTensorAllToAllCombineOptimization> {
+  void runOnOperation() override {
+    mlir::func::FuncOp function = getOperation();
+    auto module = function->getParentOfType<mlir::ModuleOp>();
+    function.walk([&](mlir::tf_device::ClusterOp cluster) {
+      std::vector<mlir::TF::DTensorAllToAllOp> ordered_all_to_alls;
+      llvm::DenseSet<mlir::Block*> blocks;
+      cluster.GetBody().walk([&](mlir::TF::DTensorAllToAllOp all_to_all) {
+        if (all_to_all.getInputLayout().mesh().is_tpu_mesh()) {
+          // Only combine all-to-alls for GPU and CPU. On TPU meshes they
+          // lower to XlaAllToAll and XLA combines them instead.
+          return;
+        }
+        auto input_type = mlir::dyn_cast<mlir::RankedTensorType>(
+            all_to_all.getInput().getType());
+        auto output_type = mlir::dyn_cast<mlir::RankedTensorType>(
+            all_to_all.getOutput().getType());
+        if (input_type && input_type.hasStaticShape() && output_type &&
+            output_type.hasStaticShape()) {
+          // Static known shapes are required to stack the exchanged tensors.
+          // If a shape is not known skip merging.
+          ordered_all_to_alls.push_back(all_to_all);
+          blocks.insert(all_to_all->getBlock());
+        }
+      });
+
+      if (ordered_all_to_alls.size() > 1) {
+        VLOG(2) << ordered_all_to_alls.size()
+                << " all-to-all ops eligible for combine optimization.";
+        // Build side effect analysis to identify indirect dependencies
+        // between all eligible all-to-all operations.
+        mlir::TF::SideEffectAnalysis side_effect_analysis(module);
+        const mlir::TF::detail::SideEffectAnalysisInfo& info =
+            side_effect_analysis.GetAnalysisForFunc(function);
+        auto all_to_all_groups =
+            createIndependentAllToAllGroups(ordered_all_to_alls, info);
+        all_to_all_groups = createSubgroupsBySignature(all_to_all_groups);
+
+        // Maintain relative order of all-to-alls within the block.
+        std::sort(all_to_all_groups.begin(), all_to_all_groups.end(),
+                  [](std::vector<mlir::TF::DTensorAllToAllOp> lhs,
+                     std::vector<mlir::TF::DTensorAllToAllOp> rhs) {
+                    // Prefer groups that are not empty.
+                    if (lhs.empty() && !rhs.empty()) return false;
+                    if (!lhs.empty() && rhs.empty()) return true;
+
+                    // Then prefer groups that are in earlier-in-memory
+                    // blocks, this part just needs to be consistent for
+                    // strict weak ordering purposes.
+                    if (lhs[0]->getBlock() != rhs[0]->getBlock()) {
+                      return lhs[0]->getBlock() < rhs[0]->getBlock();
+                    }
+
+                    // Within the block, use the group's actual sorting.
+                    return lhs[0]->isBeforeInBlock(rhs[0]);
+                  });
+
+        VLOG(2) << ordered_all_to_alls.size() << " all-to-all ops in "
+                << all_to_all_groups.size() << " groups";
+
+        for (auto& all_to_all_group : all_to_all_groups) {
+          if (all_to_all_group.size() > 1) {
+            if (mlir::failed(CombineAllToAllOps(all_to_all_group))) {
+              return signalPassFailure();
+            }
+          }
+        }
+
+        for (auto* b : blocks) {
+          mlir::sortTopologically(b);
+        }
+      }
+    });
+  }
+};
+
+}  // namespace
+
+std::unique_ptr<mlir::OperationPass<mlir::func::FuncOp>>
+CreateDTensorAllToAllCombineOptimization() {
+  return std::make_unique<DTensorAllToAllCombineOptimization>();
+}
+
+}  // namespace dtensor
+}  // namespace tensorflow
@@ -243,6 +243,10 @@ void CreateDTensorMLIRPass(const mlir::TF::StandardPipelineOptions &options,
 
   AddDTensorAllReduceCombineOptimization(pm);
 
+  // Combine independent same-layout DTensorAllToAll ops into a single batched
+  // exchange. Must run before the all-to-all lowering.
+  AddDTensorAllToAllCombineOptimization(pm);
+
   // Lowers complex and other unsupported types to supported types.
   pm->addNestedPass<mlir::func::FuncOp>(
       CreateDTensorCollectiveTypeLoweringPass());
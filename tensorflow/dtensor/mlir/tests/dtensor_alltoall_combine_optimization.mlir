@@ -0,0 +1,59 @@
+// RUN: dtensor-opt %s -split-input-file -dtensor-alltoall-combine-optimization -verify-diagnostics | FileCheck %s
+
+// Check that independent DTensorAllToAll ops with the same input type and
+// layouts are stacked into a single batched all-to-all.
+// CHECK-LABEL: func @main
+func.func @main(%arg0: tensor<i32>,
+           %arg1: tensor<4x2xf32> {tf._layout = "sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"},
+           %arg2: tensor<4x2xf32> {tf._layout = "sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"}) -> tensor<2x4xf32> {
+  // CHECK:      %[[STACK_1:.*]] = "tf.Reshape"(%arg1
+  // CHECK:      %[[STACK_2:.*]] = "tf.Reshape"(%arg2
+  // CHECK:      %[[STACKED:.*]] = "tf.ConcatV2"(%[[STACK_1]], %[[STACK_2]]
+  // CHECK-SAME:   -> tensor<2x4x2xf32>
+  // CHECK:      %[[ALLTOALL_OUT:.*]] = "tf.DTensorAllToAll"(%[[STACKED]])
+  // CHECK-SAME:   input_layout = #dtensor.layout<sharding_specs:unsharded,unsharded,x,
+  // CHECK-SAME:   output_layout = #dtensor.layout<sharding_specs:unsharded,x,unsharded,
+  // CHECK-SAME:   (tensor<2x4x2xf32>) -> tensor<2x2x4xf32>
+  // CHECK:      %[[SLICE_1:.*]] = "tf.Slice"(%[[ALLTOALL_OUT]]
+  // CHECK:      %[[OUT_1:.*]] = "tf.Reshape"(%[[SLICE_1]]
+  // CHECK:      %[[SLICE_2:.*]] = "tf.Slice"(%[[ALLTOALL_OUT]]
+  // CHECK:      %[[OUT_2:.*]] = "tf.Reshape"(%[[SLICE_2]]
+  // CHECK:      %[[ADD:.*]] = "tf.Add"(%[[OUT_1]], %[[OUT_2]])
+  // CHECK-NOT:  "tf.DTensorAllToAll"
+  %0 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllToAll"(%arg1) {_layout = ["sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"],
+    input_layout = #dtensor.layout<sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>,
+    output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>} : (tensor<4x2xf32>) -> tensor<2x4xf32>
+    %2 = "tf.DTensorAllToAll"(%arg2) {_layout = ["sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"],
+    input_layout = #dtensor.layout<sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>,
+    output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>} : (tensor<4x2xf32>) -> tensor<2x4xf32>
+    %3 = "tf.Add"(%1, %2) : (tensor<2x4xf32>, tensor<2x4xf32>) -> tensor<2x4xf32>
+    tf_device.return %3 : tensor<2x4xf32>
+  }) {_mesh = "GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"} : () -> tensor<2x4xf32>
+  func.return %0 : tensor<2x4xf32>
+}
+
+// -----
+
+// Check that DTensorAllToAll ops with different layouts are not combined.
+// CHECK-LABEL: func @main
+func.func @main(%arg0: tensor<i32>,
+           %arg1: tensor<4x2xf32> {tf._layout = "sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"},
+           %arg2: tensor<4x2xf32> {tf._layout = "sharding_specs:unsharded,y, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"}) -> tensor<2x4xf32> {
+  // CHECK:      %[[ALLTOALL_OUT_1:.*]] = "tf.DTensorAllToAll"(%arg1)
+  // CHECK-SAME:   (tensor<4x2xf32>) -> tensor<2x4xf32>
+  // CHECK:      %[[ALLTOALL_OUT_2:.*]] = "tf.DTensorAllToAll"(%arg2)
+  // CHECK-SAME:   (tensor<4x2xf32>) -> tensor<2x4xf32>
+  // CHECK:      %[[ADD:.*]] = "tf.Add"(%[[ALLTOALL_OUT_1]], %[[ALLTOALL_OUT_2]])
+  %0 = "tf_device.cluster"() ({
+    %1 = "tf.DTensorAllToAll"(%arg1) {_layout = ["sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"],
+    input_layout = #dtensor.layout<sharding_specs:unsharded,x, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>,
+    output_layout = #dtensor.layout<sharding_specs:x,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>} : (tensor<4x2xf32>) -> tensor<2x4xf32>
+    %2 = "tf.DTensorAllToAll"(%arg2) {_layout = ["sharding_specs:y,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"],
+    input_layout = #dtensor.layout<sharding_specs:unsharded,y, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>,
+    output_layout = #dtensor.layout<sharding_specs:y,unsharded, mesh:GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3>} : (tensor<4x2xf32>) -> tensor<2x4xf32>
+    %3 = "tf.Add"(%1, %2) : (tensor<2x4xf32>, tensor<2x4xf32>) -> tensor<2x4xf32>
+    tf_device.return %3 : tensor<2x4xf32>
+  }) {_mesh = "GPU|x=2,y=2|0,1,2,3|0,1,2,3|/job:localhost/task:0/device:GPU:0,/job:localhost/task:0/device:GPU:1,/job:localhost/task:0/device:GPU:2,/job:localhost/task:0/device:GPU:3"} : () -> tensor<2x4xf32>
+  func.return %0 : tensor<2x4xf32>
+}
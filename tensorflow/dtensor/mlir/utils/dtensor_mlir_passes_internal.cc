@@ -40,6 +40,20 @@ void AddDTensorAllReduceCombineOptimization(mlir::OpPassManager* pm) {
       CreateDTensorAllReduceCombineOptimization());
 }
 
+// Combine independent DTensorAllToAllOps from the same ClusterOp. TPU meshes
+// do not need this. They can rely on the XLA all-to-all combiner instead.
+void AddDTensorAllToAllCombineOptimization(mlir::OpPassManager* pm) {
+  // Experimental feature. If zero, the optimization for combining all-to-alls
+  // with the same layouts and input type, will not be done.
+  const char* env_str =
+      (std::getenv("DTENSOR_ENABLE_COMBINE_ALL_TO_ALLS_OPTIMIZATION"));
+  if (env_str && strcmp(env_str, "0") == 0) {
+    return;
+  }
+  pm->addNestedPass<mlir::func::FuncOp>(
+      CreateDTensorAllToAllCombineOptimization());
+}
+
 }  // namespace dtensor
 }  // namespace tensorflow
 
@@ -23,6 +23,8 @@ namespace dtensor {
 
 void AddDTensorAllReduceCombineOptimization(mlir::OpPassManager* pm);
 
+void AddDTensorAllToAllCombineOptimization(mlir::OpPassManager* pm);
+
 }  // namespace dtensor
 }  // namespace tensorflow
 
@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <stddef.h>
 
+#include <cstdint>
 #include <cstdio>
 #include <cstdlib>
 #include <memory>
@@ -95,6 +96,19 @@ class MMAPAllocation : public Allocation {
     return offset_of_buffer_in_file_;
   }
 
+  // Asks the OS to page in the given byte range of the mapping ahead of use
+  // (relative to base()), so large weight regions can be warmed before the
+  // first inference instead of faulting on demand. The range is clamped to
+  // the mapping. Returns false if the hint could not be applied or the
+  // platform does not support it.
+  bool Prefault(size_t offset, size_t length) const;
+
+  // Returns the number of bytes of the mapping currently resident in physical
+  // memory, or -1 if residency cannot be queried on this platform. Sampling
+  // this around invocations shows how much of the model is paged in and
+  // whether weight regions thrash under memory pressure.
+  int64_t BytesResident() const;
+
   static bool IsSupported();
 
  protected:
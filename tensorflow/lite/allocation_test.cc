@@ -20,6 +20,7 @@ limitations under the License.
 
 #include <sys/stat.h>
 
+#include <cstdint>
 #include <string>
 
 #include <gtest/gtest.h>
@@ -52,6 +53,34 @@ TEST(MMAPAllocation, TestValidFile) {
   EXPECT_NE(allocation.base(), nullptr);
 }
 
+TEST(MMAPAllocation, TestPrefaultAndResidency) {
+  if (!MMAPAllocation::IsSupported()) {
+    return;
+  }
+
+  TestErrorReporter error_reporter;
+  MMAPAllocation allocation(
+      "tensorflow/lite/testdata/empty_model.bin", &error_reporter);
+  ASSERT_TRUE(allocation.valid());
+
+  EXPECT_TRUE(allocation.Prefault(/*offset=*/0, /*length=*/allocation.bytes()));
+  // A range clamped to the mapping is still a valid hint; one past the end is
+  // not.
+  EXPECT_TRUE(
+      allocation.Prefault(/*offset=*/0, /*length=*/allocation.bytes() + 100));
+  EXPECT_FALSE(allocation.Prefault(/*offset=*/allocation.bytes(),
+                                   /*length=*/1));
+
+  // After touching the mapping (done above by mmap of a tiny file plus the
+  // prefault hint), some bytes should be reported resident on platforms where
+  // mincore is available.
+  const int64_t resident = allocation.BytesResident();
+  if (resident >= 0) {
+    // Residency is reported in whole pages but clamped to the mapping size.
+    EXPECT_LE(resident, static_cast<int64_t>(allocation.bytes()));
+  }
+}
+
 #if defined(__linux__)
 TEST(MMAPAllocation, TestInvalidFileDescriptor) {
   if (!MMAPAllocation::IsSupported()) {
@@ -52,6 +52,22 @@ ArenaPlanner::~ArenaPlanner() {
   persistent_arena_.ReleaseBuffer();
 }
 
+TfLiteStatus ArenaPlanner::DeclareInvocationSequence(
+    const std::vector<std::pair<int32_t, int32_t>>& phases) {
+  const int32_t num_execution_nodes =
+      static_cast<int32_t>(graph_info_->num_execution_nodes());
+  for (size_t i = 0; i < phases.size(); ++i) {
+    TF_LITE_ENSURE(context_, phases[i].first >= 0);
+    TF_LITE_ENSURE(context_, phases[i].first <= phases[i].second);
+    TF_LITE_ENSURE(context_, phases[i].second < num_execution_nodes);
+    if (i > 0) {
+      TF_LITE_ENSURE(context_, phases[i].first > phases[i - 1].second);
+    }
+  }
+  invocation_phases_ = phases;
+  return kTfLiteOk;
+}
+
 std::intptr_t ArenaPlanner::BasePointer(TfLiteAllocationType type) {
   if (type == kTfLiteArenaRwPersistent) {
     return persistent_arena_.BasePointer();
@@ -201,6 +217,43 @@ void ArenaPlanner::IdentifyInPlaceTensors() {
   }
 }
 
+void ArenaPlanner::IdentifyPhaseScopedVariables() {
+  phase_scoped_variables_.clear();
+  // With fewer than two phases there is no later phase whose transient
+  // tensors could reuse a variable's storage. When all tensors are preserved
+  // nothing may be overlapped, variables included.
+  if (invocation_phases_.size() < 2 || preserve_all_tensors_) return;
+
+  // Last node that reads or writes each tensor.
+  std::vector<int32_t> last_use(graph_info_->num_tensors(), -1);
+  const int num_execution_nodes = graph_info_->num_execution_nodes();
+  for (int i = 0; i < num_execution_nodes; ++i) {
+    const TfLiteNode& node = graph_info_->node(i);
+    for (int j = 0; j < node.inputs->size; ++j) {
+      const int tensor_index = node.inputs->data[j];
+      if (tensor_index != kTfLiteOptionalTensor) last_use[tensor_index] = i;
+    }
+    for (int j = 0; j < node.outputs->size; ++j) {
+      const int tensor_index = node.outputs->data[j];
+      if (tensor_index != kTfLiteOptionalTensor) last_use[tensor_index] = i;
+    }
+  }
+
+  for (int tensor_index : graph_info_->variables()) {
+    const int32_t last = last_use[tensor_index];
+    if (last < 0) continue;
+    // Find the first phase ending at or after the last use; once that phase
+    // is over the variable is never touched again. Variables still live in
+    // the final phase keep their unbounded persistent lifetime.
+    for (size_t i = 0; i + 1 < invocation_phases_.size(); ++i) {
+      if (last <= invocation_phases_[i].second) {
+        phase_scoped_variables_[tensor_index] = invocation_phases_[i].second;
+        break;
+      }
+    }
+  }
+}
+
 TfLiteStatus ArenaPlanner::PlanAllocations() {
   // Invalidate any existing data.
   const size_t num_tensors = graph_info_->num_tensors();
@@ -247,6 +300,7 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
 
   // Variable tensors also should be ensured to be never overwritten and need to
   // be alive all the time.
+  IdentifyPhaseScopedVariables();
   for (int tensor_index : graph_info_->variables()) {
     // Increase the reference count for variable tensors by one, so it will
     // never be deallocated.
@@ -257,6 +311,13 @@ TfLiteStatus ArenaPlanner::PlanAllocations() {
     // Variable tensor should be allocated at the very beginning.
     TF_LITE_ENSURE_STATUS(allocate(0, tensor_index));
     nodes_to_tensors_[0].insert(tensor_index);
+    // A declared invocation sequence bounds the lifetime of variables whose
+    // last use falls in a non-final phase; the refcount above still keeps
+    // them from being deallocated by the planning loop below.
+    auto phase_scoped_it = phase_scoped_variables_.find(tensor_index);
+    if (phase_scoped_it != phase_scoped_variables_.end()) {
+      dealloc_node_[tensor_index] = phase_scoped_it->second;
+    }
   }
 
   // Queue all graph inputs for allocation and make sure they are never
@@ -389,7 +450,7 @@ TfLiteStatus ArenaPlanner::ReleaseNonPersistentMemory() {
   TfLiteTensor* tensors = graph_info_->tensors();
   for (int i = 0; i < static_cast<int>(graph_info_->num_tensors()); ++i) {
     TfLiteTensor& tensor = tensors[i];
-    if (tensor.allocation_type == kTfLiteArenaRw) {
+    if (tensor.allocation_type == kTfLiteArenaRw || IsPhaseScopedVariable(i)) {
       tensor.data.raw = nullptr;
     }
   }
@@ -405,7 +466,7 @@ TfLiteStatus ArenaPlanner::AcquireNonPersistentMemory() {
   TfLiteTensor* tensors = graph_info_->tensors();
   for (int i = 0; i < static_cast<int>(graph_info_->num_tensors()); ++i) {
     TfLiteTensor& tensor = tensors[i];
-    if (tensor.allocation_type == kTfLiteArenaRw) {
+    if (tensor.allocation_type == kTfLiteArenaRw || IsPhaseScopedVariable(i)) {
       TF_LITE_ENSURE_STATUS(ResolveTensorAllocation(i, tensors));
     }
   }
@@ -495,8 +556,11 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
   TfLiteTensor* tensors = graph_info_->tensors();
   for (const auto& tensor_index : tensors_to_allocate) {
     TfLiteTensor& tensor = tensors[tensor_index];
-    // Only arena allocated tensors are allocated here.
-    if (tensor.allocation_type == kTfLiteArenaRw) {
+    // Only arena allocated tensors are allocated here. Phase-scoped
+    // variables are planned in the non-persistent arena despite their
+    // persistent allocation type.
+    if (tensor.allocation_type == kTfLiteArenaRw ||
+        IsPhaseScopedVariable(tensor_index)) {
       if (allocs_[tensor_index].size < tensor.bytes) {
         tensors_allocated->push_back(tensor_index);
       }
@@ -540,7 +604,8 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
         continue;
       }
     }
-    if (tensor.allocation_type == kTfLiteArenaRw) {
+    if (tensor.allocation_type == kTfLiteArenaRw ||
+        IsPhaseScopedVariable(tensor_index)) {
       TF_LITE_ENSURE_STATUS(
           arena_.Allocate(context_, tensor_alignment_, tensor.bytes,
                           tensor_index, alloc_node_[tensor_index],
@@ -549,6 +614,7 @@ TfLiteStatus ArenaPlanner::CalculateAllocations(
     // Check allocs_[].size to prevent from reallocation of persistent tensors.
     // Only allocate ArenaRwPersistent tensors which own their buffer.
     if (tensor.allocation_type == kTfLiteArenaRwPersistent &&
+        !IsPhaseScopedVariable(tensor_index) &&
         allocs_[tensor_index].size == 0) {
       if (allocs_[tensor_index].size < tensor.bytes) {
         TF_LITE_ENSURE_STATUS(persistent_arena_.Allocate(
@@ -596,13 +662,15 @@ TfLiteStatus ArenaPlanner::ResolveTensorAllocation(int32_t tensor_index,
     }
   }
 
-  if (tensor.allocation_type == kTfLiteArenaRw) {
+  if (tensor.allocation_type == kTfLiteArenaRw ||
+      IsPhaseScopedVariable(tensor_index)) {
     // Skip resolution if the size of the tensor is zero, leaving it as a
     // nullptr.
     if (allocs_[tensor_index].size != 0) {
       return arena_.ResolveAlloc(context_, allocs_[tensor_index],
                                  &tensor.data.raw);
     }
+    return kTfLiteOk;
   }
   if (tensor.allocation_type == kTfLiteArenaRwPersistent) {
     return persistent_arena_.ResolveAlloc(context_, allocs_[tensor_index],
@@ -20,6 +20,7 @@ limitations under the License.
 #include <memory>
 #include <unordered_map>
 #include <unordered_set>
+#include <utility>
 #include <vector>
 
 #include "tensorflow/lite/core/c/common.h"
@@ -58,6 +59,19 @@ class ArenaPlanner : public MemoryPlanner {
   ArenaPlanner(const ArenaPlanner&) = delete;
   ArenaPlanner& operator=(const ArenaPlanner&) = delete;
 
+  // Declares that the graph is executed as an ordered sequence of phases,
+  // each a contiguous range [first_node, last_node] of the execution plan.
+  // Phases may be invoked repeatedly, but once execution has moved on to a
+  // later phase an earlier phase never runs again (e.g. prefill followed by
+  // repeated decode in streaming models). Variable tensors whose last use
+  // falls in a non-final phase are then planned in the non-persistent arena
+  // with a lifetime ending at that phase, so transient tensors of later
+  // phases may overlap their storage. Must be called before
+  // `PlanAllocations`. Phases must be in increasing node order and
+  // non-overlapping.
+  TfLiteStatus DeclareInvocationSequence(
+      const std::vector<std::pair<int32_t, int32_t>>& phases);
+
   TfLiteStatus ResetAllocations() override;
   TfLiteStatus ResetAllocationsAfter(int node) override;
   TfLiteStatus PlanAllocations() override;
@@ -120,6 +134,17 @@ class ArenaPlanner : public MemoryPlanner {
   // Return the index of the tensor owing `tensor_index's` buffer.
   int FindSharedTensor(int tensor_index);
 
+  // Populates `phase_scoped_variables_` from the declared invocation
+  // sequence: variable tensors whose uses all fall in phases before the
+  // final one, together with the node after which each may be overwritten.
+  void IdentifyPhaseScopedVariables();
+
+  // True if the variable tensor was demoted to the non-persistent arena by
+  // the declared invocation sequence.
+  bool IsPhaseScopedVariable(int32_t tensor_index) const {
+    return phase_scoped_variables_.count(tensor_index) != 0;
+  }
+
   TfLiteContext* context_;
   std::unique_ptr<GraphInfo> graph_info_;
 
@@ -166,6 +191,17 @@ class ArenaPlanner : public MemoryPlanner {
 
   // Store number of references to each tensor.
   std::vector<int> refcounts_;
+
+  // Ordered node ranges declared via `DeclareInvocationSequence`. Empty when
+  // no sequence has been declared, in which case variable tensors keep their
+  // unbounded persistent-arena lifetime.
+  std::vector<std::pair<int32_t, int32_t>> invocation_phases_;
+
+  // Variable tensors demoted to the non-persistent arena because their last
+  // use falls in a non-final phase, mapped to the node after which their
+  // storage may be reused.
+  // NOLINTNEXTLINE - absl::flat_hash_map increases binary size by 106kB.
+  std::unordered_map<int32_t, int32_t> phase_scoped_variables_;
 };
 
 }  // namespace tflite
@@ -218,6 +218,19 @@ class ArenaPlannerTest : public ::testing::Test {
     CHECK(planner_->PlanAllocations() == kTfLiteOk);
   }
 
+  void SetGraphWithInvocationSequence(
+      TestGraph* graph, const std::vector<std::pair<int32_t, int32_t>>& phases,
+      bool preserve_all_tensors = false) {
+    graph_ = graph;
+    context_.ReportError = ReportError;
+    planner_ = std::make_unique<ArenaPlanner>(
+        &context_, std::unique_ptr<GraphInfo>(new TestGraphInfo(graph)),
+        preserve_all_tensors, kTensorAlignment);
+    CHECK(planner_->ResetAllocations() == kTfLiteOk);
+    CHECK(planner_->DeclareInvocationSequence(phases) == kTfLiteOk);
+    CHECK(planner_->PlanAllocations() == kTfLiteOk);
+  }
+
   void SwapGraph(TestGraph* graph) {
     graph_->Swap(graph);
     CHECK(planner_->PlanAllocations() == kTfLiteOk);
@@ -786,6 +799,90 @@ TEST_F(ArenaPlannerTest, SimpleGraphWithPersistentTensor) {
   EXPECT_EQ(GetOffset(1), 0);
 }
 
+TEST_F(ArenaPlannerTest, InvocationSequencePhaseScopedVariable) {
+  TestGraph graph({0},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {3}, {}},  // Prefill phase.
+                      {{3}, {4}, {}},     //
+                      {{4}, {5}, {}},     // Decode phase.
+                      {{5, 2}, {6}, {}}   //
+                  },
+                  {6});
+
+  // #1 and #2 are state tensors; #1 is only read during prefill while #2
+  // carries state across decode invocations.
+  (*graph.tensors())[1].allocation_type = kTfLiteArenaRwPersistent;
+  (*graph.tensors())[2].allocation_type = kTfLiteArenaRwPersistent;
+  graph.SetVariables({1, 2});
+  (*graph.tensors())[1].bytes = 1000;
+  (*graph.tensors())[5].bytes = 1000;
+
+  SetGraphWithInvocationSequence(&graph, {{0, 1}, {2, 3}});
+  Execute(0, graph.nodes().size() - 1);
+
+  // The prefill-only state tensor is planned in the non-persistent arena and
+  // the decode-phase transient of the same size reuses its storage.
+  EXPECT_NE((*graph.tensors())[1].data.raw, nullptr);
+  EXPECT_EQ((*graph.tensors())[1].data.raw, (*graph.tensors())[5].data.raw);
+
+  // The decode state tensor keeps its place in the persistent arena, which
+  // no longer has to hold the prefill state.
+  EXPECT_EQ(GetOffset(2), 0);
+  size_t arena_size, arena_persist_size;
+  planner_->GetAllocInfo(&arena_size, &arena_persist_size);
+  EXPECT_LT(arena_persist_size, 1000);
+
+  // Phase-scoped state lives in the non-persistent arena, so releasing it
+  // drops the prefill state but not the decode state.
+  ReleaseNonPersistentMemory();
+  EXPECT_TRUE(IsUnallocated(1));
+  EXPECT_FALSE(IsUnallocated(2));
+}
+
+TEST_F(ArenaPlannerTest, InvocationSequenceFinalPhaseVariableStaysPersistent) {
+  TestGraph graph({0},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {3}, {}},  // Prefill phase.
+                      {{3, 1}, {4}, {}},  // Decode phase reads #1 too.
+                  },
+                  {4});
+
+  (*graph.tensors())[1].allocation_type = kTfLiteArenaRwPersistent;
+  graph.SetVariables({1});
+
+  SetGraphWithInvocationSequence(&graph, {{0, 0}, {1, 1}});
+  Execute(0, graph.nodes().size() - 1);
+
+  // #1 is still used in the final phase, so it must survive every decode
+  // invocation and stays in the persistent arena at offset 0.
+  EXPECT_EQ(GetOffset(1), 0);
+  size_t arena_size, arena_persist_size;
+  planner_->GetAllocInfo(&arena_size, &arena_persist_size);
+  EXPECT_GE(arena_persist_size, (*graph.tensors())[1].bytes);
+}
+
+TEST_F(ArenaPlannerTest, InvocationSequenceRejectsInvalidPhases) {
+  TestGraph graph({0, 1},
+                  {
+                      /* in, out, tmp */
+                      {{0, 1}, {2}, {}},
+                      {{2}, {3}, {}},
+                  },
+                  {3});
+  SetGraph(&graph);
+
+  // Reversed range.
+  EXPECT_EQ(planner_->DeclareInvocationSequence({{1, 0}}), kTfLiteError);
+  // Overlapping phases.
+  EXPECT_EQ(planner_->DeclareInvocationSequence({{0, 1}, {1, 1}}),
+            kTfLiteError);
+  // Out of range.
+  EXPECT_EQ(planner_->DeclareInvocationSequence({{0, 2}}), kTfLiteError);
+  EXPECT_EQ(planner_->DeclareInvocationSequence({{0, 0}, {1, 1}}), kTfLiteOk);
+}
+
 TEST_F(ArenaPlannerTest, SimpleGraphWithDynamicTensor) {
   TestGraph graph({0, -1, 1},
                   {
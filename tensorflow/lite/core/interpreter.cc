@@ -253,6 +253,44 @@ TfLiteStatus Interpreter::Invoke() {
   return kTfLiteOk;
 }
 
+TfLiteStatus Interpreter::InvokeBatch(
+    size_t invocation_count,
+    const std::function<TfLiteStatus(size_t)>& prepare_inputs,
+    const std::function<TfLiteStatus(size_t)>& consume_outputs) {
+  if (!prepare_inputs || !consume_outputs) {
+    context_->ReportError(
+        context_, "InvokeBatch requires non-null input and output callbacks.");
+    return kTfLiteError;
+  }
+
+  ScopedRuntimeInstrumentationProfile scoped_runtime_event(root_profiler_.get(),
+                                                           "invoke batch");
+
+  // The cancellation flag is reset once for the whole batch; a cancellation
+  // requested mid-batch aborts the remaining invocations.
+  if (cancellation_enabled_) (void)continue_invocation_.test_and_set();
+
+  ruy::ScopedSuppressDenormals suppress_denormals;
+
+  for (size_t i = 0; i < invocation_count; ++i) {
+    TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(scoped_runtime_event,
+                                                      prepare_inputs(i));
+    TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(
+        scoped_runtime_event, primary_subgraph().Invoke());
+    if (!allow_buffer_handle_output_) {
+      for (int tensor_index : outputs()) {
+        TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(
+            scoped_runtime_event,
+            primary_subgraph().EnsureTensorDataIsReadable(tensor_index));
+      }
+    }
+    TF_LITE_ENSURE_STATUS_WITH_SCOPED_INSTRUMENTATION(scoped_runtime_event,
+                                                      consume_outputs(i));
+  }
+
+  return kTfLiteOk;
+}
+
 TfLiteStatus Interpreter::AddTensors(int tensors_to_add,
                                      int* first_new_tensor_index) {
   return primary_subgraph().AddTensors(tensors_to_add, first_new_tensor_index);
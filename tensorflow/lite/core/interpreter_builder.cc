@@ -47,6 +47,7 @@ limitations under the License.
 #include "tensorflow/lite/schema/schema_utils.h"
 #include "tensorflow/lite/shared_library.h"
 #include "tensorflow/lite/stderr_reporter.h"
+#include "tensorflow/lite/tflite_with_xnnpack_optional.h"
 #include "tensorflow/lite/util.h"
 #include "tensorflow/lite/version.h"
 
@@ -743,6 +744,19 @@ TfLiteStatus InterpreterBuilder::SetNumThreads(int num_threads) {
   return kTfLiteOk;
 }
 
+TfLiteStatus InterpreterBuilder::SetPersistentCacheParams(
+    const char* cache_dir, const char* model_token) {
+  if (!cache_dir || cache_dir[0] == '\0' || !model_token ||
+      model_token[0] == '\0') {
+    TF_LITE_REPORT_ERROR(error_reporter_,
+                         "Both cache_dir and model_token must be non-empty.");
+    return kTfLiteError;
+  }
+  persistent_cache_dir_ = cache_dir;
+  persistent_cache_token_ = model_token;
+  return kTfLiteOk;
+}
+
 TfLiteStatus InterpreterBuilder::operator()(
     std::unique_ptr<Interpreter>* interpreter, int num_threads) {
   TfLiteStatus status = SetNumThreads(num_threads);
@@ -887,6 +901,26 @@ TfLiteStatus InterpreterBuilder::operator()(
   if (ShouldCreateLazyDelegateProviders(num_fp32_tensors_)) {
     (*interpreter)->lazy_delegate_providers_ =
         op_resolver_.GetDelegateCreators();
+    auto& providers = (*interpreter)->lazy_delegate_providers_;
+    if (!persistent_cache_dir_.empty() && !providers.empty()) {
+      // Delegate creators are applied in order, so inserting a cache-aware
+      // XNNPACK creator up front lets it claim its ops before the resolver's
+      // default creator runs; the latter then finds nothing left to delegate.
+      // Resolvers that opt out of default delegates supply no creators and
+      // are left untouched. The cache file name carries the model token so a
+      // single cache directory can serve multiple models.
+      std::string weight_cache_path = persistent_cache_dir_ + "/" +
+                                      persistent_cache_token_ +
+                                      ".xnnpack_weights";
+      providers.insert(
+          providers.begin(),
+          [weight_cache_path = std::move(weight_cache_path)](
+              TfLiteContext* context) {
+            return MaybeCreateXNNPACKDelegate(
+                context, XNNPackQS8Options::default_value,
+                weight_cache_path.c_str());
+          });
+    }
   }
 
   if (telemetry_registered) {
@@ -127,6 +127,26 @@ class InterpreterBuilder {
     telemetry_profiler_ = std::move(profiler);
   }
 
+  /// Enables an on-disk cache for compiled delegate artifacts so repeated
+  /// process starts skip recompilation. Currently this points the default
+  /// XNNPACK delegate (when the build links it and the op resolver supplies
+  /// default delegate creators) at a persistent weight cache under
+  /// `cache_dir`. Delegates added with AddDelegate configure their own
+  /// caching; GPU program and partitioning caches keyed through
+  /// `delegates::Serialization` should reuse the same `cache_dir` and
+  /// `model_token` so all artifacts for a model live together.
+  /// * `cache_dir`: an existing, writable directory; cache files are created
+  ///   inside it and reused across runs.
+  /// * `model_token`: uniquely identifies the model contents, e.g. a
+  ///   fingerprint of the flatbuffer (see `delegates::StrFingerprint()`).
+  ///   Stale caches from a changed model are detected by the delegate, but a
+  ///   distinct token per model avoids mixing artifacts in one file.
+  /// Both arguments are copied. Returns kTfLiteError if either is null or
+  /// empty.
+  /// WARNING: This is an experimental API and subject to change.
+  TfLiteStatus SetPersistentCacheParams(const char* cache_dir,
+                                        const char* model_token);
+
  private:
   TfLiteStatus BuildLocalIndexToRegistrationMapping();
   TfLiteStatus ParseNodes(
@@ -167,6 +187,9 @@ class InterpreterBuilder {
   int num_fp32_tensors_ = 0;
   int num_threads_ = -1;
   InterpreterOptions options_;
+  // Both empty unless SetPersistentCacheParams() was called.
+  std::string persistent_cache_dir_;
+  std::string persistent_cache_token_;
 
   std::unique_ptr<telemetry::TelemetryProfiler> telemetry_profiler_;
 };
@@ -333,6 +333,29 @@ TEST(BasicFlatBufferModel, TestSetNumThreads) {
                       reporter.error_messages());
 }
 
+TEST(BasicFlatBufferModel, TestSetPersistentCacheParams) {
+  TestErrorReporter reporter;
+  auto model = FlatBufferModel::BuildFromFile(
+      "tensorflow/lite/testdata/test_model.bin", &reporter);
+  ASSERT_TRUE(model);
+  std::unique_ptr<Interpreter> interpreter;
+  TrivialResolver resolver(&dummy_reg);
+  InterpreterBuilder builder(*model, resolver);
+
+  ASSERT_EQ(builder.SetPersistentCacheParams(nullptr, "token"), kTfLiteError);
+  ASSERT_EQ(builder.SetPersistentCacheParams("/tmp/cache", ""), kTfLiteError);
+  ASSERT_EQ(reporter.num_calls(), 2);
+  ASSERT_PRED_FORMAT2(testing::IsSubstring,
+                      "Both cache_dir and model_token must be non-empty",
+                      reporter.error_messages());
+
+  // A configured cache must not break interpreter construction, with or
+  // without default delegate creators available in the build.
+  ASSERT_EQ(builder.SetPersistentCacheParams("/tmp/cache", "token"), kTfLiteOk);
+  ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+  ASSERT_NE(interpreter, nullptr);
+}
+
 TEST(BasicFlatBufferModel, TestSetNumThreadsWithMultipleSubgraphs) {
   TestErrorReporter reporter;
   auto model = FlatBufferModel::BuildFromFile(
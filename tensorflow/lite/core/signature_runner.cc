@@ -115,6 +115,58 @@ TfLiteStatus SignatureRunner::Invoke() {
   return kTfLiteOk;
 }
 
+TfLiteStatus SignatureRunner::BindBufferToTensor(int tensor_index, void* data,
+                                                 size_t bytes, int64_t flags) {
+  const TfLiteTensor* tensor = subgraph_->tensor(tensor_index);
+  if (tensor == nullptr) {
+    subgraph_->ReportError("Invalid tensor index %d", tensor_index);
+    return kTfLiteError;
+  }
+  if (tensor->allocation_type == kTfLiteDynamic) {
+    subgraph_->ReportError(
+        "Tensor %d is dynamically sized and owns its buffer; it cannot be "
+        "bound to a caller-owned buffer",
+        tensor_index);
+    return kTfLiteError;
+  }
+  // When the tensor size is known, validate the buffer here so that
+  // re-binding between invocations needs no AllocateTensors() call; the
+  // binding only swaps the tensor's data pointer and leaves the memory plan
+  // untouched. A size of zero means the shape is not resolved yet, in which
+  // case the next AllocateTensors() verifies the buffer instead.
+  if (tensor->bytes > 0 && bytes < tensor->bytes) {
+    subgraph_->ReportError(
+        "Buffer of %zu bytes is too small for tensor %d of %zu bytes",
+        bytes, tensor_index, tensor->bytes);
+    return kTfLiteError;
+  }
+  TfLiteCustomAllocation allocation = {data, bytes};
+  return subgraph_->SetCustomAllocationForTensor(tensor_index, allocation,
+                                                 flags);
+}
+
+TfLiteStatus SignatureRunner::BindInputBuffer(const char* input_name,
+                                              void* data, size_t bytes,
+                                              int64_t flags) {
+  const auto& it = signature_def_->inputs.find(input_name);
+  if (it == signature_def_->inputs.end()) {
+    subgraph_->ReportError("Input name %s was not found", input_name);
+    return kTfLiteError;
+  }
+  return BindBufferToTensor(it->second, data, bytes, flags);
+}
+
+TfLiteStatus SignatureRunner::BindOutputBuffer(const char* output_name,
+                                               void* data, size_t bytes,
+                                               int64_t flags) {
+  const auto& it = signature_def_->outputs.find(output_name);
+  if (it == signature_def_->outputs.end()) {
+    subgraph_->ReportError("Output name %s was not found", output_name);
+    return kTfLiteError;
+  }
+  return BindBufferToTensor(it->second, data, bytes, flags);
+}
+
 TfLiteStatus SignatureRunner::SetCustomAllocationForInputTensor(
     const char* input_name, const TfLiteCustomAllocation& allocation,
     int64_t flags) {
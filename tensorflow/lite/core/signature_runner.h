@@ -207,6 +207,34 @@ class SignatureRunner {
       const char* output_name, const TfLiteCustomAllocation& allocation,
       int64_t flags = kTfLiteCustomAllocationFlagsNone);
 
+  /// \brief Binds a caller-owned buffer to the named signature input.
+  /// The runtime reads the input directly from `data` instead of copying it
+  /// into an arena tensor; the buffer must stay valid and unchanged until
+  /// the invocation completes. `data` must be aligned to
+  /// kDefaultTensorAlignment defined in lite/util.h (currently 64 bytes)
+  /// unless kTfLiteCustomAllocationFlagsSkipAlignCheck is set in `flags`.
+  ///
+  /// If the tensor's size is already known (the usual case once
+  /// AllocateTensors() has run and the shape is static), `bytes` is
+  /// validated here and the binding takes effect immediately: re-binding a
+  /// different buffer between invocations requires no AllocateTensors()
+  /// call and does not disturb the memory plan. Binding a tensor whose size
+  /// is not yet known is validated by the next AllocateTensors() instead.
+  /// Tensors with dynamically sized output (kTfLiteDynamic) own their
+  /// buffers and cannot be bound.
+  /// \warning This is an experimental API and subject to change. \n
+  TfLiteStatus BindInputBuffer(
+      const char* input_name, void* data, size_t bytes,
+      int64_t flags = kTfLiteCustomAllocationFlagsNone);
+
+  /// \brief Binds a caller-owned buffer to the named signature output.
+  /// The graph writes the output directly into `data`; the same validation,
+  /// alignment and re-binding rules as `BindInputBuffer` apply.
+  /// \warning This is an experimental API and subject to change. \n
+  TfLiteStatus BindOutputBuffer(
+      const char* output_name, void* data, size_t bytes,
+      int64_t flags = kTfLiteCustomAllocationFlagsNone);
+
   /// \brief Set if buffer handle output is allowed.
   ///
   /// When using hardware delegation, Interpreter will make the data of output
@@ -245,6 +273,12 @@ class SignatureRunner {
   // SignatureRunner objects don't outlive their corresponding Subgraph objects.
   SignatureRunner(const internal::SignatureDef* signature_def,
                   Subgraph* subgraph);
+
+  // Shared implementation of `BindInputBuffer` and `BindOutputBuffer`:
+  // validates `bytes` against the tensor size when it is known and installs
+  // the buffer as a custom allocation.
+  TfLiteStatus BindBufferToTensor(int tensor_index, void* data, size_t bytes,
+                                  int64_t flags);
   friend class ::tflite::impl::Interpreter;
   friend class ::tflite::SignatureRunnerHelper;
   friend class ::tflite::SignatureRunnerJNIHelper;
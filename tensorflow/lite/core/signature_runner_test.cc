@@ -96,6 +96,57 @@ TEST(SignatureRunnerTest, TestMultiSignatures) {
   ASSERT_EQ(sub_output->data.f[2], 3);
 }
 
+TEST(SignatureRunnerTest, TestBindCallerOwnedBuffers) {
+  TestErrorReporter reporter;
+  auto model = FlatBufferModel::BuildFromFile(
+      "tensorflow/lite/testdata/multi_signatures.bin", &reporter);
+  ASSERT_TRUE(model);
+  ops::builtin::BuiltinOpResolver resolver;
+  InterpreterBuilder builder(*model, resolver);
+
+  std::unique_ptr<Interpreter> interpreter;
+  ASSERT_EQ(builder(&interpreter), kTfLiteOk);
+  ASSERT_NE(interpreter, nullptr);
+
+  SignatureRunner* add_runner = interpreter->GetSignatureRunner("add");
+  ASSERT_NE(add_runner, nullptr);
+  ASSERT_EQ(add_runner->ResizeInputTensor("x", {2}), kTfLiteOk);
+
+  alignas(64) float input_a[2] = {1, 2};
+  alignas(64) float output_a[2] = {0, 0};
+  ASSERT_EQ(add_runner->BindInputBuffer("x", input_a, sizeof(input_a)),
+            kTfLiteOk);
+  ASSERT_EQ(
+      add_runner->BindOutputBuffer("output_0", output_a, sizeof(output_a)),
+      kTfLiteOk);
+  ASSERT_EQ(add_runner->AllocateTensors(), kTfLiteOk);
+  ASSERT_EQ(add_runner->Invoke(), kTfLiteOk);
+  ASSERT_EQ(output_a[0], 3);
+  ASSERT_EQ(output_a[1], 4);
+
+  // Re-binding fresh buffers between invocations needs no AllocateTensors().
+  alignas(64) float input_b[2] = {10, 20};
+  alignas(64) float output_b[2] = {0, 0};
+  ASSERT_EQ(add_runner->BindInputBuffer("x", input_b, sizeof(input_b)),
+            kTfLiteOk);
+  ASSERT_EQ(
+      add_runner->BindOutputBuffer("output_0", output_b, sizeof(output_b)),
+      kTfLiteOk);
+  ASSERT_EQ(add_runner->Invoke(), kTfLiteOk);
+  ASSERT_EQ(output_b[0], 12);
+  ASSERT_EQ(output_b[1], 22);
+  // The previously bound buffers are not touched by the second invocation.
+  ASSERT_EQ(input_a[0], 1);
+  ASSERT_EQ(output_a[0], 3);
+
+  // Undersized buffers and unknown names are rejected immediately.
+  alignas(64) float small[1];
+  ASSERT_EQ(add_runner->BindInputBuffer("x", small, sizeof(small)),
+            kTfLiteError);
+  ASSERT_EQ(add_runner->BindInputBuffer("dummy", input_b, sizeof(input_b)),
+            kTfLiteError);
+}
+
 }  // namespace
 }  // namespace impl
 }  // namespace tflite
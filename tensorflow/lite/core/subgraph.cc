@@ -25,6 +25,7 @@ limitations under the License.
 #include <iterator>
 #include <memory>
 #include <string>
+#include <thread>  // NOLINT(build/c++11)
 #include <unordered_set>
 #include <utility>
 #include <vector>
@@ -567,6 +568,7 @@ TfLiteStatus Subgraph::ReplaceNodeSubsetsWithDelegateKernels(
                   GetDelegateKernalName(registration), node_subsets.size());
 
   execution_plan_.clear();
+  parallel_tracks_valid_ = false;
 
   for (auto& node_subset : node_subsets) {
     // Subsets claimed by the delegate should have a "macro" op created, the
@@ -1136,6 +1138,7 @@ TfLiteStatus Subgraph::AddNodeWithParameters(
   // Copying of registration is required to support unresolved custom ops.
   node_and_reg.second = *registration;
   execution_plan_.push_back(new_node_index);
+  parallel_tracks_valid_ = false;
   return kTfLiteOk;
 }
 
@@ -1615,6 +1618,187 @@ TfLiteStatus Subgraph::RemoveUnusedInputs() {
   return kTfLiteOk;
 }
 
+TfLiteStatus Subgraph::PartitionExecutionPlanIntoTracks() {
+  parallel_tracks_.clear();
+  parallel_tracks_applicable_ = false;
+  parallel_tracks_valid_ = true;
+
+  const int num_plan_nodes = static_cast<int>(execution_plan_.size());
+  if (num_plan_nodes < 2) return kTfLiteOk;
+
+  // Union-find over execution plan positions: every node is joined with the
+  // producers of its inputs, so the resulting groups ("tracks") have no data
+  // dependency on one another.
+  std::vector<int> parent(num_plan_nodes);
+  for (int i = 0; i < num_plan_nodes; ++i) parent[i] = i;
+  const auto find_root = [&parent](int i) {
+    while (parent[i] != i) {
+      parent[i] = parent[parent[i]];
+      i = parent[i];
+    }
+    return i;
+  };
+
+  // Plan position of the node producing each tensor, or -1.
+  std::vector<int> tensor_producer(tensors_.size(), -1);
+  for (int i = 0; i < num_plan_nodes; ++i) {
+    const int node_index = execution_plan_[i];
+    const TfLiteNode& node = nodes_and_registration_[node_index].first;
+    const TfLiteRegistration& registration =
+        nodes_and_registration_[node_index].second;
+    // Ops whose effects reach beyond their own inputs and outputs (other
+    // subgraphs, resources, arbitrary custom state) may not run concurrently
+    // with anything; the whole plan stays sequential.
+    switch (registration.builtin_code) {
+      case kTfLiteBuiltinCustom:
+      case kTfLiteBuiltinIf:
+      case kTfLiteBuiltinWhile:
+      case kTfLiteBuiltinCallOnce:
+      case kTfLiteBuiltinVarHandle:
+      case kTfLiteBuiltinReadVariable:
+      case kTfLiteBuiltinAssignVariable:
+        return kTfLiteOk;
+      default:
+        break;
+    }
+    if (node.delegate != nullptr || node.might_have_side_effect) {
+      return kTfLiteOk;
+    }
+    for (int j = 0; j < node.inputs->size; ++j) {
+      const int tensor_index = node.inputs->data[j];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const TfLiteType type = tensors_[tensor_index].type;
+      if (type == kTfLiteResource || type == kTfLiteVariant) return kTfLiteOk;
+      const int producer = tensor_producer[tensor_index];
+      if (producer >= 0) {
+        parent[find_root(i)] = find_root(producer);
+      }
+    }
+    for (int j = 0; j < node.outputs->size; ++j) {
+      const int tensor_index = node.outputs->data[j];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      tensor_producer[tensor_index] = i;
+    }
+  }
+
+  // Group plan positions by root, keeping plan order within each track.
+  std::vector<int> root_to_track(num_plan_nodes, -1);
+  for (int i = 0; i < num_plan_nodes; ++i) {
+    const int root = find_root(i);
+    if (root_to_track[root] < 0) {
+      root_to_track[root] = static_cast<int>(parallel_tracks_.size());
+      parallel_tracks_.emplace_back();
+    }
+    parallel_tracks_[root_to_track[root]].push_back(execution_plan_[i]);
+  }
+  parallel_tracks_applicable_ = parallel_tracks_.size() > 1;
+  return kTfLiteOk;
+}
+
+bool Subgraph::ParallelInvokeApplicable() {
+  if (!ShouldRunParallelBranchInvoke() || !ShouldPreserveAllTensors()) {
+    // Without preserved tensors the memory planner may overlap the storage
+    // of tensors whose node lifetimes are disjoint, which no longer implies
+    // temporal disjointness once tracks run concurrently.
+    return false;
+  }
+  // Dynamic tensors and partially prepared plans need the sequential path's
+  // re-planning machinery.
+  if (has_dynamic_tensors_ ||
+      next_execution_plan_index_to_prepare_ <
+          static_cast<int>(execution_plan_.size())) {
+    return false;
+  }
+  if (!delegates_applied_.empty()) return false;
+  if (!parallel_tracks_valid_) {
+    if (PartitionExecutionPlanIntoTracks() != kTfLiteOk) return false;
+  }
+  return parallel_tracks_applicable_;
+}
+
+TfLiteStatus Subgraph::InvokeTrack(const std::vector<int>& track) {
+  for (int node_index : track) {
+    TfLiteNode& node = nodes_and_registration_[node_index].first;
+    const TfLiteRegistration& registration =
+        nodes_and_registration_[node_index].second;
+
+    for (int i = 0; i < node.inputs->size; ++i) {
+      const int tensor_index = node.inputs->data[i];
+      if (tensor_index == kTfLiteOptionalTensor) continue;
+      const TfLiteTensor* tensor = &tensors_[tensor_index];
+      if (tensor->data.raw == nullptr && tensor->bytes > 0) {
+        if (registration.builtin_code == kTfLiteBuiltinReshape && i == 1 &&
+            tensor->dims->size != 1) {
+          // The second input of RESHAPE may legitimately carry only shape
+          // information; see the sequential path for details.
+          continue;
+        }
+        ReportError("Input tensor %d lacks data", tensor_index);
+        return kTfLiteError;
+      }
+    }
+
+    if (check_cancelled_func_ != nullptr &&
+        check_cancelled_func_(cancellation_data_)) {
+      ReportError("Client requested cancel during Invoke()");
+      return kTfLiteError;
+    }
+    if (continue_invocation_ && !continue_invocation_->test_and_set()) {
+      ReportError("Client requested cancel during Invoke()");
+      return kTfLiteCancelled;
+    }
+
+    if (auto s = OpInvoke(registration, &node); s != kTfLiteOk) {
+      return s == kTfLiteCancelled
+                 ? s
+                 : ReportOpError(&context_, node, registration, node_index,
+                                 "failed to invoke");
+    }
+
+    // Eligibility checks exclude dynamic tensors, so a mid-invocation resize
+    // cannot be replanned here.
+    if (HasDynamicTensor(context_, node.outputs, nullptr)) {
+      ReportError(
+          "Node %d resized a tensor during parallel invocation; dynamic "
+          "tensors are not supported by parallel branch execution",
+          node_index);
+      return kTfLiteError;
+    }
+  }
+  return kTfLiteOk;
+}
+
+TfLiteStatus Subgraph::InvokeParallelTracks() {
+  // Reserve tensor vector capacity up front so no track triggers a
+  // reallocation of `tensors_` while another is reading it.
+  EnsureTensorsVectorCapacity();
+  tensor_resized_since_op_invoke_ = false;
+
+  // The extra tracks run on dedicated threads rather than the intra-op pool:
+  // kernels on concurrent tracks may themselves fan out onto that pool, and
+  // scheduling the tracks there as well could leave every pool thread
+  // waiting on work behind its own task. Per-op profiling is skipped since
+  // profilers are not required to be thread-safe.
+  const int num_tracks = static_cast<int>(parallel_tracks_.size());
+  std::vector<TfLiteStatus> statuses(num_tracks, kTfLiteOk);
+  std::vector<std::thread> workers;
+  workers.reserve(num_tracks - 1);
+  for (int i = 1; i < num_tracks; ++i) {
+    workers.emplace_back([this, i, &statuses]() {
+      statuses[i] = InvokeTrack(parallel_tracks_[i]);
+    });
+  }
+  statuses[0] = InvokeTrack(parallel_tracks_[0]);
+  for (auto& worker : workers) worker.join();
+
+  TfLiteStatus status = kTfLiteOk;
+  for (TfLiteStatus track_status : statuses) {
+    if (track_status == kTfLiteCancelled) return kTfLiteCancelled;
+    if (track_status != kTfLiteOk) status = track_status;
+  }
+  return status;
+}
+
 TfLiteStatus Subgraph::Invoke() {
   auto status = InvokeImpl();
   telemetry::TelemetryReportEvent(&context_, "Invoke", status);
@@ -1640,6 +1824,17 @@ TfLiteStatus Subgraph::InvokeImpl() {
       tflite::OnTfLiteSubgraphInvoke(name_.c_str(), subgraph_index_);
 #endif  // TF_LITE_TENSORFLOW_PROFILER
 
+  // Independent branches of the plan run concurrently when the experimental
+  // parallel branch mode applies; everything else takes the sequential path
+  // below.
+  if (ParallelInvokeApplicable()) {
+    status = InvokeParallelTracks();
+#ifdef TF_LITE_TENSORFLOW_PROFILER
+    tflite::OnTfLiteSubgraphInvokeEnd(trace_subgraph);
+#endif  // TF_LITE_TENSORFLOW_PROFILER
+    return status;
+  }
+
   // Invocations are always done in node order.
   // Note that calling Invoke repeatedly will cause the original memory plan to
   // be reused, unless either ResizeInputTensor() or AllocateTensors() has been
@@ -1997,6 +2192,7 @@ TfLiteStatus Subgraph::SetExecutionPlan(const std::vector<int>& new_plan) {
                                   node_index < nodes_and_registration_.size());
   }
   execution_plan_ = new_plan;
+  parallel_tracks_valid_ = false;
   return kTfLiteOk;
 }
 
@@ -2134,6 +2330,7 @@ TfLiteStatus Subgraph::UndoAllDelegates() {
 
   // Reset execution plan.
   execution_plan_ = pre_delegation_execution_plan_;
+  parallel_tracks_valid_ = false;
   pre_delegation_execution_plan_.clear();
 
   // Handling FP16 delegation (if applies).
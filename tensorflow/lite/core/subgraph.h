@@ -458,6 +458,13 @@ class Subgraph {
     return (options_ && options_->GetPreserveAllTensors());
   }
 
+  // WARNING: This is an experimental API and subject to change.
+  // True if independent branches of the execution plan should be invoked on
+  // concurrent threads.
+  bool ShouldRunParallelBranchInvoke() const {
+    return (options_ && options_->GetParallelBranchInvoke());
+  }
+
   // WARNING: This is an experimental API and subject to change.
   // True if all intermediate dynamic tensors should be released once they are
   // not used by the model.
@@ -727,6 +734,27 @@ class Subgraph {
   // Does not report invoke status through profiler.
   TfLiteStatus InvokeImpl();
 
+  // Partitions the execution plan into "tracks": maximal groups of nodes
+  // connected through produced tensors. Nodes in different tracks have no
+  // data dependency on each other and may be invoked concurrently. Also
+  // determines whether the plan is eligible for parallel invocation at all
+  // (no control flow, custom ops, variables, resource tensors or delegated
+  // nodes). Results are cached until the execution plan changes.
+  TfLiteStatus PartitionExecutionPlanIntoTracks();
+
+  // True if the next invocation may run the partitioned tracks on concurrent
+  // threads. Recomputes the partition if the execution plan changed.
+  bool ParallelInvokeApplicable();
+
+  // Invokes the nodes of one track in plan order. Used by
+  // `InvokeParallelTracks`, possibly from a non-caller thread; per-op
+  // profiling and dynamic tensor handling are unsupported here.
+  TfLiteStatus InvokeTrack(const std::vector<int>& track);
+
+  // Runs each track of the execution plan on its own thread and aggregates
+  // their statuses.
+  TfLiteStatus InvokeParallelTracks();
+
   // Allow a delegate to look at the graph and modify the graph to handle
   // parts of the graph themselves. After this is called, the graph may
   // contain new nodes that replace 1 more nodes.
@@ -1082,6 +1110,18 @@ class Subgraph {
   // TODO(aselle): replace execution_plan_ with this.
   IntArrayUniquePtr plan_cache_;
 
+  // Node indices of each independent track of the execution plan, in plan
+  // order, computed by `PartitionExecutionPlanIntoTracks`.
+  std::vector<std::vector<int>> parallel_tracks_;
+
+  // True if `parallel_tracks_` reflects the current execution plan.
+  bool parallel_tracks_valid_ = false;
+
+  // True if the current execution plan may be invoked track-parallel; false
+  // if partitioning found an ineligible node. Only meaningful while
+  // `parallel_tracks_valid_` is true.
+  bool parallel_tracks_applicable_ = false;
+
   // Used by PreviewDelegateParitioning.
   std::vector<TfLiteDelegateParams> partitioning_preview_cache_;
 
@@ -194,6 +194,49 @@ TfLiteStatus GraphPartitionHelper::PrepareSupportedNodes(
   return kTfLiteOk;
 }
 
+int64_t CostAwareGraphPartitionHelper::PartitionBoundaryBytes(
+    const TfLiteDelegateParams* partition) const {
+  int64_t boundary_bytes = 0;
+  if (partition->input_tensors != nullptr) {
+    for (int tensor_id : TfLiteIntArrayView(partition->input_tensors)) {
+      const TfLiteTensor& tensor = context_->tensors[tensor_id];
+      if (IsConstantTensor(&tensor)) continue;
+      boundary_bytes += static_cast<int64_t>(tensor.bytes);
+    }
+  }
+  if (partition->output_tensors != nullptr) {
+    for (int tensor_id : TfLiteIntArrayView(partition->output_tensors)) {
+      boundary_bytes += static_cast<int64_t>(context_->tensors[tensor_id].bytes);
+    }
+  }
+  return boundary_bytes;
+}
+
+float CostAwareGraphPartitionHelper::PartitionNetBenefit(
+    const TfLiteDelegateParams* partition) const {
+  const float benefit =
+      cost_model_.benefit_per_node * partition->nodes_to_replace->size;
+  const float cost = cost_model_.fixed_cost_per_partition +
+                     cost_model_.cost_per_boundary_byte *
+                         static_cast<float>(PartitionBoundaryBytes(partition));
+  return benefit - cost;
+}
+
+std::vector<int>
+CostAwareGraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
+    int n, int min_nodes_per_partition) {
+  auto first_n_partitions =
+      GetFirstNLargestPartitions(n, min_nodes_per_partition);
+  std::vector<int> ops_to_replace;
+  for (const auto p : first_n_partitions) {
+    if (PartitionNetBenefit(p) <= 0.0f) continue;
+    auto nodes = p->nodes_to_replace;
+    ops_to_replace.insert(ops_to_replace.end(), nodes->data,
+                          nodes->data + nodes->size);
+  }
+  return ops_to_replace;
+}
+
 std::vector<int>
 FP16GraphPartitionHelper::GetNodesOfFirstNLargestPartitionsImpl(
     int n, int min_nodes_per_partition) {
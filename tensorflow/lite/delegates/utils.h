@@ -203,6 +203,59 @@ class GraphPartitionHelper {
   TfLiteIntArray* supported_nodes_ = nullptr;  // owns the memory
 };
 
+// A simple linear cost model used to decide whether delegating a partition is
+// actually profitable. Each delegated partition pays a fixed boundary cost
+// (kernel dispatch, synchronization) plus a per-byte cost for every
+// non-constant tensor copied or layout-converted across the CPU/delegate
+// boundary, and earns a per-node benefit from running on the delegate. All
+// values share one arbitrary-but-consistent unit; the defaults roughly
+// correspond to microseconds on a mid-range mobile SoC and should be tuned
+// per delegate.
+struct DelegatePartitionCostModel {
+  // Estimated benefit of executing one node on the delegate instead of CPU.
+  float benefit_per_node = 20.0f;
+  // Fixed cost of one delegate partition boundary (dispatch and sync).
+  float fixed_cost_per_partition = 50.0f;
+  // Cost of copying or converting one byte across a partition boundary.
+  float cost_per_boundary_byte = 0.0005f;
+};
+
+// Cost-aware specialization of GraphPartitionHelper: partitions whose
+// estimated boundary-crossing cost exceeds their estimated delegate speedup
+// are kept on CPU instead of being delegated. This avoids the pathological
+// case where a graph partitions into many small delegate islands and the
+// resulting tensor copies make the delegated graph slower than pure CPU
+// execution. Rejecting an unprofitable island also merges its CPU
+// neighborhood, reducing the total number of boundary crossings.
+class CostAwareGraphPartitionHelper : public GraphPartitionHelper {
+ public:
+  CostAwareGraphPartitionHelper(TfLiteContext* context,
+                                IsNodeSupportedFn is_node_supported_fn,
+                                const DelegatePartitionCostModel& cost_model =
+                                    DelegatePartitionCostModel())
+      : GraphPartitionHelper(context, std::move(is_node_supported_fn)),
+        cost_model_(cost_model) {}
+
+  // Estimated net benefit of delegating the given partition, i.e. the
+  // per-node delegate speedup minus the fixed and per-byte boundary costs.
+  // A non-positive value means the partition should stay on CPU.
+  float PartitionNetBenefit(const TfLiteDelegateParams* partition) const;
+
+ protected:
+  // Applies the base class' first-n-largest selection, then drops partitions
+  // whose estimated net benefit is not positive.
+  std::vector<int> GetNodesOfFirstNLargestPartitionsImpl(
+      int n, int min_nodes_per_partition) override;
+
+ private:
+  // Total bytes crossing this partition's boundary at invocation time:
+  // non-constant inputs plus all outputs. Constant tensors are excluded as
+  // delegates copy them once at preparation time.
+  int64_t PartitionBoundaryBytes(const TfLiteDelegateParams* partition) const;
+
+  const DelegatePartitionCostModel cost_model_;
+};
+
 // Specialized partitioner for graphs that possibly contain fp16 tensors.
 //
 // From nodes that accept fp16 inputs, this delegates the following:
@@ -166,6 +166,30 @@ class MockTfLiteContext : public TfLiteContext {
     }
   }
 
+  // Attaches boundary tensors to the partition at 'partition_index', backed
+  // by mocked tensors of the given byte sizes. Used to exercise the cost
+  // model in CostAwareGraphPartitionHelper.
+  void SetPartitionBoundaryTensors(int partition_index,
+                                   const std::vector<size_t>& input_bytes,
+                                   const std::vector<size_t>& output_bytes) {
+    auto make_tensors = [this](const std::vector<size_t>& bytes) {
+      TfLiteIntArray* ids = TfLiteIntArrayCreate(bytes.size());
+      for (int i = 0; i < bytes.size(); ++i) {
+        TfLiteTensor tensor{};
+        tensor.bytes = bytes[i];
+        ids->data[i] = mock_tensors_.size();
+        mock_tensors_.push_back(tensor);
+      }
+      return ids;
+    };
+    delegate_params_[partition_index].input_tensors = make_tensors(input_bytes);
+    delegate_params_[partition_index].output_tensors =
+        make_tensors(output_bytes);
+    // mock_tensors_ may have been reallocated.
+    this->tensors = mock_tensors_.data();
+    this->tensors_size = mock_tensors_.size();
+  }
+
   TfLiteIntArray* exec_plan() const { return exec_plan_; }
   TfLiteNode* node() { return &node_; }
   TfLiteRegistration* registration() { return &registration_; }
@@ -209,6 +233,9 @@ class MockTfLiteContext : public TfLiteContext {
   // The TfLiteDelegateParams object that's manually populated inside the mocked
   // TfLiteContext::PreviewDelegatePartitioning.
   std::vector<TfLiteDelegateParams> delegate_params_;
+
+  // Backing storage for the tensors referenced by partition boundary arrays.
+  std::vector<TfLiteTensor> mock_tensors_;
 };
 
 bool IsNodeSupported(TfLiteContext* context, TfLiteNode* node,
@@ -252,6 +279,44 @@ TEST(GraphPartitionHelper, CheckPartitions) {
   EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
 }
 
+TEST(CostAwareGraphPartitionHelper, RejectsUnprofitableSmallPartitions) {
+  // The mocked TfLiteContext has 4 partitions: {1}, {0,3,7,8}, {2,4,9}, {5,6}.
+  MockTfLiteContext mocked_context;
+  // With a fixed boundary cost of 2.5 benefit-units and one unit of benefit
+  // per node, only partitions with at least 3 nodes are worth delegating.
+  DelegatePartitionCostModel cost_model;
+  cost_model.benefit_per_node = 1.0f;
+  cost_model.fixed_cost_per_partition = 2.5f;
+  cost_model.cost_per_boundary_byte = 0.0f;
+  CostAwareGraphPartitionHelper helper(&mocked_context, IsNodeSupported,
+                                       cost_model);
+  EXPECT_EQ(kTfLiteOk, helper.Partition(nullptr));
+  EXPECT_EQ(4, helper.num_partitions());
+
+  auto nodes = helper.GetNodesOfFirstNLargestPartitions();
+  EXPECT_THAT(nodes, testing::ElementsAreArray({0, 3, 7, 8, 2, 4, 9}));
+}
+
+TEST(CostAwareGraphPartitionHelper, RejectsPartitionsWithCostlyBoundaries) {
+  // The mocked TfLiteContext has 4 partitions: {1}, {0,3,7,8}, {2,4,9}, {5,6}.
+  MockTfLiteContext mocked_context;
+  // Attach large boundary tensors to the largest partition: 4 nodes of
+  // benefit cannot pay for copying 1MB across the boundary.
+  mocked_context.SetPartitionBoundaryTensors(
+      /*partition_index=*/1, /*input_bytes=*/{512 * 1024},
+      /*output_bytes=*/{512 * 1024});
+  DelegatePartitionCostModel cost_model;
+  cost_model.benefit_per_node = 1.0f;
+  cost_model.fixed_cost_per_partition = 0.0f;
+  cost_model.cost_per_boundary_byte = 1.0f / (128 * 1024);
+  CostAwareGraphPartitionHelper helper(&mocked_context, IsNodeSupported,
+                                       cost_model);
+  EXPECT_EQ(kTfLiteOk, helper.Partition(nullptr));
+
+  auto nodes = helper.GetNodesOfFirstNLargestPartitions();
+  EXPECT_THAT(nodes, testing::ElementsAreArray({2, 4, 9, 5, 6, 1}));
+}
+
 TfLiteStatus ErrorGetExecutionPlan(TfLiteContext* context,
                                    TfLiteIntArray** execution_plan) {
   return kTfLiteError;
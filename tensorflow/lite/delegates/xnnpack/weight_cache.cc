@@ -33,6 +33,7 @@ limitations under the License.
 #include <cstdlib>
 #include <cstring>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <utility>
@@ -373,6 +374,7 @@ MMapWeightCacheProvider::MMapWeightCacheProvider(
 MMapWeightCacheProvider& MMapWeightCacheProvider::operator=(
     MMapWeightCacheProvider&& other) {
   using std::swap;
+  std::scoped_lock lock(mutex_, other.mutex_);
   swap(cache_provider_, other.cache_provider_);
   // The contexts need to keep pointing to their owning object.
   cache_provider_.context = this;
@@ -398,11 +400,18 @@ void MMapWeightCacheProvider::SetFilePath(const char* path) {
 }
 
 bool MMapWeightCacheProvider::LoadOrStartBuild(const char* path) {
-  if (Load(path)) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (file_path_ == path && (mmap_handle_.IsMapped() || builder_.IsStarted())) {
+    // Another delegate instance sharing this provider already loaded the
+    // cache or started building it.
+    return true;
+  }
+  SetFilePath(path);
+  if (LoadImpl()) {
     TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
                     "XNNPack weight cache loaded from '%s'.", path);
     return true;
-  } else if (StartBuild(path)) {
+  } else if (builder_.Start(path)) {
     TFLITE_LOG_PROD(tflite::TFLITE_LOG_VERBOSE,
                     "XNNPack weight cache build for '%s' started.", path);
 
@@ -412,16 +421,23 @@ bool MMapWeightCacheProvider::LoadOrStartBuild(const char* path) {
 }
 
 bool MMapWeightCacheProvider::StartBuild(const char* path) {
+  std::lock_guard<std::mutex> lock(mutex_);
   SetFilePath(path);
   return builder_.Start(path);
 }
 
 bool MMapWeightCacheProvider::Load(const std::string& path) {
+  std::lock_guard<std::mutex> lock(mutex_);
   SetFilePath(path.c_str());
-  return Load();
+  return LoadImpl();
 }
 
 bool MMapWeightCacheProvider::Load() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return LoadImpl();
+}
+
+bool MMapWeightCacheProvider::LoadImpl() {
   XNNPACK_ABORT_CHECK(!file_path_.empty(),
                       "Path wasn't provided to weight cache provider.");
   mmap_buffer_base_offset_ = 0;
@@ -525,6 +541,7 @@ bool MMapWeightCacheProvider::Load() {
 void MMapWeightCacheProvider::MapTensorIdentifiers(
     const TfLiteTensor* tensors, const size_t size,
     const std::unordered_map<size_t, size_t>& tensor_index_to_identifier) {
+  std::lock_guard<std::mutex> lock(mutex_);
   for (const auto [index, identifier] : tensor_index_to_identifier) {
     XNNPACK_ABORT_CHECK(index < size,
                         "Tensor index corresponds to a non existing tensor.");
@@ -534,6 +551,7 @@ void MMapWeightCacheProvider::MapTensorIdentifiers(
 
 size_t MMapWeightCacheProvider::LookUp(
     const xnn_weights_cache_look_up_key* cache_key) {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (!cache_key) {
     TFLITE_LOG_PROD(tflite::TFLITE_LOG_ERROR,
                     "XNNPack weight cache: a null cache key was provided.");
@@ -548,6 +566,7 @@ size_t MMapWeightCacheProvider::LookUp(
 }
 
 void* MMapWeightCacheProvider::ReserveSpace(size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
   XNNPACK_ABORT_CHECK(!IsFinalized(),
                       "Cannot reserve space in a finalized cache.");
   return builder_.Reserve(size);
@@ -555,6 +574,7 @@ void* MMapWeightCacheProvider::ReserveSpace(size_t size) {
 
 size_t MMapWeightCacheProvider::LookUpOrInsert(
     const xnn_weights_cache_look_up_key* cache_key, void* ptr, size_t size) {
+  std::lock_guard<std::mutex> lock(mutex_);
   XNNPACK_ABORT_CHECK(cache_key, "A null cache key was provided.");
 
   const PackIdentifier pack_id = BuildPackIdentifier(*cache_key);
@@ -581,6 +601,7 @@ void* MMapWeightCacheProvider::OffsetToAddr(const size_t offset) {
 }
 
 void MMapWeightCacheProvider::Release() {
+  std::lock_guard<std::mutex> lock(mutex_);
   buffer_address_to_identifier_.clear();
   cache_key_to_offset_.clear();
   mmap_handle_ = MMapHandle();
@@ -589,6 +610,7 @@ void MMapWeightCacheProvider::Release() {
 }
 
 bool MMapWeightCacheProvider::Finalize() {
+  std::lock_guard<std::mutex> lock(mutex_);
   if (IsFinalized()) {
     return true;
   }
@@ -603,7 +625,7 @@ bool MMapWeightCacheProvider::Finalize() {
   }
   builder_ = WeightCacheBuilder();
 
-  return Load();
+  return LoadImpl();
 }
 
 bool MMapWeightCacheProvider::IsFinalized() const {
@@ -656,4 +678,25 @@ PackIdentifier MMapWeightCacheProvider::BuildPackIdentifier(
                         /*bias_id=*/get_buffer_id(key.bias)};
 }
 
+std::shared_ptr<MMapWeightCacheProvider> GetOrCreateSharedWeightCacheProvider(
+    const char* file_path) {
+  if (!file_path || !file_path[0]) {
+    return nullptr;
+  }
+  // Function-local statics so the registry outlives any delegate without
+  // imposing a static initialization order.
+  static std::mutex* registry_mutex = new std::mutex;
+  static auto* providers =
+      new std::unordered_map<std::string,
+                             std::weak_ptr<MMapWeightCacheProvider>>;
+  std::lock_guard<std::mutex> lock(*registry_mutex);
+  std::weak_ptr<MMapWeightCacheProvider>& entry = (*providers)[file_path];
+  std::shared_ptr<MMapWeightCacheProvider> provider = entry.lock();
+  if (!provider) {
+    provider = std::make_shared<MMapWeightCacheProvider>();
+    entry = provider;
+  }
+  return provider;
+}
+
 }  // namespace tflite::xnnpack
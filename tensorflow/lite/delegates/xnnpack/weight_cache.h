@@ -19,6 +19,7 @@ limitations under the License.
 #include <cstdint>
 #include <functional>
 #include <memory>
+#include <mutex>
 #include <string>
 #include <unordered_map>
 #include <vector>
@@ -331,6 +332,13 @@ class MMapWeightCacheProvider {
   // Hashes a cache key to lookup in `cache_key_to_identifier_`.
   PackIdentifier BuildPackIdentifier(const xnn_weights_cache_look_up_key& key);
 
+  // Unlocked implementation of `Load`, shared by `Load` and `Finalize`.
+  bool LoadImpl();
+
+  // Guards the lookup tables and the builder so that one provider can be
+  // shared by several delegate instances created or prepared concurrently.
+  mutable std::mutex mutex_;
+
   // Cache provider implementation for XNNPack.
   xnn_weights_cache_provider cache_provider_{
       /*context=*/this,
@@ -361,6 +369,18 @@ class MMapWeightCacheProvider {
   WeightCacheBuilder builder_;
 };
 
+// Returns the process-wide shared weight cache provider for the given cache
+// file path, creating it on first use.
+//
+// Delegate instances created for the same model point at the same cache file
+// and therefore get the same provider: the packed weights are mapped once and
+// shared instead of being packed (and held in RAM) per interpreter. The
+// registry only keeps weak references, so the provider is destroyed when the
+// last delegate using it goes away.
+[[nodiscard]]
+std::shared_ptr<MMapWeightCacheProvider> GetOrCreateSharedWeightCacheProvider(
+    const char* file_path);
+
 }  // namespace xnnpack
 }  // namespace tflite
 
@@ -23,6 +23,7 @@ limitations under the License.
 #include <cstring>
 #include <iterator>
 #include <map>
+#include <memory>
 #include <ostream>
 #include <string>
 #include <tuple>
@@ -752,5 +753,51 @@ TEST(MMapWeightCacheProviderTest, XnnpackCApiJourney) {
   }
 }
 
+TEST(SharedWeightCacheProviderTest, SamePathReturnsSameProvider) {
+  TempFileDesc tmp_file(TempFileDesc::kAutoCLose);
+  const std::shared_ptr<MMapWeightCacheProvider> provider_1 =
+      GetOrCreateSharedWeightCacheProvider(tmp_file.GetCPath());
+  ASSERT_NE(provider_1, nullptr);
+  const std::shared_ptr<MMapWeightCacheProvider> provider_2 =
+      GetOrCreateSharedWeightCacheProvider(tmp_file.GetCPath());
+  EXPECT_EQ(provider_1, provider_2);
+}
+
+TEST(SharedWeightCacheProviderTest, DifferentPathsReturnDifferentProviders) {
+  TempFileDesc tmp_file_1(TempFileDesc::kAutoCLose);
+  TempFileDesc tmp_file_2(TempFileDesc::kAutoCLose);
+  EXPECT_NE(GetOrCreateSharedWeightCacheProvider(tmp_file_1.GetCPath()),
+            GetOrCreateSharedWeightCacheProvider(tmp_file_2.GetCPath()));
+}
+
+TEST(SharedWeightCacheProviderTest, NullOrEmptyPathReturnsNull) {
+  EXPECT_EQ(GetOrCreateSharedWeightCacheProvider(nullptr), nullptr);
+  EXPECT_EQ(GetOrCreateSharedWeightCacheProvider(""), nullptr);
+}
+
+TEST(SharedWeightCacheProviderTest, ProviderIsReleasedWithLastReference) {
+  TempFileDesc tmp_file(TempFileDesc::kAutoCLose);
+  std::weak_ptr<MMapWeightCacheProvider> weak_provider;
+  {
+    const std::shared_ptr<MMapWeightCacheProvider> provider =
+        GetOrCreateSharedWeightCacheProvider(tmp_file.GetCPath());
+    weak_provider = provider;
+    EXPECT_FALSE(weak_provider.expired());
+  }
+  EXPECT_TRUE(weak_provider.expired());
+}
+
+TEST(SharedWeightCacheProviderTest, RepeatedLoadOrStartBuildIsANoOp) {
+  TempFileDesc tmp_file(TempFileDesc::kAutoCLose);
+  const std::shared_ptr<MMapWeightCacheProvider> provider =
+      GetOrCreateSharedWeightCacheProvider(tmp_file.GetCPath());
+  ASSERT_TRUE(provider->LoadOrStartBuild(tmp_file.GetCPath()));
+  EXPECT_TRUE(provider->IsBuilding());
+  // A second delegate attaching to the shared provider must not reset the
+  // build that the first delegate started.
+  ASSERT_TRUE(provider->LoadOrStartBuild(tmp_file.GetCPath()));
+  EXPECT_TRUE(provider->IsBuilding());
+}
+
 }  // namespace
 }  // namespace tflite::xnnpack
@@ -537,16 +537,21 @@ class Delegate {
     delegate_.flags = GetXNNPackDelegateFlags();
     workspace_.reset(workspace);
 
-    // If no weight cache is provided, add one when requested.
+    // If no weight cache is provided, add one when requested. The provider is
+    // shared process-wide between delegates using the same cache file so that
+    // several interpreters running the same model map one packed-weight
+    // region instead of each packing its own copy.
     if (!options_.weights_cache) {
       if (options_.weight_cache_file_path) {
-        if (weight_cache_provider_.LoadOrStartBuild(
-                options_.weight_cache_file_path)) {
+        weight_cache_provider_ = GetOrCreateSharedWeightCacheProvider(
+            options_.weight_cache_file_path);
+        if (weight_cache_provider_ && weight_cache_provider_->LoadOrStartBuild(
+                                          options_.weight_cache_file_path)) {
           options_.weights_cache =
               reinterpret_cast<TfLiteXNNPackDelegateWeightsCache*>(
-                  weight_cache_provider_.GetCacheProvider().context);
+                  weight_cache_provider_->GetCacheProvider().context);
           options_.weight_cache_file_path =
-              weight_cache_provider_.GetFilePath().data();
+              weight_cache_provider_->GetFilePath().data();
         } else {
           TFLITE_LOG_PROD(tflite::TFLITE_LOG_ERROR,
                           "XNNPack weight cache could neither be loaded from "
@@ -554,6 +559,7 @@ class Delegate {
                           "readable and writable.",
                           options_.weight_cache_file_path);
           options_.weight_cache_file_path = nullptr;
+          weight_cache_provider_.reset();
         }
       } else {
         TFLITE_LOG(tflite::TFLITE_LOG_VERBOSE,
@@ -744,8 +750,9 @@ class Delegate {
   std::mutex workspace_mutex_;
 
   // If no weight cache is provided and a cache is set in the delegate options,
-  // this will be used as a weight cache.
-  MMapWeightCacheProvider weight_cache_provider_;
+  // this will be used as a weight cache. Shared between all delegates using
+  // the same weight cache file in this process.
+  std::shared_ptr<MMapWeightCacheProvider> weight_cache_provider_;
 };
 
 class Subgraph {
@@ -817,8 +824,9 @@ class Subgraph {
                           const TfLiteDelegateParams* params,
                           Delegate& delegate) {
     // Map tensors identifiers before packing anything.
-    if (delegate.weight_cache_provider_.IsActive()) {
-      delegate.weight_cache_provider_.MapTensorIdentifiers(
+    if (delegate.weight_cache_provider_ &&
+        delegate.weight_cache_provider_->IsActive()) {
+      delegate.weight_cache_provider_->MapTensorIdentifiers(
           context->tensors, context->tensors_size,
           reinterpret_cast<tflite::Subgraph*>(context->impl_)
               ->GetTensorBufferIdentifiers());
@@ -1164,8 +1172,9 @@ class Subgraph {
     // The weights cache needs to be finalized only once. Prepare will be called
     // for each partition after all the partitions have been created (therefore
     // all the weights are known and have been packed).
-    if (delegate->weight_cache_provider_.IsActive()) {
-      if (!delegate->weight_cache_provider_.Finalize()) {
+    if (delegate->weight_cache_provider_ &&
+        delegate->weight_cache_provider_->IsActive()) {
+      if (!delegate->weight_cache_provider_->Finalize()) {
         TF_LITE_KERNEL_LOG(context,
                            "XNNPack delegate failed to finalize cache.");
         return kTfLiteError;
@@ -87,6 +87,26 @@ class InterpreterOptions {
     experimental_disable_delegate_clustering_ = value;
   }
 
+  // If set to `true`, independent branches of a subgraph's execution plan
+  // (nodes with no data dependency between them, e.g. the towers of a
+  // two-tower model) are invoked on concurrent threads instead of strictly
+  // in topological order. Requires `SetPreserveAllTensors` so that the
+  // memory planner never overlaps the storage of tensors in different
+  // branches; subgraphs with dynamic tensors, variables, control flow,
+  // custom ops or delegates fall back to sequential execution.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  void SetParallelBranchInvoke(bool value = true) {
+    experimental_parallel_branch_invoke_ = value;
+  }
+
+  // Returns if the `experimental_parallel_branch_invoke_` feature is enabled.
+  //
+  // WARNING: This is an experimental API and subject to change.
+  bool GetParallelBranchInvoke() const {
+    return experimental_parallel_branch_invoke_;
+  }
+
   // If set to `true`, the CAST op will cache its output when its input is a
   // constant tensor.
   //
@@ -108,6 +128,7 @@ class InterpreterOptions {
   bool experimental_ensure_dynamic_tensors_are_released_ = false;
   int experimental_optimize_memory_for_large_tensors_ = 0;
   bool experimental_disable_delegate_clustering_ = false;
+  bool experimental_parallel_branch_invoke_ = false;
   bool experimental_cache_constant_cast_op_ = false;
 };
 
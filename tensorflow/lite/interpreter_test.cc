@@ -1129,6 +1129,112 @@ TEST(BasicInterpreter, ReleaseDynamicTensors) {
   ASSERT_EQ(interpreter.tensor(3)->bytes, sizeof(float) * 6 * 6);
 }
 
+TEST(BasicInterpreter, ParallelBranchInvoke) {
+  // Two independent negate branches with no data dependency between them, so
+  // the parallel branch mode runs them as two concurrent tracks.
+  Interpreter interpreter;
+  interpreter.AddTensors(4);
+  interpreter.SetInputs({0, 2});
+  interpreter.SetOutputs({1, 3});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 4; ++i) {
+    interpreter.SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {3}, quant);
+  }
+  TfLiteRegistration* neg_op = tflite::ops::builtin::Register_NEG();
+  interpreter.AddNodeWithParameters({0}, {1}, nullptr, 0, nullptr, neg_op);
+  interpreter.AddNodeWithParameters({2}, {3}, nullptr, 0, nullptr, neg_op);
+
+  InterpreterOptions options;
+  options.SetPreserveAllTensors();
+  options.SetParallelBranchInvoke();
+  ASSERT_EQ(interpreter.ApplyOptions(&options), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  for (int i = 0; i < 3; ++i) {
+    interpreter.typed_tensor<float>(0)[i] = i + 1.0f;
+    interpreter.typed_tensor<float>(2)[i] = -(i + 1.0f);
+  }
+  ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+  for (int i = 0; i < 3; ++i) {
+    EXPECT_EQ(interpreter.typed_tensor<float>(1)[i], -(i + 1.0f));
+    EXPECT_EQ(interpreter.typed_tensor<float>(3)[i], i + 1.0f);
+  }
+
+  // Repeated invocations reuse the cached track partition.
+  ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+  EXPECT_EQ(interpreter.typed_tensor<float>(1)[0], -1.0f);
+}
+
+TEST(BasicInterpreter, ParallelBranchInvokeFallsBackOnDependentGraph) {
+  // A single chain partitions into one track, so the sequential path is
+  // taken even with the parallel branch mode enabled.
+  Interpreter interpreter;
+  interpreter.AddTensors(3);
+  interpreter.SetInputs({0});
+  interpreter.SetOutputs({2});
+  TfLiteQuantizationParams quant;
+  for (int i = 0; i < 3; ++i) {
+    interpreter.SetTensorParametersReadWrite(i, kTfLiteFloat32, "", {1}, quant);
+  }
+  TfLiteRegistration* neg_op = tflite::ops::builtin::Register_NEG();
+  interpreter.AddNodeWithParameters({0}, {1}, nullptr, 0, nullptr, neg_op);
+  interpreter.AddNodeWithParameters({1}, {2}, nullptr, 0, nullptr, neg_op);
+
+  InterpreterOptions options;
+  options.SetPreserveAllTensors();
+  options.SetParallelBranchInvoke();
+  ASSERT_EQ(interpreter.ApplyOptions(&options), kTfLiteOk);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  interpreter.typed_tensor<float>(0)[0] = 5.0f;
+  ASSERT_EQ(interpreter.Invoke(), kTfLiteOk);
+  EXPECT_EQ(interpreter.typed_tensor<float>(2)[0], 5.0f);
+}
+
+TEST(BasicInterpreter, InvokeBatch) {
+  Interpreter interpreter;
+  interpreter.AddTensors(2);
+  interpreter.SetInputs({0});
+  interpreter.SetOutputs({1});
+  TfLiteQuantizationParams quant;
+  interpreter.SetTensorParametersReadWrite(0, kTfLiteFloat32, "", {1}, quant);
+  interpreter.SetTensorParametersReadWrite(1, kTfLiteFloat32, "", {1}, quant);
+  TfLiteRegistration* neg_op = tflite::ops::builtin::Register_NEG();
+  interpreter.AddNodeWithParameters({0}, {1}, nullptr, 0, nullptr, neg_op);
+  ASSERT_EQ(interpreter.AllocateTensors(), kTfLiteOk);
+
+  std::vector<float> results(4, 0.0f);
+  ASSERT_EQ(interpreter.InvokeBatch(
+                results.size(),
+                [&](size_t i) {
+                  interpreter.typed_tensor<float>(0)[0] = i + 1.0f;
+                  return kTfLiteOk;
+                },
+                [&](size_t i) {
+                  results[i] = interpreter.typed_tensor<float>(1)[0];
+                  return kTfLiteOk;
+                }),
+            kTfLiteOk);
+  for (size_t i = 0; i < results.size(); ++i) {
+    EXPECT_EQ(results[i], -(i + 1.0f));
+  }
+
+  // A failing callback aborts the batch and propagates its status.
+  size_t invocations = 0;
+  ASSERT_EQ(interpreter.InvokeBatch(
+                4,
+                [&](size_t i) {
+                  ++invocations;
+                  return i < 2 ? kTfLiteOk : kTfLiteError;
+                },
+                [](size_t) { return kTfLiteOk; }),
+            kTfLiteError);
+  EXPECT_EQ(invocations, 3);
+
+  // Null callbacks are rejected up front.
+  ASSERT_EQ(interpreter.InvokeBatch(1, nullptr, nullptr), kTfLiteError);
+}
+
 TEST(InterpreterTensorsCapacityTest, TestWithinHeadroom) {
   Interpreter interpreter;
   ASSERT_EQ(interpreter.AddTensors(Interpreter::kTensorsReservedCapacity),
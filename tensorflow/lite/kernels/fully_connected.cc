@@ -157,6 +157,12 @@ struct OpData {
   bool compute_row_sums = false;
   // Only used for sparse hybrid fully connected kernels.
   bool ledger_initialized;
+  // Remapped CSR arrays for float block-sparse weights with 1xN blocks
+  // (N a multiple of 4, N > 4): each block is viewed as N/4 consecutive 1x4
+  // blocks so the 1x4 kernel can run on the compressed weights directly.
+  // Populated lazily on first eval; the weight data itself is not copied.
+  std::vector<int32_t> sparse_1x4_segments;
+  std::vector<int32_t> sparse_1x4_indices;
   // Used for 4bit hybrid
   std::unique_ptr<optimized_4bit::OpData4Bit> op_data_4bit = nullptr;
   TfLiteType quantized_bias_type = kTfLiteNoType;
@@ -1570,6 +1576,36 @@ TfLiteStatus EvalFloat(TfLiteContext* context, TfLiteNode* node,
             bias_shape, GetTensorData<float>(bias),      // Disable formatting
             output_shape, GetTensorData<float>(output),
             CpuBackendContext::GetFromContext(context));
+      } else if (sparsity.dim_metadata_size == kDimMetadataSizeBlockSparse &&
+                 sparsity.dim_metadata[2].dense_size % 4 == 0) {
+        // Block sparse with a wider 1xN block, N a multiple of 4. The block
+        // data layout is contiguous, so a 1xN block is exactly N/4 adjacent
+        // 1x4 blocks; remap the CSR arrays once and run the 1x4 kernel over
+        // the compressed weights.
+        if (data->sparse_1x4_segments.empty()) {
+          const int factor = sparsity.dim_metadata[2].dense_size / 4;
+          const TfLiteIntArray* segments =
+              sparsity.dim_metadata[1].array_segments;
+          const TfLiteIntArray* indices = sparsity.dim_metadata[1].array_indices;
+          data->sparse_1x4_segments.reserve(segments->size);
+          for (int i = 0; i < segments->size; ++i) {
+            data->sparse_1x4_segments.push_back(segments->data[i] * factor);
+          }
+          data->sparse_1x4_indices.reserve(indices->size * factor);
+          for (int i = 0; i < indices->size; ++i) {
+            for (int j = 0; j < factor; ++j) {
+              data->sparse_1x4_indices.push_back(indices->data[i] * factor + j);
+            }
+          }
+        }
+        optimized_ops::FullyConnectedSparseWeight1x4(
+            data->sparse_1x4_segments.data(), data->sparse_1x4_indices.data(),
+            op_params,                                   // Disable formatting
+            input_shape, GetTensorData<float>(input),    // Disable formatting
+            filter_shape, GetTensorData<float>(filter),  // Disable formatting
+            bias_shape, GetTensorData<float>(bias),      // Disable formatting
+            output_shape, GetTensorData<float>(output),
+            CpuBackendContext::GetFromContext(context));
       } else {
         TF_LITE_KERNEL_LOG(context,
                            "Unsupported sparse fully-connected weight format.");
@@ -115,12 +115,13 @@ inline void FullyConnectedSparseWeight1x16Impl(
 }
 
 inline void FullyConnectedSparseWeight1x4Impl(
-    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
-    const RuntimeShape& input_shape, const float* input_data,
-    const RuntimeShape& weights_shape, const float* weights_data,
-    const RuntimeShape& bias_shape, const float* bias_data,
-    const RuntimeShape& output_shape, float* output_data, int thread_start,
-    int thread_end, const CpuBackendContext& cpu_backend_context) {
+    const int32_t* w1_segments, const int32_t* w1_indices,
+    const FullyConnectedParams& params, const RuntimeShape& input_shape,
+    const float* input_data, const RuntimeShape& weights_shape,
+    const float* weights_data, const RuntimeShape& bias_shape,
+    const float* bias_data, const RuntimeShape& output_shape,
+    float* output_data, int thread_start, int thread_end,
+    const CpuBackendContext& cpu_backend_context) {
   ruy::profiler::ScopeLabel label("FullyConnected");
   ruy::profiler::ScopeLabel inner_label("1x4 Block Sparse");
   const float output_activation_min = params.float_activation_min;
@@ -134,8 +135,6 @@ inline void FullyConnectedSparseWeight1x4Impl(
                                       input_shape, input_dims_count - 1);
   const int output_depth = MatchingDim(weights_shape, weights_dims_count - 2,
                                        output_shape, output_dims_count - 1);
-  const int* w1_segments = sparsity.dim_metadata[1].array_segments->data;
-  const int* w1_indices = sparsity.dim_metadata[1].array_indices->data;
 
   tensor_utils::SparseMatrixBatchVectorMultiplyAccumulate1x4(
       weights_data, w1_segments, w1_indices, weights_shape.Dims(0),
@@ -155,13 +154,15 @@ inline void FullyConnectedSparseWeight1x4Impl(
 
 struct FullyConnectedSparseWeight1x4Task : cpu_backend_threadpool::Task {
   FullyConnectedSparseWeight1x4Task(
-      const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
-      const RuntimeShape& input_shape, const float* input_data,
-      const RuntimeShape& weights_shape, const float* weights_data,
-      const RuntimeShape& bias_shape, const float* bias_data,
-      const RuntimeShape& output_shape, float* output_data, int thread_start,
-      int thread_end, const CpuBackendContext& cpu_backend_context_x)
-      : sparsity(sparsity),
+      const int32_t* w1_segments, const int32_t* w1_indices,
+      const FullyConnectedParams& params, const RuntimeShape& input_shape,
+      const float* input_data, const RuntimeShape& weights_shape,
+      const float* weights_data, const RuntimeShape& bias_shape,
+      const float* bias_data, const RuntimeShape& output_shape,
+      float* output_data, int thread_start, int thread_end,
+      const CpuBackendContext& cpu_backend_context_x)
+      : w1_segments(w1_segments),
+        w1_indices(w1_indices),
         params(params),
         input_shape(input_shape),
         input_data(input_data),
@@ -177,13 +178,14 @@ struct FullyConnectedSparseWeight1x4Task : cpu_backend_threadpool::Task {
 
   void Run() override {
     FullyConnectedSparseWeight1x4Impl(
-        sparsity, params, input_shape, input_data, weights_shape, weights_data,
-        bias_shape, bias_data, output_shape, output_data, thread_start,
-        thread_end, cpu_backend_context);
+        w1_segments, w1_indices, params, input_shape, input_data, weights_shape,
+        weights_data, bias_shape, bias_data, output_shape, output_data,
+        thread_start, thread_end, cpu_backend_context);
   }
 
  private:
-  const TfLiteSparsity& sparsity;
+  const int32_t* w1_segments;
+  const int32_t* w1_indices;
   const FullyConnectedParams& params;
   const RuntimeShape& input_shape;
   const float* input_data;
@@ -223,13 +225,17 @@ inline void FullyConnectedSparseWeight1x16(
 // there's not enough batches of data, the number of threads used is equal to
 // the batch size. We can improve this later with slicing along the row
 // dimension of the weight.
+//
+// This overload takes the CSR segment/index arrays directly so callers can
+// substitute remapped arrays, e.g. a wider 1xN block layout expressed as N/4
+// consecutive 1x4 blocks.
 inline void FullyConnectedSparseWeight1x4(
-    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
-    const RuntimeShape& input_shape, const float* input_data,
-    const RuntimeShape& weights_shape, const float* weights_data,
-    const RuntimeShape& bias_shape, const float* bias_data,
-    const RuntimeShape& output_shape, float* output_data,
-    CpuBackendContext* cpu_backend_context) {
+    const int32_t* w1_segments, const int32_t* w1_indices,
+    const FullyConnectedParams& params, const RuntimeShape& input_shape,
+    const float* input_data, const RuntimeShape& weights_shape,
+    const float* weights_data, const RuntimeShape& bias_shape,
+    const float* bias_data, const RuntimeShape& output_shape,
+    float* output_data, CpuBackendContext* cpu_backend_context) {
   const int output_elements = output_shape.FlatSize();
   memset(output_data, 0, output_elements * sizeof(float));
 
@@ -239,9 +245,9 @@ inline void FullyConnectedSparseWeight1x4(
   const int thread_count = std::max(1, std::min(batches, max_threads));
   if (thread_count == 1) {
     return FullyConnectedSparseWeight1x4Impl(
-        sparsity, params, input_shape, input_data, weights_shape, weights_data,
-        bias_shape, bias_data, output_shape, output_data, 0, batches,
-        *cpu_backend_context);
+        w1_segments, w1_indices, params, input_shape, input_data, weights_shape,
+        weights_data, bias_shape, bias_data, output_shape, output_data, 0,
+        batches, *cpu_backend_context);
   }
   std::vector<FullyConnectedSparseWeight1x4Task> tasks;
   tasks.reserve(thread_count);
@@ -253,9 +259,9 @@ inline void FullyConnectedSparseWeight1x4(
     int thread_end = thread_start + batches / thread_count;
     if (i < batches % thread_count) thread_end++;
 
-    tasks.emplace_back(sparsity, params, input_shape, input_data, weights_shape,
-                       weights_data, bias_shape, bias_data, output_shape,
-                       output_data, thread_start, thread_end,
+    tasks.emplace_back(w1_segments, w1_indices, params, input_shape, input_data,
+                       weights_shape, weights_data, bias_shape, bias_data,
+                       output_shape, output_data, thread_start, thread_end,
                        *cpu_backend_context);
     thread_start = thread_end;
   }
@@ -263,6 +269,20 @@ inline void FullyConnectedSparseWeight1x4(
                                   cpu_backend_context);
 }
 
+inline void FullyConnectedSparseWeight1x4(
+    const TfLiteSparsity& sparsity, const FullyConnectedParams& params,
+    const RuntimeShape& input_shape, const float* input_data,
+    const RuntimeShape& weights_shape, const float* weights_data,
+    const RuntimeShape& bias_shape, const float* bias_data,
+    const RuntimeShape& output_shape, float* output_data,
+    CpuBackendContext* cpu_backend_context) {
+  FullyConnectedSparseWeight1x4(
+      sparsity.dim_metadata[1].array_segments->data,
+      sparsity.dim_metadata[1].array_indices->data, params, input_shape,
+      input_data, weights_shape, weights_data, bias_shape, bias_data,
+      output_shape, output_data, cpu_backend_context);
+}
+
 }  // namespace optimized_ops
 }  // namespace tflite
 #endif  // TENSORFLOW_LITE_KERNELS_INTERNAL_OPTIMIZED_SPARSE_OPS_FULLY_CONNECTED_H_
@@ -577,18 +577,27 @@ void CalculateLstmGateInteger8x8_16(
     // Parameters for performance optimizations
     CpuBackendContext* context,
     // Scratch arrays
-    int32_t* scratch5) {
+    int32_t* scratch5,
+    // Optional precomputed input contribution (input_weight * input plus
+    // effective bias, requantized) for this step, of size n_batch * n_cell.
+    const int16_t* precomputed_input_contribution) {
   const bool use_peephole = (cell_to_gate_weights != nullptr);
   const bool use_layer_norm = (layer_norm_coefficients != nullptr);
 
-  // Initialize scratch buffers with zeros. Note that unlike float and hybrid
-  // versions, bias is only used in layer normalization.
-  std::fill_n(gate, n_batch * n_cell, 0);
-  // For each batch and cell: compute input_weight * input.
-  tensor_utils::MatrixBatchVectorMultiplyAccumulate(
-      input, input_to_gate_bias, input_to_gate_weights, input_to_gate_scale_a,
-      input_to_gate_scale_b, n_batch, n_input, n_cell, 0, scratch5, gate,
-      context);
+  if (precomputed_input_contribution != nullptr) {
+    // The input contribution was computed for the whole sequence in one pass
+    // over the packed weights; start the gate accumulator from it.
+    std::copy_n(precomputed_input_contribution, n_batch * n_cell, gate);
+  } else {
+    // Initialize scratch buffers with zeros. Note that unlike float and hybrid
+    // versions, bias is only used in layer normalization.
+    std::fill_n(gate, n_batch * n_cell, 0);
+    // For each batch and cell: compute input_weight * input.
+    tensor_utils::MatrixBatchVectorMultiplyAccumulate(
+        input, input_to_gate_bias, input_to_gate_weights, input_to_gate_scale_a,
+        input_to_gate_scale_b, n_batch, n_input, n_cell, 0, scratch5, gate,
+        context);
+  }
   // Note: no aux_input.
 
   // For each batch and cell: compute recurrent_weight * output_state.
@@ -1476,7 +1485,11 @@ inline void LstmStepInteger8x8_16(
     const int32_t* recurrent_to_output_effective_bias,
     const int32_t* input_to_input_effective_bias,
     const int32_t* recurrent_to_input_effective_bias,
-    const int32_t* projection_effective_bias, int n_batch, int n_cell,
+    const int32_t* projection_effective_bias,
+    const int16_t* input_to_input_precomputed,
+    const int16_t* input_to_forget_precomputed,
+    const int16_t* input_to_cell_precomputed,
+    const int16_t* input_to_output_precomputed, int n_batch, int n_cell,
     int n_input, int n_output, int8_t* output_state_ptr,
     int32_t output_state_zp, int16_t* cell_state_ptr, int8_t* output_ptr,
     int16_t* scratch0, int16_t* scratch1, int16_t* scratch2, int16_t* scratch3,
@@ -1519,7 +1532,8 @@ inline void LstmStepInteger8x8_16(
         effective_cell_to_input_scale_b, layer_norm_input_weight_ptr,
         input_gate_bias_ptr, layer_norm_input_scale_a, layer_norm_input_scale_b,
         input_variance_guard, n_batch, n_input, n_output, n_cell,
-        kTfLiteActSigmoid, input_gate_scratch, context, scratch5);
+        kTfLiteActSigmoid, input_gate_scratch, context, scratch5,
+        input_to_input_precomputed);
   }
   // Calculate the forget gate.
   CalculateLstmGateInteger8x8_16(
@@ -1533,7 +1547,7 @@ inline void LstmStepInteger8x8_16(
       forget_gate_bias_ptr, layer_norm_forget_scale_a,
       layer_norm_forget_scale_b, forget_variance_guard, n_batch, n_input,
       n_output, n_cell, kTfLiteActSigmoid, forget_gate_scratch, context,
-      scratch5);
+      scratch5, input_to_forget_precomputed);
   // Calculate the cell update gate.
   CalculateLstmGateInteger8x8_16(
       input_ptr, input_to_cell_weight_ptr, input_to_cell_effective_bias,
@@ -1545,7 +1559,7 @@ inline void LstmStepInteger8x8_16(
       /*cell_to_gate_scale_b=*/0, layer_norm_cell_weight_ptr,
       cell_gate_bias_ptr, layer_norm_cell_scale_a, layer_norm_cell_scale_b,
       cell_variance_guard, n_batch, n_input, n_output, n_cell, kTfLiteActTanh,
-      cell_gate_scratch, context, scratch5);
+      cell_gate_scratch, context, scratch5, input_to_cell_precomputed);
   // Update the cell state.
   UpdateLstmCellInteger(n_batch, n_cell, cell_state_ptr, cell_state_scale,
                         input_gate_scratch, forget_gate_scratch,
@@ -1562,7 +1576,7 @@ inline void LstmStepInteger8x8_16(
       output_gate_bias_ptr, layer_norm_output_scale_a,
       layer_norm_output_scale_b, output_variance_guard, n_batch, n_input,
       n_output, n_cell, kTfLiteActSigmoid, output_gate_scratch, context,
-      scratch5);
+      scratch5, input_to_output_precomputed);
   // Update the output state.
   CalculateLstmOutputInteger8x8_16(
       n_batch, n_cell, n_output, cell_state_ptr, cell_state_scale,
@@ -2328,11 +2342,64 @@ TfLiteStatus EvalInteger8x8_16(
   const int output_batch_leading_dim =
       output->dims->data[output->dims->size - 1];
 
+  // The input contributions input_weight * input do not depend on the
+  // recurrent state, so for sequence inputs they are computed for all
+  // timesteps in one pass over each packed weight matrix instead of one GEMV
+  // per timestep. The rows of `input` are contiguous for both time-major and
+  // batch-major layouts, so they can be treated as one large batch. Each row
+  // goes through the same accumulate-and-requantize computation as the
+  // per-step path, keeping results bit-exact.
+  const bool use_cifg = (input_to_input_weights == nullptr);
+  std::vector<int16_t> input_to_input_precomputed;
+  std::vector<int16_t> input_to_forget_precomputed;
+  std::vector<int16_t> input_to_cell_precomputed;
+  std::vector<int16_t> input_to_output_precomputed;
+  if (max_time > 1) {
+    const int num_rows = n_batch * max_time;
+    std::vector<int32_t> precompute_scratch(num_rows * n_cell);
+    auto precompute = [&](const TfLiteTensor* weights,
+                          const int32_t* effective_bias, int32_t scale_a,
+                          int32_t scale_b, std::vector<int16_t>* out) {
+      out->assign(num_rows * n_cell, 0);
+      tensor_utils::MatrixBatchVectorMultiplyAccumulate(
+          GetTensorData<int8_t>(input), effective_bias,
+          GetTensorData<int8_t>(weights), scale_a, scale_b, num_rows, n_input,
+          n_cell, 0, precompute_scratch.data(), out->data(), context);
+    };
+    if (!use_cifg) {
+      precompute(input_to_input_weights,
+                 integer_lstm_param->input_to_input_effective_bias.get(),
+                 integer_lstm_param->effective_input_to_input_scale_a,
+                 integer_lstm_param->effective_input_to_input_scale_b,
+                 &input_to_input_precomputed);
+    }
+    precompute(input_to_forget_weights,
+               integer_lstm_param->input_to_forget_effective_bias.get(),
+               integer_lstm_param->effective_input_to_forget_scale_a,
+               integer_lstm_param->effective_input_to_forget_scale_b,
+               &input_to_forget_precomputed);
+    precompute(input_to_cell_weights,
+               integer_lstm_param->input_to_cell_effective_bias.get(),
+               integer_lstm_param->effective_input_to_cell_scale_a,
+               integer_lstm_param->effective_input_to_cell_scale_b,
+               &input_to_cell_precomputed);
+    precompute(input_to_output_weights,
+               integer_lstm_param->input_to_output_effective_bias.get(),
+               integer_lstm_param->effective_input_to_output_scale_a,
+               integer_lstm_param->effective_input_to_output_scale_b,
+               &input_to_output_precomputed);
+  }
+  auto precomputed_step_ptr = [](const std::vector<int16_t>& precomputed,
+                                 int row_offset) -> const int16_t* {
+    return precomputed.empty() ? nullptr : precomputed.data() + row_offset;
+  };
+
   if (time_major) {
     const int input_step = n_batch * n_input;
     const int output_step = n_batch * output_batch_leading_dim;
     for (int t = 0; t < max_time; t++) {
       const int t_rel = t;
+      const int precomputed_offset = t_rel * n_batch * n_cell;
       int8_t* output_ptr = GetTensorData<int8_t>(output) + t_rel * output_step;
       const int8_t* input_ptr =
           GetTensorData<int8_t>(input) + t_rel * input_step;
@@ -2407,9 +2474,14 @@ TfLiteStatus EvalInteger8x8_16(
           integer_lstm_param->recurrent_to_output_effective_bias.get(),
           integer_lstm_param->input_to_input_effective_bias.get(),
           integer_lstm_param->recurrent_to_input_effective_bias.get(),
-          integer_lstm_param->projection_effective_bias.get(), n_batch, n_cell,
-          n_input, n_output, GetTensorData<int8_t>(output_state),
-          output_state_zp, GetTensorData<int16_t>(cell_state), output_ptr,
+          integer_lstm_param->projection_effective_bias.get(),
+          precomputed_step_ptr(input_to_input_precomputed, precomputed_offset),
+          precomputed_step_ptr(input_to_forget_precomputed, precomputed_offset),
+          precomputed_step_ptr(input_to_cell_precomputed, precomputed_offset),
+          precomputed_step_ptr(input_to_output_precomputed, precomputed_offset),
+          n_batch, n_cell, n_input, n_output,
+          GetTensorData<int8_t>(output_state), output_state_zp,
+          GetTensorData<int16_t>(cell_state), output_ptr,
           GetTensorData<int16_t>(scratch0), GetTensorData<int16_t>(scratch1),
           GetTensorData<int16_t>(scratch2), GetTensorData<int16_t>(scratch3),
           GetTensorData<int8_t>(scratch4), GetTensorData<int32_t>(scratch5),
@@ -2424,6 +2496,7 @@ TfLiteStatus EvalInteger8x8_16(
         // backwards.
         const int t_rel = forward_sequence ? t : max_time - t - 1;
         const int time_offset = b * max_time + t_rel;
+        const int precomputed_offset = time_offset * n_cell;
         const int8_t* input_ptr =
             GetTensorData<int8_t>(input) + time_offset * input_step;
         int8_t* output_ptr =
@@ -2506,9 +2579,18 @@ TfLiteStatus EvalInteger8x8_16(
             integer_lstm_param->recurrent_to_output_effective_bias.get(),
             integer_lstm_param->input_to_input_effective_bias.get(),
             integer_lstm_param->recurrent_to_input_effective_bias.get(),
-            integer_lstm_param->projection_effective_bias.get(), /*n_batch=*/1,
-            n_cell, n_input, n_output, output_state_ptr, output_state_zp,
-            cell_state_ptr, output_ptr, GetTensorData<int16_t>(scratch0),
+            integer_lstm_param->projection_effective_bias.get(),
+            precomputed_step_ptr(input_to_input_precomputed,
+                                 precomputed_offset),
+            precomputed_step_ptr(input_to_forget_precomputed,
+                                 precomputed_offset),
+            precomputed_step_ptr(input_to_cell_precomputed,
+                                 precomputed_offset),
+            precomputed_step_ptr(input_to_output_precomputed,
+                                 precomputed_offset),
+            /*n_batch=*/1, n_cell, n_input, n_output, output_state_ptr,
+            output_state_zp, cell_state_ptr, output_ptr,
+            GetTensorData<int16_t>(scratch0),
             GetTensorData<int16_t>(scratch1), GetTensorData<int16_t>(scratch2),
             GetTensorData<int16_t>(scratch3), GetTensorData<int8_t>(scratch4),
             GetTensorData<int32_t>(scratch5), context);
@@ -19,7 +19,10 @@ limitations under the License.
 #include <sys/stat.h>
 #include <unistd.h>
 
+#include <algorithm>
 #include <cerrno>
+#include <cstdint>
+#include <vector>
 
 #include "tensorflow/lite/allocation.h"
 #include "tensorflow/lite/core/api/error_reporter.h"
@@ -125,6 +128,61 @@ const void* MMAPAllocation::base() const {
       reinterpret_cast<const char*>(mmapped_buffer_) + offset_in_buffer_);
 }
 
+bool MMAPAllocation::Prefault(size_t offset, size_t length) const {
+  if (!valid() || offset >= buffer_size_bytes_) {
+    return false;
+  }
+  length = std::min(length, buffer_size_bytes_ - offset);
+
+#ifdef __ANDROID__
+  static const size_t pagesize = getpagesize();
+#else
+  static const size_t pagesize = sysconf(_SC_PAGE_SIZE);
+#endif
+
+  // madvise operates on whole pages, so round the range outwards.
+  const uintptr_t range_start =
+      reinterpret_cast<uintptr_t>(base()) + offset;
+  const uintptr_t page_start = range_start - (range_start % pagesize);
+  const size_t page_length = range_start + length - page_start;
+  return madvise(reinterpret_cast<void*>(page_start), page_length,
+                 MADV_WILLNEED) == 0;
+}
+
+int64_t MMAPAllocation::BytesResident() const {
+  if (!valid()) {
+    return -1;
+  }
+
+#ifdef __ANDROID__
+  static const size_t pagesize = getpagesize();
+#else
+  static const size_t pagesize = sysconf(_SC_PAGE_SIZE);
+#endif
+
+  const size_t mapping_bytes = buffer_size_bytes_ + offset_in_buffer_;
+  const size_t num_pages = (mapping_bytes + pagesize - 1) / pagesize;
+  // The vector element type of mincore differs between platforms.
+#ifdef __APPLE__
+  std::vector<char> residency(num_pages);
+#else
+  std::vector<unsigned char> residency(num_pages);
+#endif
+  if (mincore(const_cast<void*>(mmapped_buffer_), mapping_bytes,
+              residency.data()) != 0) {
+    return -1;
+  }
+
+  int64_t resident_bytes = 0;
+  for (size_t i = 0; i < num_pages; ++i) {
+    // Only the low bit is meaningful; other bits are reserved.
+    if (residency[i] & 1) {
+      resident_bytes += pagesize;
+    }
+  }
+  return std::min<int64_t>(resident_bytes, mapping_bytes);
+}
+
 size_t MMAPAllocation::bytes() const { return buffer_size_bytes_; }
 
 bool MMAPAllocation::valid() const { return mmapped_buffer_ != MAP_FAILED; }
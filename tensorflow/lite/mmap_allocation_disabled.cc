@@ -45,6 +45,12 @@ size_t MMAPAllocation::bytes() const { return 0; }
 
 bool MMAPAllocation::valid() const { return false; }
 
+bool MMAPAllocation::Prefault(size_t offset, size_t length) const {
+  return false;
+}
+
+int64_t MMAPAllocation::BytesResident() const { return -1; }
+
 bool MMAPAllocation::IsSupported() { return false; }
 
 }  // namespace tflite
@@ -31,7 +31,8 @@ using TfLiteDelegatePtr =
 
 #ifdef TFLITE_BUILD_WITH_XNNPACK_DELEGATE
 TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(
-    TfLiteContext* context, XNNPackQS8Options xnnpack_qs8_options) {
+    TfLiteContext* context, XNNPackQS8Options xnnpack_qs8_options,
+    const char* weight_cache_file_path) {
   auto opts = TfLiteXNNPackDelegateOptionsDefault();
   switch (xnnpack_qs8_options) {
     case XNNPackQS8Options::enabled:
@@ -44,11 +45,20 @@ TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(
     default:
       break;
   }
+  if (weight_cache_file_path && weight_cache_file_path[0] != '\0') {
+    opts.weight_cache_file_path = weight_cache_file_path;
+  }
 
   return TfLiteDelegatePtr(
       TfLiteXNNPackDelegateCreateWithThreadpool(&opts, context),
       TfLiteXNNPackDelegateDelete);
 }
+
+TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(
+    TfLiteContext* context, XNNPackQS8Options xnnpack_qs8_options) {
+  return MaybeCreateXNNPACKDelegate(context, xnnpack_qs8_options,
+                                    /*weight_cache_file_path=*/nullptr);
+}
 #else
 // Using weak symbols to create a delegate allows automatic injection of the
 // delegate simply by adding it as a dependency. See the strong override in
@@ -61,6 +71,14 @@ TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(
     TfLiteContext* context, XNNPackQS8Options xnnpack_qs8_options) {
   return AcquireXNNPACKDelegate();
 }
+
+TfLiteDelegatePtr MaybeCreateXNNPACKDelegate(
+    TfLiteContext* context, XNNPackQS8Options xnnpack_qs8_options,
+    const char* weight_cache_file_path) {
+  // The weight cache path only applies to the XNNPACK delegate options; the
+  // weak-symbol fallback has no options to forward it to.
+  return AcquireXNNPACKDelegate();
+}
 #endif
 
 }  // namespace tflite
@@ -23,6 +23,14 @@ enum class XNNPackQS8Options { default_value, enabled, disabled };
 
 std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
 MaybeCreateXNNPACKDelegate(TfLiteContext* context, XNNPackQS8Options x);
+
+// Same as above, but additionally points the delegate's persistent weight
+// cache at `weight_cache_file_path` so packed weights are restored from disk
+// on subsequent process starts. A null or empty path leaves weight caching
+// disabled. Ignored when the build does not link the XNNPACK delegate.
+std::unique_ptr<TfLiteDelegate, void (*)(TfLiteDelegate*)>
+MaybeCreateXNNPACKDelegate(TfLiteContext* context, XNNPackQS8Options x,
+                           const char* weight_cache_file_path);
 }  // namespace tflite
 
 #endif  // TENSORFLOW_LITE_TFLITE_WITH_XNNPACK_OPTIONAL_H_
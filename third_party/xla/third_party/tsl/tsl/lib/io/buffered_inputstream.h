@@ -26,6 +26,11 @@ namespace io {
 
 // Provides a buffer on top of an InputStreamInterface. A single instance of
 // BufferedInputStream is NOT safe for concurrent use by multiple threads.
+//
+// When constructed directly over a RandomAccessFile whose reads can execute
+// in the background (see RandomAccessFile::SupportsAsyncRead), the
+// underlying RandomAccessInputStream reads the next buffer ahead of time,
+// so sequential consumers overlap file IO with processing.
 class BufferedInputStream : public InputStreamInterface {
  public:
   // Does not take ownership of input_stream unless owns_input_stream is set
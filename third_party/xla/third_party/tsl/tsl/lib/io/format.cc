@@ -15,6 +15,7 @@ limitations under the License.
 
 #include "tsl/lib/io/format.h"
 
+#include <cstring>
 #include <limits>
 
 #include "tsl/lib/hash/crc32c.h"
@@ -163,5 +164,60 @@ absl::Status ReadBlock(RandomAccessFile* file, const BlockHandle& handle,
   return absl::OkStatus();
 }
 
+absl::Status DecodeBlock(const StringPiece& raw, const BlockHandle& handle,
+                         BlockContents* result) {
+  result->data = StringPiece();
+  result->cacheable = false;
+  result->heap_allocated = false;
+
+  const size_t n = static_cast<size_t>(handle.size());
+  if (kBlockTrailerSize > std::numeric_limits<size_t>::max() - n) {
+    return errors::DataLoss("handle.size() too big");
+  }
+  if (raw.size() != n + kBlockTrailerSize) {
+    return errors::DataLoss("truncated block read");
+  }
+
+  // Check the crc of the type and the block contents.
+  const char* data = raw.data();
+  const uint32 crc = crc32c::Unmask(core::DecodeFixed32(data + n + 1));
+  const uint32 actual = crc32c::Value(data, n + 1);
+  if (actual != crc) {
+    return errors::DataLoss("block checksum mismatch");
+  }
+
+  switch (data[n]) {
+    case kNoCompression: {
+      // Copy out of the caller's buffer so the result can outlive it (and be
+      // cached).
+      char* buf = new char[n];
+      memcpy(buf, data, n);
+      result->data = StringPiece(buf, n);
+      result->heap_allocated = true;
+      result->cacheable = true;
+      break;
+    }
+    case kSnappyCompression: {
+      size_t ulength = 0;
+      if (!port::Snappy_GetUncompressedLength(data, n, &ulength)) {
+        return errors::DataLoss("corrupted compressed block contents");
+      }
+      char* ubuf = new char[ulength];
+      if (!port::Snappy_Uncompress(data, n, ubuf)) {
+        delete[] ubuf;
+        return errors::DataLoss("corrupted compressed block contents");
+      }
+      result->data = StringPiece(ubuf, ulength);
+      result->heap_allocated = true;
+      result->cacheable = true;
+      break;
+    }
+    default:
+      return errors::DataLoss("bad block type");
+  }
+
+  return absl::OkStatus();
+}
+
 }  // namespace table
 }  // namespace tsl
@@ -102,6 +102,16 @@ struct BlockContents {
 extern absl::Status ReadBlock(RandomAccessFile* file, const BlockHandle& handle,
                               BlockContents* result);
 
+// Decode the block identified by "handle" from "raw", which must hold the
+// block contents together with the type/crc trailer (i.e. the
+// handle.size() + kBlockTrailerSize bytes at the handle's file extent).  On
+// success fill *result with a heap-allocated copy of the block data and
+// return OK.  Used by bulk loaders that fetch several blocks in one file
+// read and decode them from memory.
+extern absl::Status DecodeBlock(const StringPiece& raw,
+                                const BlockHandle& handle,
+                                BlockContents* result);
+
 // Implementation details follow.  Clients should ignore,
 
 inline BlockHandle::BlockHandle()
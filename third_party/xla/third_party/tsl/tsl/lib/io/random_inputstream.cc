@@ -25,11 +25,33 @@ RandomAccessInputStream::RandomAccessInputStream(RandomAccessFile* file,
     : file_(file), owns_file_(owns_file) {}
 
 RandomAccessInputStream::~RandomAccessInputStream() {
+  DiscardPrefetch();
   if (owns_file_) {
     delete file_;
   }
 }
 
+void RandomAccessInputStream::IssuePrefetch(int64_t offset, int64_t length) {
+  prefetch_ = std::make_unique<Prefetch>();
+  Prefetch* prefetch = prefetch_.get();
+  prefetch->offset = offset;
+  prefetch->length = length;
+  prefetch->buffer.resize_uninitialized(length);
+  file_->ReadAsync(offset, length, &prefetch->buffer[0],
+                   [prefetch](absl::Status status, StringPiece result) {
+                     prefetch->status = std::move(status);
+                     prefetch->result = result;
+                     prefetch->done.Notify();
+                   });
+}
+
+void RandomAccessInputStream::DiscardPrefetch() {
+  if (prefetch_ != nullptr) {
+    prefetch_->done.WaitForNotification();
+    prefetch_.reset();
+  }
+}
+
 absl::Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
                                                  tstring* result) {
   if (bytes_to_read < 0) {
@@ -39,14 +61,35 @@ absl::Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
   result->resize_uninitialized(bytes_to_read);
   char* result_buffer = &(*result)[0];
   StringPiece data;
-  absl::Status s = file_->Read(pos_, bytes_to_read, &data, result_buffer);
-  if (data.data() != result_buffer) {
-    memmove(result_buffer, data.data(), data.size());
+  absl::Status s;
+  if (prefetch_ != nullptr && prefetch_->offset == pos_ &&
+      prefetch_->length == bytes_to_read) {
+    prefetch_->done.WaitForNotification();
+    s = prefetch_->status;
+    memcpy(result_buffer, prefetch_->result.data(), prefetch_->result.size());
+    data = StringPiece(result_buffer, prefetch_->result.size());
+    prefetch_.reset();
+  } else {
+    DiscardPrefetch();
+    s = file_->Read(pos_, bytes_to_read, &data, result_buffer);
+    if (data.data() != result_buffer) {
+      memmove(result_buffer, data.data(), data.size());
+    }
   }
   result->resize(data.size());
+  const bool sequential = pos_ == next_sequential_offset_;
   if (s.ok() || errors::IsOutOfRange(s)) {
     pos_ += data.size();
   }
+  next_sequential_offset_ = pos_;
+  // Once the caller has shown a sequential fixed-size pattern, start
+  // reading the next chunk in the background so it is ready by the time the
+  // caller asks for it.
+  if (s.ok() && sequential && bytes_to_read > 0 &&
+      data.size() == static_cast<size_t>(bytes_to_read) &&
+      file_->SupportsAsyncRead()) {
+    IssuePrefetch(pos_, bytes_to_read);
+  }
   return s;
 }
 
@@ -61,6 +104,7 @@ absl::Status RandomAccessInputStream::ReadNBytes(int64_t bytes_to_read,
   if (s.ok() || errors::IsOutOfRange(s)) {
     pos_ += result->size() - current_size;
   }
+  next_sequential_offset_ = pos_;
   return s;
 }
 #endif
@@ -16,15 +16,24 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_RANDOM_INPUTSTREAM_H_
 #define TENSORFLOW_TSL_LIB_IO_RANDOM_INPUTSTREAM_H_
 
+#include <memory>
+
 #include "tsl/lib/io/inputstream_interface.h"
 #include "tsl/platform/cord.h"
 #include "tsl/platform/file_system.h"
+#include "tsl/platform/notification.h"
 
 namespace tsl {
 namespace io {
 
 // Wraps a RandomAccessFile in an InputStreamInterface. A given instance of
 // RandomAccessInputStream is NOT safe for concurrent use by multiple threads.
+//
+// When the file supports asynchronous reads (see
+// RandomAccessFile::SupportsAsyncRead) and the caller reads fixed-size
+// chunks back to back, the next chunk is read in the background while the
+// caller processes the current one, hiding the read latency from
+// sequential consumers such as BufferedInputStream.
 class RandomAccessInputStream : public InputStreamInterface {
  public:
   // Does not take ownership of 'file' unless owns_file is set to true. 'file'
@@ -51,9 +60,30 @@ class RandomAccessInputStream : public InputStreamInterface {
   absl::Status Reset() override { return Seek(0); }
 
  private:
+  // An in-flight background read of the next chunk.  The callback may fire
+  // on another thread, so the buffer and status live here until `done` has
+  // been notified.
+  struct Prefetch {
+    int64_t offset = 0;  // file offset the read was issued at
+    int64_t length = 0;  // number of bytes requested
+    absl::Status status;
+    StringPiece result;
+    tstring buffer;
+    Notification done;
+  };
+
+  // Starts a background read of [offset, offset + length).
+  void IssuePrefetch(int64_t offset, int64_t length);
+
+  // Waits for any in-flight prefetch and drops its data.
+  void DiscardPrefetch();
+
   RandomAccessFile* file_;  // Not owned.
   int64_t pos_ = 0;         // Tracks where we are in the file.
   bool owns_file_ = false;
+  std::unique_ptr<Prefetch> prefetch_;
+  // End offset of the previous read; used to detect sequential access.
+  int64_t next_sequential_offset_ = -1;
 };
 
 }  // namespace io
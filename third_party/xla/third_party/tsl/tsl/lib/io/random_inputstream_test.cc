@@ -116,6 +116,88 @@ TEST(RandomInputStream, SkipNBytes) {
   EXPECT_EQ(10, in.Tell());
 }
 
+// Wraps a RandomAccessFile and reports asynchronous read support, so the
+// readahead path is exercised regardless of what the platform's file
+// implementation supports.
+class AsyncReadFile : public RandomAccessFile {
+ public:
+  explicit AsyncReadFile(RandomAccessFile* file) : file_(file) {}
+
+  absl::Status Name(StringPiece* result) const override {
+    return file_->Name(result);
+  }
+
+  absl::Status Read(uint64 offset, size_t n, StringPiece* result,
+                    char* scratch) const override {
+    return file_->Read(offset, n, result, scratch);
+  }
+
+  bool SupportsAsyncRead() const override { return true; }
+
+  void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(absl::Status, StringPiece)> done) const override {
+    StringPiece result;
+    absl::Status status = file_->Read(offset, n, &result, scratch);
+    done(status, result);
+  }
+
+ private:
+  RandomAccessFile* file_;  // not owned
+};
+
+TEST(RandomInputStream, SequentialReadsWithPrefetch) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/random_inputbuffer_prefetch_test";
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+  AsyncReadFile async_file(file.get());
+  tstring read;
+  RandomAccessInputStream in(&async_file);
+  // Fixed-size sequential reads; from the third read on, the data comes out
+  // of the prefetch buffer.
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "012");
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "345");
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "678");
+  EXPECT_EQ(9, in.Tell());
+  // The last chunk is short; the prefetched read reports the EOF.
+  EXPECT_TRUE(errors::IsOutOfRange(in.ReadNBytes(3, &read)));
+  EXPECT_EQ(read, "9");
+  EXPECT_EQ(10, in.Tell());
+}
+
+TEST(RandomInputStream, SeekDiscardsPrefetch) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/random_inputbuffer_prefetch_seek_test";
+  TF_ASSERT_OK(WriteStringToFile(env, fname, "0123456789"));
+
+  std::unique_ptr<RandomAccessFile> file;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file));
+  AsyncReadFile async_file(file.get());
+  tstring read;
+  RandomAccessInputStream in(&async_file);
+  // Arm the prefetch with two sequential reads, then seek away from it.
+  TF_ASSERT_OK(in.ReadNBytes(2, &read));
+  EXPECT_EQ(read, "01");
+  TF_ASSERT_OK(in.ReadNBytes(2, &read));
+  EXPECT_EQ(read, "23");
+  TF_ASSERT_OK(in.Seek(1));
+  TF_ASSERT_OK(in.ReadNBytes(2, &read));
+  EXPECT_EQ(read, "12");
+  EXPECT_EQ(3, in.Tell());
+  // A different read size must also bypass the prefetched data.
+  TF_ASSERT_OK(in.ReadNBytes(2, &read));
+  EXPECT_EQ(read, "34");
+  TF_ASSERT_OK(in.ReadNBytes(3, &read));
+  EXPECT_EQ(read, "567");
+  EXPECT_EQ(8, in.Tell());
+}
+
 TEST(RandomInputStream, Seek) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/random_inputbuffer_seek_test";
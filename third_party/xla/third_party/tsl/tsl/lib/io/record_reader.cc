@@ -46,6 +46,8 @@ RecordReaderOptions RecordReaderOptions::CreateRecordReaderOptions(
     options.zlib_options = io::ZlibCompressionOptions::GZIP();
   } else if (compression_type == compression::kSnappy) {
     options.compression_type = io::RecordReaderOptions::SNAPPY_COMPRESSION;
+  } else if (compression_type == compression::kZstd) {
+    options.compression_type = io::RecordReaderOptions::ZSTD_COMPRESSION;
   } else if (compression_type != compression::kNone) {
     LOG(ERROR) << "Unsupported compression_type:" << compression_type
                << ". No compression will be used.";
@@ -77,6 +79,11 @@ RecordReader::RecordReader(RandomAccessFile* file,
     input_stream_.reset(
         new SnappyInputStream(input_stream_.release(),
                               options.snappy_options.output_buffer_size, true));
+  } else if (options.compression_type ==
+             RecordReaderOptions::ZSTD_COMPRESSION) {
+    input_stream_.reset(new ZstdInputStream(
+        input_stream_.release(), options.zstd_options.input_buffer_size,
+        options.zstd_options.output_buffer_size, true));
   } else if (options.compression_type == RecordReaderOptions::NONE) {
     // Nothing to do.
   } else {
@@ -182,6 +189,54 @@ absl::Status RecordReader::GetMetadata(Metadata* md) {
   return absl::OkStatus();
 }
 
+absl::Status RecordReader::GetRecordOffsets(uint64 block_size_bytes,
+                                            std::vector<uint64>* offsets) {
+  if (!offsets) {
+    return errors::InvalidArgument(
+        "Offsets object passed to GetRecordOffsets() was null");
+  }
+  if (block_size_bytes == 0) {
+    return errors::InvalidArgument("block_size_bytes must be positive");
+  }
+  if (options_.compression_type != RecordReaderOptions::NONE ||
+      options_.buffer_size > 0) {
+    return errors::InvalidArgument(
+        "Record offsets are only supported for uncompressed, unbuffered "
+        "record files");
+  }
+
+  TF_RETURN_IF_ERROR(input_stream_->Reset());
+
+  // Within the loop, we always increment offset positively, so this
+  // loop is guaranteed to either return after reaching EOF or
+  // encountering an error.
+  uint64 offset = 0;
+  uint64 next_block_start = 0;
+  tstring record;
+  while (true) {
+    // Read header, containing size of data.
+    absl::Status s = ReadChecksummed(offset, sizeof(uint64), &record);
+    if (!s.ok()) {
+      if (errors::IsOutOfRange(s)) {
+        // We should reach out of range when the record file is complete.
+        break;
+      }
+      return s;
+    }
+
+    if (offset >= next_block_start) {
+      offsets->push_back(offset);
+      next_block_start = (offset / block_size_bytes + 1) * block_size_bytes;
+    }
+
+    // Skip the data and advance to the next record header.
+    const uint64 length = core::DecodeFixed64(record.data());
+    TF_RETURN_IF_ERROR(input_stream_->SkipNBytes(length + kFooterSize));
+    offset += kHeaderSize + length + kFooterSize;
+  }
+  return absl::OkStatus();
+}
+
 absl::Status RecordReader::PositionInputStream(uint64 offset) {
   int64_t curr_pos = input_stream_->Tell();
   int64_t desired_pos = static_cast<int64_t>(offset);
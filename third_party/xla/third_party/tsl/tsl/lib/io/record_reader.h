@@ -16,6 +16,8 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_RECORD_READER_H_
 #define TENSORFLOW_TSL_LIB_IO_RECORD_READER_H_
 
+#include <vector>
+
 #include "tsl/lib/io/inputstream_interface.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/stringpiece.h"
@@ -24,6 +26,8 @@ limitations under the License.
 #include "tsl/lib/io/snappy/snappy_inputstream.h"
 #include "tsl/lib/io/zlib_compression_options.h"
 #include "tsl/lib/io/zlib_inputstream.h"
+#include "tsl/lib/io/zstd_compression_options.h"
+#include "tsl/lib/io/zstd_inputstream.h"
 #endif  // IS_SLIM_BUILD
 #include "tsl/platform/macros.h"
 #include "tsl/platform/types.h"
@@ -37,7 +41,8 @@ struct RecordReaderOptions {
   enum CompressionType {
     NONE = 0,
     ZLIB_COMPRESSION = 1,
-    SNAPPY_COMPRESSION = 2
+    SNAPPY_COMPRESSION = 2,
+    ZSTD_COMPRESSION = 3
   };
   CompressionType compression_type = NONE;
 
@@ -53,6 +58,7 @@ struct RecordReaderOptions {
   // Options specific to compression.
   ZlibCompressionOptions zlib_options;
   SnappyCompressionOptions snappy_options;
+  ZstdCompressionOptions zstd_options;
 #endif  // IS_SLIM_BUILD
 };
 
@@ -114,6 +120,21 @@ class RecordReader {
   // 'metadata' must not be nullptr.
   absl::Status GetMetadata(Metadata* md);
 
+  // Appends to *offsets the byte offset of the first record at or after each
+  // successive `block_size_bytes` boundary of the file (the first record is
+  // always included). The resulting offsets partition the file into roughly
+  // block-sized runs of whole records, so multiple RecordReader cursors can
+  // read disjoint parts of one file in parallel: cursor i reads records in
+  // [(*offsets)[i], (*offsets)[i+1]).
+  //
+  // The scan reads only record headers, not record data. Offsets are byte
+  // positions into the raw file, so this is only supported for uncompressed,
+  // unbuffered files; an InvalidArgument error is returned otherwise.
+  //
+  // 'offsets' must not be nullptr.
+  absl::Status GetRecordOffsets(uint64 block_size_bytes,
+                                std::vector<uint64>* offsets);
+
  private:
   absl::Status ReadChecksummed(uint64 offset, size_t n, tstring* result);
   absl::Status PositionInputStream(uint64 offset);
@@ -45,6 +45,9 @@ io::RecordReaderOptions GetMatchingReaderOptions(
   if (options.compression_type == io::RecordWriterOptions::ZLIB_COMPRESSION) {
     return io::RecordReaderOptions::CreateRecordReaderOptions("ZLIB");
   }
+  if (options.compression_type == io::RecordWriterOptions::ZSTD_COMPRESSION) {
+    return io::RecordReaderOptions::CreateRecordReaderOptions("ZSTD");
+  }
   return io::RecordReaderOptions::CreateRecordReaderOptions("");
 }
 
@@ -121,6 +124,14 @@ TEST(RecordReaderWriterTest, TestZlibSyncFlush) {
   VerifyFlush(options);
 }
 
+TEST(RecordReaderWriterTest, TestZstdFlush) {
+  io::RecordWriterOptions options;
+  options.compression_type = io::RecordWriterOptions::ZSTD_COMPRESSION;
+  // Flush() ends the current zstd compression block, so every record written
+  // so far is decodable by the reader while the frame stays open.
+  VerifyFlush(options);
+}
+
 TEST(RecordReaderWriterTest, TestBasics) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_test";
@@ -162,6 +173,85 @@ TEST(RecordReaderWriterTest, TestBasics) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestWriteRecordsBatch) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_writer_batch_test";
+
+  std::vector<string> data = {"abc", "defg", "",
+                              "ZYXWVUTSRQPONMLKJIHGFEDCBA0123456789"};
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriter writer(file.get(), io::RecordWriterOptions());
+    std::vector<StringPiece> records(data.begin(), data.end());
+    TF_EXPECT_OK(writer.WriteRecords(absl::MakeSpan(records)));
+    // A second (empty) batch is a no-op.
+    TF_EXPECT_OK(writer.WriteRecords({}));
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  {
+    // A batched write must be byte-for-byte equivalent to repeated
+    // WriteRecord() calls.
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReader reader(read_file.get(), io::RecordReaderOptions());
+    uint64 offset = 0;
+    tstring record;
+    for (const string& expected : data) {
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ(expected, record);
+    }
+    CHECK_EQ(reader.ReadRecord(&offset, &record).code(), error::OUT_OF_RANGE);
+  }
+}
+
+TEST(RecordReaderWriterTest, TestGetRecordOffsets) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_offsets_test";
+
+  {
+    std::unique_ptr<WritableFile> file;
+    TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+    io::RecordWriter writer(file.get(), io::RecordWriterOptions());
+    // Each record occupies 16 bytes of header/footer plus 4 bytes of data.
+    for (int i = 0; i < 10; i++) {
+      TF_EXPECT_OK(writer.WriteRecord("abcd"));
+    }
+    TF_CHECK_OK(writer.Flush());
+  }
+
+  {
+    std::unique_ptr<RandomAccessFile> read_file;
+    TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+    io::RecordReader reader(read_file.get(), io::RecordReaderOptions());
+
+    // With a block size of 40 bytes and 20-byte records, every other record
+    // starts a new block.
+    std::vector<uint64> offsets;
+    TF_ASSERT_OK(reader.GetRecordOffsets(40, &offsets));
+    ASSERT_EQ(5, offsets.size());
+    for (int i = 0; i < 5; i++) {
+      EXPECT_EQ(40 * i, offsets[i]);
+    }
+
+    // Each offset is a valid read position.
+    tstring record;
+    for (uint64 offset : offsets) {
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ("abcd", record);
+    }
+
+    // A block size larger than the file yields only the first record.
+    offsets.clear();
+    TF_ASSERT_OK(reader.GetRecordOffsets(1 << 20, &offsets));
+    ASSERT_EQ(1, offsets.size());
+    EXPECT_EQ(0, offsets[0]);
+  }
+}
+
 TEST(RecordReaderWriterTest, TestSkipBasic) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_skip_basic_test";
@@ -343,6 +433,42 @@ TEST(RecordReaderWriterTest, TestZlib) {
   }
 }
 
+TEST(RecordReaderWriterTest, TestZstd) {
+  Env* env = Env::Default();
+  string fname = testing::TmpDir() + "/record_reader_writer_zstd_test";
+
+  for (auto buf_size : BufferSizes()) {
+    {
+      std::unique_ptr<WritableFile> file;
+      TF_CHECK_OK(env->NewWritableFile(fname, &file));
+
+      io::RecordWriterOptions options;
+      options.compression_type = io::RecordWriterOptions::ZSTD_COMPRESSION;
+      options.zstd_options.output_buffer_size = buf_size;
+      io::RecordWriter writer(file.get(), options);
+      TF_EXPECT_OK(writer.WriteRecord("abc"));
+      TF_EXPECT_OK(writer.WriteRecord("defg"));
+      TF_CHECK_OK(writer.Flush());
+    }
+
+    {
+      std::unique_ptr<RandomAccessFile> read_file;
+      // Read it back with the RecordReader.
+      TF_CHECK_OK(env->NewRandomAccessFile(fname, &read_file));
+      io::RecordReaderOptions options;
+      options.compression_type = io::RecordReaderOptions::ZSTD_COMPRESSION;
+      options.zstd_options.input_buffer_size = buf_size;
+      io::RecordReader reader(read_file.get(), options);
+      uint64 offset = 0;
+      tstring record;
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ("abc", record);
+      TF_CHECK_OK(reader.ReadRecord(&offset, &record));
+      EXPECT_EQ("defg", record);
+    }
+  }
+}
+
 TEST(RecordReaderWriterTest, TestUseAfterClose) {
   Env* env = Env::Default();
   string fname = testing::TmpDir() + "/record_reader_writer_flush_close_test";
@@ -30,6 +30,10 @@ bool IsZlibCompressed(const RecordWriterOptions& options) {
 bool IsSnappyCompressed(const RecordWriterOptions& options) {
   return options.compression_type == RecordWriterOptions::SNAPPY_COMPRESSION;
 }
+
+bool IsZstdCompressed(const RecordWriterOptions& options) {
+  return options.compression_type == RecordWriterOptions::ZSTD_COMPRESSION;
+}
 }  // namespace
 
 RecordWriterOptions RecordWriterOptions::CreateRecordWriterOptions(
@@ -49,6 +53,8 @@ RecordWriterOptions RecordWriterOptions::CreateRecordWriterOptions(
     options.zlib_options = io::ZlibCompressionOptions::GZIP();
   } else if (compression_type == compression::kSnappy) {
     options.compression_type = io::RecordWriterOptions::SNAPPY_COMPRESSION;
+  } else if (compression_type == compression::kZstd) {
+    options.compression_type = io::RecordWriterOptions::ZSTD_COMPRESSION;
   } else if (compression_type != compression::kNone) {
     LOG(ERROR) << "Unsupported compression_type:" << compression_type
                << ". No compression will be used.";
@@ -79,6 +85,10 @@ RecordWriter::RecordWriter(WritableFile* dest,
     dest_ =
         new SnappyOutputBuffer(dest, options.snappy_options.input_buffer_size,
                                options.snappy_options.output_buffer_size);
+  } else if (IsZstdCompressed(options)) {
+    dest_ = new ZstdOutputBuffer(dest, options.zstd_options.input_buffer_size,
+                                 options.zstd_options.output_buffer_size,
+                                 options.zstd_options);
   } else if (options.compression_type == RecordWriterOptions::NONE) {
     // Nothing to do
   } else {
@@ -115,6 +125,32 @@ absl::Status RecordWriter::WriteRecord(StringPiece data) {
   return dest_->Append(StringPiece(footer, sizeof(footer)));
 }
 
+absl::Status RecordWriter::WriteRecords(absl::Span<const StringPiece> records) {
+  if (dest_ == nullptr) {
+    return absl::Status(absl::StatusCode::kFailedPrecondition,
+                        "Writer not initialized or previously closed");
+  }
+  if (records.empty()) {
+    return absl::OkStatus();
+  }
+  size_t total_size = 0;
+  for (const StringPiece& data : records) {
+    total_size += kHeaderSize + data.size() + kFooterSize;
+  }
+  batch_scratch_.clear();
+  batch_scratch_.reserve(total_size);
+  char header[kHeaderSize];
+  char footer[kFooterSize];
+  for (const StringPiece& data : records) {
+    PopulateHeader(header, data.data(), data.size());
+    PopulateFooter(footer, data.data(), data.size());
+    batch_scratch_.append(header, kHeaderSize);
+    batch_scratch_.append(data.data(), data.size());
+    batch_scratch_.append(footer, kFooterSize);
+  }
+  return dest_->Append(batch_scratch_);
+}
+
 #if defined(TF_CORD_SUPPORT)
 absl::Status RecordWriter::WriteRecord(const absl::Cord& data) {
   if (dest_ == nullptr) {
@@ -138,7 +174,8 @@ absl::Status RecordWriter::WriteRecord(const absl::Cord& data) {
 
 absl::Status RecordWriter::Close() {
   if (dest_ == nullptr) return absl::OkStatus();
-  if (IsZlibCompressed(options_) || IsSnappyCompressed(options_)) {
+  if (IsZlibCompressed(options_) || IsSnappyCompressed(options_) ||
+      IsZstdCompressed(options_)) {
     absl::Status s = dest_->Close();
     delete dest_;
     dest_ = nullptr;
@@ -16,6 +16,7 @@ limitations under the License.
 #ifndef TENSORFLOW_TSL_LIB_IO_RECORD_WRITER_H_
 #define TENSORFLOW_TSL_LIB_IO_RECORD_WRITER_H_
 
+#include "absl/types/span.h"
 #include "tsl/lib/hash/crc32c.h"
 #include "tsl/platform/coding.h"
 #include "tsl/platform/status.h"
@@ -25,6 +26,8 @@ limitations under the License.
 #include "tsl/lib/io/snappy/snappy_outputbuffer.h"
 #include "tsl/lib/io/zlib_compression_options.h"
 #include "tsl/lib/io/zlib_outputbuffer.h"
+#include "tsl/lib/io/zstd_compression_options.h"
+#include "tsl/lib/io/zstd_outputbuffer.h"
 #endif  // IS_SLIM_BUILD
 #include "tsl/platform/cord.h"
 #include "tsl/platform/macros.h"
@@ -41,7 +44,8 @@ struct RecordWriterOptions {
   enum CompressionType {
     NONE = 0,
     ZLIB_COMPRESSION = 1,
-    SNAPPY_COMPRESSION = 2
+    SNAPPY_COMPRESSION = 2,
+    ZSTD_COMPRESSION = 3
   };
   CompressionType compression_type = NONE;
 
@@ -52,6 +56,7 @@ struct RecordWriterOptions {
   // Options specific to compression.
   io::ZlibCompressionOptions zlib_options;
   io::SnappyCompressionOptions snappy_options;
+  io::ZstdCompressionOptions zstd_options;
 #endif  // IS_SLIM_BUILD
 };
 
@@ -83,6 +88,14 @@ class RecordWriter {
   absl::Status WriteRecord(const absl::Cord& data);
 #endif
 
+  // Writes a batch of records, each framed exactly as by WriteRecord().
+  // The headers, payloads, and footers of the whole batch are gathered into a
+  // scratch buffer owned by the writer and handed to the destination in a
+  // single Append() call, amortizing per-append overhead across the batch.
+  // The scratch buffer keeps its capacity between calls, so steady-state
+  // batched writes do not allocate.
+  absl::Status WriteRecords(absl::Span<const StringPiece> records);
+
   // Flushes any buffered data held by underlying containers of the
   // RecordWriter to the WritableFile. Does *not* flush the
   // WritableFile.
@@ -114,6 +127,9 @@ class RecordWriter {
   WritableFile* dest_;
   RecordWriterOptions options_;
 
+  // Reusable scratch space for assembling batches in WriteRecords().
+  string batch_scratch_;
+
   inline static uint32 MaskedCrc(const char* data, size_t n) {
     return crc32c::Mask(crc32c::Value(data, n));
   }
@@ -15,6 +15,10 @@ limitations under the License.
 
 #include "tsl/lib/io/table.h"
 
+#include <algorithm>
+#include <memory>
+#include <vector>
+
 #include "tsl/lib/io/block.h"
 #include "tsl/lib/io/cache.h"
 #include "tsl/lib/io/format.h"
@@ -23,6 +27,7 @@ limitations under the License.
 #include "tsl/platform/coding.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
+#include "tsl/platform/threadpool.h"
 
 namespace tsl {
 namespace table {
@@ -158,6 +163,154 @@ Iterator* Table::NewIterator() const {
                              &Table::BlockReader, const_cast<Table*>(this));
 }
 
+absl::Status Table::PrefetchBlocks(const std::vector<StringPiece>& keys) {
+  // Upper bound on the size of one coalesced file read.
+  static const uint64 kMaxBytesPerRead = 8 << 20;
+  // Number of threads used to decode (crc-check and decompress) the fetched
+  // blocks.
+  static const int kMaxDecodeThreads = 8;
+
+  Cache* block_cache = rep_->options.block_cache;
+  if (block_cache == nullptr) {
+    return errors::FailedPrecondition(
+        "Table::PrefetchBlocks requires a block cache to populate");
+  }
+
+  // Map the keys to the distinct handles of the blocks that may hold them.
+  std::vector<BlockHandle> handles;
+  {
+    Iterator* iiter = rep_->index_block->NewIterator();
+    uint64 last_offset = ~static_cast<uint64>(0);
+    for (const StringPiece& key : keys) {
+      iiter->Seek(key);
+      if (!iiter->Valid()) continue;  // Past the last block.
+      BlockHandle handle;
+      StringPiece input = iiter->value();
+      absl::Status s = handle.DecodeFrom(&input);
+      if (!s.ok()) {
+        delete iiter;
+        return s;
+      }
+      if (handle.offset() != last_offset) {
+        last_offset = handle.offset();
+        handles.push_back(handle);
+      }
+    }
+    absl::Status s = iiter->status();
+    delete iiter;
+    if (!s.ok()) return s;
+  }
+
+  // Sort by file offset and drop duplicates (for unsorted callers) and
+  // blocks that are already cached.
+  std::sort(handles.begin(), handles.end(),
+            [](const BlockHandle& a, const BlockHandle& b) {
+              return a.offset() < b.offset();
+            });
+  std::vector<BlockHandle> to_fetch;
+  to_fetch.reserve(handles.size());
+  for (const BlockHandle& handle : handles) {
+    if (!to_fetch.empty() && to_fetch.back().offset() == handle.offset()) {
+      continue;
+    }
+    char cache_key_buffer[16];
+    core::EncodeFixed64(cache_key_buffer, rep_->cache_id);
+    core::EncodeFixed64(cache_key_buffer + 8, handle.offset());
+    absl::string_view key(cache_key_buffer, sizeof(cache_key_buffer));
+    Cache::Handle* cache_handle = block_cache->Lookup(key);
+    if (cache_handle != nullptr) {
+      block_cache->Release(cache_handle);
+      continue;
+    }
+    to_fetch.push_back(handle);
+  }
+  if (to_fetch.empty()) return absl::OkStatus();
+
+  // Coalesce adjacent blocks -- they are laid out back to back in the file,
+  // each followed by its kBlockTrailerSize trailer -- into large sequential
+  // reads.
+  struct Run {
+    uint64 offset;
+    uint64 size;
+    size_t first_block;
+    size_t num_blocks;
+  };
+  std::vector<Run> runs;
+  for (size_t i = 0; i < to_fetch.size(); ++i) {
+    const uint64 extent = to_fetch[i].size() + kBlockTrailerSize;
+    if (!runs.empty() &&
+        runs.back().offset + runs.back().size == to_fetch[i].offset() &&
+        runs.back().size + extent <= kMaxBytesPerRead) {
+      runs.back().size += extent;
+      ++runs.back().num_blocks;
+    } else {
+      runs.push_back({to_fetch[i].offset(), extent, i, 1});
+    }
+  }
+
+  // Issue the coalesced reads, decoding each fetched block on a pool: once
+  // reads are this large, the checksum verification and decompression are
+  // what is left on the critical path.
+  std::vector<std::unique_ptr<char[]>> buffers(runs.size());
+  std::vector<StringPiece> contents(runs.size());
+  std::vector<Block*> blocks(to_fetch.size(), nullptr);
+  std::vector<absl::Status> statuses(to_fetch.size());
+  {
+    thread::ThreadPool decode_pool(
+        Env::Default(), "table_prefetch_decode",
+        std::min<int>(kMaxDecodeThreads, static_cast<int>(to_fetch.size())));
+    for (size_t r = 0; r < runs.size(); ++r) {
+      const Run& run = runs[r];
+      buffers[r].reset(new char[run.size]);
+      absl::Status s =
+          rep_->file->Read(run.offset, run.size, &contents[r], buffers[r].get());
+      if (s.ok() && contents[r].size() != run.size) {
+        s = errors::DataLoss("truncated block read");
+      }
+      if (!s.ok()) {
+        for (size_t b = run.first_block; b < run.first_block + run.num_blocks;
+             ++b) {
+          statuses[b] = s;
+        }
+        continue;
+      }
+      for (size_t b = run.first_block; b < run.first_block + run.num_blocks;
+           ++b) {
+        decode_pool.Schedule([b, r, run_offset = run.offset, &to_fetch,
+                              &contents, &blocks, &statuses] {
+          const BlockHandle& handle = to_fetch[b];
+          const StringPiece raw(
+              contents[r].data() + (handle.offset() - run_offset),
+              handle.size() + kBlockTrailerSize);
+          BlockContents block_contents;
+          statuses[b] = DecodeBlock(raw, handle, &block_contents);
+          if (statuses[b].ok()) blocks[b] = new Block(block_contents);
+        });
+      }
+    }
+    // The pool joins at the end of this scope; the read buffers must stay
+    // alive until then.
+  }
+
+  absl::Status status;
+  for (const absl::Status& s : statuses) status.Update(s);
+  for (size_t b = 0; b < to_fetch.size(); ++b) {
+    if (blocks[b] == nullptr) continue;
+    if (!status.ok()) {
+      delete blocks[b];
+      continue;
+    }
+    char cache_key_buffer[16];
+    core::EncodeFixed64(cache_key_buffer, rep_->cache_id);
+    core::EncodeFixed64(cache_key_buffer + 8, to_fetch[b].offset());
+    absl::string_view key(cache_key_buffer, sizeof(cache_key_buffer));
+    Cache::Handle* cache_handle = block_cache->Insert(
+        key, blocks[b], blocks[b]->size(), &DeleteCachedBlock);
+    block_cache->Release(cache_handle);
+  }
+  return status;
+}
+
 absl::Status Table::InternalGet(const StringPiece& k, void* arg,
                                 void (*saver)(void*, const StringPiece&,
                                               const StringPiece&)) {
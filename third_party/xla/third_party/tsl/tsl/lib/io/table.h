@@ -18,6 +18,8 @@ limitations under the License.
 
 #include <stdint.h>
 
+#include <vector>
+
 #include "tsl/lib/io/iterator.h"
 
 namespace tsl {
@@ -53,6 +55,17 @@ class Table {
   // call one of the Seek methods on the iterator before using it).
   Iterator* NewIterator() const;
 
+  // Bulk-loads the data blocks covering "keys" into the block cache.  The
+  // keys should be sorted so that consecutive keys map to the same or
+  // adjacent blocks; reads of adjacent blocks are coalesced into large
+  // sequential file reads and the fetched blocks are decoded on a small
+  // thread pool.  Blocks already present in the cache are not re-read.
+  // Subsequent lookups and iteration over the prefetched key range are then
+  // served from the cache instead of issuing per-block reads.  Requires a
+  // block cache to be configured in Options; returns FailedPrecondition
+  // otherwise.
+  absl::Status PrefetchBlocks(const std::vector<StringPiece>& keys);
+
   // Given a key, return an approximate byte offset in the file where
   // the data for that key begins (or would begin if the key were
   // present in the file).  The returned value is in terms of file
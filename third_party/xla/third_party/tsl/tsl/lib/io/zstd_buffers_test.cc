@@ -0,0 +1,191 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/core/status_test_util.h"
+#include "tsl/lib/io/random_inputstream.h"
+#include "tsl/lib/io/zstd_compression_options.h"
+#include "tsl/lib/io/zstd_inputstream.h"
+#include "tsl/lib/io/zstd_outputbuffer.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/errors.h"
+#include "tsl/platform/strcat.h"
+#include "tsl/platform/test.h"
+
+namespace tsl {
+namespace io {
+
+static std::vector<int> InputBufferSizes() {
+  return {10, 100, 200, 500, 1000, 10000};
+}
+
+static std::vector<int> OutputBufferSizes() { return {100, 200, 500, 1000}; }
+
+static std::vector<int> NumCopies() { return {1, 50, 500}; }
+
+static string GetRecord() {
+  static const string lorem_ipsum =
+      "Lorem ipsum dolor sit amet, consectetur adipiscing elit."
+      " Fusce vehicula tincidunt libero sit amet ultrices. Vestibulum non "
+      "felis augue. Duis vitae augue id lectus lacinia congue et ut purus. "
+      "Donec auctor, nisl at dapibus volutpat, diam ante lacinia dolor, vel"
+      "dignissim lacus nisi sed purus. Duis fringilla nunc ac lacus sagittis"
+      " efficitur. Praesent tincidunt egestas eros, eu vehicula urna ultrices"
+      " et. Aliquam erat volutpat. Maecenas vehicula risus consequat risus"
+      " dictum, luctus tincidunt nibh imperdiet. Aenean bibendum ac erat"
+      " cursus scelerisque. Cras lacinia in enim dapibus iaculis. Nunc porta"
+      " felis lectus, ac tincidunt massa pharetra quis. Fusce feugiat dolor"
+      " vel ligula rutrum egestas. Donec vulputate quam eros, et commodo"
+      " purus lobortis sed.";
+  return lorem_ipsum;
+}
+
+static string GenTestString(int copies = 1) {
+  string result = "";
+  for (int i = 0; i < copies; i++) {
+    result += GetRecord();
+  }
+  return result;
+}
+
+void TestAllCombinations(const ZstdCompressionOptions& options) {
+  Env* env = Env::Default();
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  for (auto file_size : NumCopies()) {
+    // Write to compressed file
+    string data = GenTestString(file_size);
+    for (auto input_buf_size : InputBufferSizes()) {
+      for (auto output_buf_size : OutputBufferSizes()) {
+        std::unique_ptr<WritableFile> file_writer;
+        TF_ASSERT_OK(env->NewWritableFile(fname, &file_writer));
+        tstring result;
+
+        ZstdOutputBuffer out(file_writer.get(), input_buf_size, output_buf_size,
+                             options);
+
+        TF_ASSERT_OK(out.Append(StringPiece(data)));
+        TF_ASSERT_OK(out.Close());
+        TF_ASSERT_OK(file_writer->Flush());
+        TF_ASSERT_OK(file_writer->Close());
+
+        std::unique_ptr<RandomAccessFile> file_reader;
+        TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file_reader));
+        std::unique_ptr<RandomAccessInputStream> input_stream(
+            new RandomAccessInputStream(file_reader.get()));
+        ZstdInputStream in(input_stream.get(), input_buf_size, output_buf_size);
+        TF_ASSERT_OK(in.ReadNBytes(data.size(), &result));
+        EXPECT_EQ(result, data);
+      }
+    }
+  }
+}
+
+TEST(ZstdBuffers, DefaultOptions) {
+  TestAllCombinations(ZstdCompressionOptions());
+}
+
+TEST(ZstdBuffers, FastestLevel) {
+  ZstdCompressionOptions options;
+  options.compression_level = 1;
+  TestAllCombinations(options);
+}
+
+TEST(ZstdBuffers, HighCompressionLevel) {
+  ZstdCompressionOptions options;
+  options.compression_level = 19;
+  TestAllCombinations(options);
+}
+
+void TestMultipleWrites(int input_buf_size, int output_buf_size, int num_writes,
+                        bool with_flush = false) {
+  Env* env = Env::Default();
+
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  string data = GenTestString();
+  std::unique_ptr<WritableFile> file_writer;
+  string expected_result;
+
+  TF_ASSERT_OK(env->NewWritableFile(fname, &file_writer));
+  ZstdOutputBuffer out(file_writer.get(), input_buf_size, output_buf_size,
+                       ZstdCompressionOptions());
+
+  for (int i = 0; i < num_writes; i++) {
+    TF_ASSERT_OK(out.Append(StringPiece(data)));
+    if (with_flush) {
+      TF_ASSERT_OK(out.Flush());
+    }
+    strings::StrAppend(&expected_result, data);
+  }
+  TF_ASSERT_OK(out.Close());
+  TF_ASSERT_OK(file_writer->Flush());
+  TF_ASSERT_OK(file_writer->Close());
+
+  std::unique_ptr<RandomAccessFile> file_reader;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file_reader));
+  std::unique_ptr<RandomAccessInputStream> input_stream(
+      new RandomAccessInputStream(file_reader.get()));
+  ZstdInputStream in(input_stream.get(), input_buf_size, output_buf_size);
+
+  tstring result;
+  TF_ASSERT_OK(in.ReadNBytes(expected_result.size(), &result));
+  EXPECT_EQ(result, expected_result);
+}
+
+TEST(ZstdBuffers, MultipleWritesWithoutFlush) {
+  TestMultipleWrites(200, 200, 10);
+}
+
+TEST(ZstdBuffers, MultipleWritesWithFlush) {
+  // A flush ends the current compression block, so everything written so far
+  // is decodable by the reader even though the frame is still open.
+  TestMultipleWrites(200, 200, 10, true);
+}
+
+TEST(ZstdBuffers, TellAndReset) {
+  Env* env = Env::Default();
+
+  string fname;
+  ASSERT_TRUE(env->LocalTempFilename(&fname));
+  string data = GenTestString(10);
+  std::unique_ptr<WritableFile> file_writer;
+
+  TF_ASSERT_OK(env->NewWritableFile(fname, &file_writer));
+  ZstdOutputBuffer out(file_writer.get(), 200, 200, ZstdCompressionOptions());
+  TF_ASSERT_OK(out.Append(StringPiece(data)));
+  TF_ASSERT_OK(out.Close());
+  TF_ASSERT_OK(file_writer->Flush());
+  TF_ASSERT_OK(file_writer->Close());
+
+  std::unique_ptr<RandomAccessFile> file_reader;
+  TF_ASSERT_OK(env->NewRandomAccessFile(fname, &file_reader));
+  std::unique_ptr<RandomAccessInputStream> input_stream(
+      new RandomAccessInputStream(file_reader.get()));
+  ZstdInputStream in(input_stream.get(), 200, 200);
+
+  tstring first_half;
+  TF_ASSERT_OK(in.ReadNBytes(data.size() / 2, &first_half));
+  EXPECT_EQ(in.Tell(), static_cast<int64_t>(data.size() / 2));
+
+  // After a reset the stream decompresses from the beginning again.
+  TF_ASSERT_OK(in.Reset());
+  EXPECT_EQ(in.Tell(), 0);
+  tstring result;
+  TF_ASSERT_OK(in.ReadNBytes(data.size(), &result));
+  EXPECT_EQ(result, data);
+}
+
+}  // namespace io
+}  // namespace tsl
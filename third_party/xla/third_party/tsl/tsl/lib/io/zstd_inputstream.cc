@@ -0,0 +1,192 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/zstd_inputstream.h"
+
+#include <algorithm>
+#include <cstring>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+
+namespace tsl {
+namespace io {
+
+ZstdInputStream::ZstdInputStream(InputStreamInterface* input_stream,
+                                 size_t input_buffer_bytes,
+                                 size_t output_buffer_bytes,
+                                 bool owns_input_stream)
+    : owns_input_stream_(owns_input_stream),
+      input_stream_(input_stream),
+      input_buffer_capacity_(input_buffer_bytes),
+      output_buffer_capacity_(output_buffer_bytes),
+      input_buffer_(new char[input_buffer_capacity_]),
+      output_buffer_(new char[output_buffer_capacity_]),
+      context_(ZSTD_createDCtx()),
+      bytes_read_(0) {
+  CHECK(context_ != nullptr) << "ZSTD_createDCtx failed";
+  InitZstdBuffer();
+}
+
+ZstdInputStream::ZstdInputStream(InputStreamInterface* input_stream,
+                                 size_t input_buffer_bytes,
+                                 size_t output_buffer_bytes)
+    : ZstdInputStream(input_stream, input_buffer_bytes, output_buffer_bytes,
+                      false) {}
+
+ZstdInputStream::~ZstdInputStream() {
+  ZSTD_freeDCtx(context_);
+  if (owns_input_stream_) {
+    delete input_stream_;
+  }
+}
+
+void ZstdInputStream::InitZstdBuffer() {
+  input_.src = input_buffer_.get();
+  input_.size = 0;
+  input_.pos = 0;
+  output_.dst = output_buffer_.get();
+  output_.size = output_buffer_capacity_;
+  output_.pos = 0;
+  next_unread_byte_ = output_buffer_.get();
+}
+
+absl::Status ZstdInputStream::Reset() {
+  TF_RETURN_IF_ERROR(input_stream_->Reset());
+  ZSTD_DCtx_reset(context_, ZSTD_reset_session_only);
+  InitZstdBuffer();
+  bytes_read_ = 0;
+  return absl::OkStatus();
+}
+
+absl::Status ZstdInputStream::ReadFromStream() {
+  size_t bytes_to_read = input_buffer_capacity_;
+  char* read_location = input_buffer_.get();
+
+  // If there are unconsumed compressed bytes in the input buffer we move them
+  // to the head of the buffer to maximize the space available to read new
+  // data into.
+  const size_t unread_bytes = input_.size - input_.pos;
+  if (unread_bytes > 0) {
+    memmove(input_buffer_.get(), input_buffer_.get() + input_.pos,
+            unread_bytes);
+    bytes_to_read -= unread_bytes;
+    read_location += unread_bytes;
+  }
+
+  tstring data;
+  // Try to read enough data to fill up input_buffer_.
+  absl::Status s = input_stream_->ReadNBytes(bytes_to_read, &data);
+  memcpy(read_location, data.data(), data.size());
+
+  // Since we moved unconsumed data to the head of the input buffer we can
+  // point the decompressor back at its start.
+  input_.pos = 0;
+
+  // Note: data.size() could be different from bytes_to_read.
+  input_.size = unread_bytes + data.size();
+
+  if (!s.ok() && !errors::IsOutOfRange(s)) {
+    return s;
+  }
+
+  // We throw OutOfRange error iff no new data has been read from stream.
+  // Since we never check how much data is remaining in the stream, it is
+  // possible that on the last read there isn't enough data in the stream to
+  // fill up the buffer in which case input_stream_->ReadNBytes would return an
+  // OutOfRange error.
+  if (data.empty()) {
+    return errors::OutOfRange("EOF reached");
+  }
+  if (errors::IsOutOfRange(s)) {
+    return absl::OkStatus();
+  }
+
+  return s;
+}
+
+size_t ZstdInputStream::ReadBytesFromCache(size_t bytes_to_read,
+                                           tstring* result) {
+  size_t can_read_bytes = std::min(bytes_to_read, NumUnreadBytes());
+  if (can_read_bytes > 0) {
+    result->append(next_unread_byte_, can_read_bytes);
+    next_unread_byte_ += can_read_bytes;
+  }
+  bytes_read_ += can_read_bytes;
+  return can_read_bytes;
+}
+
+size_t ZstdInputStream::NumUnreadBytes() const {
+  return (output_buffer_.get() + output_.pos) - next_unread_byte_;
+}
+
+absl::Status ZstdInputStream::ReadNBytes(int64_t bytes_to_read,
+                                         tstring* result) {
+  result->clear();
+  // Read as many bytes as possible from cache.
+  bytes_to_read -= ReadBytesFromCache(bytes_to_read, result);
+
+  while (bytes_to_read > 0) {
+    // At this point we can be sure that cache has been emptied.
+    DCHECK_EQ(NumUnreadBytes(), 0);
+
+    // Now that the cache is empty we need to decompress more data.
+
+    // Step 1. Setup output buffer.
+    output_.pos = 0;
+    next_unread_byte_ = output_buffer_.get();
+
+    // Step 2. Try to decompress some input data.
+    TF_RETURN_IF_ERROR(Inflate());
+
+    // Step 3. Read any data produced by the decompressor. If no progress was
+    // made, read more compressed data from the input stream.
+    if (NumUnreadBytes() == 0) {
+      TF_RETURN_IF_ERROR(ReadFromStream());
+    } else {
+      bytes_to_read -= ReadBytesFromCache(bytes_to_read, result);
+    }
+  }
+
+  return absl::OkStatus();
+}
+
+#if defined(TF_CORD_SUPPORT)
+absl::Status ZstdInputStream::ReadNBytes(int64_t bytes_to_read,
+                                         absl::Cord* result) {
+  // TODO(frankchn): Optimize this instead of bouncing through the buffer.
+  tstring buf;
+  TF_RETURN_IF_ERROR(ReadNBytes(bytes_to_read, &buf));
+  result->Clear();
+  result->Append(buf.data());
+  return absl::OkStatus();
+}
+#endif
+
+int64_t ZstdInputStream::Tell() const { return bytes_read_; }
+
+absl::Status ZstdInputStream::Inflate() {
+  // When a frame is fully decoded the context is automatically ready for the
+  // next frame, so concatenated frames decompress as one logical stream.
+  const size_t status = ZSTD_decompressStream(context_, &output_, &input_);
+  if (ZSTD_isError(status)) {
+    return errors::DataLoss("ZSTD_decompressStream failed: ",
+                            ZSTD_getErrorName(status));
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace io
+}  // namespace tsl
@@ -0,0 +1,137 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_IO_ZSTD_INPUTSTREAM_H_
+#define TENSORFLOW_TSL_LIB_IO_ZSTD_INPUTSTREAM_H_
+
+#include <zstd.h>
+
+#include <memory>
+
+#include "tsl/lib/io/inputstream_interface.h"
+#include "tsl/lib/io/zstd_compression_options.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/macros.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace io {
+
+// A ZstdInputStream provides support for reading from a stream compressed
+// using zstd (https://facebook.github.io/zstd/). The compressed input may
+// consist of any number of concatenated zstd frames; frame boundaries are
+// invisible to the caller.
+//
+// A given instance of a ZstdInputStream is NOT safe for concurrent use
+// by multiple threads.
+class ZstdInputStream : public InputStreamInterface {
+ public:
+  // Create a ZstdInputStream for `input_stream` with a buffer of size
+  // `input_buffer_bytes` bytes for reading contents from `input_stream` and
+  // another buffer with size `output_buffer_bytes` for caching decompressed
+  // contents.
+  //
+  // Takes ownership of `input_stream` iff `owns_input_stream` is true.
+  ZstdInputStream(InputStreamInterface* input_stream, size_t input_buffer_bytes,
+                  size_t output_buffer_bytes, bool owns_input_stream);
+
+  // Equivalent to the previous constructor with owns_input_stream=false.
+  ZstdInputStream(InputStreamInterface* input_stream, size_t input_buffer_bytes,
+                  size_t output_buffer_bytes);
+
+  ~ZstdInputStream() override;
+
+  // Reads bytes_to_read bytes into *result, overwriting *result.
+  //
+  // Return Status codes:
+  // OK:           If successful.
+  // OUT_OF_RANGE: If there are not enough bytes to read before
+  //               the end of the stream.
+  // DATA_LOSS:    If ZSTD_decompressStream() fails.
+  // others:       If reading from stream failed.
+  absl::Status ReadNBytes(int64_t bytes_to_read, tstring* result) override;
+
+#if defined(TF_CORD_SUPPORT)
+  absl::Status ReadNBytes(int64_t bytes_to_read, absl::Cord* result) override;
+#endif
+
+  int64_t Tell() const override;
+
+  absl::Status Reset() override;
+
+ private:
+  void InitZstdBuffer();
+
+  // Reads data from `input_stream_` and tries to fill up `input_buffer_` if
+  // enough unread data is left in `input_stream_`.
+  //
+  // Unconsumed bytes (input_.size - input_.pos) are moved to the head of
+  // `input_buffer_` and new data is appended after them. After this call
+  // input_.pos is 0 and input_.size is the number of readable bytes in
+  // `input_buffer_`.
+  //
+  // Returns OutOfRange error if NO data could be read from stream. Note that
+  // this won't return an OutOfRange if there wasn't sufficient data in stream
+  // to completely fill up `input_buffer_`.
+  absl::Status ReadFromStream();
+
+  // Calls `ZSTD_decompressStream()` and returns DataLoss Status if it failed.
+  absl::Status Inflate();
+
+  // Starts reading bytes at `next_unread_byte_` till either `bytes_to_read`
+  // bytes have been read or the end of the decompressed output is reached.
+  // Returns the number of bytes read and advances the `next_unread_byte_`
+  // pointer to the next location to read from.
+  size_t ReadBytesFromCache(size_t bytes_to_read, tstring* result);
+
+  // The number of unread bytes in `output_buffer_`, i.e. the size of
+  // [next_unread_byte_, output_buffer_ + output_.pos).
+  size_t NumUnreadBytes() const;
+
+  const bool owns_input_stream_;
+  InputStreamInterface* input_stream_;
+  const size_t input_buffer_capacity_;   // Size of input_buffer_
+  const size_t output_buffer_capacity_;  // Size of output_buffer_
+
+  // Buffer for storing contents read from compressed stream.
+  std::unique_ptr<char[]> input_buffer_;
+
+  // Buffer for storing decompressed contents of `input_stream_`.
+  std::unique_ptr<char[]> output_buffer_;
+
+  char* next_unread_byte_;  // Next unread byte in output_buffer_
+
+  ZSTD_DCtx* context_;
+
+  // input_.pos .. input_.size delimit the compressed bytes in `input_buffer_`
+  // not yet consumed by the decompressor.
+  ZSTD_inBuffer input_;
+
+  // output_.pos is the number of decompressed bytes written to
+  // `output_buffer_` by the decompressor.
+  ZSTD_outBuffer output_;
+
+  // Number of *uncompressed* bytes that have been read from this stream.
+  int64_t bytes_read_;
+
+  ZstdInputStream(const ZstdInputStream&) = delete;
+  void operator=(const ZstdInputStream&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_LIB_IO_ZSTD_INPUTSTREAM_H_
@@ -0,0 +1,199 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#include "tsl/lib/io/zstd_outputbuffer.h"
+
+#include <cstring>
+
+#include "tsl/platform/errors.h"
+#include "tsl/platform/logging.h"
+
+namespace tsl {
+namespace io {
+
+ZstdOutputBuffer::ZstdOutputBuffer(WritableFile* file,
+                                   int32_t input_buffer_bytes,
+                                   int32_t output_buffer_bytes,
+                                   const ZstdCompressionOptions& zstd_options)
+    : file_(file),
+      input_buffer_(new char[input_buffer_bytes]),
+      input_buffer_capacity_(input_buffer_bytes),
+      next_in_(input_buffer_.get()),
+      output_buffer_(new char[output_buffer_bytes]),
+      output_buffer_capacity_(output_buffer_bytes),
+      next_out_(output_buffer_.get()),
+      avail_out_(output_buffer_bytes),
+      context_(ZSTD_createCCtx()) {
+  CHECK(context_ != nullptr) << "ZSTD_createCCtx failed";
+  const size_t status = ZSTD_CCtx_setParameter(
+      context_, ZSTD_c_compressionLevel, zstd_options.compression_level);
+  CHECK(!ZSTD_isError(status))
+      << "Setting zstd compression level failed: " << ZSTD_getErrorName(status);
+}
+
+ZstdOutputBuffer::~ZstdOutputBuffer() {
+  size_t bytes_to_write = output_buffer_capacity_ - avail_out_;
+  if (bytes_to_write > 0 || avail_in_ > 0) {
+    LOG(WARNING) << "There is still data in the output buffer. "
+                 << "Possible data loss has occurred.";
+  }
+  ZSTD_freeCCtx(context_);
+}
+
+absl::Status ZstdOutputBuffer::Append(StringPiece data) {
+  // The compressed output is accumulated in output_buffer_ and gets written to
+  // file as and when needed.
+
+  size_t bytes_to_write = data.size();
+
+  // If there is sufficient free space in input_buffer_ to fit data we
+  // add it there and return.
+  if (static_cast<int32>(bytes_to_write) <= AvailableInputSpace()) {
+    AddToInputBuffer(data);
+    return absl::OkStatus();
+  }
+
+  // If there isn't enough available space in the input_buffer_ we empty it
+  // by compressing its contents. If data now fits in input_buffer_
+  // we add it there else we directly compress it.
+  TF_RETURN_IF_ERROR(Deflate(ZSTD_e_continue));
+
+  // input_buffer_ should be empty at this point.
+  if (static_cast<int32>(bytes_to_write) <= AvailableInputSpace()) {
+    AddToInputBuffer(data);
+    return absl::OkStatus();
+  }
+
+  // `data` is too large to fit in input buffer so we compress it directly.
+  // Note that at this point we have already compressed all existing input so
+  // we do not need to backup next_in and avail_in.
+  next_in_ = const_cast<char*>(data.data());
+  avail_in_ = bytes_to_write;
+
+  TF_RETURN_IF_ERROR(Deflate(ZSTD_e_continue));
+
+  DCHECK_EQ(avail_in_, 0);  // All input will be used up.
+
+  next_in_ = input_buffer_.get();
+
+  return absl::OkStatus();
+}
+
+#if defined(TF_CORD_SUPPORT)
+absl::Status ZstdOutputBuffer::Append(const absl::Cord& cord) {
+  for (absl::string_view fragment : cord.Chunks()) {
+    TF_RETURN_IF_ERROR(Append(fragment));
+  }
+  return absl::OkStatus();
+}
+#endif
+
+absl::Status ZstdOutputBuffer::Close() {
+  TF_RETURN_IF_ERROR(Deflate(ZSTD_e_end));
+  return FlushOutputBufferToFile();
+}
+
+absl::Status ZstdOutputBuffer::Name(StringPiece* result) const {
+  return file_->Name(result);
+}
+
+absl::Status ZstdOutputBuffer::Sync() {
+  TF_RETURN_IF_ERROR(Flush());
+  return file_->Sync();
+}
+
+absl::Status ZstdOutputBuffer::Tell(int64_t* position) {
+  return file_->Tell(position);
+}
+
+absl::Status ZstdOutputBuffer::Flush() {
+  TF_RETURN_IF_ERROR(Deflate(ZSTD_e_flush));
+  return FlushOutputBufferToFile();
+}
+
+int32 ZstdOutputBuffer::AvailableInputSpace() const {
+  return input_buffer_capacity_ - avail_in_;
+}
+
+void ZstdOutputBuffer::AddToInputBuffer(StringPiece data) {
+  size_t bytes_to_write = data.size();
+  DCHECK_LE(bytes_to_write, AvailableInputSpace());
+
+  // next_in_ points to the head of the unconsumed input; Deflate() always
+  // consumes all input, so unconsumed bytes start at input_buffer_ and we can
+  // simply append at next_in_ + avail_in_ after compacting to the head.
+  const int32_t read_bytes = next_in_ - input_buffer_.get();
+  const int32_t unread_bytes = avail_in_;
+  const int32_t free_tail_bytes =
+      input_buffer_capacity_ - (read_bytes + unread_bytes);
+
+  if (static_cast<int32>(bytes_to_write) > free_tail_bytes) {
+    memmove(input_buffer_.get(), next_in_, avail_in_);
+    next_in_ = input_buffer_.get();
+  }
+  memcpy(next_in_ + avail_in_, data.data(), bytes_to_write);
+  avail_in_ += bytes_to_write;
+}
+
+absl::Status ZstdOutputBuffer::Deflate(ZSTD_EndDirective end_directive) {
+  if (end_directive == ZSTD_e_continue && avail_in_ == 0) {
+    return absl::OkStatus();
+  }
+
+  ZSTD_inBuffer input = {next_in_, avail_in_, 0};
+  while (true) {
+    ZSTD_outBuffer output = {next_out_, avail_out_, 0};
+    const size_t remaining =
+        ZSTD_compressStream2(context_, &output, &input, end_directive);
+    if (ZSTD_isError(remaining)) {
+      return errors::DataLoss("ZSTD_compressStream2 failed: ",
+                              ZSTD_getErrorName(remaining));
+    }
+    next_out_ += output.pos;
+    avail_out_ -= output.pos;
+    if (avail_out_ == 0) {
+      TF_RETURN_IF_ERROR(FlushOutputBufferToFile());
+    }
+    const bool input_consumed = input.pos == input.size;
+    // For ZSTD_e_flush and ZSTD_e_end `remaining` is the number of bytes
+    // still held inside the compressor; keep going until it reports zero.
+    if (end_directive == ZSTD_e_continue ? input_consumed
+                                         : input_consumed && remaining == 0) {
+      break;
+    }
+  }
+
+  next_in_ = input_buffer_.get();
+  avail_in_ = 0;
+
+  return absl::OkStatus();
+}
+
+absl::Status ZstdOutputBuffer::FlushOutputBufferToFile() {
+  size_t bytes_to_write = output_buffer_capacity_ - avail_out_;
+  if (bytes_to_write > 0) {
+    absl::Status s = file_->Append(StringPiece(
+        reinterpret_cast<char*>(output_buffer_.get()), bytes_to_write));
+    if (s.ok()) {
+      next_out_ = output_buffer_.get();
+      avail_out_ = output_buffer_capacity_;
+    }
+    return s;
+  }
+  return absl::OkStatus();
+}
+
+}  // namespace io
+}  // namespace tsl
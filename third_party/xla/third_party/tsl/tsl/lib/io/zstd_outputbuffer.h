@@ -0,0 +1,149 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+
+#ifndef TENSORFLOW_TSL_LIB_IO_ZSTD_OUTPUTBUFFER_H_
+#define TENSORFLOW_TSL_LIB_IO_ZSTD_OUTPUTBUFFER_H_
+
+#include <zstd.h>
+
+#include <memory>
+
+#include "tsl/lib/io/zstd_compression_options.h"
+#include "tsl/platform/env.h"
+#include "tsl/platform/file_system.h"
+#include "tsl/platform/macros.h"
+#include "tsl/platform/status.h"
+#include "tsl/platform/stringpiece.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+namespace io {
+
+// Compresses input data using zstd (https://facebook.github.io/zstd/) and
+// writes to `file`.
+//
+// The input data is cached in a buffer of size `input_buffer_bytes`. When the
+// buffer does not have enough available space to fit new data (in the call to
+// `Append`), the contents of the buffer are compressed and sent to the output
+// buffer.
+//
+// The compressed output is buffered in a buffer of size `output_buffer_bytes`
+// which gets flushed to file when full.
+//
+// The output is a standard zstd frame and can be decompressed with any zstd
+// implementation (or read back with ZstdInputStream). `Flush()` ends the
+// current compression block so that everything appended so far is decodable,
+// without ending the frame.
+//
+// A given instance of a ZstdOutputBuffer is NOT safe for concurrent use
+// by multiple threads.
+class ZstdOutputBuffer : public WritableFile {
+ public:
+  // Create a ZstdOutputBuffer for `file` with two buffers that cache the
+  // 1. input data to be compressed
+  // 2. the compressed output
+  // with sizes `input_buffer_bytes` and `output_buffer_bytes` respectively.
+  // Does not take ownership of `file`.
+  ZstdOutputBuffer(WritableFile* file, int32_t input_buffer_bytes,
+                   int32_t output_buffer_bytes,
+                   const ZstdCompressionOptions& zstd_options);
+
+  // Per convention, the dtor does not call Flush() or Close(). We expect the
+  // caller to call those manually when done.
+  ~ZstdOutputBuffer() override;
+
+  // Adds `data` to the compression pipeline.
+  //
+  // The input data is buffered internally and will be written to disk at a
+  // later time. To immediately write contents to file call `Flush()`.
+  absl::Status Append(StringPiece data) override;
+
+#if defined(TF_CORD_SUPPORT)
+  absl::Status Append(const absl::Cord& cord) override;
+#endif
+
+  // Compresses any buffered input, ends the zstd frame and writes all output
+  // to file. This must be called before the destructor to avoid any data
+  // loss.
+  //
+  // Contrary to `Flush()` this informs zstd that it should not expect any
+  // further input.
+  //
+  // After calling this, any further calls to `Append()`, `Flush()` or
+  // `Close()` will fail.
+  absl::Status Close() override;
+
+  // Returns the name of the underlying file.
+  absl::Status Name(StringPiece* result) const override;
+
+  // Compresses any cached input, writes all output to file and syncs it.
+  absl::Status Sync() override;
+
+  // Returns the write position in the underlying file. The position does not
+  // reflect buffered, un-flushed data.
+  absl::Status Tell(int64_t* position) override;
+
+  // Compresses any cached input and writes all output to file. Everything
+  // appended so far becomes decodable by a reader, but the zstd frame is left
+  // open for further input.
+  absl::Status Flush() override;
+
+ private:
+  // Appends `data` to `input_buffer_`.
+  // Throws if `data.size()` > AvailableInputSpace().
+  void AddToInputBuffer(StringPiece data);
+
+  // Returns the total space available in `input_buffer_`.
+  int32 AvailableInputSpace() const;
+
+  // Compresses the `avail_in_` bytes at `next_in_` with the given end
+  // directive and stores the results in `output_buffer_`. The contents of
+  // `output_buffer_` are written to file whenever it fills up.
+  //
+  // With ZSTD_e_flush (or ZSTD_e_end) all pending internal state of the
+  // compressor is (additionally) flushed to `output_buffer_`.
+  //
+  // Note: This method does not flush contents to file.
+  // Returns non-ok status if writing contents to file fails.
+  absl::Status Deflate(ZSTD_EndDirective end_directive);
+
+  // Appends contents of `output_buffer_` to `file_`.
+  // Returns non-OK status if writing to file fails.
+  absl::Status FlushOutputBufferToFile();
+
+  WritableFile* file_;  // Not owned
+
+  // Buffer for storing not yet compressed input data.
+  std::unique_ptr<char[]> input_buffer_;
+  size_t input_buffer_capacity_;
+  char* next_in_;
+  size_t avail_in_ = 0;
+
+  // Buffer for storing compressed output before it is written to `file_`.
+  std::unique_ptr<char[]> output_buffer_;
+  size_t output_buffer_capacity_;
+  char* next_out_;
+  size_t avail_out_;
+
+  ZSTD_CCtx* context_;
+
+  ZstdOutputBuffer(const ZstdOutputBuffer&) = delete;
+  void operator=(const ZstdOutputBuffer&) = delete;
+};
+
+}  // namespace io
+}  // namespace tsl
+
+#endif  // TENSORFLOW_TSL_LIB_IO_ZSTD_OUTPUTBUFFER_H_
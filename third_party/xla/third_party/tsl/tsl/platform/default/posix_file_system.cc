@@ -18,10 +18,19 @@ limitations under the License.
 #include <fcntl.h>
 #include <stdint.h>
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
 #include <sys/mman.h>
 
 #if defined(__linux__)
 #include <sys/sendfile.h>
+#include <sys/syscall.h>
+#include <sys/uio.h>
+#if __has_include(<linux/io_uring.h>) && defined(__NR_io_uring_setup) && \
+    defined(__NR_io_uring_enter)
+#include <linux/io_uring.h>
+#define TSL_POSIX_IO_URING 1
+#endif
 #endif
 #include <sys/stat.h>
 #include <sys/time.h>
@@ -29,11 +38,14 @@ limitations under the License.
 #include <time.h>
 #include <unistd.h>
 
+#include <algorithm>
+
 #include "tsl/platform/default/posix_file_system.h"
 #include "tsl/platform/env.h"
 #include "tsl/platform/errors.h"
 #include "tsl/platform/file_system_helper.h"
 #include "tsl/platform/logging.h"
+#include "tsl/platform/mutex.h"
 #include "tsl/platform/status.h"
 #include "tsl/platform/strcat.h"
 #include "tsl/protobuf/error_codes.pb.h"
@@ -45,6 +57,319 @@ using ::tsl::errors::IOError;
 // 128KB of copy buffer
 constexpr size_t kPosixCopyFileBufferSize = 128 * 1024;
 
+// Reads up to `n` bytes from `fd` starting at `offset` with pread(),
+// retrying interrupted and short reads.  Shared by the synchronous Read()
+// path and the io_uring fallback paths.
+absl::Status PReadFully(int fd, const string& filename, uint64 offset,
+                        size_t n, StringPiece* result, char* scratch) {
+  absl::Status s;
+  char* dst = scratch;
+  while (n > 0 && s.ok()) {
+    // Some platforms, notably macs, throw EINVAL if pread is asked to read
+    // more than fits in a 32-bit integer.
+    size_t requested_read_length;
+    if (n > INT32_MAX) {
+      requested_read_length = INT32_MAX;
+    } else {
+      requested_read_length = n;
+    }
+    ssize_t r =
+        pread(fd, dst, requested_read_length, static_cast<off_t>(offset));
+    if (r > 0) {
+      dst += r;
+      n -= r;
+      offset += r;
+    } else if (r == 0) {
+      s = absl::Status(absl::StatusCode::kOutOfRange,
+                       "Read less bytes than requested");
+    } else if (errno == EINTR || errno == EAGAIN) {
+      // Retry
+    } else {
+      s = IOError(filename, errno);
+    }
+  }
+  *result = StringPiece(scratch, dst - scratch);
+  return s;
+}
+
+#if defined(TSL_POSIX_IO_URING)
+
+// Number of submission queue entries in the shared io_uring instance.  The
+// kernel sizes the completion queue at twice this, and that in turn bounds
+// the number of reads in flight.
+constexpr unsigned kIoUringQueueDepth = 64;
+
+// A process-wide io_uring instance that queues reads in the kernel.  Reads
+// submitted here overlap each other without a blocked thread per request,
+// which is what lets a few threads keep a modern NVMe device at full queue
+// depth.  A single background thread reaps completions and runs callbacks.
+//
+// The ring is created lazily on first use.  If the kernel does not support
+// io_uring (pre-5.1, or filtered by seccomp), or it is disabled via the
+// TF_DISABLE_IO_URING environment variable, Instance() returns null and
+// callers fall back to synchronous pread().
+class IoUringQueue {
+ public:
+  static IoUringQueue* Instance() {
+    static IoUringQueue* instance = []() -> IoUringQueue* {
+      const char* disabled = getenv("TF_DISABLE_IO_URING");
+      if (disabled != nullptr && strcmp(disabled, "0") != 0) {
+        return nullptr;
+      }
+      // Never freed: reads may be in flight for the life of the process.
+      IoUringQueue* queue = new IoUringQueue();
+      if (!queue->Init(kIoUringQueueDepth)) {
+        delete queue;
+        return nullptr;
+      }
+      queue->completion_thread_.reset(Env::Default()->StartThread(
+          ThreadOptions(), "io_uring_completion",
+          [queue]() { queue->ReapCompletions(); }));
+      return queue;
+    }();
+    return instance;
+  }
+
+  // Reads `n` bytes at `offset` from `fd` into `scratch`, invoking `done`
+  // once the read completes, with the same result contract as
+  // RandomAccessFile::Read().  Completes the read with blocking pread()
+  // calls if the ring is at capacity.
+  void SubmitRead(int fd, const string& filename, uint64 offset, size_t n,
+                  char* scratch,
+                  std::function<void(absl::Status, StringPiece)> done) {
+    PendingRead* read = new PendingRead;
+    read->fd = fd;
+    read->filename = filename;
+    read->offset = offset;
+    read->dst = scratch;
+    read->remaining = n;
+    read->scratch = scratch;
+    read->total = n;
+    read->done = std::move(done);
+    if (!Enqueue(read)) {
+      FinishSynchronously(read);
+    }
+  }
+
+ private:
+  struct PendingRead {
+    int fd;
+    string filename;
+    uint64 offset;     // file offset of the next submission
+    char* dst;         // destination of the next submission
+    size_t remaining;  // bytes still to be read
+    char* scratch;     // start of the caller's buffer
+    size_t total;      // bytes requested by the caller
+    struct iovec iov;  // must stay live while a submission is in flight
+    std::function<void(absl::Status, StringPiece)> done;
+  };
+
+  IoUringQueue() = default;
+
+  ~IoUringQueue() {
+    if (sqes_ != nullptr) munmap(sqes_, sqes_size_);
+    if (cq_ring_ != nullptr && cq_ring_ != sq_ring_) {
+      munmap(cq_ring_, cq_ring_size_);
+    }
+    if (sq_ring_ != nullptr) munmap(sq_ring_, sq_ring_size_);
+    if (ring_fd_ >= 0) close(ring_fd_);
+  }
+
+  // Sets up the ring and maps its queues, following io_uring_setup(2).
+  bool Init(unsigned entries) {
+    io_uring_params params;
+    memset(&params, 0, sizeof(params));
+    ring_fd_ = syscall(__NR_io_uring_setup, entries, &params);
+    if (ring_fd_ < 0) {
+      return false;
+    }
+    sq_entries_ = params.sq_entries;
+    cq_entries_ = params.cq_entries;
+    sq_ring_size_ = params.sq_off.array + params.sq_entries * sizeof(__u32);
+    cq_ring_size_ =
+        params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+#if defined(IORING_FEAT_SINGLE_MMAP)
+    const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+#else
+    const bool single_mmap = false;
+#endif
+    if (single_mmap) {
+      sq_ring_size_ = cq_ring_size_ = std::max(sq_ring_size_, cq_ring_size_);
+    }
+    sq_ring_ = mmap(nullptr, sq_ring_size_, PROT_READ | PROT_WRITE,
+                    MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_SQ_RING);
+    if (sq_ring_ == MAP_FAILED) {
+      sq_ring_ = nullptr;
+      return false;
+    }
+    if (single_mmap) {
+      cq_ring_ = sq_ring_;
+    } else {
+      cq_ring_ = mmap(nullptr, cq_ring_size_, PROT_READ | PROT_WRITE,
+                      MAP_SHARED | MAP_POPULATE, ring_fd_, IORING_OFF_CQ_RING);
+      if (cq_ring_ == MAP_FAILED) {
+        cq_ring_ = nullptr;
+        return false;
+      }
+    }
+    sqes_size_ = params.sq_entries * sizeof(io_uring_sqe);
+    sqes_ = static_cast<io_uring_sqe*>(mmap(nullptr, sqes_size_,
+                                            PROT_READ | PROT_WRITE,
+                                            MAP_SHARED | MAP_POPULATE,
+                                            ring_fd_, IORING_OFF_SQES));
+    if (sqes_ == MAP_FAILED) {
+      sqes_ = nullptr;
+      return false;
+    }
+    char* sq = static_cast<char*>(sq_ring_);
+    sq_head_ = reinterpret_cast<unsigned*>(sq + params.sq_off.head);
+    sq_tail_ = reinterpret_cast<unsigned*>(sq + params.sq_off.tail);
+    sq_mask_ = reinterpret_cast<unsigned*>(sq + params.sq_off.ring_mask);
+    sq_array_ = reinterpret_cast<unsigned*>(sq + params.sq_off.array);
+    char* cq = static_cast<char*>(cq_ring_);
+    cq_head_ = reinterpret_cast<unsigned*>(cq + params.cq_off.head);
+    cq_tail_ = reinterpret_cast<unsigned*>(cq + params.cq_off.tail);
+    cq_mask_ = reinterpret_cast<unsigned*>(cq + params.cq_off.ring_mask);
+    cqes_ = reinterpret_cast<io_uring_cqe*>(cq + params.cq_off.cqes);
+    return true;
+  }
+
+  // Queues one READV submission for the next unread range of `read`.
+  // Returns false without submitting if the ring is at capacity.
+  bool Enqueue(PendingRead* read) {
+    mutex_lock lock(submit_mu_);
+    if (in_flight_ >= cq_entries_) {
+      return false;
+    }
+    const unsigned head = __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+    const unsigned tail = *sq_tail_;  // sole writer, under submit_mu_
+    if (tail - head >= sq_entries_) {
+      return false;
+    }
+    const unsigned index = tail & *sq_mask_;
+    io_uring_sqe* sqe = &sqes_[index];
+    memset(sqe, 0, sizeof(*sqe));
+    read->iov.iov_base = read->dst;
+    read->iov.iov_len = std::min<size_t>(read->remaining, INT32_MAX);
+    sqe->opcode = IORING_OP_READV;
+    sqe->fd = read->fd;
+    sqe->off = read->offset;
+    sqe->addr = reinterpret_cast<uintptr_t>(&read->iov);
+    sqe->len = 1;
+    sqe->user_data = reinterpret_cast<uintptr_t>(read);
+    sq_array_[index] = index;
+    // Publish the new tail; pairs with the kernel's acquire load.
+    __atomic_store_n(sq_tail_, tail + 1, __ATOMIC_RELEASE);
+    ++in_flight_;
+    // Submit every entry the kernel has not consumed yet, so that entries
+    // left behind by a previously failed submission are flushed too.
+    long ret;  // NOLINT(runtime/int): syscall interface.
+    do {
+      const unsigned to_submit =
+          tail + 1 - __atomic_load_n(sq_head_, __ATOMIC_ACQUIRE);
+      ret = syscall(__NR_io_uring_enter, ring_fd_, to_submit, 0, 0, nullptr,
+                    0);
+    } while (ret < 0 && errno == EINTR);
+    // On any other failure the entry stays queued and is submitted by the
+    // next call; completions are bounded by in_flight_, so this does not
+    // overflow the completion queue.
+    return true;
+  }
+
+  // Runs when a request cannot be (re)queued: completes whatever is left of
+  // `read` with blocking pread() calls and invokes the callback.
+  void FinishSynchronously(PendingRead* read) {
+    StringPiece tail_result;
+    absl::Status status = PReadFully(read->fd, read->filename, read->offset,
+                                     read->remaining, &tail_result, read->dst);
+    const size_t read_bytes =
+        (read->dst - read->scratch) + tail_result.size();
+    read->done(status, StringPiece(read->scratch, read_bytes));
+    delete read;
+  }
+
+  // Applies one completion result.  Short reads are resubmitted for the
+  // remainder, matching the retry loop in PReadFully().
+  void HandleCompletion(PendingRead* read, int result) {
+    {
+      mutex_lock lock(submit_mu_);
+      --in_flight_;
+    }
+    if (result < 0) {
+      if (-result == EINTR || -result == EAGAIN) {
+        if (!Enqueue(read)) FinishSynchronously(read);
+        return;
+      }
+      read->done(IOError(read->filename, -result),
+                 StringPiece(read->scratch, read->dst - read->scratch));
+      delete read;
+      return;
+    }
+    if (result == 0) {
+      read->done(absl::Status(absl::StatusCode::kOutOfRange,
+                              "Read less bytes than requested"),
+                 StringPiece(read->scratch, read->dst - read->scratch));
+      delete read;
+      return;
+    }
+    read->dst += result;
+    read->offset += result;
+    read->remaining -= result;
+    if (read->remaining > 0) {
+      if (!Enqueue(read)) FinishSynchronously(read);
+      return;
+    }
+    read->done(absl::OkStatus(), StringPiece(read->scratch, read->total));
+    delete read;
+  }
+
+  // Completion loop run by completion_thread_.
+  void ReapCompletions() {
+    while (true) {
+      unsigned head = *cq_head_;  // this thread is the only consumer
+      const unsigned tail = __atomic_load_n(cq_tail_, __ATOMIC_ACQUIRE);
+      if (head == tail) {
+        // Interrupted or woken up; either way, re-check the queue.
+        syscall(__NR_io_uring_enter, ring_fd_, 0, 1, IORING_ENTER_GETEVENTS,
+                nullptr, 0);
+        continue;
+      }
+      while (head != tail) {
+        const io_uring_cqe* cqe = &cqes_[head & *cq_mask_];
+        PendingRead* read = reinterpret_cast<PendingRead*>(
+            static_cast<uintptr_t>(cqe->user_data));
+        const int result = cqe->res;
+        ++head;
+        __atomic_store_n(cq_head_, head, __ATOMIC_RELEASE);
+        HandleCompletion(read, result);
+      }
+    }
+  }
+
+  int ring_fd_ = -1;
+  unsigned sq_entries_ = 0;
+  unsigned cq_entries_ = 0;
+  void* sq_ring_ = nullptr;
+  void* cq_ring_ = nullptr;
+  size_t sq_ring_size_ = 0;
+  size_t cq_ring_size_ = 0;
+  io_uring_sqe* sqes_ = nullptr;
+  size_t sqes_size_ = 0;
+  unsigned* sq_head_ = nullptr;
+  unsigned* sq_tail_ = nullptr;
+  unsigned* sq_mask_ = nullptr;
+  unsigned* sq_array_ = nullptr;
+  unsigned* cq_head_ = nullptr;
+  unsigned* cq_tail_ = nullptr;
+  unsigned* cq_mask_ = nullptr;
+  io_uring_cqe* cqes_ = nullptr;
+  mutex submit_mu_;
+  unsigned in_flight_ TF_GUARDED_BY(submit_mu_) = 0;
+  std::unique_ptr<Thread> completion_thread_;
+};
+
+#endif  // defined(TSL_POSIX_IO_URING)
+
 // pread() based random-access
 class PosixRandomAccessFile : public RandomAccessFile {
  private:
@@ -67,34 +392,28 @@ class PosixRandomAccessFile : public RandomAccessFile {
 
   absl::Status Read(uint64 offset, size_t n, StringPiece* result,
                     char* scratch) const override {
-    absl::Status s;
-    char* dst = scratch;
-    while (n > 0 && s.ok()) {
-      // Some platforms, notably macs, throw EINVAL if pread is asked to read
-      // more than fits in a 32-bit integer.
-      size_t requested_read_length;
-      if (n > INT32_MAX) {
-        requested_read_length = INT32_MAX;
-      } else {
-        requested_read_length = n;
-      }
-      ssize_t r =
-          pread(fd_, dst, requested_read_length, static_cast<off_t>(offset));
-      if (r > 0) {
-        dst += r;
-        n -= r;
-        offset += r;
-      } else if (r == 0) {
-        s = absl::Status(absl::StatusCode::kOutOfRange,
-                         "Read less bytes than requested");
-      } else if (errno == EINTR || errno == EAGAIN) {
-        // Retry
-      } else {
-        s = IOError(filename_, errno);
-      }
+    return PReadFully(fd_, filename_, offset, n, result, scratch);
+  }
+
+  bool SupportsAsyncRead() const override {
+#if defined(TSL_POSIX_IO_URING)
+    return IoUringQueue::Instance() != nullptr;
+#else
+    return false;
+#endif
+  }
+
+  void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(absl::Status, StringPiece)> done) const override {
+#if defined(TSL_POSIX_IO_URING)
+    IoUringQueue* queue = IoUringQueue::Instance();
+    if (queue != nullptr) {
+      queue->SubmitRead(fd_, filename_, offset, n, scratch, std::move(done));
+      return;
     }
-    *result = StringPiece(scratch, dst - scratch);
-    return s;
+#endif
+    RandomAccessFile::ReadAsync(offset, n, scratch, std::move(done));
   }
 
 #if defined(TF_CORD_SUPPORT)
@@ -792,6 +792,38 @@ class RandomAccessFile {
   }
 #endif
 
+  /// \brief Returns true if reads issued through `ReadAsync` may execute in
+  /// the background and complete out of line.
+  ///
+  /// When false, `ReadAsync` degenerates to a synchronous `Read` that
+  /// invokes the callback before returning, so callers gain nothing from
+  /// issuing several requests before waiting.
+  virtual bool SupportsAsyncRead() const { return false; }
+
+  /// \brief Asynchronously reads up to `n` bytes from the file starting at
+  /// `offset`, with the same buffer and result contract as `Read`.
+  ///
+  /// Invokes `done` with the read status and result once the read
+  /// completes, possibly from an internal thread; it may also be invoked
+  /// before this call returns (and always is under the default
+  /// implementation, which simply calls `Read`).  `scratch` must stay live
+  /// until `done` is invoked.  `done` should be cheap, as a slow callback
+  /// can delay the completion of other outstanding reads.
+  ///
+  /// File systems that can queue reads in the kernel (e.g. the POSIX
+  /// implementation on top of io_uring) overlap many outstanding requests
+  /// without dedicating a blocked thread to each, so callers that need
+  /// several reads should issue them all before waiting on any.
+  ///
+  /// Safe for concurrent use by multiple threads.
+  virtual void ReadAsync(
+      uint64 offset, size_t n, char* scratch,
+      std::function<void(absl::Status, StringPiece)> done) const {
+    StringPiece result;
+    absl::Status status = Read(offset, n, &result, scratch);
+    done(status, result);
+  }
+
  private:
   RandomAccessFile(const RandomAccessFile&) = delete;
   void operator=(const RandomAccessFile&) = delete;
@@ -146,7 +146,7 @@ class CoordinationServiceStandaloneImpl : public CoordinationServiceInterface {
   uint64_t GetServiceIncarnation() override;
   void StartCheckStaleness();  // Checks both heartbeat and barrier timeouts.
   void Stop(bool shut_staleness_thread = true);
-  bool ServiceHasStopped() const ABSL_EXCLUSIVE_LOCKS_REQUIRED(state_mu_);
+  bool ServiceHasStopped() const ABSL_SHARED_LOCKS_REQUIRED(state_mu_);
   // Report service error to a specified task.
   void ReportServiceErrorToTaskAsync(const CoordinatedTask& destination_task,
                                      absl::Status error);
@@ -785,7 +785,11 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
   const std::string task_name = GetTaskName(task);
   absl::Status s = absl::OkStatus();
   {
-    absl::MutexLock l(&state_mu_);
+    // Heartbeats only read the cluster state; the heartbeat timestamp itself
+    // is guarded by a per-task mutex. Acquiring the state lock in shared mode
+    // lets the service record heartbeats from many tasks concurrently instead
+    // of serializing the whole cluster's fan-in on one lock.
+    absl::ReaderMutexLock l(&state_mu_);
     if (ServiceHasStopped()) {
       return MakeCoordinationError(absl::InternalError(absl::StrCat(
           "Coordination service has stopped. RecordHeartbeat() from task: ",
@@ -794,26 +798,28 @@ absl::Status CoordinationServiceStandaloneImpl::RecordHeartbeat(
           "coordination service to shut down before the workers disconnect "
           "gracefully. Check the task leader's logs for an earlier error to "
           "debug the root cause.")));
-    } else if (!cluster_state_.contains(task_name)) {
+    }
+    const auto task_state_it = cluster_state_.find(task_name);
+    if (task_state_it == cluster_state_.end()) {
       return MakeCoordinationError(absl::InvalidArgumentError(
           absl::StrCat("Unexpected heartbeat request from task: ", task_name,
                        ". This usually implies a configuration error.")));
     }
-    if (!cluster_state_[task_name]->GetStatus().ok()) {
-      return cluster_state_[task_name]->GetStatus();
-    } else if (cluster_state_[task_name]->GetState() ==
+    TaskState* task_state = task_state_it->second.get();
+    if (!task_state->GetStatus().ok()) {
+      return task_state->GetStatus();
+    } else if (task_state->GetState() ==
                    CoordinatedTaskState::TASKSTATE_DISCONNECTED &&
                // We accept heartbeats for a short grace period to account for
                // the lag time between the service recording the state change
                // and the agent stopping heartbeats.
                Env::Default()->NowMicros() >
-                   cluster_state_[task_name]
-                       ->GetDisconnectedGracePeriodMicros()) {
+                   task_state->GetDisconnectedGracePeriodMicros()) {
       return MakeCoordinationError(absl::InvalidArgumentError(absl::StrCat(
           "Task with task_name=", task_name,
           " must be registered before sending heartbeat messages")));
     }
-    s = cluster_state_[task_name]->RecordHeartbeat(incarnation);
+    s = task_state->RecordHeartbeat(incarnation);
   }
 
   // Set and propagate any heartbeat errors.
@@ -1318,11 +1324,23 @@ void CoordinationServiceStandaloneImpl::PassBarrier(std::string_view barrier_id,
   ongoing_barriers_.erase(barrier_id);
   // Note: barrier_id shouldn't be referenced after this line as its lifetime
   // may be tied to one of the callbacks.
-  // Propagate results to participating tasks.
-  for (const auto& callback : barrier->done_callbacks) {
-    callback(result);
-  }
+  // Propagate results to participating tasks from a scheduled closure. The
+  // fan-out is O(cluster size) and every caller of PassBarrier() holds the
+  // state lock, so invoking the callbacks inline would stall heartbeats and
+  // other barriers behind a single barrier's completion on large clusters.
+  // The callbacks only complete pending RPCs and do not touch service state,
+  // so they are safe to run without the lock.
+  std::vector<StatusCallback> done_callbacks =
+      std::move(barrier->done_callbacks);
   barrier->done_callbacks.clear();
+  if (!done_callbacks.empty()) {
+    env_.SchedClosure(
+        [done_callbacks = std::move(done_callbacks), result]() {
+          for (const auto& callback : done_callbacks) {
+            callback(result);
+          }
+        });
+  }
 }
 
 bool CoordinationServiceStandaloneImpl::ValidateTaskArgs(
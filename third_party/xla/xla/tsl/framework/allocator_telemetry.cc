@@ -0,0 +1,129 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/tsl/framework/allocator_telemetry.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "tsl/lib/core/bits.h"
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/strcat.h"
+
+namespace tsl {
+namespace {
+
+std::atomic<int> num_listeners{0};
+
+mutex& ListenersMutex() {
+  static mutex* mu = new mutex;
+  return *mu;
+}
+
+std::vector<AllocatorEventListener*>& Listeners() {
+  static auto* listeners = new std::vector<AllocatorEventListener*>;
+  return *listeners;
+}
+
+}  // namespace
+
+void RegisterAllocatorEventListener(AllocatorEventListener* listener) {
+  mutex_lock lock(ListenersMutex());
+  Listeners().push_back(listener);
+  num_listeners.fetch_add(1, std::memory_order_release);
+}
+
+void UnregisterAllocatorEventListener(AllocatorEventListener* listener) {
+  mutex_lock lock(ListenersMutex());
+  auto& listeners = Listeners();
+  auto it = std::find(listeners.begin(), listeners.end(), listener);
+  if (it != listeners.end()) {
+    listeners.erase(it);
+    num_listeners.fetch_sub(1, std::memory_order_release);
+  }
+}
+
+bool HasAllocatorEventListeners() {
+  return num_listeners.load(std::memory_order_acquire) > 0;
+}
+
+void NotifyAllocatorEvent(const AllocatorEvent& event) {
+  mutex_lock lock(ListenersMutex());
+  for (AllocatorEventListener* listener : Listeners()) {
+    listener->OnAllocatorEvent(event);
+  }
+}
+
+void FragmentationAnalyzer::OnAllocatorEvent(const AllocatorEvent& event) {
+  mutex_lock lock(mu_);
+  report_.peak_bytes_in_use =
+      std::max(report_.peak_bytes_in_use, event.bytes_in_use);
+  report_.peak_fragmentation =
+      std::max(report_.peak_fragmentation, event.fragmentation);
+  if (event.fragmentation > threshold_) {
+    ++report_.high_fragmentation_events;
+  }
+  if (event.kind != AllocatorEvent::Kind::kAllocation ||
+      event.allocation_bytes <= 0) {
+    return;
+  }
+  const int size_class = std::min<int>(
+      Log2Floor64(event.allocation_bytes),
+      static_cast<int>(report_.size_classes.size()) - 1);
+  SizeClassStats& stats = report_.size_classes[size_class];
+  ++stats.allocations;
+  if (event.fragmentation > threshold_) {
+    ++stats.high_fragmentation_allocations;
+  }
+}
+
+FragmentationAnalyzer::Report FragmentationAnalyzer::GetReport() const {
+  mutex_lock lock(mu_);
+  return report_;
+}
+
+std::string FragmentationAnalyzer::DebugString() const {
+  const Report report = GetReport();
+  std::string result = strings::StrCat(
+      "FragmentationAnalyzer: peak_bytes_in_use=", report.peak_bytes_in_use,
+      " peak_fragmentation=", report.peak_fragmentation,
+      " high_fragmentation_events=", report.high_fragmentation_events, "\n");
+
+  // Sort size classes by their count of high-fragmentation allocations.
+  std::vector<int> size_class_indices;
+  for (int i = 0; i < report.size_classes.size(); ++i) {
+    if (report.size_classes[i].allocations > 0) {
+      size_class_indices.push_back(i);
+    }
+  }
+  std::sort(size_class_indices.begin(), size_class_indices.end(),
+            [&report](int a, int b) {
+              return report.size_classes[a].high_fragmentation_allocations >
+                     report.size_classes[b].high_fragmentation_allocations;
+            });
+  for (const int i : size_class_indices) {
+    const SizeClassStats& stats = report.size_classes[i];
+    strings::StrAppend(&result, "  size_class=[", 1LL << i, ", ",
+                       (1LL << (i + 1)) - 1,
+                       "] allocations=", stats.allocations,
+                       " high_fragmentation_allocations=",
+                       stats.high_fragmentation_allocations, "\n");
+  }
+  return result;
+}
+
+}  // namespace tsl
@@ -0,0 +1,120 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#ifndef XLA_TSL_FRAMEWORK_ALLOCATOR_TELEMETRY_H_
+#define XLA_TSL_FRAMEWORK_ALLOCATOR_TELEMETRY_H_
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <string>
+
+#include "tsl/platform/mutex.h"
+#include "tsl/platform/thread_annotations.h"
+#include "tsl/platform/types.h"
+
+namespace tsl {
+
+// One allocator event. AllocatorStats only exposes point-in-time aggregates;
+// this stream carries every allocation and deallocation together with the
+// allocator state at that moment, so long-running fragmentation problems can
+// be analyzed online instead of from occasional snapshots.
+struct AllocatorEvent {
+  enum class Kind { kAllocation, kDeallocation };
+
+  Kind kind = Kind::kAllocation;
+  // Name of the emitting allocator (e.g. "GPU_0_bfc").
+  std::string allocator_name;
+  // Bytes the client asked for and bytes the chunk actually occupies.
+  int64_t requested_bytes = 0;
+  int64_t allocation_bytes = 0;
+  // Allocator state after applying the event.
+  int64_t bytes_in_use = 0;
+  int64_t peak_bytes_in_use = 0;
+  // External fragmentation in [0, 1]: fraction of free memory that is not in
+  // the largest free chunk.
+  double fragmentation = 0.0;
+};
+
+// Observer of allocator events. Callbacks run synchronously on the
+// allocating thread while the allocator lock is held: implementations must
+// be fast, must not allocate from the observed allocator, and must not call
+// back into it.
+class AllocatorEventListener {
+ public:
+  virtual ~AllocatorEventListener() = default;
+
+  virtual void OnAllocatorEvent(const AllocatorEvent& event) = 0;
+};
+
+// Registers/unregisters a listener for the events of all allocators that
+// emit telemetry. Thread-safe. The caller keeps ownership and must
+// unregister before destroying the listener.
+void RegisterAllocatorEventListener(AllocatorEventListener* listener);
+void UnregisterAllocatorEventListener(AllocatorEventListener* listener);
+
+// True if any listener is registered. Allocators use this as a cheap guard
+// so that the telemetry path costs one relaxed atomic load when unused.
+bool HasAllocatorEventListeners();
+
+// Dispatches the event to all registered listeners.
+void NotifyAllocatorEvent(const AllocatorEvent& event);
+
+// Online analyzer for the event stream. It maintains, per power-of-two size
+// class, how often allocations of that class were made while the allocator
+// was already badly fragmented, plus overall high-water marks. The size
+// classes that dominate the high-fragmentation counts identify the
+// allocation patterns responsible for intermittent memory blowups on
+// long-lived processes.
+class FragmentationAnalyzer : public AllocatorEventListener {
+ public:
+  // Allocations observed while fragmentation exceeds `threshold` are counted
+  // as high-fragmentation allocations.
+  explicit FragmentationAnalyzer(double threshold = 0.5)
+      : threshold_(threshold) {}
+
+  void OnAllocatorEvent(const AllocatorEvent& event) override;
+
+  struct SizeClassStats {
+    // Total allocations in this size class.
+    int64_t allocations = 0;
+    // Allocations made while fragmentation exceeded the threshold.
+    int64_t high_fragmentation_allocations = 0;
+  };
+
+  struct Report {
+    int64_t peak_bytes_in_use = 0;
+    double peak_fragmentation = 0.0;
+    // Events with fragmentation above the threshold.
+    int64_t high_fragmentation_events = 0;
+    // Indexed by floor(log2(allocation_bytes)), clamped to the last entry.
+    std::array<SizeClassStats, 48> size_classes;
+  };
+
+  Report GetReport() const;
+
+  // Human-readable summary of GetReport(), listing the size classes with the
+  // highest share of high-fragmentation allocations first.
+  std::string DebugString() const;
+
+ private:
+  const double threshold_;
+
+  mutable mutex mu_;
+  Report report_ TF_GUARDED_BY(mu_);
+};
+
+}  // namespace tsl
+
+#endif  // XLA_TSL_FRAMEWORK_ALLOCATOR_TELEMETRY_H_
@@ -0,0 +1,125 @@
+/* Copyright 2024 The TensorFlow Authors. All Rights Reserved.
+
+Licensed under the Apache License, Version 2.0 (the "License");
+you may not use this file except in compliance with the License.
+You may obtain a copy of the License at
+
+    http://www.apache.org/licenses/LICENSE-2.0
+
+Unless required by applicable law or agreed to in writing, software
+distributed under the License is distributed on an "AS IS" BASIS,
+WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+See the License for the specific language governing permissions and
+limitations under the License.
+==============================================================================*/
+#include "xla/tsl/framework/allocator_telemetry.h"
+
+#include <string>
+#include <vector>
+
+#include "tsl/platform/test.h"
+
+namespace tsl {
+namespace {
+
+AllocatorEvent MakeEvent(AllocatorEvent::Kind kind, int64_t allocation_bytes,
+                         double fragmentation, int64_t bytes_in_use = 0) {
+  AllocatorEvent event;
+  event.kind = kind;
+  event.allocator_name = "test_bfc";
+  event.requested_bytes = allocation_bytes;
+  event.allocation_bytes = allocation_bytes;
+  event.bytes_in_use = bytes_in_use;
+  event.peak_bytes_in_use = bytes_in_use;
+  event.fragmentation = fragmentation;
+  return event;
+}
+
+class RecordingListener : public AllocatorEventListener {
+ public:
+  void OnAllocatorEvent(const AllocatorEvent& event) override {
+    events.push_back(event);
+  }
+
+  std::vector<AllocatorEvent> events;
+};
+
+TEST(AllocatorTelemetryTest, NoListenersByDefault) {
+  EXPECT_FALSE(HasAllocatorEventListeners());
+  // Dispatch with no listeners is a no-op.
+  NotifyAllocatorEvent(MakeEvent(AllocatorEvent::Kind::kAllocation, 256, 0.0));
+}
+
+TEST(AllocatorTelemetryTest, RegisteredListenerReceivesEvents) {
+  RecordingListener listener;
+  RegisterAllocatorEventListener(&listener);
+  EXPECT_TRUE(HasAllocatorEventListeners());
+
+  NotifyAllocatorEvent(MakeEvent(AllocatorEvent::Kind::kAllocation, 1024, 0.1));
+  NotifyAllocatorEvent(
+      MakeEvent(AllocatorEvent::Kind::kDeallocation, 1024, 0.1));
+
+  UnregisterAllocatorEventListener(&listener);
+  EXPECT_FALSE(HasAllocatorEventListeners());
+  NotifyAllocatorEvent(MakeEvent(AllocatorEvent::Kind::kAllocation, 2048, 0.2));
+
+  ASSERT_EQ(listener.events.size(), 2);
+  EXPECT_EQ(listener.events[0].kind, AllocatorEvent::Kind::kAllocation);
+  EXPECT_EQ(listener.events[0].allocation_bytes, 1024);
+  EXPECT_EQ(listener.events[1].kind, AllocatorEvent::Kind::kDeallocation);
+}
+
+TEST(AllocatorTelemetryTest, FragmentationAnalyzerTracksPeaks) {
+  FragmentationAnalyzer analyzer(/*threshold=*/0.5);
+  analyzer.OnAllocatorEvent(MakeEvent(AllocatorEvent::Kind::kAllocation, 1024,
+                                      /*fragmentation=*/0.2,
+                                      /*bytes_in_use=*/1 << 20));
+  analyzer.OnAllocatorEvent(MakeEvent(AllocatorEvent::Kind::kDeallocation, 1024,
+                                      /*fragmentation=*/0.7,
+                                      /*bytes_in_use=*/1 << 19));
+
+  const auto report = analyzer.GetReport();
+  EXPECT_EQ(report.peak_bytes_in_use, 1 << 20);
+  EXPECT_EQ(report.peak_fragmentation, 0.7);
+  EXPECT_EQ(report.high_fragmentation_events, 1);
+}
+
+TEST(AllocatorTelemetryTest, FragmentationAnalyzerCountsSizeClasses) {
+  FragmentationAnalyzer analyzer(/*threshold=*/0.5);
+  // Two allocations of 1KiB (size class 10), one under fragmentation.
+  analyzer.OnAllocatorEvent(
+      MakeEvent(AllocatorEvent::Kind::kAllocation, 1024, 0.2));
+  analyzer.OnAllocatorEvent(
+      MakeEvent(AllocatorEvent::Kind::kAllocation, 1100, 0.8));
+  // Deallocations do not contribute to size-class counts.
+  analyzer.OnAllocatorEvent(
+      MakeEvent(AllocatorEvent::Kind::kDeallocation, 1024, 0.8));
+
+  const auto report = analyzer.GetReport();
+  EXPECT_EQ(report.size_classes[10].allocations, 2);
+  EXPECT_EQ(report.size_classes[10].high_fragmentation_allocations, 1);
+  EXPECT_EQ(report.size_classes[11].allocations, 0);
+}
+
+TEST(AllocatorTelemetryTest, FragmentationAnalyzerClampsHugeAllocations) {
+  FragmentationAnalyzer analyzer;
+  AllocatorEvent event =
+      MakeEvent(AllocatorEvent::Kind::kAllocation, int64_t{1} << 60, 0.0);
+  analyzer.OnAllocatorEvent(event);
+
+  const auto report = analyzer.GetReport();
+  EXPECT_EQ(report.size_classes.back().allocations, 1);
+}
+
+TEST(AllocatorTelemetryTest, DebugStringListsActiveSizeClasses) {
+  FragmentationAnalyzer analyzer(/*threshold=*/0.5);
+  analyzer.OnAllocatorEvent(
+      MakeEvent(AllocatorEvent::Kind::kAllocation, 4096, 0.9));
+
+  const std::string debug = analyzer.DebugString();
+  EXPECT_NE(debug.find("high_fragmentation_events=1"), std::string::npos);
+  EXPECT_NE(debug.find("size_class=[4096, 8191]"), std::string::npos);
+}
+
+}  // namespace
+}  // namespace tsl
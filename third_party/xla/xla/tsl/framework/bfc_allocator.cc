@@ -22,6 +22,7 @@ limitations under the License.
 
 #include "absl/strings/string_view.h"
 #include "xla/tsl/framework/allocator_retry.h"
+#include "xla/tsl/framework/allocator_telemetry.h"
 #include "tsl/lib/core/bits.h"
 #include "tsl/platform/file_system.h"
 #include "tsl/platform/logging.h"
@@ -259,6 +260,17 @@ void* BFCAllocator::AllocateRawInternalWithRetry(
 void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                 const AllocationAttributes& allocation_attr) {
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes;
+  const bool use_thread_cache = opts_.small_alloc_thread_cache &&
+                                timing_counter_ == nullptr && num_bytes > 0 &&
+                                num_bytes <= kSmallAllocThreshold;
+  if (use_thread_cache) {
+    void* cached = AllocateFromThreadCache(num_bytes);
+    if (cached != nullptr) {
+      VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << cached
+              << " (thread cache)";
+      return cached;
+    }
+  }
   void* result = [&] {
     if (!opts_.allow_retry_on_failure || !allocation_attr.retry_on_failure) {
       // If we have globally disabled retry-on-failure and fail to allocate an
@@ -305,6 +317,9 @@ void* BFCAllocator::AllocateRaw(size_t unused_alignment, size_t num_bytes,
                                           allocation_attr);
     }
   }();
+  if (use_thread_cache && result != nullptr) {
+    RecordSmallAllocation(result, num_bytes);
+  }
   VLOG(3) << "AllocateRaw " << Name() << "  " << num_bytes << " " << result;
   VLOG(4) << "[mem-debug] AllocateRaw," << Name() << "," << num_bytes << ","
           << result << "," << tsl::CurrentStackTrace();
@@ -320,6 +335,122 @@ size_t BFCAllocator::RoundedBytes(size_t bytes) {
   return rounded_bytes;
 }
 
+// static
+int64_t BFCAllocator::NextThreadCacheId() {
+  static std::atomic<int64_t> next_id{1};
+  return next_id.fetch_add(1, std::memory_order_relaxed);
+}
+
+namespace {
+// Set once this thread's BFC thread caches have been destroyed.  A plain bool
+// has no destructor, so it stays valid through TLS teardown; a DeallocateRaw
+// arriving after that (e.g. from another thread-local destructor dropping a
+// tensor) must take the central path rather than re-enter the destroyed map.
+thread_local bool bfc_thread_caches_destroyed = false;
+}  // namespace
+
+BFCAllocator::ThreadCache* BFCAllocator::GetThreadCache() {
+  if (bfc_thread_caches_destroyed) {
+    return nullptr;
+  }
+  struct CacheMap {
+    std::unordered_map<int64_t, ThreadCache> caches;
+    ~CacheMap() { bfc_thread_caches_destroyed = true; }
+  };
+  static thread_local CacheMap m;
+  return &m.caches[thread_cache_id_];
+}
+
+void BFCAllocator::SyncThreadCacheEpoch(ThreadCache* cache) {
+  // A central free of a recorded pointer bumps small_cache_epoch_ before the
+  // address can be handed out again (both happen under lock_), and the new
+  // owner publishing the pointer to this thread orders the bump before the
+  // load below.  So by the time a recycled address can reach this cache, the
+  // epoch check is guaranteed to discard the stale record for it.
+  const uint64_t epoch = small_cache_epoch_.load(std::memory_order_acquire);
+  if (epoch != cache->epoch) {
+    cache->outstanding.clear();
+    cache->epoch = epoch;
+  }
+}
+
+void* BFCAllocator::AllocateFromThreadCache(size_t num_bytes) {
+  const size_t rounded_bytes = RoundedBytes(num_bytes);
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  SyncThreadCacheEpoch(cache);
+  std::vector<void*>& free_list =
+      cache->free_lists[rounded_bytes / kMinAllocationSize - 1];
+  if (free_list.empty()) {
+    return nullptr;
+  }
+  void* ptr = free_list.back();
+  free_list.pop_back();
+  cache->cached_bytes -= rounded_bytes;
+  cache->outstanding.insert_or_assign(ptr, rounded_bytes);
+  return ptr;
+}
+
+void BFCAllocator::RecordSmallAllocation(const void* ptr, size_t num_bytes) {
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr) {
+    return;
+  }
+  SyncThreadCacheEpoch(cache);
+  {
+    // Tag the chunk so that a cross-thread free of it knows to invalidate the
+    // record made below.  The caller just paid for a locked central
+    // allocation, so this extra acquisition is off the cache-hit path.
+    mutex_lock l(lock_);
+    BFCAllocator::ChunkHandle h = region_manager_.get_handle(ptr);
+    CHECK(h != kInvalidChunkHandle);
+    ChunkFromHandle(h)->thread_cache_recorded = true;
+  }
+  cache->outstanding.insert_or_assign(ptr, RoundedBytes(num_bytes));
+}
+
+bool BFCAllocator::DeallocateToThreadCache(void* ptr) {
+  ThreadCache* cache = GetThreadCache();
+  if (cache == nullptr) {
+    return false;
+  }
+  SyncThreadCacheEpoch(cache);
+  auto it = cache->outstanding.find(ptr);
+  if (it == cache->outstanding.end()) {
+    // Allocated on another thread (or before the cache saw it); the caller
+    // must go through the central path.
+    return false;
+  }
+  const size_t rounded_bytes = it->second;
+  cache->outstanding.erase(it);
+  cache->free_lists[rounded_bytes / kMinAllocationSize - 1].push_back(ptr);
+  cache->cached_bytes += rounded_bytes;
+  if (cache->cached_bytes > kThreadCacheByteBudget) {
+    SpillThreadCache(cache);
+  }
+  return true;
+}
+
+void BFCAllocator::SpillThreadCache(ThreadCache* cache) {
+  // Free the largest size classes first; each DeallocateRawInternal call
+  // takes lock_, so spilling is the one place a cached free pays for lock
+  // contention.
+  for (int i = kNumSmallSizeClasses - 1;
+       i >= 0 && cache->cached_bytes > kThreadCacheByteBudget / 2; --i) {
+    std::vector<void*>& free_list = cache->free_lists[i];
+    const size_t class_bytes = (i + 1) * kMinAllocationSize;
+    while (!free_list.empty() &&
+           cache->cached_bytes > kThreadCacheByteBudget / 2) {
+      DeallocateRawInternal(free_list.back(),
+                            /*from_thread_cache_spill=*/true);
+      free_list.pop_back();
+      cache->cached_bytes -= class_bytes;
+    }
+  }
+}
+
 bool BFCAllocator::DeallocateFreeRegions(size_t rounded_bytes)
     TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
   // Do nothing if garbage collection is off.
@@ -376,6 +507,51 @@ bool BFCAllocator::DeallocateFreeRegions(size_t rounded_bytes)
   return true;
 }
 
+bool BFCAllocator::MaybeDefragment() TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
+  // Proactive defragmentation reuses the garbage collection machinery, so it
+  // is only available when garbage collection is on.
+  if (!opts_.garbage_collection) {
+    return false;
+  }
+  int64_t bytes_available = *stats_.pool_bytes - stats_.bytes_in_use;
+  if (bytes_available <= 0 ||
+      GetFragmentation() < opts_.defragmentation_threshold) {
+    return false;
+  }
+
+  // Only wholly free regions can be released; regions with any live chunk
+  // are pinned by the pointers handed out from them.
+  absl::flat_hash_set<void*> free_region_ptrs;
+  size_t total_free_bytes = 0;
+  for (const AllocationRegion& region : region_manager_.regions()) {
+    ChunkHandle h = region_manager_.get_handle(region.ptr());
+    bool any_use = false;
+    while (h != kInvalidChunkHandle) {
+      const Chunk* c = ChunkFromHandle(h);
+      if (c->in_use()) {
+        any_use = true;
+        break;
+      }
+      h = c->next;
+    }
+    if (!any_use) {
+      free_region_ptrs.insert(region.ptr());
+      total_free_bytes += region.memory_size();
+    }
+  }
+  if (free_region_ptrs.empty()) {
+    return false;
+  }
+
+  VLOG(1) << "Defragmentation: fragmentation metric exceeded "
+          << opts_.defragmentation_threshold << "; returning "
+          << strings::HumanReadableNumBytes(total_free_bytes) << " in "
+          << free_region_ptrs.size()
+          << " wholly free region(s) to the sub allocator.";
+  DeallocateRegions(free_region_ptrs);
+  return true;
+}
+
 void BFCAllocator::DeallocateRegions(
     const absl::flat_hash_set<void*>& region_ptrs)
     TF_EXCLUSIVE_LOCKS_REQUIRED(lock_) {
@@ -550,6 +726,20 @@ void BFCAllocator::AddTraceMe(absl::string_view traceme_name,
                                {"shape", annotation.pending_shape_func()}});
           },
       /*level=*/tsl::profiler::TraceMeLevel::kInfo);
+
+  if (HasAllocatorEventListeners()) {
+    AllocatorEvent event;
+    event.kind = traceme_name == "MemoryDeallocation"
+                     ? AllocatorEvent::Kind::kDeallocation
+                     : AllocatorEvent::Kind::kAllocation;
+    event.allocator_name = name_;
+    event.requested_bytes = req_bytes;
+    event.allocation_bytes = alloc_bytes;
+    event.bytes_in_use = stats_.bytes_in_use;
+    event.peak_bytes_in_use = stats_.peak_bytes_in_use;
+    event.fragmentation = GetFragmentation();
+    NotifyAllocatorEvent(event);
+  }
 }
 
 void* BFCAllocator::FindChunkPtr(BinNum bin_num, size_t rounded_bytes,
@@ -679,6 +869,12 @@ void BFCAllocator::SplitChunk(BFCAllocator::ChunkHandle h, size_t num_bytes) {
 }
 
 void BFCAllocator::DeallocateRaw(void* ptr) {
+  if (opts_.small_alloc_thread_cache && timing_counter_ == nullptr &&
+      ptr != nullptr && DeallocateToThreadCache(ptr)) {
+    VLOG(3) << "DeallocateRaw " << Name() << " " << ptr << " (thread cache)";
+    retry_helper_.NotifyDealloc();
+    return;
+  }
   VLOG(3) << "DeallocateRaw " << Name() << " "
           << (ptr ? RequestedSize(ptr) : 0);
   VLOG(4) << "[mem-debug] DeallocateRaw," << Name() << ","
@@ -688,7 +884,8 @@ void BFCAllocator::DeallocateRaw(void* ptr) {
   retry_helper_.NotifyDealloc();
 }
 
-void BFCAllocator::DeallocateRawInternal(void* ptr) {
+void BFCAllocator::DeallocateRawInternal(void* ptr,
+                                         bool from_thread_cache_spill) {
   if (ptr == nullptr) {
     VLOG(2) << "tried to deallocate nullptr";
     return;
@@ -704,6 +901,17 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   int64_t req_bytes = chunk->requested_size;
   int64_t alloc_bytes = chunk->size;
 
+  if (chunk->thread_cache_recorded) {
+    chunk->thread_cache_recorded = false;
+    // The allocating thread's `outstanding` map still records this address;
+    // bump the epoch so every thread cache drops its records before trusting
+    // them again.  Spills are exempt: a spilled pointer was erased from the
+    // owning cache's map when the cache absorbed it.
+    if (!from_thread_cache_spill) {
+      small_cache_epoch_.fetch_add(1, std::memory_order_release);
+    }
+  }
+
   MarkFree(h);
 
   // Consider coalescing it.
@@ -718,6 +926,12 @@ void BFCAllocator::DeallocateRawInternal(void* ptr) {
   // correct aggregation stats (bytes_in_use, fragmentation).
   AddTraceMe("MemoryDeallocation", chunk_ptr, req_bytes, alloc_bytes);
 
+  if (opts_.defragmentation_threshold > 0 &&
+      ++deallocs_since_defrag_check_ >= kDefragmentationCheckInterval) {
+    deallocs_since_defrag_check_ = 0;
+    MaybeDefragment();
+  }
+
   if (VLOG_IS_ON(4)) {
     LOG(INFO) << "F: " << RenderOccupancy();
   }
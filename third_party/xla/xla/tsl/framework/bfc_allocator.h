@@ -66,9 +66,30 @@ class BFCAllocator : public Allocator {
     // memory fragmentation.
     bool garbage_collection = false;
 
+    // If positive, wholly free allocation regions are proactively returned
+    // to the sub allocator whenever the fragmentation metric (see
+    // GetFragmentation()) meets or exceeds this fraction, instead of only
+    // after an allocation has already failed. The sub allocator can then
+    // recombine the released ranges with unallocated memory into larger
+    // contiguous regions, so long-running processes do not accumulate
+    // regions that can no longer serve large requests. Requires
+    // `garbage_collection`. Zero disables proactive defragmentation.
+    double defragmentation_threshold = 0.0;
+
     // Controls when a chunk should be split, if its size exceeds the requested
     // allocation size.
     double fragmentation_fraction = 0;
+
+    // If true, maintains a per-thread cache of freed sub-4KB chunks in front
+    // of the central free bins, so that most small allocations and
+    // deallocations do not contend on the allocator lock.  Chunks held in a
+    // thread cache are still considered "in use" by the central structures
+    // (and therefore by GetStats()) until they are spilled back.  Only a
+    // pointer freed on the thread that allocated it can be cached;
+    // cross-thread frees take the normal locked path.  This option is ignored
+    // for allocators with a timing counter (see SetTimingCounter()), since
+    // cached reuse would bypass the safe-frontier bookkeeping.
+    bool small_alloc_thread_cache = false;
   };
   BFCAllocator(std::unique_ptr<SubAllocator> sub_allocator, size_t total_memory,
                const string& name, const Options& opts);
@@ -119,7 +140,10 @@ class BFCAllocator : public Allocator {
       size_t alignment, size_t num_bytes,
       const AllocationAttributes& allocation_attr);
 
-  void DeallocateRawInternal(void* ptr);
+  // 'from_thread_cache_spill' is set by SpillThreadCache, whose pointers were
+  // already erased from the owning cache's `outstanding` map and therefore do
+  // not require an epoch bump (see small_cache_epoch_).
+  void DeallocateRawInternal(void* ptr, bool from_thread_cache_spill = false);
 
   // Chunks whose freed_at_count is later than the safe frontier value are kept
   // on a special list and not subject to merging immediately upon being freed.
@@ -209,6 +233,13 @@ class BFCAllocator : public Allocator {
     // Optional count when this chunk was most recently made free.
     uint64 freed_at_count = 0;
 
+    // True while some thread cache's `outstanding` map may record this
+    // chunk's address (see Options::small_alloc_thread_cache).  Written only
+    // under the allocator lock.  A central free of a chunk with this flag set
+    // bumps small_cache_epoch_ so that the stale record is dropped before it
+    // can misfile a recycled address.
+    bool thread_cache_recorded = false;
+
     bool in_use() const { return allocation_id != -1; }
 
 #ifdef TENSORFLOW_MEM_DEBUG
@@ -463,6 +494,13 @@ class BFCAllocator : public Allocator {
   // found and freed; false otherwise.
   bool DeallocateFreeRegions(size_t rounded_bytes);
 
+  // Proactively returns wholly free regions to the sub allocator when the
+  // fragmentation metric meets or exceeds `opts_.defragmentation_threshold`.
+  // Evaluated on the deallocation path once every
+  // `kDefragmentationCheckInterval` frees so the region scan stays off the
+  // common case.  Returns true if any regions were released.
+  bool MaybeDefragment() TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
+
   // Helper function to deallocate regions.
   void DeallocateRegions(const absl::flat_hash_set<void*>& region_ptrs)
       TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
@@ -532,6 +570,68 @@ class BFCAllocator : public Allocator {
   std::array<BinDebugInfo, kNumBins> get_bin_debug_info()
       TF_EXCLUSIVE_LOCKS_REQUIRED(lock_);
 
+  // Per-thread cache of small freed chunks, enabled by
+  // Options::small_alloc_thread_cache.  Cached chunks remain allocated as far
+  // as the central data structures are concerned, so the fast path touches no
+  // chunk metadata and takes no lock.  Reuse is restricted to exact
+  // rounded-size matches, which keeps AllocatedSize() exact; RequestedSize()
+  // for a reused chunk may differ from the current request by up to
+  // kMinAllocationSize - 1 bytes.
+  static constexpr size_t kSmallAllocThreshold = 4096;
+  static constexpr int kNumSmallSizeClasses =
+      kSmallAllocThreshold / kMinAllocationSize;
+  // When a thread holds more than this many cached bytes, half of them are
+  // spilled back to the central bins.
+  static constexpr size_t kThreadCacheByteBudget = 1 << 20;
+
+  struct ThreadCache {
+    // Freed pointers bucketed by rounded size; the index for a chunk of
+    // rounded size s is s / kMinAllocationSize - 1.
+    std::vector<void*> free_lists[kNumSmallSizeClasses];
+    // Rounded sizes of the small chunks handed out by this thread that are
+    // still live.  Only pointers present here may be absorbed by the cache
+    // without taking lock_.  A record goes stale when the pointer is freed on
+    // another thread (the central path cannot reach this map); stale records
+    // are dropped wholesale by SyncThreadCacheEpoch before the map is
+    // consulted or grown, so they can never misfile a recycled address and
+    // the map's size stays bounded by this thread's live small allocations.
+    std::unordered_map<const void*, size_t> outstanding;
+    // Value of small_cache_epoch_ as of the last SyncThreadCacheEpoch.
+    uint64_t epoch = 0;
+    size_t cached_bytes = 0;
+  };
+
+  // Returns this thread's cache for this allocator, creating it on first use.
+  // Returns nullptr once the calling thread's caches have been destroyed
+  // during TLS teardown, in which case callers must take the central path.
+  ThreadCache* GetThreadCache();
+
+  // Drops all of 'cache's `outstanding` records if any recorded pointer
+  // (of any thread) has been freed through the central path since the last
+  // sync.  Affected live pointers simply take the central path on their next
+  // free; correctness never depends on a record being present.
+  void SyncThreadCacheEpoch(ThreadCache* cache);
+
+  // Serves a small allocation from the thread cache, or returns nullptr if no
+  // chunk of the right size class is cached.
+  void* AllocateFromThreadCache(size_t num_bytes);
+
+  // Records a small allocation served by the central path so that a
+  // same-thread free of it can be cached.  Re-acquires lock_ briefly to tag
+  // the chunk as recorded; this only runs after a central (already locked)
+  // allocation, so the cache-hit path stays lock-free.
+  void RecordSmallAllocation(const void* ptr, size_t num_bytes);
+
+  // Returns true if 'ptr' was allocated on this thread and has been absorbed
+  // by the thread cache; false if the caller must take the central path.
+  bool DeallocateToThreadCache(void* ptr);
+
+  // Frees cached chunks back to the central bins until this thread holds at
+  // most kThreadCacheByteBudget / 2 bytes.
+  void SpillThreadCache(ThreadCache* cache);
+
+  static int64_t NextThreadCacheId();
+
   AllocatorRetry retry_helper_;
 
   // Structures immutable after construction
@@ -567,6 +667,15 @@ class BFCAllocator : public Allocator {
 
   std::unique_ptr<SubAllocator> sub_allocator_;
   string name_;
+  // Process-unique key for this allocator's thread caches.  Keyed by an id
+  // rather than 'this' so that an allocator reusing a destroyed allocator's
+  // address can never observe stale cache entries.
+  const int64_t thread_cache_id_ = NextThreadCacheId();
+  // Bumped (under lock_) whenever a chunk still recorded in some thread's
+  // `outstanding` map is freed through the central path, i.e. on a thread
+  // other than the one that allocated it.  Thread caches drop their records
+  // when they observe a new epoch, before trusting or growing them.
+  std::atomic<uint64_t> small_cache_epoch_{0};
   SharedCounter* timing_counter_ = nullptr;
   std::deque<ChunkHandle> timestamped_chunks_;
 
@@ -587,6 +696,11 @@ class BFCAllocator : public Allocator {
 
   // Stats.
   AllocatorStats stats_ TF_GUARDED_BY(lock_);
+
+  // Number of deallocations since the fragmentation threshold was last
+  // evaluated; see MaybeDefragment().
+  static constexpr int64_t kDefragmentationCheckInterval = 256;
+  int64_t deallocs_since_defrag_check_ TF_GUARDED_BY(lock_) = 0;
 #ifdef TENSORFLOW_MEM_DEBUG
   int64 action_counter_ TF_GUARDED_BY(lock_) = 0;
 #define MEM_DEBUG_SIZE_HISTORY_SIZE 4096
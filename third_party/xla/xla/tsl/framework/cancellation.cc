@@ -16,6 +16,7 @@ limitations under the License.
 #include "xla/tsl/framework/cancellation.h"
 
 #include <forward_list>
+#include <vector>
 
 #include "absl/memory/memory.h"
 #include "tsl/platform/errors.h"
@@ -43,37 +44,48 @@ void CancellationManager::StartCancel() {
 }
 
 void CancellationManager::StartCancelWithStatus(const absl::Status& status) {
-  gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks_to_run;
+  std::vector<CallbackConfiguration> callbacks_to_run;
   std::forward_list<CancellationManager*> children_to_cancel;
   Notification* cancelled_notification = nullptr;
+  State* state = nullptr;
   {
     mutex_lock l(mu_);
     if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
       return;
     }
     is_cancelling_ = true;
-    if (state_) {
-      std::swap(state_->callbacks, callbacks_to_run);
-
+    state = state_.get();
+    if (state) {
       // Remove all children from the list of children.
-      CancellationManager* child = state_->first_child;
+      CancellationManager* child = state->first_child;
       while (child != nullptr) {
         children_to_cancel.push_front(child);
         child->is_removed_from_parent_ = true;
         child = child->next_sibling_;
       }
-      state_->first_child = nullptr;
+      state->first_child = nullptr;
 
-      cancelled_notification = &state_->cancelled_notification;
+      cancelled_notification = &state->cancelled_notification;
     }
   }
-  // We call these callbacks without holding mu_, so that concurrent
+  if (state) {
+    // Drain each shard, marking it cancelled so that no new callback can be
+    // registered in a shard that has already been drained.
+    for (CallbackShard& shard : state->callback_shards) {
+      mutex_lock l(shard.mu);
+      shard.cancelled = true;
+      for (auto& key_and_value : shard.callbacks) {
+        callbacks_to_run.push_back(std::move(key_and_value.second));
+      }
+      shard.callbacks.clear();
+    }
+  }
+  // We call these callbacks without holding any locks, so that concurrent
   // calls to DeregisterCallback, which can happen asynchronously, do
   // not block. The callbacks remain valid because any concurrent call
   // to DeregisterCallback will block until the
   // cancelled_notification_ is notified.
-  for (auto key_and_value : callbacks_to_run) {
-    CallbackConfiguration& config = key_and_value.second;
+  for (CallbackConfiguration& config : callbacks_to_run) {
     if (!status.ok() && config.log_error) {
       LOG(WARNING) << "Cancellation callback \"" << config.name
                    << "\" is triggered due to a "
@@ -111,41 +123,53 @@ bool CancellationManager::RegisterCallbackWithErrorLogging(
 bool CancellationManager::RegisterCallbackConfig(CancellationToken token,
                                                  CallbackConfiguration config) {
   DCHECK_LT(token, next_cancellation_token_) << "Invalid cancellation token";
-  mutex_lock l(mu_);
-  bool should_register = !is_cancelled_ && !is_cancelling_;
-  if (should_register) {
+  if (is_cancelled_.load(std::memory_order_relaxed)) {
+    return false;
+  }
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    // First registration on this manager: create the state under mu_ and
+    // publish it for subsequent lock-free access.
+    mutex_lock l(mu_);
+    if (is_cancelled_.load(std::memory_order_relaxed) || is_cancelling_) {
+      return false;
+    }
     if (!state_) {
       state_ = absl::make_unique<State>();
+      state_ptr_.store(state_.get(), std::memory_order_release);
     }
-    std::swap(state_->callbacks[token], config);
+    state = state_.get();
   }
-  return should_register;
+  CallbackShard& shard = state->callback_shard(token);
+  mutex_lock l(shard.mu);
+  if (shard.cancelled) {
+    return false;
+  }
+  std::swap(shard.callbacks[token], config);
+  return true;
 }
 
 bool CancellationManager::DeregisterCallback(CancellationToken token) {
-  mu_.lock();
-  if (is_cancelled_) {
-    mu_.unlock();
-    return false;
-  } else if (is_cancelling_) {
-    Notification* cancelled_notification =
-        state_ ? &state_->cancelled_notification : nullptr;
-    mu_.unlock();
-    // Wait for all of the cancellation callbacks to be called. This
-    // wait ensures that the caller of DeregisterCallback does not
-    // return immediately and free objects that may be used in the
-    // execution of any currently pending callbacks in StartCancel.
-    if (cancelled_notification) {
-      cancelled_notification->WaitForNotification();
-    }
-    return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    // Nothing was ever registered; only the cancellation state matters.
+    mutex_lock l(mu_);
+    return !is_cancelled_.load(std::memory_order_relaxed) && !is_cancelling_;
+  }
+  {
+    CallbackShard& shard = state->callback_shard(token);
+    mutex_lock l(shard.mu);
+    if (!shard.cancelled) {
+      shard.callbacks.erase(token);
+      return true;
     }
-    mu_.unlock();
-    return true;
   }
+  // Cancellation has started. Wait for all of the cancellation callbacks to
+  // be called. This wait ensures that the caller of DeregisterCallback does
+  // not return immediately and free objects that may be used in the
+  // execution of any currently pending callbacks in StartCancel.
+  state->cancelled_notification.WaitForNotification();
+  return false;
 }
 
 bool CancellationManager::RegisterChild(CancellationManager* child) {
@@ -157,6 +181,7 @@ bool CancellationManager::RegisterChild(CancellationManager* child) {
 
   if (!state_) {
     state_ = absl::make_unique<State>();
+    state_ptr_.store(state_.get(), std::memory_order_release);
   }
 
   // Push `child` onto the front of the list of children.
@@ -208,15 +233,18 @@ void CancellationManager::DeregisterChild(CancellationManager* child) {
 }
 
 bool CancellationManager::TryDeregisterCallback(CancellationToken token) {
-  mutex_lock lock(mu_);
-  if (is_cancelled_ || is_cancelling_) {
+  State* state = state_ptr_.load(std::memory_order_acquire);
+  if (state == nullptr) {
+    mutex_lock lock(mu_);
+    return !is_cancelled_.load(std::memory_order_relaxed) && !is_cancelling_;
+  }
+  CallbackShard& shard = state->callback_shard(token);
+  mutex_lock lock(shard.mu);
+  if (shard.cancelled) {
     return false;
-  } else {
-    if (state_) {
-      state_->callbacks.erase(token);
-    }
-    return true;
   }
+  shard.callbacks.erase(token);
+  return true;
 }
 
 CancellationManager::~CancellationManager() {
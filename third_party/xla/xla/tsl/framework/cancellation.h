@@ -69,8 +69,11 @@ class CancellationManager {
   // CancellationManager::RegisterCallbackWithErrorLogging.
   void StartCancelWithStatus(const absl::Status& status);
 
-  // Returns true iff StartCancel() has been called.
-  bool IsCancelled() { return is_cancelled_.load(std::memory_order_acquire); }
+  // Returns true iff StartCancel() has been called. This is a relaxed atomic
+  // read that imposes no ordering, so steady-state polling never contends; it
+  // may return false while cancellation callbacks are still running on
+  // another thread (use IsCancelling() to detect that case).
+  bool IsCancelled() { return is_cancelled_.load(std::memory_order_relaxed); }
 
   // Returns a token that must be used in calls to RegisterCallback
   // and DeregisterCallback.
@@ -167,9 +170,27 @@ class CancellationManager {
     bool log_error = false;
   };
 
+  // Registered callbacks are partitioned by token across a fixed number of
+  // shards, each guarded by its own mutex, so that concurrent
+  // RegisterCallback/DeregisterCallback calls from many outstanding async ops
+  // do not serialize on a single lock. StartCancel marks each shard cancelled
+  // while draining it, so no registration can land in a drained shard.
+  struct CallbackShard {
+    mutex mu;
+    bool cancelled TF_GUARDED_BY(mu) = false;
+    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks
+        TF_GUARDED_BY(mu);
+  };
+
   struct State {
+    static constexpr int kNumCallbackShards = 8;
+
     Notification cancelled_notification;
-    gtl::FlatMap<CancellationToken, CallbackConfiguration> callbacks;
+    CallbackShard callback_shards[kNumCallbackShards];
+
+    CallbackShard& callback_shard(CancellationToken token) {
+      return callback_shards[token % kNumCallbackShards];
+    }
 
     // If this CancellationManager has any children, this member points to the
     // head of a doubly-linked list of its children.
@@ -203,6 +224,11 @@ class CancellationManager {
 
   mutex mu_;
   std::unique_ptr<State> state_ TF_GUARDED_BY(mu_);
+
+  // Cached raw pointer to *state_, set (once) under mu_ when the state is
+  // created. Lets the callback registration paths reach their shard without
+  // taking mu_; the state is only destroyed with the manager itself.
+  std::atomic<State*> state_ptr_{nullptr};
 };
 
 // Registers the given cancellation callback, returning a function that can be